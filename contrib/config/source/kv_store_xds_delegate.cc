@@ -34,9 +34,11 @@ XdsKeyValueStoreStats KeyValueStoreXdsDelegate::generateStats(Stats::Scope& scop
 }
 
 KeyValueStoreXdsDelegate::KeyValueStoreXdsDelegate(KeyValueStorePtr&& xds_config_store,
-                                                   Stats::Scope& root_scope)
+                                                   Stats::Scope& root_scope,
+                                                   bool load_on_startup)
     : xds_config_store_(std::move(xds_config_store)),
-      scope_(root_scope.createScope("xds.kv_store.")), stats_(generateStats(*scope_)) {}
+      scope_(root_scope.createScope("xds.kv_store.")), stats_(generateStats(*scope_)),
+      load_on_startup_(load_on_startup) {}
 
 std::vector<envoy::service::discovery::v3::Resource> KeyValueStoreXdsDelegate::getResources(
     const XdsSourceId& source_id, const absl::flat_hash_set<std::string>& resource_names) const {
@@ -157,7 +159,8 @@ Envoy::Config::XdsResourcesDelegatePtr KeyValueStoreXdsDelegateFactory::createXd
       validator_config.key_value_store_config().config());
   KeyValueStorePtr xds_config_store = kv_store_factory.createStore(
       validator_config.key_value_store_config(), validation_visitor, dispatcher, api.fileSystem());
-  return std::make_unique<KeyValueStoreXdsDelegate>(std::move(xds_config_store), api.rootScope());
+  return std::make_unique<KeyValueStoreXdsDelegate>(std::move(xds_config_store), api.rootScope(),
+                                                    validator_config.load_on_startup());
 }
 
 REGISTER_FACTORY(KeyValueStoreXdsDelegateFactory, Envoy::Config::XdsResourcesDelegateFactory);
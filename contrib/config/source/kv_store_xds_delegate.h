@@ -42,7 +42,8 @@ struct XdsKeyValueStoreStats {
 // not currently advised to use this feature for large and complicated configurations.
 class KeyValueStoreXdsDelegate : public Envoy::Config::XdsResourcesDelegate {
 public:
-  KeyValueStoreXdsDelegate(KeyValueStorePtr&& xds_config_store, Stats::Scope& root_scope);
+  KeyValueStoreXdsDelegate(KeyValueStorePtr&& xds_config_store, Stats::Scope& root_scope,
+                           bool load_on_startup = false);
 
   std::vector<envoy::service::discovery::v3::Resource>
   getResources(const Envoy::Config::XdsSourceId& source_id,
@@ -55,6 +56,8 @@ public:
                             const std::string& resource_name,
                             const absl::optional<EnvoyException>& exception) override;
 
+  bool loadResourcesOnStart() const override { return load_on_startup_; }
+
 private:
   // Gets all the resources present in the KeyValueStore for the given source_id. This is the
   // equivalent of wildcard xDS requests.
@@ -66,6 +69,7 @@ private:
   KeyValueStorePtr xds_config_store_;
   Stats::ScopeSharedPtr scope_;
   XdsKeyValueStoreStats stats_;
+  const bool load_on_startup_;
 };
 
 // A factory for creating instances of KeyValueStoreXdsDelegate from the typed_config field of a
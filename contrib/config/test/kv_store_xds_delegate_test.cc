@@ -18,6 +18,7 @@
 #include "test/test_common/utility.h"
 
 #include "contrib/config/source/kv_store_xds_delegate.h"
+#include "contrib/envoy/extensions/config/v3alpha/kv_store_xds_delegate_config.pb.h"
 #include "gtest/gtest.h"
 
 namespace Envoy {
@@ -335,5 +336,19 @@ TEST_F(KeyValueStoreXdsDelegateTest, ResourcesWithTTL) {
       source_id, /*resource_names=*/{"some_resource_1"}, decoded_resources.refvec_);
 }
 
+TEST_F(KeyValueStoreXdsDelegateTest, LoadOnStartup) {
+  EXPECT_FALSE(xds_delegate_->loadResourcesOnStart());
+
+  auto config = kvStoreDelegateConfig();
+  envoy::extensions::config::v3alpha::KeyValueStoreXdsDelegateConfig delegate_config;
+  MessageUtil::unpackTo(config.typed_config(), delegate_config);
+  delegate_config.set_load_on_startup(true);
+  config.mutable_typed_config()->PackFrom(delegate_config);
+  Extensions::Config::KeyValueStoreXdsDelegateFactory delegate_factory;
+  const auto startup_delegate = delegate_factory.createXdsResourcesDelegate(
+      config.typed_config(), ProtobufMessage::getStrictValidationVisitor(), *api_, dispatcher_);
+  EXPECT_TRUE(startup_delegate->loadResourcesOnStart());
+}
+
 } // namespace
 } // namespace Envoy
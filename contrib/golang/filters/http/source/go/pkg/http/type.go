@@ -325,7 +325,8 @@ type httpBuffer struct {
 	request             *httpRequest
 	envoyBufferInstance uint64
 	length              uint64
-	value               []byte
+	// value caches the content of the buffer copied from Envoy, until the buffer is changed.
+	value []byte
 }
 
 var _ api.BufferInstance = (*httpBuffer)(nil)
@@ -334,6 +335,7 @@ func (b *httpBuffer) Write(p []byte) (n int, err error) {
 	cAPI.HttpSetBytesBufferHelper(unsafe.Pointer(b.request.req), b.envoyBufferInstance, p, api.AppendBuffer)
 	n = len(p)
 	b.length += uint64(n)
+	b.value = nil
 	return n, nil
 }
 
@@ -341,12 +343,14 @@ func (b *httpBuffer) WriteString(s string) (n int, err error) {
 	cAPI.HttpSetBufferHelper(unsafe.Pointer(b.request.req), b.envoyBufferInstance, s, api.AppendBuffer)
 	n = len(s)
 	b.length += uint64(n)
+	b.value = nil
 	return n, nil
 }
 
 func (b *httpBuffer) WriteByte(p byte) error {
 	cAPI.HttpSetBufferHelper(unsafe.Pointer(b.request.req), b.envoyBufferInstance, string(p), api.AppendBuffer)
 	b.length++
+	b.value = nil
 	return nil
 }
 
@@ -368,11 +372,15 @@ func (b *httpBuffer) WriteUint64(p uint64) error {
 	return err
 }
 
+// Bytes copies the buffer from Envoy at most once until the buffer is changed, so that reading the
+// body repeatedly does not cross the cgo boundary every time.
 func (b *httpBuffer) Bytes() []byte {
 	if b.length == 0 {
 		return nil
 	}
-	b.value = cAPI.HttpGetBuffer(unsafe.Pointer(b.request.req), b.envoyBufferInstance, b.length)
+	if b.value == nil {
+		b.value = cAPI.HttpGetBuffer(unsafe.Pointer(b.request.req), b.envoyBufferInstance, b.length)
+	}
 	return b.value
 }
 
@@ -389,6 +397,12 @@ func (b *httpBuffer) Drain(offset int) {
 	cAPI.HttpDrainBuffer(unsafe.Pointer(b.request.req), b.envoyBufferInstance, size)
 
 	b.length -= size
+	if b.value != nil {
+		b.value = b.value[size:]
+		if b.length == 0 {
+			b.value = nil
+		}
+	}
 }
 
 func (b *httpBuffer) Len() int {
@@ -400,11 +414,7 @@ func (b *httpBuffer) Reset() {
 }
 
 func (b *httpBuffer) String() string {
-	if b.length == 0 {
-		return ""
-	}
-	b.value = cAPI.HttpGetBuffer(unsafe.Pointer(b.request.req), b.envoyBufferInstance, b.length)
-	return string(b.value)
+	return string(b.Bytes())
 }
 
 func (b *httpBuffer) Append(data []byte) error {
@@ -415,6 +425,7 @@ func (b *httpBuffer) Append(data []byte) error {
 func (b *httpBuffer) Prepend(data []byte) error {
 	cAPI.HttpSetBytesBufferHelper(unsafe.Pointer(b.request.req), b.envoyBufferInstance, data, api.PrependBuffer)
 	b.length += uint64(len(data))
+	b.value = nil
 	return nil
 }
 
@@ -426,17 +437,20 @@ func (b *httpBuffer) AppendString(s string) error {
 func (b *httpBuffer) PrependString(s string) error {
 	cAPI.HttpSetBufferHelper(unsafe.Pointer(b.request.req), b.envoyBufferInstance, s, api.PrependBuffer)
 	b.length += uint64(len(s))
+	b.value = nil
 	return nil
 }
 
 func (b *httpBuffer) Set(data []byte) error {
 	cAPI.HttpSetBytesBufferHelper(unsafe.Pointer(b.request.req), b.envoyBufferInstance, data, api.SetBuffer)
 	b.length = uint64(len(data))
+	b.value = nil
 	return nil
 }
 
 func (b *httpBuffer) SetString(s string) error {
 	cAPI.HttpSetBufferHelper(unsafe.Pointer(b.request.req), b.envoyBufferInstance, s, api.SetBuffer)
 	b.length = uint64(len(s))
+	b.value = nil
 	return nil
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <unordered_map>
 
 #include "envoy/event/dispatcher.h"
 
@@ -53,12 +54,17 @@ public:
   // Executed in Envoy worker thread.
   void processDelivery(const DeliveryMemento& memento);
 
-  std::list<ProduceFinishCbSharedPtr>& getUnfinishedRequestsForTest();
+  // Requests waiting for delivery confirmations, keyed by the payload of each record sent, so that
+  // a confirmation can be matched without going through all the requests and their records.
+  // A multimap, as records with empty payloads need not have distinct data pointers.
+  using UnfinishedRequests = std::unordered_multimap<const void*, ProduceFinishCbSharedPtr>;
+
+  UnfinishedRequests& getUnfinishedRequestsForTest();
 
 private:
   Event::Dispatcher& dispatcher_;
 
-  std::list<ProduceFinishCbSharedPtr> unfinished_produce_requests_;
+  UnfinishedRequests unfinished_produce_requests_;
 
   // Real Kafka producer (thread-safe).
   // Invoked by Envoy handler thread (to produce), and internal monitoring thread
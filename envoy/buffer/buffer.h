@@ -122,6 +122,11 @@ public:
    */
   virtual void credit(uint64_t amount) PURE;
 
+  /**
+   * @return the amount of memory the account is currently charged for.
+   */
+  virtual uint64_t balance() const PURE;
+
   /**
    * Clears the associated downstream with this account.
    * After this has been called, calls to reset the downstream become no-ops.
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <functional>
+#include <utility>
 
+#include "envoy/buffer/buffer.h"
 #include "envoy/common/pure.h"
 #include "envoy/network/address.h"
 #include "envoy/thread_local/thread_local.h"
@@ -30,7 +32,11 @@ public:
   };
 
   Request(RequestType type, IoUringSocket& socket) : type_(type), socket_(socket) {}
-  virtual ~Request() = default;
+  virtual ~Request() {
+    if (provided_buffer_ != nullptr) {
+      provided_buffer_->done();
+    }
+  }
 
   /**
    * Return the request type.
@@ -42,9 +48,24 @@ public:
    */
   IoUringSocket& socket() const { return socket_; }
 
+  /**
+   * Attaches the provided buffer the kernel selected for a completed read. The buffer is
+   * returned to its ring when the request is released without taking the buffer.
+   */
+  void setProvidedBuffer(Buffer::BufferFragment& buffer) { provided_buffer_ = &buffer; }
+
+  /**
+   * Takes the provided buffer holding the data of a completed read, if any. The caller becomes
+   * responsible for calling done() on the returned fragment.
+   */
+  Buffer::BufferFragment* releaseProvidedBuffer() {
+    return std::exchange(provided_buffer_, nullptr);
+  }
+
 private:
   RequestType type_;
   IoUringSocket& socket_;
+  Buffer::BufferFragment* provided_buffer_{nullptr};
 };
 
 /**
@@ -147,6 +168,29 @@ public:
    */
   virtual IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) PURE;
 
+  /**
+   * Registers a ring of `num_buffers` buffers of `buffer_size` bytes each which the kernel
+   * selects from when a read prepared by prepareReadProvidedBuffer() completes. The selected
+   * buffer is attached to the request of the completion.
+   * Returns false if the kernel does not support provided buffer rings.
+   */
+  virtual bool registerProvidedBuffers(uint32_t num_buffers, uint32_t buffer_size) PURE;
+
+  /**
+   * Returns true if provided buffers are registered and the ring has buffers left that the kernel
+   * can select for a read.
+   */
+  virtual bool hasProvidedBuffers() const PURE;
+
+  /**
+   * Prepares a read system call into a buffer selected from the provided buffer ring and puts it
+   * into the submission queue. The read fails with -ENOBUFS if the ring is empty when the data
+   * arrives.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareReadProvidedBuffer(os_fd_t fd, Request* user_data) PURE;
+
   /**
    * Submits the entries in the submission queue to the kernel using the
    * `io_uring_enter()` system call.
@@ -13,6 +13,13 @@ public:
   virtual CompressorPtr createCompressor() PURE;
   virtual const std::string& statsPrefix() const PURE;
   virtual const std::string& contentEncoding() const PURE;
+
+  /**
+   * @return the SHA-256 hash of the dictionary that a client must already have to decode the
+   *         compressed output, as the structured field byte sequence it is sent in the
+   *         available-dictionary request header. Empty if the output is self-contained.
+   */
+  virtual std::string availableDictionary() const { return ""; }
 };
 
 using CompressorFactoryPtr = std::unique_ptr<CompressorFactory>;
@@ -65,6 +65,14 @@ public:
    * @return optional ref<envoy::config::core::v3::Metadata> of a resource.
    */
   virtual const OptRef<const envoy::config::core::v3::Metadata> metadata() const PURE;
+
+  /**
+   * @return the hash of the resource as serialized by the management server, if it was decoded
+   *         from its serialized form. Equal hashes mean the resource is unchanged without having
+   *         to hash the decoded message, but as serialization is not deterministic, a changed
+   *         hash does not mean that the resource changed.
+   */
+  virtual absl::optional<uint64_t> serializedHash() const PURE;
 };
 
 using DecodedResourcePtr = std::unique_ptr<DecodedResource>;
@@ -83,6 +83,13 @@ public:
    */
   virtual void onResourceLoadFailed(const XdsSourceId& source_id, const std::string& resource_name,
                                     const absl::optional<EnvoyException>& exception) PURE;
+
+  /**
+   * @return true if the resources returned by getResources() should be applied as soon as the xDS
+   *         fetch starts, so that Envoy can serve with them until the xDS authority responds. If
+   *         false, they are only applied once connecting to the xDS authority failed.
+   */
+  virtual bool loadResourcesOnStart() const PURE;
 };
 
 using XdsResourcesDelegatePtr = std::unique_ptr<XdsResourcesDelegate>;
@@ -39,8 +39,11 @@ namespace Event {
  * All dispatcher stats. @see stats_macros.h
  */
 #define ALL_DISPATCHER_STATS(HISTOGRAM)                                                            \
+  HISTOGRAM(deferred_delete_duration_us, Microseconds)                                             \
   HISTOGRAM(loop_duration_us, Microseconds)                                                        \
-  HISTOGRAM(poll_delay_us, Microseconds)
+  HISTOGRAM(poll_delay_us, Microseconds)                                                           \
+  HISTOGRAM(post_duration_us, Microseconds)                                                        \
+  HISTOGRAM(post_queue_size, Unspecified)
 
 /**
  * Struct definition for all dispatcher stats. @see stats_macros.h
@@ -64,6 +64,23 @@ public:
   virtual ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
                                             Server::Configuration::ServerFactoryContext& context,
                                             bool validate_clusters_default) const PURE;
+
+  /**
+   * Create a config object based on a route configuration which replaces a previous one. This may
+   * share the parts of the previous config object which did not change instead of building them
+   * again, and by default builds the whole config object.
+   * @param rc supplies the RouteConfiguration.
+   * @param context supplies the context of the server factory.
+   * @param validate_clusters_default see createConfig().
+   * @param previous_config supplies the config object which is replaced.
+   * @throw EnvoyException if the new config can't be applied.
+   */
+  virtual ConfigConstSharedPtr updateConfig(const Protobuf::Message& rc,
+                                            Server::Configuration::ServerFactoryContext& context,
+                                            bool validate_clusters_default,
+                                            const ConfigConstSharedPtr& /*previous_config*/) const {
+    return createConfig(rc, context, validate_clusters_default);
+  }
 };
 
 } // namespace Rds
@@ -120,6 +120,13 @@ public:
 class RouteSpecificFilterConfig {
 public:
   virtual ~RouteSpecificFilterConfig() = default;
+
+  /**
+   * @return true if the filter does nothing at all for the routes this config applies to. Such
+   *     filters are left out of the filter chains of these routes, as if they were disabled with
+   *     envoy.config.route.v3.FilterConfig.
+   */
+  virtual bool disablesFilter() const { return false; }
 };
 using RouteSpecificFilterConfigConstSharedPtr = std::shared_ptr<const RouteSpecificFilterConfig>;
 
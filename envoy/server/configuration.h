@@ -85,6 +85,11 @@ public:
    */
   virtual bool flushOnAdmin() const PURE;
 
+  /**
+   * @return true if only the stats which changed since the previous flush are flushed to sinks.
+   */
+  virtual bool flushOnlyChanged() const PURE;
+
   /**
    * @return true if deferred creation of stats is enabled.
    */
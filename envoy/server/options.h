@@ -61,6 +61,29 @@ enum class DrainStrategy {
   Immediate,
 };
 
+/**
+ * Whether application logs are written by the logging threads themselves or by a background
+ * thread, and what happens to the lines logged while the buffer of a thread is full.
+ */
+enum class AsyncLogMode {
+  /**
+   * Log lines are written synchronously by the threads logging them.
+   */
+  Disabled,
+
+  /**
+   * Log lines are written by a background thread. Lines logged while the buffer of their thread
+   * is full are dropped and counted.
+   */
+  Drop,
+
+  /**
+   * Log lines are written by a background thread. Threads logging while their buffer is full
+   * wait for it to be drained.
+   */
+  Block,
+};
+
 using CommandLineOptionsPtr = std::unique_ptr<envoy::admin::v3::CommandLineOptions>;
 
 /**
@@ -189,6 +212,11 @@ public:
    */
   virtual const std::string& logPath() const PURE;
 
+  /**
+   * @return AsyncLogMode whether and how application logs are written asynchronously.
+   */
+  virtual AsyncLogMode asyncLogMode() const PURE;
+
   /**
    * @return the restart epoch. 0 indicates the first server start, 1 the second, and so on.
    */
@@ -205,6 +233,17 @@ public:
    */
   virtual std::chrono::milliseconds fileFlushIntervalMsec() const PURE;
 
+  /**
+   * @return uint64_t the maximum size of the data buffered for a log file, or 0 if unbounded.
+   */
+  virtual uint64_t fileFlushMaxBufferBytes() const PURE;
+
+  /**
+   * @return bool indicating whether writes to a log file whose buffer is full wait for it to be
+   *         flushed, rather than being dropped.
+   */
+  virtual bool fileFlushBlockWhenFull() const PURE;
+
   /**
    * @return const std::string& the server's cluster.
    */
@@ -245,6 +284,11 @@ public:
    */
   virtual bool cpusetThreadsEnabled() const PURE;
 
+  /**
+   * @return bool indicating whether each worker thread should be pinned to a CPU.
+   */
+  virtual bool pinWorkerThreadsEnabled() const PURE;
+
   /**
    * @return the names of extensions to disable.
    */
@@ -94,6 +94,12 @@ public:
    * @return the max depth used when verifying the certificate-chain
    */
   virtual absl::optional<uint32_t> maxVerifyDepth() const PURE;
+
+  /**
+   * @return the maximum number of successfully verified certificate chains to cache, 0 if the
+   * verifications must not be cached.
+   */
+  virtual uint32_t verifiedCertificateCacheSize() const PURE;
 };
 
 using CertificateValidationContextConfigPtr = std::unique_ptr<CertificateValidationContextConfig>;
@@ -39,6 +39,20 @@ public:
   virtual CounterSharedPtr makeCounter(StatName name, StatName tag_extracted_name,
                                        const StatNameTagVector& stat_name_tags) PURE;
 
+  /**
+   * Like makeCounter(), but if the counter does not exist yet it is created sharded: each
+   * thread increments one of several cache line sized slots, which are summed when the
+   * counter is read or latched. This avoids contention on counters incremented by all workers
+   * for nearly every request, at the cost of more memory per counter.
+   *
+   * @param name the full name of the stat.
+   * @param tag_extracted_name the name of the stat with tag-values stripped out.
+   * @param tags the tag values.
+   * @return CounterSharedPtr a counter.
+   */
+  virtual CounterSharedPtr makeShardedCounter(StatName name, StatName tag_extracted_name,
+                                              const StatNameTagVector& stat_name_tags) PURE;
+
   /**
    * @param name the full name of the stat.
    * @param tag_extracted_name the name of the stat with tag-values stripped out.
@@ -102,12 +102,14 @@ public:
    * Flags:
    * Used: used by all stats types to figure out whether they have been used.
    * Logic...: used by gauges to cache how they should be combined with a parent's value.
+   * Changed: used by gauges to track whether they changed since the last stats flush.
    */
   struct Flags {
     static constexpr uint8_t Used = 0x01;
     static constexpr uint8_t LogicAccumulate = 0x02;
     static constexpr uint8_t NeverImport = 0x04;
     static constexpr uint8_t Hidden = 0x08;
+    static constexpr uint8_t Changed = 0x10;
   };
   virtual SymbolTable& symbolTable() PURE;
   virtual const SymbolTable& constSymbolTable() const PURE;
@@ -153,6 +155,12 @@ public:
   virtual void sub(uint64_t amount) PURE;
   virtual uint64_t value() const PURE;
 
+  /**
+   * Like Counter::latch(), this is meant to be called only by the periodic stats flush.
+   * @return true if the gauge was changed since the previous call, and clears that state.
+   */
+  virtual bool latchChanged() PURE;
+
   /**
    * Sets a value from a hot-restart parent. This parent contribution must be
    * kept distinct from the child value, so that when we erase the value it
@@ -235,6 +235,22 @@ public:
    */
   virtual void setHistogramSettings(HistogramSettingsConstPtr&& histogram_settings) PURE;
 
+  /**
+   * Controls whether the counters which are incremented for nearly every request or connection
+   * of a cluster, HTTP connection manager or listener are made sharded, as provided by
+   * Allocator::makeShardedCounter(). Only affects counters created after the call.
+   * @param shard_hot_counters whether to shard the hot counters.
+   */
+  virtual void setShardHotCounters(bool shard_hot_counters) PURE;
+
+  /**
+   * Limits the number of stats of each scope other than the root one. Stats past the limit are
+   * not created: null stats are returned instead, and the ``stats.scope_stats_overflow`` counter
+   * is incremented. Only affects stats created after the call.
+   * @param max_stats_per_scope the maximum number of stats of a scope, or 0 for no limit.
+   */
+  virtual void setMaxStatsPerScope(uint32_t max_stats_per_scope) PURE;
+
   /**
    * Initialize the store for threading. This will be called once after all worker threads have
    * been initialized. At this point the store can initialize itself for multi-threaded operation.
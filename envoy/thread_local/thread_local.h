@@ -57,6 +57,9 @@ public:
    *
    * NOTE: The initialize callback is not supposed to capture the Slot, or its owner, as the owner
    * may be destructed in main thread before the update_cb gets called in a worker thread.
+   *
+   * NOTE: A single copy of the initialize callback is shared by all threads, which may run it
+   * concurrently, so it must not modify its captures.
    */
   using InitializeCb = std::function<ThreadLocalObjectSharedPtr(Event::Dispatcher& dispatcher)>;
   virtual void set(InitializeCb cb) PURE;
@@ -142,6 +145,9 @@ public:
    *
    * NOTE: The initialize callback is not supposed to capture the Slot, or its owner, as the owner
    * may be destructed in main thread before the update_cb gets called in a worker thread.
+   *
+   * NOTE: A single copy of the initialize callback is shared by all threads, which may run it
+   * concurrently, so it must not modify its captures.
    */
   using InitializeCb = std::function<std::shared_ptr<T>(Event::Dispatcher& dispatcher)>;
   void set(InitializeCb cb) { slot_->set(cb); }
@@ -178,6 +184,9 @@ public:
    * NOTE: The update callback is not supposed to capture the TypedSlot, or its
    * owner, as the owner may be destructed in main thread before the update_cb
    * gets called in a worker thread.
+   *
+   * NOTE: A single copy of the update callback is shared by all threads, which may run it
+   * concurrently, so it must not modify its captures.
    */
   using UpdateCb = std::function<void(OptRef<T> obj)>;
   void runOnAllThreads(const UpdateCb& cb) { slot_->runOnAllThreads(makeSlotUpdateCb(cb)); }
@@ -73,6 +73,13 @@ public:
    */
   virtual void setSampled(bool sampled) PURE;
 
+  /**
+   * @return whether the tags and logs of this span may be reported to the tracing system. Callers
+   * may skip building tags for spans which are not recording, such as spans that are not sampled
+   * by a tracer which drops unsampled spans when they finish.
+   */
+  virtual bool isRecording() const PURE;
+
   /**
    * Retrieve a key's value from the span's baggage.
    * This baggage data could've been set by this span or any parent spans.
@@ -222,10 +222,14 @@ public:
    *
    * @param cluster supplies the cluster configuration.
    * @param version_info supplies the xDS version of the cluster.
+   * @param serialized_hash optionally supplies the hash of the serialized cluster configuration,
+   *        see Config::DecodedResource::serializedHash(). If it matches the one of the previously
+   *        running configuration, nothing is done without hashing the whole configuration.
    * @return true if the action results in an add/update of a cluster.
    */
   virtual bool addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
-                                  const std::string& version_info) PURE;
+                                  const std::string& version_info,
+                                  absl::optional<uint64_t> serialized_hash = absl::nullopt) PURE;
 
   /**
    * Set a callback that will be invoked when all primary clusters have been initialized.
@@ -964,6 +964,12 @@ public:
    */
   virtual float perUpstreamPreconnectRatio() const PURE;
 
+  /**
+   * @return true if connection pools should preconnect based on the estimated stream arrival rate
+   *         and connect latency.
+   */
+  virtual bool adaptivePreconnect() const PURE;
+
   /**
    * @return how many streams should be anticipated per each current stream.
    */
@@ -2,8 +2,10 @@
 
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/common/lock_guard.h"
+#include "source/common/common/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/notification.h"
 #include "library/common/bridge/utility.h"
 #include "library/common/data/utility.h"
@@ -61,6 +63,8 @@ envoy_status_t InternalEngine::run(std::shared_ptr<Envoy::OptionsImplBase> optio
 envoy_status_t InternalEngine::main(std::shared_ptr<Envoy::OptionsImplBase> options) {
   // Using unique_ptr ensures main_common's lifespan is strictly scoped to this function.
   std::unique_ptr<EngineCommon> main_common;
+  const MonotonicTime start_time = RealTimeSource().monotonicTime();
+  std::chrono::milliseconds server_init_time{};
   {
     Thread::LockGuard lock(mutex_);
     TRY_NEEDS_AUDIT {
@@ -91,6 +95,8 @@ envoy_status_t InternalEngine::main(std::shared_ptr<Envoy::OptionsImplBase> opti
       main_common = std::make_unique<EngineCommon>(options);
       server_ = main_common->server();
       event_dispatcher_ = &server_->dispatcher();
+      server_init_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+          server_->timeSource().monotonicTime() - start_time);
 
       cv_.notifyAll();
     }
@@ -105,7 +111,8 @@ envoy_status_t InternalEngine::main(std::shared_ptr<Envoy::OptionsImplBase> opti
     // as we did previously).
 
     postinit_callback_handler_ = main_common->server()->lifecycleNotifier().registerCallback(
-        Envoy::Server::ServerLifecycleNotifier::Stage::PostInit, [this]() -> void {
+        Envoy::Server::ServerLifecycleNotifier::Stage::PostInit,
+        [this, start_time, server_init_time]() -> void {
           ASSERT(Thread::MainThread::isMainOrTestThread());
 
           Envoy::Server::GenericFactoryContextImpl generic_context(
@@ -128,6 +135,9 @@ envoy_status_t InternalEngine::main(std::shared_ptr<Envoy::OptionsImplBase> opti
                                                         server_->serverFactoryContext().scope(),
                                                         server_->api().randomGenerator());
           dispatcher_->drain(server_->dispatcher());
+          logStartupTime(server_init_time,
+                         std::chrono::duration_cast<std::chrono::milliseconds>(
+                             server_->timeSource().monotonicTime() - start_time));
           if (callbacks_.on_engine_running != nullptr) {
             callbacks_.on_engine_running(callbacks_.context);
           }
@@ -236,6 +246,19 @@ envoy_status_t InternalEngine::recordCounterInc(absl::string_view elements, envo
 
 Event::ProvisionalDispatcher& InternalEngine::dispatcher() { return *dispatcher_; }
 
+void InternalEngine::logStartupTime(std::chrono::milliseconds server_init_time,
+                                    std::chrono::milliseconds running_time) {
+  ENVOY_LOG(info, "engine started in {}ms, {}ms of which were spent creating the server",
+            running_time.count(), server_init_time.count());
+  if (event_tracker_.track != nullptr) {
+    event_tracker_.track(
+        Bridge::Utility::makeEnvoyMap({{"name", "engine_startup"},
+                                       {"server_init_ms", absl::StrCat(server_init_time.count())},
+                                       {"running_ms", absl::StrCat(running_time.count())}}),
+        event_tracker_.context);
+  }
+}
+
 void statsAsText(const std::map<std::string, uint64_t>& all_stats,
                  const std::vector<Stats::ParentHistogramSharedPtr>& histograms,
                  Buffer::Instance& response) {
@@ -129,6 +129,11 @@ private:
   envoy_status_t main(std::shared_ptr<Envoy::OptionsImplBase> options);
   static void logInterfaces(absl::string_view event,
                             std::vector<Network::InterfacePair>& interfaces);
+  // Logs how long the engine took to start, and emits it as an "engine_startup" event. The server
+  // init time covers creating the server, the running time also covers the cluster warming done
+  // before the engine is reported as running.
+  void logStartupTime(std::chrono::milliseconds server_init_time,
+                      std::chrono::milliseconds running_time);
 
   Thread::PosixThreadFactoryPtr thread_factory_;
   Event::Dispatcher* event_dispatcher_{};
@@ -6,6 +6,7 @@
 #include "test/common/mocks/common/mocks.h"
 #include "test/mocks/thread/mocks.h"
 
+#include "absl/strings/numbers.h"
 #include "absl/synchronization/notification.h"
 #include "gtest/gtest.h"
 #include "library/cc/engine_builder.h"
@@ -440,6 +441,44 @@ TEST_F(InternalEngineTest, EventTrackerRegistersEnvoyBugRecordAction) {
   ASSERT_TRUE(test_context.on_exit.WaitForNotificationWithTimeout(absl::Seconds(3)));
 }
 
+TEST_F(InternalEngineTest, EventTrackerReceivesStartupTime) {
+  EngineTestContext test_context{};
+  envoy_engine_callbacks engine_cbs{[](void* context) -> void {
+                                      auto* test_context = static_cast<EngineTestContext*>(context);
+                                      test_context->on_engine_running.Notify();
+                                    } /*on_engine_running*/,
+                                    [](void* context) -> void {
+                                      auto* test_context = static_cast<EngineTestContext*>(context);
+                                      test_context->on_exit.Notify();
+                                    } /*on_exit*/,
+                                    &test_context /*context*/};
+
+  envoy_event_tracker event_tracker{
+      [](envoy_map map, const void* context) -> void {
+        const auto new_map = toMap(map);
+        if (new_map.count("name") && new_map.at("name") == "engine_startup") {
+          uint64_t server_init_ms;
+          uint64_t running_ms;
+          EXPECT_TRUE(absl::SimpleAtoi(new_map.at("server_init_ms"), &server_init_ms));
+          EXPECT_TRUE(absl::SimpleAtoi(new_map.at("running_ms"), &running_ms));
+          EXPECT_LE(server_init_ms, running_ms);
+          auto* test_context = static_cast<EngineTestContext*>(const_cast<void*>(context));
+          test_context->on_event.Notify();
+        }
+      } /*track*/,
+      &test_context /*context*/};
+
+  std::unique_ptr<Envoy::InternalEngine> engine(
+      new Envoy::InternalEngine(engine_cbs, {}, event_tracker));
+  engine->run(MINIMAL_TEST_CONFIG, LEVEL_DEBUG);
+
+  // The startup event is emitted before the engine is reported as running.
+  ASSERT_TRUE(test_context.on_engine_running.WaitForNotificationWithTimeout(absl::Seconds(3)));
+  EXPECT_TRUE(test_context.on_event.HasBeenNotified());
+  engine->terminate();
+  ASSERT_TRUE(test_context.on_exit.WaitForNotificationWithTimeout(absl::Seconds(3)));
+}
+
 TEST_F(InternalEngineTest, BasicStream) {
   const std::string level = "debug";
   EngineTestContext engine_cbs_context{};
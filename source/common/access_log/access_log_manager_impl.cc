@@ -48,21 +48,26 @@ AccessLogManagerImpl::createAccessLog(const Filesystem::FilePathAndType& file_in
 
   access_logs_[file_name] =
       std::make_shared<AccessLogFileImpl>(std::move(file), dispatcher_, lock_, file_stats_,
-                                          file_flush_interval_msec_, api_.threadFactory());
+                                          file_flush_interval_msec_, api_.threadFactory(),
+                                          file_buffer_limits_);
   return access_logs_[file_name];
 }
 
 AccessLogFileImpl::AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                                      Thread::BasicLockable& lock, AccessLogFileStats& stats,
                                      std::chrono::milliseconds flush_interval_msec,
-                                     Thread::ThreadFactory& thread_factory)
+                                     Thread::ThreadFactory& thread_factory,
+                                     const FileBufferLimits& limits)
     : file_(std::move(file)), file_lock_(lock),
       flush_timer_(dispatcher.createTimer([this]() -> void {
         stats_.flushed_by_timer_.inc();
-        flush_event_.notifyOne();
+        if (buffered_bytes_.load() > 0) {
+          requestFlush();
+        }
         flush_timer_->enableTimer(flush_interval_msec_);
       })),
-      thread_factory_(thread_factory), flush_interval_msec_(flush_interval_msec), stats_(stats) {
+      thread_factory_(thread_factory), flush_interval_msec_(flush_interval_msec), limits_(limits),
+      stats_(stats) {
   flush_timer_->enableTimer(flush_interval_msec_);
 }
 
@@ -85,8 +90,9 @@ AccessLogFileImpl::~AccessLogFileImpl() {
 
   // Flush any remaining data. If file was not opened for some reason, skip flushing part.
   if (file_->isOpen()) {
-    if (flush_buffer_.length() > 0) {
-      doWrite(flush_buffer_);
+    collectWriteBuffers();
+    if (about_to_write_buffer_.length() > 0) {
+      doWrite(about_to_write_buffer_);
     }
     const Api::IoCallBoolResult result = file_->close();
     ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
@@ -119,8 +125,14 @@ void AccessLogFileImpl::doWrite(Buffer::Instance& buffer) {
     }
   }
 
-  stats_.write_total_buffered_.sub(buffer.length());
-  buffer.drain(buffer.length());
+  const uint64_t length = buffer.length();
+  buffer.drain(length);
+  buffered_bytes_ -= length;
+  stats_.write_total_buffered_.sub(length);
+  if (limits_.block_when_full_ && length > 0) {
+    Thread::LockGuard lock(drain_lock_);
+    drain_event_.notifyAll();
+  }
 }
 
 void AccessLogFileImpl::flushThreadFunc() {
@@ -136,13 +148,12 @@ void AccessLogFileImpl::flushThreadFunc() {
     {
       Thread::LockGuard write_lock(write_lock_);
 
-      // flush_event_ can be woken up either by large enough flush_buffer or by timer.
-      // In case it was timer, flush_buffer_ can be empty.
+      // flush_event_ can be woken up either by large enough write buffers or by timer.
       //
       // Note: do not stop waiting when only `do_reopen` is true. In this case, we tried to
       // reopen and failed. We don't want to retry this in a tight loop, so wait for the next
       // event (timer or flush).
-      while (flush_buffer_.length() == 0 && !flush_thread_exit_ && !reopen_file_) {
+      while (!flush_requested_.load() && !flush_thread_exit_ && !reopen_file_) {
         // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
         flush_event_.wait(write_lock_);
       }
@@ -151,9 +162,9 @@ void AccessLogFileImpl::flushThreadFunc() {
         return;
       }
 
+      // Writes from now on request another flush if needed.
+      flush_requested_ = false;
       flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-      about_to_write_buffer_.move(flush_buffer_);
-      ASSERT(flush_buffer_.length() == 0);
 
       if (reopen_file_) {
         do_reopen = true;
@@ -161,6 +172,8 @@ void AccessLogFileImpl::flushThreadFunc() {
       }
     }
 
+    collectWriteBuffers();
+
     if (do_reopen) {
       if (file_->isOpen()) {
         const Api::IoCallBoolResult result = file_->close();
@@ -180,47 +193,103 @@ void AccessLogFileImpl::flushThreadFunc() {
 }
 
 void AccessLogFileImpl::flush() {
-  std::unique_lock<Thread::BasicLockable> flush_buffer_lock;
-
-  {
-    Thread::LockGuard write_lock(write_lock_);
+  // flush_lock_ must be held while collecting the write buffers or else it is possible that
+  // flushThreadFunc() has already collected data, but has not yet completed doWrite(). This
+  // would allow flush() to return before the pending data has actually been written to disk.
+  Thread::LockGuard flush_lock(flush_lock_);
+  collectWriteBuffers();
+  if (about_to_write_buffer_.length() == 0) {
+    return;
+  }
 
-    // flush_lock_ must be held while checking this or else it is
-    // possible that flushThreadFunc() has already moved data from
-    // flush_buffer_ to about_to_write_buffer_, has unlocked write_lock_,
-    // but has not yet completed doWrite(). This would allow flush() to
-    // return before the pending data has actually been written to disk.
-    flush_buffer_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
+  doWrite(about_to_write_buffer_);
+}
 
-    if (flush_buffer_.length() == 0) {
-      return;
+void AccessLogFileImpl::write(absl::string_view data) {
+  const bool start_flush_thread = !flush_thread_started_.load();
+  if (start_flush_thread) {
+    Thread::LockGuard lock(write_lock_);
+    if (flush_thread_ == nullptr) {
+      createFlushStructures();
     }
+  }
 
-    about_to_write_buffer_.move(flush_buffer_);
-    ASSERT(flush_buffer_.length() == 0);
+  if (!reserveBufferSpace(data.size())) {
+    return;
   }
 
-  doWrite(about_to_write_buffer_);
+  stats_.write_buffered_.inc();
+  stats_.write_total_buffered_.add(data.length());
+  {
+    WriteBuffer& write_buffer = write_buffers_[writeBufferIndex()];
+    Thread::LockGuard lock(write_buffer.lock_);
+    write_buffer.buffer_.add(data.data(), data.size());
+  }
+  // The first write is flushed right away, so that a new file gets its data without waiting
+  // for the timer.
+  if (start_flush_thread || buffered_bytes_.load() > MIN_FLUSH_SIZE) {
+    requestFlush();
+  }
 }
 
-void AccessLogFileImpl::write(absl::string_view data) {
+void AccessLogFileImpl::requestFlush() {
+  if (flush_requested_.exchange(true)) {
+    return;
+  }
+  // Holding write_lock_ while notifying makes sure that the flush thread either sees the request
+  // when it checks whether to wait, or is already waiting and gets woken up.
   Thread::LockGuard lock(write_lock_);
+  flush_event_.notifyOne();
+}
 
-  if (flush_thread_ == nullptr) {
-    createFlushStructures();
+void AccessLogFileImpl::collectWriteBuffers() {
+  for (WriteBuffer& write_buffer : write_buffers_) {
+    Thread::LockGuard lock(write_buffer.lock_);
+    about_to_write_buffer_.move(write_buffer.buffer_);
   }
+}
 
-  stats_.write_buffered_.inc();
-  stats_.write_total_buffered_.add(data.length());
-  flush_buffer_.add(data.data(), data.size());
-  if (flush_buffer_.length() > MIN_FLUSH_SIZE) {
-    flush_event_.notifyOne();
+bool AccessLogFileImpl::reserveBufferSpace(uint64_t length) {
+  if (limits_.max_buffer_bytes_ == 0) {
+    buffered_bytes_ += length;
+    return true;
+  }
+
+  bool blocked = false;
+  while (true) {
+    // A single write which is larger than the limit is still taken once nothing is buffered.
+    uint64_t buffered = buffered_bytes_.load();
+    while (buffered == 0 || buffered + length <= limits_.max_buffer_bytes_) {
+      if (buffered_bytes_.compare_exchange_weak(buffered, buffered + length)) {
+        return true;
+      }
+    }
+
+    if (!limits_.block_when_full_) {
+      stats_.write_dropped_.inc();
+      return false;
+    }
+    if (!blocked) {
+      stats_.write_blocked_.inc();
+      blocked = true;
+    }
+    requestFlush();
+    Thread::LockGuard lock(drain_lock_);
+    while (true) {
+      buffered = buffered_bytes_.load();
+      if (buffered == 0 || buffered + length <= limits_.max_buffer_bytes_) {
+        break;
+      }
+      // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
+      drain_event_.wait(drain_lock_);
+    }
   }
 }
 
 void AccessLogFileImpl::createFlushStructures() {
   flush_thread_ = thread_factory_.createThread([this]() -> void { flushThreadFunc(); },
                                                Thread::Options{"AccessLogFlush"});
+  flush_thread_started_ = true;
 }
 
 } // namespace AccessLog
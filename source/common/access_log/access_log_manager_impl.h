@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <string>
 
 #include "envoy/access_log/access_log.h"
@@ -12,6 +14,7 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
+#include "source/common/common/thread_shard.h"
 
 #include "absl/container/node_hash_map.h"
 
@@ -20,8 +23,10 @@ namespace Envoy {
 #define ACCESS_LOG_FILE_STATS(COUNTER, GAUGE)                                                      \
   COUNTER(flushed_by_timer)                                                                        \
   COUNTER(reopen_failed)                                                                           \
+  COUNTER(write_blocked)                                                                           \
   COUNTER(write_buffered)                                                                          \
   COUNTER(write_completed)                                                                         \
+  COUNTER(write_dropped)                                                                           \
   COUNTER(write_failed)                                                                            \
   GAUGE(write_total_buffered, Accumulate)
 
@@ -31,15 +36,28 @@ struct AccessLogFileStats {
 
 namespace AccessLog {
 
+/**
+ * Bounds the log data each file buffers while its flush thread cannot keep up, e.g. because the
+ * disk stalls.
+ */
+struct FileBufferLimits {
+  // 0 means that the buffered data is not bounded.
+  uint64_t max_buffer_bytes_{0};
+  // Whether writes beyond the limit wait for the flush thread to catch up, rather than being
+  // dropped.
+  bool block_when_full_{false};
+};
+
 class AccessLogManagerImpl : public AccessLogManager, Logger::Loggable<Logger::Id::main> {
 public:
   AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec, Api::Api& api,
                        Event::Dispatcher& dispatcher, Thread::BasicLockable& lock,
-                       Stats::Store& stats_store)
+                       Stats::Store& stats_store, const FileBufferLimits& file_buffer_limits = {})
       : file_flush_interval_msec_(file_flush_interval_msec), api_(api), dispatcher_(dispatcher),
-        lock_(lock), file_stats_{
-                         ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(stats_store, "filesystem."),
-                                               POOL_GAUGE_PREFIX(stats_store, "filesystem."))} {}
+        lock_(lock), file_stats_{ACCESS_LOG_FILE_STATS(
+                         POOL_COUNTER_PREFIX(stats_store, "filesystem."),
+                         POOL_GAUGE_PREFIX(stats_store, "filesystem."))},
+        file_buffer_limits_(file_buffer_limits) {}
   ~AccessLogManagerImpl() override;
 
   // AccessLog::AccessLogManager
@@ -53,6 +71,7 @@ private:
   Event::Dispatcher& dispatcher_;
   Thread::BasicLockable& lock_;
   AccessLogFileStats file_stats_;
+  const FileBufferLimits file_buffer_limits_;
   absl::node_hash_map<std::string, AccessLogFileSharedPtr> access_logs_;
 };
 
@@ -62,13 +81,17 @@ private:
  * This implementation uses a flush thread per file, with the idea there aren't that many
  * files. If this turns out to be a good implementation we can potentially have a single flush
  * thread that flushes all files, but we will start with this.
+ *
+ * Writes are spread over a fixed set of independently locked buffers, each thread always using
+ * the same one, so that workers logging to the same file rarely contend. The data one thread
+ * writes stays in order, but entries of different threads may be reordered within a flush.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
   AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                     Thread::BasicLockable& lock, AccessLogFileStats& stats,
                     std::chrono::milliseconds flush_interval_msec,
-                    Thread::ThreadFactory& thread_factory);
+                    Thread::ThreadFactory& thread_factory, const FileBufferLimits& limits = {});
   ~AccessLogFileImpl() override;
 
   // AccessLog::AccessLogFile
@@ -83,19 +106,36 @@ public:
   void flush() override;
 
 private:
+  struct alignas(CacheLineSize) WriteBuffer {
+    Thread::MutexBasicLockable lock_;
+    Buffer::OwnedImpl buffer_ ABSL_GUARDED_BY(lock_);
+  };
+
   void doWrite(Buffer::Instance& buffer);
   void flushThreadFunc();
   void createFlushStructures();
+  // Wakes the flush thread, unless a flush is already pending.
+  void requestFlush();
+  // Moves the data of all write buffers to about_to_write_buffer_.
+  void collectWriteBuffers();
+  // Returns false if the write must be dropped because the buffered data is at its limit.
+  bool reserveBufferSpace(uint64_t length);
+
+  // Threads are assigned write buffers round robin when they first write to a file.
+  static size_t writeBufferIndex() { return threadShardIndex<NumWriteBuffers>(); }
 
   // Minimum size before the flush thread will be told to flush.
   static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
+  static constexpr size_t NumWriteBuffers = 16;
 
   Filesystem::FilePtr file_;
 
   // These locks are always acquired in the following order if multiple locks are held:
   //    1) write_lock_
   //    2) flush_lock_
-  //    3) file_lock_
+  //    3) a WriteBuffer lock_
+  //    4) file_lock_
+  // drain_lock_ is only held on its own.
   Thread::BasicLockable& file_lock_;      // This lock is used only by the flush thread when writing
                                           // to disk. This is used to make sure that file blocks do
                                           // not get interleaved by multiple processes writing to
@@ -106,30 +146,38 @@ private:
                                           // and all other data used during flushing and file
                                           // re-opening.
   Thread::MutexBasicLockable
-      write_lock_; // The lock is used when filling the flush buffer. It allows
-                   // multiple threads to write to the same file at relatively
-                   // high performance. It is always local to the process.
+      write_lock_; // The lock is used to start the flush thread and to wake it up. It is not
+                   // taken by writes, except for the ones that need to wake the flush thread.
   Thread::ThreadPtr flush_thread_;
+  std::atomic<bool> flush_thread_started_{false};
   Thread::CondVar flush_event_;
   bool flush_thread_exit_ ABSL_GUARDED_BY(write_lock_){false};
   bool reopen_file_ ABSL_GUARDED_BY(write_lock_){false};
-  Buffer::OwnedImpl
-      flush_buffer_ ABSL_GUARDED_BY(write_lock_); // This buffer is used by multiple threads. It
-                                                  // gets filled and then flushed either when max
-                                                  // size is reached or when a timer fires.
+  // Set when the flush thread needs to run, by a write that fills the buffers past
+  // MIN_FLUSH_SIZE or by the flush timer. It is only cleared while holding write_lock_.
+  std::atomic<bool> flush_requested_{false};
+  // These buffers are filled by the threads which write to the file. They get flushed either when
+  // MIN_FLUSH_SIZE is reached or when a timer fires.
+  std::array<WriteBuffer, NumWriteBuffers> write_buffers_;
+  // The size of the data in write_buffers_ and about_to_write_buffer_ which is not written yet.
+  std::atomic<uint64_t> buffered_bytes_{0};
   // TODO(jmarantz): this should be ABSL_GUARDED_BY(flush_lock_) but the analysis cannot poke
   // through the std::make_unique assignment. I do not believe it's possible to annotate this
   // properly now due to limitations in the clang thread annotation analysis.
   Buffer::OwnedImpl about_to_write_buffer_; // This buffer is used only by the flush thread. Data
-                                            // is moved from flush_buffer_ under lock, and then
-                                            // the lock is released so that flush_buffer_ can
+                                            // is moved from write_buffers_ under their locks, and
+                                            // then the locks are released so that they can
                                             // continue to fill. This buffer is then used for the
                                             // final write to disk.
+  // Used by writes which wait for the buffered data to drop below the limit.
+  Thread::MutexBasicLockable drain_lock_;
+  Thread::CondVar drain_event_;
   Event::TimerPtr flush_timer_;
   Thread::ThreadFactory& thread_factory_;
   const std::chrono::milliseconds flush_interval_msec_; // Time interval buffer gets flushed no
                                                         // matter if it reached the MIN_FLUSH_SIZE
                                                         // or not.
+  const FileBufferLimits limits_;
   AccessLogFileStats& stats_;
 };
 
@@ -17,5 +17,11 @@ SysCallIntResult LinuxOsSysCallsImpl::sched_getaffinity(pid_t pid, size_t cpuset
   return {rc, errno};
 }
 
+SysCallIntResult LinuxOsSysCallsImpl::sched_setaffinity(pid_t pid, size_t cpusetsize,
+                                                        const cpu_set_t* mask) {
+  const int rc = ::sched_setaffinity(pid, cpusetsize, mask);
+  return {rc, errno};
+}
+
 } // namespace Api
 } // namespace Envoy
@@ -19,10 +19,6 @@ namespace {
 constexpr uint64_t CopyThreshold = 512;
 } // namespace
 
-thread_local absl::InlinedVector<Slice::StoragePtr,
-                                 OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_max_>
-    OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_;
-
 void OwnedImpl::addImpl(const void* data, uint64_t size) {
   const char* src = static_cast<const char*>(data);
   bool new_slice_needed = slices_.empty();
@@ -521,6 +517,15 @@ ssize_t OwnedImpl::search(const void* data, uint64_t size, size_t start, size_t
       // bytes in the buffer match the remainder of the needle. Note that the match can span
       // two or more slices.
       left_to_search -= static_cast<size_t>(first_byte_match - haystack + 1);
+      if (static_cast<size_t>(haystack_end - first_byte_match) >= size) {
+        // The rest of the needle fits in this slice, so it can be compared all at once.
+        if (left_to_search >= size - 1 &&
+            memcmp(first_byte_match + 1, needle + 1, size - 1) == 0) {
+          return offset + (first_byte_match - slice_start);
+        }
+        haystack = first_byte_match + 1;
+        continue;
+      }
       // Save the current number of bytes left to search.
       // If the pattern is not found, the search will resume from the next byte
       // and left_to_search value must be restored.
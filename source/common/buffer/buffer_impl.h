@@ -9,6 +9,7 @@
 #include "envoy/buffer/buffer.h"
 #include "envoy/http/stream_reset_handler.h"
 
+#include "source/common/buffer/slice_allocator.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
@@ -19,6 +20,15 @@
 namespace Envoy {
 namespace Buffer {
 
+/**
+ * Returns the backing storage of a Slice to the thread's SliceAllocator.
+ */
+struct SliceStorageDeleter {
+  void operator()(uint8_t* mem) const { SliceAllocator::deallocate(mem, len_); }
+
+  size_t len_{};
+};
+
 /**
  * A Slice manages a contiguous block of bytes.
  * The block is arranged like this:
@@ -37,7 +47,7 @@ namespace Buffer {
 class Slice {
 public:
   using Reservation = RawSlice;
-  using StoragePtr = std::unique_ptr<uint8_t[]>;
+  using StoragePtr = std::unique_ptr<uint8_t[], SliceStorageDeleter>;
 
   struct SizedStorage {
     StoragePtr mem_{};
@@ -57,7 +67,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_(allocateStorage(capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -385,7 +395,17 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {allocateStorage(slice_size), static_cast<size_t>(slice_size)};
+  }
+
+  /**
+   * Create new backend storage of the given size from the thread's SliceAllocator.
+   * @param size the size of the storage, which must be a multiple of 4kb.
+   * @return the backend storage.
+   */
+  static inline StoragePtr allocateStorage(uint64_t size) {
+    return StoragePtr{SliceAllocator::allocate(size),
+                      SliceStorageDeleter{static_cast<size_t>(size)}};
   }
 
 protected:
@@ -783,32 +803,11 @@ private:
 
   struct OwnedImplReservationSlicesOwnerMultiple : public OwnedImplReservationSlicesOwner {
   public:
-    static constexpr uint32_t free_list_max_ = Buffer::Reservation::MAX_SLICES_;
-
-    OwnedImplReservationSlicesOwnerMultiple() : free_list_ref_(free_list_) {}
-    ~OwnedImplReservationSlicesOwnerMultiple() override {
-      for (auto r = owned_storages_.rbegin(); r != owned_storages_.rend(); r++) {
-        if (r->mem_ != nullptr) {
-          ASSERT(r->len_ == Slice::default_slice_size_);
-          if (free_list_ref_.size() < free_list_max_) {
-            free_list_ref_.push_back(std::move(r->mem_));
-          }
-        }
-      }
-    }
-
     Slice::SizedStorage newStorage() {
       ASSERT(Slice::sliceSize(Slice::default_slice_size_) == Slice::default_slice_size_);
-
-      Slice::SizedStorage storage{nullptr, Slice::default_slice_size_};
-      if (!free_list_ref_.empty()) {
-        storage.mem_ = std::move(free_list_ref_.back());
-        free_list_ref_.pop_back();
-      } else {
-        storage.mem_.reset(new uint8_t[Slice::default_slice_size_]);
-      }
-
-      return storage;
+      // The unused storages go back to the free list of the SliceAllocator when this owner is
+      // destroyed.
+      return {Slice::allocateStorage(Slice::default_slice_size_), Slice::default_slice_size_};
     }
 
     absl::Span<Slice::SizedStorage> ownedStorages() override {
@@ -816,16 +815,6 @@ private:
     }
 
     absl::InlinedVector<Slice::SizedStorage, Buffer::Reservation::MAX_SLICES_> owned_storages_;
-
-  private:
-    // Thread local resolving introduces additional overhead. Initialize this reference once when
-    // constructing the owner to reduce thread local resolving to improve performance.
-    absl::InlinedVector<Slice::StoragePtr, free_list_max_>& free_list_ref_;
-
-    // Simple thread local cache to reduce unnecessary memory allocation and release. This cache
-    // is currently only used for multiple slices reservation because of the additional overhead
-    // that thread local resolving would introduce.
-    static thread_local absl::InlinedVector<Slice::StoragePtr, free_list_max_> free_list_;
   };
 
   struct OwnedImplReservationSlicesOwnerSingle : public OwnedImplReservationSlicesOwner {
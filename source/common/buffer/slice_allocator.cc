@@ -0,0 +1,117 @@
+#include "source/common/buffer/slice_allocator.h"
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+enum class CacheState : uint8_t { Uninitialized, Alive, Destroyed };
+
+// Storage may be released by thread local or static destructors which run after the cache of the
+// thread has been destroyed. This is trivially destructible, so it remains accessible then.
+thread_local CacheState cache_state = CacheState::Uninitialized;
+
+constexpr bool isCachedSize(uint64_t size) {
+  return size > 0 && size <= SliceAllocator::MaxCachedSize &&
+         size % SliceAllocator::PageSize == 0;
+}
+
+constexpr uint64_t sizeClass(uint64_t size) { return size / SliceAllocator::PageSize - 1; }
+
+constexpr uint64_t sizeClassSize(uint64_t size_class) {
+  return (size_class + 1) * SliceAllocator::PageSize;
+}
+
+} // namespace
+
+SliceAllocator::ThreadCache::ThreadCache() {
+  for (uint64_t i = 0; i < NumSizeClasses; i++) {
+    free_lists_[i].reserve(MaxCachedBytesPerSizeClass / sizeClassSize(i));
+  }
+  cache_state = CacheState::Alive;
+}
+
+SliceAllocator::ThreadCache::~ThreadCache() {
+  releaseAll();
+  cache_state = CacheState::Destroyed;
+}
+
+uint64_t SliceAllocator::ThreadCache::releaseAll() {
+  uint64_t released = 0;
+  for (uint64_t i = 0; i < NumSizeClasses; i++) {
+    for (uint8_t* mem : free_lists_[i]) {
+      delete[] mem;
+    }
+    released += free_lists_[i].size() * sizeClassSize(i);
+    free_lists_[i].clear();
+  }
+  ASSERT(released == stats_.cached_bytes_);
+  stats_.cached_bytes_ = 0;
+  stats_.released_bytes_ += released;
+  return released;
+}
+
+SliceAllocator::ThreadCache* SliceAllocator::threadCache() {
+  if (cache_state == CacheState::Destroyed) {
+    return nullptr;
+  }
+  static thread_local ThreadCache cache;
+  return &cache;
+}
+
+uint8_t* SliceAllocator::allocate(uint64_t size) {
+  ThreadCache* cache = threadCache();
+  if (cache == nullptr) {
+    return new uint8_t[size];
+  }
+
+  if (isCachedSize(size)) {
+    std::vector<uint8_t*>& free_list = cache->free_lists_[sizeClass(size)];
+    if (!free_list.empty()) {
+      uint8_t* mem = free_list.back();
+      free_list.pop_back();
+      cache->stats_.cached_bytes_ -= size;
+      cache->stats_.cache_hits_++;
+      return mem;
+    }
+  }
+  cache->stats_.heap_allocations_++;
+  return new uint8_t[size];
+}
+
+void SliceAllocator::deallocate(uint8_t* mem, uint64_t size) {
+  if (mem == nullptr) {
+    return;
+  }
+
+  if (isCachedSize(size)) {
+    ThreadCache* cache = threadCache();
+    if (cache != nullptr) {
+      std::vector<uint8_t*>& free_list = cache->free_lists_[sizeClass(size)];
+      if ((free_list.size() + 1) * size <= MaxCachedBytesPerSizeClass) {
+        free_list.push_back(mem);
+        cache->stats_.cached_bytes_ += size;
+        return;
+      }
+    }
+  }
+  delete[] mem;
+}
+
+uint64_t SliceAllocator::releaseFreeMemory() {
+  ThreadCache* cache = threadCache();
+  return cache != nullptr ? cache->releaseAll() : 0;
+}
+
+const SliceAllocator::Stats& SliceAllocator::threadStats() {
+  ThreadCache* cache = threadCache();
+  if (cache == nullptr) {
+    static const Stats empty_stats;
+    return empty_stats;
+  }
+  return cache->stats_;
+}
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * Thread local allocator for the backing storage of Buffer::Slice. Slice storage is always a
+ * multiple of the page size, and every size up to MaxCachedSize is a size class with its own
+ * bounded free list, so the buffer churn of a worker is mostly served without going through the
+ * general purpose heap. Larger storage is allocated from the heap directly.
+ *
+ * Each thread has its own free lists and never takes a lock. Storage released on a different
+ * thread than the one it was allocated on is cached by the releasing thread.
+ */
+class SliceAllocator {
+public:
+  static constexpr uint64_t PageSize = 4096;
+  static constexpr uint64_t MaxCachedSize = 16 * PageSize;
+  static constexpr uint64_t NumSizeClasses = MaxCachedSize / PageSize;
+  // Upper bound of the bytes cached by the free list of a single size class on one thread.
+  static constexpr uint64_t MaxCachedBytesPerSizeClass = 256 * 1024;
+
+  /**
+   * Memory usage of the allocator of one thread. The values only change on the owning thread.
+   */
+  struct Stats {
+    // Bytes held in the free lists.
+    uint64_t cached_bytes_{};
+    // Allocations served from a free list.
+    uint64_t cache_hits_{};
+    // Allocations which went to the heap.
+    uint64_t heap_allocations_{};
+    // Bytes dropped from the free lists by releaseFreeMemory().
+    uint64_t released_bytes_{};
+  };
+
+  /**
+   * Allocates storage of the given size.
+   * @param size the size of the storage in bytes, a multiple of PageSize.
+   * @return the storage, which must be released with deallocate() and the same size.
+   */
+  static uint8_t* allocate(uint64_t size);
+
+  /**
+   * Releases storage returned by allocate().
+   * @param mem the storage, may be nullptr.
+   * @param size the size the storage was allocated with.
+   */
+  static void deallocate(uint8_t* mem, uint64_t size);
+
+  /**
+   * Returns all storage cached by the calling thread to the heap, e.g. when the overload manager
+   * asks to shrink the heap.
+   * @return the number of bytes released.
+   */
+  static uint64_t releaseFreeMemory();
+
+  /**
+   * @return the memory usage of the calling thread's allocator.
+   */
+  static const Stats& threadStats();
+
+private:
+  struct ThreadCache {
+    ThreadCache();
+    ~ThreadCache();
+
+    uint64_t releaseAll();
+
+    std::array<std::vector<uint8_t*>, NumSizeClasses> free_lists_;
+    Stats stats_;
+  };
+
+  static ThreadCache* threadCache();
+};
+
+} // namespace Buffer
+} // namespace Envoy
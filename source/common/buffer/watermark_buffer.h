@@ -24,8 +24,9 @@ public:
   WatermarkBuffer(std::function<void()> below_low_watermark,
                   std::function<void()> above_high_watermark,
                   std::function<void()> above_overflow_watermark)
-      : below_low_watermark_(below_low_watermark), above_high_watermark_(above_high_watermark),
-        above_overflow_watermark_(above_overflow_watermark) {}
+      : below_low_watermark_(std::move(below_low_watermark)),
+        above_high_watermark_(std::move(above_high_watermark)),
+        above_overflow_watermark_(std::move(above_overflow_watermark)) {}
 
   // Override all functions from Instance which can result in changing the size
   // of the underlying buffer.
@@ -111,7 +112,7 @@ public:
   BufferMemoryAccountImpl(BufferMemoryAccountImpl&&) = delete;
   BufferMemoryAccountImpl& operator=(BufferMemoryAccountImpl&&) = delete;
 
-  uint64_t balance() const { return buffer_memory_allocated_; }
+  uint64_t balance() const override { return buffer_memory_allocated_; }
   void charge(uint64_t amount) override;
   void credit(uint64_t amount) override;
 
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <string>
 
+#include "absl/time/time.h"
 #include "spdlog/spdlog.h"
 
 namespace Envoy {
@@ -34,5 +35,131 @@ void FileSinkDelegate::flush() {
   log_file_->flush();
 }
 
+bool AsyncSinkDelegate::Ring::push(absl::string_view msg, const spdlog::details::log_msg& log_msg) {
+  const uint64_t tail = tail_.load(std::memory_order_relaxed);
+  if (tail - head_.load(std::memory_order_acquire) == entries_.size()) {
+    return false;
+  }
+  Entry& entry = entries_[tail % entries_.size()];
+  entry.msg_.assign(msg.data(), msg.size());
+  entry.logger_name_.assign(log_msg.logger_name.data(), log_msg.logger_name.size());
+  entry.level_ = log_msg.level;
+  entry.time_ = log_msg.time;
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+template <class Fn> void AsyncSinkDelegate::Ring::drain(Fn fn) {
+  uint64_t head = head_.load(std::memory_order_relaxed);
+  const uint64_t tail = tail_.load(std::memory_order_acquire);
+  for (; head != tail; ++head) {
+    fn(entries_[head % entries_.size()]);
+    head_.store(head + 1, std::memory_order_release);
+  }
+}
+
+AsyncSinkDelegate::AsyncSinkDelegate(DelegatingLogSinkSharedPtr log_sink,
+                                     Thread::ThreadFactory& thread_factory,
+                                     AsyncLogOverflowPolicy overflow_policy, uint32_t ring_size,
+                                     std::chrono::milliseconds drain_interval)
+    : SinkDelegate(log_sink), id_([] {
+        static std::atomic<uint64_t> next_id{1};
+        return next_id++;
+      }()),
+      overflow_policy_(overflow_policy), ring_size_(ring_size),
+      drain_interval_(absl::FromChrono(drain_interval)) {
+  assert(ring_size_ > 0);
+  drain_thread_ =
+      thread_factory.createThread([this]() { drainLoop(); }, Thread::Options{"async_log"});
+  setDelegate();
+}
+
+AsyncSinkDelegate::~AsyncSinkDelegate() {
+  // Restoring the previous delegate waits for the lines being logged through this one, so that
+  // none is left behind by the final drain.
+  restoreDelegate();
+  {
+    absl::MutexLock lock(&drain_mutex_);
+    shutdown_ = true;
+  }
+  drain_thread_->join();
+  flush();
+}
+
+void AsyncSinkDelegate::log(absl::string_view msg, const spdlog::details::log_msg& log_msg) {
+  Ring& ring = threadRing();
+  if (ring.push(msg, log_msg)) {
+    return;
+  }
+  if (overflow_policy_ == AsyncLogOverflowPolicy::Drop) {
+    dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  {
+    absl::MutexLock lock(&drain_mutex_);
+    drainLocked();
+  }
+  // This thread is the only producer of its ring, so the drain made room for the line.
+  ring.push(msg, log_msg);
+}
+
+void AsyncSinkDelegate::flush() {
+  absl::MutexLock lock(&drain_mutex_);
+  drainLocked();
+  previousDelegate()->flush();
+}
+
+AsyncSinkDelegate::Ring& AsyncSinkDelegate::threadRing() {
+  // Each thread caches the ring it has in the delegate it last logged to, so that only the first
+  // line a thread logs takes the rings mutex.
+  static thread_local uint64_t cached_id = 0;
+  static thread_local Ring* cached_ring = nullptr;
+  if (cached_id == id_) {
+    return *cached_ring;
+  }
+  absl::MutexLock lock(&rings_mutex_);
+  std::unique_ptr<Ring>& ring = rings_[std::this_thread::get_id()];
+  if (ring == nullptr) {
+    ring = std::make_unique<Ring>(ring_size_);
+  }
+  cached_id = id_;
+  cached_ring = ring.get();
+  return *ring;
+}
+
+void AsyncSinkDelegate::drainLoop() {
+  absl::MutexLock lock(&drain_mutex_);
+  while (!drain_mutex_.AwaitWithTimeout(absl::Condition(&shutdown_), drain_interval_)) {
+    drainLocked();
+  }
+}
+
+void AsyncSinkDelegate::drainLocked() {
+  {
+    absl::MutexLock lock(&rings_mutex_);
+    drain_rings_.clear();
+    for (const auto& [thread_id, ring] : rings_) {
+      drain_rings_.push_back(ring.get());
+    }
+  }
+  for (Ring* ring : drain_rings_) {
+    ring->drain([this](const Entry& entry) {
+      spdlog::details::log_msg log_msg(entry.time_, spdlog::source_loc{}, entry.logger_name_,
+                                       entry.level_, entry.msg_);
+      previousDelegate()->log(entry.msg_, log_msg);
+    });
+  }
+
+  const uint64_t dropped_messages = droppedMessages();
+  if (dropped_messages != reported_dropped_messages_) {
+    const std::string msg = fmt::format("[async log] dropped {} log lines{}",
+                                        dropped_messages - reported_dropped_messages_,
+                                        spdlog::details::os::default_eol);
+    spdlog::details::log_msg log_msg("async_log", spdlog::level::warn, msg);
+    previousDelegate()->log(msg, log_msg);
+    reported_dropped_messages_ = dropped_messages;
+  }
+}
+
 } // namespace Logger
 } // namespace Envoy
@@ -1,15 +1,22 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "envoy/access_log/access_log.h"
+#include "envoy/thread/thread.h"
 
 #include "source/common/common/logger.h"
 #include "source/common/common/macros.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 
 namespace Envoy {
 namespace Logger {
@@ -31,6 +38,87 @@ private:
   AccessLog::AccessLogFileSharedPtr log_file_;
 };
 
+/**
+ * What happens to a log line logged while the buffer of its thread is full.
+ */
+enum class AsyncLogOverflowPolicy {
+  // The line is dropped and counted.
+  Drop,
+  // The logging thread drains the buffers itself, then buffers the line.
+  Block,
+};
+
+/**
+ * SinkDelegate that buffers log lines in a lock-free ring per logging thread, and has a background
+ * thread write them to the previous delegate. Logging threads, including the ones logging through
+ * the fine-grain logger, then no longer contend on the locks of the underlying sink.
+ *
+ * Lines of one thread are written in order, but lines of different threads may be reordered. The
+ * log_msg handed to the previous delegate carries the formatted line as its payload.
+ */
+class AsyncSinkDelegate : public SinkDelegate {
+public:
+  static constexpr uint32_t DefaultRingSize = 4096;
+  static constexpr std::chrono::milliseconds DefaultDrainInterval{10};
+
+  AsyncSinkDelegate(DelegatingLogSinkSharedPtr log_sink, Thread::ThreadFactory& thread_factory,
+                    AsyncLogOverflowPolicy overflow_policy, uint32_t ring_size = DefaultRingSize,
+                    std::chrono::milliseconds drain_interval = DefaultDrainInterval);
+  ~AsyncSinkDelegate() override;
+
+  // SinkDelegate
+  void log(absl::string_view msg, const spdlog::details::log_msg& log_msg) override;
+  void flush() override;
+
+  /**
+   * @return the number of log lines dropped because the buffer of their thread was full.
+   */
+  uint64_t droppedMessages() const { return dropped_messages_.load(std::memory_order_relaxed); }
+
+private:
+  struct Entry {
+    std::string msg_;
+    std::string logger_name_;
+    spdlog::level::level_enum level_{};
+    spdlog::log_clock::time_point time_;
+  };
+
+  // Single producer, single consumer ring. The producer is the thread owning the ring, the
+  // consumer is whoever holds the drain mutex. Entries keep their capacity, so that buffering a
+  // line does not allocate once the ring has warmed up.
+  class Ring {
+  public:
+    explicit Ring(uint32_t size) : entries_(size) {}
+
+    bool push(absl::string_view msg, const spdlog::details::log_msg& log_msg);
+    template <class Fn> void drain(Fn fn);
+
+  private:
+    std::vector<Entry> entries_;
+    std::atomic<uint64_t> head_{0};
+    std::atomic<uint64_t> tail_{0};
+  };
+
+  Ring& threadRing();
+  void drainLoop();
+  void drainLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(drain_mutex_);
+
+  const uint64_t id_;
+  const AsyncLogOverflowPolicy overflow_policy_;
+  const uint32_t ring_size_;
+  const absl::Duration drain_interval_;
+  std::atomic<uint64_t> dropped_messages_{0};
+
+  absl::Mutex rings_mutex_;
+  absl::flat_hash_map<std::thread::id, std::unique_ptr<Ring>> rings_ ABSL_GUARDED_BY(rings_mutex_);
+
+  absl::Mutex drain_mutex_;
+  std::vector<Ring*> drain_rings_ ABSL_GUARDED_BY(drain_mutex_);
+  uint64_t reported_dropped_messages_ ABSL_GUARDED_BY(drain_mutex_){0};
+  bool shutdown_ ABSL_GUARDED_BY(drain_mutex_){false};
+  Thread::ThreadPtr drain_thread_;
+};
+
 } // namespace Logger
 
 } // namespace Envoy
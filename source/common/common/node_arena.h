@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+
+/**
+ * Arena for the nodes of a node based container, e.g. std::list. Nodes are carved out of chunks
+ * which grow geometrically up to MaxChunkNodes, so filling the container takes a handful of heap
+ * allocations instead of one per node. Released nodes are kept on a free list for reuse, and all
+ * chunks are freed at once when the arena is destroyed. The arena must outlive the container.
+ *
+ * The arena serves allocations of a single node, which is all that node based containers ask
+ * for. Allocations of any other size go directly to the heap. Not thread safe.
+ */
+class NodeArena : NonCopyable {
+public:
+  static constexpr size_t FirstChunkNodes = 4;
+  static constexpr size_t MaxChunkNodes = 64;
+
+  NodeArena() = default;
+  ~NodeArena() {
+    while (chunks_ != nullptr) {
+      Chunk* previous = chunks_->previous_;
+      ::operator delete(chunks_);
+      chunks_ = previous;
+    }
+  }
+
+  void* allocate(size_t size) {
+    if (node_size_ == 0) {
+      // The first allocation decides the size of the nodes.
+      node_size_ = size;
+      slot_size_ = std::max(size, sizeof(FreeNode));
+    }
+    if (size != node_size_) {
+      return ::operator new(size);
+    }
+    if (free_list_ != nullptr) {
+      FreeNode* node = free_list_;
+      free_list_ = node->next_;
+      return node;
+    }
+    if (next_ == end_) {
+      newChunk();
+    }
+    void* node = next_;
+    next_ += slot_size_;
+    return node;
+  }
+
+  void deallocate(void* node, size_t size) {
+    if (size != node_size_) {
+      ::operator delete(node);
+      return;
+    }
+    free_list_ = new (node) FreeNode{free_list_};
+  }
+
+private:
+  struct FreeNode {
+    FreeNode* next_;
+  };
+
+  // Chunks are linked through a header which is padded so that the nodes following it keep the
+  // alignment guaranteed by operator new.
+  struct alignas(std::max_align_t) Chunk {
+    Chunk* previous_;
+  };
+
+  void newChunk() {
+    const size_t nodes_size = next_chunk_nodes_ * slot_size_;
+    char* memory = static_cast<char*>(::operator new(sizeof(Chunk) + nodes_size));
+    chunks_ = new (memory) Chunk{chunks_};
+    next_ = memory + sizeof(Chunk);
+    end_ = next_ + nodes_size;
+    next_chunk_nodes_ = std::min(2 * next_chunk_nodes_, MaxChunkNodes);
+  }
+
+  size_t node_size_{};
+  size_t slot_size_{};
+  size_t next_chunk_nodes_{FirstChunkNodes};
+  FreeNode* free_list_{};
+  Chunk* chunks_{};
+  char* next_{};
+  char* end_{};
+};
+
+/**
+ * Standard allocator which allocates from a NodeArena.
+ */
+template <class T> class NodeArenaAllocator {
+public:
+  using value_type = T;
+
+  explicit NodeArenaAllocator(NodeArena& arena) : arena_(&arena) {}
+  template <class U>
+  NodeArenaAllocator(const NodeArenaAllocator<U>& other) : arena_(other.arena_) {} // NOLINT
+
+  T* allocate(size_t n) { return static_cast<T*>(arena_->allocate(n * sizeof(T))); }
+  void deallocate(T* p, size_t n) { arena_->deallocate(p, n * sizeof(T)); }
+
+  template <class U> bool operator==(const NodeArenaAllocator<U>& other) const {
+    return arena_ == other.arena_;
+  }
+
+private:
+  template <class U> friend class NodeArenaAllocator;
+
+  NodeArena* arena_;
+};
+
+} // namespace Envoy
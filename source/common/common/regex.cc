@@ -1,5 +1,7 @@
 #include "source/common/common/regex.h"
 
+#include <algorithm>
+
 #include "envoy/common/exception.h"
 #include "envoy/extensions/regex_engines/v3/google_re2.pb.h"
 #include "envoy/extensions/regex_engines/v3/google_re2.pb.validate.h"
@@ -15,13 +17,28 @@ namespace Regex {
 
 CompiledGoogleReMatcher::CompiledGoogleReMatcher(const std::string& regex,
                                                  bool do_program_size_check)
-    : regex_(regex, re2::RE2::Quiet) {
-  if (!regex_.ok()) {
-    throwEnvoyExceptionOrPanic(regex_.error());
+    : regex_(std::make_shared<const re2::RE2>(regex, re2::RE2::Quiet)) {
+  if (!regex_->ok()) {
+    throwEnvoyExceptionOrPanic(regex_->error());
+  }
+
+  if (do_program_size_check) {
+    checkProgramSize(regex);
+  }
+}
+
+CompiledGoogleReMatcher::CompiledGoogleReMatcher(std::shared_ptr<const re2::RE2> regex,
+                                                 bool do_program_size_check)
+    : regex_(std::move(regex)) {
+  ASSERT(regex_->ok());
+  if (do_program_size_check) {
+    checkProgramSize(regex_->pattern());
   }
+}
 
-  if (do_program_size_check && Runtime::isRuntimeInitialized()) {
-    const uint32_t regex_program_size = static_cast<uint32_t>(regex_.ProgramSize());
+void CompiledGoogleReMatcher::checkProgramSize(const std::string& regex) const {
+  if (Runtime::isRuntimeInitialized()) {
+    const uint32_t regex_program_size = static_cast<uint32_t>(regex_->ProgramSize());
     const uint32_t max_program_size_error_level =
         Runtime::getInteger("re2.max_program_size.error_level", 100);
     if (regex_program_size > max_program_size_error_level) {
@@ -46,7 +63,7 @@ CompiledGoogleReMatcher::CompiledGoogleReMatcher(const std::string& regex,
 CompiledGoogleReMatcher::CompiledGoogleReMatcher(
     const envoy::type::matcher::v3::RegexMatcher& config)
     : CompiledGoogleReMatcher(config.regex(), !config.google_re2().has_max_program_size()) {
-  const uint32_t regex_program_size = static_cast<uint32_t>(regex_.ProgramSize());
+  const uint32_t regex_program_size = static_cast<uint32_t>(regex_->ProgramSize());
 
   // Check if the deprecated field max_program_size is set first, and follow the old logic if so.
   if (config.google_re2().has_max_program_size()) {
@@ -62,7 +79,23 @@ CompiledGoogleReMatcher::CompiledGoogleReMatcher(
 }
 
 CompiledMatcherPtr GoogleReEngine::matcher(const std::string& regex) const {
-  return std::make_unique<CompiledGoogleReMatcher>(regex, true);
+  absl::MutexLock lock(&mutex_);
+  auto it = regexes_.find(regex);
+  if (it != regexes_.end()) {
+    std::shared_ptr<const re2::RE2> compiled = it->second.lock();
+    if (compiled != nullptr) {
+      return std::make_unique<CompiledGoogleReMatcher>(std::move(compiled), true);
+    }
+  }
+
+  // Throws if the regex is invalid, before it is remembered.
+  auto matcher = std::make_unique<CompiledGoogleReMatcher>(regex, true);
+  regexes_.insert_or_assign(regex, matcher->regex());
+  if (regexes_.size() >= next_prune_size_) {
+    absl::erase_if(regexes_, [](const auto& entry) { return entry.second.expired(); });
+    next_prune_size_ = std::max<size_t>(next_prune_size_, 2 * regexes_.size());
+  }
+  return matcher;
 }
 
 EnginePtr GoogleReEngineFactory::createEngine(const Protobuf::Message&,
@@ -12,6 +12,8 @@
 #include "source/common/singleton/threadsafe_singleton.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "re2/re2.h"
 #include "xds/type/matcher/v3/regex.pb.h"
 
@@ -22,28 +24,46 @@ class CompiledGoogleReMatcher : public CompiledMatcher {
 public:
   explicit CompiledGoogleReMatcher(const std::string& regex, bool do_program_size_check);
 
+  // Shares an already compiled regex, which must be valid.
+  CompiledGoogleReMatcher(std::shared_ptr<const re2::RE2> regex, bool do_program_size_check);
+
   explicit CompiledGoogleReMatcher(const xds::type::matcher::v3::RegexMatcher& config)
       : CompiledGoogleReMatcher(config.regex(), false) {}
 
   explicit CompiledGoogleReMatcher(const envoy::type::matcher::v3::RegexMatcher& config);
 
   // CompiledMatcher
-  bool match(absl::string_view value) const override { return re2::RE2::FullMatch(value, regex_); }
+  bool match(absl::string_view value) const override { return re2::RE2::FullMatch(value, *regex_); }
 
   // CompiledMatcher
   std::string replaceAll(absl::string_view value, absl::string_view substitution) const override {
     std::string result = std::string(value);
-    re2::RE2::GlobalReplace(&result, regex_, substitution);
+    re2::RE2::GlobalReplace(&result, *regex_, substitution);
     return result;
   }
 
+  const std::shared_ptr<const re2::RE2>& regex() const { return regex_; }
+
 private:
-  const re2::RE2 regex_;
+  void checkProgramSize(const std::string& regex) const;
+
+  const std::shared_ptr<const re2::RE2> regex_;
 };
 
+/**
+ * RE2 engine. Regexes are compiled once per pattern and shared by all the matchers using them for
+ * as long as any of those is alive, as configurations often repeat the same patterns many times.
+ */
 class GoogleReEngine : public Engine {
 public:
   CompiledMatcherPtr matcher(const std::string& regex) const override;
+
+private:
+  mutable absl::Mutex mutex_;
+  mutable absl::flat_hash_map<std::string, std::weak_ptr<const re2::RE2>>
+      regexes_ ABSL_GUARDED_BY(mutex_);
+  // The size of regexes_ at which patterns of released regexes are erased from it.
+  mutable size_t next_prune_size_ ABSL_GUARDED_BY(mutex_){64};
 };
 
 class GoogleReEngineFactory : public EngineFactory {
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Envoy {
+
+// The cache line size assumed when laying out data written by several threads. Shards aligned to
+// it do not share cache lines, so that threads writing to their own shard do not contend.
+constexpr size_t CacheLineSize = 64;
+
+/**
+ * @return the shard of the calling thread out of NumShards. Threads are assigned shards round robin
+ *         the first time they ask, and keep their shard for their lifetime.
+ */
+template <uint32_t NumShards> uint32_t threadShardIndex() {
+  static std::atomic<uint32_t> next_shard{0};
+  static thread_local const uint32_t shard = next_shard++ % NumShards;
+  return shard;
+}
+
+} // namespace Envoy
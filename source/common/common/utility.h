@@ -1,11 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <chrono>
 #include <cstdint>
 #include <ios>
+#include <numeric>
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "envoy/common/interval_set.h"
@@ -713,6 +717,142 @@ template <class Value> struct TrieLookupTable {
   TrieEntry<Value> root_;
 };
 
+/**
+ * A read only lookup table over a set of keys which is known when the table is built. The keys
+ * are placed with a perfect hash, so a lookup hashes the key once and compares it with at most
+ * one entry, independent of the size of the table and the length of the key.
+ *
+ * The keys are first split into buckets by their hash. Each bucket then gets the seed with which
+ * the hashes of all of its keys map to distinct free slots, starting with the largest bucket.
+ */
+template <class Value> class PerfectHashLookupTable {
+public:
+  PerfectHashLookupTable() : PerfectHashLookupTable(std::vector<std::pair<std::string, Value>>{}) {}
+
+  /**
+   * Builds the table.
+   * @param entries the keys and their values. The keys must be unique.
+   */
+  explicit PerfectHashLookupTable(std::vector<std::pair<std::string, Value>> entries) {
+    const size_t num_entries = std::max<size_t>(entries.size(), 1);
+    // Start with a load factor of 1/2 and grow the table until all buckets could be placed, which
+    // only takes more than one attempt for unlucky key sets.
+    for (size_t num_slots = 2 * std::bit_ceil(num_entries); num_slots <= 64 * num_entries;
+         num_slots *= 2) {
+      if (build(entries, std::bit_ceil(num_entries), num_slots)) {
+        return;
+      }
+    }
+    RELEASE_ASSERT(false, "unable to build perfect hash lookup table, duplicate keys?");
+  }
+
+  /**
+   * Finds the value associated with the key.
+   * @param key the key used to find.
+   * @return the value associated with the key or nullptr if there is none.
+   */
+  const Value* find(absl::string_view key) const {
+    const uint64_t hash = HashUtil::xxHash64(key);
+    const Slot& slot = slots_[slotIndex(hash, seeds_[hash & bucket_mask_], slot_mask_)];
+    return slot.used_ && slot.key_ == key ? &slot.value_ : nullptr;
+  }
+
+  /**
+   * @return the number of entries in the table.
+   */
+  size_t size() const { return size_; }
+
+private:
+  struct Slot {
+    std::string key_;
+    Value value_{};
+    bool used_{};
+  };
+
+  // Bounds the search for the seed of a bucket before the table is grown.
+  static constexpr uint32_t MaxSeedAttempts = 1 << 12;
+
+  static size_t slotIndex(uint64_t hash, uint32_t seed, uint64_t slot_mask) {
+    // Mixes the seed into the hash with the finalizer of MurmurHash3.
+    uint64_t mixed = hash ^ (seed * 0x9e3779b97f4a7c15);
+    mixed ^= mixed >> 33;
+    mixed *= 0xff51afd7ed558ccd;
+    mixed ^= mixed >> 33;
+    return mixed & slot_mask;
+  }
+
+  bool build(const std::vector<std::pair<std::string, Value>>& entries, size_t num_buckets,
+             size_t num_slots) {
+    const uint64_t bucket_mask = num_buckets - 1;
+    const uint64_t slot_mask = num_slots - 1;
+    std::vector<uint64_t> hashes;
+    hashes.reserve(entries.size());
+    std::vector<std::vector<size_t>> buckets(num_buckets);
+    for (size_t i = 0; i < entries.size(); ++i) {
+      hashes.push_back(HashUtil::xxHash64(entries[i].first));
+      buckets[hashes.back() & bucket_mask].push_back(i);
+    }
+
+    std::vector<size_t> bucket_order(num_buckets);
+    std::iota(bucket_order.begin(), bucket_order.end(), 0);
+    std::stable_sort(bucket_order.begin(), bucket_order.end(), [&buckets](size_t a, size_t b) {
+      return buckets[a].size() > buckets[b].size();
+    });
+
+    std::vector<uint32_t> seeds(num_buckets);
+    std::vector<bool> used(num_slots);
+    std::vector<size_t> bucket_slots;
+    for (const size_t bucket : bucket_order) {
+      if (buckets[bucket].empty()) {
+        break;
+      }
+      bool placed = false;
+      for (uint32_t seed = 0; seed < MaxSeedAttempts && !placed; ++seed) {
+        bucket_slots.clear();
+        placed = true;
+        for (const size_t entry : buckets[bucket]) {
+          const size_t slot = slotIndex(hashes[entry], seed, slot_mask);
+          if (used[slot] || std::find(bucket_slots.begin(), bucket_slots.end(), slot) !=
+                                bucket_slots.end()) {
+            placed = false;
+            break;
+          }
+          bucket_slots.push_back(slot);
+        }
+        if (placed) {
+          seeds[bucket] = seed;
+          for (const size_t slot : bucket_slots) {
+            used[slot] = true;
+          }
+        }
+      }
+      if (!placed) {
+        return false;
+      }
+    }
+
+    slots_ = std::vector<Slot>(num_slots);
+    for (size_t i = 0; i < entries.size(); ++i) {
+      const uint64_t hash = hashes[i];
+      Slot& slot = slots_[slotIndex(hash, seeds[hash & bucket_mask], slot_mask)];
+      slot.key_ = entries[i].first;
+      slot.value_ = entries[i].second;
+      slot.used_ = true;
+    }
+    seeds_ = std::move(seeds);
+    bucket_mask_ = bucket_mask;
+    slot_mask_ = slot_mask;
+    size_ = entries.size();
+    return true;
+  }
+
+  std::vector<uint32_t> seeds_;
+  std::vector<Slot> slots_;
+  uint64_t bucket_mask_{};
+  uint64_t slot_mask_{};
+  size_t size_{};
+};
+
 /**
  * A global utility class to take care of all the exception throwing behaviors in header files.
  * Its functions simply forward the throwing into .cc file.
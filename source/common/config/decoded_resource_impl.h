@@ -4,6 +4,7 @@
 #include "envoy/config/subscription.h"
 #include "envoy/service/discovery/v3/discovery.pb.h"
 
+#include "source/common/common/hash.h"
 #include "source/common/protobuf/utility.h"
 
 #include "xds/core/v3/collection_entry.pb.h"
@@ -31,12 +32,15 @@ public:
                                              const ProtobufWkt::Any& resource,
                                              const std::string& version) {
     if (resource.Is<envoy::service::discovery::v3::Resource>()) {
-      envoy::service::discovery::v3::Resource r;
-      MessageUtil::unpackTo(resource, r);
+      // The wrapper is only needed until the wrapped resource is decoded, so all of its fields
+      // are allocated on an arena rather than one by one on the heap.
+      Protobuf::Arena arena;
+      auto* r = Protobuf::Arena::Create<envoy::service::discovery::v3::Resource>(&arena);
+      MessageUtil::unpackTo(resource, *r);
 
-      r.set_version(version);
+      r->set_version(version);
 
-      return std::make_unique<DecodedResourceImpl>(resource_decoder, r);
+      return std::make_unique<DecodedResourceImpl>(resource_decoder, *r);
     }
 
     return std::unique_ptr<DecodedResourceImpl>(new DecodedResourceImpl(
@@ -67,7 +71,8 @@ public:
   DecodedResourceImpl(ProtobufTypes::MessagePtr resource, const std::string& name,
                       const std::vector<std::string>& aliases, const std::string& version)
       : resource_(std::move(resource)), has_resource_(true), name_(name), aliases_(aliases),
-        version_(version), ttl_(absl::nullopt), metadata_(absl::nullopt) {}
+        version_(version), ttl_(absl::nullopt), metadata_(absl::nullopt),
+        serialized_hash_(absl::nullopt) {}
 
   // Config::DecodedResource
   const std::string& name() const override { return name_; }
@@ -79,6 +84,7 @@ public:
   const OptRef<const envoy::config::core::v3::Metadata> metadata() const override {
     return metadata_.has_value() ? makeOptRef(metadata_.value()) : absl::nullopt;
   }
+  absl::optional<uint64_t> serializedHash() const override { return serialized_hash_; }
 
 private:
   DecodedResourceImpl(OpaqueResourceDecoder& resource_decoder, absl::optional<std::string> name,
@@ -89,7 +95,9 @@ private:
       : resource_(resource_decoder.decodeResource(resource)), has_resource_(has_resource),
         name_(name ? *name : resource_decoder.resourceName(*resource_)),
         aliases_(repeatedPtrFieldToVector(aliases)), version_(version), ttl_(ttl),
-        metadata_(metadata) {}
+        metadata_(metadata),
+        serialized_hash_(has_resource ? absl::make_optional(HashUtil::xxHash64(resource.value()))
+                                      : absl::nullopt) {}
 
   const ProtobufTypes::MessagePtr resource_;
   const bool has_resource_;
@@ -102,6 +110,10 @@ private:
   // This is the metadata info under the Resource wrapper.
   // It is intended to be consumed in the xds_config_tracker extension.
   const absl::optional<envoy::config::core::v3::Metadata> metadata_;
+
+  // Hashing the serialized resource is much cheaper than hashing the decoded message, and lets
+  // consumers skip resources which the management server resent unchanged.
+  const absl::optional<uint64_t> serialized_hash_;
 };
 
 struct DecodedResourcesWrapper {
@@ -165,7 +165,7 @@ TagNameValues::TagNameValues() {
   addRe2(
       WORKER_ID,
       R"(^(?:listener\.(?:<ADDRESS>|<TAG_VALUE>)\.|server\.|listener_manager\.)worker_((\d+)\.))",
-      "");
+      "worker_");
 
   // listener.(<address|stat_prefix>.)*, but specifically excluding "admin"
   addRe2(LISTENER_ADDRESS, R"(^listener\.((<ADDRESS>|<TAG_VALUE>)\.))", "", "admin");
@@ -1,5 +1,7 @@
 #include "source/common/conn_pool/conn_pool_base.h"
 
+#include <cmath>
+
 #include "source/common/common/assert.h"
 #include "source/common/common/debug_recursion_checker.h"
 #include "source/common/network/transport_socket_options_impl.h"
@@ -17,6 +19,15 @@ namespace {
   }
   return ret;
 }
+
+// The weight given to the latest sample in the adaptive preconnect moving averages.
+constexpr double AdaptivePreconnectEwmaAlpha = 0.2;
+
+void updateEwma(double& average, double sample) {
+  average = average == 0 ? sample
+                         : AdaptivePreconnectEwmaAlpha * sample +
+                               (1 - AdaptivePreconnectEwmaAlpha) * average;
+}
 } // namespace
 
 ConnPoolImplBase::ConnPoolImplBase(
@@ -97,8 +108,17 @@ bool ConnPoolImplBase::shouldCreateNewConnection(float global_preconnect_ratio)
     // Local preconnect does not need to anticipate a stream. It is called as
     // new streams are established or torn down and simply attempts to maintain
     // the correct ratio of streams and anticipated capacity.
-    return shouldConnect(pending_streams_.size(), num_active_streams_, connecting_stream_capacity_,
-                         perUpstreamPreconnectRatio());
+    if (shouldConnect(pending_streams_.size(), num_active_streams_, connecting_stream_capacity_,
+                      perUpstreamPreconnectRatio())) {
+      return true;
+    }
+    // With adaptive preconnect, also keep enough spare capacity for the streams expected to
+    // arrive while one more connection is being established. As with the preconnect ratio, this
+    // is only done while the pool has traffic.
+    return host_->cluster().adaptivePreconnect() &&
+           (num_active_streams_ > 0 || !pending_streams_.empty()) &&
+           pending_streams_.size() + adaptivePreconnectStreams() >
+               connecting_stream_capacity_ + readyStreamCapacity();
   }
 }
 
@@ -106,6 +126,42 @@ float ConnPoolImplBase::perUpstreamPreconnectRatio() const {
   return host_->cluster().perUpstreamPreconnectRatio();
 }
 
+uint32_t ConnPoolImplBase::adaptivePreconnectStreams() const {
+  if (connect_latency_ewma_ms_ == 0) {
+    return 0;
+  }
+  if (stream_interval_ewma_ms_ == 0) {
+    // Streams have arrived faster than the clock resolution. Anticipate one stream per
+    // millisecond of connect latency.
+    return std::ceil(connect_latency_ewma_ms_);
+  }
+  return std::ceil(connect_latency_ewma_ms_ / stream_interval_ewma_ms_);
+}
+
+void ConnPoolImplBase::onStreamArrivalForAdaptivePreconnect() {
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  if (last_stream_arrival_.has_value()) {
+    const std::chrono::duration<double, std::milli> interval = now - last_stream_arrival_.value();
+    updateEwma(stream_interval_ewma_ms_, interval.count());
+  }
+  last_stream_arrival_ = now;
+}
+
+void ConnPoolImplBase::onConnectLatencyForAdaptivePreconnect(std::chrono::milliseconds latency) {
+  // Count at least a millisecond so that a connection which was established is never mistaken for
+  // the absence of a sample.
+  updateEwma(connect_latency_ewma_ms_, std::max<double>(latency.count(), 1));
+}
+
+void ConnPoolImplBase::updateReadyStreamCapacity(ActiveClient& client) {
+  const uint64_t capacity = client.state() == ActiveClient::State::Ready
+                                ? std::max<int64_t>(client.currentUnusedCapacity(), 0)
+                                : 0;
+  ASSERT(ready_stream_capacity_ >= client.ready_stream_capacity_);
+  ready_stream_capacity_ = ready_stream_capacity_ - client.ready_stream_capacity_ + capacity;
+  client.ready_stream_capacity_ = capacity;
+}
+
 ConnPoolImplBase::ConnectionResult ConnPoolImplBase::tryCreateNewConnections() {
   ConnPoolImplBase::ConnectionResult result;
   // Somewhat arbitrarily cap the number of connections preconnected due to new
@@ -208,6 +264,7 @@ void ConnPoolImplBase::attachStreamToClient(Envoy::ConnectionPool::ActiveClient&
   host_->cluster().resourceManager(priority_).requests().inc();
 
   onPoolReady(client, context);
+  updateReadyStreamCapacity(client);
 }
 
 void ConnPoolImplBase::onStreamClosed(Envoy::ConnectionPool::ActiveClient& client,
@@ -250,6 +307,7 @@ void ConnPoolImplBase::onStreamClosed(Envoy::ConnectionPool::ActiveClient& clien
       }
     }
   }
+  updateReadyStreamCapacity(client);
 }
 
 ConnectionPool::Cancellable* ConnPoolImplBase::newStreamImpl(AttachContext& context,
@@ -257,6 +315,10 @@ ConnectionPool::Cancellable* ConnPoolImplBase::newStreamImpl(AttachContext& cont
   ASSERT(!is_draining_for_deletion_);
   ASSERT(!deferred_deleting_);
 
+  if (host_->cluster().adaptivePreconnect()) {
+    onStreamArrivalForAdaptivePreconnect();
+  }
+
   ASSERT(static_cast<ssize_t>(connecting_stream_capacity_) ==
          connectingCapacity(connecting_clients_) +
              connectingCapacity(early_data_clients_)); // O(n) debug check.
@@ -367,6 +429,7 @@ void ConnPoolImplBase::transitionActiveClientState(ActiveClient& client,
   if (&old_list != &new_list) {
     client.moveBetweenLists(old_list, new_list);
   }
+  updateReadyStreamCapacity(client);
 }
 
 void ConnPoolImplBase::addIdleCallbackImpl(Instance::IdleCb cb) { idle_callbacks_.push_back(cb); }
@@ -560,6 +623,7 @@ void ConnPoolImplBase::onConnectionEvent(ActiveClient& client, absl::string_view
     checkForIdleAndNotify();
 
     client.setState(ActiveClient::State::Closed);
+    updateReadyStreamCapacity(client);
 
     // If we have pending streams and we just lost a connection we should make a new one.
     if (!pending_streams_.empty()) {
@@ -575,6 +639,9 @@ void ConnPoolImplBase::onConnectionEvent(ActiveClient& client, absl::string_view
     ASSERT(connecting_stream_capacity_ >= client.currentUnusedCapacity());
     connecting_stream_capacity_ -= client.currentUnusedCapacity();
     client.has_handshake_completed_ = true;
+    if (host_->cluster().adaptivePreconnect()) {
+      onConnectLatencyForAdaptivePreconnect(client.conn_connect_ms_->elapsed());
+    }
     client.conn_connect_ms_->complete();
     client.conn_connect_ms_.reset();
     if (client.state() == ActiveClient::State::Connecting ||
@@ -711,6 +778,7 @@ void ConnPoolImplBase::decrConnectingAndConnectedStreamCapacity(uint32_t delta,
     ASSERT(connecting_stream_capacity_ >= delta);
     connecting_stream_capacity_ -= delta;
   }
+  updateReadyStreamCapacity(client);
 }
 
 void ConnPoolImplBase::incrConnectingAndConnectedStreamCapacity(uint32_t delta,
@@ -719,6 +787,7 @@ void ConnPoolImplBase::incrConnectingAndConnectedStreamCapacity(uint32_t delta,
   if (!client.hasHandshakeCompleted()) {
     connecting_stream_capacity_ += delta;
   }
+  updateReadyStreamCapacity(client);
 }
 
 void ConnPoolImplBase::onUpstreamReadyForEarlyData(ActiveClient& client) {
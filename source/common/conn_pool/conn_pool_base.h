@@ -11,6 +11,7 @@
 #include "source/common/common/linked_object.h"
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "fmt/ostream.h"
 
 namespace Envoy {
@@ -141,6 +142,8 @@ public:
   // and can be adjusted by SETTINGS frame, but the max value of it can't exceed
   // `configured_stream_limit_`.
   uint32_t concurrent_stream_limit_;
+  // The unused stream capacity of this client counted in the ready stream capacity of the pool.
+  uint64_t ready_stream_capacity_{};
   Upstream::HostDescriptionConstSharedPtr real_host_description_;
   Stats::TimespanPtr conn_connect_ms_;
   Stats::TimespanPtr conn_length_;
@@ -307,6 +310,9 @@ public:
 
   void decrConnectingAndConnectedStreamCapacity(uint32_t delta, ActiveClient& client);
   void incrConnectingAndConnectedStreamCapacity(uint32_t delta, ActiveClient& client);
+  // Updates the ready stream capacity after the state or the unused capacity of the client
+  // changed.
+  void updateReadyStreamCapacity(ActiveClient& client);
 
   // Called when an upstream is ready to serve pending streams.
   void onUpstreamReady();
@@ -345,6 +351,14 @@ protected:
 
   float perUpstreamPreconnectRatio() const;
 
+  // Returns the number of streams expected to arrive while a new connection is established, based
+  // on the stream inter-arrival time and connect latency moving averages. Only meaningful if the
+  // cluster has adaptive preconnect enabled.
+  uint32_t adaptivePreconnectStreams() const;
+
+  // The stream capacity still unused on connections which are ready for new streams.
+  uint64_t readyStreamCapacity() const { return ready_stream_capacity_; }
+
   ConnectionPool::Cancellable*
   addPendingStream(Envoy::ConnectionPool::PendingStreamPtr&& pending_stream) {
     LinkedList::moveIntoList(std::move(pending_stream), pending_streams_);
@@ -396,6 +410,10 @@ private:
   // Prerequisite: the given clients shouldn't be idle.
   void drainClients(std::list<ActiveClientPtr>& clients);
 
+  // Updates the adaptive preconnect moving averages.
+  void onStreamArrivalForAdaptivePreconnect();
+  void onConnectLatencyForAdaptivePreconnect(std::chrono::milliseconds latency);
+
   std::list<PendingStreamPtr> pending_streams_;
 
   // The number of streams currently attached to clients.
@@ -408,6 +426,15 @@ private:
   // True iff this object is in the deferred delete list.
   bool deferred_deleting_{false};
 
+  // Moving averages of the time between new streams and of the time to establish a connection,
+  // used for adaptive preconnect. Zero until the first sample.
+  absl::optional<MonotonicTime> last_stream_arrival_;
+  double stream_interval_ewma_ms_{0};
+  double connect_latency_ewma_ms_{0};
+  // The sum of the unused stream capacity of the ready clients, kept up to date as clients change
+  // state and attach or release streams.
+  uint64_t ready_stream_capacity_{0};
+
   Event::SchedulableCallbackPtr upstream_ready_cb_;
   Common::DebugRecursionChecker recursion_checker_;
 };
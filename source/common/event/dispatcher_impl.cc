@@ -131,6 +131,8 @@ void DispatcherImpl::clearDeferredDeleteList() {
 
   touchWatchdog();
   deferred_deleting_ = true;
+  DispatcherStats* stats = stats_.get();
+  const MonotonicTime start = stats != nullptr ? time_source_.monotonicTime() : MonotonicTime();
 
   // Calling clear() on the vector does not specify which order destructors run in. We want to
   // destroy in FIFO order so just do it manually. This required 2 passes over the vector which is
@@ -141,6 +143,11 @@ void DispatcherImpl::clearDeferredDeleteList() {
 
   to_delete->clear();
   deferred_deleting_ = false;
+  if (stats != nullptr) {
+    stats->deferred_delete_duration_us_.recordValue(
+        std::chrono::duration_cast<std::chrono::microseconds>(time_source_.monotonicTime() - start)
+            .count());
+  }
 }
 
 Network::ServerConnectionPtr
@@ -347,6 +354,10 @@ void DispatcherImpl::runPostCallbacks() {
     // post_callbacks_ should be empty after the move.
     ASSERT(post_callbacks_.empty());
   }
+  // The stats may be initialized by one of the callbacks, in which case this batch is not recorded.
+  DispatcherStats* stats = stats_.get();
+  const size_t num_callbacks = callbacks.size();
+  const MonotonicTime start = stats != nullptr ? time_source_.monotonicTime() : MonotonicTime();
   // It is important that the execution and deletion of the callback happen while post_lock_ is not
   // held. Either the invocation or destructor of the callback can call post() on this dispatcher.
   while (!callbacks.empty()) {
@@ -359,6 +370,12 @@ void DispatcherImpl::runPostCallbacks() {
     // callback executes.
     callbacks.pop_front();
   }
+  if (stats != nullptr) {
+    stats->post_queue_size_.recordValue(num_callbacks);
+    stats->post_duration_us_.recordValue(
+        std::chrono::duration_cast<std::chrono::microseconds>(time_source_.monotonicTime() - start)
+            .count());
+  }
 }
 
 void DispatcherImpl::onFatalError(std::ostream& os) const {
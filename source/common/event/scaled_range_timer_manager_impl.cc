@@ -29,6 +29,11 @@ namespace Event {
  * timer in the scaling-max state will logically execute the transition sequence
  * [scaling-max -> inactive -> waiting-for-min -> scaling-max] in a single
  * method call. The waiting-for-min transitions are elided for efficiency.
+ *
+ * Timers whose min equals their max can't be scaled. They skip waiting-for-min
+ * and go straight to the scaling-max state in an unscaled queue, as appending
+ * to and removing from a queue is cheaper than re-arming a real timer each
+ * time the timer is enabled (e.g. stream idle timers on every data frame).
  */
 class ScaledRangeTimerManagerImpl::RangeTimerImpl final : public Timer {
 public:
@@ -61,8 +66,10 @@ public:
     if (min_ms <= std::chrono::milliseconds::zero()) {
       // If the duration spread (max - min) is zero, skip over the waiting-for-min and straight to
       // the scaling-max state.
-      auto handle = manager_.activateTimer(max_ms, *this);
+      auto handle = manager_.activateTimer(max_ms, *this, true);
       state_.emplace<ScalingMax>(handle);
+    } else if (min_ms == max_ms) {
+      state_.emplace<ScalingMax>(manager_.activateTimer(max_ms, *this, false));
     } else {
       state_.emplace<WaitingForMin>(max_ms - min_ms);
       min_duration_timer_->enableTimer(std::min(max_ms, min_ms));
@@ -124,7 +131,8 @@ private:
     if (waiting.scalable_duration_ < std::chrono::milliseconds::zero()) {
       trigger();
     } else {
-      state_.emplace<ScalingMax>(manager_.activateTimer(waiting.scalable_duration_, *this));
+      state_.emplace<ScalingMax>(
+          manager_.activateTimer(waiting.scalable_duration_, *this, true));
     }
   }
 
@@ -148,6 +156,7 @@ ScaledRangeTimerManagerImpl::~ScaledRangeTimerManagerImpl() {
   // Scaled timers created by the manager shouldn't outlive it. This is
   // necessary but not sufficient to guarantee that.
   ASSERT(queues_.empty());
+  ASSERT(unscaled_queues_.empty());
 }
 
 TimerPtr ScaledRangeTimerManagerImpl::createTimer(ScaledTimerType timer_type, TimerCb callback) {
@@ -174,10 +183,10 @@ void ScaledRangeTimerManagerImpl::setScaleFactor(UnitFloat scale_factor) {
 ScaledRangeTimerManagerImpl::Queue::Item::Item(RangeTimerImpl& timer, MonotonicTime active_time)
     : timer_(timer), active_time_(active_time) {}
 
-ScaledRangeTimerManagerImpl::Queue::Queue(std::chrono::milliseconds duration,
+ScaledRangeTimerManagerImpl::Queue::Queue(std::chrono::milliseconds duration, bool scaled,
                                           ScaledRangeTimerManagerImpl& manager,
                                           Dispatcher& dispatcher)
-    : duration_(duration),
+    : duration_(duration), scaled_(scaled),
       timer_(dispatcher.createTimer([this, &manager] { manager.onQueueTimerFired(*this); })) {}
 
 ScaledRangeTimerManagerImpl::ScalingTimerHandle::ScalingTimerHandle(Queue& queue,
@@ -191,18 +200,28 @@ MonotonicTime ScaledRangeTimerManagerImpl::computeTriggerTime(const Queue::Item&
          std::chrono::duration_cast<MonotonicTime::duration>(duration * scale_factor.value());
 }
 
+MonotonicTime ScaledRangeTimerManagerImpl::computeTriggerTime(const Queue& queue) const {
+  return computeTriggerTime(queue.range_timers_.front(), queue.duration_,
+                            queue.scaled_ ? scale_factor_ : UnitFloat::max());
+}
+
+ScaledRangeTimerManagerImpl::QueueSet& ScaledRangeTimerManagerImpl::queuesFor(bool scaled) {
+  return scaled ? queues_ : unscaled_queues_;
+}
+
 ScaledRangeTimerManagerImpl::ScalingTimerHandle
 ScaledRangeTimerManagerImpl::activateTimer(std::chrono::milliseconds duration,
-                                           RangeTimerImpl& range_timer) {
+                                           RangeTimerImpl& range_timer, bool scaled) {
   // Ensure this is being called on the same dispatcher.
   ASSERT(dispatcher_.isThreadSafe());
 
   // Find the matching queue for the (max - min) duration of the range timer; if there isn't one,
   // create it.
-  auto it = queues_.find(duration);
-  if (it == queues_.end()) {
-    auto queue = std::make_unique<Queue>(duration, *this, dispatcher_);
-    it = queues_.emplace(std::move(queue)).first;
+  QueueSet& queues = queuesFor(scaled);
+  auto it = queues.find(duration);
+  if (it == queues.end()) {
+    auto queue = std::make_unique<Queue>(duration, scaled, *this, dispatcher_);
+    it = queues.emplace(std::move(queue)).first;
   }
   Queue& queue = **it;
 
@@ -228,7 +247,7 @@ void ScaledRangeTimerManagerImpl::removeTimer(ScalingTimerHandle handle) {
     // Skip erasing the queue if we're in the middle of processing timers for the queue. The
     // queue will be erased in `onQueueTimerFired` after the queue entries have been processed.
     if (!handle.queue_.processing_timers_) {
-      queues_.erase(handle.queue_);
+      queuesFor(handle.queue_.scaled_).erase(handle.queue_);
     }
     return;
   }
@@ -242,8 +261,7 @@ void ScaledRangeTimerManagerImpl::removeTimer(ScalingTimerHandle handle) {
 
 void ScaledRangeTimerManagerImpl::resetQueueTimer(Queue& queue, MonotonicTime now) {
   ASSERT(!queue.range_timers_.empty());
-  const MonotonicTime trigger_time =
-      computeTriggerTime(queue.range_timers_.front(), queue.duration_, scale_factor_);
+  const MonotonicTime trigger_time = computeTriggerTime(queue);
   if (trigger_time < now) {
     queue.timer_->enableTimer(std::chrono::milliseconds::zero());
   } else {
@@ -260,8 +278,7 @@ void ScaledRangeTimerManagerImpl::onQueueTimerFired(Queue& queue) {
   // Pop and trigger timers until the one at the front isn't supposed to have expired yet (given the
   // current scale factor).
   queue.processing_timers_ = true;
-  while (!timers.empty() &&
-         computeTriggerTime(timers.front(), queue.duration_, scale_factor_) <= now) {
+  while (!timers.empty() && computeTriggerTime(queue) <= now) {
     auto item = std::move(queue.range_timers_.front());
     queue.range_timers_.pop_front();
     item.timer_.trigger();
@@ -270,7 +287,7 @@ void ScaledRangeTimerManagerImpl::onQueueTimerFired(Queue& queue) {
 
   if (queue.range_timers_.empty()) {
     // Maintain the invariant that queues are never empty.
-    queues_.erase(queue);
+    queuesFor(queue.scaled_).erase(queue);
   } else {
     resetQueueTimer(queue, now);
   }
@@ -20,6 +20,9 @@ namespace Event {
  * expectation is that the number of (max - min) values used to enable timers is small, so the
  * number of queues is tightly bounded. The queue-based implementation depends on that expectation
  * for efficient operation.
+ *
+ * Timers with equal min and max durations can't be scaled. They are tracked by separate queues of
+ * their max duration, which ignore the scale factor.
  */
 class ScaledRangeTimerManagerImpl : public ScaledRangeTimerManager {
 public:
@@ -49,12 +52,16 @@ private:
     // Typedef for convenience.
     using Iterator = std::list<Item>::iterator;
 
-    Queue(std::chrono::milliseconds duration, ScaledRangeTimerManagerImpl& manager,
+    Queue(std::chrono::milliseconds duration, bool scaled, ScaledRangeTimerManagerImpl& manager,
           Dispatcher& dispatcher);
 
-    // The (max - min) value for all timers in range_timers_.
+    // The (max - min) value for all timers in range_timers_, or their max value if the queue is
+    // not scaled.
     const std::chrono::milliseconds duration_;
 
+    // Whether duration_ is scaled by the scale factor of the manager.
+    const bool scaled_;
+
     // The list of active timers in this queue. This is implemented as a
     // std::list so that the iterators held in ScalingTimerHandle instances are
     // not invalidated by removal or insertion of other timers. The timers in
@@ -110,11 +117,19 @@ private:
     }
   };
 
+  using QueueSet = absl::flat_hash_set<std::unique_ptr<Queue>, Hash, Eq>;
+
   static MonotonicTime computeTriggerTime(const Queue::Item& item,
                                           std::chrono::milliseconds duration,
                                           UnitFloat scale_factor);
 
-  ScalingTimerHandle activateTimer(std::chrono::milliseconds duration, RangeTimerImpl& timer);
+  // Returns the trigger time of the first timer of a non-empty queue.
+  MonotonicTime computeTriggerTime(const Queue& queue) const;
+
+  QueueSet& queuesFor(bool scaled);
+
+  ScalingTimerHandle activateTimer(std::chrono::milliseconds duration, RangeTimerImpl& timer,
+                                   bool scaled);
 
   void removeTimer(ScalingTimerHandle handle);
 
@@ -125,7 +140,8 @@ private:
   Dispatcher& dispatcher_;
   const ScaledTimerTypeMapConstSharedPtr timer_minimums_;
   UnitFloat scale_factor_;
-  absl::flat_hash_set<std::unique_ptr<Queue>, Hash, Eq> queues_;
+  QueueSet queues_;
+  QueueSet unscaled_queues_;
 };
 
 } // namespace Event
@@ -1,5 +1,11 @@
 #include "source/common/formatter/substitution_formatter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "fmt/format.h"
+
 namespace Envoy {
 namespace Formatter {
 
@@ -54,5 +60,78 @@ const std::regex& SubstitutionFormatParser::commandWithArgsRegex() {
   // clang-format on
 }
 
+void JsonFormatterUtil::appendString(std::string& out, absl::string_view str,
+                                     std::string& sanitize_buffer) {
+  out.push_back('"');
+  const absl::string_view sanitized = Json::sanitize(sanitize_buffer, str);
+  out.append(sanitized.data(), sanitized.size());
+  out.push_back('"');
+}
+
+void JsonFormatterUtil::appendNumber(std::string& out, double number) {
+  if (!std::isfinite(number)) {
+    out.append("null");
+    return;
+  }
+  // The shortest representation which reads back as the same number, as the protobuf JSON printer
+  // produces, e.g. 200 rather than 200.0.
+  fmt::format_to(std::back_inserter(out), "{}", number);
+}
+
+void JsonFormatterUtil::appendValue(std::string& out, const ProtobufWkt::Value& value,
+                                    bool sort_properties, std::string& sanitize_buffer) {
+  switch (value.kind_case()) {
+  case ProtobufWkt::Value::kNumberValue:
+    appendNumber(out, value.number_value());
+    break;
+  case ProtobufWkt::Value::kStringValue:
+    appendString(out, value.string_value(), sanitize_buffer);
+    break;
+  case ProtobufWkt::Value::kBoolValue:
+    out.append(value.bool_value() ? "true" : "false");
+    break;
+  case ProtobufWkt::Value::kStructValue: {
+    const auto& fields = value.struct_value().fields();
+    std::vector<std::pair<absl::string_view, const ProtobufWkt::Value*>> ordered;
+    ordered.reserve(fields.size());
+    for (const auto& field : fields) {
+      ordered.emplace_back(field.first, &field.second);
+    }
+    if (sort_properties) {
+      std::sort(ordered.begin(), ordered.end());
+    }
+    out.push_back('{');
+    bool first = true;
+    for (const auto& [name, field_value] : ordered) {
+      if (!first) {
+        out.push_back(',');
+      }
+      first = false;
+      appendString(out, name, sanitize_buffer);
+      out.push_back(':');
+      appendValue(out, *field_value, sort_properties, sanitize_buffer);
+    }
+    out.push_back('}');
+    break;
+  }
+  case ProtobufWkt::Value::kListValue: {
+    out.push_back('[');
+    bool first = true;
+    for (const auto& element : value.list_value().values()) {
+      if (!first) {
+        out.push_back(',');
+      }
+      first = false;
+      appendValue(out, element, sort_properties, sanitize_buffer);
+    }
+    out.push_back(']');
+    break;
+  }
+  default:
+    out.append("null");
+    break;
+  }
+}
+
 } // namespace Formatter
 } // namespace Envoy
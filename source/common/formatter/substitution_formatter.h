@@ -15,8 +15,10 @@
 #include "source/common/formatter/http_specific_formatter.h"
 #include "source/common/formatter/stream_info_formatter.h"
 #include "source/common/json/json_loader.h"
+#include "source/common/json/json_sanitizer.h"
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -381,6 +383,37 @@ private:
 template <class FormatterContext>
 using StructFormatterBasePtr = std::unique_ptr<StructFormatterBase<FormatterContext>>;
 
+/**
+ * Helpers for rendering the values of a JSON access log entry.
+ */
+class JsonFormatterUtil {
+public:
+  /**
+   * Appends a quoted JSON string.
+   * @param out the log line to append to.
+   * @param str the string, which is escaped as needed.
+   * @param sanitize_buffer scratch space for escaping str.
+   */
+  static void appendString(std::string& out, absl::string_view str, std::string& sanitize_buffer);
+
+  /**
+   * Appends a JSON number. Numbers which JSON cannot represent, such as NaN, are rendered as null.
+   */
+  static void appendNumber(std::string& out, double number);
+
+  /**
+   * Appends the JSON rendering of a value returned by a formatter.
+   * @param sort_properties whether the fields of struct values are rendered in key order.
+   */
+  static void appendValue(std::string& out, const ProtobufWkt::Value& value, bool sort_properties,
+                          std::string& sanitize_buffer);
+};
+
+/**
+ * A formatter for JSON log formats. The format is compiled into a flat list of instructions once,
+ * with keys and constant values already rendered to JSON, so that formatting a log entry only has
+ * to render the values of its formatters into the log line.
+ */
 template <class FormatterContext>
 class CommonJsonFormatterBaseImpl : public FormatterBase<FormatterContext> {
 public:
@@ -389,31 +422,200 @@ public:
   CommonJsonFormatterBaseImpl(const ProtobufWkt::Struct& format_mapping, bool preserve_types,
                               bool omit_empty_values, bool sort_properties,
                               const CommandParsers& commands = {})
-      : struct_formatter_(format_mapping, preserve_types, omit_empty_values, commands),
-        sort_properties_(sort_properties) {}
+      : omit_empty_values_(omit_empty_values), preserve_types_(preserve_types),
+        sort_properties_(sort_properties),
+        empty_value_(omit_empty_values_ ? std::string()
+                                        : std::string(DefaultUnspecifiedValueStringView)) {
+    std::string sanitize_buffer;
+    compileMap(format_mapping, "", commands, sanitize_buffer);
+  }
 
   // FormatterBase
   std::string formatWithContext(const FormatterContext& context,
                                 const StreamInfo::StreamInfo& info) const override {
-    const ProtobufWkt::Struct output_struct = struct_formatter_.formatWithContext(context, info);
-
-    std::string log_line = "";
-#ifdef ENVOY_ENABLE_YAML
-    if (sort_properties_) {
-      log_line = Json::Factory::loadFromProtobufStruct(output_struct)->asJsonString();
-    } else {
-      log_line = MessageUtil::getJsonStringFromMessageOrError(output_struct, false, true);
+    std::string log_line;
+    log_line.reserve(512);
+    std::string sanitize_buffer;
+    absl::InlinedVector<Level, 8> levels;
+
+    for (const Instruction& instruction : instructions_) {
+      switch (instruction.type_) {
+      case InstructionType::StartMap:
+      case InstructionType::StartList: {
+        Level level{log_line.size(), true};
+        if (!levels.empty()) {
+          level.parent_was_empty_ = levels.back().empty_;
+          startField(log_line, levels.back(), instruction.key_);
+        }
+        log_line.append(instruction.text_);
+        levels.push_back(level);
+        break;
+      }
+      case InstructionType::EndMap:
+      case InstructionType::EndList: {
+        const Level level = levels.back();
+        levels.pop_back();
+        // Maps without any value are omitted as well, except for the root map. Lists are kept.
+        if (omit_empty_values_ && level.empty_ && !levels.empty() &&
+            instruction.type_ == InstructionType::EndMap) {
+          log_line.resize(level.start_);
+          levels.back().empty_ = level.parent_was_empty_;
+        } else {
+          log_line.append(instruction.text_);
+        }
+        break;
+      }
+      case InstructionType::Constant:
+        startField(log_line, levels.back(), instruction.key_);
+        log_line.append(instruction.text_);
+        break;
+      case InstructionType::Value:
+        appendProviders(log_line, levels.back(), instruction, context, info, sanitize_buffer);
+        break;
+      }
     }
-#else
-    UNREFERENCED_PARAMETER(sort_properties_);
-    IS_ENVOY_BUG("Json support compiled out");
-#endif
-    return absl::StrCat(log_line, "\n");
+
+    log_line.push_back('\n');
+    return log_line;
   }
 
 private:
-  const StructFormatterBase<FormatterContext> struct_formatter_;
+  enum class InstructionType { StartMap, EndMap, StartList, EndList, Constant, Value };
+
+  struct Instruction {
+    InstructionType type_;
+    // The rendered key followed by ':', or empty for list elements and the root map.
+    std::string key_;
+    // The brace or bracket for maps and lists, or the rendered value for constants.
+    std::string text_;
+    std::vector<FormatterProviderBasePtr<FormatterContext>> providers_;
+  };
+
+  // A map or list which is being written.
+  struct Level {
+    // Where the map or list started in the log line, including its separator and key.
+    size_t start_;
+    // Whether the parent had no fields before this map or list was started.
+    bool parent_was_empty_;
+    bool empty_{true};
+  };
+
+  void compileMap(const ProtobufWkt::Struct& struct_format, std::string key,
+                  const CommandParsers& commands, std::string& sanitize_buffer) {
+    instructions_.push_back({InstructionType::StartMap, std::move(key), "{", {}});
+    // Although not required for JSON, it is nice to have the order of properties stable between
+    // log entries, thus the keys are sorted.
+    std::map<std::string, const ProtobufWkt::Value*> fields;
+    for (const auto& pair : struct_format.fields()) {
+      fields.emplace(pair.first, &pair.second);
+    }
+    for (const auto& [name, value] : fields) {
+      std::string rendered_key;
+      JsonFormatterUtil::appendString(rendered_key, name, sanitize_buffer);
+      rendered_key.push_back(':');
+      compileValue(*value, std::move(rendered_key), commands, sanitize_buffer);
+    }
+    instructions_.push_back({InstructionType::EndMap, "", "}", {}});
+  }
+
+  void compileValue(const ProtobufWkt::Value& value, std::string key,
+                    const CommandParsers& commands, std::string& sanitize_buffer) {
+    switch (value.kind_case()) {
+    case ProtobufWkt::Value::kStringValue: {
+      const std::string& string_format = value.string_value();
+      if (string_format.find('%') == std::string::npos) {
+        std::string text;
+        JsonFormatterUtil::appendString(text, string_format, sanitize_buffer);
+        instructions_.push_back({InstructionType::Constant, std::move(key), std::move(text), {}});
+      } else {
+        instructions_.push_back(
+            {InstructionType::Value, std::move(key), "",
+             SubstitutionFormatParser::parse<FormatterContext>(string_format, commands)});
+      }
+      break;
+    }
+
+    case ProtobufWkt::Value::kStructValue:
+      compileMap(value.struct_value(), std::move(key), commands, sanitize_buffer);
+      break;
+
+    case ProtobufWkt::Value::kListValue:
+      instructions_.push_back({InstructionType::StartList, std::move(key), "[", {}});
+      for (const auto& element : value.list_value().values()) {
+        compileValue(element, "", commands, sanitize_buffer);
+      }
+      instructions_.push_back({InstructionType::EndList, "", "]", {}});
+      break;
+
+    case ProtobufWkt::Value::kNumberValue: {
+      std::string text;
+      if (preserve_types_) {
+        JsonFormatterUtil::appendNumber(text, value.number_value());
+      } else {
+        JsonFormatterUtil::appendString(text, absl::StrFormat("%g", value.number_value()),
+                                        sanitize_buffer);
+      }
+      instructions_.push_back({InstructionType::Constant, std::move(key), std::move(text), {}});
+      break;
+    }
+
+    default:
+      throwEnvoyExceptionOrPanic(
+          "Only string values, nested structs, list values and number values are "
+          "supported in structured access log format.");
+    }
+  }
+
+  // Adds the separator and the key of a field to the log line.
+  static void startField(std::string& log_line, Level& parent, absl::string_view key) {
+    if (!parent.empty_) {
+      log_line.push_back(',');
+    }
+    parent.empty_ = false;
+    log_line.append(key.data(), key.size());
+  }
+
+  void appendProviders(std::string& log_line, Level& parent, const Instruction& instruction,
+                       const FormatterContext& context, const StreamInfo::StreamInfo& info,
+                       std::string& sanitize_buffer) const {
+    const auto& providers = instruction.providers_;
+    ASSERT(!providers.empty());
+    if (providers.size() == 1) {
+      const auto& provider = providers.front();
+      if (preserve_types_) {
+        const ProtobufWkt::Value value = provider->formatValueWithContext(context, info);
+        if (omit_empty_values_ && value.kind_case() == ProtobufWkt::Value::kNullValue) {
+          return;
+        }
+        startField(log_line, parent, instruction.key_);
+        JsonFormatterUtil::appendValue(log_line, value, sort_properties_, sanitize_buffer);
+        return;
+      }
+
+      const absl::optional<std::string> str = provider->formatWithContext(context, info);
+      if (omit_empty_values_ && !str.has_value()) {
+        return;
+      }
+      startField(log_line, parent, instruction.key_);
+      JsonFormatterUtil::appendString(log_line, str.has_value() ? *str : empty_value_,
+                                      sanitize_buffer);
+      return;
+    }
+    // Multiple providers forces string output.
+    std::string str;
+    for (const auto& provider : providers) {
+      const auto bit = provider->formatWithContext(context, info);
+      str += bit.value_or(empty_value_);
+    }
+    startField(log_line, parent, instruction.key_);
+    JsonFormatterUtil::appendString(log_line, str, sanitize_buffer);
+  }
+
+  const bool omit_empty_values_;
+  const bool preserve_types_;
   const bool sort_properties_;
+  const std::string empty_value_;
+  std::vector<Instruction> instructions_;
 };
 
 template <class FormatterContext>
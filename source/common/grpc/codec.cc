@@ -1,5 +1,6 @@
 #include "source/common/grpc/codec.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <memory>
@@ -27,29 +28,95 @@ void Encoder::prependFrameHeader(uint8_t flags, Buffer::Instance& buffer, uint32
   // Compute the size of the payload and construct the length prefix.
   std::array<uint8_t, Grpc::GRPC_FRAME_HEADER_SIZE> frame;
   Grpc::Encoder().newFrame(flags, message_length, frame);
-  Buffer::OwnedImpl frame_buffer(frame.data(), frame.size());
-  buffer.prepend(frame_buffer);
+  buffer.prepend(absl::string_view(reinterpret_cast<const char*>(frame.data()), frame.size()));
 }
 
+namespace {
+
+bool validFrameFlags(uint8_t flags) { return (flags & ~GRPC_FH_COMPRESSED) == 0; }
+
+// Runs over the frame headers from the current state of a decoder, without touching the frame
+// data, so that the decoder can leave its input unchanged when the input holds an invalid frame.
+class FrameHeaderValidator : public FrameInspector {
+public:
+  explicit FrameHeaderValidator(const FrameInspector& decoder) : FrameInspector(decoder) {}
+
+  bool valid() const { return !decoding_error_ && !is_frame_oversized_; }
+
+protected:
+  bool frameStart(uint8_t flags) override {
+    decoding_error_ = !validFrameFlags(flags);
+    return !decoding_error_;
+  }
+
+private:
+  bool decoding_error_{false};
+};
+
+uint64_t remainingFrameHeaderLength(State state) {
+  switch (state) {
+  case State::FhFlag:
+    return GRPC_FRAME_HEADER_SIZE;
+  case State::FhLen0:
+    return GRPC_FRAME_HEADER_SIZE - 1;
+  case State::FhLen1:
+    return GRPC_FRAME_HEADER_SIZE - 2;
+  case State::FhLen2:
+    return GRPC_FRAME_HEADER_SIZE - 3;
+  case State::FhLen3:
+    return GRPC_FRAME_HEADER_SIZE - 4;
+  case State::Data:
+    break;
+  }
+  return 0;
+}
+
+} // namespace
+
 bool Decoder::decode(Buffer::Instance& input, std::vector<Frame>& output) {
   // Make sure those flags are set to initial state.
   decoding_error_ = false;
   is_frame_oversized_ = false;
-  output_ = &output;
-  inspect(input);
-  output_ = nullptr;
 
-  if (decoding_error_ || is_frame_oversized_) {
+  output_ = &output;
+  FrameHeaderValidator validator(*this);
+  validator.inspect(input);
+  if (!validator.valid()) {
+    // Copies out the frames preceding the invalid one, leaving the input unchanged.
+    inspect(input);
+    output_ = nullptr;
     return false;
   }
 
-  input.drain(input.length());
+  // The frame data is moved out of the input rather than copied, so that the slices of large
+  // messages are handed over as they are. Only the frame headers are copied out.
+  uint64_t delta = 0;
+  while (input.length() > 0) {
+    if (state_ == State::Data) {
+      const uint64_t length = std::min<uint64_t>(length_, input.length());
+      frame_.data_->move(input, length);
+      length_ -= length;
+      if (length_ == 0) {
+        frameDataEnd();
+        state_ = State::FhFlag;
+      }
+      continue;
+    }
+    std::array<uint8_t, GRPC_FRAME_HEADER_SIZE> header;
+    const uint64_t header_length =
+        std::min<uint64_t>(remainingFrameHeaderLength(state_), input.length());
+    input.copyOut(0, header_length, header.data());
+    input.drain(header_length);
+    const bool inspected = inspectSlice(header.data(), header_length, delta);
+    ASSERT(inspected);
+  }
+  output_ = nullptr;
   return true;
 }
 
 bool Decoder::frameStart(uint8_t flags) {
   // Unsupported flags.
-  if (flags & ~GRPC_FH_COMPRESSED) {
+  if (!validFrameFlags(flags)) {
     decoding_error_ = true;
     return false;
   }
@@ -74,74 +141,80 @@ void Decoder::frameDataEnd() {
 uint64_t FrameInspector::inspect(const Buffer::Instance& data) {
   uint64_t delta = 0;
   for (const Buffer::RawSlice& slice : data.getRawSlices()) {
-    uint8_t* mem = reinterpret_cast<uint8_t*>(slice.mem_);
-    uint8_t* end = mem + slice.len_;
-    while (mem < end) {
-      uint8_t c = *mem;
-      switch (state_) {
-      case State::FhFlag:
-        if (!frameStart(c)) {
-          return delta;
-        }
-        count_ += 1;
-        delta += 1;
-        state_ = State::FhLen0;
-        mem++;
-        break;
-      case State::FhLen0:
-        length_as_bytes_[0] = c;
-        state_ = State::FhLen1;
-        mem++;
-        break;
-      case State::FhLen1:
-        length_as_bytes_[1] = c;
-        state_ = State::FhLen2;
-        mem++;
-        break;
-      case State::FhLen2:
-        length_as_bytes_[2] = c;
-        state_ = State::FhLen3;
-        mem++;
-        break;
-      case State::FhLen3:
-        length_as_bytes_[3] = c;
-        length_ = absl::big_endian::Load32(length_as_bytes_);
-        // Compares the frame length against maximum length when `max_frame_length_` is configured,
-        if (max_frame_length_ != 0 && length_ > max_frame_length_) {
-          // Set the flag to indicate the over-limit error and return.
-          is_frame_oversized_ = true;
-          return delta;
-        }
-        frameDataStart();
-        if (length_ == 0) {
-          frameDataEnd();
-          state_ = State::FhFlag;
-        } else {
-          state_ = State::Data;
-        }
-        mem++;
-        break;
-      case State::Data:
-        uint64_t remain_in_buffer = end - mem;
-        if (remain_in_buffer <= length_) {
-          frameData(mem, remain_in_buffer);
-          mem += remain_in_buffer;
-          length_ -= remain_in_buffer;
-        } else {
-          frameData(mem, length_);
-          mem += length_;
-          length_ = 0;
-        }
-        if (length_ == 0) {
-          frameDataEnd();
-          state_ = State::FhFlag;
-        }
-        break;
-      }
+    if (!inspectSlice(reinterpret_cast<uint8_t*>(slice.mem_), slice.len_, delta)) {
+      break;
     }
   }
   return delta;
 }
 
+bool FrameInspector::inspectSlice(uint8_t* mem, uint64_t length, uint64_t& delta) {
+  uint8_t* end = mem + length;
+  while (mem < end) {
+    uint8_t c = *mem;
+    switch (state_) {
+    case State::FhFlag:
+      if (!frameStart(c)) {
+        return false;
+      }
+      count_ += 1;
+      delta += 1;
+      state_ = State::FhLen0;
+      mem++;
+      break;
+    case State::FhLen0:
+      length_as_bytes_[0] = c;
+      state_ = State::FhLen1;
+      mem++;
+      break;
+    case State::FhLen1:
+      length_as_bytes_[1] = c;
+      state_ = State::FhLen2;
+      mem++;
+      break;
+    case State::FhLen2:
+      length_as_bytes_[2] = c;
+      state_ = State::FhLen3;
+      mem++;
+      break;
+    case State::FhLen3:
+      length_as_bytes_[3] = c;
+      length_ = absl::big_endian::Load32(length_as_bytes_);
+      // Compares the frame length against maximum length when `max_frame_length_` is configured,
+      if (max_frame_length_ != 0 && length_ > max_frame_length_) {
+        // Set the flag to indicate the over-limit error and return.
+        is_frame_oversized_ = true;
+        return false;
+      }
+      frameDataStart();
+      if (length_ == 0) {
+        frameDataEnd();
+        state_ = State::FhFlag;
+      } else {
+        state_ = State::Data;
+      }
+      mem++;
+      break;
+    case State::Data:
+      uint64_t remain_in_buffer = end - mem;
+      if (remain_in_buffer <= length_) {
+        frameData(mem, remain_in_buffer);
+        mem += remain_in_buffer;
+        length_ -= remain_in_buffer;
+      } else {
+        frameData(mem, length_);
+        mem += length_;
+        length_ = 0;
+      }
+      if (length_ == 0) {
+        frameDataEnd();
+        state_ = State::FhFlag;
+      }
+      break;
+    }
+  }
+  return true;
+}
+
 } // namespace Grpc
 } // namespace Envoy
@@ -99,6 +99,9 @@ public:
   virtual ~FrameInspector() = default;
 
 protected:
+  // Inspects the given memory, returning false if the inspector aborted.
+  bool inspectSlice(uint8_t* mem, uint64_t length, uint64_t& delta);
+
   virtual bool frameStart(uint8_t) { return true; }
   virtual void frameDataStart() {}
   virtual void frameData(uint8_t*, uint64_t) {}
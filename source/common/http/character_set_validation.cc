@@ -0,0 +1,153 @@
+#include "source/common/http/character_set_validation.h"
+
+#include "source/common/common/macros.h"
+
+#if defined(__x86_64__) && !defined(_WIN32) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ENVOY_CHAR_TABLE_X86 1
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ENVOY_CHAR_TABLE_NEON 1
+#endif
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+size_t findFirstCharNotInTableScalar(const std::array<uint32_t, 8>& table, const char* data,
+                                     size_t begin, size_t size) {
+  for (size_t i = begin; i < size; ++i) {
+    if (!testCharInTable(table, data[i])) {
+      return i;
+    }
+  }
+  return absl::string_view::npos;
+}
+
+size_t findFirstCharNotInTableGeneric(const VectorizedCharTable& table, absl::string_view input) {
+  return findFirstCharNotInTableScalar(table.table(), input.data(), 0, input.size());
+}
+
+// The vectorized lookups split every character into its high nibble, which selects a bit, and its
+// low nibble, which selects a row of VectorizedCharTable::rows(), with one shuffle each. Characters
+// of 0x80 and above are handled with a sign test. When a block contains a character which is not
+// in the table, the scalar lookup continues from that character, so that tables which contain only
+// part of the extended characters are still found exactly.
+
+#if defined(ENVOY_CHAR_TABLE_X86)
+
+__attribute__((target("ssse3"))) size_t
+findFirstCharNotInTableSsse3(const VectorizedCharTable& table, absl::string_view input) {
+  const char* data = input.data();
+  const size_t size = input.size();
+  const __m128i rows = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.rows().data()));
+  const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i low_nibble = _mm_set1_epi8(0x0f);
+  const __m128i extended = _mm_set1_epi8(table.extendedAllowed() ? -1 : 0);
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + sizeof(__m128i) <= size; i += sizeof(__m128i)) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128i row = _mm_shuffle_epi8(rows, _mm_and_si128(bytes, low_nibble));
+    const __m128i bit =
+        _mm_shuffle_epi8(bits, _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibble));
+    const __m128i not_in_ascii = _mm_cmpeq_epi8(_mm_and_si128(row, bit), zero);
+    const __m128i in_extended = _mm_and_si128(_mm_cmplt_epi8(bytes, zero), extended);
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(not_in_ascii)) &
+                          ~static_cast<uint32_t>(_mm_movemask_epi8(in_extended));
+    if (mask != 0) {
+      return findFirstCharNotInTableScalar(table.table(), data, i + __builtin_ctz(mask), size);
+    }
+  }
+  return findFirstCharNotInTableScalar(table.table(), data, i, size);
+}
+
+__attribute__((target("avx2"))) size_t
+findFirstCharNotInTableAvx2(const VectorizedCharTable& table, absl::string_view input) {
+  const char* data = input.data();
+  const size_t size = input.size();
+  // The shuffle works on each 128 bit lane separately, so the rows and bits are repeated in both.
+  const __m256i rows = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.rows().data())));
+  const __m256i bits = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0));
+  const __m256i low_nibble = _mm256_set1_epi8(0x0f);
+  const __m256i extended = _mm256_set1_epi8(table.extendedAllowed() ? -1 : 0);
+  const __m256i zero = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + sizeof(__m256i) <= size; i += sizeof(__m256i)) {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    const __m256i row = _mm256_shuffle_epi8(rows, _mm256_and_si256(bytes, low_nibble));
+    const __m256i bit =
+        _mm256_shuffle_epi8(bits, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), low_nibble));
+    const __m256i not_in_ascii = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), zero);
+    const __m256i in_extended = _mm256_and_si256(_mm256_cmpgt_epi8(zero, bytes), extended);
+    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(not_in_ascii)) &
+                          ~static_cast<uint32_t>(_mm256_movemask_epi8(in_extended));
+    if (mask != 0) {
+      return findFirstCharNotInTableScalar(table.table(), data, i + __builtin_ctz(mask), size);
+    }
+  }
+  const size_t result = findFirstCharNotInTableSsse3(table, input.substr(i));
+  return result == absl::string_view::npos ? result : i + result;
+}
+
+#endif
+
+#if defined(ENVOY_CHAR_TABLE_NEON)
+
+size_t findFirstCharNotInTableNeon(const VectorizedCharTable& table, absl::string_view input) {
+  const char* data = input.data();
+  const size_t size = input.size();
+  static constexpr uint8_t kBits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 0, 0, 0, 0, 0, 0, 0, 0};
+  const uint8x16_t rows = vld1q_u8(table.rows().data());
+  const uint8x16_t bits = vld1q_u8(kBits);
+  const uint8x16_t low_nibble = vdupq_n_u8(0x0f);
+  const uint8x16_t extended = vdupq_n_u8(table.extendedAllowed() ? 0xff : 0);
+  size_t i = 0;
+  for (; i + sizeof(uint8x16_t) <= size; i += sizeof(uint8x16_t)) {
+    const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+    const uint8x16_t row = vqtbl1q_u8(rows, vandq_u8(bytes, low_nibble));
+    const uint8x16_t bit = vqtbl1q_u8(bits, vshrq_n_u8(bytes, 4));
+    const uint8x16_t in_table =
+        vorrq_u8(vtstq_u8(row, bit), vandq_u8(vcgeq_u8(bytes, vdupq_n_u8(0x80)), extended));
+    if (vminvq_u8(in_table) == 0) {
+      return findFirstCharNotInTableScalar(table.table(), data, i, size);
+    }
+  }
+  return findFirstCharNotInTableScalar(table.table(), data, i, size);
+}
+
+#endif
+
+using FindFirstCharNotInTableFn = size_t (*)(const VectorizedCharTable&, absl::string_view);
+
+FindFirstCharNotInTableFn selectImpl() {
+#if defined(ENVOY_CHAR_TABLE_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return findFirstCharNotInTableAvx2;
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    return findFirstCharNotInTableSsse3;
+  }
+#elif defined(ENVOY_CHAR_TABLE_NEON)
+  return findFirstCharNotInTableNeon;
+#endif
+  return findFirstCharNotInTableGeneric;
+}
+
+const FindFirstCharNotInTableFn& findFirstCharNotInTableImpl() {
+  CONSTRUCT_ON_FIRST_USE(FindFirstCharNotInTableFn, selectImpl());
+}
+
+} // namespace
+
+size_t findFirstCharNotInTable(const VectorizedCharTable& table, absl::string_view input) {
+  return findFirstCharNotInTableImpl()(table, input);
+}
+
+} // namespace Http
+} // namespace Envoy
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
+#include "absl/strings/string_view.h"
+
 // A set of tables for validating that a character is in a specific
 // character set. Used to validate RFC compliance for various HTTP protocol elements.
 
@@ -21,6 +24,62 @@ inline constexpr bool testCharInTable(const std::array<uint32_t, 8>& table, char
   return (table[tmp >> 5] & (0x80000000 >> (tmp & 0x1f))) != 0;
 }
 
+/**
+ * @return a copy of `table` without the characters of `chars`.
+ */
+constexpr std::array<uint32_t, 8> removeCharsFromTable(std::array<uint32_t, 8> table,
+                                                       absl::string_view chars) {
+  for (const char c : chars) {
+    const uint8_t tmp = static_cast<uint8_t>(c);
+    table[tmp >> 5] &= ~(0x80000000 >> (tmp & 0x1f));
+  }
+  return table;
+}
+
+/**
+ * A character table in a form which allows to test 16 or 32 characters at a time with a vector
+ * shuffle, see findFirstCharNotInTable(). Construct one at compile time for every table which is
+ * applied to whole header names, values or paths.
+ */
+class VectorizedCharTable {
+public:
+  constexpr explicit VectorizedCharTable(const std::array<uint32_t, 8>& table)
+      : table_(table), extended_allowed_(extendedAllowed(table)) {
+    for (uint32_t low = 0; low < 16; ++low) {
+      for (uint32_t high = 0; high < 8; ++high) {
+        if (testCharInTable(table, static_cast<char>(high << 4 | low))) {
+          rows_[low] |= 1 << high;
+        }
+      }
+    }
+  }
+
+  const std::array<uint32_t, 8>& table() const { return table_; }
+  // Bit `h` of `rows()[l]` is set if the character `h << 4 | l` is in the table, for `h` < 8.
+  const std::array<uint8_t, 16>& rows() const { return rows_; }
+  // True if all the characters 0x80-0xff are in the table. If only some are, the vectorized
+  // lookup treats all of them as not in the table and relies on the scalar lookup to decide.
+  bool extendedAllowed() const { return extended_allowed_; }
+
+private:
+  static constexpr bool extendedAllowed(const std::array<uint32_t, 8>& table) {
+    return table[4] == 0xffffffff && table[5] == 0xffffffff && table[6] == 0xffffffff &&
+           table[7] == 0xffffffff;
+  }
+
+  std::array<uint32_t, 8> table_;
+  std::array<uint8_t, 16> rows_{};
+  bool extended_allowed_;
+};
+
+/**
+ * Finds the first character of `input` which is not in `table`. The lookup is vectorized with
+ * AVX2, SSSE3 or NEON when the CPU supports it.
+ * @return the offset of the character or `absl::string_view::npos` if all characters are in the
+ *         table.
+ */
+size_t findFirstCharNotInTable(const VectorizedCharTable& table, absl::string_view input);
+
 // Header name character table.
 // From RFC 9110, https://www.rfc-editor.org/rfc/rfc9110.html#section-5.1:
 //
@@ -49,6 +108,9 @@ inline constexpr std::array<uint32_t, 8> kGenericHeaderNameCharTable = {
     0b00000000000000000000000000000000,
 };
 
+inline constexpr VectorizedCharTable kVectorizedGenericHeaderNameCharTable{
+    kGenericHeaderNameCharTable};
+
 // A URI query and fragment character table. From RFC 3986:
 // https://datatracker.ietf.org/doc/html/rfc3986#section-3.4
 //
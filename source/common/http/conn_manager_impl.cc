@@ -956,6 +956,23 @@ ConnectionManagerImpl::ActiveStream::ActiveStream(ConnectionManagerImpl& connect
   }
 }
 
+ConnectionManagerImpl::ActiveStream::~ActiveStream() {
+  const Buffer::BufferMemoryAccountSharedPtr account = filter_manager_.account();
+  if (account != nullptr && account_charged_header_bytes_ > 0) {
+    account->credit(account_charged_header_bytes_);
+  }
+}
+
+void ConnectionManagerImpl::ActiveStream::chargeAccountForHeaders(const HeaderMap& headers) {
+  const Buffer::BufferMemoryAccountSharedPtr account = filter_manager_.account();
+  if (account == nullptr) {
+    return;
+  }
+  const uint64_t size = headers.byteSize();
+  account->charge(size);
+  account_charged_header_bytes_ += size;
+}
+
 void ConnectionManagerImpl::ActiveStream::completeRequest() {
   filter_manager_.streamInfo().onRequestComplete();
 
@@ -1205,6 +1222,7 @@ void ConnectionManagerImpl::ActiveStream::decodeHeaders(RequestHeaderMapSharedPt
   ScopeTrackerScopeState scope(this,
                                connection_manager_.read_callbacks_->connection().dispatcher());
   request_headers_ = std::move(headers);
+  chargeAccountForHeaders(*request_headers_);
   filter_manager_.requestHeadersInitialized();
   if (request_header_timer_ != nullptr) {
     request_header_timer_->disableTimer();
@@ -1530,6 +1548,7 @@ void ConnectionManagerImpl::ActiveStream::decodeTrailers(RequestTrailerMapPtr&&
 
   ASSERT(!request_trailers_);
   request_trailers_ = std::move(trailers);
+  chargeAccountForHeaders(*request_trailers_);
   if (!validateTrailers()) {
     ENVOY_STREAM_LOG(debug, "request trailers validation failed:\n{}", *this, *request_trailers_);
     return;
@@ -1756,6 +1775,8 @@ void ConnectionManagerImpl::ActiveStream::encode1xxHeaders(ResponseHeaderMap& re
 
 void ConnectionManagerImpl::ActiveStream::encodeHeaders(ResponseHeaderMap& headers,
                                                         bool end_stream) {
+  chargeAccountForHeaders(headers);
+
   // Base headers.
 
   // We want to preserve the original date header, but we add a date header if it is absent
@@ -1910,6 +1931,7 @@ void ConnectionManagerImpl::ActiveStream::encodeData(Buffer::Instance& data, boo
 
 void ConnectionManagerImpl::ActiveStream::encodeTrailers(ResponseTrailerMap& trailers) {
   ENVOY_STREAM_LOG(debug, "encoding trailers via codec:\n{}", *this, trailers);
+  chargeAccountForHeaders(trailers);
 
   response_encoder_->encodeTrailers(trailers);
 }
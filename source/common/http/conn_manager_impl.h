@@ -181,6 +181,7 @@ private:
                               public DownstreamStreamFilterCallbacks {
     ActiveStream(ConnectionManagerImpl& connection_manager, uint32_t buffer_limit,
                  Buffer::BufferMemoryAccountSharedPtr account);
+    ~ActiveStream() override;
 
     // Event::DeferredDeletable
     void deleteIsPending() override {
@@ -243,6 +244,11 @@ private:
     void dumpState(std::ostream& os, int indent_level = 0) const override {
       const char* spaces = spacesForLevel(indent_level);
       os << spaces << "ActiveStream " << this << DUMP_MEMBER(stream_id_);
+      const Buffer::BufferMemoryAccountSharedPtr account = filter_manager_.account();
+      if (account != nullptr) {
+        os << DUMP_MEMBER_AS(account_balance, account->balance())
+           << DUMP_MEMBER(account_charged_header_bytes_);
+      }
 
       DUMP_DETAILS(&filter_manager_);
     }
@@ -445,6 +451,11 @@ private:
     // present). Return false if this stream was not deferred.
     bool onDeferredRequestProcessing();
 
+    // Charges the buffer memory account of the stream for the size of a header map, so that
+    // streams with large headers are also reset first under memory pressure. The charges are
+    // credited when the stream is destroyed.
+    void chargeAccountForHeaders(const HeaderMap& headers);
+
     ConnectionManagerImpl& connection_manager_;
     OptRef<const TracingConnectionManagerConfig> connection_manager_tracing_config_;
     // TODO(snowp): It might make sense to move this to the FilterManager to avoid storing it in
@@ -461,6 +472,7 @@ private:
     // Note: The FM must outlive the above headers, as they are possibly accessed during filter
     // destruction.
     DownstreamFilterManager filter_manager_;
+    uint64_t account_charged_header_bytes_{};
 
     Tracing::SpanPtr active_span_;
     ResponseEncoder* response_encoder_{};
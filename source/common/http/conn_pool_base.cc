@@ -142,6 +142,7 @@ void MultiplexedActiveClientBase::onSettings(ReceivedSettings& settings) {
       parent_.incrClusterStreamCapacity(-delta);
       ENVOY_CONN_LOG(trace, "Increasing stream capacity by {}", *codec_client_, -delta);
     }
+    parent_.updateReadyStreamCapacity(*this);
   }
 }
 
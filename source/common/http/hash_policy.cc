@@ -142,9 +142,7 @@ public:
 
     const HeaderEntry* header = headers.Path();
     if (header) {
-      Http::Utility::QueryParamsMulti query_parameters =
-          Http::Utility::QueryParamsMulti::parseQueryString(header->value().getStringView());
-      const auto val = query_parameters.getFirstValue(parameter_name_);
+      const auto val = firstValue(header->value().getStringView());
       if (val.has_value()) {
         hash = HashUtil::xxHash64(val.value());
       }
@@ -153,6 +151,29 @@ public:
   }
 
 private:
+  // Finds the first value of the parameter the same way QueryParamsMulti::parseQueryString() and
+  // getFirstValue() would, without copying every parameter of the query string into a map.
+  absl::optional<absl::string_view> firstValue(absl::string_view path) const {
+    size_t start = path.find('?');
+    if (start == absl::string_view::npos) {
+      return absl::nullopt;
+    }
+    ++start;
+    while (start < path.size()) {
+      size_t end = path.find('&', start);
+      if (end == absl::string_view::npos) {
+        end = path.size();
+      }
+      const absl::string_view param = path.substr(start, end - start);
+      const size_t equal = param.find('=');
+      if (param.substr(0, equal) == parameter_name_) {
+        return equal == absl::string_view::npos ? absl::string_view() : param.substr(equal + 1);
+      }
+      start = end + 1;
+    }
+    return absl::nullopt;
+  }
+
   const std::string parameter_name_;
 };
 
@@ -112,6 +112,77 @@ void HeaderMapImpl::HeaderEntryImpl::value(const HeaderEntry& header) {
   value(header.value().getStringView());
 }
 
+const std::vector<LowerCaseString>& HeaderMapImpl::staticTableHeaderNames() {
+  // From RFC 7541, Appendix A and RFC 9204, Appendix A.
+  CONSTRUCT_ON_FIRST_USE(std::vector<LowerCaseString>,
+                         {
+                             LowerCaseString("accept"),
+                             LowerCaseString("accept-charset"),
+                             LowerCaseString("accept-encoding"),
+                             LowerCaseString("accept-language"),
+                             LowerCaseString("accept-ranges"),
+                             LowerCaseString("access-control-allow-credentials"),
+                             LowerCaseString("access-control-allow-headers"),
+                             LowerCaseString("access-control-allow-methods"),
+                             LowerCaseString("access-control-allow-origin"),
+                             LowerCaseString("access-control-expose-headers"),
+                             LowerCaseString("access-control-request-headers"),
+                             LowerCaseString("access-control-request-method"),
+                             LowerCaseString("age"),
+                             LowerCaseString("allow"),
+                             LowerCaseString("alt-svc"),
+                             LowerCaseString("authorization"),
+                             LowerCaseString("cache-control"),
+                             LowerCaseString("content-disposition"),
+                             LowerCaseString("content-encoding"),
+                             LowerCaseString("content-language"),
+                             LowerCaseString("content-length"),
+                             LowerCaseString("content-location"),
+                             LowerCaseString("content-range"),
+                             LowerCaseString("content-security-policy"),
+                             LowerCaseString("content-type"),
+                             LowerCaseString("cookie"),
+                             LowerCaseString("date"),
+                             LowerCaseString("early-data"),
+                             LowerCaseString("etag"),
+                             LowerCaseString("expect"),
+                             LowerCaseString("expires"),
+                             LowerCaseString("from"),
+                             LowerCaseString("host"),
+                             LowerCaseString("if-match"),
+                             LowerCaseString("if-modified-since"),
+                             LowerCaseString("if-none-match"),
+                             LowerCaseString("if-range"),
+                             LowerCaseString("if-unmodified-since"),
+                             LowerCaseString("last-modified"),
+                             LowerCaseString("link"),
+                             LowerCaseString("location"),
+                             LowerCaseString("max-forwards"),
+                             LowerCaseString("origin"),
+                             LowerCaseString("proxy-authenticate"),
+                             LowerCaseString("proxy-authorization"),
+                             LowerCaseString("purpose"),
+                             LowerCaseString("range"),
+                             LowerCaseString("referer"),
+                             LowerCaseString("refresh"),
+                             LowerCaseString("retry-after"),
+                             LowerCaseString("server"),
+                             LowerCaseString("set-cookie"),
+                             LowerCaseString("strict-transport-security"),
+                             LowerCaseString("timing-allow-origin"),
+                             LowerCaseString("transfer-encoding"),
+                             LowerCaseString("upgrade-insecure-requests"),
+                             LowerCaseString("user-agent"),
+                             LowerCaseString("vary"),
+                             LowerCaseString("via"),
+                             LowerCaseString("www-authenticate"),
+                             LowerCaseString("x-content-type-options"),
+                             LowerCaseString("x-forwarded-for"),
+                             LowerCaseString("x-frame-options"),
+                             LowerCaseString("x-xss-protection"),
+                         });
+}
+
 template <> HeaderMapImpl::StaticLookupTable<RequestHeaderMap>::StaticLookupTable() {
 #define REGISTER_DEFAULT_REQUEST_HEADER(name)                                                      \
   CustomInlineHeaderRegistry::registerInlineHeader<RequestHeaderMap::header_map_type>(             \
@@ -119,19 +190,19 @@ template <> HeaderMapImpl::StaticLookupTable<RequestHeaderMap>::StaticLookupTabl
   INLINE_REQ_HEADERS(REGISTER_DEFAULT_REQUEST_HEADER)
   INLINE_REQ_RESP_HEADERS(REGISTER_DEFAULT_REQUEST_HEADER)
 
-  finalizeTable();
+  Entries entries = finalizeTable();
 
   // Special case where we map a legacy host header to :authority.
   const auto handle =
       CustomInlineHeaderRegistry::getInlineHeader<RequestHeaderMap::header_map_type>(
           Headers::get().Host);
-  add(Headers::get().HostLegacy.get().c_str(), [handle](HeaderMapImpl& h) -> StaticLookupResponse {
-    return {&h.inlineHeaders()[handle.value().it_->second], &handle.value().it_->first};
-  });
+  entries.emplace_back(Headers::get().HostLegacy.get(),
+                       StaticLookupEntry{handle.value().it_->second, &handle.value().it_->first});
+  buildTable(std::move(entries));
 }
 
 template <> HeaderMapImpl::StaticLookupTable<RequestTrailerMap>::StaticLookupTable() {
-  finalizeTable();
+  buildTable(finalizeTable());
 }
 
 template <> HeaderMapImpl::StaticLookupTable<ResponseHeaderMap>::StaticLookupTable() {
@@ -142,7 +213,7 @@ template <> HeaderMapImpl::StaticLookupTable<ResponseHeaderMap>::StaticLookupTab
   INLINE_REQ_RESP_HEADERS(REGISTER_RESPONSE_HEADER)
   INLINE_RESP_HEADERS_TRAILERS(REGISTER_RESPONSE_HEADER)
 
-  finalizeTable();
+  buildTable(finalizeTable());
 }
 
 template <> HeaderMapImpl::StaticLookupTable<ResponseTrailerMap>::StaticLookupTable() {
@@ -151,7 +222,7 @@ template <> HeaderMapImpl::StaticLookupTable<ResponseTrailerMap>::StaticLookupTa
       Headers::get().name);
   INLINE_RESP_HEADERS_TRAILERS(REGISTER_RESPONSE_TRAILER)
 
-  finalizeTable();
+  buildTable(finalizeTable());
 }
 
 uint64_t HeaderMapImpl::appendToHeader(HeaderString& header, absl::string_view data,
@@ -231,7 +302,13 @@ bool HeaderMapImpl::operator==(const HeaderMap& rhs) const {
 bool HeaderMapImpl::operator!=(const HeaderMap& rhs) const { return !operator==(rhs); }
 
 void HeaderMapImpl::insertByKey(HeaderString&& key, HeaderString&& value) {
-  auto lookup = staticLookup(key.getStringView());
+  auto lookup = staticLookupForInsert(key.getStringView());
+  if (lookup.has_value() && lookup.value().entry_ == nullptr) {
+    // The name is in the HPACK or QPACK static table. Refer to the static name rather than keeping
+    // a copy, so that the codecs can hand the name to their encoders without copying it.
+    key.setReference(lookup.value().key_->get());
+    lookup.reset();
+  }
   if (lookup.has_value()) {
     key.clear();
     if (*lookup.value().entry_ == nullptr) {
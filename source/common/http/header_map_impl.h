@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstdint>
+#include <limits>
 #include <list>
 #include <memory>
 #include <string>
@@ -11,6 +12,7 @@
 #include "envoy/config/core/v3/base.pb.h"
 #include "envoy/http/header_map.h"
 
+#include "source/common/common/node_arena.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
 #include "source/common/http/headers.h"
@@ -113,6 +115,11 @@ public:
   StatefulHeaderKeyFormatterOptRef formatter() { return makeOptRefFromPtr(formatter_.get()); }
 
 protected:
+  struct HeaderEntryImpl;
+  // The entries of a header map are allocated from an arena owned by the map, so that populating
+  // a map takes a few allocations and destroying it frees them at once.
+  using HeaderEntryList = std::list<HeaderEntryImpl, NodeArenaAllocator<HeaderEntryImpl>>;
+
   struct HeaderEntryImpl : public HeaderEntry, NonCopyable {
     HeaderEntryImpl(const LowerCaseString& key);
     HeaderEntryImpl(const LowerCaseString& key, HeaderString&& value);
@@ -128,36 +135,70 @@ protected:
 
     HeaderString key_;
     HeaderString value_;
-    std::list<HeaderEntryImpl>::iterator entry_;
+    HeaderEntryList::iterator entry_;
   };
-  using HeaderNode = std::list<HeaderEntryImpl>::iterator;
+  using HeaderNode = HeaderEntryList::iterator;
 
   /**
    * This is the static lookup table that is used to determine whether a header is one of the O(1)
-   * headers. This uses a trie for lookup time at most equal to the size of the incoming string.
+   * headers. This uses a perfect hash, so the lookup hashes the incoming string once and compares
+   * it with at most one O(1) header.
    */
   struct StaticLookupResponse {
     HeaderEntryImpl** entry_;
     const LowerCaseString* key_;
   };
 
+  struct StaticLookupEntry {
+    // The index of the O(1) header, or NotInline for the names of the HPACK and QPACK static
+    // tables which are not O(1) headers.
+    size_t index_;
+    const LowerCaseString* key_;
+  };
+  static constexpr size_t NotInline = std::numeric_limits<size_t>::max();
+
+  /**
+   * @return the header names of the HPACK and QPACK static tables, except the pseudo headers.
+   */
+  static const std::vector<LowerCaseString>& staticTableHeaderNames();
+
   /**
    * Base class for a static lookup table that converts a string key into an O(1) header.
    */
-  template <class Interface>
-  struct StaticLookupTable
-      : public TrieLookupTable<std::function<StaticLookupResponse(HeaderMapImpl&)>> {
+  template <class Interface> struct StaticLookupTable {
+    using Entries = std::vector<std::pair<std::string, StaticLookupEntry>>;
+
     StaticLookupTable();
 
-    void finalizeTable() {
+    /**
+     * Finalizes the registration of the O(1) headers, after which the table can be built.
+     * @return the lookup table entries of all registered headers.
+     */
+    Entries finalizeTable() {
       CustomInlineHeaderRegistry::finalize<Interface::header_map_type>();
       auto& headers = CustomInlineHeaderRegistry::headers<Interface::header_map_type>();
       size_ = headers.size();
+      Entries entries;
+      entries.reserve(headers.size());
       for (const auto& header : headers) {
-        this->add(header.first.get().c_str(), [&header](HeaderMapImpl& h) -> StaticLookupResponse {
-          return {&h.inlineHeaders()[header.second], &header.first};
-        });
+        entries.emplace_back(header.first.get(), StaticLookupEntry{header.second, &header.first});
       }
+      return entries;
+    }
+
+    void buildTable(Entries entries) {
+      // Also add the static table names, so that inserting such a header can switch its key to
+      // the static name with the same lookup.
+      absl::flat_hash_set<std::string> keys;
+      for (const auto& entry : entries) {
+        keys.insert(entry.first);
+      }
+      for (const LowerCaseString& name : staticTableHeaderNames()) {
+        if (!keys.contains(name.get())) {
+          entries.emplace_back(name.get(), StaticLookupEntry{NotInline, &name});
+        }
+      }
+      table_ = PerfectHashLookupTable<StaticLookupEntry>(std::move(entries));
     }
 
     static size_t size() {
@@ -173,15 +214,31 @@ protected:
 
     static absl::optional<StaticLookupResponse> lookup(HeaderMapImpl& header_map,
                                                        absl::string_view key) {
-      const auto& entry = ConstSingleton<StaticLookupTable>::get().find(key);
-      if (entry != nullptr) {
-        return entry(header_map);
+      const StaticLookupEntry* entry = ConstSingleton<StaticLookupTable>::get().table_.find(key);
+      if (entry != nullptr && entry->index_ != NotInline) {
+        return StaticLookupResponse{&header_map.inlineHeaders()[entry->index_], entry->key_};
       } else {
         return absl::nullopt;
       }
     }
 
+    /**
+     * Like lookup(), but also finds the static table names which are not O(1) headers, for which
+     * the response has no entry.
+     */
+    static absl::optional<StaticLookupResponse> lookupForInsert(HeaderMapImpl& header_map,
+                                                                absl::string_view key) {
+      const StaticLookupEntry* entry = ConstSingleton<StaticLookupTable>::get().table_.find(key);
+      if (entry == nullptr) {
+        return absl::nullopt;
+      }
+      return StaticLookupResponse{
+          entry->index_ != NotInline ? &header_map.inlineHeaders()[entry->index_] : nullptr,
+          entry->key_};
+    }
+
     size_t size_;
+    PerfectHashLookupTable<StaticLookupEntry> table_;
   };
 
   /**
@@ -203,7 +260,9 @@ protected:
     using HeaderNodeVector = absl::InlinedVector<HeaderNode, 1>;
     using HeaderLazyMap = absl::flat_hash_map<absl::string_view, HeaderNodeVector>;
 
-    HeaderList() : pseudo_headers_end_(headers_.end()) {}
+    HeaderList()
+        : headers_(NodeArenaAllocator<HeaderEntryImpl>(arena_)),
+          pseudo_headers_end_(headers_.end()) {}
 
     template <class Key> bool isPseudoHeader(const Key& key) {
       return !key.getStringView().empty() && key.getStringView()[0] == ':';
@@ -293,12 +352,12 @@ protected:
      */
     size_t remove(absl::string_view key);
 
-    std::list<HeaderEntryImpl>::iterator begin() { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::iterator end() { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_iterator begin() const { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::const_iterator end() const { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rend() const { return headers_.rend(); }
+    HeaderEntryList::iterator begin() { return headers_.begin(); }
+    HeaderEntryList::iterator end() { return headers_.end(); }
+    HeaderEntryList::const_iterator begin() const { return headers_.begin(); }
+    HeaderEntryList::const_iterator end() const { return headers_.end(); }
+    HeaderEntryList::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
+    HeaderEntryList::const_reverse_iterator rend() const { return headers_.rend(); }
     HeaderLazyMap::iterator mapFind(absl::string_view key) { return lazy_map_.find(key); }
     HeaderLazyMap::iterator mapEnd() { return lazy_map_.end(); }
     size_t size() const { return headers_.size(); }
@@ -310,7 +369,9 @@ protected:
     }
 
   private:
-    std::list<HeaderEntryImpl> headers_;
+    // Declared before the list so that it outlives the list's nodes.
+    NodeArena arena_;
+    HeaderEntryList headers_;
     HeaderNode pseudo_headers_end_;
     HeaderLazyMap lazy_map_;
   };
@@ -330,6 +391,7 @@ protected:
   void addSize(uint64_t size);
   void subtractSize(uint64_t size);
   virtual absl::optional<StaticLookupResponse> staticLookup(absl::string_view) PURE;
+  virtual absl::optional<StaticLookupResponse> staticLookupForInsert(absl::string_view) PURE;
   virtual void clearInline() PURE;
   virtual HeaderEntryImpl** inlineHeaders() PURE;
 
@@ -466,6 +528,9 @@ protected:
   absl::optional<StaticLookupResponse> staticLookup(absl::string_view key) override {
     return StaticLookupTable<Interface>::lookup(*this, key);
   }
+  absl::optional<StaticLookupResponse> staticLookupForInsert(absl::string_view key) override {
+    return StaticLookupTable<Interface>::lookupForInsert(*this, key);
+  }
   virtual const HeaderEntryImpl* const* constInlineHeaders() const PURE;
 };
 
@@ -20,7 +20,9 @@ public:
 
   void evaluateHeaders(Http::HeaderMap& headers, const Formatter::HttpFormatterContext& context,
                        const StreamInfo::StreamInfo& stream_info) const override {
-    const std::string value = formatter_->formatWithContext(context, stream_info);
+    const std::string formatted =
+        is_constant_ ? std::string() : formatter_->formatWithContext(context, stream_info);
+    const absl::string_view value = is_constant_ ? absl::string_view(original_value_) : formatted;
 
     if (!value.empty() || add_if_empty_) {
       switch (append_action_) {
@@ -52,6 +52,14 @@ public:
 
     const std::string& backingString() const { return result_backing_string_; }
 
+    // The result as a string. The backing string, if any, is moved rather than copied.
+    std::string resultAsString() && {
+      if (!result_backing_string_.empty()) {
+        return std::move(result_backing_string_);
+      }
+      return std::string(result_.value_or(absl::string_view()));
+    }
+
   private:
     absl::optional<absl::string_view> result_;
     // Valid only if result_ relies on memory allocation that must live beyond the call. See above.
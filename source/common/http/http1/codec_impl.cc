@@ -620,6 +620,12 @@ bool ConnectionImpl::maybeDirectDispatch(Buffer::Instance& data) {
     return false;
   }
 
+  if (parser_ != nullptr) {
+    // Upgraded connections may live for a long time and never parse again, so the parser and its
+    // header buffers are released. This is never called from within the parser.
+    parser_.reset();
+  }
+
   ENVOY_CONN_LOG(trace, "direct-dispatched {} bytes", connection_, data.length());
   onBody(data);
   data.drain(data.length());
@@ -301,6 +301,7 @@ protected:
   Network::Connection& connection_;
   CodecStats& stats_;
   const Http1Settings codec_settings_;
+  // Released once an upgrade is handled, as nothing is parsed after that.
   std::unique_ptr<Parser> parser_;
   Buffer::Instance* current_dispatching_buffer_{};
   Buffer::Instance* output_buffer_ = nullptr; // Not owned
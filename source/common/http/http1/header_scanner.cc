@@ -0,0 +1,238 @@
+#include "source/common/http/http1/header_scanner.h"
+
+#include <cstdint>
+
+#include "source/common/common/macros.h"
+#include "source/common/http/character_set_validation.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) && !defined(_WIN32) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ENVOY_HEADER_SCANNER_AVX2 1
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ENVOY_HEADER_SCANNER_NEON 1
+#endif
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+bool isTokenChar(char c) { return testCharInTable(kGenericHeaderNameCharTable, c); }
+
+size_t findCrOrLfScalar(const char* data, size_t begin, size_t size) {
+  for (size_t i = begin; i < size; ++i) {
+    if (data[i] == '\r' || data[i] == '\n') {
+      return i;
+    }
+  }
+  return absl::string_view::npos;
+}
+
+bool isValidTokenScalar(const char* data, size_t begin, size_t size) {
+  for (size_t i = begin; i < size; ++i) {
+    if (!isTokenChar(data[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#if !defined(__SSE2__) && !defined(ENVOY_HEADER_SCANNER_NEON)
+
+size_t findCrOrLfGeneric(absl::string_view input) {
+  return findCrOrLfScalar(input.data(), 0, input.size());
+}
+
+bool isValidTokenGeneric(absl::string_view input) {
+  return isValidTokenScalar(input.data(), 0, input.size());
+}
+
+#endif
+
+// The vectorized token scans only check for the characters which make up nearly all header names
+// and methods, i.e. letters, digits and '-'. A block containing any other character is re-checked
+// against the full tchar table, so the result is always exact.
+
+#if defined(__SSE2__)
+
+// Signed byte comparisons are fine for the ranges below as bytes of 0x80 and above compare as
+// negative and therefore fall outside of every range.
+inline __m128i inRangeSse2(__m128i bytes, char low, char high) {
+  return _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(low - 1)),
+                       _mm_cmplt_epi8(bytes, _mm_set1_epi8(high + 1)));
+}
+
+size_t findCrOrLfSse2(absl::string_view input) {
+  const char* data = input.data();
+  const size_t size = input.size();
+  const __m128i cr = _mm_set1_epi8('\r');
+  const __m128i lf = _mm_set1_epi8('\n');
+  size_t i = 0;
+  for (; i + sizeof(__m128i) <= size; i += sizeof(__m128i)) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const int mask = _mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, cr), _mm_cmpeq_epi8(bytes, lf)));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return findCrOrLfScalar(data, i, size);
+}
+
+bool isValidTokenSse2(absl::string_view input) {
+  const char* data = input.data();
+  const size_t size = input.size();
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  const __m128i dash = _mm_set1_epi8('-');
+  size_t i = 0;
+  for (; i + sizeof(__m128i) <= size; i += sizeof(__m128i)) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128i valid =
+        _mm_or_si128(_mm_or_si128(inRangeSse2(_mm_or_si128(bytes, case_bit), 'a', 'z'),
+                                  inRangeSse2(bytes, '0', '9')),
+                     _mm_cmpeq_epi8(bytes, dash));
+    if (_mm_movemask_epi8(valid) != 0xffff &&
+        !isValidTokenScalar(data, i, i + sizeof(__m128i))) {
+      return false;
+    }
+  }
+  return isValidTokenScalar(data, i, size);
+}
+
+#endif
+
+#if defined(ENVOY_HEADER_SCANNER_AVX2)
+
+__attribute__((target("avx2"))) inline __m256i inRangeAvx2(__m256i bytes, char low, char high) {
+  return _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(low - 1)),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(high + 1), bytes));
+}
+
+__attribute__((target("avx2"))) size_t findCrOrLfAvx2(absl::string_view input) {
+  const char* data = input.data();
+  const size_t size = input.size();
+  const __m256i cr = _mm256_set1_epi8('\r');
+  const __m256i lf = _mm256_set1_epi8('\n');
+  size_t i = 0;
+  for (; i + sizeof(__m256i) <= size; i += sizeof(__m256i)) {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, cr), _mm256_cmpeq_epi8(bytes, lf))));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  // Let the SSE2 scan handle a remaining 16 byte block.
+  const size_t result = findCrOrLfSse2(input.substr(i));
+  return result == absl::string_view::npos ? result : i + result;
+}
+
+__attribute__((target("avx2"))) bool isValidTokenAvx2(absl::string_view input) {
+  const char* data = input.data();
+  const size_t size = input.size();
+  const __m256i case_bit = _mm256_set1_epi8(0x20);
+  const __m256i dash = _mm256_set1_epi8('-');
+  size_t i = 0;
+  for (; i + sizeof(__m256i) <= size; i += sizeof(__m256i)) {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    const __m256i valid =
+        _mm256_or_si256(_mm256_or_si256(inRangeAvx2(_mm256_or_si256(bytes, case_bit), 'a', 'z'),
+                                        inRangeAvx2(bytes, '0', '9')),
+                        _mm256_cmpeq_epi8(bytes, dash));
+    if (_mm256_movemask_epi8(valid) != -1 && !isValidTokenScalar(data, i, i + sizeof(__m256i))) {
+      return false;
+    }
+  }
+  return isValidTokenSse2(input.substr(i));
+}
+
+#endif
+
+#if defined(ENVOY_HEADER_SCANNER_NEON)
+
+inline uint8x16_t inRangeNeon(uint8x16_t bytes, uint8_t low, uint8_t high) {
+  return vandq_u8(vcgeq_u8(bytes, vdupq_n_u8(low)), vcleq_u8(bytes, vdupq_n_u8(high)));
+}
+
+size_t findCrOrLfNeon(absl::string_view input) {
+  const char* data = input.data();
+  const size_t size = input.size();
+  const uint8x16_t cr = vdupq_n_u8('\r');
+  const uint8x16_t lf = vdupq_n_u8('\n');
+  size_t i = 0;
+  for (; i + sizeof(uint8x16_t) <= size; i += sizeof(uint8x16_t)) {
+    const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+    if (vmaxvq_u8(vorrq_u8(vceqq_u8(bytes, cr), vceqq_u8(bytes, lf))) != 0) {
+      // The block is known to contain a match, find it with the scalar scan.
+      return findCrOrLfScalar(data, i, i + sizeof(uint8x16_t));
+    }
+  }
+  return findCrOrLfScalar(data, i, size);
+}
+
+bool isValidTokenNeon(absl::string_view input) {
+  const char* data = input.data();
+  const size_t size = input.size();
+  const uint8x16_t case_bit = vdupq_n_u8(0x20);
+  const uint8x16_t dash = vdupq_n_u8('-');
+  size_t i = 0;
+  for (; i + sizeof(uint8x16_t) <= size; i += sizeof(uint8x16_t)) {
+    const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+    const uint8x16_t valid = vorrq_u8(vorrq_u8(inRangeNeon(vorrq_u8(bytes, case_bit), 'a', 'z'),
+                                               inRangeNeon(bytes, '0', '9')),
+                                      vceqq_u8(bytes, dash));
+    if (vminvq_u8(valid) == 0 && !isValidTokenScalar(data, i, i + sizeof(uint8x16_t))) {
+      return false;
+    }
+  }
+  return isValidTokenScalar(data, i, size);
+}
+
+#endif
+
+struct ScannerImpl {
+  absl::string_view name_;
+  size_t (*find_cr_or_lf_)(absl::string_view);
+  bool (*is_valid_token_)(absl::string_view);
+};
+
+ScannerImpl selectImpl() {
+#if defined(ENVOY_HEADER_SCANNER_AVX2)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return {"avx2", findCrOrLfAvx2, isValidTokenAvx2};
+  }
+#endif
+#if defined(__SSE2__)
+  return {"sse2", findCrOrLfSse2, isValidTokenSse2};
+#elif defined(ENVOY_HEADER_SCANNER_NEON)
+  return {"neon", findCrOrLfNeon, isValidTokenNeon};
+#else
+  return {"generic", findCrOrLfGeneric, isValidTokenGeneric};
+#endif
+}
+
+const ScannerImpl& scannerImpl() { CONSTRUCT_ON_FIRST_USE(ScannerImpl, selectImpl()); }
+
+} // namespace
+
+size_t HeaderScanner::findCrOrLf(absl::string_view input) {
+  return scannerImpl().find_cr_or_lf_(input);
+}
+
+bool HeaderScanner::isValidToken(absl::string_view input) {
+  return scannerImpl().is_valid_token_(input);
+}
+
+absl::string_view HeaderScanner::implementationName() { return scannerImpl().name_; }
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+
+/**
+ * Vectorized scans over HTTP/1 header lines. Each scan processes 16 or 32 bytes at a time with
+ * SSE2, AVX2 or NEON, whichever is the widest supported by the CPU, and falls back to a byte by
+ * byte scan for the remainder and on other platforms. The implementation is chosen once per
+ * process at runtime.
+ */
+class HeaderScanner {
+public:
+  /**
+   * @return the offset of the first CR or LF character of `input`, or `absl::string_view::npos` if
+   *         there is none.
+   */
+  static size_t findCrOrLf(absl::string_view input);
+
+  /**
+   * @return true if every character of `input` is a tchar as defined by
+   *         https://www.rfc-editor.org/rfc/rfc9110.html#section-5.6.2, i.e. `input` is a valid
+   *         header name or method if it is also non-empty.
+   */
+  static bool isValidToken(absl::string_view input);
+
+  /**
+   * @return the name of the implementation in use, for tests and benchmarks.
+   */
+  static absl::string_view implementationName();
+};
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
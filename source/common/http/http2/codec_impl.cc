@@ -670,8 +670,7 @@ bool ConnectionImpl::StreamDataFrameSource::Send(absl::string_view frame_header,
   stream_.parent_.protocol_constraints_.incrementOutboundDataFrameCount();
 
   Buffer::OwnedImpl output;
-  stream_.parent_.addOutboundFrameFragment(
-      output, reinterpret_cast<const uint8_t*>(frame_header.data()), frame_header.size());
+  stream_.parent_.addOutboundDataFrameHeader(output, frame_header);
   if (!stream_.parent_.protocol_constraints_.checkOutboundFrameLimits().ok()) {
     ENVOY_CONN_LOG(debug, "error sending data frame: Too many frames in the outbound queue",
                    stream_.parent_.connection_);
@@ -1400,18 +1399,36 @@ int ConnectionImpl::onBeforeFrameSend(int32_t /*stream_id*/, size_t /*length*/,
   return 0;
 }
 
-void ConnectionImpl::addOutboundFrameFragment(Buffer::OwnedImpl& output, const uint8_t* data,
-                                              size_t length) {
+ProtocolConstraints::ReleasorProc ConnectionImpl::trackOutboundFrame() {
   // Reset the outbound frame type (set in the onBeforeFrameSend callback) since the
   // onBeforeFrameSend callback is not called for DATA frames.
   bool is_outbound_flood_monitored_control_frame = false;
   std::swap(is_outbound_flood_monitored_control_frame, is_outbound_flood_monitored_control_frame_);
-  auto releasor =
-      protocol_constraints_.incrementOutboundFrameCount(is_outbound_flood_monitored_control_frame);
+  return protocol_constraints_.incrementOutboundFrameCount(
+      is_outbound_flood_monitored_control_frame);
+}
+
+void ConnectionImpl::addOutboundFrameFragment(Buffer::OwnedImpl& output, const uint8_t* data,
+                                              size_t length) {
+  auto releasor = trackOutboundFrame();
   output.add(data, length);
   output.addDrainTracker(releasor);
 }
 
+void ConnectionImpl::addOutboundDataFrameHeader(Buffer::OwnedImpl& output,
+                                                absl::string_view frame_header) {
+  auto releasor = trackOutboundFrame();
+  // Adding the 9 byte header with add() would allocate a page sized slice, because the tail of the
+  // connection write buffer is usually a full payload slice that cannot absorb it.
+  output.addBufferFragment(*Buffer::OwnedBufferFragmentImpl::create(
+                                frame_header,
+                                [](const Buffer::OwnedBufferFragmentImpl* fragment) {
+                                  delete fragment;
+                                })
+                                .release());
+  output.addDrainTracker(releasor);
+}
+
 Status ConnectionImpl::trackInboundFrames(int32_t stream_id, size_t length, uint8_t type,
                                           uint8_t flags, uint32_t padding_length) {
   Status result;
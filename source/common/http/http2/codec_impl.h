@@ -800,8 +800,14 @@ private:
   int onMetadataReceived(int32_t stream_id, const uint8_t* data, size_t len);
   int onMetadataFrameComplete(int32_t stream_id, bool end_metadata);
 
+  // Counts a new outbound frame against the flood limits and returns the releasor to run once the
+  // frame has been written out.
+  ProtocolConstraints::ReleasorProc trackOutboundFrame();
   // Adds buffer fragment for a new outbound frame to the supplied Buffer::OwnedImpl.
   void addOutboundFrameFragment(Buffer::OwnedImpl& output, const uint8_t* data, size_t length);
+  // Adds the header of an outbound DATA frame to the supplied Buffer::OwnedImpl as its own small
+  // fragment, so that the payload slices moved in after it are written out without being copied.
+  void addOutboundDataFrameHeader(Buffer::OwnedImpl& output, absl::string_view frame_header);
   Status trackInboundFrames(int32_t stream_id, size_t length, uint8_t type, uint8_t flags,
                             uint32_t padding_length);
   void onKeepaliveResponse();
@@ -1,5 +1,7 @@
 #include "source/common/http/http3_status_tracker_impl.h"
 
+#include <algorithm>
+
 namespace Envoy {
 namespace Http {
 
@@ -11,8 +13,11 @@ const std::chrono::minutes DefaultExpirationTime{5};
 const int MaxConsecutiveBrokenCount = 8;
 } // namespace
 
-Http3StatusTrackerImpl::Http3StatusTrackerImpl(Event::Dispatcher& dispatcher)
-    : expiration_timer_(dispatcher.createTimer([this]() -> void { onExpirationTimeout(); })) {}
+Http3StatusTrackerImpl::Http3StatusTrackerImpl(Event::Dispatcher& dispatcher,
+                                               BrokenStatusChangedCb broken_status_changed_cb)
+    : expiration_timer_(dispatcher.createTimer([this]() -> void { onExpirationTimeout(); })),
+      time_source_(dispatcher.timeSource()),
+      broken_status_changed_cb_(std::move(broken_status_changed_cb)) {}
 
 bool Http3StatusTrackerImpl::isHttp3Broken() const { return state_ == State::Broken; }
 
@@ -32,24 +37,53 @@ void Http3StatusTrackerImpl::markHttp3Broken() {
     if (consecutive_broken_count_ < MaxConsecutiveBrokenCount) {
       ++consecutive_broken_count_;
     }
+    if (broken_status_changed_cb_) {
+      broken_status_changed_cb_(time_source_.monotonicTime() + expiration_in_min);
+    }
   }
 }
 
 void Http3StatusTrackerImpl::markHttp3Confirmed() {
+  const bool was_broken = state_ == State::Broken;
   state_ = State::Confirmed;
   consecutive_broken_count_ = 0;
   if (expiration_timer_->enabled()) {
     expiration_timer_->disableTimer();
   }
+  if (was_broken && broken_status_changed_cb_) {
+    broken_status_changed_cb_(absl::nullopt);
+  }
 }
 
 void Http3StatusTrackerImpl::markHttp3FailedRecently() { state_ = State::FailedRecently; }
 
+void Http3StatusTrackerImpl::markHttp3BrokenUntil(MonotonicTime broken_until) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (broken_until <= now) {
+    return;
+  }
+  // The monotonic clock of the previous run may have started earlier, e.g. before a reboot.
+  broken_until = std::min(broken_until, now + maxBrokenPeriod());
+  state_ = State::Broken;
+  // The backoff of the previous run is not known, so the next break backs off as if this was the
+  // first one.
+  consecutive_broken_count_ = 1;
+  expiration_timer_->enableTimer(
+      std::chrono::duration_cast<std::chrono::milliseconds>(broken_until - now));
+}
+
+std::chrono::minutes Http3StatusTrackerImpl::maxBrokenPeriod() {
+  return DefaultExpirationTime * (1 << MaxConsecutiveBrokenCount);
+}
+
 void Http3StatusTrackerImpl::onExpirationTimeout() {
   if (state_ != State::Broken) {
     return;
   }
   state_ = State::FailedRecently;
+  if (broken_status_changed_cb_) {
+    broken_status_changed_cb_(absl::nullopt);
+  }
 }
 
 } // namespace Http
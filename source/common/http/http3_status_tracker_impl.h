@@ -1,7 +1,9 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
+#include "envoy/common/time.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/event/timer.h"
 #include "envoy/http/http_server_properties_cache.h"
@@ -13,7 +15,11 @@ namespace Http {
 // subject to exponential backoff.
 class Http3StatusTrackerImpl : public HttpServerPropertiesCache::Http3StatusTracker {
 public:
-  explicit Http3StatusTrackerImpl(Event::Dispatcher& dispatcher);
+  // Called with the time until which HTTP/3 is marked broken, or with nullopt once it no longer is.
+  using BrokenStatusChangedCb = std::function<void(absl::optional<MonotonicTime> broken_until)>;
+
+  explicit Http3StatusTrackerImpl(Event::Dispatcher& dispatcher,
+                                  BrokenStatusChangedCb broken_status_changed_cb = nullptr);
 
   // Returns true if HTTP/3 is broken.
   bool isHttp3Broken() const override;
@@ -28,6 +34,13 @@ public:
   // Marks HTTP/3 as failed recently.
   void markHttp3FailedRecently() override;
 
+  // Marks HTTP/3 broken until the given time, as restored from a previous run, but for no longer
+  // than maxBrokenPeriod(). Does not invoke the broken status changed callback.
+  void markHttp3BrokenUntil(MonotonicTime broken_until);
+
+  // The longest period for which HTTP/3 is marked broken.
+  static std::chrono::minutes maxBrokenPeriod();
+
 private:
   enum class State {
     Pending,
@@ -44,6 +57,8 @@ private:
   int consecutive_broken_count_{};
   // The timer which tracks when HTTP/3 broken status should expire
   Event::TimerPtr expiration_timer_;
+  TimeSource& time_source_;
+  const BrokenStatusChangedCb broken_status_changed_cb_;
 };
 
 } // namespace Http
@@ -1,5 +1,6 @@
 #include "source/common/http/http_server_properties_cache_impl.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "source/common/common/logger.h"
@@ -58,6 +59,13 @@ std::string HttpServerPropertiesCacheImpl::originDataToStringForCache(const Orig
     }
   }
   absl::StrAppend(&value, "|", data.srtt.count(), "|", data.concurrent_streams);
+  if (data.h3_broken_until.has_value()) {
+    // As with the max age, this is the absolute time at which HTTP/3 stops being broken.
+    absl::StrAppend(&value, "|",
+                    std::chrono::duration_cast<std::chrono::seconds>(
+                        data.h3_broken_until->time_since_epoch())
+                        .count());
+  }
   return value;
 }
 
@@ -65,7 +73,7 @@ absl::optional<HttpServerPropertiesCacheImpl::OriginData>
 HttpServerPropertiesCacheImpl::originDataFromString(absl::string_view origin_data_string,
                                                     TimeSource& time_source, bool from_cache) {
   const std::vector<absl::string_view> parts = absl::StrSplit(origin_data_string, '|');
-  if (parts.size() != 3) {
+  if (parts.size() != 3 && parts.size() != 4) {
     return {};
   }
 
@@ -84,6 +92,14 @@ HttpServerPropertiesCacheImpl::originDataFromString(absl::string_view origin_dat
   }
   data.concurrent_streams = concurrency;
 
+  if (parts.size() == 4) {
+    int64_t h3_broken_until;
+    if (!absl::SimpleAtoi(parts[3], &h3_broken_until)) {
+      return {};
+    }
+    data.h3_broken_until = MonotonicTime(std::chrono::seconds(h3_broken_until));
+  }
+
   return data;
 }
 
@@ -136,7 +152,19 @@ HttpServerPropertiesCacheImpl::HttpServerPropertiesCacheImpl(
         }
         OriginDataWithOptRef data(protocols, origin_data->srtt, nullptr,
                                   origin_data->concurrent_streams);
-        setPropertiesImpl(*origin, data);
+        auto it = setPropertiesImpl(*origin, data);
+        // Keep HTTP/3 broken for the rest of its period, so that connections don't race it again
+        // right after a restart. The period is clamped, since the monotonic clock of the previous
+        // run may have started earlier, e.g. before a reboot.
+        const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+        if (origin_data->h3_broken_until.has_value() && *origin_data->h3_broken_until > now) {
+          const MonotonicTime broken_until = std::min(
+              *origin_data->h3_broken_until, now + Http3StatusTrackerImpl::maxBrokenPeriod());
+          it->second.h3_broken_until = broken_until;
+          std::unique_ptr<Http3StatusTrackerImpl> tracker = createHttp3StatusTracker(*origin);
+          tracker->markHttp3BrokenUntil(broken_until);
+          it->second.h3_status_tracker = std::move(tracker);
+        }
       } else {
         ENVOY_LOG(warn,
                   fmt::format("Unable to parse cache entry with key: {} value: {}", key, value));
@@ -283,17 +311,38 @@ HttpServerPropertiesCacheImpl::getOrCreateHttp3StatusTracker(const Origin& origi
   auto entry_it = protocols_.find(origin);
   if (entry_it != protocols_.end()) {
     if (entry_it->second.h3_status_tracker == nullptr) {
-      entry_it->second.h3_status_tracker = std::make_unique<Http3StatusTrackerImpl>(dispatcher_);
+      entry_it->second.h3_status_tracker = createHttp3StatusTracker(origin);
     }
     return *entry_it->second.h3_status_tracker;
   }
 
   OriginDataWithOptRef data;
-  data.h3_status_tracker = std::make_unique<Http3StatusTrackerImpl>(dispatcher_);
+  data.h3_status_tracker = createHttp3StatusTracker(origin);
   auto it = setPropertiesImpl(origin, data);
   return *it->second.h3_status_tracker;
 }
 
+std::unique_ptr<Http3StatusTrackerImpl>
+HttpServerPropertiesCacheImpl::createHttp3StatusTracker(const Origin& origin) {
+  return std::make_unique<Http3StatusTrackerImpl>(
+      dispatcher_, [this, origin](absl::optional<MonotonicTime> broken_until) {
+        onHttp3BrokenStatusChanged(origin, broken_until);
+      });
+}
+
+void HttpServerPropertiesCacheImpl::onHttp3BrokenStatusChanged(
+    const Origin& origin, absl::optional<MonotonicTime> broken_until) {
+  auto entry_it = protocols_.find(origin);
+  if (entry_it == protocols_.end()) {
+    return;
+  }
+  entry_it->second.h3_broken_until = broken_until;
+  if (key_value_store_) {
+    key_value_store_->addOrUpdate(originToString(origin),
+                                  originDataToStringForCache(entry_it->second), absl::nullopt);
+  }
+}
+
 absl::string_view HttpServerPropertiesCacheImpl::getCanonicalSuffix(absl::string_view hostname) {
   for (const std::string& suffix : canonical_suffixes_) {
     if (absl::EndsWith(hostname, suffix)) {
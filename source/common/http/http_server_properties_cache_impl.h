@@ -50,6 +50,8 @@ public:
     Http3StatusTrackerPtr h3_status_tracker;
     // The number of concurrent streams expected to be allowed.
     uint32_t concurrent_streams;
+    // The time until which HTTP/3 is marked broken, if it is.
+    absl::optional<MonotonicTime> h3_broken_until;
   };
 
   // Converts an Origin to a string which can be parsed by stringToOrigin.
@@ -64,7 +66,7 @@ public:
   // This function also does not do standards-required normalization. Entries requiring
   // normalization will simply not be read from cache.
   // The string format is:
-  // protocols|rtt
+  // protocols|rtt|concurrent_streams[|h3_broken_until]
   static std::string originDataToStringForCache(const OriginData& data);
   // Parse an origin data into structured data, or absl::nullopt
   // if it is empty or invalid.
@@ -133,6 +135,11 @@ private:
 
   ProtocolsMap::iterator addOriginData(const Origin& origin, OriginData&& origin_data);
 
+  // Creates a tracker which records changes of its broken status in the origin's entry.
+  std::unique_ptr<Http3StatusTrackerImpl> createHttp3StatusTracker(const Origin& origin);
+  void onHttp3BrokenStatusChanged(const Origin& origin,
+                                  absl::optional<MonotonicTime> broken_until);
+
   // Returns the canonical suffix, if any, associated with `hostname`.
   absl::string_view getCanonicalSuffix(absl::string_view hostname);
 
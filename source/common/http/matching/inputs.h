@@ -33,7 +33,7 @@ public:
 
     if (header_string.result()) {
       return {Matcher::DataInputGetResult::DataAvailability::AllDataAvailable,
-              std::string(header_string.result().value())};
+              std::move(header_string).resultAsString()};
     }
 
     return {Matcher::DataInputGetResult::DataAvailability::AllDataAvailable, absl::monostate()};
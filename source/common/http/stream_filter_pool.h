@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "envoy/common/pure.h"
+#include "envoy/thread_local/thread_local_object.h"
+
+#include "source/common/common/non_copyable.h"
+#include "source/common/common/node_arena.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * Implemented by filters which can be reused for later streams, so that they can be handed out by
+ * a StreamFilterPool.
+ */
+class ReusableStreamFilter {
+public:
+  virtual ~ReusableStreamFilter() = default;
+
+  /**
+   * Called once the filter manager and everything else has released the filter. Must reset all
+   * the per stream state of the filter, leaving it as if it had just been created.
+   */
+  virtual void resetForReuse() PURE;
+};
+
+/**
+ * A per worker pool of filters. Filters released by their stream are reset and kept for later
+ * streams, up to MaxIdleFilters of them, instead of being destroyed. The control blocks of the
+ * shared pointers handed out are allocated from an arena of the pool, so that acquiring a pooled
+ * filter does not allocate at all.
+ *
+ * Filters and their pool are not thread safe: the last reference to a filter must be released on
+ * the worker which acquired it, as the filter manager does. The pool is kept alive by the filters
+ * it handed out, so it may be released before them.
+ */
+template <class T>
+class StreamFilterPool : public ThreadLocal::ThreadLocalObject,
+                         public std::enable_shared_from_this<StreamFilterPool<T>>,
+                         NonCopyable {
+  static_assert(std::is_base_of<ReusableStreamFilter, T>::value,
+                "pooled filters must implement ReusableStreamFilter");
+
+public:
+  static constexpr uint32_t MaxIdleFilters = 1024;
+
+  /**
+   * @return a filter for a new stream, either an idle one or one returned by create.
+   */
+  template <class CreateFn> std::shared_ptr<T> acquire(CreateFn create) {
+    std::unique_ptr<T> filter;
+    if (idle_.empty()) {
+      filter = create();
+    } else {
+      filter = std::move(idle_.back());
+      idle_.pop_back();
+    }
+    return {filter.release(), Releaser{this}, Allocator<T>(this->shared_from_this())};
+  }
+
+  size_t idleFilters() const { return idle_.size(); }
+
+private:
+  // The allocator of the control blocks keeps the pool alive until the last one is freed, which
+  // happens after the filter has been released.
+  template <class U> class Allocator {
+  public:
+    using value_type = U;
+
+    explicit Allocator(std::shared_ptr<StreamFilterPool> pool) : pool_(std::move(pool)) {}
+    template <class V> Allocator(const Allocator<V>& other) : pool_(other.pool_) {} // NOLINT
+
+    U* allocate(size_t n) { return NodeArenaAllocator<U>(pool_->arena_).allocate(n); }
+    void deallocate(U* p, size_t n) { NodeArenaAllocator<U>(pool_->arena_).deallocate(p, n); }
+
+    template <class V> bool operator==(const Allocator<V>& other) const {
+      return pool_ == other.pool_;
+    }
+
+  private:
+    template <class V> friend class Allocator;
+
+    std::shared_ptr<StreamFilterPool> pool_;
+  };
+
+  struct Releaser {
+    void operator()(T* filter) const { pool_->release(std::unique_ptr<T>(filter)); }
+
+    StreamFilterPool* pool_;
+  };
+
+  void release(std::unique_ptr<T> filter) {
+    if (idle_.size() >= MaxIdleFilters) {
+      return;
+    }
+    filter->resetForReuse();
+    idle_.push_back(std::move(filter));
+  }
+
+  // Declared first, so that it is destroyed after the idle filters.
+  NodeArena arena_;
+  std::vector<std::unique_ptr<T>> idle_;
+};
+
+template <class T> using StreamFilterPoolSharedPtr = std::shared_ptr<StreamFilterPool<T>>;
+
+} // namespace Http
+} // namespace Envoy
@@ -1,6 +1,9 @@
 #include "source/common/io/io_uring_impl.h"
 
 #include <sys/eventfd.h>
+#include <sys/mman.h>
+
+#include <bit>
 
 namespace Envoy {
 namespace Io {
@@ -17,6 +20,89 @@ bool isIoUringSupported() {
   return is_supported;
 }
 
+ProvidedBufferRing::ProvidedBufferRing(uint32_t num_buffers, uint32_t buffer_size)
+    : num_buffers_(std::bit_ceil(num_buffers)), buffer_size_(buffer_size),
+      buffers_(new uint8_t[static_cast<size_t>(num_buffers_) * buffer_size_]),
+      fragments_(num_buffers_) {
+  ASSERT(num_buffers_ > 0 && num_buffers_ <= 32768);
+  for (uint32_t i = 0; i < num_buffers_; i++) {
+    fragments_[i].data_ = bufferAddress(i);
+    fragments_[i].buffer_id_ = i;
+  }
+}
+
+ProvidedBufferRing::~ProvidedBufferRing() { ASSERT(br_ == nullptr); }
+
+int ProvidedBufferRing::registerRing(struct io_uring& ring) {
+  ASSERT(br_ == nullptr);
+  // The kernel requires the ring memory to be page aligned.
+  const size_t ring_size = num_buffers_ * sizeof(struct io_uring_buf);
+  void* ring_addr =
+      mmap(nullptr, ring_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+  if (ring_addr == MAP_FAILED) {
+    return -errno;
+  }
+
+  br_ = static_cast<struct io_uring_buf_ring*>(ring_addr);
+  io_uring_buf_ring_init(br_);
+  struct io_uring_buf_reg reg {};
+  reg.ring_addr = reinterpret_cast<uintptr_t>(br_);
+  reg.ring_entries = num_buffers_;
+  reg.bgid = GroupId;
+  const int ret = io_uring_register_buf_ring(&ring, &reg, 0);
+  if (ret != 0) {
+    munmap(br_, ring_size);
+    br_ = nullptr;
+    return ret;
+  }
+
+  const int mask = io_uring_buf_ring_mask(num_buffers_);
+  for (uint32_t i = 0; i < num_buffers_; i++) {
+    io_uring_buf_ring_add(br_, bufferAddress(i), buffer_size_, i, mask, i);
+  }
+  io_uring_buf_ring_advance(br_, num_buffers_);
+  available_buffers_ = num_buffers_;
+  return 0;
+}
+
+void ProvidedBufferRing::unregisterRing(struct io_uring& ring) {
+  ASSERT(br_ != nullptr);
+  io_uring_unregister_buf_ring(&ring, GroupId);
+  munmap(br_, num_buffers_ * sizeof(struct io_uring_buf));
+  br_ = nullptr;
+  available_buffers_ = 0;
+}
+
+Buffer::BufferFragment& ProvidedBufferRing::takeBuffer(uint16_t buffer_id, uint32_t length) {
+  ASSERT(buffer_id < num_buffers_);
+  ASSERT(length <= buffer_size_);
+  ASSERT(available_buffers_ > 0);
+  available_buffers_--;
+  Fragment& fragment = fragments_[buffer_id];
+  ASSERT(fragment.ring_ == nullptr);
+  fragment.size_ = length;
+  fragment.ring_ = shared_from_this();
+  return fragment;
+}
+
+void ProvidedBufferRing::recycleBuffer(uint16_t buffer_id) {
+  // Buffers drained after the ring has been unregistered are simply dropped.
+  if (br_ == nullptr) {
+    return;
+  }
+  io_uring_buf_ring_add(br_, bufferAddress(buffer_id), buffer_size_, buffer_id,
+                        io_uring_buf_ring_mask(num_buffers_), 0);
+  io_uring_buf_ring_advance(br_, 1);
+  available_buffers_++;
+}
+
+void ProvidedBufferRing::Fragment::done() {
+  // Recycling the last outstanding buffer of an unregistered ring destroys the ring, and this
+  // fragment with it.
+  ProvidedBufferRingSharedPtr ring = std::move(ring_);
+  ring->recycleBuffer(buffer_id_);
+}
+
 IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polling)
     : cqes_(io_uring_size, nullptr) {
   struct io_uring_params p {};
@@ -30,7 +116,12 @@ IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polli
   RELEASE_ASSERT(ret == 0, fmt::format("unable to initialize io_uring: {}", errorDetails(-ret)));
 }
 
-IoUringImpl::~IoUringImpl() { io_uring_queue_exit(&ring_); }
+IoUringImpl::~IoUringImpl() {
+  if (provided_buffers_ != nullptr) {
+    provided_buffers_->unregisterRing(ring_);
+  }
+  io_uring_queue_exit(&ring_);
+}
 
 os_fd_t IoUringImpl::registerEventfd() {
   ASSERT(!isEventfdRegistered());
@@ -69,7 +160,18 @@ void IoUringImpl::forEveryCompletion(const CompletionCb& completion_cb) {
 
   for (unsigned i = 0; i < count; ++i) {
     struct io_uring_cqe* cqe = cqes_[i];
-    completion_cb(reinterpret_cast<Request*>(cqe->user_data), cqe->res, false);
+    Request* req = reinterpret_cast<Request*>(cqe->user_data);
+    if (cqe->flags & IORING_CQE_F_BUFFER) {
+      ASSERT(provided_buffers_ != nullptr);
+      Buffer::BufferFragment& buffer = provided_buffers_->takeBuffer(
+          cqe->flags >> IORING_CQE_BUFFER_SHIFT, std::max(cqe->res, 0));
+      if (cqe->res > 0 && req != nullptr) {
+        req->setProvidedBuffer(buffer);
+      } else {
+        buffer.done();
+      }
+    }
+    completion_cb(req, cqe->res, false);
   }
 
   io_uring_cq_advance(&ring_, count);
@@ -195,6 +297,41 @@ IoUringResult IoUringImpl::prepareShutdown(os_fd_t fd, int how, Request* user_da
   return IoUringResult::Ok;
 }
 
+bool IoUringImpl::registerProvidedBuffers(uint32_t num_buffers, uint32_t buffer_size) {
+  ASSERT(provided_buffers_ == nullptr);
+  auto provided_buffers = std::make_shared<ProvidedBufferRing>(num_buffers, buffer_size);
+  const int ret = provided_buffers->registerRing(ring_);
+  if (ret != 0) {
+    ENVOY_LOG(debug, "unable to register provided buffer ring: {}", errorDetails(-ret));
+    return false;
+  }
+  provided_buffers_ = std::move(provided_buffers);
+  return true;
+}
+
+bool IoUringImpl::hasProvidedBuffers() const {
+  return provided_buffers_ != nullptr && provided_buffers_->hasBuffers();
+}
+
+IoUringResult IoUringImpl::prepareReadProvidedBuffer(os_fd_t fd, Request* user_data) {
+  ENVOY_LOG(trace, "prepare read with provided buffer for fd = {}", fd);
+  ASSERT(provided_buffers_ != nullptr);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  // The kernel picks a buffer from the ring once the data arrives, so an idle socket doesn't hold
+  // any read buffer.
+  io_uring_prep_recv(sqe, fd, nullptr, provided_buffers_->bufferSize(), 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = ProvidedBufferRing::GroupId;
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::submit() {
   int res = io_uring_submit(&ring_);
   RELEASE_ASSERT(res >= 0 || res == -EBUSY, "unable to submit io_uring queue entries");
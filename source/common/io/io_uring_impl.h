@@ -21,6 +21,63 @@ struct InjectedCompletion {
   const int32_t result_;
 };
 
+/**
+ * A ring of equally sized buffers registered with the kernel, which picks one of them for every
+ * read prepared with a buffer selection once data arrives. A selected buffer is handed to the
+ * upper layer as a BufferFragment without copying and goes back to the ring when the fragment is
+ * released. Outstanding fragments keep the ring alive so the memory stays valid after the
+ * io_uring instance is torn down.
+ */
+class ProvidedBufferRing : public std::enable_shared_from_this<ProvidedBufferRing> {
+public:
+  ProvidedBufferRing(uint32_t num_buffers, uint32_t buffer_size);
+  ~ProvidedBufferRing();
+
+  // Registers the ring with the given io_uring. Returns 0 on success or a negative errno, e.g. if
+  // the kernel doesn't support provided buffer rings.
+  int registerRing(struct io_uring& ring);
+  void unregisterRing(struct io_uring& ring);
+
+  // Takes the buffer the kernel selected for a completed read. The buffer goes back to the ring
+  // once done() is called on the returned fragment.
+  Buffer::BufferFragment& takeBuffer(uint16_t buffer_id, uint32_t length);
+
+  bool hasBuffers() const { return br_ != nullptr && available_buffers_ > 0; }
+  uint32_t bufferSize() const { return buffer_size_; }
+
+  // The buffer group id the reads select buffers from.
+  static constexpr uint16_t GroupId = 0;
+
+private:
+  class Fragment : public Buffer::BufferFragment {
+  public:
+    // Buffer::BufferFragment
+    const void* data() const override { return data_; }
+    size_t size() const override { return size_; }
+    void done() override;
+
+    uint8_t* data_{};
+    size_t size_{};
+    uint16_t buffer_id_{};
+    // Set while the buffer is owned by the upper layer.
+    std::shared_ptr<ProvidedBufferRing> ring_;
+  };
+
+  void recycleBuffer(uint16_t buffer_id);
+  uint8_t* bufferAddress(uint16_t buffer_id) const {
+    return buffers_.get() + static_cast<size_t>(buffer_id) * buffer_size_;
+  }
+
+  const uint32_t num_buffers_;
+  const uint32_t buffer_size_;
+  std::unique_ptr<uint8_t[]> buffers_;
+  std::vector<Fragment> fragments_;
+  struct io_uring_buf_ring* br_{nullptr};
+  uint32_t available_buffers_{0};
+};
+
+using ProvidedBufferRingSharedPtr = std::shared_ptr<ProvidedBufferRing>;
+
 class IoUringImpl : public IoUring,
                     public ThreadLocal::ThreadLocalObject,
                     protected Logger::Loggable<Logger::Id::io> {
@@ -43,6 +100,9 @@ public:
   IoUringResult prepareClose(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareCancel(Request* cancelling_user_data, Request* user_data) override;
   IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) override;
+  bool registerProvidedBuffers(uint32_t num_buffers, uint32_t buffer_size) override;
+  bool hasProvidedBuffers() const override;
+  IoUringResult prepareReadProvidedBuffer(os_fd_t fd, Request* user_data) override;
   IoUringResult submit() override;
   void injectCompletion(os_fd_t fd, Request* user_data, int32_t result) override;
   void removeInjectedCompletion(os_fd_t fd) override;
@@ -52,6 +112,7 @@ private:
   std::vector<struct io_uring_cqe*> cqes_;
   os_fd_t event_fd_{INVALID_SOCKET};
   std::list<InjectedCompletion> injected_completions_;
+  ProvidedBufferRingSharedPtr provided_buffers_;
 };
 
 } // namespace Io
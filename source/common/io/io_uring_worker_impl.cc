@@ -10,6 +10,8 @@ ReadRequest::ReadRequest(IoUringSocket& socket, uint32_t size)
   iov_->iov_len = size;
 }
 
+ReadRequest::ReadRequest(IoUringSocket& socket) : Request(RequestType::Read, socket) {}
+
 WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices)
     : Request(RequestType::Write, socket), iov_(std::make_unique<struct iovec[]>(slices.size())) {
   for (size_t i = 0; i < slices.size(); i++) {
@@ -60,9 +62,15 @@ void IoUringSocketEntry::onRemoteClose() {
 
 IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                                      uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                                     Event::Dispatcher& dispatcher)
+                                     uint32_t num_provided_buffers, Event::Dispatcher& dispatcher)
     : IoUringWorkerImpl(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling),
-                        read_buffer_size, write_timeout_ms, dispatcher) {}
+                        read_buffer_size, write_timeout_ms, dispatcher) {
+  // Fall back to a buffer per read request if the kernel doesn't support provided buffer rings.
+  if (num_provided_buffers > 0 &&
+      !io_uring_->registerProvidedBuffers(num_provided_buffers, read_buffer_size_)) {
+    ENVOY_LOG(warn, "provided buffer rings are not supported, each read allocates its buffer");
+  }
+}
 
 IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
                                      uint32_t write_timeout_ms, Event::Dispatcher& dispatcher)
@@ -149,6 +157,10 @@ IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
 }
 
 Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
+  if (io_uring_->hasProvidedBuffers()) {
+    return submitReadProvidedBufferRequest(socket);
+  }
+
   ReadRequest* req = new ReadRequest(socket, read_buffer_size_);
 
   ENVOY_LOG(trace, "submit read request, fd = {}, read req = {}", socket.fd(), fmt::ptr(req));
@@ -164,6 +176,23 @@ Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
   return req;
 }
 
+Request* IoUringWorkerImpl::submitReadProvidedBufferRequest(IoUringSocket& socket) {
+  ReadRequest* req = new ReadRequest(socket);
+
+  ENVOY_LOG(trace, "submit read request with provided buffer, fd = {}, read req = {}", socket.fd(),
+            fmt::ptr(req));
+
+  auto res = io_uring_->prepareReadProvidedBuffer(socket.fd(), req);
+  if (res == IoUringResult::Failed) {
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    submit();
+    res = io_uring_->prepareReadProvidedBuffer(socket.fd(), req);
+    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare read");
+  }
+  submit();
+  return req;
+}
+
 Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
                                                const Buffer::RawSliceVector& slices) {
   WriteRequest* req = new WriteRequest(socket, slices);
@@ -425,6 +454,15 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
 }
 
 void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length) {
+  // The data read into a provided buffer is handed over without copying, the buffer goes back to
+  // the ring once it is drained.
+  Buffer::BufferFragment* provided_buffer = req->releaseProvidedBuffer();
+  if (provided_buffer != nullptr) {
+    ASSERT(provided_buffer->size() == data_length);
+    read_buf_.addBufferFragment(*provided_buffer);
+    return;
+  }
+
   ReadRequest* read_req = static_cast<ReadRequest*>(req);
   Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
       read_req->buf_.release(), data_length,
@@ -463,6 +501,13 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
       closeInternal();
       return;
     }
+
+    // The provided buffer ring ran dry before the data arrived, retry the read. The retry reads
+    // into its own buffer while the ring is empty.
+    if (result == -ENOBUFS && status_ != Closed) {
+      submitReadRequest();
+      return;
+    }
   }
 
   // Move read data from request to buffer or store the error.
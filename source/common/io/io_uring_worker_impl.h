@@ -13,6 +13,8 @@ namespace Io {
 class ReadRequest : public Request {
 public:
   ReadRequest(IoUringSocket& socket, uint32_t size);
+  // A read whose buffer is selected by the kernel from the provided buffer ring on completion.
+  explicit ReadRequest(IoUringSocket& socket);
 
   std::unique_ptr<uint8_t[]> buf_;
   std::unique_ptr<struct iovec> iov_;
@@ -32,7 +34,7 @@ class IoUringWorkerImpl : public IoUringWorker, private Logger::Loggable<Logger:
 public:
   IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                     uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    uint32_t num_provided_buffers, Event::Dispatcher& dispatcher);
   IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size, uint32_t write_timeout_ms,
                     Event::Dispatcher& dispatcher);
   ~IoUringWorkerImpl() override;
@@ -69,6 +71,7 @@ protected:
   IoUringSocketEntry& addSocket(IoUringSocketEntryPtr&& socket);
   void onFileEvent();
   void submit();
+  Request* submitReadProvidedBufferRequest(IoUringSocket& socket);
 
   // The iouring instance.
   IoUringPtr io_uring_;
@@ -492,7 +492,8 @@ void ListenerImpl::buildInternalListener(const envoy::config::listener::v3::List
                                        name_));
     }
     if ((config.has_connection_balance_config() &&
-         config.connection_balance_config().has_exact_balance()) ||
+         (config.connection_balance_config().has_exact_balance() ||
+          config.connection_balance_config().has_power_of_two_choices_balance())) ||
         config.enable_mptcp() ||
         config.has_enable_reuse_port() // internal listener doesn't use physical l4 port.
         || (config.has_freebind() && config.freebind().value()) || config.has_tcp_backlog_size() ||
@@ -751,6 +752,13 @@ void ListenerImpl::buildConnectionBalancer(const envoy::config::listener::v3::Li
         connection_balancers_.emplace(address.asString(),
                                       std::make_shared<Network::ExactConnectionBalancerImpl>());
         break;
+      case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::
+          kPowerOfTwoChoicesBalance:
+        connection_balancers_.emplace(
+            address.asString(),
+            std::make_shared<Network::PowerOfTwoChoicesConnectionBalancerImpl>(
+                parent_.server_.api().randomGenerator()));
+        break;
       case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kExtendBalance: {
         const std::string connection_balance_library_type{TypeUtil::typeUrlToDescriptorFullName(
             config.connection_balance_config().extend_balance().typed_config().type_url())};
@@ -41,8 +41,8 @@ public:
       return {MatchState::MatchComplete, on_no_match_};
     }
 
-    const auto result = doMatch(absl::get<std::string>(input.data_));
-    if (result) {
+    const OnMatch<DataType>* result = doMatch(absl::get<std::string>(input.data_));
+    if (result != nullptr) {
       if (result->matcher_) {
         return result->matcher_->match(data);
       } else {
@@ -63,9 +63,9 @@ protected:
   const absl::optional<OnMatch<DataType>> on_no_match_;
 
   // The inner match method. Attempts to match against the resulting data string. If the match
-  // result was determined, the OnMatch will be returned. If a match result was determined to be no
-  // match, {} will be returned.
-  virtual absl::optional<OnMatch<DataType>> doMatch(const std::string& data) PURE;
+  // result was determined, the OnMatch owned by the matcher will be returned. If a match result was
+  // determined to be no match, nullptr will be returned.
+  virtual const OnMatch<DataType>* doMatch(const std::string& data) PURE;
 };
 
 } // namespace Matcher
@@ -34,5 +34,44 @@ ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&) {
   return *min_connection_handler;
 }
 
+void PowerOfTwoChoicesConnectionBalancerImpl::registerHandler(
+    BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(&lock_);
+  handlers_.push_back(&handler);
+}
+
+void PowerOfTwoChoicesConnectionBalancerImpl::unregisterHandler(
+    BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(&lock_);
+  handlers_.erase(std::find(handlers_.begin(), handlers_.end(), &handler));
+}
+
+BalancedConnectionHandler& PowerOfTwoChoicesConnectionBalancerImpl::pickTargetHandler(
+    BalancedConnectionHandler& current_handler) {
+  BalancedConnectionHandler* target_handler = &current_handler;
+  {
+    // Handlers only change when workers are added or removed, so picks share the lock and the
+    // connection counts, which are atomic, are read without any further synchronization.
+    absl::ReaderMutexLock lock(&lock_);
+    const size_t size = handlers_.size();
+    if (size > 1) {
+      const size_t first = random_.random() % size;
+      // Pick the second handler among the others, so that both choices are always distinct.
+      size_t second = random_.random() % (size - 1);
+      if (second >= first) {
+        second++;
+      }
+      target_handler = handlers_[first];
+      if (handlers_[second]->numConnections() < target_handler->numConnections()) {
+        target_handler = handlers_[second];
+      }
+    }
+
+    target_handler->incNumConnections();
+  }
+
+  return *target_handler;
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "envoy/common/random_generator.h"
 #include "envoy/config/listener/v3/listener.pb.h"
 #include "envoy/network/connection_balancer.h"
 #include "envoy/registry/registry.h"
@@ -44,6 +45,29 @@ private:
   std::vector<BalancedConnectionHandler*> handlers_ ABSL_GUARDED_BY(lock_);
 };
 
+/**
+ * Implementation of connection balancer that picks two distinct handlers at random and hands the
+ * connection to the one with fewer connections. Picks only take a shared lock, so accepts on
+ * different handlers proceed in parallel. Balancing is approximate, as concurrent picks may choose
+ * the same handler, but the load of every handler still stays close to the minimum. This balancer
+ * trades some of the accuracy of ExactConnectionBalancerImpl for accept throughput.
+ */
+class PowerOfTwoChoicesConnectionBalancerImpl : public ConnectionBalancer {
+public:
+  explicit PowerOfTwoChoicesConnectionBalancerImpl(Random::RandomGenerator& random)
+      : random_(random) {}
+
+  // ConnectionBalancer
+  void registerHandler(BalancedConnectionHandler& handler) override;
+  void unregisterHandler(BalancedConnectionHandler& handler) override;
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler) override;
+
+private:
+  Random::RandomGenerator& random_;
+  absl::Mutex lock_;
+  std::vector<BalancedConnectionHandler*> handlers_ ABSL_GUARDED_BY(lock_);
+};
+
 /**
  * A NOP connection balancer implementation that always continues execution after incrementing
  * the handler's connection count.
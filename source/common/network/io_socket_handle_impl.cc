@@ -133,6 +133,11 @@ Api::IoCallUint64Result IoSocketHandleImpl::writev(const Buffer::RawSlice* slice
 }
 
 Api::IoCallUint64Result IoSocketHandleImpl::write(Buffer::Instance& buffer) {
+  // The written bytes are drained, and their slices possibly freed, as soon as the kernel accepted
+  // them. This is why there is no MSG_ZEROCOPY path: the kernel reads zero copy sends after
+  // sendmsg() returns, so the slices would have to stay alive until their completion is read from
+  // the error queue of the socket, and slices which are only partially written could not be
+  // released while the rest of the data is still buffered.
   constexpr uint64_t MaxSlices = 16;
   Buffer::RawSliceVector slices = buffer.getRawSlices(MaxSlices);
   Api::IoCallUint64Result result = writev(slices.begin(), slices.size());
@@ -0,0 +1,362 @@
+#include "source/common/network/io_uring_socket_handle_impl.h"
+
+#include "envoy/buffer/buffer.h"
+#include "envoy/common/exception.h"
+#include "envoy/event/dispatcher.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+#include "source/common/network/io_socket_error_impl.h"
+
+namespace Envoy {
+namespace Network {
+
+namespace {
+
+// Converts the result of an io_uring request, which is a negative errno on failure, into an
+// IoCallUint64Result.
+Api::IoCallUint64Result ioUringResultToIoCallResult(int32_t result) {
+  if (result >= 0) {
+    return {static_cast<uint64_t>(result), Api::IoError::none()};
+  }
+  if (-result == SOCKET_ERROR_AGAIN) {
+    return {0, IoSocketError::getIoSocketEagainError()};
+  }
+  return {0, IoSocketError::create(-result)};
+}
+
+// Returns the result of reading from an io_uring socket whose read buffer is empty.
+Api::IoCallUint64Result emptyReadResult(const Io::ReadParam& read_param) {
+  // A positive result means the data has already been consumed within this read event.
+  if (read_param.result_ > 0) {
+    return {0, IoSocketError::getIoSocketEagainError()};
+  }
+  return ioUringResultToIoCallResult(read_param.result_);
+}
+
+} // namespace
+
+IoUringSocketHandleImpl::IoUringSocketHandleImpl(Io::IoUringWorkerFactory& io_uring_worker_factory,
+                                                 os_fd_t fd, bool socket_v6only,
+                                                 absl::optional<int> domain, bool is_server_socket)
+    : IoSocketHandleImpl(fd, socket_v6only, domain),
+      io_uring_worker_factory_(io_uring_worker_factory),
+      io_uring_socket_type_(is_server_socket ? IoUringSocketType::Server
+                                             : IoUringSocketType::Unknown) {
+  ENVOY_LOG(trace, "construct io uring socket handle, fd = {}, type = {}", fd_,
+            ioUringSocketTypeStr());
+}
+
+IoUringSocketHandleImpl::~IoUringSocketHandleImpl() {
+  if (SOCKET_VALID(fd_) && io_uring_socket_.has_value()) {
+    // If the worker of this thread has already been torn down, it has closed all of its sockets
+    // and the fd must not be closed again by the base class destructor.
+    if (io_uring_worker_factory_.currentThreadRegistered()) {
+      IoUringSocketHandleImpl::close();
+    } else {
+      io_uring_socket_.reset();
+      SET_SOCKET_INVALID(fd_);
+    }
+  }
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::close() {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::close();
+  }
+
+  ENVOY_LOG(trace, "close, fd = {}, type = {}", fd_, ioUringSocketTypeStr());
+  ASSERT(SOCKET_VALID(fd_));
+  // The io_uring socket drains the in-flight requests and closes the fd asynchronously.
+  io_uring_socket_->close(false);
+  io_uring_socket_.reset();
+  SET_SOCKET_INVALID(fd_);
+  return Api::ioCallUint64ResultNoError();
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::readv(uint64_t max_length,
+                                                       Buffer::RawSlice* slices,
+                                                       uint64_t num_slice) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::readv(max_length, slices, num_slice);
+  }
+
+  const auto& read_param = io_uring_socket_->getReadParam();
+  // The data is only available while the read event is being delivered.
+  if (!read_param.has_value()) {
+    return {0, IoSocketError::getIoSocketEagainError()};
+  }
+  if (read_param->buf_.length() == 0) {
+    return emptyReadResult(*read_param);
+  }
+
+  Buffer::Instance& buf = read_param->buf_;
+  const uint64_t max_read_length = std::min(max_length, buf.length());
+  uint64_t num_bytes_to_read = 0;
+  for (uint64_t i = 0; i < num_slice && num_bytes_to_read < max_read_length; i++) {
+    const uint64_t slice_length =
+        std::min(static_cast<uint64_t>(slices[i].len_), max_read_length - num_bytes_to_read);
+    buf.copyOut(num_bytes_to_read, slice_length, slices[i].mem_);
+    num_bytes_to_read += slice_length;
+  }
+  buf.drain(num_bytes_to_read);
+  ENVOY_LOG(trace, "readv, fd = {}, result = {}", fd_, num_bytes_to_read);
+  return {num_bytes_to_read, Api::IoError::none()};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::read(Buffer::Instance& buffer,
+                                                      absl::optional<uint64_t> max_length_opt) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::read(buffer, max_length_opt);
+  }
+
+  const uint64_t max_length = max_length_opt.value_or(UINT64_MAX);
+  if (max_length == 0) {
+    return Api::ioCallUint64ResultNoError();
+  }
+
+  const auto& read_param = io_uring_socket_->getReadParam();
+  if (!read_param.has_value()) {
+    return {0, IoSocketError::getIoSocketEagainError()};
+  }
+  if (read_param->buf_.length() == 0) {
+    return emptyReadResult(*read_param);
+  }
+
+  // The slices filled by the kernel are moved into the destination buffer without copying.
+  const uint64_t move_length = std::min(max_length, read_param->buf_.length());
+  buffer.move(read_param->buf_, move_length);
+  ENVOY_LOG(trace, "read, fd = {}, result = {}", fd_, move_length);
+  return {move_length, Api::IoError::none()};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::writev(const Buffer::RawSlice* slices,
+                                                        uint64_t num_slice) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::writev(slices, num_slice);
+  }
+
+  const auto& write_param = io_uring_socket_->getWriteParam();
+  if (write_param.has_value() && write_param->result_ < 0) {
+    return ioUringResultToIoCallResult(write_param->result_);
+  }
+
+  const uint64_t bytes_written = io_uring_socket_->write(slices, num_slice);
+  ENVOY_LOG(trace, "writev, fd = {}, result = {}", fd_, bytes_written);
+  return {bytes_written, Api::IoError::none()};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::write(Buffer::Instance& buffer) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::write(buffer);
+  }
+
+  const auto& write_param = io_uring_socket_->getWriteParam();
+  if (write_param.has_value() && write_param->result_ < 0) {
+    return ioUringResultToIoCallResult(write_param->result_);
+  }
+
+  // The io_uring socket takes ownership of the slices, which are drained from the buffer.
+  const uint64_t buffer_size = buffer.length();
+  io_uring_socket_->write(buffer);
+  ENVOY_LOG(trace, "write, fd = {}, result = {}", fd_, buffer_size);
+  return {buffer_size, Api::IoError::none()};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::recv(void* buffer, size_t length, int flags) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::recv(buffer, length, flags);
+  }
+
+  // Listener filters peek and drain the data read by the io_uring socket from within the read
+  // event. Peeked data stays in the io_uring socket and is delivered again to the next owner.
+  const auto& read_param = io_uring_socket_->getReadParam();
+  if (!read_param.has_value()) {
+    return {0, IoSocketError::getIoSocketEagainError()};
+  }
+  if (read_param->buf_.length() == 0) {
+    return emptyReadResult(*read_param);
+  }
+
+  const uint64_t copy_length = std::min(static_cast<uint64_t>(length), read_param->buf_.length());
+  read_param->buf_.copyOut(0, copy_length, buffer);
+  if (!(flags & MSG_PEEK)) {
+    read_param->buf_.drain(copy_length);
+  }
+  return {copy_length, Api::IoError::none()};
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::listen(int backlog) {
+  ASSERT(io_uring_socket_type_ == IoUringSocketType::Unknown);
+  io_uring_socket_type_ = IoUringSocketType::Accept;
+  return IoSocketHandleImpl::listen(backlog);
+}
+
+IoHandlePtr IoUringSocketHandleImpl::accept(struct sockaddr* addr, socklen_t* addrlen) {
+  auto result = Api::OsSysCallsSingleton::get().accept(fd_, addr, addrlen);
+  if (SOCKET_INVALID(result.return_value_)) {
+    return nullptr;
+  }
+  ENVOY_LOG(trace, "accept new socket, fd = {}, accepted fd = {}", fd_, result.return_value_);
+  return std::make_unique<IoUringSocketHandleImpl>(io_uring_worker_factory_, result.return_value_,
+                                                   socket_v6only_, domain_, true);
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::connect(Address::InstanceConstSharedPtr address) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::connect(address);
+  }
+
+  ASSERT(io_uring_socket_type_ == IoUringSocketType::Client);
+  ENVOY_LOG(trace, "connect, fd = {}, address = {}", fd_, address->asStringView());
+  // The connect result is delivered as a write event, the same way a non-blocking connect(2)
+  // completes.
+  io_uring_socket_->connect(address);
+  return {-1, SOCKET_ERROR_IN_PROGRESS};
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::getOption(int level, int optname, void* optval,
+                                                         socklen_t* optlen) {
+  // A failed io_uring connect consumes the pending socket error, so report the result of the
+  // connect request while its write event is being delivered.
+  if (io_uring_socket_.has_value() && level == SOL_SOCKET && optname == SO_ERROR &&
+      io_uring_socket_->getWriteParam().has_value() &&
+      io_uring_socket_->getWriteParam()->result_ < 0 && *optlen >= sizeof(int)) {
+    *static_cast<int*>(optval) = -io_uring_socket_->getWriteParam()->result_;
+    *optlen = sizeof(int);
+    return {0, 0};
+  }
+  return IoSocketHandleImpl::getOption(level, optname, optval, optlen);
+}
+
+IoHandlePtr IoUringSocketHandleImpl::duplicate() {
+  auto result = Api::OsSysCallsSingleton::get().duplicate(fd_);
+  RELEASE_ASSERT(result.return_value_ != -1,
+                 fmt::format("duplicate failed for '{}': ({}) {}", fd_, result.errno_,
+                             errorDetails(result.errno_)));
+  return std::make_unique<IoUringSocketHandleImpl>(io_uring_worker_factory_, result.return_value_,
+                                                   socket_v6only_, domain_,
+                                                   io_uring_socket_type_ ==
+                                                       IoUringSocketType::Server);
+}
+
+void IoUringSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher,
+                                                  Event::FileReadyCb cb,
+                                                  Event::FileTriggerType trigger,
+                                                  uint32_t events) {
+  ENVOY_LOG(trace, "initialize file event, fd = {}, type = {}, has io_uring socket = {}", fd_,
+            ioUringSocketTypeStr(), io_uring_socket_.has_value());
+
+  // The io_uring socket survives resetFileEvents(), e.g. when the listener filters hand the
+  // socket over to the connection, so only the callback needs to be replaced.
+  if (io_uring_socket_.has_value()) {
+    io_uring_socket_->setFileReadyCb(std::move(cb));
+    enableFileEvents(events);
+    return;
+  }
+
+  if (io_uring_socket_type_ == IoUringSocketType::Unknown) {
+    io_uring_socket_type_ = IoUringSocketType::Client;
+  }
+
+  OptRef<Io::IoUringWorker> io_uring_worker;
+  if (io_uring_worker_factory_.currentThreadRegistered()) {
+    io_uring_worker = io_uring_worker_factory_.getIoUringWorker();
+  }
+
+  // Accepting is driven by the regular file event, and sockets used on threads without an
+  // io_uring worker keep working through the syscall based implementation.
+  if (io_uring_socket_type_ == IoUringSocketType::Accept || !io_uring_worker.has_value() ||
+      &io_uring_worker->dispatcher() != &dispatcher) {
+    IoSocketHandleImpl::initializeFileEvent(dispatcher, std::move(cb), trigger, events);
+    return;
+  }
+
+  ASSERT(file_event_ == nullptr, "Attempting to initialize an io_uring socket for a file "
+                                 "descriptor with a `file_event_`. This is not allowed.");
+  const bool enable_close_event = events & Event::FileReadyType::Closed;
+  if (io_uring_socket_type_ == IoUringSocketType::Server) {
+    io_uring_socket_ = io_uring_worker->addServerSocket(fd_, std::move(cb), enable_close_event);
+    if (!(events & Event::FileReadyType::Read)) {
+      io_uring_socket_->disableRead();
+    }
+  } else {
+    // The client socket will be read enabled once it is connected.
+    io_uring_socket_ = io_uring_worker->addClientSocket(fd_, std::move(cb), enable_close_event);
+  }
+}
+
+void IoUringSocketHandleImpl::activateFileEvents(uint32_t events) {
+  if (!io_uring_socket_.has_value()) {
+    IoSocketHandleImpl::activateFileEvents(events);
+    return;
+  }
+
+  if (events & Event::FileReadyType::Read) {
+    io_uring_socket_->injectCompletion(Io::Request::RequestType::Read);
+  }
+  if (events & Event::FileReadyType::Write) {
+    io_uring_socket_->injectCompletion(Io::Request::RequestType::Write);
+  }
+}
+
+void IoUringSocketHandleImpl::enableFileEvents(uint32_t events) {
+  if (!io_uring_socket_.has_value()) {
+    IoSocketHandleImpl::enableFileEvents(events);
+    return;
+  }
+
+  io_uring_socket_->enableCloseEvent(events & Event::FileReadyType::Closed);
+  // A connecting client socket is read enabled by the io_uring socket itself.
+  if (io_uring_socket_->getStatus() == Io::IoUringSocketStatus::Initialized) {
+    return;
+  }
+  if (events & Event::FileReadyType::Read) {
+    io_uring_socket_->enableRead();
+  } else {
+    io_uring_socket_->disableRead();
+  }
+}
+
+void IoUringSocketHandleImpl::resetFileEvents() {
+  if (!io_uring_socket_.has_value()) {
+    IoSocketHandleImpl::resetFileEvents();
+    return;
+  }
+
+  // Keep the io_uring socket, and the data it has read, for the next owner of the handle, but make
+  // sure no event is delivered to the previous one.
+  io_uring_socket_->disableRead();
+  io_uring_socket_->enableCloseEvent(false);
+  io_uring_socket_->setFileReadyCb([](uint32_t) {});
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::shutdown(int how) {
+  // The io_uring socket only supports half closing the write side, which is queued behind the
+  // pending writes.
+  if (!io_uring_socket_.has_value() || how != SHUT_WR) {
+    return IoSocketHandleImpl::shutdown(how);
+  }
+
+  ENVOY_LOG(trace, "shutdown, fd = {}, how = {}", fd_, how);
+  io_uring_socket_->shutdown(how);
+  return {0, 0};
+}
+
+std::string IoUringSocketHandleImpl::ioUringSocketTypeStr() const {
+  switch (io_uring_socket_type_) {
+  case IoUringSocketType::Unknown:
+    return "unknown";
+  case IoUringSocketType::Accept:
+    return "accept";
+  case IoUringSocketType::Server:
+    return "server";
+  case IoUringSocketType::Client:
+    return "client";
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+} // namespace Network
+} // namespace Envoy
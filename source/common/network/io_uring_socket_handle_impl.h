@@ -0,0 +1,75 @@
+#pragma once
+
+#include "envoy/common/io/io_uring.h"
+
+#include "source/common/network/io_socket_handle_impl.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * The type of the socket behind an IoUringSocketHandleImpl. The type is decided lazily: a handle
+ * which is listening is an `Accept` socket, a handle returned by `accept()` is a `Server` socket
+ * and any other stream socket is treated as a `Client` socket once its file event is initialized.
+ */
+enum class IoUringSocketType {
+  Unknown,
+  Accept,
+  Server,
+  Client,
+};
+
+/**
+ * IoHandle derivative for TCP sockets which moves the data path onto the thread's io_uring
+ * worker. Reads and writes are submitted to the kernel as io_uring requests and the results are
+ * delivered to the owner through the regular file event callback, so that `ConnectionImpl` and
+ * `TcpListenerImpl` do not need to know about io_uring.
+ *
+ * Listening sockets keep using a regular file event for accepting, and any socket whose file event
+ * is initialized on a thread without an io_uring worker (or whose io_uring socket has not been
+ * created yet) falls back to the plain syscall based implementation of IoSocketHandleImpl.
+ */
+class IoUringSocketHandleImpl : public IoSocketHandleImpl {
+public:
+  IoUringSocketHandleImpl(Io::IoUringWorkerFactory& io_uring_worker_factory,
+                          os_fd_t fd = INVALID_SOCKET, bool socket_v6only = false,
+                          absl::optional<int> domain = absl::nullopt,
+                          bool is_server_socket = false);
+  ~IoUringSocketHandleImpl() override;
+
+  Api::IoCallUint64Result close() override;
+  Api::IoCallUint64Result readv(uint64_t max_length, Buffer::RawSlice* slices,
+                                uint64_t num_slice) override;
+  Api::IoCallUint64Result read(Buffer::Instance& buffer,
+                               absl::optional<uint64_t> max_length) override;
+  Api::IoCallUint64Result writev(const Buffer::RawSlice* slices, uint64_t num_slice) override;
+  Api::IoCallUint64Result write(Buffer::Instance& buffer) override;
+  Api::IoCallUint64Result recv(void* buffer, size_t length, int flags) override;
+  Api::SysCallIntResult listen(int backlog) override;
+  IoHandlePtr accept(struct sockaddr* addr, socklen_t* addrlen) override;
+  Api::SysCallIntResult connect(Address::InstanceConstSharedPtr address) override;
+  Api::SysCallIntResult getOption(int level, int optname, void* optval,
+                                  socklen_t* optlen) override;
+  IoHandlePtr duplicate() override;
+  void initializeFileEvent(Event::Dispatcher& dispatcher, Event::FileReadyCb cb,
+                           Event::FileTriggerType trigger, uint32_t events) override;
+  void activateFileEvents(uint32_t events) override;
+  void enableFileEvents(uint32_t events) override;
+  void resetFileEvents() override;
+  Api::SysCallIntResult shutdown(int how) override;
+
+  IoUringSocketType ioUringSocketType() const { return io_uring_socket_type_; }
+  bool usingIoUring() const { return io_uring_socket_.has_value(); }
+
+private:
+  std::string ioUringSocketTypeStr() const;
+
+  Io::IoUringWorkerFactory& io_uring_worker_factory_;
+  IoUringSocketType io_uring_socket_type_{IoUringSocketType::Unknown};
+  // Set once the socket has been registered with the current thread's io_uring worker. The worker
+  // owns the io_uring socket, this handle only keeps a reference until it is closed.
+  OptRef<Io::IoUringSocket> io_uring_socket_{absl::nullopt};
+};
+
+} // namespace Network
+} // namespace Envoy
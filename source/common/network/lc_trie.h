@@ -106,13 +106,11 @@ public:
     for (const auto& pair_data : data) {
       for (const auto& cidr_range : pair_data.second) {
         if (cidr_range.ip()->version() == Address::IpVersion::v4) {
-          IpPrefix<Ipv4> ip_prefix(ntohl(cidr_range.ip()->ipv4()->address()), cidr_range.length(),
-                                   pair_data.first);
-          ipv4_temp.insert(ip_prefix);
+          ipv4_temp.insert(ntohl(cidr_range.ip()->ipv4()->address()), cidr_range.length(),
+                           pair_data.first);
         } else {
-          IpPrefix<Ipv6> ip_prefix(Utility::Ip6ntohl(cidr_range.ip()->ipv6()->address()),
-                                   cidr_range.length(), pair_data.first);
-          ipv6_temp.insert(ip_prefix);
+          ipv6_temp.insert(Utility::Ip6ntohl(cidr_range.ip()->ipv6()->address()),
+                           cidr_range.length(), pair_data.first);
         }
       }
     }
@@ -249,6 +247,9 @@ private:
     IpPrefix(const IpType& ip, int length, const DataSet& data)
         : ip_(ip), length_(length), data_(data) {}
 
+    IpPrefix(const IpType& ip, int length, DataSet&& data)
+        : ip_(ip), length_(length), data_(std::move(data)) {}
+
     /**
      * @return -1 if the current object is less than other. 0 if they are the same. 1
      * if other is smaller than the current object.
@@ -318,11 +319,14 @@ private:
     /**
      * Add a CIDR prefix and associated data to the binary trie. If an entry already
      * exists for the prefix, merge the data into the existing entry.
+     * @param ip supplies the address of the CIDR prefix in host byte order.
+     * @param length supplies the length of the CIDR prefix.
+     * @param data supplies the data associated with the CIDR prefix.
      */
-    void insert(const IpPrefix<IpType>& prefix) {
+    void insert(const IpType& ip, uint32_t length, const T& data) {
       Node* node = root_.get();
-      for (uint32_t i = 0; i < prefix.length_; i++) {
-        auto bit = static_cast<uint32_t>(extractBits(i, 1, prefix.ip_));
+      for (uint32_t i = 0; i < length; i++) {
+        auto bit = static_cast<uint32_t>(extractBits(i, 1, ip));
         NodePtr& next_node = node->children[bit];
         if (next_node == nullptr) {
           next_node = std::make_unique<Node>();
@@ -332,7 +336,7 @@ private:
       if (node->data == nullptr) {
         node->data = std::make_shared<DataSet>();
       }
-      node->data->insert(prefix.data_.begin(), prefix.data_.end());
+      node->data->insert(data);
     }
 
     /**
@@ -381,7 +385,13 @@ private:
                 if (depth != 0) {
                   ip <<= (address_size - depth);
                 }
-                prefixes.emplace_back(IpPrefix<IpType>(ip, depth, *node->data));
+                if (node->data.use_count() == 1) {
+                  // The data set is not inherited by any other node, so it can be moved to
+                  // the prefix instead of being copied.
+                  prefixes.emplace_back(ip, depth, std::move(*node->data));
+                } else {
+                  prefixes.emplace_back(ip, depth, *node->data);
+                }
               }
             }
           };
@@ -416,7 +426,8 @@ private:
   public:
     /**
      * Construct a LC-Trie for IpType.
-     * @param data supplies a vector of data and CIDR ranges (in IpPrefix format).
+     * @param data supplies a vector of data and CIDR ranges (in IpPrefix format). The vector is
+     *             moved into the trie.
      * @param fill_factor supplies the fraction of completeness to use when calculating the branch
      *                    value for a sub-trie.
      * @param root_branching_factor supplies the branching factor at the root. The paper suggests
@@ -444,7 +455,7 @@ private:
         return;
       }
 
-      ip_prefixes_ = data;
+      ip_prefixes_ = std::move(data);
       std::sort(ip_prefixes_.begin(), ip_prefixes_.end());
 
       // Build the trie_.
@@ -2,6 +2,7 @@
 
 #include "envoy/common/exception.h"
 #include "envoy/extensions/network/socket_interface/v3/default_socket_interface.pb.h"
+#include "envoy/extensions/network/socket_interface/v3/default_socket_interface.pb.validate.h"
 
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/common/assert.h"
@@ -9,10 +10,23 @@
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/win32_socket_handle_impl.h"
+#include "source/common/protobuf/utility.h"
+
+#ifdef __linux__
+#include "source/common/io/io_uring_impl.h"
+#include "source/common/io/io_uring_worker_factory_impl.h"
+#include "source/common/network/io_uring_socket_handle_impl.h"
+#endif
 
 namespace Envoy {
 namespace Network {
 
+void DefaultSocketInterfaceExtension::onServerInitialized() {
+  if (io_uring_worker_factory_ != nullptr) {
+    io_uring_worker_factory_->onWorkerThreadInitialized();
+  }
+}
+
 IoHandlePtr SocketInterfaceImpl::makePlatformSpecificSocket(int socket_fd, bool socket_v6only,
                                                             absl::optional<int> domain) {
   if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
@@ -26,6 +40,31 @@ IoHandlePtr SocketInterfaceImpl::makeSocket(int socket_fd, bool socket_v6only,
   return makePlatformSpecificSocket(socket_fd, socket_v6only, domain);
 }
 
+IoHandlePtr SocketInterfaceImpl::makeIoUringSocket(int socket_fd, bool socket_v6only,
+                                                   absl::optional<int> domain,
+                                                   Socket::Type socket_type,
+                                                   Address::Type addr_type) const {
+#ifdef __linux__
+  if (socket_type != Socket::Type::Stream || addr_type != Address::Type::Ip) {
+    return nullptr;
+  }
+  std::shared_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory =
+      io_uring_worker_factory_.lock();
+  if (io_uring_worker_factory == nullptr) {
+    return nullptr;
+  }
+  return std::make_unique<IoUringSocketHandleImpl>(*io_uring_worker_factory, socket_fd,
+                                                   socket_v6only, domain);
+#else
+  UNREFERENCED_PARAMETER(socket_fd);
+  UNREFERENCED_PARAMETER(socket_v6only);
+  UNREFERENCED_PARAMETER(domain);
+  UNREFERENCED_PARAMETER(socket_type);
+  UNREFERENCED_PARAMETER(addr_type);
+  return nullptr;
+#endif
+}
+
 IoHandlePtr SocketInterfaceImpl::socket(Socket::Type socket_type, Address::Type addr_type,
                                         Address::IpVersion version, bool socket_v6only,
                                         const SocketCreationOptions& options) const {
@@ -78,7 +117,11 @@ IoHandlePtr SocketInterfaceImpl::socket(Socket::Type socket_type, Address::Type
                      fmt::format("socket(2) failed, got error: {}", errorDetails(result.errno_)));
     }
   }
-  IoHandlePtr io_handle = makeSocket(result.return_value_, socket_v6only, domain);
+  IoHandlePtr io_handle =
+      makeIoUringSocket(result.return_value_, socket_v6only, domain, socket_type, addr_type);
+  if (io_handle == nullptr) {
+    io_handle = makeSocket(result.return_value_, socket_v6only, domain);
+  }
 
 #if defined(__APPLE__) || defined(WIN32)
   // Cannot set SOCK_NONBLOCK as a ::socket flag.
@@ -131,10 +174,34 @@ bool SocketInterfaceImpl::ipFamilySupported(int domain) {
   return SOCKET_VALID(result.return_value_);
 }
 
-Server::BootstrapExtensionPtr
-SocketInterfaceImpl::createBootstrapExtension(const Protobuf::Message&,
-                                              Server::Configuration::ServerFactoryContext&) {
-  return std::make_unique<SocketInterfaceExtension>(*this);
+Server::BootstrapExtensionPtr SocketInterfaceImpl::createBootstrapExtension(
+    const Protobuf::Message& message, Server::Configuration::ServerFactoryContext& context) {
+#ifdef __linux__
+  const auto& config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::network::socket_interface::v3::DefaultSocketInterface&>(
+      message, context.messageValidationVisitor());
+  if (config.has_io_uring_options()) {
+    if (Io::isIoUringSupported()) {
+      const auto& options = config.io_uring_options();
+      std::shared_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory =
+          std::make_shared<Io::IoUringWorkerFactoryImpl>(
+              PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, io_uring_size, 1000),
+              options.enable_submission_queue_polling(),
+              PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, read_buffer_size, 8192),
+              PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, write_timeout_ms, 1000),
+              PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, provided_buffers, 0),
+              context.threadLocal());
+      io_uring_worker_factory_ = io_uring_worker_factory;
+      return std::make_unique<DefaultSocketInterfaceExtension>(*this, io_uring_worker_factory);
+    }
+    ENVOY_LOG_MISC(warn, "io_uring is enabled but not supported by the kernel, falling back to "
+                         "the default socket API");
+  }
+#else
+  UNREFERENCED_PARAMETER(message);
+  UNREFERENCED_PARAMETER(context);
+#endif
+  return std::make_unique<DefaultSocketInterfaceExtension>(*this, nullptr);
 }
 
 ProtobufTypes::MessagePtr SocketInterfaceImpl::createEmptyConfigProto() {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "envoy/common/io/io_uring.h"
 #include "envoy/network/socket.h"
 
 #include "source/common/network/socket_interface.h"
@@ -7,6 +8,22 @@
 namespace Envoy {
 namespace Network {
 
+// Bootstrap extension of the default socket interface. It owns the io_uring worker factory, if
+// io_uring is enabled, and registers the io_uring workers once the server is initialized.
+class DefaultSocketInterfaceExtension : public SocketInterfaceExtension {
+public:
+  DefaultSocketInterfaceExtension(SocketInterface& sock_interface,
+                                  std::shared_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory)
+      : SocketInterfaceExtension(sock_interface),
+        io_uring_worker_factory_(std::move(io_uring_worker_factory)) {}
+
+  // Server::BootstrapExtension
+  void onServerInitialized() override;
+
+protected:
+  std::shared_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory_;
+};
+
 class SocketInterfaceImpl : public SocketInterfaceBase {
 public:
   // SocketInterface
@@ -32,6 +49,15 @@ public:
 protected:
   virtual IoHandlePtr makeSocket(int socket_fd, bool socket_v6only,
                                  absl::optional<int> domain) const;
+
+private:
+  // Returns an io_uring backed IoHandle for TCP sockets if io_uring is enabled, nullptr otherwise.
+  IoHandlePtr makeIoUringSocket(int socket_fd, bool socket_v6only, absl::optional<int> domain,
+                                Socket::Type socket_type, Address::Type addr_type) const;
+
+  // The factory is owned by the DefaultSocketInterfaceExtension, and is only set if io_uring is
+  // enabled and supported.
+  std::weak_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory_;
 };
 
 DECLARE_FACTORY(SocketInterfaceImpl);
@@ -117,6 +117,16 @@ SocketOptionFactory::buildTcpFastOpenOptions(uint32_t queue_length) {
   return options;
 }
 
+std::unique_ptr<Socket::Options> SocketOptionFactory::buildTcpNotsentLowatOptions(uint32_t lowat) {
+  // Limits the unsent data queued in the kernel, so that the rest stays in the connection's buffer
+  // and counts towards its watermarks.
+  std::unique_ptr<Socket::Options> options = std::make_unique<Socket::Options>();
+  options->push_back(std::make_shared<Network::SocketOptionImpl>(
+      envoy::config::core::v3::SocketOption::STATE_PREBIND, ENVOY_SOCKET_TCP_NOTSENT_LOWAT, lowat,
+      absl::optional<Network::Socket::Type>(Network::Socket::Type::Stream)));
+  return options;
+}
+
 std::unique_ptr<Socket::Options> SocketOptionFactory::buildIpPacketInfoOptions() {
   std::unique_ptr<Socket::Options> options = std::make_unique<Socket::Options>();
   options->push_back(std::make_shared<AddrFamilyAwareSocketOptionImpl>(
@@ -18,17 +18,21 @@
 namespace Envoy {
 namespace Network {
 
-bool TcpListenerImpl::rejectCxOverGlobalLimit() const {
+bool TcpListenerImpl::rejectCxOverGlobalLimit(
+    Runtime::SnapshotConstSharedPtr& runtime_snapshot) const {
   // Enforce the global connection limit if necessary, immediately closing the accepted connection.
   if (ignore_global_conn_limit_) {
     return false;
   }
+  if (runtime_snapshot == nullptr) {
+    runtime_snapshot = runtime_.threadsafeSnapshot();
+  }
   // TODO(nezdolik): deprecate `overload.global_downstream_max_connections` key once
   // downstream connections monitor extension is stable.
   if (track_global_cx_limit_in_overload_manager_) {
     // Check if runtime flag `overload.global_downstream_max_connections` is configured
     // simultaneously with downstream connections monitor in overload manager.
-    if (runtime_.threadsafeSnapshot()->get(Runtime::Keys::GlobalMaxCxRuntimeKey)) {
+    if (runtime_snapshot->get(Runtime::Keys::GlobalMaxCxRuntimeKey)) {
       ENVOY_LOG_ONCE_MISC(
           warn,
           "Global downstream connections limits is configured via deprecated runtime key {} and in "
@@ -47,7 +51,7 @@ bool TcpListenerImpl::rejectCxOverGlobalLimit() const {
     // FakeUpstreams use a listener and do not run in a worker thread. In practice, this code path
     // will always be run on a worker thread, but to prevent failed assertions in test environments,
     // threadsafe snapshots must be used. This must be revisited.
-    const uint64_t global_cx_limit = runtime_.threadsafeSnapshot()->getInteger(
+    const uint64_t global_cx_limit = runtime_snapshot->getInteger(
         Runtime::Keys::GlobalMaxCxRuntimeKey, std::numeric_limits<uint64_t>::max());
     return AcceptedSocketImpl::acceptedSocketCount() >= global_cx_limit;
   }
@@ -58,6 +62,7 @@ void TcpListenerImpl::onSocketEvent(short flags) {
   ASSERT(flags & (Event::FileReadyType::Read));
 
   uint32_t connections_accepted_from_kernel_count = 0;
+  Runtime::SnapshotConstSharedPtr runtime_snapshot;
   for (; connections_accepted_from_kernel_count < max_connections_to_accept_per_socket_event_;
        ++connections_accepted_from_kernel_count) {
     if (!socket_->ioHandle().isOpen()) {
@@ -73,7 +78,7 @@ void TcpListenerImpl::onSocketEvent(short flags) {
       break;
     }
 
-    if (rejectCxOverGlobalLimit()) {
+    if (rejectCxOverGlobalLimit(runtime_snapshot)) {
       // The global connection limit has been reached.
       io_handle->close();
       cb_.onReject(TcpListenerCallbacks::RejectCause::GlobalCxLimit);
@@ -39,7 +39,8 @@ private:
 
   // Returns true if global connection limit has been reached and the accepted socket should be
   // rejected/closed. If the accepted socket is to be admitted, false is returned.
-  bool rejectCxOverGlobalLimit() const;
+  // The runtime snapshot is taken on first use, and shared by the sockets accepted on one event.
+  bool rejectCxOverGlobalLimit(Runtime::SnapshotConstSharedPtr& runtime_snapshot) const;
 
   Random::RandomGenerator& random_;
   Runtime::Loader& runtime_;
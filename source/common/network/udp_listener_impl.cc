@@ -102,6 +102,12 @@ void UdpListenerImpl::handleReadCallback() {
   const Api::IoErrorPtr result = Utility::readPacketsFromSocket(
       socket_->ioHandle(), *socket_->connectionInfoProvider().localAddress(), *this, time_source_,
       config_.prefer_gro_, /*allow_mmsg=*/true, packets_dropped_);
+  // The datagrams sent by the filters while processing the packets which were just read, replies
+  // in particular, are written together instead of waiting for a later flush by the filters.
+  Network::UdpPacketWriter& udp_packet_writer = cb_.udpPacketWriter();
+  if (udp_packet_writer.isBatchMode()) {
+    udp_packet_writer.flush();
+  }
   if (result == nullptr) {
     // No error. The number of reads was limited by read rate. There are more packets to read.
     // Register to read more in the next event loop.
@@ -94,7 +94,8 @@ uint64_t convertPercent(double percent, uint64_t max_value) {
   return max_value * (percent / 100.0);
 }
 
-bool evaluateFractionalPercent(envoy::type::v3::FractionalPercent percent, uint64_t random_value) {
+bool evaluateFractionalPercent(const envoy::type::v3::FractionalPercent& percent,
+                               uint64_t random_value) {
   return random_value % fractionalPercentDenominatorToInt(percent.denominator()) <
          percent.numerator();
 }
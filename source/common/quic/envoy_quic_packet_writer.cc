@@ -35,18 +35,29 @@ quic::WriteResult EnvoyQuicPacketWriter::WritePacket(
   Buffer::OwnedImpl buf;
   buf.addBufferFragment(fragment);
 
-  quic::QuicSocketAddress self_address(self_ip, /*port=*/0);
-  Network::Address::InstanceConstSharedPtr local_addr =
-      quicAddressToEnvoyAddressInstance(self_address);
-  Network::Address::InstanceConstSharedPtr remote_addr =
-      quicAddressToEnvoyAddressInstance(peer_address);
-
   Api::IoCallUint64Result result = envoy_udp_packet_writer_->writePacket(
-      buf, local_addr == nullptr ? nullptr : local_addr->ip(), *remote_addr);
+      buf, toEnvoySelfIp(self_ip), *toEnvoyAddress(peer_address, peer_address_));
 
   return convertToQuicWriteResult(result);
 }
 
+const Network::Address::InstanceConstSharedPtr&
+EnvoyQuicPacketWriter::toEnvoyAddress(const quic::QuicSocketAddress& address,
+                                      CachedAddress& cache) {
+  if (address != cache.quic_address_ || cache.envoy_address_ == nullptr) {
+    cache.envoy_address_ = quicAddressToEnvoyAddressInstance(address);
+    cache.quic_address_ = address;
+  }
+  return cache.envoy_address_;
+}
+
+const Network::Address::Ip*
+EnvoyQuicPacketWriter::toEnvoySelfIp(const quic::QuicIpAddress& self_ip) {
+  const Network::Address::InstanceConstSharedPtr& local_addr =
+      toEnvoyAddress(quic::QuicSocketAddress(self_ip, /*port=*/0), self_address_);
+  return local_addr == nullptr ? nullptr : local_addr->ip();
+}
+
 absl::optional<int> EnvoyQuicPacketWriter::MessageTooBigErrorCode() const { return EMSGSIZE; }
 
 quic::QuicByteCount
@@ -59,13 +70,8 @@ EnvoyQuicPacketWriter::GetMaxPacketSize(const quic::QuicSocketAddress& peer_addr
 quic::QuicPacketBuffer
 EnvoyQuicPacketWriter::GetNextWriteLocation(const quic::QuicIpAddress& self_ip,
                                             const quic::QuicSocketAddress& peer_address) {
-  quic::QuicSocketAddress self_address(self_ip, /*port=*/0);
-  Network::Address::InstanceConstSharedPtr local_addr =
-      quicAddressToEnvoyAddressInstance(self_address);
-  Network::Address::InstanceConstSharedPtr remote_addr =
-      quicAddressToEnvoyAddressInstance(peer_address);
   Network::UdpPacketWriterBuffer write_location = envoy_udp_packet_writer_->getNextWriteLocation(
-      local_addr == nullptr ? nullptr : local_addr->ip(), *remote_addr);
+      toEnvoySelfIp(self_ip), *toEnvoyAddress(peer_address, peer_address_));
   return {reinterpret_cast<char*>(write_location.buffer_), write_location.release_buffer_};
 }
 
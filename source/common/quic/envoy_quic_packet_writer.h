@@ -1,8 +1,10 @@
 #pragma once
 
+#include "envoy/network/address.h"
 #include "envoy/network/udp_packet_writer_handler.h"
 
 #include "quiche/quic/core/quic_packet_writer.h"
+#include "quiche/quic/platform/api/quic_socket_address.h"
 
 namespace Envoy {
 namespace Quic {
@@ -33,7 +35,21 @@ public:
   quic::WriteResult Flush() override;
 
 private:
+  // The last QUIC address converted into an Envoy address.
+  struct CachedAddress {
+    quic::QuicSocketAddress quic_address_;
+    Network::Address::InstanceConstSharedPtr envoy_address_;
+  };
+
+  // Consecutive packets, such as the ones of a paced burst, usually share their addresses, so the
+  // last conversion is reused instead of allocating a new address for every packet.
+  static const Network::Address::InstanceConstSharedPtr&
+  toEnvoyAddress(const quic::QuicSocketAddress& address, CachedAddress& cache);
+  const Network::Address::Ip* toEnvoySelfIp(const quic::QuicIpAddress& self_ip);
+
   Network::UdpPacketWriterPtr envoy_udp_packet_writer_;
+  CachedAddress self_address_;
+  CachedAddress peer_address_;
 };
 
 } // namespace Quic
@@ -225,14 +225,7 @@ void EnvoyQuicServerStream::OnBodyAvailable() {
   Buffer::InstancePtr buffer = std::make_unique<Buffer::OwnedImpl>();
   // TODO(danzh): check Envoy per stream buffer limit.
   // Currently read out all the data.
-  while (HasBytesToRead()) {
-    iovec iov;
-    int num_regions = GetReadableRegions(&iov, 1);
-    ASSERT(num_regions > 0);
-    size_t bytes_read = iov.iov_len;
-    buffer->add(iov.iov_base, bytes_read);
-    MarkConsumed(bytes_read);
-  }
+  readBodyFromSequencer(*buffer);
 
   bool fin_read_and_no_trailers = IsDoneReading();
   ENVOY_STREAM_LOG(debug, "Received {} bytes of data {} FIN.", *this, buffer->length(),
@@ -79,6 +79,27 @@ void EnvoyQuicStream::encodeData(Buffer::Instance& data, bool end_stream) {
   }
 }
 
+void EnvoyQuicStream::readBodyFromSequencer(Buffer::Instance& buffer) {
+  constexpr size_t MaxRegionsPerRead = 16;
+  while (quic_stream_.HasBytesToRead()) {
+    iovec iovs[MaxRegionsPerRead];
+    const int num_regions = quic_stream_.GetReadableRegions(iovs, MaxRegionsPerRead);
+    ASSERT(num_regions > 0);
+    size_t bytes_readable = 0;
+    for (int i = 0; i < num_regions; ++i) {
+      bytes_readable += iovs[i].iov_len;
+    }
+    Buffer::ReservationSingleSlice reservation = buffer.reserveSingleSlice(bytes_readable);
+    uint8_t* dest = static_cast<uint8_t*>(reservation.slice().mem_);
+    for (int i = 0; i < num_regions; ++i) {
+      memcpy(dest, iovs[i].iov_base, iovs[i].iov_len); // NOLINT(safe-memcpy)
+      dest += iovs[i].iov_len;
+    }
+    reservation.commit(bytes_readable);
+    quic_stream_.MarkConsumed(bytes_readable);
+  }
+}
+
 void EnvoyQuicStream::encodeTrailersImpl(spdy::Http2HeaderBlock&& trailers) {
   if (quic_stream_.write_side_closed()) {
     IS_ENVOY_BUG("encodeTrailers is called on write-closed stream.");
@@ -178,6 +178,11 @@ protected:
 
   StreamInfo::BytesMeterSharedPtr& mutableBytesMeter() { return bytes_meter_; }
 
+  // Drains all readable body bytes from the QUIC stream sequencer into |buffer|. The sequencer
+  // owns and recycles its blocks, so the bytes are copied, but into a single reservation and with
+  // a single MarkConsumed() call rather than one per readable region.
+  void readBodyFromSequencer(Buffer::Instance& buffer);
+
   void encodeTrailersImpl(spdy::Http2HeaderBlock&& trailers);
 
 #ifdef ENVOY_ENABLE_HTTP_DATAGRAMS
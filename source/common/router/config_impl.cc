@@ -225,6 +225,30 @@ createRedirectConfig(const envoy::config::route::v3::Route& route) {
   return redirect_config;
 }
 
+ProtobufWkt::FieldMask fieldMaskWithoutVirtualHosts() {
+  ProtobufWkt::FieldMask mask;
+  const Protobuf::Descriptor* descriptor =
+      envoy::config::route::v3::RouteConfiguration::descriptor();
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    if (descriptor->field(i)->number() !=
+        envoy::config::route::v3::RouteConfiguration::kVirtualHostsFieldNumber) {
+      mask.add_paths(descriptor->field(i)->name());
+    }
+  }
+  return mask;
+}
+
+// Hashes the route configuration without its virtual hosts, i.e. everything the global route
+// config of the virtual hosts is built from, without copying the virtual hosts.
+uint64_t hashWithoutVirtualHosts(const envoy::config::route::v3::RouteConfiguration& config) {
+  static const ProtobufWkt::FieldMask* mask =
+      new ProtobufWkt::FieldMask(fieldMaskWithoutVirtualHosts());
+  envoy::config::route::v3::RouteConfiguration shared_config;
+  ProtobufUtil::FieldMaskUtil::MergeMessageTo(
+      config, *mask, ProtobufUtil::FieldMaskUtil::MergeOptions(), &shared_config);
+  return MessageUtil::hash(shared_config);
+}
+
 } // namespace
 
 const std::string& OriginalConnectPort::key() {
@@ -1550,7 +1574,10 @@ RegexRouteEntryImpl::RegexRouteEntryImpl(
     Server::Configuration::ServerFactoryContext& factory_context,
     ProtobufMessage::ValidationVisitor& validator)
     : RouteEntryImplBase(vhost, route, factory_context, validator),
-      path_matcher_(Matchers::PathMatcher::createSafeRegex(route.match().safe_regex())) {
+      path_matcher_(Matchers::PathMatcher::createSafeRegex(route.match().safe_regex())),
+      uses_google_re2_(route.match().safe_regex().has_google_re2() ||
+                       dynamic_cast<const Regex::GoogleReEngine*>(
+                           Regex::EngineSingleton::getExisting()) != nullptr) {
   ASSERT(route.match().path_specifier_case() ==
          envoy::config::route::v3::RouteMatch::PathSpecifierCase::kSafeRegex);
 }
@@ -1819,6 +1846,30 @@ VirtualHostImpl::VirtualHostImpl(
       routes_.emplace_back(createAndValidateRoute(route, shared_virtual_host_, factory_context,
                                                   validator, validation_clusters));
     }
+    buildPathIndex();
+  }
+}
+
+void VirtualHostImpl::buildPathIndex() {
+  auto path_index = std::make_unique<RoutePathIndex>();
+  for (uint32_t i = 0; i < routes_.size(); ++i) {
+    const RouteEntryImplBase& route = *routes_[i];
+    if (route.case_sensitive() && route.matchType() == PathMatchType::Prefix) {
+      path_index->addPrefix(route.matcher(), i);
+    } else if (route.case_sensitive() && route.matchType() == PathMatchType::Exact) {
+      path_index->addExact(route.matcher(), i);
+    } else if (route.matchType() == PathMatchType::Regex &&
+               static_cast<const RegexRouteEntryImpl&>(route).usesGoogleRe2()) {
+      if (!path_index->addRegex(route.matcher(), i)) {
+        path_index->addUnindexed(i);
+      }
+    } else {
+      path_index->addUnindexed(i);
+    }
+  }
+  path_index->compile();
+  if (path_index->indexedRoutes() >= RoutePathIndex::MinIndexedRoutes) {
+    path_index_ = std::move(path_index);
   }
 }
 
@@ -1862,6 +1913,34 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
   return nullptr;
 }
 
+RouteConstSharedPtr
+VirtualHostImpl::getRouteFromPathIndex(const Http::RequestHeaderMap& headers,
+                                       const StreamInfo::StreamInfo& stream_info,
+                                       uint64_t random_value) const {
+  // Mirror the path the prefix and exact path routes match against, see
+  // RouteEntryImplBase::sanitizePathBeforePathMatching() and Matchers::PathMatcher.
+  absl::string_view path = headers.getPathValue();
+  if (shared_virtual_host_->globalRouteConfig().ignorePathParametersInPathMatching()) {
+    path = path.substr(0, path.find_first_of(';'));
+  }
+  path = Http::PathUtil::removeQueryAndFragment(path);
+
+  // A route which is not a candidate cannot match the path, so evaluating the candidates in
+  // config order finds the same route as evaluating all of the routes.
+  RoutePathIndex::Candidates candidates;
+  path_index_->findCandidates(path, candidates);
+  for (const uint32_t candidate : candidates) {
+    RouteConstSharedPtr route_entry =
+        routes_[candidate]->matches(headers, stream_info, random_value);
+    if (route_entry != nullptr) {
+      return route_entry;
+    }
+  }
+
+  ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  return nullptr;
+}
+
 RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb,
                                                          const Http::RequestHeaderMap& headers,
                                                          const StreamInfo::StreamInfo& stream_info,
@@ -1910,36 +1989,20 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     return nullptr;
   }
 
-  // Check for a route that matches the request.
-  return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
-}
-
-const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
-    absl::string_view host, const RouteMatcher::WildcardVirtualHosts& wildcard_virtual_hosts,
-    RouteMatcher::SubstringFunction substring_function) const {
-  // We do a longest wildcard match against the host that's passed in
-  // (e.g. "foo-bar.baz.com" should match "*-bar.baz.com" before matching "*.baz.com" for suffix
-  // wildcards). This is done by scanning the length => wildcards map looking for every wildcard
-  // whose size is < length.
-  for (const auto& iter : wildcard_virtual_hosts) {
-    const uint32_t wildcard_length = iter.first;
-    const auto& wildcard_map = iter.second;
-    // >= because *.foo.com shouldn't match .foo.com.
-    if (wildcard_length >= host.size()) {
-      continue;
-    }
-    const auto match = wildcard_map.find(substring_function(host, wildcard_length));
-    if (match != wildcard_map.end()) {
-      return match->second.get();
-    }
+  // Check for a route that matches the request. The path index is not used with a callback, which
+  // is told whether more routes follow the one it is offered, nor for requests without a path,
+  // for which only the routes supporting pathless headers are evaluated.
+  if (path_index_ != nullptr && cb == nullptr && headers.Path() != nullptr) {
+    return getRouteFromPathIndex(headers, stream_info, random_value);
   }
-  return nullptr;
+  return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
 
 RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& route_config,
                            const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
-                           ProtobufMessage::ValidationVisitor& validator, bool validate_clusters)
+                           ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                           const RouteMatcher* previous_matcher)
     : vhost_scope_(factory_context.scope().scopeFromStatName(
           factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()) {
@@ -1948,9 +2011,25 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
     validation_clusters = factory_context.clusterManager().clusters();
   }
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostSharedPtr virtual_host =
-        std::make_shared<VirtualHostImpl>(virtual_host_config, global_route_config, factory_context,
-                                          *vhost_scope_, validator, validation_clusters);
+    VirtualHostSharedPtr virtual_host;
+    absl::optional<uint64_t> hash;
+    if (!validate_clusters) {
+      hash = MessageUtil::hash(virtual_host_config);
+      if (previous_matcher != nullptr) {
+        const auto previous = previous_matcher->virtual_hosts_by_hash_.find(*hash);
+        if (previous != previous_matcher->virtual_hosts_by_hash_.end()) {
+          virtual_host = previous->second;
+        }
+      }
+    }
+    if (virtual_host == nullptr) {
+      virtual_host = std::make_shared<VirtualHostImpl>(virtual_host_config, global_route_config,
+                                                       factory_context, *vhost_scope_, validator,
+                                                       validation_clusters);
+    }
+    if (hash.has_value()) {
+      virtual_hosts_by_hash_.emplace(*hash, virtual_host);
+    }
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const Http::LowerCaseString lower_case_domain_name(domain_name);
       absl::string_view domain = lower_case_domain_name;
@@ -1962,15 +2041,12 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
         }
         default_virtual_host_ = virtual_host;
       } else if (!domain.empty() && '*' == domain[0]) {
-        duplicate_found = !wildcard_virtual_host_suffixes_[domain.size() - 1]
-                               .emplace(domain.substr(1), virtual_host)
-                               .second;
+        duplicate_found = !virtual_hosts_.addSuffix(domain.substr(1), virtual_host);
       } else if (!domain.empty() && '*' == domain[domain.size() - 1]) {
-        duplicate_found = !wildcard_virtual_host_prefixes_[domain.size() - 1]
-                               .emplace(domain.substr(0, domain.size() - 1), virtual_host)
-                               .second;
+        duplicate_found =
+            !virtual_hosts_.addPrefix(domain.substr(0, domain.size() - 1), virtual_host);
       } else {
-        duplicate_found = !virtual_hosts_.emplace(domain, virtual_host).second;
+        duplicate_found = !virtual_hosts_.addExact(domain, virtual_host);
       }
       if (duplicate_found) {
         throwEnvoyExceptionOrPanic(
@@ -1984,8 +2060,7 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
 
 const VirtualHostImpl* RouteMatcher::findVirtualHost(const Http::RequestHeaderMap& headers) const {
   // Fast path the case where we only have a default virtual host.
-  if (virtual_hosts_.empty() && wildcard_virtual_host_suffixes_.empty() &&
-      wildcard_virtual_host_prefixes_.empty()) {
+  if (virtual_hosts_.empty()) {
     return default_virtual_host_.get();
   }
 
@@ -2005,27 +2080,10 @@ const VirtualHostImpl* RouteMatcher::findVirtualHost(const Http::RequestHeaderMa
   }
   // TODO (@rshriram) Match Origin header in WebSocket
   // request with VHost, using wildcard match
-  // Lower-case the value of the host header, as hostnames are case insensitive.
-  const std::string host = absl::AsciiStrToLower(host_header_value);
-  const auto iter = virtual_hosts_.find(host);
-  if (iter != virtual_hosts_.end()) {
-    return iter->second.get();
-  }
-  if (!wildcard_virtual_host_suffixes_.empty()) {
-    const VirtualHostImpl* vhost = findWildcardVirtualHost(
-        host, wildcard_virtual_host_suffixes_,
-        [](absl::string_view h, int l) -> absl::string_view { return h.substr(h.size() - l); });
-    if (vhost != nullptr) {
-      return vhost;
-    }
-  }
-  if (!wildcard_virtual_host_prefixes_.empty()) {
-    const VirtualHostImpl* vhost = findWildcardVirtualHost(
-        host, wildcard_virtual_host_prefixes_,
-        [](absl::string_view h, int l) -> absl::string_view { return h.substr(0, l); });
-    if (vhost != nullptr) {
-      return vhost;
-    }
+  // Hostnames are case insensitive, the index lower cases the host while looking it up.
+  const VirtualHostSharedPtr* virtual_host = virtual_hosts_.find(host_header_value);
+  if (virtual_host != nullptr) {
+    return virtual_host->get();
   }
   return default_virtual_host_.get();
 }
@@ -2127,13 +2185,25 @@ const Envoy::Config::TypedMetadata& CommonConfigImpl::typedMetadata() const {
 ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
                        Server::Configuration::ServerFactoryContext& factory_context,
                        ProtobufMessage::ValidationVisitor& validator,
-                       bool validate_clusters_default) {
-
-  shared_config_ = std::make_shared<CommonConfigImpl>(config, factory_context, validator);
+                       bool validate_clusters_default, const ConfigImpl* previous_config) {
+  const bool validate_clusters =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default);
+  const RouteMatcher* previous_matcher = nullptr;
+  if (!validate_clusters) {
+    shared_config_hash_ = hashWithoutVirtualHosts(config);
+    if (previous_config != nullptr && previous_config->shared_config_hash_ == shared_config_hash_) {
+      // The virtual hosts of the previous config can only be shared together with the global
+      // route config they refer to.
+      shared_config_ = previous_config->shared_config_;
+      previous_matcher = previous_config->route_matcher_.get();
+    }
+  }
+  if (shared_config_ == nullptr) {
+    shared_config_ = std::make_shared<CommonConfigImpl>(config, factory_context, validator);
+  }
 
-  route_matcher_ = std::make_unique<RouteMatcher>(
-      config, shared_config_, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
+  route_matcher_ = std::make_unique<RouteMatcher>(config, shared_config_, factory_context,
+                                                  validator, validate_clusters, previous_matcher);
 }
 
 RouteConstSharedPtr ConfigImpl::route(const RouteCallback& cb,
@@ -2232,9 +2302,10 @@ PerFilterConfigs::PerFilterConfigs(
                                                factory_context, validator);
     }
 
-    // If a filter is explicitly configured we treat it as enabled.
-    // The config may be nullptr because the filter could be optional.
-    configs_.emplace(name, FilterConfig{std::move(config), false});
+    // If a filter is explicitly configured we treat it as enabled, unless the config itself turns
+    // the filter into a no-op. The config may be nullptr because the filter could be optional.
+    const bool disabled = config != nullptr && config->disablesFilter();
+    configs_.emplace(name, FilterConfig{std::move(config), disabled});
   }
 }
 
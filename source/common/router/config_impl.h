@@ -29,13 +29,15 @@
 #include "source/common/http/header_utility.h"
 #include "source/common/matcher/matcher.h"
 #include "source/common/router/config_utility.h"
+#include "source/common/router/domain_index.h"
 #include "source/common/router/header_parser.h"
 #include "source/common/router/metadatamatchcriteria_impl.h"
+#include "source/common/router/route_path_index.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
 
-#include "absl/container/node_hash_map.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -382,11 +384,20 @@ private:
 
   static const std::shared_ptr<const SslRedirectRoute> SSL_REDIRECT_ROUTE;
 
+  // Builds path_index_ if the virtual host has enough prefix and exact path routes.
+  void buildPathIndex();
+  // Finds the route like getRouteFromRoutes() without a callback, evaluating only the routes
+  // proposed by path_index_.
+  RouteConstSharedPtr getRouteFromPathIndex(const Http::RequestHeaderMap& headers,
+                                            const StreamInfo::StreamInfo& stream_info,
+                                            uint64_t random_value) const;
+
   CommonVirtualHostSharedPtr shared_virtual_host_;
 
   SslRequirements ssl_requirements_;
 
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  std::unique_ptr<const RoutePathIndex> path_index_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
 };
 
@@ -632,6 +643,7 @@ public:
 
   bool matchRoute(const Http::RequestHeaderMap& headers, const StreamInfo::StreamInfo& stream_info,
                   uint64_t random_value) const;
+  bool case_sensitive() const { return case_sensitive_; }
   void validateClusters(const Upstream::ClusterManager::ClusterInfoMaps& cluster_info_maps) const;
 
   // Router::RouteEntry
@@ -1059,7 +1071,6 @@ protected:
   const std::string host_rewrite_;
   std::unique_ptr<ConnectConfig> connect_config_;
 
-  bool case_sensitive() const { return case_sensitive_; }
   RouteConstSharedPtr clusterEntry(const Http::RequestHeaderMap& headers,
                                    uint64_t random_value) const;
 
@@ -1348,8 +1359,12 @@ public:
   absl::optional<std::string>
   currentUrlPathAfterRewrite(const Http::RequestHeaderMap& headers) const override;
 
+  // Whether the regex is evaluated by RE2, so that it can be indexed in an RE2::Set.
+  bool usesGoogleRe2() const { return uses_google_re2_; }
+
 private:
   const Matchers::PathMatcherConstSharedPtr path_matcher_;
+  const bool uses_google_re2_;
 };
 
 /**
@@ -1477,10 +1492,15 @@ DECLARE_FACTORY(RouteListMatchActionFactory);
  */
 class RouteMatcher {
 public:
+  /**
+   * @param previous_matcher supplies the route matcher of the replaced config, which was built
+   *        with the same global_route_config and whose virtual hosts may be shared, if any.
+   */
   RouteMatcher(const envoy::config::route::v3::RouteConfiguration& config,
                const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
-               ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+               ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+               const RouteMatcher* previous_matcher = nullptr);
 
   RouteConstSharedPtr route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                             const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
@@ -1488,29 +1508,15 @@ public:
   const VirtualHostImpl* findVirtualHost(const Http::RequestHeaderMap& headers) const;
 
 private:
-  using WildcardVirtualHosts =
-      std::map<int64_t, absl::node_hash_map<std::string, VirtualHostSharedPtr>, std::greater<>>;
-  using SubstringFunction = std::function<absl::string_view(absl::string_view, int)>;
-  const VirtualHostImpl* findWildcardVirtualHost(absl::string_view host,
-                                                 const WildcardVirtualHosts& wildcard_virtual_hosts,
-                                                 SubstringFunction substring_function) const;
   bool ignorePortInHostMatching() const { return ignore_port_in_host_matching_; }
 
   Stats::ScopeSharedPtr vhost_scope_;
-  absl::node_hash_map<std::string, VirtualHostSharedPtr> virtual_hosts_;
-  // std::greater as a minor optimization to iterate from more to less specific
-  //
-  // A note on using an unordered_map versus a vector of (string, VirtualHostSharedPtr) pairs:
-  //
-  // Based on local benchmarks, each vector entry costs around 20ns for recall and (string)
-  // comparison with a fixed cost of about 25ns. For unordered_map, the empty map costs about 65ns
-  // and climbs to about 110ns once there are any entries.
-  //
-  // The break-even is 4 entries.
-  WildcardVirtualHosts wildcard_virtual_host_suffixes_;
-  WildcardVirtualHosts wildcard_virtual_host_prefixes_;
-
+  // All domains other than "*", which selects default_virtual_host_.
+  DomainIndex<VirtualHostSharedPtr> virtual_hosts_;
   VirtualHostSharedPtr default_virtual_host_;
+  // The virtual hosts by the hash of their config, for sharing them with the route matcher of a
+  // later config. Empty when clusters are validated, as this happens while building them.
+  absl::flat_hash_map<uint64_t, VirtualHostSharedPtr> virtual_hosts_by_hash_;
   const bool ignore_port_in_host_matching_{false};
 };
 
@@ -1586,9 +1592,16 @@ private:
  */
 class ConfigImpl : public Config {
 public:
+  /**
+   * @param previous_config supplies the config replaced by this one, if any. Unless the clusters
+   *        are validated, the virtual hosts whose config did not change are shared with it
+   *        instead of being built again, as long as the rest of the route configuration did not
+   *        change either.
+   */
   ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
              Server::Configuration::ServerFactoryContext& factory_context,
-             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
+             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+             const ConfigImpl* previous_config = nullptr);
 
   bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
     return route_matcher_->findVirtualHost(headers) != nullptr;
@@ -1630,6 +1643,9 @@ public:
 private:
   CommonConfigSharedPtr shared_config_;
   std::unique_ptr<RouteMatcher> route_matcher_;
+  // The hash of the route configuration without its virtual hosts. Only set when the virtual hosts
+  // may be shared with a later config.
+  absl::optional<uint64_t> shared_config_hash_;
 };
 
 /**
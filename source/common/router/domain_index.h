@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Index of values, e.g. virtual hosts, by exact domains, suffix wildcard domains ("*.foo.com",
+ * "*-bar.foo.com") and prefix wildcard domains ("foo.*"). Exact and suffix wildcard domains are
+ * held in one radix trie of the reversed domains, so that a single walk from the end of the host
+ * finds the exact match or else the longest suffix wildcard. Prefix wildcard domains are held in a
+ * second radix trie, which is only walked when the first one has no match.
+ *
+ * Domains must be added in lower case. Hosts are lower cased while they are walked, so lookups
+ * do not allocate.
+ */
+template <class Value> class DomainIndex {
+public:
+  /**
+   * Adds a value for a domain which must be equal to the host.
+   * @return false if there is already a value for the domain.
+   */
+  bool addExact(absl::string_view domain, Value value) {
+    return setValue(insertReversed(suffixes_, domain).exact_, std::move(value));
+  }
+
+  /**
+   * Adds a value for the suffix of a "*suffix" wildcard domain, which matches hosts that are
+   * longer than the suffix and end with it.
+   * @return false if there is already a value for the suffix.
+   */
+  bool addSuffix(absl::string_view suffix, Value value) {
+    return setValue(insertReversed(suffixes_, suffix).wildcard_, std::move(value));
+  }
+
+  /**
+   * Adds a value for the prefix of a "prefix*" wildcard domain, which matches hosts that are
+   * longer than the prefix and start with it.
+   * @return false if there is already a value for the prefix.
+   */
+  bool addPrefix(absl::string_view prefix, Value value) {
+    return setValue(insert(prefixes_, prefix).wildcard_, std::move(value));
+  }
+
+  /**
+   * @return true if no domains were added.
+   */
+  bool empty() const { return suffixes_.children_.empty() && prefixes_.children_.empty(); }
+
+  /**
+   * Finds the value of the exact domain equal to the host, or else of the longest suffix wildcard
+   * domain matching it, or else of the longest prefix wildcard domain matching it.
+   * @param host the host, compared case insensitively.
+   * @return the value found, or nullptr if no domain matches.
+   */
+  const Value* find(absl::string_view host) const {
+    const Value* value = findIn<true>(suffixes_, host);
+    return value != nullptr ? value : findIn<false>(prefixes_, host);
+  }
+
+private:
+  struct Node {
+    // The part of the key between the parent and this node, in the order it is walked.
+    std::string label_;
+    Value exact_{};
+    Value wildcard_{};
+    // Ordered by the first character of their label, which is distinct for all children.
+    std::vector<std::unique_ptr<Node>> children_;
+  };
+
+  static bool setValue(Value& slot, Value value) {
+    if (slot) {
+      return false;
+    }
+    slot = std::move(value);
+    return true;
+  }
+
+  static bool childLessThan(const std::unique_ptr<Node>& child, char c) {
+    return child->label_.front() < c;
+  }
+
+  static Node& insertReversed(Node& root, absl::string_view key) {
+    return insert(root, std::string(key.rbegin(), key.rend()));
+  }
+
+  static Node& insert(Node& root, absl::string_view key) {
+    Node* node = &root;
+    while (!key.empty()) {
+      auto it = std::lower_bound(node->children_.begin(), node->children_.end(), key.front(),
+                                 childLessThan);
+      if (it == node->children_.end() || (*it)->label_.front() != key.front()) {
+        it = node->children_.insert(it, std::make_unique<Node>());
+        (*it)->label_ = std::string(key);
+        return **it;
+      }
+
+      const std::string& label = (*it)->label_;
+      const size_t common =
+          std::mismatch(label.begin(), label.begin() + std::min(label.size(), key.size()),
+                        key.begin())
+              .first -
+          label.begin();
+      if (common < label.size()) {
+        // Split the child so that its first common characters become their own node.
+        auto split = std::make_unique<Node>();
+        split->label_ = label.substr(0, common);
+        (*it)->label_.erase(0, common);
+        split->children_.push_back(std::move(*it));
+        *it = std::move(split);
+      }
+      node = it->get();
+      key.remove_prefix(common);
+    }
+    return *node;
+  }
+
+  // Walks the trie with the host, read from its end if Reversed is set. Returns the exact value of
+  // the node reached by the whole host, or else the wildcard value of the deepest node reached by
+  // a strict prefix (or suffix) of the host, as "*.foo.com" must not match ".foo.com".
+  template <bool Reversed>
+  static const Value* findIn(const Node& root, absl::string_view host) {
+    const auto at = [host](size_t i) {
+      return absl::ascii_tolower(Reversed ? host[host.size() - 1 - i] : host[i]);
+    };
+    const Node* node = &root;
+    const Value* wildcard = nullptr;
+    size_t depth = 0;
+    while (true) {
+      if (depth == host.size()) {
+        return node->exact_ ? &node->exact_ : wildcard;
+      }
+      if (node->wildcard_) {
+        wildcard = &node->wildcard_;
+      }
+      const char c = at(depth);
+      auto it = std::lower_bound(node->children_.begin(), node->children_.end(), c, childLessThan);
+      if (it == node->children_.end() || (*it)->label_.front() != c) {
+        return wildcard;
+      }
+      const std::string& label = (*it)->label_;
+      if (label.size() > host.size() - depth) {
+        return wildcard;
+      }
+      for (size_t i = 1; i < label.size(); ++i) {
+        if (label[i] != at(depth + i)) {
+          return wildcard;
+        }
+      }
+      depth += label.size();
+      node = it->get();
+    }
+  }
+
+  Node suffixes_;
+  Node prefixes_;
+};
+
+} // namespace Router
+} // namespace Envoy
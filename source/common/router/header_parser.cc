@@ -1,5 +1,6 @@
 #include "source/common/router/header_parser.h"
 
+#include <algorithm>
 #include <cctype>
 #include <memory>
 #include <regex>
@@ -14,6 +15,7 @@
 #include "source/common/json/json_loader.h"
 #include "source/common/protobuf/utility.h"
 
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 
@@ -68,12 +70,14 @@ HeadersToAddEntry::HeadersToAddEntry(const HeaderValueOption& header_value_optio
   }
 
   formatter_ = parseHttpHeaderFormatter(header_value_option.header());
+  is_constant_ = !absl::StrContains(original_value_, '%');
 }
 
 HeadersToAddEntry::HeadersToAddEntry(const HeaderValue& header_value,
                                      HeaderAppendAction append_action)
     : original_value_(header_value.value()), append_action_(append_action) {
   formatter_ = parseHttpHeaderFormatter(header_value);
+  is_constant_ = !absl::StrContains(original_value_, '%');
 }
 
 HeaderParserPtr
@@ -119,6 +123,11 @@ HeaderParser::configure(const Protobuf::RepeatedPtrField<HeaderValueOption>& hea
   return header_parser;
 }
 
+bool HeaderParser::isConstant() const {
+  return std::all_of(headers_to_add_.begin(), headers_to_add_.end(),
+                     [](const auto& header) { return header.second.is_constant_; });
+}
+
 void HeaderParser::evaluateHeaders(Http::HeaderMap& headers,
                                    const Formatter::HttpFormatterContext& context,
                                    const StreamInfo::StreamInfo& stream_info) const {
@@ -143,21 +152,18 @@ void HeaderParser::evaluateHeaders(Http::HeaderMap& headers,
   // header_formatter_speed_test.cc provides micro-benchmark for evaluating speed of adding and
   // replacing headers and should be used when modifying the code below to access the performance
   // impact of code changes.
-  absl::InlinedVector<std::pair<const Http::LowerCaseString&, const std::string>, 4> headers_to_add,
-      headers_to_overwrite;
-  // value_buffer is used only when stream_info is a valid pointer and stores header value
-  // created by a formatter. It is declared outside of 'for' loop for performance reason to avoid
-  // stack allocation and unnecessary std::string's memory adjustments for each iteration. The
-  // actual value of the header is accessed via 'value' variable which is initialized differently
-  // depending whether stream_info and valid or nullptr. Based on performance tests implemented in
-  // header_formatter_speed_test.cc this approach strikes the best balance between performance and
-  // readability.
-  std::string value_buffer;
+  absl::InlinedVector<std::pair<const Http::LowerCaseString&, absl::string_view>, 4>
+      headers_to_add, headers_to_overwrite;
+  // Holds the values produced by formatters, which headers_to_add and headers_to_overwrite refer
+  // to. It is reserved up front so that the values never move. Constant values are not formatted
+  // or copied, but refer to the configured value instead.
+  absl::InlinedVector<std::string, 4> formatted_values;
+  formatted_values.reserve(headers_to_add_.size());
   for (const auto& [key, entry] : headers_to_add_) {
     absl::string_view value;
-    if (stream_info != nullptr) {
-      value_buffer = entry.formatter_->formatWithContext(context, *stream_info);
-      value = value_buffer;
+    if (stream_info != nullptr && !entry.is_constant_) {
+      value = formatted_values.emplace_back(
+          entry.formatter_->formatWithContext(context, *stream_info));
     } else {
       value = entry.original_value_;
     }
@@ -201,7 +207,9 @@ Http::HeaderTransforms HeaderParser::getHeaderTransforms(const StreamInfo::Strea
 
   for (const auto& [key, entry] : headers_to_add_) {
     if (do_formatting) {
-      const std::string value = entry.formatter_->formatWithContext({}, stream_info);
+      const std::string value = entry.is_constant_
+                                    ? entry.original_value_
+                                    : entry.formatter_->formatWithContext({}, stream_info);
       if (!value.empty() || entry.add_if_empty_) {
         switch (entry.append_action_) {
         case HeaderValueOption::APPEND_IF_EXISTS_OR_ADD:
@@ -27,6 +27,9 @@ struct HeadersToAddEntry {
 
   std::string original_value_;
   bool add_if_empty_ = false;
+  // Set if the value has no substitution commands, so that it can be used as is rather than being
+  // formatted for every request.
+  bool is_constant_ = false;
 
   Formatter::FormatterPtr formatter_;
   HeaderAppendAction append_action_;
@@ -101,6 +104,12 @@ public:
   Http::HeaderTransforms getHeaderTransforms(const StreamInfo::StreamInfo& stream_info,
                                              bool do_formatting = true) const;
 
+  /**
+   * @return whether all the headers to add have constant values, so that evaluating the headers
+   * does not need a stream info.
+   */
+  bool isConstant() const;
+
   static std::string translateMetadataFormat(const std::string& header_value);
   static std::string translatePerRequestState(const std::string& header_value);
 
@@ -26,6 +26,10 @@ public:
   Rds::ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
                                          Server::Configuration::ServerFactoryContext& context,
                                          bool validate_clusters_default) const override;
+  Rds::ConfigConstSharedPtr
+  updateConfig(const Protobuf::Message& rc, Server::Configuration::ServerFactoryContext& context,
+               bool validate_clusters_default,
+               const Rds::ConfigConstSharedPtr& previous_config) const override;
 
 private:
   ProtobufMessage::ValidationVisitor& validator_;
@@ -0,0 +1,119 @@
+#include "source/common/router/route_path_index.h"
+
+#include <algorithm>
+
+#include "absl/strings/match.h"
+
+namespace Envoy {
+namespace Router {
+
+void RoutePathIndex::addPrefix(absl::string_view prefix, uint32_t route) {
+  insert(prefix).prefix_routes_.push_back(route);
+  ++indexed_routes_;
+}
+
+void RoutePathIndex::addExact(absl::string_view path, uint32_t route) {
+  insert(path).exact_routes_.push_back(route);
+  ++indexed_routes_;
+}
+
+bool RoutePathIndex::addRegex(const std::string& regex, uint32_t route) {
+  if (regex_set_ == nullptr) {
+    // The options and anchoring of Regex::CompiledGoogleReMatcher, which uses RE2::FullMatch().
+    regex_set_ =
+        std::make_unique<re2::RE2::Set>(re2::RE2::Options(re2::RE2::Quiet), re2::RE2::ANCHOR_BOTH);
+  }
+  if (regex_set_->Add(regex, nullptr) < 0) {
+    return false;
+  }
+  regex_routes_.push_back(route);
+  ++indexed_routes_;
+  return true;
+}
+
+void RoutePathIndex::addUnindexed(uint32_t route) { unindexed_routes_.push_back(route); }
+
+void RoutePathIndex::compile() {
+  if (regex_set_ != nullptr && !regex_set_->Compile()) {
+    // Without the set every regex route is a candidate for every path.
+    unindexed_routes_.insert(unindexed_routes_.end(), regex_routes_.begin(), regex_routes_.end());
+    indexed_routes_ -= regex_routes_.size();
+    regex_routes_.clear();
+    regex_set_.reset();
+  }
+}
+
+void RoutePathIndex::findCandidates(absl::string_view path, Candidates& candidates) const {
+  const Node* node = &root_;
+  absl::string_view remaining = path;
+  while (true) {
+    candidates.insert(candidates.end(), node->prefix_routes_.begin(), node->prefix_routes_.end());
+    if (remaining.empty()) {
+      candidates.insert(candidates.end(), node->exact_routes_.begin(), node->exact_routes_.end());
+      break;
+    }
+    const Node* child = node->findChild(remaining.front());
+    if (child == nullptr || !absl::StartsWith(remaining, child->label_)) {
+      break;
+    }
+    remaining.remove_prefix(child->label_.size());
+    node = child;
+  }
+  if (regex_set_ != nullptr) {
+    std::vector<int> matches;
+    re2::RE2::Set::ErrorInfo error_info;
+    if (regex_set_->Match(path, &matches, &error_info)) {
+      for (const int match : matches) {
+        candidates.push_back(regex_routes_[match]);
+      }
+    } else if (error_info.kind != re2::RE2::Set::kNoError) {
+      // The set ran out of DFA memory, so which of the regexes match is unknown.
+      candidates.insert(candidates.end(), regex_routes_.begin(), regex_routes_.end());
+    }
+  }
+  candidates.insert(candidates.end(), unindexed_routes_.begin(), unindexed_routes_.end());
+  std::sort(candidates.begin(), candidates.end());
+}
+
+bool RoutePathIndex::Node::childLessThan(const std::unique_ptr<Node>& child, char c) {
+  return child->label_.front() < c;
+}
+
+const RoutePathIndex::Node* RoutePathIndex::Node::findChild(char c) const {
+  auto it = std::lower_bound(children_.begin(), children_.end(), c, childLessThan);
+  return it != children_.end() && (*it)->label_.front() == c ? it->get() : nullptr;
+}
+
+RoutePathIndex::Node& RoutePathIndex::insert(absl::string_view key) {
+  Node* node = &root_;
+  while (!key.empty()) {
+    auto it = std::lower_bound(node->children_.begin(), node->children_.end(), key.front(),
+                               Node::childLessThan);
+    if (it == node->children_.end() || (*it)->label_.front() != key.front()) {
+      it = node->children_.insert(it, std::make_unique<Node>());
+      (*it)->label_ = std::string(key);
+      return **it;
+    }
+
+    const std::string& label = (*it)->label_;
+    const size_t common =
+        std::mismatch(label.begin(), label.begin() + std::min(label.size(), key.size()),
+                      key.begin())
+            .first -
+        label.begin();
+    if (common < label.size()) {
+      // Split the child so that its first common characters become their own node.
+      auto split = std::make_unique<Node>();
+      split->label_ = label.substr(0, common);
+      (*it)->label_.erase(0, common);
+      split->children_.push_back(std::move(*it));
+      *it = std::move(split);
+    }
+    node = it->get();
+    key.remove_prefix(common);
+  }
+  return *node;
+}
+
+} // namespace Router
+} // namespace Envoy
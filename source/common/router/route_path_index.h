@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+#include "re2/set.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Index of the routes of a virtual host by the path they require, used to find the routes which
+ * may match a request path without evaluating all of them. Routes are identified by their
+ * position in the config. Case sensitive prefix and exact path routes are held in a radix trie and
+ * RE2 regex routes are compiled into a single RE2::Set, so that one pass over the path finds all
+ * of them which match. All other routes are returned as candidates for every path, so evaluating
+ * the candidates in config order gives the same result as evaluating every route.
+ */
+class RoutePathIndex {
+public:
+  using Candidates = absl::InlinedVector<uint32_t, 8>;
+
+  // Virtual hosts with fewer indexed routes than this are not worth indexing.
+  static constexpr uint32_t MinIndexedRoutes = 16;
+
+  /**
+   * Adds a route which matches paths starting with prefix. Routes must be added in config order.
+   */
+  void addPrefix(absl::string_view prefix, uint32_t route);
+
+  /**
+   * Adds a route which matches paths equal to path. Routes must be added in config order.
+   */
+  void addExact(absl::string_view path, uint32_t route);
+
+  /**
+   * Adds a route which matches paths fully matched by an RE2 regex. Routes must be added in config
+   * order.
+   * @return false if the regex cannot be added to the set, in which case the route must be added
+   *         with addUnindexed() instead.
+   */
+  bool addRegex(const std::string& regex, uint32_t route);
+
+  /**
+   * Adds a route which is not indexed by path. Routes must be added in config order.
+   */
+  void addUnindexed(uint32_t route);
+
+  /**
+   * Completes the index, must be called after all routes are added and before findCandidates().
+   */
+  void compile();
+
+  /**
+   * @return the number of prefix, exact and regex path routes in the index.
+   */
+  uint32_t indexedRoutes() const { return indexed_routes_; }
+
+  /**
+   * Finds the candidate routes for a path.
+   * @param path the path without query and fragment.
+   * @param candidates receives the routes which may match path, in config order.
+   */
+  void findCandidates(absl::string_view path, Candidates& candidates) const;
+
+private:
+  struct Node {
+    // The part of the key between the parent and this node, which is empty only for the root.
+    std::string label_;
+    std::vector<uint32_t> prefix_routes_;
+    std::vector<uint32_t> exact_routes_;
+    // Ordered by the first character of their label, which is distinct for all children.
+    std::vector<std::unique_ptr<Node>> children_;
+
+    const Node* findChild(char c) const;
+    static bool childLessThan(const std::unique_ptr<Node>& child, char c);
+  };
+
+  Node& insert(absl::string_view key);
+
+  Node root_;
+  std::unique_ptr<re2::RE2::Set> regex_set_;
+  // The route of each regex in regex_set_, by the index returned by RE2::Set::Add().
+  std::vector<uint32_t> regex_routes_;
+  std::vector<uint32_t> unindexed_routes_;
+  uint32_t indexed_routes_{0};
+};
+
+} // namespace Router
+} // namespace Envoy
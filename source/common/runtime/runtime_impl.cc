@@ -151,9 +151,15 @@ bool SnapshotImpl::featureEnabled(absl::string_view key,
                                   const envoy::type::v3::FractionalPercent& default_value,
                                   uint64_t random_value) const {
   const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  envoy::type::v3::FractionalPercent percent;
+  // The percentage is evaluated as integers, so that no proto is copied for every call.
+  uint64_t numerator;
+  uint64_t denominator_value;
   if (entry != values_.end() && entry->second.fractional_percent_value_.has_value()) {
-    percent = entry->second.fractional_percent_value_.value();
+    const envoy::type::v3::FractionalPercent& percent =
+        entry->second.fractional_percent_value_.value();
+    numerator = percent.numerator();
+    denominator_value =
+        ProtobufPercentHelper::fractionalPercentDenominatorToInt(percent.denominator());
   } else if (entry != values_.end() && entry->second.uint_value_.has_value()) {
     // Check for > 100 because the runtime value is assumed to be specified as
     // an integer, and it also ensures that truncating the uint64_t runtime
@@ -165,25 +171,25 @@ bool SnapshotImpl::featureEnabled(absl::string_view key,
     // The runtime value was specified as an integer rather than a fractional
     // percent proto. To preserve legacy semantics, we treat it as a percentage
     // (i.e. denominator of 100).
-    percent.set_numerator(entry->second.uint_value_.value());
-    percent.set_denominator(envoy::type::v3::FractionalPercent::HUNDRED);
+    numerator = entry->second.uint_value_.value();
+    denominator_value = 100;
   } else {
-    percent = default_value;
+    numerator = default_value.numerator();
+    denominator_value =
+        ProtobufPercentHelper::fractionalPercentDenominatorToInt(default_value.denominator());
   }
 
   // When numerator > denominator condition is always evaluates to TRUE
   // It becomes hard to debug why configuration does not work in case of wrong numerator.
   // Log debug message that numerator is invalid.
-  uint64_t denominator_value =
-      ProtobufPercentHelper::fractionalPercentDenominatorToInt(percent.denominator());
-  if (percent.numerator() > denominator_value) {
+  if (numerator > denominator_value) {
     ENVOY_LOG(debug,
               "WARNING runtime key '{}': numerator ({}) > denominator ({}), condition always "
               "evaluates to true",
-              key, percent.numerator(), denominator_value);
+              key, numerator, denominator_value);
   }
 
-  return ProtobufPercentHelper::evaluateFractionalPercent(percent, random_value);
+  return random_value % denominator_value < numerator;
 }
 
 uint64_t SnapshotImpl::getInteger(absl::string_view key, uint64_t default_value) const {
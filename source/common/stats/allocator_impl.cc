@@ -1,6 +1,7 @@
 #include "source/common/stats/allocator_impl.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 
 #include "envoy/stats/sink.h"
@@ -11,6 +12,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
 #include "source/common/common/thread_annotations.h"
+#include "source/common/common/thread_shard.h"
 #include "source/common/common/utility.h"
 #include "source/common/stats/metric_impl.h"
 #include "source/common/stats/stat_merger.h"
@@ -166,6 +168,65 @@ private:
   std::atomic<uint64_t> pending_increment_{0};
 };
 
+// A counter whose value is spread over cache line sized shards, so that threads incrementing it
+// concurrently don't contend on the same cache line. Each thread always uses the same shard.
+class ShardedCounterImpl : public StatsSharedImpl<Counter> {
+public:
+  static constexpr uint32_t NumShards = 16;
+
+  ShardedCounterImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
+                     const StatNameTagVector& stat_name_tags)
+      : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {}
+
+  void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) override {
+    const size_t count = alloc_.counters_.erase(statName());
+    ASSERT(count == 1);
+    alloc_.sinked_counters_.erase(this);
+  }
+
+  // Stats::Counter
+  void add(uint64_t amount) override {
+    Shard& shard = shards_[shardIndex()];
+    shard.value_ += amount;
+    shard.pending_increment_ += amount;
+    // Only write the flags once, so that they stay in the caches of all threads.
+    if (!(flags_ & Flags::Used)) {
+      flags_ |= Flags::Used;
+    }
+  }
+  void inc() override { add(1); }
+  uint64_t latch() override {
+    uint64_t latched = 0;
+    for (Shard& shard : shards_) {
+      latched += shard.pending_increment_.exchange(0);
+    }
+    return latched;
+  }
+  void reset() override {
+    for (Shard& shard : shards_) {
+      shard.value_ = 0;
+    }
+  }
+  uint64_t value() const override {
+    uint64_t value = 0;
+    for (const Shard& shard : shards_) {
+      value += shard.value_;
+    }
+    return value;
+  }
+
+private:
+  struct alignas(CacheLineSize) Shard {
+    std::atomic<uint64_t> value_{0};
+    std::atomic<uint64_t> pending_increment_{0};
+  };
+
+  // Threads are assigned shards round robin when they first increment a sharded counter.
+  static uint32_t shardIndex() { return threadShardIndex<NumShards>(); }
+
+  std::array<Shard, NumShards> shards_;
+};
+
 class GaugeImpl : public StatsSharedImpl<Gauge> {
 public:
   GaugeImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
@@ -200,20 +261,24 @@ public:
   // Stats::Gauge
   void add(uint64_t amount) override {
     child_value_ += amount;
-    flags_ |= Flags::Used;
+    flags_ |= Flags::Used | Flags::Changed;
   }
   void dec() override { sub(1); }
   void inc() override { add(1); }
   void set(uint64_t value) override {
     child_value_ = value;
-    flags_ |= Flags::Used;
+    flags_ |= Flags::Used | Flags::Changed;
   }
   void sub(uint64_t amount) override {
     ASSERT(child_value_ >= amount);
     ASSERT(used() || amount == 0);
     child_value_ -= amount;
+    flags_ |= Flags::Changed;
   }
   uint64_t value() const override { return child_value_ + parent_value_; }
+  bool latchChanged() override {
+    return flags_.fetch_and(static_cast<uint16_t>(~Flags::Changed)) & Flags::Changed;
+  }
 
   // TODO(diazalan): Rename importMode and to more generic name
   ImportMode importMode() const override {
@@ -260,7 +325,10 @@ public:
     }
   }
 
-  void setParentValue(uint64_t value) override { parent_value_ = value; }
+  void setParentValue(uint64_t value) override {
+    parent_value_ = value;
+    flags_ |= Flags::Changed;
+  }
 
 private:
   std::atomic<uint64_t> parent_value_{0};
@@ -298,6 +366,17 @@ private:
 
 CounterSharedPtr AllocatorImpl::makeCounter(StatName name, StatName tag_extracted_name,
                                             const StatNameTagVector& stat_name_tags) {
+  return makeCounterHelper(name, tag_extracted_name, stat_name_tags, false);
+}
+
+CounterSharedPtr AllocatorImpl::makeShardedCounter(StatName name, StatName tag_extracted_name,
+                                                   const StatNameTagVector& stat_name_tags) {
+  return makeCounterHelper(name, tag_extracted_name, stat_name_tags, true);
+}
+
+CounterSharedPtr AllocatorImpl::makeCounterHelper(StatName name, StatName tag_extracted_name,
+                                                  const StatNameTagVector& stat_name_tags,
+                                                  bool sharded) {
   Thread::LockGuard lock(mutex_);
   ASSERT(gauges_.find(name) == gauges_.end());
   ASSERT(text_readouts_.find(name) == text_readouts_.end());
@@ -305,7 +384,9 @@ CounterSharedPtr AllocatorImpl::makeCounter(StatName name, StatName tag_extracte
   if (iter != counters_.end()) {
     return {*iter};
   }
-  auto counter = CounterSharedPtr(makeCounterInternal(name, tag_extracted_name, stat_name_tags));
+  auto counter = CounterSharedPtr(
+      sharded ? makeShardedCounterInternal(name, tag_extracted_name, stat_name_tags)
+              : makeCounterInternal(name, tag_extracted_name, stat_name_tags));
   counters_.insert(counter.get());
   // Add counter to sinked_counters_ if it matches the sink predicate.
   if (sink_predicates_ != nullptr && sink_predicates_->includeCounter(*counter)) {
@@ -369,6 +450,11 @@ Counter* AllocatorImpl::makeCounterInternal(StatName name, StatName tag_extracte
   return new CounterImpl(name, *this, tag_extracted_name, stat_name_tags);
 }
 
+Counter* AllocatorImpl::makeShardedCounterInternal(StatName name, StatName tag_extracted_name,
+                                                   const StatNameTagVector& stat_name_tags) {
+  return new ShardedCounterImpl(name, *this, tag_extracted_name, stat_name_tags);
+}
+
 void AllocatorImpl::forEachCounter(SizeFn f_size, StatFn<Counter> f_stat) const {
   Thread::LockGuard lock(mutex_);
   if (f_size != nullptr) {
@@ -261,7 +261,7 @@ bool StatName::startsWith(StatName prefix) const {
 
 std::vector<absl::string_view> SymbolTable::decodeStrings(StatName stat_name) const {
   std::vector<absl::string_view> strings;
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   Encoding::decodeTokens(
       stat_name,
       [this, &strings](Symbol symbol)
@@ -313,16 +313,34 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
   symbols.reserve(tokens.size());
 
   // Now take the lock and populate the Symbol objects, which involves bumping
-  // ref-counts in this.
-  {
-    Thread::LockGuard lock(lock_);
-    recent_lookups_.lookup(name);
-    for (auto& token : tokens) {
+  // ref-counts in this. Names made of existing symbols are the common case, and
+  // only need the lock to be held shared, as the ref-counts are atomic.
+  size_t num_existing = 0;
+  if (recent_lookup_capacity_.load(std::memory_order_relaxed) == 0) {
+    untracked_lookups_.fetch_add(1, std::memory_order_relaxed);
+    absl::ReaderMutexLock lock(&lock_);
+    for (; num_existing < tokens.size(); ++num_existing) {
+      auto encode_find = encode_map_.find(tokens[num_existing]);
+      if (encode_find == encode_map_.end()) {
+        break;
+      }
+      encode_find->second.ref_count_.fetch_add(1, std::memory_order_relaxed);
+      symbols.push_back(encode_find->second.symbol_);
+    }
+  }
+
+  // Adding symbols, and recording the lookup, requires the lock to be held exclusively.
+  if (num_existing < tokens.size()) {
+    absl::MutexLock lock(&lock_);
+    if (num_existing == 0 && recent_lookup_capacity_.load(std::memory_order_relaxed) != 0) {
+      recent_lookups_.lookup(name);
+    }
+    for (size_t i = num_existing; i < tokens.size(); ++i) {
       // TODO(jmarantz): consider using StatNameDynamicStorage for tokens with
       // length below some threshold, say 4 bytes. It might be preferable not to
       // reserve Symbols for every 3 digit number found (for example) in ipv4
       // addresses.
-      symbols.push_back(toSymbol(token));
+      symbols.push_back(toSymbol(tokens[i]));
     }
   }
 
@@ -331,7 +349,7 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
 }
 
 uint64_t SymbolTable::numSymbols() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   ASSERT(encode_map_.size() == decode_map_.size());
   return encode_map_.size();
 }
@@ -344,7 +362,7 @@ void SymbolTable::incRefCount(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   for (Symbol symbol : symbols) {
     auto decode_search = decode_map_.find(symbol);
 
@@ -358,7 +376,7 @@ void SymbolTable::incRefCount(const StatName& stat_name) {
            "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
            "debugging-symbol-table-assertions");
 
-    ++encode_search->second.ref_count_;
+    encode_search->second.ref_count_.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
@@ -366,21 +384,44 @@ void SymbolTable::free(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
+  SymbolVec unreferenced;
+  {
+    absl::ReaderMutexLock lock(&lock_);
+    for (Symbol symbol : symbols) {
+      auto decode_search = decode_map_.find(symbol);
+      ASSERT(decode_search != decode_map_.end());
+
+      auto encode_search = encode_map_.find(decode_search->second->toStringView());
+      ASSERT(encode_search != encode_map_.end());
+
+      if (encode_search->second.ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        unreferenced.push_back(symbol);
+      }
+    }
+  }
+
+  // If that was the last remaining client usage of any symbol, erase its
+  // mappings, which requires the lock to be held exclusively.
+  if (!unreferenced.empty()) {
+    removeUnreferencedSymbols(unreferenced);
+  }
+}
+
+void SymbolTable::removeUnreferencedSymbols(const SymbolVec& symbols) {
+  absl::MutexLock lock(&lock_);
   for (Symbol symbol : symbols) {
+    // Between dropping the shared lock and taking it exclusively, the symbol
+    // may have been encoded again, or removed by another thread freeing it
+    // after it had been encoded again, and even been reused for another token.
+    // Only a symbol which is still unreferenced is removed, so each of these
+    // cases is handled.
     auto decode_search = decode_map_.find(symbol);
-    ASSERT(decode_search != decode_map_.end());
-
+    if (decode_search == decode_map_.end()) {
+      continue;
+    }
     auto encode_search = encode_map_.find(decode_search->second->toStringView());
     ASSERT(encode_search != encode_map_.end());
-
-    // If that was the last remaining client usage of the symbol, erase the
-    // current mappings and add the now-unused symbol to the reuse pool.
-    //
-    // The "if (--EXPR.ref_count_)" pattern speeds up BM_CreateRace by 20% in
-    // symbol_table_speed_test.cc, relative to breaking out the decrement into a
-    // separate step, likely due to the non-trivial dereferences in EXPR.
-    if (--encode_search->second.ref_count_ == 0) {
+    if (encode_search->second.ref_count_.load(std::memory_order_relaxed) == 0) {
       decode_map_.erase(decode_search);
       encode_map_.erase(encode_search);
       pool_.push(symbol);
@@ -395,11 +436,11 @@ uint64_t SymbolTable::getRecentLookups(const RecentLookupsFn& iter) const {
   // We don't want to hold lock_ while calling the iterator, but we need it to
   // access recent_lookups_, so we buffer in name_count_map.
   {
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     recent_lookups_.forEach(
         [&name_count_map](absl::string_view str, uint64_t count)
             ABSL_NO_THREAD_SAFETY_ANALYSIS { name_count_map[std::string(str)] += count; });
-    total += recent_lookups_.total();
+    total += recent_lookups_.total() + untracked_lookups_.load(std::memory_order_relaxed);
   }
 
   // Now we have the collated name-count map data: we need to vectorize and
@@ -445,17 +486,19 @@ DynamicSpans SymbolTable::getDynamicSpans(StatName stat_name) const {
 }
 
 void SymbolTable::setRecentLookupCapacity(uint64_t capacity) {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&lock_);
   recent_lookups_.setCapacity(capacity);
+  recent_lookup_capacity_.store(capacity, std::memory_order_relaxed);
 }
 
 void SymbolTable::clearRecentLookups() {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&lock_);
   recent_lookups_.clear();
+  untracked_lookups_.store(0, std::memory_order_relaxed);
 }
 
 uint64_t SymbolTable::recentLookupCapacity() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   return recent_lookups_.capacity();
 }
 
@@ -486,13 +529,13 @@ Symbol SymbolTable::toSymbol(absl::string_view sv) {
     // If the insertion didn't take place, return the actual value at that location and up the
     // refcount at that location
     result = encode_find->second.symbol_;
-    ++(encode_find->second.ref_count_);
+    encode_find->second.ref_count_.fetch_add(1, std::memory_order_relaxed);
   }
   return result;
 }
 
 absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    ABSL_SHARED_LOCKS_REQUIRED(lock_) {
   auto search = decode_map_.find(symbol);
   RELEASE_ASSERT(search != decode_map_.end(), "no such symbol");
   return search->second->toStringView();
@@ -513,12 +556,12 @@ bool SymbolTable::lessThan(const StatName& a, const StatName& b) const {
   // Proactively take the table lock in anticipation that we'll need to
   // convert at least one symbol to a string_view, and it's easier not to
   // bother to lazily take the lock.
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   return lessThanLockHeld(a, b);
 }
 
 bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    ABSL_SHARED_LOCKS_REQUIRED(lock_) {
   Encoding::TokenIter a_iter(a), b_iter(b);
   while (true) {
     Encoding::TokenIter::TokenType a_type = a_iter.next();
@@ -548,7 +591,7 @@ bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
 
 #ifndef ENVOY_CONFIG_COVERAGE
 void SymbolTable::debugPrint() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   std::vector<Symbol> symbols;
   for (const auto& p : decode_map_) {
     symbols.push_back(p.first);
@@ -557,7 +600,8 @@ void SymbolTable::debugPrint() const {
   for (Symbol symbol : symbols) {
     const InlineString& token = *decode_map_.find(symbol)->second;
     const SharedSymbol& shared_symbol = encode_map_.find(token.toStringView())->second;
-    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(), shared_symbol.ref_count_);
+    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(),
+                   shared_symbol.ref_count_.load());
   }
 }
 #endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -349,7 +350,7 @@ public:
   void sortByStatNames(Iter begin, Iter end, GetStatName get_stat_name) const {
     // Grab the lock once before sorting begins, so we don't have to re-take
     // it on every comparison.
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     StatNameCompare<GetStatName, Obj> compare(*this, get_stat_name);
     std::sort(begin, end, compare);
   }
@@ -397,13 +398,20 @@ private:
 
   struct SharedSymbol {
     SharedSymbol(Symbol symbol) : symbol_(symbol) {}
+    // The maps only move their values while rehashing, which requires lock_ to be held
+    // exclusively, so nobody else can be accessing the ref count then.
+    SharedSymbol(SharedSymbol&& src) noexcept
+        : symbol_(src.symbol_), ref_count_(src.ref_count_.load(std::memory_order_relaxed)) {}
 
     Symbol symbol_;
-    uint32_t ref_count_{1};
+    // Changed with lock_ held shared, so that encoding and freeing existing symbols don't
+    // serialize on the lock.
+    std::atomic<uint32_t> ref_count_{1};
   };
 
-  // This must be held during both encode() and free().
-  mutable Thread::MutexBasicLockable lock_;
+  // Held shared to look up existing symbols and to change their reference counts, and held
+  // exclusively to add and remove symbols.
+  mutable absl::Mutex lock_;
 
   /**
    * Decodes a uint8_t array into an array of period-delimited strings. Note
@@ -434,7 +442,7 @@ private:
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(Symbol symbol) const ABSL_SHARED_LOCKS_REQUIRED(lock_);
 
   /**
    * Stages a new symbol for use. To be called after a successful insertion.
@@ -450,8 +458,16 @@ private:
    */
   void addTokensToEncoding(absl::string_view name, Encoding& encoding);
 
+  /**
+   * Removes the symbols whose reference count dropped to zero, unless they have been referenced
+   * again in the meantime.
+   *
+   * @param symbols the symbols whose reference count dropped to zero.
+   */
+  void removeUnreferencedSymbols(const SymbolVec& symbols);
+
   Symbol monotonicCounter() {
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     return monotonic_counter_;
   }
 
@@ -475,6 +491,11 @@ private:
   // using an Envoy::IntervalSet.
   std::stack<Symbol> pool_ ABSL_GUARDED_BY(lock_);
   RecentLookups recent_lookups_ ABSL_GUARDED_BY(lock_);
+
+  // Recording recent lookups requires lock_ to be held exclusively, so encoding only takes the
+  // shared path while this is zero. Lookups on that path are only counted, in untracked_lookups_.
+  std::atomic<uint64_t> recent_lookup_capacity_{0};
+  std::atomic<uint64_t> untracked_lookups_{0};
 };
 
 // Base class for holding the backing-storing for a StatName. The two derived
@@ -12,6 +12,7 @@
 
 #include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 
@@ -193,7 +194,8 @@ bool TagExtractorRe2Impl::extractTag(TagExtractionContext& context, std::vector<
 }
 
 TagExtractorTokensImpl::TagExtractorTokensImpl(absl::string_view name, absl::string_view tokens)
-    : TagExtractorImplBase(name, tokens, ""), tokens_(absl::StrSplit(tokens, '.')),
+    : TagExtractorImplBase(name, tokens, requiredSubstr(tokens)),
+      tokens_(absl::StrSplit(tokens, '.')),
       match_index_(findMatchIndex(tokens_)) {
   if (!tokens_.empty()) {
     const absl::string_view first = tokens_[0];
@@ -213,9 +215,28 @@ uint32_t TagExtractorTokensImpl::findMatchIndex(const std::vector<std::string>&
   return 0;
 }
 
+std::string TagExtractorTokensImpl::requiredSubstr(absl::string_view tokens) {
+  // Literal tokens must be equal to an input token, and every input token but the first is
+  // preceded by a dot. The first token is already covered by the prefix.
+  absl::string_view longest;
+  bool first = true;
+  for (absl::string_view token : absl::StrSplit(tokens, '.')) {
+    if (!first && token != "$" && token != "*" && token != "**" && token.size() > longest.size()) {
+      longest = token;
+    }
+    first = false;
+  }
+  return longest.empty() ? "" : absl::StrCat(".", longest);
+}
+
 bool TagExtractorTokensImpl::extractTag(TagExtractionContext& context, std::vector<Tag>& tags,
                                         IntervalSet<size_t>& remove_characters) const {
   PERF_OPERATION(perf);
+  if (substrMismatch(context.name())) {
+    PERF_RECORD(perf, "tokens-skip", name_);
+    PERF_TAG_INC(skipped_);
+    return false;
+  }
   const std::vector<absl::string_view>& input_tokens = context.tokens();
   uint32_t match_input_index = input_tokens.size(), start = 0;
   if (!searchTags(input_tokens, 0, 0, 0, start, match_input_index)) {
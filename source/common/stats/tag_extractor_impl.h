@@ -162,6 +162,16 @@ public:
 
 private:
   static uint32_t findMatchIndex(const std::vector<std::string>& tokens);
+
+  /**
+   * Returns a substring which any stat name matched by the tokens must contain, so that most stat
+   * names can be skipped without splitting them into tokens. This is the longest literal token
+   * after the first one, preceded by its dot.
+   * @param tokens the dot-separated token pattern.
+   * @return std::string the required substring, or "" if the pattern has no such literal token.
+   */
+  static std::string requiredSubstr(absl::string_view tokens);
+
   bool searchTags(const std::vector<absl::string_view>& input_tokens, uint32_t input_index,
                   uint32_t pattern_index, uint32_t char_index, uint32_t& start,
                   uint32_t& match_input_index) const;
@@ -1,5 +1,6 @@
 #include "source/common/stats/thread_local_store.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <list>
@@ -31,8 +32,8 @@ ThreadLocalStoreImpl::ThreadLocalStoreImpl(Allocator& alloc)
     : alloc_(alloc), tag_producer_(std::make_unique<TagProducerImpl>()),
       stats_matcher_(std::make_unique<StatsMatcherImpl>()),
       histogram_settings_(std::make_unique<HistogramSettingsImpl>()),
-      null_counter_(alloc.symbolTable()), null_gauge_(alloc.symbolTable()),
-      null_histogram_(alloc.symbolTable()), null_text_readout_(alloc.symbolTable()),
+      sharded_counter_pool_(alloc.symbolTable()), null_counter_(alloc.symbolTable()),
+      null_gauge_(alloc.symbolTable()), null_histogram_(alloc.symbolTable()), null_text_readout_(alloc.symbolTable()),
       well_known_tags_(alloc.symbolTable().makeSet("well_known_tags")) {
   for (const auto& desc : Config::TagNames::get().descriptorVec()) {
     well_known_tags_->rememberBuiltin(desc.name_);
@@ -60,6 +61,60 @@ void ThreadLocalStoreImpl::setHistogramSettings(HistogramSettingsConstPtr&& hist
   histogram_settings_ = std::move(histogram_settings);
 }
 
+void ThreadLocalStoreImpl::setShardHotCounters(bool shard_hot_counters) {
+  // The tag extracted names of the counters incremented for nearly every request or connection,
+  // with the default tags. Response codes and classes are tags, so e.g. upstream_rq_200 is
+  // cluster.upstream_rq and upstream_rq_2xx is cluster.upstream_rq_xx.
+  static constexpr absl::string_view hot_counters[] = {
+      "cluster.upstream_cx_total",
+      "cluster.upstream_rq",
+      "cluster.upstream_rq_completed",
+      "cluster.upstream_rq_total",
+      "cluster.upstream_rq_xx",
+      "http.downstream_cx_total",
+      "http.downstream_rq_completed",
+      "http.downstream_rq_total",
+      "http.downstream_rq_xx",
+      "listener.downstream_cx_total",
+      "listener.http.downstream_rq_completed",
+      "listener.http.downstream_rq_xx",
+  };
+
+  Thread::LockGuard lock(lock_);
+  sharded_counter_names_.clear();
+  if (!shard_hot_counters) {
+    return;
+  }
+  for (absl::string_view name : hot_counters) {
+    sharded_counter_names_.insert(sharded_counter_pool_.add(name));
+  }
+}
+
+void ThreadLocalStoreImpl::setMaxStatsPerScope(uint32_t max_stats_per_scope) {
+  // The counter lives in the default scope, which is not limited, and is created before taking the
+  // lock as creating it takes the lock as well.
+  Counter* scope_stats_overflow =
+      max_stats_per_scope == 0 ? nullptr
+                               : &default_scope_->counterFromString("stats.scope_stats_overflow");
+  Thread::LockGuard lock(lock_);
+  max_stats_per_scope_ = max_stats_per_scope;
+  scope_stats_overflow_ = scope_stats_overflow;
+}
+
+bool ThreadLocalStoreImpl::scopeAtStatLimit(const ScopeImpl& scope) {
+  if (max_stats_per_scope_ == 0 || &scope == default_scope_.get()) {
+    return false;
+  }
+  const CentralCacheEntry& central_cache = *scope.centralCacheLockHeld();
+  if (central_cache.counters_.size() + central_cache.gauges_.size() +
+          central_cache.histograms_.size() + central_cache.text_readouts_.size() <
+      max_stats_per_scope_) {
+    return false;
+  }
+  scope_stats_overflow_->inc();
+  return true;
+}
+
 void ThreadLocalStoreImpl::setStatsMatcher(StatsMatcherPtr&& stats_matcher) {
   stats_matcher_ = std::move(stats_matcher);
   if (stats_matcher_->acceptsAll()) {
@@ -507,6 +562,10 @@ StatType& ThreadLocalStoreImpl::ScopeImpl::safeMakeStat(
   } else if (parent_.checkAndRememberRejection(full_stat_name, fast_reject_result,
                                                central_rejected_stats, tls_rejected_stats)) {
     return null_stat;
+  } else if (parent_.scopeAtStatLimit(*this)) {
+    // Unlike rejections, these are not remembered, so that a flood of new names can't grow the
+    // rejected sets without bound either.
+    return null_stat;
   } else {
     StatNameTagHelper tag_helper(parent_, name_no_tags, stat_name_tags);
 
@@ -556,8 +615,12 @@ Counter& ThreadLocalStoreImpl::ScopeImpl::counterFromStatNameWithTags(
   return safeMakeStat<Counter>(
       final_stat_name, joiner.tagExtractedName(), stat_name_tags, central_cache->counters_,
       fast_reject_result, central_cache->rejected_stats_,
-      [](Allocator& allocator, StatName name, StatName tag_extracted_name,
-         const StatNameTagVector& tags) -> CounterSharedPtr {
+      [this](Allocator& allocator, StatName name, StatName tag_extracted_name,
+             const StatNameTagVector& tags)
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(parent_.lock_) -> CounterSharedPtr {
+        if (parent_.isShardedCounter(tag_extracted_name)) {
+          return allocator.makeShardedCounter(name, tag_extracted_name, tags);
+        }
         return allocator.makeCounter(name, tag_extracted_name, tags);
       },
       tls_cache, tls_rejected_stats, parent_.null_counter_);
@@ -665,6 +728,8 @@ Histogram& ThreadLocalStoreImpl::ScopeImpl::histogramFromStatNameWithTags(
                                                central_cache->rejected_stats_,
                                                tls_rejected_stats)) {
     return parent_.null_histogram_;
+  } else if (parent_.scopeAtStatLimit(*this)) {
+    return parent_.null_histogram_;
   } else {
     StatNameTagHelper tag_helper(parent_, joiner.tagExtractedName(), stat_name_tags);
 
@@ -817,13 +882,19 @@ ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
 void ThreadLocalHistogramImpl::recordValue(uint64_t value) {
   ASSERT(std::this_thread::get_id() == created_thread_id_);
   hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  has_values_[current_active_] = true;
   used_ = true;
 }
 
 void ThreadLocalHistogramImpl::merge(histogram_t* target) {
-  histogram_t** other_histogram = &histograms_[otherHistogramIndex()];
+  const uint64_t other_index = otherHistogramIndex();
+  if (!has_values_[other_index]) {
+    return;
+  }
+  histogram_t** other_histogram = &histograms_[other_index];
   hist_accumulate(target, other_histogram, 1);
   hist_clear(*other_histogram);
+  has_values_[other_index] = false;
 }
 
 ParentHistogramImpl::ParentHistogramImpl(StatName name, Histogram::Unit unit,
@@ -911,6 +982,16 @@ bool ParentHistogramImpl::hidden() const { return false; }
 void ParentHistogramImpl::merge() {
   Thread::ReleasableLockGuard lock(merge_lock_);
   if (merged_ || usedLockHeld()) {
+    const bool has_values_to_merge =
+        std::any_of(tls_histograms_.begin(), tls_histograms_.end(),
+                    [](const TlsHistogramSharedPtr& tls_histogram) {
+                      return tls_histogram->hasValuesToMerge();
+                    });
+    if (merged_ && interval_empty_ && !has_values_to_merge) {
+      // Nothing was recorded in this interval nor the previous one, so both statistics are
+      // unchanged. This makes merging the many idle histograms of a large config cheap.
+      return;
+    }
     hist_clear(interval_histogram_);
     // Here we could copy all the pointers to TLS histograms in the tls_histogram_ list,
     // then release the lock before we do the actual merge. However it is not a big deal
@@ -925,6 +1006,7 @@ void ParentHistogramImpl::merge() {
     cumulative_statistics_.refresh(cumulative_histogram_);
     interval_statistics_.refresh(interval_histogram_);
     merged_ = true;
+    interval_empty_ = !has_values_to_merge;
   }
 }
 
@@ -39,6 +39,12 @@ public:
 
   void merge(histogram_t* target);
 
+  /**
+   * @return whether values were recorded into the histogram which is merged by the next merge().
+   *         This must be called after beginMerge() swapped the histograms.
+   */
+  bool hasValuesToMerge() const { return has_values_[otherHistogramIndex()]; }
+
   /**
    * Called in the beginning of merge process. Swaps the histogram used for collection so that we do
    * not have to lock the histogram in high throughput TLS writes.
@@ -67,6 +73,8 @@ private:
   uint64_t otherHistogramIndex() const { return 1 - current_active_; }
   uint64_t current_active_{0};
   histogram_t* histograms_[2];
+  // Whether values were recorded into each of histograms_ since it was last merged.
+  bool has_values_[2]{false, false};
   std::atomic<bool> used_;
   std::thread::id created_thread_id_;
   SymbolTable& symbol_table_;
@@ -141,6 +149,8 @@ private:
   mutable Thread::MutexBasicLockable merge_lock_;
   std::list<TlsHistogramSharedPtr> tls_histograms_ ABSL_GUARDED_BY(merge_lock_);
   bool merged_{false};
+  // Whether the last merge left the interval histogram empty.
+  bool interval_empty_{false};
   std::atomic<bool> shutting_down_{false};
   std::atomic<uint32_t> ref_count_{0};
   const uint64_t id_; // Index into TlsCache::histogram_cache_.
@@ -191,6 +201,8 @@ public:
   }
   void setStatsMatcher(StatsMatcherPtr&& stats_matcher) override;
   void setHistogramSettings(HistogramSettingsConstPtr&& histogram_settings) override;
+  void setShardHotCounters(bool shard_hot_counters) override;
+  void setMaxStatsPerScope(uint32_t max_stats_per_scope) override;
   void initializeThreading(Event::Dispatcher& main_thread_dispatcher,
                            ThreadLocal::Instance& tls) override;
   void shutdownThreading() override;
@@ -494,6 +506,12 @@ private:
   bool rejects(StatName name) const { return stats_matcher_->rejects(name); }
   StatsMatcher::FastResult fastRejects(StatName name) const;
   bool rejectsAll() const { return stats_matcher_->rejectsAll(); }
+  bool isShardedCounter(StatName tag_extracted_name) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    return sharded_counter_names_.contains(tag_extracted_name);
+  }
+  // Returns whether a new stat may not be created in the scope, as it already holds the maximum
+  // number of stats, counting the overflow if so.
+  bool scopeAtStatLimit(const ScopeImpl& scope) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   template <class StatMapClass, class StatListClass>
   void removeRejectedStats(StatMapClass& map, StatListClass& list);
   template <class StatSharedPtr>
@@ -517,6 +535,13 @@ private:
   TagProducerPtr tag_producer_;
   StatsMatcherPtr stats_matcher_;
   HistogramSettingsConstPtr histogram_settings_;
+  // The tag extracted names of the counters to create sharded.
+  StatNamePool sharded_counter_pool_;
+  StatNameHashSet sharded_counter_names_ ABSL_GUARDED_BY(lock_);
+  // The maximum number of stats of a scope other than the default one, or 0 for no limit, and the
+  // counter of stats not created because of it.
+  uint32_t max_stats_per_scope_ ABSL_GUARDED_BY(lock_) = 0;
+  Counter* scope_stats_overflow_ ABSL_GUARDED_BY(lock_) = nullptr;
   std::atomic<bool> threading_ever_initialized_{};
   std::atomic<bool> shutting_down_{};
   std::atomic<bool> merge_in_progress_{};
@@ -132,6 +132,11 @@ void FilterStateImpl::maybeCreateParent(ParentAccessMode parent_access_mode) {
   }
   if (absl::holds_alternative<FilterStateSharedPtr>(ancestor_)) {
     FilterStateSharedPtr ancestor = absl::get<FilterStateSharedPtr>(ancestor_);
+    // Without an ancestor, the parents would be empty until data is stored in them, so they are
+    // only created then.
+    if (parent_access_mode == ParentAccessMode::ReadOnly && ancestor == nullptr) {
+      return;
+    }
     if (ancestor == nullptr || ancestor->lifeSpan() != life_span_ + 1) {
       parent_ = std::make_shared<FilterStateImpl>(ancestor, FilterState::LifeSpan(life_span_ + 1));
     } else {
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <memory>
 
 #include "envoy/common/time.h"
 #include "envoy/config/core/v3/base.pb.h"
@@ -280,11 +281,19 @@ struct StreamInfoImpl : public StreamInfo {
 
   Router::RouteConstSharedPtr route() const override { return route_; }
 
-  envoy::config::core::v3::Metadata& dynamicMetadata() override { return metadata_; };
-  const envoy::config::core::v3::Metadata& dynamicMetadata() const override { return metadata_; };
+  envoy::config::core::v3::Metadata& dynamicMetadata() override {
+    if (metadata_ == nullptr) {
+      metadata_ = std::make_unique<envoy::config::core::v3::Metadata>();
+    }
+    return *metadata_;
+  };
+  const envoy::config::core::v3::Metadata& dynamicMetadata() const override {
+    return metadata_ != nullptr ? *metadata_
+                                : envoy::config::core::v3::Metadata::default_instance();
+  };
 
   void setDynamicMetadata(const std::string& name, const ProtobufWkt::Struct& value) override {
-    (*metadata_.mutable_filter_metadata())[name].MergeFrom(value);
+    (*dynamicMetadata().mutable_filter_metadata())[name].MergeFrom(value);
   };
 
   const FilterStateSharedPtr& filterState() override { return filter_state_; }
@@ -395,7 +404,13 @@ struct StreamInfoImpl : public StreamInfo {
                            other_response_flags.end());
     health_check_request_ = info.healthCheck();
     route_ = info.route();
-    metadata_ = info.dynamicMetadata();
+    const envoy::config::core::v3::Metadata& metadata =
+        static_cast<const StreamInfo&>(info).dynamicMetadata();
+    if (metadata.filter_metadata().empty() && metadata.typed_filter_metadata().empty()) {
+      metadata_.reset();
+    } else {
+      metadata_ = std::make_unique<envoy::config::core::v3::Metadata>(metadata);
+    }
     filter_state_ = info.filterState();
     request_headers_ = request_headers;
     upstream_cluster_info_ = info.upstreamClusterInfo();
@@ -444,7 +459,8 @@ public:
   absl::InlinedVector<ResponseFlag, 4> response_flags_{};
   bool health_check_request_{};
   Router::RouteConstSharedPtr route_;
-  envoy::config::core::v3::Metadata metadata_{};
+  // Only allocated once written, as most streams have no dynamic metadata.
+  std::unique_ptr<envoy::config::core::v3::Metadata> metadata_;
   FilterStateSharedPtr filter_state_;
   absl::optional<uint32_t> attempt_count_;
   // TODO(agrawroh): Check if the owner of this storage outlives the StreamInfo. We should only copy
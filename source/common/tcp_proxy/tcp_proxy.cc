@@ -702,6 +702,10 @@ Network::FilterStatus Filter::onData(Buffer::Instance& data, bool end_stream) {
   getStreamInfo().getDownstreamBytesMeter()->addWireBytesReceived(data.length());
   if (upstream_) {
     getStreamInfo().getUpstreamBytesMeter()->addWireBytesSent(data.length());
+    // Moving the read slices into the upstream write buffer doesn't copy the data. Bypassing
+    // userspace altogether with splice() is not possible here, as the data has already been read
+    // by the downstream transport socket, and the connection filter chain and watermarks depend
+    // on every byte passing through these buffers.
     upstream_->encodeData(data, end_stream);
   }
   // The upstream should consume all of the data.
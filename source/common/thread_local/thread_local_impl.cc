@@ -96,14 +96,18 @@ void InstanceImpl::SlotImpl::set(InitializeCb cb) {
   ASSERT_IS_MAIN_OR_TEST_THREAD();
   ASSERT(!parent_.shutdown_);
 
+  // As in InstanceImpl::runOnAllThreads(), share the callback between the threads rather than
+  // copying it for each of them.
+  auto shared_cb = std::make_shared<const InitializeCb>(std::move(cb));
   for (Event::Dispatcher& dispatcher : parent_.registered_threads_) {
     // See the header file comments for still_alive_guard_ for why we capture index_.
-    dispatcher.post(wrapCallback(
-        [index = index_, cb, &dispatcher]() -> void { setThreadLocal(index, cb(dispatcher)); }));
+    dispatcher.post(wrapCallback([index = index_, shared_cb, &dispatcher]() -> void {
+      setThreadLocal(index, (*shared_cb)(dispatcher));
+    }));
   }
 
   // Handle main thread.
-  setThreadLocal(index_, cb(*parent_.main_thread_dispatcher_));
+  setThreadLocal(index_, (*shared_cb)(*parent_.main_thread_dispatcher_));
 }
 
 void InstanceImpl::registerThread(Event::Dispatcher& dispatcher, bool main_thread) {
@@ -151,12 +155,15 @@ void InstanceImpl::runOnAllThreads(std::function<void()> cb) {
   ASSERT_IS_MAIN_OR_TEST_THREAD();
   ASSERT(!shutdown_);
 
+  // Share the callback between the threads rather than copying it for each of them, as its
+  // captures may be large, e.g. the host vectors of a cluster update.
+  auto shared_cb = std::make_shared<const std::function<void()>>(std::move(cb));
   for (Event::Dispatcher& dispatcher : registered_threads_) {
-    dispatcher.post(cb);
+    dispatcher.post([shared_cb]() -> void { (*shared_cb)(); });
   }
 
   // Handle main thread.
-  cb();
+  (*shared_cb)();
 }
 
 void InstanceImpl::runOnAllThreads(std::function<void()> cb,
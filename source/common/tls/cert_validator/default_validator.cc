@@ -34,6 +34,7 @@
 #include "source/common/tls/utility.h"
 
 #include "absl/synchronization/mutex.h"
+#include "openssl/sha.h"
 #include "openssl/ssl.h"
 #include "openssl/x509v3.h"
 
@@ -45,7 +46,9 @@ namespace Tls {
 DefaultCertValidator::DefaultCertValidator(
     const Envoy::Ssl::CertificateValidationContextConfig* config, SslStats& stats,
     TimeSource& time_source)
-    : config_(config), stats_(stats), time_source_(time_source) {
+    : config_(config), stats_(stats), time_source_(time_source),
+      verified_cert_chain_cache_size_(config != nullptr ? config->verifiedCertificateCacheSize()
+                                                        : 0) {
   if (config_ != nullptr) {
     allow_untrusted_certificate_ = config_->trustChainVerification() ==
                                    envoy::extensions::transport_sockets::tls::v3::
@@ -72,13 +75,8 @@ int DefaultCertValidator::initializeSslContexts(std::vector<SSL_CTX*> contexts,
 
   if (config_ != nullptr && !config_->caCert().empty() && !provides_certificates) {
     ca_file_path_ = config_->caCertPath();
-    bssl::UniquePtr<BIO> bio(
-        BIO_new_mem_buf(const_cast<char*>(config_->caCert().data()), config_->caCert().size()));
-    RELEASE_ASSERT(bio != nullptr, "");
-    // Based on BoringSSL's X509_load_cert_crl_file().
-    bssl::UniquePtr<STACK_OF(X509_INFO)> list(
-        PEM_X509_INFO_read_bio(bio.get(), nullptr, nullptr, nullptr));
-    if (list == nullptr) {
+    ca_infos_ = CertValidatorUtil::parseX509Infos(config_->caCert());
+    if (ca_infos_ == nullptr) {
       throwEnvoyExceptionOrPanic(
           absl::StrCat("Failed to load trusted CA certificates from ", config_->caCertPath()));
     }
@@ -89,7 +87,7 @@ int DefaultCertValidator::initializeSslContexts(std::vector<SSL_CTX*> contexts,
         X509_STORE_set_flags(store, X509_V_FLAG_PARTIAL_CHAIN);
       }
       bool has_crl = false;
-      for (const X509_INFO* item : list.get()) {
+      for (const X509_INFO* item : ca_infos_.get()) {
         if (item->x509) {
           X509_STORE_add_cert(store, item->x509);
           if (ca_cert_ == nullptr) {
@@ -121,15 +119,8 @@ int DefaultCertValidator::initializeSslContexts(std::vector<SSL_CTX*> contexts,
   }
 
   if (config_ != nullptr && !config_->certificateRevocationList().empty()) {
-    bssl::UniquePtr<BIO> bio(
-        BIO_new_mem_buf(const_cast<char*>(config_->certificateRevocationList().data()),
-                        config_->certificateRevocationList().size()));
-    RELEASE_ASSERT(bio != nullptr, "");
-
-    // Based on BoringSSL's X509_load_cert_crl_file().
-    bssl::UniquePtr<STACK_OF(X509_INFO)> list(
-        PEM_X509_INFO_read_bio(bio.get(), nullptr, nullptr, nullptr));
-    if (list == nullptr) {
+    crl_infos_ = CertValidatorUtil::parseX509Infos(config_->certificateRevocationList());
+    if (crl_infos_ == nullptr) {
       throwEnvoyExceptionOrPanic(
           absl::StrCat("Failed to load CRL from ", config_->certificateRevocationListPath()));
     }
@@ -139,7 +130,7 @@ int DefaultCertValidator::initializeSslContexts(std::vector<SSL_CTX*> contexts,
       if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.enable_intermediate_ca")) {
         X509_STORE_set_flags(store, X509_V_FLAG_PARTIAL_CHAIN);
       }
-      for (const X509_INFO* item : list.get()) {
+      for (const X509_INFO* item : crl_infos_.get()) {
         if (item->crl) {
           X509_STORE_add_crl(store, item->crl);
         }
@@ -293,8 +284,20 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
     return {ValidationResults::ValidationStatus::Failed,
             Envoy::Ssl::ClientValidationStatus::NoClientCertificate, absl::nullopt, error};
   }
+  // Only chains verified against the trusted CA are cached, as the other checks are cheap.
+  const bool use_cache = verified_cert_chain_cache_size_ > 0 && verify_trusted_ca_;
+  std::string cache_key;
+  if (use_cache) {
+    cache_key = verifiedCertChainKey(cert_chain, transport_socket_options.get());
+    if (findVerifiedCertChain(cache_key)) {
+      stats_.verify_cache_hit_.inc();
+      return {ValidationResults::ValidationStatus::Successful,
+              Envoy::Ssl::ClientValidationStatus::Validated, absl::nullopt, absl::nullopt};
+    }
+  }
   Envoy::Ssl::ClientValidationStatus detailed_status =
       Envoy::Ssl::ClientValidationStatus::NotValidated;
+  absl::optional<SystemTime> expiration;
   X509* leaf_cert = sk_X509_value(&cert_chain, 0);
   ASSERT(leaf_cert);
   if (verify_trusted_ca_) {
@@ -333,17 +336,82 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
               SSL_alert_from_verify_result(X509_STORE_CTX_get_error(ctx.get())), error};
     }
     detailed_status = Envoy::Ssl::ClientValidationStatus::Validated;
+    if (use_cache) {
+      // The verified chain includes the trust anchor, whose expiry also ends the validity of the
+      // cached result.
+      for (X509* cert : X509_STORE_CTX_get0_chain(ctx.get())) {
+        const SystemTime cert_expiration = Utility::getExpirationTime(*cert);
+        expiration = expiration.has_value() ? std::min(*expiration, cert_expiration)
+                                            : cert_expiration;
+      }
+    }
   }
   std::string error_details;
   uint8_t tls_alert = SSL_AD_CERTIFICATE_UNKNOWN;
   const bool succeeded = verifyCertAndUpdateStatus(leaf_cert, transport_socket_options.get(),
                                                    detailed_status, &error_details, &tls_alert);
+  if (succeeded && detailed_status == Envoy::Ssl::ClientValidationStatus::Validated &&
+      expiration.has_value()) {
+    addVerifiedCertChain(std::move(cache_key), *expiration);
+  }
   return succeeded ? ValidationResults{ValidationResults::ValidationStatus::Successful,
                                        detailed_status, absl::nullopt, absl::nullopt}
                    : ValidationResults{ValidationResults::ValidationStatus::Failed, detailed_status,
                                        tls_alert, error_details};
 }
 
+std::string DefaultCertValidator::verifiedCertChainKey(
+    STACK_OF(X509)& cert_chain, const Network::TransportSocketOptions* transport_socket_options) {
+  SHA256_CTX sha256;
+  SHA256_Init(&sha256);
+  for (const X509* cert : &cert_chain) {
+    uint8_t cert_digest[SHA256_DIGEST_LENGTH];
+    unsigned int cert_digest_length;
+    RELEASE_ASSERT(X509_digest(cert, EVP_sha256(), cert_digest, &cert_digest_length) == 1,
+                   Utility::getLastCryptoError().value_or(""));
+    SHA256_Update(&sha256, cert_digest, cert_digest_length);
+  }
+  if (transport_socket_options != nullptr) {
+    for (const std::string& san : transport_socket_options->verifySubjectAltNameListOverride()) {
+      // Include the terminating null character to separate the names.
+      SHA256_Update(&sha256, san.c_str(), san.size() + 1);
+    }
+  }
+  std::string key(SHA256_DIGEST_LENGTH, '\0');
+  SHA256_Final(reinterpret_cast<uint8_t*>(key.data()), &sha256);
+  return key;
+}
+
+bool DefaultCertValidator::findVerifiedCertChain(const std::string& key) {
+  absl::MutexLock lock(&verified_cert_chain_mutex_);
+  auto it = verified_cert_chain_index_.find(key);
+  if (it == verified_cert_chain_index_.end()) {
+    return false;
+  }
+  if (it->second->second <= time_source_.systemTime()) {
+    verified_cert_chains_.erase(it->second);
+    verified_cert_chain_index_.erase(it);
+    return false;
+  }
+  verified_cert_chains_.splice(verified_cert_chains_.begin(), verified_cert_chains_, it->second);
+  return true;
+}
+
+void DefaultCertValidator::addVerifiedCertChain(std::string key, SystemTime expiration) {
+  absl::MutexLock lock(&verified_cert_chain_mutex_);
+  if (verified_cert_chain_index_.contains(key)) {
+    // Another connection verified the same chain concurrently.
+    return;
+  }
+  if (verified_cert_chains_.size() >= verified_cert_chain_cache_size_) {
+    verified_cert_chain_index_.erase(verified_cert_chains_.back().first);
+    verified_cert_chains_.pop_back();
+  }
+  verified_cert_chains_.emplace_front(std::move(key), expiration);
+  verified_cert_chain_index_.emplace(verified_cert_chains_.front().first,
+                                     verified_cert_chains_.begin());
+}
+
 bool DefaultCertValidator::verifySubjectAltName(X509* cert,
                                                 const std::vector<std::string>& subject_alt_names) {
   bssl::UniquePtr<GENERAL_NAMES> san_names(
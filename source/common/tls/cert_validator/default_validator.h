@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <deque>
 #include <functional>
+#include <list>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -23,6 +25,7 @@
 #include "source/common/tls/cert_validator/san_matcher.h"
 #include "source/common/tls/stats.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
 #include "openssl/ssl.h"
 #include "openssl/x509v3.h"
@@ -108,6 +111,16 @@ private:
                                  Envoy::Ssl::ClientValidationStatus& detailed_status,
                                  std::string* error_details, uint8_t* out_alert);
 
+  // Cache of the successfully verified peer certificate chains. The key of a chain is the SHA-256
+  // of its certificates and of the subject alt names it was verified against, and an entry expires
+  // with the first certificate of the verified chain. The cache lives as long as the validator, so
+  // that an update of the validation context, which creates a new validator, drops it.
+  static std::string
+  verifiedCertChainKey(STACK_OF(X509)& cert_chain,
+                       const Network::TransportSocketOptions* transport_socket_options);
+  bool findVerifiedCertChain(const std::string& key);
+  void addVerifiedCertChain(std::string key, SystemTime expiration);
+
   const Envoy::Ssl::CertificateValidationContextConfig* config_;
   SslStats& stats_;
   TimeSource& time_source_;
@@ -115,10 +128,22 @@ private:
   bool allow_untrusted_certificate_{false};
   bssl::UniquePtr<X509> ca_cert_;
   std::string ca_file_path_;
+  // The parsed trusted CA and CRL bundles, held so that validators trusting the same bundles keep
+  // sharing them instead of parsing them again.
+  std::shared_ptr<STACK_OF(X509_INFO)> ca_infos_;
+  std::shared_ptr<STACK_OF(X509_INFO)> crl_infos_;
   std::vector<SanMatcherPtr> subject_alt_name_matchers_;
   std::vector<std::vector<uint8_t>> verify_certificate_hash_list_;
   std::vector<std::vector<uint8_t>> verify_certificate_spki_list_;
   bool verify_trusted_ca_{false};
+
+  using VerifiedCertChainList = std::list<std::pair<std::string, SystemTime>>;
+  const uint32_t verified_cert_chain_cache_size_;
+  absl::Mutex verified_cert_chain_mutex_;
+  // Most recently used first.
+  VerifiedCertChainList verified_cert_chains_ ABSL_GUARDED_BY(verified_cert_chain_mutex_);
+  absl::flat_hash_map<std::string, VerifiedCertChainList::iterator>
+      verified_cert_chain_index_ ABSL_GUARDED_BY(verified_cert_chain_mutex_);
 };
 
 DECLARE_FACTORY(DefaultCertValidatorFactory);
@@ -1,5 +1,15 @@
 #include "source/common/tls/cert_validator/utility.h"
 
+#include <string>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/sha.h"
+#include "openssl/ssl.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace TransportSockets {
@@ -22,6 +32,17 @@ int ignoreCertificateExpirationCallback(int ok, X509_STORE_CTX* store_ctx) {
 } // namespace
 #endif
 
+namespace {
+// The parsed PEM bundles which are in use, keyed by the SHA-256 digest of their content.
+struct X509InfosCache {
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, std::weak_ptr<STACK_OF(X509_INFO)>>
+      infos_ ABSL_GUARDED_BY(mutex_);
+};
+
+X509InfosCache& x509InfosCache() { MUTABLE_CONSTRUCT_ON_FIRST_USE(X509InfosCache); }
+} // namespace
+
 void CertValidatorUtil::setIgnoreCertificateExpiration(X509_STORE_CTX* store_ctx) {
 #if defined(X509_V_FLAG_NO_CHECK_TIME)
   X509_STORE_CTX_set_flags(store_ctx, X509_V_FLAG_NO_CHECK_TIME);
@@ -38,6 +59,43 @@ void CertValidatorUtil::setIgnoreCertificateExpiration(X509_STORE* store) {
 #endif
 }
 
+std::shared_ptr<STACK_OF(X509_INFO)> CertValidatorUtil::parseX509Infos(absl::string_view pem) {
+  std::string digest(SHA256_DIGEST_LENGTH, '\0');
+  SHA256(reinterpret_cast<const uint8_t*>(pem.data()), pem.size(),
+         reinterpret_cast<uint8_t*>(digest.data()));
+
+  X509InfosCache& cache = x509InfosCache();
+  absl::MutexLock lock(&cache.mutex_);
+  std::weak_ptr<STACK_OF(X509_INFO)>& cached = cache.infos_[digest];
+  std::shared_ptr<STACK_OF(X509_INFO)> infos = cached.lock();
+  if (infos != nullptr) {
+    return infos;
+  }
+
+  bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(const_cast<char*>(pem.data()), pem.size()));
+  RELEASE_ASSERT(bio != nullptr, "");
+  // Based on BoringSSL's X509_load_cert_crl_file().
+  STACK_OF(X509_INFO)* list = PEM_X509_INFO_read_bio(bio.get(), nullptr, nullptr, nullptr);
+  if (list == nullptr) {
+    cache.infos_.erase(digest);
+    return nullptr;
+  }
+  infos.reset(list, [digest](STACK_OF(X509_INFO)* list) {
+    X509InfosCache& cache = x509InfosCache();
+    {
+      absl::MutexLock lock(&cache.mutex_);
+      // The entry may have been replaced by a new parse of the same bundle after this one expired.
+      auto it = cache.infos_.find(digest);
+      if (it != cache.infos_.end() && it->second.expired()) {
+        cache.infos_.erase(it);
+      }
+    }
+    sk_X509_INFO_pop_free(list, X509_INFO_free);
+  });
+  cached = infos;
+  return infos;
+}
+
 } // namespace Tls
 } // namespace TransportSockets
 } // namespace Extensions
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory>
+
+#include "absl/strings/string_view.h"
 #include "openssl/x509v3.h"
 
 namespace Envoy {
@@ -14,6 +17,11 @@ public:
 
   // Configures `store` to ignore certificate expiration.
   static void setIgnoreCertificateExpiration(X509_STORE* store);
+
+  // Returns the certificates and CRLs of the PEM bundle `pem`, or nullptr if it can't be parsed.
+  // Identical bundles are parsed once and share the result while it is in use, so that the stores
+  // of many contexts trusting the same CAs reference the same certificate objects.
+  static std::shared_ptr<STACK_OF(X509_INFO)> parseX509Infos(absl::string_view pem);
 };
 
 } // namespace Tls
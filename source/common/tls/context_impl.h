@@ -204,7 +204,11 @@ public:
   enum ssl_select_cert_result_t selectTlsContext(const SSL_CLIENT_HELLO* ssl_client_hello);
 
   // Finds the best matching context. The returned context will have the same lifetime as
-  // this ``ServerContextImpl``.
+  // this ``ServerContextImpl``. A SNI is matched with at most two lookups of server_names_map_,
+  // one for the exact name and one for its wildcard domain, regardless of the number of
+  // certificates. The contexts are only scanned in order when no SNI is provided, or when it
+  // matches no certificate and full_scan_certs_on_sni_mismatch is enabled, and the scan stops at
+  // the first context compatible with the client.
   std::pair<const Ssl::TlsContext&, OcspStapleAction> findTlsContext(absl::string_view sni,
                                                                      bool client_ecdsa_capable,
                                                                      bool client_ocsp_capable,
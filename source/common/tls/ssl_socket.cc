@@ -264,6 +264,9 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     bytes_to_write = std::min(write_buffer.length(), static_cast<uint64_t>(16384));
   }
 
+  // Records are always encrypted here rather than by kernel TLS: BoringSSL neither configures
+  // TLS_TX/TLS_RX on the socket nor exports the traffic secrets and sequence numbers which doing so
+  // would require. Kernel TLS would also bypass the BIO that this transport socket writes through.
   uint64_t total_bytes_written = 0;
   while (bytes_to_write > 0) {
     // TODO(mattklein123): As it relates to our fairness efforts, we might want to limit the number
@@ -414,6 +417,9 @@ bool ClientSslSocketFactory::implementsSecureTransport() const { return true; }
 
 void ClientSslSocketFactory::onAddOrUpdateSecret() {
   ENVOY_LOG(debug, "Secret is updated.");
+  // The sessions cached by the previous context are deliberately not carried over. Resuming them
+  // would skip validating the server against the updated validation context, and would present
+  // the identity of the replaced client certificate.
   auto ctx = manager_.createSslClientContext(stats_scope_, *config_);
   {
     absl::WriterMutexLock l(&ssl_ctx_mu_);
@@ -463,6 +469,9 @@ bool ServerSslSocketFactory::implementsSecureTransport() const { return true; }
 
 void ServerSslSocketFactory::onAddOrUpdateSecret() {
   ENVOY_LOG(debug, "Secret is updated.");
+  // The new context has an empty session cache, and unless session ticket keys are configured,
+  // new ticket keys. Configured ticket keys keep tickets valid across certificate rotations, as
+  // the session ID context only depends on the names of the certificates.
   auto ctx = manager_.createSslServerContext(stats_scope_, *config_, server_names_, nullptr);
   {
     absl::WriterMutexLock l(&ssl_ctx_mu_);
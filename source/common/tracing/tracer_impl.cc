@@ -87,6 +87,12 @@ Decision TracerUtility::shouldTraceRequest(const StreamInfo::StreamInfo& stream_
 void TracerUtility::finalizeSpan(Span& span, const TraceContext& trace_context,
                                  const StreamInfo::StreamInfo& stream_info,
                                  const Config& tracing_config, bool upstream_span) {
+  // The tags of spans which are not reported are never read, so they are not built.
+  if (!span.isRecording()) {
+    span.finishSpan();
+    return;
+  }
+
   span.setTag(Tracing::Tags::get().Component, Tracing::Tags::get().Proxy);
 
   // Response flag.
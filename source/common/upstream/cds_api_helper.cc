@@ -37,16 +37,18 @@ CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& adde
   uint32_t added_or_updated = 0;
   uint32_t skipped = 0;
   for (const auto& resource : added_resources) {
-    envoy::config::cluster::v3::Cluster cluster;
+    // The decoded resource stays alive for the whole update, so there is no need to copy it.
+    const auto& cluster =
+        dynamic_cast<const envoy::config::cluster::v3::Cluster&>(resource.get().resource());
     TRY_ASSERT_MAIN_THREAD {
-      cluster = dynamic_cast<const envoy::config::cluster::v3::Cluster&>(resource.get().resource());
       if (!cluster_names.insert(cluster.name()).second) {
         // NOTE: at this point, the first of these duplicates has already been successfully applied.
         exception_msgs.push_back(
             fmt::format("{}: duplicate cluster {} found", cluster.name(), cluster.name()));
         continue;
       }
-      if (cm_.addOrUpdateCluster(cluster, resource.get().version())) {
+      if (cm_.addOrUpdateCluster(cluster, resource.get().version(),
+                                 resource.get().serializedHash())) {
         any_applied = true;
         ENVOY_LOG(debug, "{}: add/update cluster '{}'", name_, cluster.name());
         ++added_or_updated;
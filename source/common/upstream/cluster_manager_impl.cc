@@ -763,7 +763,8 @@ void ClusterManagerImpl::applyUpdates(ClusterManagerCluster& cluster, uint32_t p
 }
 
 bool ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
-                                            const std::string& version_info) {
+                                            const std::string& version_info,
+                                            absl::optional<uint64_t> serialized_hash) {
   // First we need to see if this new config is new or an update to an existing dynamic cluster.
   // We don't allow updates to statically configured clusters in the main configuration. We check
   // both the warming clusters and the active clusters to see if we need an update or the update
@@ -771,18 +772,24 @@ bool ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cl
   const std::string& cluster_name = cluster.name();
   const auto existing_active_cluster = active_clusters_.find(cluster_name);
   const auto existing_warming_cluster = warming_clusters_.find(cluster_name);
-  const uint64_t new_hash = MessageUtil::hash(cluster);
+  ClusterData* existing_cluster = nullptr;
   if (existing_warming_cluster != warming_clusters_.end()) {
     // If the cluster is the same as the warming cluster of the same name, block the update.
-    if (existing_warming_cluster->second->blockUpdate(new_hash)) {
-      return false;
-    }
     // NB: https://github.com/envoyproxy/envoy/issues/14598
     // Always proceed if the cluster is different from the existing warming cluster.
-  } else if (existing_active_cluster != active_clusters_.end() &&
-             existing_active_cluster->second->blockUpdate(new_hash)) {
+    existing_cluster = existing_warming_cluster->second.get();
+  } else if (existing_active_cluster != active_clusters_.end()) {
     // If there's no warming cluster of the same name, and if the cluster is the same as the active
     // cluster of the same name, block the update.
+    existing_cluster = existing_active_cluster->second.get();
+  }
+  // Management servers commonly resend unchanged clusters, which the hash of their serialized
+  // config detects without hashing the whole config.
+  if (existing_cluster != nullptr && existing_cluster->blockUpdate(serialized_hash)) {
+    return false;
+  }
+  const uint64_t new_hash = MessageUtil::hash(cluster);
+  if (existing_cluster != nullptr && existing_cluster->blockUpdate(new_hash)) {
     return false;
   }
 
@@ -817,6 +824,7 @@ bool ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cl
   THROW_IF_STATUS_NOT_OK(status_or_cluster, throw);
   const ClusterDataPtr previous_cluster = std::move(status_or_cluster.value());
   auto& cluster_entry = warming_clusters_.at(cluster_name);
+  cluster_entry->serialized_hash_ = serialized_hash;
   cluster_entry->cluster_->info()->configUpdateStats().warming_state_.set(1);
   if (!all_clusters_initialized) {
     ENVOY_LOG(debug, "add/update cluster {} during init", cluster_name);
@@ -871,6 +879,7 @@ bool ClusterManagerImpl::removeCluster(const std::string& cluster_name) {
       }
       cluster_manager->thread_local_clusters_.erase(cluster_name);
       cluster_manager->thread_local_deferred_clusters_.erase(cluster_name);
+      cluster_manager->last_cluster_ = nullptr;
       cluster_manager->local_stats_.clusters_inflated_.set(
           cluster_manager->thread_local_clusters_.size());
     });
@@ -1038,9 +1047,14 @@ void ClusterManagerImpl::updateClusterCounts() {
 
 ThreadLocalCluster* ClusterManagerImpl::getThreadLocalCluster(absl::string_view cluster) {
   ThreadLocalClusterManagerImpl& cluster_manager = *tls_;
+  if (cluster_manager.last_cluster_ != nullptr &&
+      cluster_manager.last_cluster_->name() == cluster) {
+    return cluster_manager.last_cluster_;
+  }
 
   auto entry = cluster_manager.thread_local_clusters_.find(cluster);
   if (entry != cluster_manager.thread_local_clusters_.end()) {
+    cluster_manager.last_cluster_ = entry->second.get();
     return entry->second.get();
   } else {
     return cluster_manager.initializeClusterInlineIfExists(cluster);
@@ -1288,6 +1302,7 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
         new_cluster = new ThreadLocalClusterManagerImpl::ClusterEntry(*cluster_manager, info,
                                                                       load_balancer_factory);
         cluster_manager->thread_local_clusters_[info->name()].reset(new_cluster);
+        cluster_manager->last_cluster_ = nullptr;
         cluster_manager->local_stats_.clusters_inflated_.set(
             cluster_manager->thread_local_clusters_.size());
       }
@@ -1591,7 +1606,7 @@ ClusterManagerImpl::allocateOdCdsApi(const envoy::config::core::v3::ConfigSource
   // return an already existing one if the config or locator matches. Note that this may need a
   // way to clean up the unused handles, so we can close the unnecessary connections.
   auto odcds = OdCdsApiImpl::create(odcds_config, odcds_resources_locator, *this, *this,
-                                    *stats_.rootScope(), validation_visitor);
+                                    dispatcher_, *stats_.rootScope(), validation_visitor);
   return OdCdsApiHandleImpl::create(*this, std::move(odcds));
 }
 
@@ -1774,6 +1789,7 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::~ThreadLocalClusterManagerImp
   // member update callback registered with the local cluster.
   ENVOY_LOG(debug, "shutting down thread local cluster manager");
   destroying_ = true;
+  last_cluster_ = nullptr;
   host_http_conn_pool_map_.clear();
   host_tcp_conn_pool_map_.clear();
   ASSERT(host_tcp_conn_map_.empty());
@@ -262,7 +262,8 @@ public:
 
   // Upstream::ClusterManager
   bool addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
-                          const std::string& version_info) override;
+                          const std::string& version_info,
+                          absl::optional<uint64_t> serialized_hash = absl::nullopt) override;
 
   void setPrimaryClustersInitializedCb(PrimaryClustersReadyCallback callback) override {
     init_helper_.setPrimaryClustersInitializedCb(callback);
@@ -616,6 +617,8 @@ private:
                           ConnectionPool::DrainBehavior behavior);
       UnitFloat dropOverload() const override { return drop_overload_; }
       void setDropOverload(UnitFloat drop_overload) override { drop_overload_ = drop_overload; }
+      // Unlike info(), does not copy the shared pointer.
+      const std::string& name() const { return cluster_info_->name(); }
 
     private:
       Http::ConnectionPool::Instance*
@@ -709,8 +712,14 @@ private:
     ClusterManagerImpl& parent_;
     Event::Dispatcher& thread_local_dispatcher_;
     // Known clusters will exclusively exist in either `thread_local_clusters_`
-    // or `thread_local_deferred_clusters_`.
+    // or `thread_local_deferred_clusters_`. A cluster moves from the latter to the former
+    // the first time it is used on this worker, and never moves back: callers may keep
+    // references to the ThreadLocalCluster, its load balancer and its connection pools for
+    // as long as the cluster exists.
     absl::flat_hash_map<std::string, ClusterEntryPtr> thread_local_clusters_;
+    // The cluster last returned by getThreadLocalCluster(), as requests usually look up the same
+    // cluster several times. Reset whenever a cluster entry is removed or replaced.
+    ClusterEntry* last_cluster_{};
     // Maps from a given cluster name to the CIO for that cluster.
     ClusterInitializationMap thread_local_deferred_clusters_;
 
@@ -744,6 +753,10 @@ private:
           added_via_api_(added_via_api), added_or_updated_{}, required_for_ads_(required_for_ads) {}
 
     bool blockUpdate(uint64_t hash) { return !added_via_api_ || config_hash_ == hash; }
+    bool blockUpdate(absl::optional<uint64_t> serialized_hash) {
+      return !added_via_api_ ||
+             (serialized_hash.has_value() && serialized_hash_ == serialized_hash);
+    }
 
     // ClusterManagerCluster
     Cluster& cluster() override { return *cluster_; }
@@ -763,6 +776,8 @@ private:
 
     const envoy::config::cluster::v3::Cluster cluster_config_;
     const uint64_t config_hash_;
+    // The hash of the serialized config, if it was known when the cluster was added or updated.
+    absl::optional<uint64_t> serialized_hash_;
     const std::string version_info_;
     // Don't change the order of cluster_ and thread_aware_lb_ as the thread_aware_lb_ may
     // keep a reference to the cluster_.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <list>
 #include <vector>
 
 #include "envoy/common/conn_pool.h"
@@ -71,7 +72,7 @@ public:
 
 private:
   /**
-   * Frees the first idle pool in `active_pools_`.
+   * Frees the least recently used idle pool in `active_pools_`.
    * @return false if no pool was freed.
    */
   bool freeOnePool();
@@ -81,7 +82,16 @@ private:
    **/
   void clearActivePools();
 
-  absl::flat_hash_map<KEY_TYPE, std::unique_ptr<POOL_TYPE>> active_pools_;
+  struct PoolEntry {
+    std::unique_ptr<POOL_TYPE> pool_;
+    // The position of the pool's key in `lru_keys_`.
+    typename std::list<KEY_TYPE>::iterator lru_position_;
+  };
+
+  absl::flat_hash_map<KEY_TYPE, PoolEntry> active_pools_;
+  // Keys of `active_pools_`, most recently used first, so that the least recently used idle pool
+  // is the one freed when the pool limit is reached.
+  std::list<KEY_TYPE> lru_keys_;
   Event::Dispatcher& thread_local_dispatcher_;
   std::vector<IdleCb> cached_callbacks_;
   const HostConstSharedPtr host_;
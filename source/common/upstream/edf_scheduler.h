@@ -31,10 +31,10 @@ public:
 
   // See scheduler.h for an explanation of each public method.
   std::shared_ptr<C> peekAgain(std::function<double(const C&)> calculate_weight) override {
-    std::shared_ptr<C> ret = popEntry();
+    std::shared_ptr<C> ret = nextEntry();
     if (ret) {
       prepick_list_.push_back(ret);
-      add(calculate_weight(*ret), ret);
+      readdNextEntry(calculate_weight(*ret));
     }
     return ret;
   }
@@ -48,9 +48,9 @@ public:
         return ret;
       }
     }
-    std::shared_ptr<C> ret = popEntry();
+    std::shared_ptr<C> ret = nextEntry();
     if (ret) {
-      add(calculate_weight(*ret), ret);
+      readdNextEntry(calculate_weight(*ret));
     }
     return ret;
   }
@@ -171,9 +171,11 @@ private:
   friend class EdfSchedulerTest;
 
   /**
-   * Clears expired entries and pops the next unexpired entry in the queue.
+   * Clears expired entries and returns the next unexpired entry in the queue, advancing the
+   * current time to its deadline. The entry is left at the top of the queue, and must be re-added
+   * with readdNextEntry().
    */
-  std::shared_ptr<C> popEntry() {
+  std::shared_ptr<C> nextEntry() {
     EDF_TRACE("Queue pick: queue_.size()={}, current_time_={}.", queue_.size(), current_time_);
     while (true) {
       if (queue_.empty()) {
@@ -191,11 +193,22 @@ private:
       ASSERT(edf_entry.deadline_ >= current_time_);
       current_time_ = edf_entry.deadline_;
       EDF_TRACE("Picked {}, current_time_={}.", static_cast<const void*>(ret.get()), current_time_);
-      queue_.pop();
       return ret;
     }
   }
 
+  /**
+   * Re-adds the entry returned by nextEntry() with a new deadline. This is equivalent to popping
+   * it and calling add(), but only sifts the queue once and reuses the weak pointer of the entry.
+   */
+  void readdNextEntry(double weight) {
+    ASSERT(weight > 0);
+    const double deadline = current_time_ + 1.0 / weight;
+    EDF_TRACE("Reinsertion in queue with deadline {} and weight {}.", deadline, weight);
+    queue_.replaceTop(deadline, order_offset_++);
+    ASSERT(queue_.top().deadline_ >= current_time_);
+  }
+
   struct EdfEntry {
     double deadline_;
     // Tie breaker for entries with the same deadline. This is used to provide FIFO behavior.
@@ -211,6 +224,36 @@ private:
     }
   };
 
+  // Min priority queue for EDF, which can replace its top entry without a pop and a push.
+  class EdfQueue : public std::priority_queue<EdfEntry> {
+  public:
+    using std::priority_queue<EdfEntry>::priority_queue;
+
+    // Gives the top entry a new deadline and order offset, and restores the heap order.
+    void replaceTop(double deadline, uint64_t order_offset) {
+      ASSERT(!this->c.empty());
+      EdfEntry entry{deadline, order_offset, std::move(this->c.front().entry_)};
+      // Sift the entry down from the root of the heap.
+      const size_t size = this->c.size();
+      size_t index = 0;
+      while (true) {
+        size_t child = 2 * index + 1;
+        if (child >= size) {
+          break;
+        }
+        if (child + 1 < size && this->comp(this->c[child], this->c[child + 1])) {
+          ++child;
+        }
+        if (!this->comp(entry, this->c[child])) {
+          break;
+        }
+        this->c[index] = std::move(this->c[child]);
+        index = child;
+      }
+      this->c[index] = std::move(entry);
+    }
+  };
+
   EdfScheduler(std::vector<EdfEntry>&& scheduler_entries, double current_time,
                uint32_t order_offset)
       : current_time_(current_time), order_offset_(order_offset),
@@ -223,8 +266,7 @@ private:
   // Offset used during addition to break ties when entries have the same weight but should reflect
   // FIFO insertion order in picks.
   uint64_t order_offset_{};
-  // Min priority queue for EDF.
-  std::priority_queue<EdfEntry> queue_;
+  EdfQueue queue_;
   std::list<std::weak_ptr<C>> prepick_list_;
 };
 
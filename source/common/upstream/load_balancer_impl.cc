@@ -1291,10 +1291,10 @@ double LeastRequestLoadBalancer::hostWeight(const Host& host) const {
   // If the value of active requests is the max value, adding +1 will overflow
   // it and cause a divide by zero. This won't happen in normal cases but stops
   // failing fuzz tests
-  const uint64_t active_request_value =
-      host.stats().rq_active_.value() != std::numeric_limits<uint64_t>::max()
-          ? host.stats().rq_active_.value() + 1
-          : host.stats().rq_active_.value();
+  const uint64_t active_requests = host.stats().rq_active_.value();
+  const uint64_t active_request_value = active_requests != std::numeric_limits<uint64_t>::max()
+                                            ? active_requests + 1
+                                            : active_requests;
 
   if (active_request_bias_ == 1.0) {
     host_weight = static_cast<double>(host.weight()) / active_request_value;
@@ -1336,8 +1336,13 @@ HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPick(const HostVector
   return candidate_host;
 }
 
+// The pick functions below read the active requests of the candidate host once, when it is chosen,
+// rather than on every comparison. The gauge of a host is written by every worker which sends
+// requests to it, so each read of a busy host may have to fetch its cache line from another core.
+
 HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVector& hosts_to_use) {
   HostSharedPtr candidate_host = nullptr;
+  uint64_t candidate_active_rq = 0;
 
   size_t num_hosts_known_tied_for_least = 0;
 
@@ -1346,20 +1351,20 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVec
   for (size_t i = 0; i < num_hosts; ++i) {
     const HostSharedPtr& sampled_host = hosts_to_use[i];
 
+    const uint64_t sampled_active_rq = sampled_host->stats().rq_active_.value();
     if (candidate_host == nullptr) {
       // Make a first choice to start the comparisons.
       num_hosts_known_tied_for_least = 1;
       candidate_host = sampled_host;
+      candidate_active_rq = sampled_active_rq;
       continue;
     }
 
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
-
     if (sampled_active_rq < candidate_active_rq) {
       // Reset the count of known tied hosts.
       num_hosts_known_tied_for_least = 1;
       candidate_host = sampled_host;
+      candidate_active_rq = sampled_active_rq;
     } else if (sampled_active_rq == candidate_active_rq) {
       ++num_hosts_known_tied_for_least;
 
@@ -1382,22 +1387,23 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVec
 
 HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickNChoices(const HostVector& hosts_to_use) {
   HostSharedPtr candidate_host = nullptr;
+  uint64_t candidate_active_rq = 0;
 
   for (uint32_t choice_idx = 0; choice_idx < choice_count_; ++choice_idx) {
     const int rand_idx = random_.random() % hosts_to_use.size();
     const HostSharedPtr& sampled_host = hosts_to_use[rand_idx];
+    const uint64_t sampled_active_rq = sampled_host->stats().rq_active_.value();
 
     if (candidate_host == nullptr) {
       // Make a first choice to start the comparisons.
       candidate_host = sampled_host;
+      candidate_active_rq = sampled_active_rq;
       continue;
     }
 
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
-
     if (sampled_active_rq < candidate_active_rq) {
       candidate_host = sampled_host;
+      candidate_active_rq = sampled_active_rq;
     }
   }
 
@@ -11,20 +11,21 @@ namespace Upstream {
 OdCdsApiSharedPtr
 OdCdsApiImpl::create(const envoy::config::core::v3::ConfigSource& odcds_config,
                      OptRef<xds::core::v3::ResourceLocator> odcds_resources_locator,
-                     ClusterManager& cm, MissingClusterNotifier& notifier, Stats::Scope& scope,
+                     ClusterManager& cm, MissingClusterNotifier& notifier,
+                     Event::Dispatcher& dispatcher, Stats::Scope& scope,
                      ProtobufMessage::ValidationVisitor& validation_visitor) {
   return OdCdsApiSharedPtr(new OdCdsApiImpl(odcds_config, odcds_resources_locator, cm, notifier,
-                                            scope, validation_visitor));
+                                            dispatcher, scope, validation_visitor));
 }
 
 OdCdsApiImpl::OdCdsApiImpl(const envoy::config::core::v3::ConfigSource& odcds_config,
                            OptRef<xds::core::v3::ResourceLocator> odcds_resources_locator,
                            ClusterManager& cm, MissingClusterNotifier& notifier,
-                           Stats::Scope& scope,
+                           Event::Dispatcher& dispatcher, Stats::Scope& scope,
                            ProtobufMessage::ValidationVisitor& validation_visitor)
     : Envoy::Config::SubscriptionBase<envoy::config::cluster::v3::Cluster>(validation_visitor,
                                                                            "name"),
-      helper_(cm, "odcds"), cm_(cm), notifier_(notifier),
+      helper_(cm, "odcds"), cm_(cm), notifier_(notifier), dispatcher_(dispatcher),
       scope_(scope.createScope("cluster_manager.odcds.")) {
   // TODO(krnowak): Move the subscription setup to CdsApiHelper. Maybe make CdsApiHelper a base
   // class for CDS and ODCDS.
@@ -80,9 +81,8 @@ void OdCdsApiImpl::sendAwaiting() {
   if (awaiting_names_.empty()) {
     return;
   }
-  // The awaiting names are sent only once. After the state transition from Starting to
-  // InitialFetchDone (which happens on the first received response), the awaiting names list is not
-  // used any more.
+  // Names requested before the initial response are sent once it arrives. Later names are sent at
+  // the end of the event loop iteration which requested them.
   ENVOY_LOG(debug, "odcds: sending request for awaiting cluster names {}",
             fmt::join(awaiting_names_, ", "));
   subscription_->requestOnDemandUpdate(awaiting_names_);
@@ -103,8 +103,14 @@ void OdCdsApiImpl::updateOnDemand(std::string cluster_name) {
     return;
 
   case StartStatus::InitialFetchDone:
+    // The names requested during one event loop iteration, usually by several workers, are sent
+    // in a single request.
     ENVOY_LOG(trace, "odcds: requesting for cluster name {}", cluster_name);
-    subscription_->requestOnDemandUpdate({std::move(cluster_name)});
+    awaiting_names_.insert(std::move(cluster_name));
+    if (send_awaiting_cb_ == nullptr) {
+      send_awaiting_cb_ = dispatcher_.createSchedulableCallback([this] { sendAwaiting(); });
+    }
+    send_awaiting_cb_->scheduleCallbackCurrentIteration();
     return;
   }
   PANIC("corrupt enum");
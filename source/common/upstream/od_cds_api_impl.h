@@ -7,6 +7,7 @@
 #include "envoy/config/cluster/v3/cluster.pb.validate.h"
 #include "envoy/config/core/v3/config_source.pb.h"
 #include "envoy/config/subscription.h"
+#include "envoy/event/dispatcher.h"
 #include "envoy/protobuf/message_validator.h"
 #include "envoy/stats/scope.h"
 #include "envoy/upstream/cluster_manager.h"
@@ -62,7 +63,7 @@ public:
   static OdCdsApiSharedPtr create(const envoy::config::core::v3::ConfigSource& odcds_config,
                                   OptRef<xds::core::v3::ResourceLocator> odcds_resources_locator,
                                   ClusterManager& cm, MissingClusterNotifier& notifier,
-                                  Stats::Scope& scope,
+                                  Event::Dispatcher& dispatcher, Stats::Scope& scope,
                                   ProtobufMessage::ValidationVisitor& validation_visitor);
 
   // Upstream::OdCdsApi
@@ -80,16 +81,21 @@ private:
 
   OdCdsApiImpl(const envoy::config::core::v3::ConfigSource& odcds_config,
                OptRef<xds::core::v3::ResourceLocator> odcds_resources_locator, ClusterManager& cm,
-               MissingClusterNotifier& notifier, Stats::Scope& scope,
+               MissingClusterNotifier& notifier, Event::Dispatcher& dispatcher, Stats::Scope& scope,
                ProtobufMessage::ValidationVisitor& validation_visitor);
   void sendAwaiting();
 
   CdsApiHelper helper_;
   ClusterManager& cm_;
   MissingClusterNotifier& notifier_;
+  Event::Dispatcher& dispatcher_;
   Stats::ScopeSharedPtr scope_;
   StartStatus status_{StartStatus::NotStarted};
+  // Names waiting for the initial response, or, after it, for the end of the current event loop
+  // iteration, so that they are all sent in a single request.
   absl::flat_hash_set<std::string> awaiting_names_;
+  // Created on the first request after the initial fetch.
+  Event::SchedulableCallbackPtr send_awaiting_cb_;
   Config::SubscriptionPtr subscription_;
 };
 
@@ -351,16 +351,14 @@ void DetectorImpl::armIntervalTimer() {
       runtime_.snapshot().getInteger(IntervalMsRuntime, config_.intervalMs())));
 }
 
-void DetectorImpl::checkHostForUneject(HostSharedPtr host, DetectorHostMonitorImpl* monitor,
-                                       MonotonicTime now) {
+void DetectorImpl::checkHostForUneject(const HostSharedPtr& host,
+                                       DetectorHostMonitorImpl* monitor, MonotonicTime now,
+                                       std::chrono::milliseconds base_eject_time,
+                                       std::chrono::milliseconds max_eject_time) {
   if (!host->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK)) {
     return;
   }
 
-  const std::chrono::milliseconds base_eject_time = std::chrono::milliseconds(
-      runtime_.snapshot().getInteger(BaseEjectionTimeMsRuntime, config_.baseEjectionTimeMs()));
-  const std::chrono::milliseconds max_eject_time = std::chrono::milliseconds(
-      runtime_.snapshot().getInteger(MaxEjectionTimeMsRuntime, config_.maxEjectionTimeMs()));
   const std::chrono::milliseconds jitter = monitor->getJitter();
   ASSERT(monitor->numEjections() > 0);
   if ((min(base_eject_time * monitor->ejectTimeBackoff(), max_eject_time) + jitter) <=
@@ -629,8 +627,9 @@ DetectorImpl::EjectionPair DetectorImpl::successRateEjectionThreshold(
   double mean = success_rate_sum / valid_success_rate_hosts.size();
   double variance = 0;
   std::for_each(valid_success_rate_hosts.begin(), valid_success_rate_hosts.end(),
-                [&variance, mean](HostSuccessRatePair v) {
-                  variance += std::pow(v.success_rate_ - mean, 2);
+                [&variance, mean](const HostSuccessRatePair& v) {
+                  const double deviation = v.success_rate_ - mean;
+                  variance += deviation * deviation;
                 });
   variance /= valid_success_rate_hosts.size();
   double stdev = std::sqrt(variance);
@@ -741,9 +740,17 @@ void DetectorImpl::processSuccessRateEjections(
 
 void DetectorImpl::onIntervalTimer() {
   MonotonicTime now = time_source_.monotonicTime();
+  // The runtime is read once per interval rather than once per host, as clusters may have tens of
+  // thousands of hosts.
+  const std::chrono::milliseconds base_eject_time = std::chrono::milliseconds(
+      runtime_.snapshot().getInteger(BaseEjectionTimeMsRuntime, config_.baseEjectionTimeMs()));
+  const std::chrono::milliseconds max_eject_time = std::chrono::milliseconds(
+      runtime_.snapshot().getInteger(MaxEjectionTimeMsRuntime, config_.maxEjectionTimeMs()));
+  const std::chrono::milliseconds interval = std::chrono::milliseconds(
+      runtime_.snapshot().getInteger(IntervalMsRuntime, config_.intervalMs()));
 
-  for (auto host : host_monitors_) {
-    checkHostForUneject(host.first, host.second, now);
+  for (const auto& host : host_monitors_) {
+    checkHostForUneject(host.first, host.second, now, base_eject_time, max_eject_time);
 
     // Need to update the writer bucket to keep the data valid.
     host.second->updateCurrentSuccessRateBucket();
@@ -757,14 +764,12 @@ void DetectorImpl::onIntervalTimer() {
   processSuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin);
 
   // Decrement time backoff for all hosts which have not been ejected.
-  for (auto host : host_monitors_) {
+  for (const auto& host : host_monitors_) {
     if (!host.first->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK)) {
       auto& monitor = host.second;
       // Node is healthy and was not ejected since the last check.
       if (monitor->lastUnejectionTime().has_value() &&
-          ((now - monitor->lastUnejectionTime().value()) >=
-           std::chrono::milliseconds(
-               runtime_.snapshot().getInteger(IntervalMsRuntime, config_.intervalMs())))) {
+          ((now - monitor->lastUnejectionTime().value()) >= interval)) {
         if (monitor->ejectTimeBackoff() != 0) {
           monitor->ejectTimeBackoff()--;
         }
@@ -425,7 +425,9 @@ private:
 
   void addHostMonitor(HostSharedPtr host);
   void armIntervalTimer();
-  void checkHostForUneject(HostSharedPtr host, DetectorHostMonitorImpl* monitor, MonotonicTime now);
+  void checkHostForUneject(const HostSharedPtr& host, DetectorHostMonitorImpl* monitor,
+                           MonotonicTime now, std::chrono::milliseconds base_eject_time,
+                           std::chrono::milliseconds max_eject_time);
   void ejectHost(HostSharedPtr host, envoy::data::cluster::v3::OutlierEjectionType type);
   static DetectionStats generateStats(Stats::Scope& scope);
   void initialize(Cluster& cluster);
@@ -119,11 +119,12 @@ private:
 
     // Envoy::ResourceLimit
     bool canCreate() override {
-      if (!useRetryBudget()) {
+      const Runtime::Snapshot& snapshot = runtime_.snapshot();
+      if (!useRetryBudget(snapshot)) {
         return max_retry_resource_.canCreate();
       }
-      clearRemainingGauge();
-      return count() < max();
+      remaining_.set(0);
+      return count() < budgetMax(snapshot);
     }
     void inc() override {
       max_retry_resource_.inc();
@@ -138,37 +139,40 @@ private:
       clearRemainingGauge();
     }
     uint64_t max() override {
-      if (!useRetryBudget()) {
+      const Runtime::Snapshot& snapshot = runtime_.snapshot();
+      if (!useRetryBudget(snapshot)) {
         return max_retry_resource_.max();
       }
+      remaining_.set(0);
+      return budgetMax(snapshot);
+    }
+    uint64_t count() const override { return max_retry_resource_.count(); }
+
+  private:
+    bool useRetryBudget(const Runtime::Snapshot& snapshot) const {
+      return budget_percent_ || min_retry_concurrency_ ||
+             snapshot.get(budget_percent_key_).has_value() ||
+             snapshot.get(min_retry_concurrency_key_).has_value();
+    }
 
+    uint64_t budgetMax(const Runtime::Snapshot& snapshot) const {
       const uint64_t current_active = requests_.count() + pending_requests_.count();
-      const double budget_percent = runtime_.snapshot().getDouble(
-          budget_percent_key_, budget_percent_ ? *budget_percent_ : 20.0);
-      const uint32_t min_retry_concurrency = runtime_.snapshot().getInteger(
+      const double budget_percent =
+          snapshot.getDouble(budget_percent_key_, budget_percent_ ? *budget_percent_ : 20.0);
+      const uint32_t min_retry_concurrency = snapshot.getInteger(
           min_retry_concurrency_key_, min_retry_concurrency_ ? *min_retry_concurrency_ : 3);
 
-      clearRemainingGauge();
-
       // We enforce that the retry concurrency is never allowed to go below the
       // min_retry_concurrency, even if the configured percent of the current active requests
       // yields a value that is smaller.
       return std::max<uint64_t>(budget_percent / 100.0 * current_active, min_retry_concurrency);
     }
-    uint64_t count() const override { return max_retry_resource_.count(); }
-
-  private:
-    bool useRetryBudget() const {
-      return runtime_.snapshot().get(budget_percent_key_).has_value() ||
-             runtime_.snapshot().get(min_retry_concurrency_key_).has_value() || budget_percent_ ||
-             min_retry_concurrency_;
-    }
 
     // If the retry budget is in use, the stats tracking remaining retries do not make sense since
     // they would dependent on other resources that can change without a call to this object.
     // Therefore, the gauge should just be reset to 0.
     void clearRemainingGauge() {
-      if (useRetryBudget()) {
+      if (useRetryBudget(runtime_.snapshot())) {
         remaining_.set(0);
       }
     }
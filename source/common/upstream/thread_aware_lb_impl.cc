@@ -3,6 +3,8 @@
 #include <memory>
 #include <random>
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -97,12 +99,14 @@ void ThreadAwareLoadBalancerBase::initialize() {
   // complicated initialization as the load balancer would need its own initialized callback. I
   // think the synchronous/asynchronous split is probably the best option.
   priority_update_cb_ = priority_set_.addPriorityUpdateCb(
-      [this](uint32_t, const HostVector&, const HostVector&) -> void { refresh(); });
+      [this](uint32_t priority, const HostVector&, const HostVector&) -> void {
+        refresh(priority);
+      });
 
-  refresh();
+  refresh(absl::nullopt);
 }
 
-void ThreadAwareLoadBalancerBase::refresh() {
+void ThreadAwareLoadBalancerBase::refresh(absl::optional<uint32_t> updated_priority) {
   auto per_priority_state_vector = std::make_shared<std::vector<PerPriorityStatePtr>>(
       priority_set_.hostSetsPerPriority().size());
   auto healthy_per_priority_load =
@@ -110,6 +114,12 @@ void ThreadAwareLoadBalancerBase::refresh() {
   auto degraded_per_priority_load =
       std::make_shared<DegradedLoad>(per_priority_load_.degraded_priority_load_);
 
+  std::shared_ptr<std::vector<PerPriorityStatePtr>> previous_per_priority_state_vector;
+  if (updated_priority.has_value()) {
+    absl::ReaderMutexLock lock(&factory_->mutex_);
+    previous_per_priority_state_vector = factory_->per_priority_state_;
+  }
+
   for (const auto& host_set : priority_set_.hostSetsPerPriority()) {
     const uint32_t priority = host_set->priority();
     (*per_priority_state_vector)[priority] = std::make_unique<PerPriorityState>();
@@ -118,6 +128,19 @@ void ThreadAwareLoadBalancerBase::refresh() {
     // in hosts set or hosts' health.
     per_priority_state->global_panic_ = per_priority_panic_[priority];
 
+    // The hosts of the other priorities did not change, so their hashing load balancers can be
+    // shared with the previous state unless their panic mode flipped. Rebuilding e.g. a Maglev
+    // table is by far the most expensive part of the refresh.
+    if (previous_per_priority_state_vector != nullptr && priority != updated_priority.value() &&
+        priority < previous_per_priority_state_vector->size()) {
+      const auto& previous_state = (*previous_per_priority_state_vector)[priority];
+      if (previous_state != nullptr &&
+          previous_state->global_panic_ == per_priority_state->global_panic_) {
+        per_priority_state->current_lb_ = previous_state->current_lb_;
+        continue;
+      }
+    }
+
     // Normalize host and locality weights such that the sum of all normalized weights is 1.
     NormalizedHostWeightVector normalized_host_weights;
     double min_normalized_weight = 1.0;
@@ -199,14 +222,14 @@ double ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::hostOverload
   const uint32_t slots =
       std::max(static_cast<uint32_t>(std::ceil(total_slots * weight)), static_cast<uint32_t>(1));
 
-  if (host.stats().rq_active_.value() > slots) {
+  if (host_active > slots) {
     ENVOY_LOG_MISC(
         debug,
         "ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost: "
         "host {} overloaded; overall_active {}, host_weight {}, host_active {} > slots {}",
         host.address()->asString(), overall_active, weight, host_active, slots);
   }
-  return static_cast<double>(host.stats().rq_active_.value()) / slots;
+  return static_cast<double>(host_active) / slots;
 }
 
 HostConstSharedPtr
@@ -224,8 +247,9 @@ ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost(uint64_t
   //
   // If weights are specified on the hosts, they are respected.
   //
-  // This is an O(N) algorithm, unlike other load balancers. Using a lower `hash_balance_factor`
-  // results in more hosts being probed, so use a higher value if you require better performance.
+  // This is an O(N) algorithm in the worst case, unlike other load balancers, though its cost is
+  // proportional to the number of hosts probed. Using a lower `hash_balance_factor` results in
+  // more hosts being probed, so use a higher value if you require better performance.
 
   if (normalized_host_weights_.empty()) {
     return nullptr;
@@ -249,10 +273,14 @@ ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost(uint64_t
   // next one in the ring. The random sequence is seeded by the hash, so the same input gets the
   // same sequence of hosts all the time.
   const uint32_t num_hosts = normalized_host_weights_.size();
-  auto host_index = std::vector<uint32_t>(num_hosts);
-  for (uint32_t i = 0; i < num_hosts; i++) {
-    host_index[i] = i;
-  }
+  // The shuffle below is done lazily: only the positions which were swapped are stored, and all
+  // other positions hold their own index. This yields the same sequence as shuffling a vector of
+  // all host indices, without paying for one when the first few probed hosts are eligible.
+  absl::flat_hash_map<uint32_t, uint32_t> host_index;
+  const auto host_index_at = [&host_index](uint32_t i) -> uint32_t {
+    const auto it = host_index.find(i);
+    return it != host_index.end() ? it->second : i;
+  };
 
   // Not using Random::RandomGenerator as it does not take a seed. Seeded RNG is a requirement
   // here as we need the same shuffle sequence for the same hash every time.
@@ -273,11 +301,13 @@ ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost(uint64_t
   HostConstSharedPtr alt_host, least_overloaded_host = host;
   double least_overload_factor = overload_factor;
   for (uint32_t i = 0; i < num_hosts; i++) {
-    // The random shuffle algorithm
+    // The random shuffle algorithm. Position i is never read again, so swapping it with position
+    // i + j only needs to store the previous value of position i in i + j.
     const uint32_t j = uniform_int(random, num_hosts - i);
-    std::swap(host_index[i], host_index[i + j]);
+    const uint32_t k = host_index_at(i + j);
+    const uint32_t previous = host_index_at(i);
+    host_index[i + j] = previous;
 
-    const uint32_t k = host_index[i];
     alt_host = normalized_host_weights_[k].first;
     if (alt_host == host) {
       continue;
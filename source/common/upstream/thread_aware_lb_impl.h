@@ -12,6 +12,7 @@
 
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -165,7 +166,9 @@ private:
   virtual HashingLoadBalancerSharedPtr
   createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
                      double min_normalized_weight, double max_normalized_weight) PURE;
-  void refresh();
+  // Publishes a new state to the workers. If updated_priority is set, only the hosts of that
+  // priority changed and the load balancers of the other priorities are reused.
+  void refresh(absl::optional<uint32_t> updated_priority);
 
   std::shared_ptr<LoadBalancerFactoryImpl> factory_;
   const bool locality_weighted_balancing_{};
@@ -63,7 +63,8 @@
 namespace Envoy {
 namespace Upstream {
 namespace {
-std::string addressToString(Network::Address::InstanceConstSharedPtr address) {
+// The returned view is valid for as long as the address is.
+absl::string_view addressToString(const Network::Address::InstanceConstSharedPtr& address) {
   if (!address) {
     return "";
   }
@@ -197,6 +198,11 @@ buildBaseSocketOptions(const envoy::config::cluster::v3::Cluster& cluster_config
                                    Network::SocketOptionFactory::buildTcpKeepaliveOptions(
                                        parseTcpKeepaliveConfig(cluster_config)));
   }
+  if (cluster_config.upstream_connection_options().has_tcp_notsent_lowat()) {
+    const uint32_t lowat = cluster_config.upstream_connection_options().tcp_notsent_lowat().value();
+    Network::Socket::appendOptions(
+        base_options, Network::SocketOptionFactory::buildTcpNotsentLowatOptions(lowat));
+  }
 
   return base_options;
 }
@@ -890,7 +896,7 @@ void MainPrioritySetImpl::updateCrossPriorityHostMap(const HostVector& hosts_add
   }
 
   for (const auto& host : hosts_added) {
-    mutable_cross_priority_host_map_->insert({addressToString(host->address()), host});
+    mutable_cross_priority_host_map_->emplace(addressToString(host->address()), host);
   }
 }
 
@@ -1080,6 +1086,7 @@ ClusterInfoImpl::ClusterInfoImpl(
           config.preconnect_policy(), per_upstream_preconnect_ratio, 1.0)),
       peekahead_ratio_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.preconnect_policy(),
                                                        predictive_preconnect_ratio, 0)),
+      adaptive_preconnect_(config.preconnect_policy().adaptive_preconnect()),
       socket_matcher_(std::move(socket_matcher)), stats_scope_(std::move(stats_scope)),
       traffic_stats_(generateStats(stats_scope_,
                                    factory_context.clusterManager().clusterStatNames(),
@@ -1088,13 +1095,11 @@ ClusterInfoImpl::ClusterInfoImpl(
                            *stats_scope_),
       lb_stats_(factory_context.clusterManager().clusterLbStatNames(), *stats_scope_),
       endpoint_stats_(factory_context.clusterManager().clusterEndpointStatNames(), *stats_scope_),
-      load_report_stats_store_(stats_scope_->symbolTable()),
-      load_report_stats_(
-          generateLoadReportStats(*load_report_stats_store_.rootScope(),
-                                  factory_context.clusterManager().clusterLoadReportStatNames())),
+      load_report_stat_names_(factory_context.clusterManager().clusterLoadReportStatNames()),
       optional_cluster_stats_((config.has_track_cluster_stats() || config.track_timeout_budgets())
                                   ? std::make_unique<OptionalClusterStats>(
-                                        config, *stats_scope_, factory_context.clusterManager())
+                                        config, stats_scope_, factory_context.clusterManager(),
+                                        server_context.statsConfig().enableDeferredCreationStats())
                                   : nullptr),
       features_(ClusterInfoImpl::HttpProtocolOptionsConfigImpl::parseFeatures(
           config, *http_protocol_options_)),
@@ -1833,18 +1838,18 @@ void ClusterImplBase::validateEndpointsForZoneAwareRouting(
 }
 
 ClusterInfoImpl::OptionalClusterStats::OptionalClusterStats(
-    const envoy::config::cluster::v3::Cluster& config, Stats::Scope& stats_scope,
-    const ClusterManager& manager)
-    : timeout_budget_stats_(
-          (config.track_cluster_stats().timeout_budgets() || config.track_timeout_budgets())
-              ? std::make_unique<ClusterTimeoutBudgetStats>(generateTimeoutBudgetStats(
-                    stats_scope, manager.clusterTimeoutBudgetStatNames()))
-              : nullptr),
-      request_response_size_stats_(
-          (config.track_cluster_stats().request_response_sizes()
-               ? std::make_unique<ClusterRequestResponseSizeStats>(generateRequestResponseSizeStats(
-                     stats_scope, manager.clusterRequestResponseSizeStatNames()))
-               : nullptr)) {}
+    const envoy::config::cluster::v3::Cluster& config, Stats::ScopeSharedPtr stats_scope,
+    const ClusterManager& manager, bool defer_creation) {
+  if (config.track_cluster_stats().timeout_budgets() || config.track_timeout_budgets()) {
+    timeout_budget_stats_.emplace(Stats::createDeferredCompatibleStats<ClusterTimeoutBudgetStats>(
+        stats_scope, manager.clusterTimeoutBudgetStatNames(), defer_creation));
+  }
+  if (config.track_cluster_stats().request_response_sizes()) {
+    request_response_size_stats_.emplace(
+        Stats::createDeferredCompatibleStats<ClusterRequestResponseSizeStats>(
+            stats_scope, manager.clusterRequestResponseSizeStatNames(), defer_creation));
+  }
+}
 
 ClusterInfoImpl::ResourceManagers::ResourceManagers(
     const envoy::config::cluster::v3::Cluster& config, Runtime::Loader& runtime,
@@ -2194,21 +2199,26 @@ bool BaseDynamicClusterImpl::updateDynamicHostList(
   // possible for DNS to return the same address multiple times, and a bad EDS implementation
   // could do the same thing.
 
+  // The sets below hold views of the keys of all_hosts and of the addresses of new_hosts, which
+  // outlive this function, so that large updates don't copy every address string a few times.
+  //
   // Keep track of hosts we see in new_hosts that we are able to match up with an existing host.
-  absl::flat_hash_set<std::string> existing_hosts_for_current_priority(
+  absl::flat_hash_set<absl::string_view> existing_hosts_for_current_priority(
       current_priority_hosts.size());
   // Keep track of hosts we're adding (or replacing)
-  absl::flat_hash_set<std::string> new_hosts_for_current_priority(new_hosts.size());
+  absl::flat_hash_set<absl::string_view> new_hosts_for_current_priority(new_hosts.size());
   // Keep track of hosts for which locality is changed.
-  absl::flat_hash_set<std::string> hosts_with_updated_locality_for_current_priority(
+  absl::flat_hash_set<absl::string_view> hosts_with_updated_locality_for_current_priority(
       current_priority_hosts.size());
   // Keep track of hosts for which active health check flag is changed.
-  absl::flat_hash_set<std::string> hosts_with_active_health_check_flag_changed(
+  absl::flat_hash_set<absl::string_view> hosts_with_active_health_check_flag_changed(
       current_priority_hosts.size());
   HostVector final_hosts;
+  final_hosts.reserve(new_hosts.size());
   for (const HostSharedPtr& host : new_hosts) {
     // To match a new host with an existing host means comparing their addresses.
-    auto existing_host = all_hosts.find(addressToString(host->address()));
+    const absl::string_view host_address = addressToString(host->address());
+    auto existing_host = all_hosts.find(host_address);
     const bool existing_host_found = existing_host != all_hosts.end();
 
     // Clear any pending deletion flag on an existing host in case it came back while it was
@@ -2292,7 +2302,7 @@ bool BaseDynamicClusterImpl::updateDynamicHostList(
 
       final_hosts.push_back(existing_host->second);
     } else {
-      new_hosts_for_current_priority.emplace(addressToString(host->address()));
+      new_hosts_for_current_priority.emplace(host_address);
       if (host->weight() > max_host_weight) {
         max_host_weight = host->weight();
       }
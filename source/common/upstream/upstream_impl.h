@@ -870,6 +870,7 @@ public:
   }
 
   float perUpstreamPreconnectRatio() const override { return per_upstream_preconnect_ratio_; }
+  bool adaptivePreconnect() const override { return adaptive_preconnect_; }
   float peekaheadRatio() const override { return peekahead_ratio_; }
   uint32_t perConnectionBufferLimitBytes() const override {
     return per_connection_buffer_limit_bytes_;
@@ -969,22 +970,28 @@ public:
 
   ClusterRequestResponseSizeStatsOptRef requestResponseSizeStats() const override {
     if (optional_cluster_stats_ == nullptr ||
-        optional_cluster_stats_->request_response_size_stats_ == nullptr) {
+        !optional_cluster_stats_->request_response_size_stats_.has_value()) {
       return absl::nullopt;
     }
 
-    return std::ref(*(optional_cluster_stats_->request_response_size_stats_));
+    return std::ref(**(optional_cluster_stats_->request_response_size_stats_));
   }
 
-  ClusterLoadReportStats& loadReportStats() const override { return load_report_stats_; }
+  ClusterLoadReportStats& loadReportStats() const override {
+    return load_report_stats_
+        .get([this] {
+          return new LoadReportStats(stats_scope_->symbolTable(), load_report_stat_names_);
+        })
+        ->stats_;
+  }
 
   ClusterTimeoutBudgetStatsOptRef timeoutBudgetStats() const override {
     if (optional_cluster_stats_ == nullptr ||
-        optional_cluster_stats_->timeout_budget_stats_ == nullptr) {
+        !optional_cluster_stats_->timeout_budget_stats_.has_value()) {
       return absl::nullopt;
     }
 
-    return std::ref(*(optional_cluster_stats_->timeout_budget_stats_));
+    return std::ref(**(optional_cluster_stats_->timeout_budget_stats_));
   }
 
   bool perEndpointStatsEnabled() const override { return per_endpoint_stats_; }
@@ -1091,11 +1098,16 @@ private:
     const ClusterCircuitBreakersStatNames& circuit_breakers_stat_names_;
   };
 
+  // Like the traffic stats, these are only instantiated on first use when deferred creation of
+  // stats is enabled.
   struct OptionalClusterStats {
     OptionalClusterStats(const envoy::config::cluster::v3::Cluster& config,
-                         Stats::Scope& stats_scope, const ClusterManager& manager);
-    const ClusterTimeoutBudgetStatsPtr timeout_budget_stats_;
-    const ClusterRequestResponseSizeStatsPtr request_response_size_stats_;
+                         Stats::ScopeSharedPtr stats_scope, const ClusterManager& manager,
+                         bool defer_creation);
+    absl::optional<Stats::DeferredCreationCompatibleStats<ClusterTimeoutBudgetStats>>
+        timeout_budget_stats_;
+    absl::optional<Stats::DeferredCreationCompatibleStats<ClusterRequestResponseSizeStats>>
+        request_response_size_stats_;
   };
 
 #ifdef ENVOY_ENABLE_UHV
@@ -1115,14 +1127,26 @@ private:
   OptionalTimeouts optional_timeouts_;
   const float per_upstream_preconnect_ratio_;
   const float peekahead_ratio_;
+  const bool adaptive_preconnect_;
   TransportSocketMatcherPtr socket_matcher_;
   Stats::ScopeSharedPtr stats_scope_;
   mutable DeferredCreationCompatibleClusterTrafficStats traffic_stats_;
   mutable ClusterConfigUpdateStats config_update_stats_;
   mutable ClusterLbStats lb_stats_;
   mutable ClusterEndpointStats endpoint_stats_;
-  Stats::IsolatedStoreImpl load_report_stats_store_;
-  mutable ClusterLoadReportStats load_report_stats_;
+  // The load report stats are kept in a store of their own, which is only created on first use as
+  // most clusters neither report load nor drop requests.
+  struct LoadReportStats {
+    LoadReportStats(Stats::SymbolTable& symbol_table,
+                    const ClusterLoadReportStatNames& stat_names)
+        : store_(symbol_table), stats_(generateLoadReportStats(*store_.rootScope(), stat_names)) {}
+
+    Stats::IsolatedStoreImpl store_;
+    ClusterLoadReportStats stats_;
+  };
+  const ClusterLoadReportStatNames& load_report_stat_names_;
+  mutable Thread::AtomicPtr<LoadReportStats, Thread::AtomicPtrAllocMode::DeleteOnDestruct>
+      load_report_stats_;
   const std::unique_ptr<OptionalClusterStats> optional_cluster_stats_;
   const uint64_t features_;
   mutable ResourceManagers resource_managers_;
@@ -10,13 +10,16 @@
 #include "envoy/thread_local/thread_local.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/thread.h"
 #include "source/common/grpc/typed_async_client.h"
 #include "source/common/http/utility.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/tracing/null_span_impl.h"
 #include "source/extensions/access_loggers/common/grpc_access_logger_utils.h"
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -221,6 +224,49 @@ template <typename HttpLogProto, typename TcpLogProto, typename LogRequest, type
 class GrpcAccessLogger : public Detail::GrpcAccessLogger<HttpLogProto, TcpLogProto> {
 public:
   using Interface = Detail::GrpcAccessLogger<HttpLogProto, TcpLogProto>;
+
+  /**
+   * A gRPC stream shared by the loggers of all threads for the same configuration. The stream
+   * belongs to the logger of the main thread, and the other loggers move their batches to the main
+   * thread to be sent on it.
+   */
+  class SharedStream {
+  public:
+    /**
+     * Called on the main thread with the logger that owns the stream.
+     */
+    void setOwner(Event::Dispatcher& dispatcher, std::weak_ptr<GrpcAccessLogger> owner) {
+      absl::MutexLock lock(&mutex_);
+      dispatcher_ = &dispatcher;
+      owner_ = std::move(owner);
+    }
+
+    /**
+     * Sends a batch on the stream from any thread.
+     * @param batch supplies the batch to send.
+     * @param entries supplies the number of log entries in the batch.
+     * @return false if the stream has no owner yet, in which case the batch is not sent.
+     */
+    bool send(const LogRequest& batch, uint64_t entries) {
+      absl::MutexLock lock(&mutex_);
+      if (dispatcher_ == nullptr) {
+        return false;
+      }
+      dispatcher_->post([owner = owner_, batch, entries]() mutable {
+        if (auto logger = owner.lock()) {
+          logger->receiveBatch(std::move(batch), entries);
+        }
+      });
+      return true;
+    }
+
+  private:
+    absl::Mutex mutex_;
+    Event::Dispatcher* dispatcher_ ABSL_GUARDED_BY(mutex_){};
+    std::weak_ptr<GrpcAccessLogger> owner_ ABSL_GUARDED_BY(mutex_);
+  };
+  using SharedStreamSharedPtr = std::shared_ptr<SharedStream>;
+
   GrpcAccessLogger(
       const Grpc::RawAsyncClientSharedPtr& client,
       const envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig& config,
@@ -233,6 +279,7 @@ public:
           flush_timer_->enableTimer(buffer_flush_interval_msec_);
         })),
         max_buffer_size_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, buffer_size_bytes, 16384)),
+        share_stream_(config.share_stream_between_workers()),
         stats_({ALL_GRPC_ACCESS_LOGGER_STATS(POOL_COUNTER_PREFIX(scope, access_log_prefix))}) {
     if (stream) {
       client_ = std::make_unique<Detail::StreamingGrpcAccessLogClient<LogRequest, LogResponse>>(
@@ -249,6 +296,7 @@ public:
       return;
     }
     approximate_message_size_bytes_ += entry.ByteSizeLong();
+    ++batch_entries_;
     addEntry(std::move(entry));
     if (approximate_message_size_bytes_ >= max_buffer_size_bytes_) {
       flush();
@@ -257,12 +305,26 @@ public:
 
   void log(TcpLogProto&& entry) override {
     approximate_message_size_bytes_ += entry.ByteSizeLong();
+    ++batch_entries_;
     addEntry(std::move(entry));
     if (approximate_message_size_bytes_ >= max_buffer_size_bytes_) {
       flush();
     }
   }
 
+  /**
+   * @return whether the configuration asks for one gRPC stream shared by all threads.
+   */
+  bool sharesStream() const { return share_stream_; }
+
+  /**
+   * Makes this logger send its batches on a stream owned by the logger of another thread.
+   * @param shared_stream supplies the stream.
+   */
+  void setSharedStream(SharedStreamSharedPtr shared_stream) {
+    shared_stream_ = std::move(shared_stream);
+  }
+
 protected:
   std::unique_ptr<Detail::GrpcAccessLogClient<LogRequest, LogResponse>> client_;
   LogRequest message_;
@@ -273,6 +335,24 @@ private:
   virtual void addEntry(HttpLogProto&& entry) PURE;
   virtual void addEntry(TcpLogProto&& entry) PURE;
   virtual void clearMessage() { message_.Clear(); }
+  // Adds the entries of a batch that another thread sent on the shared stream.
+  virtual void mergeBatch(LogRequest&& batch) { message_.MergeFrom(batch); }
+
+  // Called on the thread of the logger that owns the shared stream.
+  void receiveBatch(LogRequest&& batch, uint64_t entries) {
+    if (max_buffer_size_bytes_ != 0 && approximate_message_size_bytes_ >= max_buffer_size_bytes_) {
+      flush();
+      if (approximate_message_size_bytes_ >= max_buffer_size_bytes_) {
+        stats_.logs_dropped_.add(entries);
+        return;
+      }
+    }
+    approximate_message_size_bytes_ += batch.ByteSizeLong();
+    mergeBatch(std::move(batch));
+    if (approximate_message_size_bytes_ >= max_buffer_size_bytes_) {
+      flush();
+    }
+  }
 
   void flush() {
     if (isEmpty()) {
@@ -280,6 +360,16 @@ private:
       return;
     }
 
+    if (shared_stream_ != nullptr) {
+      // The owner of the stream adds the identifier when the batch starts a new stream.
+      if (shared_stream_->send(message_, batch_entries_)) {
+        approximate_message_size_bytes_ = 0;
+        batch_entries_ = 0;
+        clearMessage();
+      }
+      return;
+    }
+
     if (!client_->isConnected()) {
       initMessage();
     }
@@ -287,6 +377,7 @@ private:
     if (client_->log(message_)) {
       // Clear the message regardless of the success.
       approximate_message_size_bytes_ = 0;
+      batch_entries_ = 0;
       clearMessage();
     }
   }
@@ -309,6 +400,10 @@ private:
   const Event::TimerPtr flush_timer_;
   const uint64_t max_buffer_size_bytes_;
   uint64_t approximate_message_size_bytes_ = 0;
+  // The number of entries in message_.
+  uint64_t batch_entries_ = 0;
+  const bool share_stream_;
+  SharedStreamSharedPtr shared_stream_;
   GrpcAccessLoggerStats stats_;
 };
 
@@ -341,6 +436,14 @@ public:
     }
 
     const auto logger = createLogger(config, cache.dispatcher_);
+    if (logger->sharesStream()) {
+      auto shared_stream = getOrCreateSharedStream(cache_key);
+      if (Thread::MainThread::isMainOrTestThread()) {
+        shared_stream->setOwner(cache.dispatcher_, logger);
+      } else {
+        logger->setSharedStream(std::move(shared_stream));
+      }
+    }
     cache.access_loggers_.emplace(cache_key, logger);
     return logger;
   }
@@ -363,11 +466,27 @@ private:
         access_loggers_;
   };
 
+  using CacheKey = std::pair<std::size_t, Common::GrpcAccessLoggerType>;
+  using SharedStreamSharedPtr = typename GrpcAccessLogger::SharedStreamSharedPtr;
+
   // Create the specific logger type for this cache.
   virtual typename GrpcAccessLogger::SharedPtr createLogger(const ConfigProto& config,
                                                             Event::Dispatcher& dispatcher) PURE;
 
+  SharedStreamSharedPtr getOrCreateSharedStream(const CacheKey& cache_key) {
+    absl::MutexLock lock(&shared_streams_mutex_);
+    SharedStreamSharedPtr& shared_stream = shared_streams_[cache_key];
+    if (shared_stream == nullptr) {
+      shared_stream = std::make_shared<typename GrpcAccessLogger::SharedStream>();
+    }
+    return shared_stream;
+  }
+
   ThreadLocal::SlotPtr tls_slot_;
+  absl::Mutex shared_streams_mutex_;
+  // Shared streams indexed like the loggers of the per-thread caches.
+  absl::flat_hash_map<CacheKey, SharedStreamSharedPtr>
+      shared_streams_ ABSL_GUARDED_BY(shared_streams_mutex_);
 };
 
 } // namespace Common
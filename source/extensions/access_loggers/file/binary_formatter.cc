@@ -0,0 +1,48 @@
+#include "source/extensions/access_loggers/file/binary_formatter.h"
+
+#include "envoy/data/accesslog/v3/accesslog.pb.h"
+
+#include "source/common/protobuf/protobuf.h"
+#include "source/extensions/access_loggers/grpc/grpc_access_log_utils.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace File {
+
+BinaryFormatter::BinaryFormatter(
+    const envoy::extensions::access_loggers::file::v3::FileAccessLog::BinaryFormat& config) {
+  for (const auto& header : config.additional_request_headers_to_log()) {
+    request_headers_to_log_.emplace_back(header);
+  }
+  for (const auto& header : config.additional_response_headers_to_log()) {
+    response_headers_to_log_.emplace_back(header);
+  }
+  for (const auto& header : config.additional_response_trailers_to_log()) {
+    response_trailers_to_log_.emplace_back(header);
+  }
+  *common_config_.mutable_filter_state_objects_to_log() = config.filter_state_objects_to_log();
+}
+
+std::string
+BinaryFormatter::formatWithContext(const Formatter::HttpFormatterContext& context,
+                                   const StreamInfo::StreamInfo& stream_info) const {
+  envoy::data::accesslog::v3::HTTPAccessLogEntry log_entry;
+  GrpcCommon::Utility::extractHttpAccessLogEntry(log_entry, context, stream_info, common_config_,
+                                                 request_headers_to_log_, response_headers_to_log_,
+                                                 response_trailers_to_log_);
+
+  std::string output;
+  {
+    Protobuf::io::StringOutputStream stream(&output);
+    Protobuf::io::CodedOutputStream coded_stream(&stream);
+    coded_stream.WriteVarint32(log_entry.ByteSizeLong());
+    log_entry.SerializeWithCachedSizes(&coded_stream);
+  }
+  return output;
+}
+
+} // namespace File
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/access_loggers/file/v3/file.pb.h"
+#include "envoy/extensions/access_loggers/grpc/v3/als.pb.h"
+#include "envoy/formatter/substitution_formatter.h"
+#include "envoy/http/header_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace File {
+
+/**
+ * Formats each log entry as a serialized envoy.data.accesslog.v3.HTTPAccessLogEntry, prefixed with
+ * its length as a varint. The entry is filled in the same way as by the HTTP gRPC access log.
+ */
+class BinaryFormatter : public Formatter::Formatter {
+public:
+  explicit BinaryFormatter(
+      const envoy::extensions::access_loggers::file::v3::FileAccessLog::BinaryFormat& config);
+
+  // Formatter::Formatter
+  std::string formatWithContext(const Formatter::HttpFormatterContext& context,
+                                const StreamInfo::StreamInfo& stream_info) const override;
+
+private:
+  envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig common_config_;
+  std::vector<Http::LowerCaseString> request_headers_to_log_;
+  std::vector<Http::LowerCaseString> response_headers_to_log_;
+  std::vector<Http::LowerCaseString> response_trailers_to_log_;
+};
+
+} // namespace File
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -13,6 +13,7 @@
 #include "source/common/formatter/substitution_formatter.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/extensions/access_loggers/common/file_access_log_impl.h"
+#include "source/extensions/access_loggers/file/binary_formatter.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -53,6 +54,10 @@ FileAccessLogFactory::createAccessLogInstance(const Protobuf::Message& config,
     formatter =
         Formatter::SubstitutionFormatStringUtils::fromProtoConfig(fal_config.log_format(), context);
     break;
+  case envoy::extensions::access_loggers::file::v3::FileAccessLog::AccessLogFormatCase::
+      kBinaryFormat:
+    formatter = std::make_unique<BinaryFormatter>(fal_config.binary_format());
+    break;
   case envoy::extensions::access_loggers::file::v3::FileAccessLog::AccessLogFormatCase::
       ACCESS_LOG_FORMAT_NOT_SET:
     formatter = Formatter::HttpSubstitutionFormatUtils::defaultSubstitutionFormatter();
@@ -0,0 +1,91 @@
+#include "source/extensions/access_loggers/filters/adaptive_sampling/adaptive_sampling.h"
+
+#include <algorithm>
+
+#include "source/common/common/interval_value.h"
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Filters {
+namespace AdaptiveSampling {
+
+namespace {
+constexpr std::chrono::seconds SamplingWindow{1};
+} // namespace
+
+AdaptiveSamplingFilter::ThreadLocalSampler::ThreadLocalSampler(uint32_t max_sampled_per_second,
+                                                               TimeSource& time_source)
+    : max_sampled_per_second_(max_sampled_per_second), time_source_(time_source),
+      token_bucket_(max_sampled_per_second, time_source, max_sampled_per_second),
+      window_start_(time_source.monotonicTime()) {}
+
+bool AdaptiveSamplingFilter::ThreadLocalSampler::sample(Random::RandomGenerator& random) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  const auto elapsed = now - window_start_;
+  if (elapsed >= SamplingWindow) {
+    // Spread the next window's entries over all of its requests, assuming that it sees as many
+    // requests per second as the window that just ended.
+    const double requests_per_second =
+        window_requests_ / std::chrono::duration<double>(elapsed).count();
+    probability_ = requests_per_second > max_sampled_per_second_
+                       ? static_cast<float>(max_sampled_per_second_ / requests_per_second)
+                       : 1.0f;
+    window_start_ = now;
+    window_requests_ = 0;
+  }
+  ++window_requests_;
+
+  // The token bucket keeps the limit while the traffic grows faster than the probability adapts.
+  return random.bernoulli(UnitFloat(probability_)) && token_bucket_.consume(1, false) == 1;
+}
+
+AdaptiveSamplingFilter::AdaptiveSamplingFilter(
+    const envoy::extensions::access_loggers::filters::adaptive_sampling::v3::AdaptiveSamplingFilter&
+        config,
+    Stats::Scope& scope, ThreadLocal::SlotAllocator& tls, TimeSource& time_source,
+    Random::RandomGenerator& random)
+    : error_status_threshold_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, error_status_threshold, 500)),
+      slow_request_threshold_(PROTOBUF_GET_OPTIONAL_MS(config, slow_request_threshold)),
+      stats_({ADAPTIVE_SAMPLING_STATS(
+          POOL_COUNTER_PREFIX(scope, "access_logs.adaptive_sampling." + config.stat_prefix()))}),
+      random_(random), tls_slot_(ThreadLocal::TypedSlot<ThreadLocalSampler>::makeUnique(tls)) {
+  tls_slot_->set([max_sampled_per_second = config.max_sampled_entries_per_second(),
+                  &time_source](Event::Dispatcher&) {
+    return std::make_shared<ThreadLocalSampler>(max_sampled_per_second, time_source);
+  });
+}
+
+bool AdaptiveSamplingFilter::alwaysLog(const StreamInfo::StreamInfo& stream_info) const {
+  if (!stream_info.responseCode().has_value() ||
+      stream_info.responseCode().value() >= error_status_threshold_ ||
+      stream_info.hasAnyResponseFlag()) {
+    return true;
+  }
+  if (slow_request_threshold_.has_value()) {
+    const absl::optional<std::chrono::nanoseconds> duration = stream_info.currentDuration();
+    return duration.has_value() && duration.value() >= slow_request_threshold_.value();
+  }
+  return false;
+}
+
+bool AdaptiveSamplingFilter::evaluate(const Formatter::HttpFormatterContext&,
+                                      const StreamInfo::StreamInfo& stream_info) const {
+  if (alwaysLog(stream_info)) {
+    stats_.always_logged_.inc();
+    return true;
+  }
+  if ((*tls_slot_)->sample(random_)) {
+    stats_.sampled_.inc();
+    return true;
+  }
+  stats_.not_sampled_.inc();
+  return false;
+}
+
+} // namespace AdaptiveSampling
+} // namespace Filters
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
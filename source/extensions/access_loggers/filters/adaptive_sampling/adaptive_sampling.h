@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+
+#include "envoy/access_log/access_log.h"
+#include "envoy/common/random_generator.h"
+#include "envoy/common/time.h"
+#include "envoy/extensions/access_loggers/filters/adaptive_sampling/v3/adaptive_sampling.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/stream_info/stream_info.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/token_bucket_impl.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Filters {
+namespace AdaptiveSampling {
+
+#define ADAPTIVE_SAMPLING_STATS(COUNTER)                                                           \
+  COUNTER(always_logged)                                                                           \
+  COUNTER(sampled)                                                                                 \
+  COUNTER(not_sampled)
+
+struct AdaptiveSamplingStats {
+  ADAPTIVE_SAMPLING_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Access log filter that always passes failed and slow requests and passes a bounded, evenly spread
+ * sample of the other requests on each worker.
+ */
+class AdaptiveSamplingFilter : public AccessLog::Filter {
+public:
+  AdaptiveSamplingFilter(
+      const envoy::extensions::access_loggers::filters::adaptive_sampling::v3::
+          AdaptiveSamplingFilter& config,
+      Stats::Scope& scope, ThreadLocal::SlotAllocator& tls, TimeSource& time_source,
+      Random::RandomGenerator& random);
+
+  // AccessLog::Filter
+  bool evaluate(const Formatter::HttpFormatterContext& context,
+                const StreamInfo::StreamInfo& stream_info) const override;
+
+private:
+  // The sampling state of a worker.
+  struct ThreadLocalSampler : public ThreadLocal::ThreadLocalObject {
+    ThreadLocalSampler(uint32_t max_sampled_per_second, TimeSource& time_source);
+
+    // Decides whether to log a request that neither failed nor was slow.
+    bool sample(Random::RandomGenerator& random);
+
+    const uint32_t max_sampled_per_second_;
+    TimeSource& time_source_;
+    TokenBucketImpl token_bucket_;
+    MonotonicTime window_start_;
+    // The requests seen since window_start_.
+    uint64_t window_requests_{0};
+    // The probability of logging a request, as set at the start of the current window.
+    float probability_{1.0f};
+  };
+
+  bool alwaysLog(const StreamInfo::StreamInfo& stream_info) const;
+
+  const uint32_t error_status_threshold_;
+  const absl::optional<std::chrono::milliseconds> slow_request_threshold_;
+  AdaptiveSamplingStats stats_;
+  Random::RandomGenerator& random_;
+  ThreadLocal::TypedSlotPtr<ThreadLocalSampler> tls_slot_;
+};
+
+} // namespace AdaptiveSampling
+} // namespace Filters
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
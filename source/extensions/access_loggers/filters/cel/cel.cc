@@ -12,7 +12,7 @@ CELAccessLogExtensionFilter::CELAccessLogExtensionFilter(
     const ::Envoy::LocalInfo::LocalInfo& local_info, Expr::BuilderInstanceSharedPtr builder,
     const google::api::expr::v1alpha1::Expr& input_expr)
     : local_info_(local_info), builder_(builder), parsed_expr_(input_expr) {
-  compiled_expr_ = Expr::createExpression(builder_->builder(), parsed_expr_);
+  compiled_expr_ = builder_->createSharedExpression(parsed_expr_);
 }
 
 bool CELAccessLogExtensionFilter::evaluate(const Formatter::HttpFormatterContext& log_context,
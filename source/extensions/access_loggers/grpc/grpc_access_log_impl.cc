@@ -32,6 +32,16 @@ void GrpcAccessLoggerImpl::addEntry(envoy::data::accesslog::v3::TCPAccessLogEntr
   message_.mutable_tcp_logs()->mutable_log_entry()->Add(std::move(entry));
 }
 
+void GrpcAccessLoggerImpl::mergeBatch(
+    envoy::service::accesslog::v3::StreamAccessLogsMessage&& batch) {
+  for (auto& entry : *batch.mutable_http_logs()->mutable_log_entry()) {
+    addEntry(std::move(entry));
+  }
+  for (auto& entry : *batch.mutable_tcp_logs()->mutable_log_entry()) {
+    addEntry(std::move(entry));
+  }
+}
+
 bool GrpcAccessLoggerImpl::isEmpty() {
   return !message_.has_http_logs() && !message_.has_tcp_logs();
 }
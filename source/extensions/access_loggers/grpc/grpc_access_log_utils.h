@@ -1,8 +1,12 @@
 #pragma once
 
+#include <vector>
+
 #include "envoy/access_log/access_log.h"
 #include "envoy/data/accesslog/v3/accesslog.pb.h"
 #include "envoy/extensions/access_loggers/grpc/v3/als.pb.h"
+#include "envoy/formatter/http_formatter_context.h"
+#include "envoy/http/header_map.h"
 #include "envoy/stream_info/stream_info.h"
 
 namespace Envoy {
@@ -19,6 +23,16 @@ public:
           filter_states_to_log,
       AccessLog::AccessLogType access_log_type);
 
+  // Fills in the common, request and response properties of an HTTP log entry, including the
+  // values of the given headers and trailers.
+  static void extractHttpAccessLogEntry(
+      envoy::data::accesslog::v3::HTTPAccessLogEntry& log_entry,
+      const Formatter::HttpFormatterContext& context, const StreamInfo::StreamInfo& stream_info,
+      const envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig& config,
+      const std::vector<Http::LowerCaseString>& request_headers_to_log,
+      const std::vector<Http::LowerCaseString>& response_headers_to_log,
+      const std::vector<Http::LowerCaseString>& response_trailers_to_log);
+
   static void responseFlagsToAccessLogResponseFlags(
       envoy::data::accesslog::v3::AccessLogCommon& common_access_log,
       const StreamInfo::StreamInfo& stream_info);
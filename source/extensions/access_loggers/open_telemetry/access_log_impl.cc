@@ -42,9 +42,9 @@ packBody(const ::opentelemetry::proto::common::v1::AnyValue& body) {
 }
 
 ::opentelemetry::proto::common::v1::AnyValue
-unpackBody(const ::opentelemetry::proto::common::v1::KeyValueList& value) {
+unpackBody(::opentelemetry::proto::common::v1::KeyValueList&& value) {
   ASSERT(value.values().size() == 1 && value.values(0).key() == BODY_KEY);
-  return value.values(0).value();
+  return std::move(*value.mutable_values(0)->mutable_value());
 }
 
 } // namespace
@@ -83,13 +83,13 @@ void AccessLog::emitLog(const Formatter::HttpFormatterContext& log_context,
                                    stream_info.startTime().time_since_epoch())
                                    .count());
 
-  // Unpacking the body "KeyValueList" to "AnyValue".
+  // Unpacking the body "KeyValueList" to "AnyValue". The formatted values are moved into the
+  // entry rather than copied.
   if (body_formatter_) {
-    const auto formatted_body = unpackBody(body_formatter_->format(log_context, stream_info));
-    *log_entry.mutable_body() = formatted_body;
+    *log_entry.mutable_body() = unpackBody(body_formatter_->format(log_context, stream_info));
   }
-  const auto formatted_attributes = attributes_formatter_->format(log_context, stream_info);
-  *log_entry.mutable_attributes() = formatted_attributes.values();
+  auto formatted_attributes = attributes_formatter_->format(log_context, stream_info);
+  log_entry.mutable_attributes()->Swap(formatted_attributes.mutable_values());
 
   tls_slot_->getTyped<ThreadLocalLogger>().logger_->log(std::move(log_entry));
 }
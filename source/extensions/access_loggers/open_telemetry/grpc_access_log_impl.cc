@@ -75,6 +75,19 @@ void GrpcAccessLoggerImpl::initMessage() {}
 
 void GrpcAccessLoggerImpl::clearMessage() { root_->clear_log_records(); }
 
+// Batches from other threads have the same structure and resource, so only their records are
+// added.
+void GrpcAccessLoggerImpl::mergeBatch(
+    opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest&& batch) {
+  for (auto& resource_logs : *batch.mutable_resource_logs()) {
+    for (auto& scope_logs : *resource_logs.mutable_scope_logs()) {
+      for (auto& record : *scope_logs.mutable_log_records()) {
+        addEntry(std::move(record));
+      }
+    }
+  }
+}
+
 GrpcAccessLoggerCacheImpl::GrpcAccessLoggerCacheImpl(Grpc::AsyncClientManager& async_client_manager,
                                                      Stats::Scope& scope,
                                                      ThreadLocal::SlotAllocator& tls,
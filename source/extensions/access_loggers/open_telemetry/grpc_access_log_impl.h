@@ -54,6 +54,8 @@ private:
   bool isEmpty() override;
   void initMessage() override;
   void clearMessage() override;
+  void
+  mergeBatch(opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest&& batch) override;
 
   opentelemetry::proto::logs::v1::ScopeLogs* root_;
 };
@@ -35,8 +35,7 @@ WasmAccessLogFactory::createAccessLogInstance(const Protobuf::Message& proto_con
     auto tls_slot = ThreadLocal::TypedSlot<PluginHandleSharedPtrThreadLocal>::makeUnique(
         context.serverFactoryContext().threadLocal());
     tls_slot->set([base_wasm, plugin](Event::Dispatcher& dispatcher) {
-      return std::make_shared<PluginHandleSharedPtrThreadLocal>(
-          Common::Wasm::getOrCreateThreadLocalPlugin(base_wasm, plugin, dispatcher));
+      return Common::Wasm::createThreadLocalPluginHandle(base_wasm, plugin, dispatcher);
     });
     access_log->setTlsSlot(std::move(tls_slot));
   };
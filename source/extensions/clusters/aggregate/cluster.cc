@@ -43,16 +43,54 @@ AggregateClusterLoadBalancer::AggregateClusterLoadBalancer(
 
 void AggregateClusterLoadBalancer::addMemberUpdateCallbackForCluster(
     Upstream::ThreadLocalCluster& thread_local_cluster) {
+  // Priority updates are run for each updated priority before the member update.
+  priority_update_cbs_[thread_local_cluster.info()->name()] =
+      thread_local_cluster.prioritySet().addPriorityUpdateCb(
+          [this, &priority_set = thread_local_cluster.prioritySet(),
+           target_cluster_info = thread_local_cluster.info()](
+              uint32_t priority, const Upstream::HostVector& hosts_added,
+              const Upstream::HostVector& hosts_removed) {
+            onPriorityUpdate(priority_set, target_cluster_info->name(), priority, hosts_added,
+                             hosts_removed);
+          });
   member_update_cbs_[thread_local_cluster.info()->name()] =
       thread_local_cluster.prioritySet().addMemberUpdateCb(
           [this, target_cluster_info = thread_local_cluster.info()](const Upstream::HostVector&,
                                                                     const Upstream::HostVector&) {
             ENVOY_LOG(debug, "member update for cluster '{}' in aggregate cluster '{}'",
                       target_cluster_info->name(), parent_info_->name());
-            refresh();
+            if (refresh_pending_) {
+              refresh();
+            }
           });
 }
 
+void AggregateClusterLoadBalancer::onPriorityUpdate(const Upstream::PrioritySet& priority_set,
+                                                    absl::string_view cluster, uint32_t priority,
+                                                    const Upstream::HostVector& hosts_added,
+                                                    const Upstream::HostVector& hosts_removed) {
+  if (refresh_pending_) {
+    return;
+  }
+  const Upstream::HostSet& host_set = *priority_set.hostSetsPerPriority()[priority];
+  const auto it = priority_context_->cluster_and_priority_to_linearized_priority_.find(
+      std::make_pair(cluster, priority));
+  if (it == priority_context_->cluster_and_priority_to_linearized_priority_.end()) {
+    // A priority without hosts is left out of the linearized priorities.
+    refresh_pending_ = !host_set.hosts().empty();
+    return;
+  }
+  if (host_set.hosts().empty()) {
+    refresh_pending_ = true;
+    return;
+  }
+  // The load balancer recomputes the priority loads from the updated host set.
+  priority_context_->priority_set_.updateHosts(
+      it->second, Upstream::HostSetImpl::updateHostsParams(host_set), host_set.localityWeights(),
+      hosts_added, hosts_removed, random_.random(), host_set.weightedPriorityHealth(),
+      host_set.overprovisioningFactor());
+}
+
 PriorityContextPtr
 AggregateClusterLoadBalancer::linearizePrioritySet(OptRef<const std::string> excluded_cluster) {
   PriorityContextPtr priority_context = std::make_unique<PriorityContext>();
@@ -92,7 +130,8 @@ AggregateClusterLoadBalancer::linearizePrioritySet(OptRef<const std::string> exc
             std::make_pair(priority_in_current_cluster, tlc));
 
         priority_context->cluster_and_priority_to_linearized_priority_[std::make_pair(
-            cluster, priority_in_current_cluster)] = next_priority_after_linearizing;
+            absl::string_view(cluster), priority_in_current_cluster)] =
+            next_priority_after_linearizing;
         next_priority_after_linearizing++;
       }
       priority_in_current_cluster++;
@@ -103,6 +142,7 @@ AggregateClusterLoadBalancer::linearizePrioritySet(OptRef<const std::string> exc
 }
 
 void AggregateClusterLoadBalancer::refresh(OptRef<const std::string> excluded_cluster) {
+  refresh_pending_ = false;
   PriorityContextPtr priority_context = linearizePrioritySet(excluded_cluster);
   if (!priority_context->priority_set_.hostSetsPerPriority().empty()) {
     load_balancer_ = std::make_unique<LoadBalancerImpl>(
@@ -138,7 +178,7 @@ void AggregateClusterLoadBalancer::onClusterRemoval(const std::string& cluster_n
 absl::optional<uint32_t> AggregateClusterLoadBalancer::LoadBalancerImpl::hostToLinearizedPriority(
     const Upstream::HostDescription& host) const {
   auto it = priority_context_.cluster_and_priority_to_linearized_priority_.find(
-      std::make_pair(host.cluster().name(), host.priority()));
+      std::make_pair(absl::string_view(host.cluster().name()), host.priority()));
 
   if (it != priority_context_.cluster_and_priority_to_linearized_priority_.end()) {
     return it->second;
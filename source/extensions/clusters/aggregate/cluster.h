@@ -21,8 +21,9 @@ namespace Aggregate {
 using PriorityToClusterVector = std::vector<std::pair<uint32_t, Upstream::ThreadLocalCluster*>>;
 
 // Maps pair(host_cluster_name, host_priority) to the linearized priority of the Aggregate cluster.
+// The cluster names are owned by the ClusterSet of the aggregate cluster.
 using ClusterAndPriorityToLinearizedPriorityMap =
-    absl::flat_hash_map<std::pair<std::string, uint32_t>, uint32_t>;
+    absl::flat_hash_map<std::pair<absl::string_view, uint32_t>, uint32_t>;
 
 struct PriorityContext {
   Upstream::PrioritySetImpl priority_set_;
@@ -121,6 +122,11 @@ private:
   using LoadBalancerImplPtr = std::unique_ptr<LoadBalancerImpl>;
 
   void addMemberUpdateCallbackForCluster(Upstream::ThreadLocalCluster& thread_local_cluster);
+  // Updates the linearized priority of a priority of an included cluster in place, if there is
+  // one and it still has hosts. Otherwise the load balancer is refreshed after the member update.
+  void onPriorityUpdate(const Upstream::PrioritySet& priority_set, absl::string_view cluster,
+                        uint32_t priority, const Upstream::HostVector& hosts_added,
+                        const Upstream::HostVector& hosts_removed);
   PriorityContextPtr linearizePrioritySet(OptRef<const std::string> excluded_cluster);
   void refresh(OptRef<const std::string> excluded_cluster = OptRef<const std::string>());
 
@@ -133,6 +139,9 @@ private:
   const ClusterSetConstSharedPtr clusters_;
   Upstream::ClusterUpdateCallbacksHandlePtr handle_;
   absl::flat_hash_map<std::string, Envoy::Common::CallbackHandlePtr> member_update_cbs_;
+  absl::flat_hash_map<std::string, Envoy::Common::CallbackHandlePtr> priority_update_cbs_;
+  // Whether a member update of an included cluster changed which of its priorities have hosts.
+  bool refresh_pending_{};
 };
 
 // Load balancer factory created by the main thread and will be called in each worker thread to
@@ -59,13 +59,20 @@ HostConstSharedPtr OriginalDstCluster::LoadBalancer::chooseHost(LoadBalancerCont
     if (dst_host) {
       const Network::Address::Instance& dst_addr = *dst_host.get();
       // Check if a host with the destination address is already in the host set.
-      auto it = host_map_->find(dst_addr.asString());
+      const std::string& address = dst_addr.asString();
+      auto it = host_map_->find(address);
       if (it != host_map_->end()) {
         HostConstSharedPtr host = it->second->host_;
         ENVOY_LOG(trace, "Using existing host {} {}.", *host, host->address()->asString());
         it->second->used_ = true;
         return host;
       }
+      // Check if this load balancer already added a host which is not in the host map yet.
+      auto added_it = added_hosts_.find(address);
+      if (added_it != added_hosts_.end()) {
+        ENVOY_LOG(trace, "Using added host {} {}.", *added_it->second, address);
+        return added_it->second;
+      }
       // Add a new host
       const Network::Address::Ip* dst_ip = dst_addr.ip();
       if (dst_ip) {
@@ -79,6 +86,7 @@ HostConstSharedPtr OriginalDstCluster::LoadBalancer::chooseHost(LoadBalancerCont
             envoy::config::endpoint::v3::Endpoint::HealthCheckConfig().default_instance(), 0,
             envoy::config::core::v3::UNKNOWN, parent_->cluster_->time_source_));
         ENVOY_LOG(debug, "Created host {} {}.", *host, host->address()->asString());
+        added_hosts_.emplace(address, host);
 
         // Tell the cluster about the new host
         // lambda cannot capture a member by value.
@@ -84,7 +84,9 @@ public:
    * add hosts on demand. Additions are synced with all other threads so that the host set in the
    * cluster remains (eventually) consistent. If multiple threads add a host to the same upstream
    * address then two distinct HostSharedPtr's (with the same upstream IP address) will be added,
-   * and both of them will eventually time out.
+   * and both of them will eventually time out. A load balancer reuses the hosts it added itself
+   * until it is replaced by one with the updated host map, so that a burst of requests to a new
+   * address on one worker adds a single host.
    */
   class LoadBalancer : public Upstream::LoadBalancer {
   public:
@@ -121,6 +123,8 @@ public:
     const absl::optional<Config::MetadataKey>& metadata_key_;
     const absl::optional<uint32_t> port_override_;
     HostMultiMapConstSharedPtr host_map_;
+    // Hosts added by this load balancer which are not in host_map_ yet, keyed by address.
+    absl::flat_hash_map<std::string, HostSharedPtr> added_hosts_;
   };
 
   const absl::optional<Http::LowerCaseString>& httpHeaderName() { return http_header_name_; }
@@ -182,8 +182,7 @@ bool RedisLoadBalancerContextImpl::isReadRequest(
       command->type() != NetworkFilters::Common::Redis::RespType::BulkString) {
     return false;
   }
-  std::string to_lower_string = absl::AsciiStrToLower(command->asString());
-  return NetworkFilters::Common::Redis::SupportedCommands::isReadCommand(to_lower_string);
+  return NetworkFilters::Common::Redis::SupportedCommands::isReadCommand(command->asString());
 }
 
 RedisLoadBalancerContextImpl::RedisLoadBalancerContextImpl(
@@ -106,6 +106,14 @@ DnsCacheImpl::loadDnsCacheEntry(absl::string_view raw_host, uint16_t default_por
             is_proxy_lookup ? "proxy mode " : "");
   ThreadLocalHostInfo& tls_host_info = *tls_slot_;
 
+  const auto tls_host = tls_host_info.resolved_hosts_.find(host);
+  if (tls_host != tls_host_info.resolved_hosts_.end()) {
+    ENVOY_LOG(debug, "thread local cache hit for host '{}'", host);
+    return {LoadDnsCacheEntryStatus::InCache, nullptr, tls_host->second};
+  }
+
+  // Hosts which resolved after the last update of this worker are still found in the primary
+  // hosts.
   auto [is_overflow, host_info] = [&]() {
     absl::ReaderMutexLock read_lock{&primary_hosts_lock_};
     auto tls_host = primary_hosts_.find(host);
@@ -275,7 +283,7 @@ void DnsCacheImpl::onReResolve(const std::string& host) {
       host_to_erase = std::move(host_it->second);
       primary_hosts_.erase(host_it);
     }
-    notifyThreads(host, primary_host.host_info_);
+    notifyThreads(host, primary_host.host_info_, true);
   } else {
     startResolve(host, primary_host);
   }
@@ -421,7 +429,7 @@ void DnsCacheImpl::finishResolve(const std::string& host,
     primary_host_info->host_info_->setFirstResolveComplete();
   }
   if (first_resolve || (address_changed && !primary_host_info->host_info_->isStale())) {
-    notifyThreads(host, primary_host_info->host_info_);
+    notifyThreads(host, primary_host_info->host_info_, false);
   }
 
   runResolutionCompleteCallbacks(host, primary_host_info->host_info_, status);
@@ -430,9 +438,19 @@ void DnsCacheImpl::finishResolve(const std::string& host,
   if (status == Network::DnsResolver::ResolutionStatus::Success) {
     primary_host_info->failure_backoff_strategy_->reset(
         std::chrono::duration_cast<std::chrono::milliseconds>(dns_ttl).count());
-    primary_host_info->refresh_timer_->enableTimer(dns_ttl);
+    std::chrono::milliseconds refresh_interval = dns_ttl;
+    if (from_cache && Runtime::runtimeFeatureEnabled(
+                          "envoy.reloadable_features.dfp_refresh_stale_cache_entries")) {
+      // Entries loaded from the key value store are served while they are refreshed once the
+      // rest of their TTL passed, immediately if they are already stale.
+      refresh_interval = std::max(std::chrono::milliseconds(0),
+                                  std::chrono::duration_cast<std::chrono::milliseconds>(
+                                      primary_host_info->host_info_->staleAtTime() -
+                                      main_thread_dispatcher_.timeSource().monotonicTime()));
+    }
+    primary_host_info->refresh_timer_->enableTimer(refresh_interval);
     ENVOY_LOG(debug, "DNS refresh rate reset for host '{}', refresh rate {} ms", host,
-              dns_ttl.count() * 1000);
+              refresh_interval.count());
   } else {
     const uint64_t refresh_interval = primary_host_info->failure_backoff_strategy_->nextBackOffMs();
     primary_host_info->refresh_timer_->enableTimer(std::chrono::milliseconds(refresh_interval));
@@ -463,8 +481,8 @@ void DnsCacheImpl::runRemoveCallbacks(const std::string& host) {
 }
 
 void DnsCacheImpl::notifyThreads(const std::string& host,
-                                 const DnsHostInfoImplSharedPtr& resolved_info) {
-  auto shared_info = std::make_shared<HostMapUpdateInfo>(host, resolved_info);
+                                 const DnsHostInfoImplSharedPtr& resolved_info, bool removed) {
+  auto shared_info = std::make_shared<HostMapUpdateInfo>(host, resolved_info, removed);
   tls_slot_.runOnAllThreads([shared_info](OptRef<ThreadLocalHostInfo> local_host_info) {
     local_host_info->onHostMapUpdate(shared_info);
   });
@@ -481,6 +499,12 @@ DnsCacheImpl::ThreadLocalHostInfo::~ThreadLocalHostInfo() {
 
 void DnsCacheImpl::ThreadLocalHostInfo::onHostMapUpdate(
     const HostMapUpdateInfoSharedPtr& resolved_host) {
+  if (resolved_host->removed_) {
+    resolved_hosts_.erase(resolved_host->host_);
+  } else if (resolved_host->info_->firstResolveComplete()) {
+    resolved_hosts_.insert_or_assign(resolved_host->host_, resolved_host->info_);
+  }
+
   auto host_it = pending_resolutions_.find(resolved_host->host_);
   if (host_it != pending_resolutions_.end()) {
     for (auto* resolution : host_it->second) {
@@ -88,10 +88,11 @@ private:
   using DnsHostInfoImplSharedPtr = std::shared_ptr<DnsHostInfoImpl>;
 
   struct HostMapUpdateInfo {
-    HostMapUpdateInfo(const std::string& host, DnsHostInfoImplSharedPtr info)
-        : host_(host), info_(std::move(info)) {}
+    HostMapUpdateInfo(const std::string& host, DnsHostInfoImplSharedPtr info, bool removed)
+        : host_(host), info_(std::move(info)), removed_(removed) {}
     std::string host_;
     DnsHostInfoImplSharedPtr info_;
+    const bool removed_;
   };
   using HostMapUpdateInfoSharedPtr = std::shared_ptr<HostMapUpdateInfo>;
 
@@ -101,6 +102,9 @@ private:
     ~ThreadLocalHostInfo() override;
     void onHostMapUpdate(const HostMapUpdateInfoSharedPtr& resolved_info);
     absl::flat_hash_map<std::string, std::list<LoadDnsCacheEntryHandleImpl*>> pending_resolutions_;
+    // The resolved hosts the main thread told this worker about, so that cache hits don't take the
+    // primary hosts lock. The host info is updated in place when its addresses change.
+    absl::flat_hash_map<std::string, DnsHostInfoSharedPtr> resolved_hosts_;
     DnsCacheImpl& parent_;
   };
 
@@ -134,6 +138,7 @@ private:
     bool isStale() {
       return time_source_.monotonicTime() > static_cast<MonotonicTime>(stale_at_time_);
     }
+    MonotonicTime staleAtTime() const { return stale_at_time_; }
 
     void setAddresses(Network::Address::InstanceConstSharedPtr address,
                       std::vector<Network::Address::InstanceConstSharedPtr>&& list) {
@@ -218,7 +223,8 @@ private:
                                       const DnsHostInfoSharedPtr& host_info,
                                       Network::DnsResolver::ResolutionStatus status);
   void runRemoveCallbacks(const std::string& host);
-  void notifyThreads(const std::string& host, const DnsHostInfoImplSharedPtr& resolved_info);
+  void notifyThreads(const std::string& host, const DnsHostInfoImplSharedPtr& resolved_info,
+                     bool removed);
   void onReResolve(const std::string& host);
   void onResolveTimeout(const std::string& host);
   PrimaryHostInfo& getPrimaryHost(const std::string& host);
@@ -794,18 +794,10 @@ WasmResult Context::setHeaderMapPairs(WasmHeaderMapType type, const Pairs& pairs
   if (!map) {
     return WasmResult::BadArgument;
   }
-  std::vector<std::string> keys;
-  map->iterate([&keys](const Http::HeaderEntry& header) -> Http::HeaderMap::Iterate {
-    keys.push_back(std::string(header.key().getStringView()));
-    return Http::HeaderMap::Iterate::Continue;
-  });
-  for (auto& k : keys) {
-    const Http::LowerCaseString lower_key{k};
-    map->remove(lower_key);
-  }
+  map->clear();
   for (auto& p : pairs) {
     const Http::LowerCaseString lower_key{std::string(p.first)};
-    map->addCopy(lower_key, std::string(p.second));
+    map->addCopy(lower_key, toAbslStringView(p.second));
   }
   if (type == WasmHeaderMapType::RequestHeaders && decoder_callbacks_) {
     decoder_callbacks_->downstreamCallbacks()->clearRouteCache();
@@ -890,9 +882,8 @@ BufferInterface* Context::getBuffer(WasmBufferType type) {
   case WasmBufferType::HttpCallResponseBody:
     response = rootContext()->http_call_response_;
     if (response) {
-      auto& body = (*response)->body();
-      return buffer_.set(
-          std::string_view(static_cast<const char*>(body.linearize(body.length())), body.length()));
+      // The body is copied into the VM straight from its slices, rather than being linearized.
+      return buffer_.set(static_cast<const ::Envoy::Buffer::Instance*>(&(*response)->body()));
     }
     return nullptr;
   case WasmBufferType::GrpcReceiveBuffer:
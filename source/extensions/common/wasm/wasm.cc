@@ -483,6 +483,22 @@ getOrCreateThreadLocalPlugin(const WasmHandleSharedPtr& base_wasm, const PluginS
       getPluginHandleFactory()));
 }
 
+std::shared_ptr<PluginHandleSharedPtrThreadLocal>
+createThreadLocalPluginHandle(const WasmHandleSharedPtr& base_wasm, const PluginSharedPtr& plugin,
+                              Event::Dispatcher& dispatcher,
+                              CreateContextFn create_root_context_for_testing) {
+  if (plugin->wasmConfig().config().lazy_worker_initialization()) {
+    return std::make_shared<PluginHandleSharedPtrThreadLocal>(
+        std::function<PluginHandleSharedPtr()>(
+            [base_wasm, plugin, &dispatcher, create_root_context_for_testing]() {
+              return getOrCreateThreadLocalPlugin(base_wasm, plugin, dispatcher,
+                                                  create_root_context_for_testing);
+            }));
+  }
+  return std::make_shared<PluginHandleSharedPtrThreadLocal>(
+      getOrCreateThreadLocalPlugin(base_wasm, plugin, dispatcher, create_root_context_for_testing));
+}
+
 } // namespace Wasm
 } // namespace Common
 } // namespace Extensions
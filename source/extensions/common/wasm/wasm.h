@@ -155,10 +155,20 @@ using PluginHandleSharedPtr = std::shared_ptr<PluginHandle>;
 class PluginHandleSharedPtrThreadLocal : public ThreadLocal::ThreadLocalObject {
 public:
   PluginHandleSharedPtrThreadLocal(PluginHandleSharedPtr handle) : handle_(handle){};
-  PluginHandleSharedPtr& handle() { return handle_; }
+  // The handle is created by create_handle when it is first needed.
+  PluginHandleSharedPtrThreadLocal(std::function<PluginHandleSharedPtr()> create_handle)
+      : create_handle_(std::move(create_handle)) {}
+  PluginHandleSharedPtr& handle() {
+    if (create_handle_) {
+      handle_ = create_handle_();
+      create_handle_ = nullptr;
+    }
+    return handle_;
+  }
 
 private:
   PluginHandleSharedPtr handle_;
+  std::function<PluginHandleSharedPtr()> create_handle_;
 };
 
 using CreateWasmCallback = std::function<void(WasmHandleSharedPtr)>;
@@ -179,6 +189,14 @@ getOrCreateThreadLocalPlugin(const WasmHandleSharedPtr& base_wasm, const PluginS
                              Event::Dispatcher& dispatcher,
                              CreateContextFn create_root_context_for_testing = nullptr);
 
+// Returns the thread local plugin handle of the worker running dispatcher. The plugin is only
+// created on the worker once it is first used if the plugin is configured with
+// lazy_worker_initialization.
+std::shared_ptr<PluginHandleSharedPtrThreadLocal>
+createThreadLocalPluginHandle(const WasmHandleSharedPtr& base_wasm, const PluginSharedPtr& plugin,
+                              Event::Dispatcher& dispatcher,
+                              CreateContextFn create_root_context_for_testing = nullptr);
+
 void clearCodeCacheForTesting();
 void setTimeOffsetForCodeCacheForTesting(MonotonicTime::duration d);
 WasmEvent toWasmEvent(const std::shared_ptr<WasmHandleBase>& wasm);
@@ -46,10 +46,15 @@ void ZlibDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
   for (const Buffer::RawSlice& input_slice : input_buffer.getRawSlices()) {
     zstream_ptr_->avail_in = input_slice.len_;
     zstream_ptr_->next_in = static_cast<Bytef*>(input_slice.mem_);
-    while (inflateNext()) {
-      if (zstream_ptr_->avail_out == 0) {
-        updateOutput(output_buffer);
-      }
+    bool more = true;
+    while (more) {
+      // Inflate straight into the output buffer, at most one chunk at a time, rather than into
+      // the chunk buffer which would then have to be copied out.
+      Buffer::ReservationSingleSlice reservation = output_buffer.reserveSingleSlice(chunk_size_);
+      zstream_ptr_->next_out = static_cast<Bytef*>(reservation.slice().mem_);
+      zstream_ptr_->avail_out = chunk_size_;
+      more = inflateNext();
+      reservation.commit(chunk_size_ - zstream_ptr_->avail_out);
 
       if (Runtime::runtimeFeatureEnabled(
               "envoy.reloadable_features.enable_compression_bomb_protection") &&
@@ -63,10 +68,6 @@ void ZlibDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
       }
     }
   }
-
-  // Flush z_stream and reset its buffer. Otherwise the stale content of the buffer
-  // will pollute output upon the next call to decompress().
-  updateOutput(output_buffer);
 }
 
 bool ZlibDecompressorImpl::inflateNext() {
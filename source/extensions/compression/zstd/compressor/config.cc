@@ -13,6 +13,13 @@ ZstdCompressorFactory::ZstdCompressorFactory(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, compression_level, ZSTD_CLEVEL_DEFAULT)),
       enable_checksum_(zstd.enable_checksum()), strategy_(zstd.strategy()),
       chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, chunk_size, ZSTD_CStreamOutSize())) {
+  if (zstd.has_shared_dictionary()) {
+    if (zstd.has_dictionary()) {
+      throw EnvoyException("zstd dictionary and shared_dictionary cannot both be set");
+    }
+    shared_dictionary_ =
+        std::make_unique<SharedDictionary>(zstd.shared_dictionary(), dispatcher, api);
+  }
   if (zstd.has_dictionary()) {
     Protobuf::RepeatedPtrField<envoy::config::core::v3::DataSource> dictionaries;
     dictionaries.Add()->CopyFrom(zstd.dictionary());
@@ -25,8 +32,13 @@ ZstdCompressorFactory::ZstdCompressorFactory(
 }
 
 Envoy::Compression::Compressor::CompressorPtr ZstdCompressorFactory::createCompressor() {
-  return std::make_unique<ZstdCompressorImpl>(compression_level_, enable_checksum_, strategy_,
-                                              cdict_manager_, chunk_size_);
+  return std::make_unique<ZstdCompressorImpl>(
+      compression_level_, enable_checksum_, strategy_, cdict_manager_, chunk_size_,
+      shared_dictionary_ ? shared_dictionary_->contents() : nullptr);
+}
+
+std::string ZstdCompressorFactory::availableDictionary() const {
+  return shared_dictionary_ ? shared_dictionary_->contents()->available_dictionary_ : "";
 }
 
 Envoy::Compression::Compressor::CompressorFactoryPtr
@@ -17,6 +17,7 @@ namespace Compressor {
 namespace {
 
 const std::string& zstdStatsPrefix() { CONSTRUCT_ON_FIRST_USE(std::string, "zstd."); }
+const std::string& dczContentEncoding() { CONSTRUCT_ON_FIRST_USE(std::string, "dcz"); }
 const std::string& zstdExtensionName() {
   CONSTRUCT_ON_FIRST_USE(std::string, "envoy.compression.zstd.compressor");
 }
@@ -33,8 +34,10 @@ public:
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
   const std::string& statsPrefix() const override { return zstdStatsPrefix(); }
   const std::string& contentEncoding() const override {
-    return Http::CustomHeaders::get().ContentEncodingValues.Zstd;
+    return shared_dictionary_ ? dczContentEncoding()
+                              : Http::CustomHeaders::get().ContentEncodingValues.Zstd;
   }
+  std::string availableDictionary() const override;
 
 private:
   const uint32_t compression_level_;
@@ -42,6 +45,7 @@ private:
   const uint32_t strategy_;
   const uint32_t chunk_size_;
   ZstdCDictManagerPtr cdict_manager_{nullptr};
+  SharedDictionaryPtr shared_dictionary_;
 };
 
 class ZstdCompressorLibraryFactory
@@ -0,0 +1,68 @@
+#include "source/extensions/compression/zstd/compressor/shared_dictionary.h"
+
+#include <utility>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/base64.h"
+#include "source/common/config/datasource.h"
+#include "source/common/crypto/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Compressor {
+
+SharedDictionary::SharedDictionary(const envoy::config::core::v3::DataSource& source,
+                                   Event::Dispatcher& dispatcher, Api::Api& api)
+    : api_(api),
+      contents_(makeContents(
+          THROW_OR_RETURN_VALUE(Config::DataSource::read(source, false, api), std::string))) {
+  if (contents_->data_.empty()) {
+    throw EnvoyException("zstd shared dictionary must not be empty");
+  }
+  if (source.specifier_case() == envoy::config::core::v3::DataSource::SpecifierCase::kFilename) {
+    const std::string& filename = source.filename();
+    watcher_ = dispatcher.createFilesystemWatcher();
+    watcher_->addWatch(filename,
+                       Filesystem::Watcher::Events::Modified | Filesystem::Watcher::Events::MovedTo,
+                       [this, filename](uint32_t) { onFileChanged(filename); });
+  }
+}
+
+SharedDictionary::ContentsConstSharedPtr SharedDictionary::contents() const {
+  absl::MutexLock lock(&mutex_);
+  return contents_;
+}
+
+SharedDictionary::ContentsConstSharedPtr SharedDictionary::makeContents(std::string data) {
+  auto contents = std::make_shared<Contents>();
+  contents->hash_ =
+      Envoy::Common::Crypto::UtilitySingleton::get().getSha256Digest(Buffer::OwnedImpl(data));
+  contents->available_dictionary_ =
+      absl::StrCat(":",
+                   Base64::encode(reinterpret_cast<const char*>(contents->hash_.data()),
+                                  contents->hash_.size()),
+                   ":");
+  contents->data_ = std::move(data);
+  return contents;
+}
+
+void SharedDictionary::onFileChanged(const std::string& filename) {
+  auto file_or_error = api_.fileSystem().fileReadToEnd(filename);
+  // Keep serving the current dictionary if the new one can't be read.
+  if (!file_or_error.ok() || file_or_error.value().empty()) {
+    return;
+  }
+  ContentsConstSharedPtr contents = makeContents(std::move(file_or_error.value()));
+  absl::MutexLock lock(&mutex_);
+  contents_ = std::move(contents);
+}
+
+} // namespace Compressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
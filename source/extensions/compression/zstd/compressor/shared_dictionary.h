@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/api/api.h"
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/filesystem/watcher.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Compressor {
+
+/**
+ * A dictionary shared with clients as described by Compression Dictionary Transport
+ * (https://www.rfc-editor.org/rfc/rfc9842). Clients announce the dictionary they have by its
+ * SHA-256 hash in the available-dictionary request header, and responses compressed with it use
+ * the "dcz" content encoding, which starts with the hash of the dictionary.
+ *
+ * Unlike dictionaries used with the "zstd" content encoding, the dictionary is raw content rather
+ * than a trained zstd dictionary. If it is read from a file, it is reloaded when the file changes.
+ */
+class SharedDictionary {
+public:
+  struct Contents {
+    std::string data_;
+    // The SHA-256 hash of data_.
+    std::vector<uint8_t> hash_;
+    // hash_ as the structured field byte sequence that clients send in available-dictionary.
+    std::string available_dictionary_;
+  };
+  using ContentsConstSharedPtr = std::shared_ptr<const Contents>;
+
+  SharedDictionary(const envoy::config::core::v3::DataSource& source,
+                   Event::Dispatcher& dispatcher, Api::Api& api);
+
+  /**
+   * @return the current dictionary. It may be called from any thread.
+   */
+  ContentsConstSharedPtr contents() const ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  static ContentsConstSharedPtr makeContents(std::string data);
+  void onFileChanged(const std::string& filename) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  Api::Api& api_;
+  mutable absl::Mutex mutex_;
+  ContentsConstSharedPtr contents_ ABSL_GUARDED_BY(mutex_);
+  Filesystem::WatcherPtr watcher_;
+};
+using SharedDictionaryPtr = std::unique_ptr<SharedDictionary>;
+
+} // namespace Compressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -8,11 +8,19 @@ namespace Compression {
 namespace Zstd {
 namespace Compressor {
 
+namespace {
+// The header of a "dcz" response, which is a zstd skippable frame holding the 32 byte SHA-256
+// hash of the dictionary.
+constexpr uint8_t DczHeaderMagic[] = {0x5e, 0x2a, 0x4d, 0x18, 0x20, 0x00, 0x00, 0x00};
+} // namespace
+
 ZstdCompressorImpl::ZstdCompressorImpl(uint32_t compression_level, bool enable_checksum,
                                        uint32_t strategy, const ZstdCDictManagerPtr& cdict_manager,
-                                       uint32_t chunk_size)
+                                       uint32_t chunk_size,
+                                       SharedDictionary::ContentsConstSharedPtr shared_dictionary)
     : Common::Base(chunk_size), cctx_(ZSTD_createCCtx(), &ZSTD_freeCCtx),
-      cdict_manager_(cdict_manager), compression_level_(compression_level) {
+      cdict_manager_(cdict_manager), compression_level_(compression_level),
+      shared_dictionary_(std::move(shared_dictionary)) {
   size_t result;
   result = ZSTD_CCtx_setParameter(cctx_.get(), ZSTD_c_checksumFlag, enable_checksum);
   RELEASE_ASSERT(!ZSTD_isError(result), "");
@@ -20,7 +28,12 @@ ZstdCompressorImpl::ZstdCompressorImpl(uint32_t compression_level, bool enable_c
   result = ZSTD_CCtx_setParameter(cctx_.get(), ZSTD_c_strategy, strategy);
   RELEASE_ASSERT(!ZSTD_isError(result), "");
 
-  if (cdict_manager_) {
+  if (shared_dictionary_) {
+    result = ZSTD_CCtx_setParameter(cctx_.get(), ZSTD_c_compressionLevel, compression_level_);
+    RELEASE_ASSERT(!ZSTD_isError(result), "");
+    result = ZSTD_CCtx_refPrefix(cctx_.get(), shared_dictionary_->data_.data(),
+                                 shared_dictionary_->data_.size());
+  } else if (cdict_manager_) {
     ZSTD_CDict* cdict = cdict_manager_->getFirstDictionary();
     result = ZSTD_CCtx_refCDict(cctx_.get(), cdict);
   } else {
@@ -32,6 +45,11 @@ ZstdCompressorImpl::ZstdCompressorImpl(uint32_t compression_level, bool enable_c
 void ZstdCompressorImpl::compress(Buffer::Instance& buffer,
                                   Envoy::Compression::Compressor::State state) {
   Buffer::OwnedImpl accumulation_buffer;
+  if (shared_dictionary_ && !dcz_header_written_) {
+    dcz_header_written_ = true;
+    accumulation_buffer.add(DczHeaderMagic, sizeof(DczHeaderMagic));
+    accumulation_buffer.add(shared_dictionary_->hash_.data(), shared_dictionary_->hash_.size());
+  }
   for (const Buffer::RawSlice& input_slice : buffer.getRawSlices()) {
     if (input_slice.len_ > 0) {
       setInput(input_slice);
@@ -4,6 +4,7 @@
 
 #include "source/extensions/compression/zstd/common/base.h"
 #include "source/extensions/compression/zstd/common/dictionary_manager.h"
+#include "source/extensions/compression/zstd/compressor/shared_dictionary.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -22,8 +23,11 @@ class ZstdCompressorImpl : public Common::Base,
                            public Envoy::Compression::Compressor::Compressor,
                            NonCopyable {
 public:
+  // If shared_dictionary is set, the output is in the "dcz" format: a header naming the
+  // dictionary, followed by a frame compressed with the dictionary as raw content.
   ZstdCompressorImpl(uint32_t compression_level, bool enable_checksum, uint32_t strategy,
-                     const ZstdCDictManagerPtr& cdict_manager, uint32_t chunk_size);
+                     const ZstdCDictManagerPtr& cdict_manager, uint32_t chunk_size,
+                     SharedDictionary::ContentsConstSharedPtr shared_dictionary = nullptr);
 
   // Compression::Compressor::Compressor
   void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override;
@@ -34,6 +38,9 @@ private:
   std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx_;
   const ZstdCDictManagerPtr& cdict_manager_;
   const uint32_t compression_level_;
+  // Referenced by cctx_ as its prefix, so it must outlive the frame.
+  const SharedDictionary::ContentsConstSharedPtr shared_dictionary_;
+  bool dcz_header_written_{};
 };
 
 } // namespace Compressor
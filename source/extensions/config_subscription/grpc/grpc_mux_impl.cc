@@ -77,6 +77,10 @@ GrpcMuxImpl::GrpcMuxImpl(GrpcMuxContext& grpc_mux_context, bool skip_subsequent_
                 onDynamicContextUpdate(resource_type_url);
               })) {
   THROW_IF_NOT_OK(Config::Utility::checkLocalInfo("ads", local_info_));
+  if (xds_resources_delegate_.has_value() && xds_resources_delegate_->loadResourcesOnStart()) {
+    startup_delegate_load_cb_ =
+        dispatcher_.createSchedulableCallback([this]() { loadStartupConfigFromDelegate(); });
+  }
   AllMuxes::get().insert(this);
 }
 
@@ -99,6 +103,9 @@ void GrpcMuxImpl::start() {
     return;
   }
   started_ = true;
+  if (startup_delegate_load_cb_ != nullptr) {
+    startup_delegate_load_cb_->scheduleCallbackCurrentIteration();
+  }
   grpc_stream_.establishNewStream();
 }
 
@@ -199,6 +206,22 @@ void GrpcMuxImpl::loadConfigFromDelegate(const std::string& type_url,
   }
 }
 
+void GrpcMuxImpl::loadStartupConfigFromDelegate() {
+  for (const auto& [type_url, api_state] : api_state_) {
+    if (api_state->previously_fetched_data_ || api_state->watches_.empty()) {
+      continue;
+    }
+    // The persisted config is used until the xDS server responds, and is then replaced by the
+    // server's config like any other SotW update.
+    absl::flat_hash_set<std::string> resource_names;
+    for (const auto* watch : api_state->watches_) {
+      resource_names.insert(watch->resources_.begin(), watch->resources_.end());
+    }
+    loadConfigFromDelegate(type_url, resource_names);
+    api_state->previously_fetched_data_ = true;
+  }
+}
+
 GrpcMuxWatchPtr GrpcMuxImpl::addWatch(const std::string& type_url,
                                       const absl::flat_hash_set<std::string>& resources,
                                       SubscriptionCallbacks& callbacks,
@@ -225,6 +248,12 @@ GrpcMuxWatchPtr GrpcMuxImpl::addWatch(const std::string& type_url,
     subscriptions_.emplace_back(type_url);
   }
 
+  // Watches added after the mux started, e.g. LDS after the clusters initialized, are loaded from
+  // the delegate outside of the addWatch() call, as loading invokes their callbacks.
+  if (started_ && startup_delegate_load_cb_ != nullptr) {
+    startup_delegate_load_cb_->scheduleCallbackCurrentIteration();
+  }
+
   // This will send an updated request on each subscription.
   // TODO(htuch): For RDS/EDS, this will generate a new DiscoveryRequest on each resource we added.
   // Consider in the future adding some kind of collation/batching during CDS/LDS updates so that we
@@ -313,6 +342,7 @@ void GrpcMuxImpl::onDiscoveryResponse(
   same_type_resume = pause(type_url);
   TRY_ASSERT_MAIN_THREAD {
     std::vector<DecodedResourcePtr> resources;
+    resources.reserve(message->resources().size());
     OpaqueResourceDecoder& resource_decoder = *api_state.watches_.front()->resource_decoder_;
 
     for (const auto& resource : message->resources()) {
@@ -252,6 +252,9 @@ private:
   // Must be invoked from the main or test thread.
   void loadConfigFromDelegate(const std::string& type_url,
                               const absl::flat_hash_set<std::string>& resource_names);
+  // Loads the persisted config of every watched API with no data yet, when the delegate asks for
+  // its resources to be applied on start. Must be invoked from the main or test thread.
+  void loadStartupConfigFromDelegate();
   // Must be invoked from the main or test thread.
   void processDiscoveryResources(const std::vector<DecodedResourcePtr>& resources,
                                  ApiState& api_state, const std::string& type_url,
@@ -285,6 +288,9 @@ private:
 
   Event::Dispatcher& dispatcher_;
   Common::CallbackHandlePtr dynamic_update_callback_handle_;
+  // Applies the persisted config of the delegate once the current watch additions are done, if it
+  // asked for it to be loaded on start.
+  Event::SchedulableCallbackPtr startup_delegate_load_cb_;
 
   bool started_{false};
   // True iff Envoy is shutting down; no messages should be sent on the `grpc_stream_` when this is
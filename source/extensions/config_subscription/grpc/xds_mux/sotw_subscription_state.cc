@@ -46,6 +46,7 @@ void SotwSubscriptionState::markStreamFresh() {
 void SotwSubscriptionState::handleGoodResponse(
     const envoy::service::discovery::v3::DiscoveryResponse& message) {
   std::vector<DecodedResourcePtr> non_heartbeat_resources;
+  non_heartbeat_resources.reserve(message.resources().size());
 
   {
     const auto scoped_update = ttl_.scopedTtlUpdate();
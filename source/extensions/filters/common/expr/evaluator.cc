@@ -122,8 +122,42 @@ SINGLETON_MANAGER_REGISTRATION(expression_builder);
 
 BuilderInstanceSharedPtr getBuilder(Server::Configuration::CommonFactoryContext& context) {
   return context.singletonManager().getTyped<BuilderInstance>(
-      SINGLETON_MANAGER_REGISTERED_NAME(expression_builder),
-      [] { return std::make_shared<BuilderInstance>(createBuilder(nullptr)); });
+      SINGLETON_MANAGER_REGISTERED_NAME(expression_builder), [] {
+        // The folded constants stay on the arena until the builder is released. Expressions created
+        // with createSharedExpression() are only folded once however often they are configured.
+        auto constant_arena = std::make_unique<Protobuf::Arena>();
+        auto builder = createBuilder(constant_arena.get());
+        return std::make_shared<BuilderInstance>(std::move(builder), std::move(constant_arena));
+      });
+}
+
+ExpressionSharedPtr
+BuilderInstance::createSharedExpression(const google::api::expr::v1alpha1::Expr& expr) {
+  std::string key = expr.SerializeAsString();
+  absl::MutexLock lock(&mutex_);
+  if (auto it = expressions_.find(key); it != expressions_.end()) {
+    if (ExpressionSharedPtr expression = it->second.lock(); expression != nullptr) {
+      return expression;
+    }
+  }
+  ExpressionPtr compiled = createExpression(*builder_, expr);
+  // Expressions may be released on any thread, and remove their entry when they are.
+  auto release = [instance = shared_from_this(), key](const Expression* expression) {
+    delete expression;
+    instance->releaseExpression(key);
+  };
+  ExpressionSharedPtr expression(compiled.release(), std::move(release));
+  expressions_[key] = expression;
+  return expression;
+}
+
+void BuilderInstance::releaseExpression(const std::string& key) {
+  absl::MutexLock lock(&mutex_);
+  auto it = expressions_.find(key);
+  // The entry may already hold a newer expression created after this one expired.
+  if (it != expressions_.end() && it->second.expired()) {
+    expressions_.erase(it);
+  }
 }
 
 ExpressionPtr createExpression(Builder& builder, const google::api::expr::v1alpha1::Expr& expr) {
@@ -142,9 +176,9 @@ absl::optional<CelValue> evaluate(const Expression& expr, Protobuf::Arena& arena
                                   const Http::RequestHeaderMap* request_headers,
                                   const Http::ResponseHeaderMap* response_headers,
                                   const Http::ResponseTrailerMap* response_trailers) {
-  auto activation =
-      createActivation(local_info, info, request_headers, response_headers, response_trailers);
-  auto eval_status = expr.Evaluate(*activation, &arena);
+  const StreamActivation activation(local_info, info, request_headers, response_headers,
+                                    response_trailers);
+  auto eval_status = expr.Evaluate(activation, &arena);
   if (!eval_status.ok()) {
     return {};
   }
@@ -154,7 +188,13 @@ absl::optional<CelValue> evaluate(const Expression& expr, Protobuf::Arena& arena
 
 bool matches(const Expression& expr, const StreamInfo::StreamInfo& info,
              const Http::RequestHeaderMap& headers) {
-  Protobuf::Arena arena;
+  // Most conditions only need a few small values, so the arena starts on the stack rather than
+  // allocating for every evaluation.
+  alignas(8) char initial_block[1024];
+  Protobuf::ArenaOptions arena_options;
+  arena_options.initial_block = initial_block;
+  arena_options.initial_block_size = sizeof(initial_block);
+  Protobuf::Arena arena(arena_options);
   auto eval_status = Expr::evaluate(expr, arena, nullptr, info, &headers, nullptr, nullptr);
   if (!eval_status.has_value()) {
     return false;
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include "envoy/stream_info/stream_info.h"
 
 #include "source/common/http/headers.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/extensions/filters/common/expr/context.h"
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
 // CEL-CPP does not enforce unused parameter checks consistently, so we relax it here.
 
 #if defined(__GNUC__)
@@ -33,6 +40,7 @@ using Builder = google::api::expr::runtime::CelExpressionBuilder;
 using BuilderPtr = std::unique_ptr<Builder>;
 using Expression = google::api::expr::runtime::CelExpression;
 using ExpressionPtr = std::unique_ptr<Expression>;
+using ExpressionSharedPtr = std::shared_ptr<const Expression>;
 
 // Base class for the context used by the CEL evaluator to look up attributes.
 class StreamActivation : public google::api::expr::runtime::BaseActivation {
@@ -73,13 +81,33 @@ ActivationPtr createActivation(const ::Envoy::LocalInfo::LocalInfo* local_info,
                                const ::Envoy::Http::ResponseTrailerMap* response_trailers);
 
 // Shared expression builder instance.
-class BuilderInstance : public Singleton::Instance {
+class BuilderInstance : public Singleton::Instance,
+                        public std::enable_shared_from_this<BuilderInstance> {
 public:
   explicit BuilderInstance(BuilderPtr builder) : builder_(std::move(builder)) {}
+  // The constant arena holds the constants folded by the builder.
+  BuilderInstance(BuilderPtr builder, std::unique_ptr<Protobuf::Arena> constant_arena)
+      : constant_arena_(std::move(constant_arena)), builder_(std::move(builder)) {}
   Builder& builder() { return *builder_; }
 
+  // Creates an interpretable expression, or returns the one already created from an identical
+  // expression if that one is still in use. The instance must be owned by a shared pointer, which
+  // the expression keeps alive.
+  // Throws an exception if fails to construct a runtime expression.
+  ExpressionSharedPtr createSharedExpression(const google::api::expr::v1alpha1::Expr& expr)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
 private:
+  void releaseExpression(const std::string& key) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Declared before builder_, since the constants folded by the builder may be referenced by the
+  // expressions it built.
+  std::unique_ptr<Protobuf::Arena> constant_arena_;
   BuilderPtr builder_;
+  absl::Mutex mutex_;
+  // The expressions in use, keyed by their serialized form.
+  absl::flat_hash_map<std::string, std::weak_ptr<const Expression>>
+      expressions_ ABSL_GUARDED_BY(mutex_);
 };
 
 using BuilderInstanceSharedPtr = std::shared_ptr<BuilderInstance>;
@@ -89,7 +117,7 @@ using BuilderInstanceSharedPtr = std::shared_ptr<BuilderInstance>;
 // Throws an exception if fails to construct an expression builder.
 BuilderPtr createBuilder(Protobuf::Arena* arena);
 
-// Gets the singleton expression builder. Must be called on the main thread.
+// Gets the singleton expression builder, which folds constants. Must be called on the main thread.
 BuilderInstanceSharedPtr getBuilder(Server::Configuration::CommonFactoryContext& context);
 
 // Creates an interpretable expression from a protobuf representation.
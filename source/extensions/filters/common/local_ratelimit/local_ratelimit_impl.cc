@@ -18,12 +18,13 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
     const uint32_t tokens_per_fill, Event::Dispatcher& dispatcher,
     const Protobuf::RepeatedPtrField<
         envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors,
-    bool always_consume_default_token_bucket)
+    bool always_consume_default_token_bucket, bool per_worker_token_budgets)
     : fill_timer_(fill_interval > std::chrono::milliseconds(0)
                       ? dispatcher.createTimer([this] { onFillTimer(); })
                       : nullptr),
       time_source_(dispatcher.timeSource()),
-      always_consume_default_token_bucket_(always_consume_default_token_bucket) {
+      always_consume_default_token_bucket_(always_consume_default_token_bucket),
+      per_worker_token_budgets_(per_worker_token_budgets) {
   if (fill_timer_ && fill_interval < std::chrono::milliseconds(50)) {
     throw EnvoyException("local rate limit token bucket fill timer must be >= 50ms");
   }
@@ -31,7 +32,7 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
   token_bucket_.max_tokens_ = max_tokens;
   token_bucket_.tokens_per_fill_ = tokens_per_fill;
   token_bucket_.fill_interval_ = absl::FromChrono(fill_interval);
-  tokens_.tokens_ = max_tokens;
+  initTokens(tokens_, max_tokens);
   tokens_.fill_time_ = time_source_.monotonicTime();
 
   if (fill_timer_) {
@@ -60,7 +61,7 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
     new_descriptor.token_bucket_ = per_descriptor_token_bucket;
 
     auto token_state = std::make_shared<TokenState>();
-    token_state->tokens_ = per_descriptor_token_bucket.max_tokens_;
+    initTokens(*token_state, per_descriptor_token_bucket.max_tokens_);
     token_state->fill_time_ = time_source_.monotonicTime();
     new_descriptor.token_state_ = token_state;
 
@@ -103,8 +104,28 @@ void LocalRateLimiterImpl::onFillTimer() {
   fill_timer_->enableTimer(absl::ToChronoMilliseconds(token_bucket_.fill_interval_));
 }
 
+void LocalRateLimiterImpl::initTokens(TokenState& state, uint32_t tokens) {
+  if (!per_worker_token_budgets_) {
+    state.tokens_ = tokens;
+    return;
+  }
+  state.tokens_ = 0;
+  state.budgets_ = std::make_unique<TokenBudgets>();
+  for (size_t i = 0; i < NumTokenBudgets; ++i) {
+    (*state.budgets_)[i].tokens_ = tokens / NumTokenBudgets + (i < tokens % NumTokenBudgets);
+  }
+}
+
+uint32_t LocalRateLimiterImpl::budgetIndex() { return threadShardIndex<NumTokenBudgets>(); }
+
 void LocalRateLimiterImpl::onFillTimerHelper(TokenState& tokens,
                                              const RateLimit::TokenBucket& bucket) {
+  if (tokens.budgets_ != nullptr) {
+    onFillTimerBudgetsHelper(*tokens.budgets_, bucket);
+    tokens.fill_time_ = time_source_.monotonicTime();
+    return;
+  }
+
   // Relaxed consistency is used for all operations because we don't care about ordering, just the
   // final atomic correctness.
   uint32_t expected_tokens = tokens.tokens_.load(std::memory_order_relaxed);
@@ -124,6 +145,39 @@ void LocalRateLimiterImpl::onFillTimerHelper(TokenState& tokens,
   tokens.fill_time_ = time_source_.monotonicTime();
 }
 
+void LocalRateLimiterImpl::onFillTimerBudgetsHelper(TokenBudgets& budgets,
+                                                    const RateLimit::TokenBucket& bucket) {
+  // All the tokens are taken back from the budgets and handed out again, together with the new
+  // tokens, in proportion to how many requests each budget has seen since the last fill. Requests
+  // which find all the budgets empty while this runs are limited, so for a moment fewer requests
+  // may be allowed than the bucket holds, but never more.
+  std::array<uint32_t, NumTokenBudgets> demand;
+  uint64_t tokens = 0;
+  uint64_t total_demand = 0;
+  size_t busiest = 0;
+  for (size_t i = 0; i < NumTokenBudgets; ++i) {
+    tokens += budgets[i].tokens_.exchange(0, std::memory_order_relaxed);
+    demand[i] = budgets[i].demand_.exchange(0, std::memory_order_relaxed);
+    total_demand += demand[i];
+    if (demand[i] > demand[busiest]) {
+      busiest = i;
+    }
+  }
+  tokens = std::min<uint64_t>(bucket.max_tokens_, tokens + bucket.tokens_per_fill_);
+
+  uint64_t handed_out = 0;
+  for (size_t i = 0; i < NumTokenBudgets; ++i) {
+    // Without any requests, the tokens are split evenly.
+    const uint64_t share = total_demand > 0
+                               ? tokens * demand[i] / total_demand
+                               : tokens / NumTokenBudgets + (i < tokens % NumTokenBudgets);
+    budgets[i].tokens_.fetch_add(share, std::memory_order_relaxed);
+    handed_out += share;
+  }
+  // Tokens lost to rounding go to the budget with the most requests.
+  budgets[busiest].tokens_.fetch_add(tokens - handed_out, std::memory_order_relaxed);
+}
+
 void LocalRateLimiterImpl::onFillTimerDescriptorHelper() {
   for (const auto& descriptor : descriptors_) {
     // Descriptors are refilled every Nth timer hit where N is the ratio of the
@@ -137,9 +191,27 @@ void LocalRateLimiterImpl::onFillTimerDescriptorHelper() {
 }
 
 bool LocalRateLimiterImpl::requestAllowedHelper(const TokenState& tokens) const {
+  if (tokens.budgets_ == nullptr) {
+    return consumeToken(tokens.tokens_);
+  }
+
+  // Requests are served from the budget of the current thread, and only take tokens from the
+  // budgets of other threads when their own budget is empty.
+  const uint32_t own_budget = budgetIndex();
+  TokenBudgets& budgets = *tokens.budgets_;
+  budgets[own_budget].demand_.fetch_add(1, std::memory_order_relaxed);
+  for (size_t i = 0; i < NumTokenBudgets; ++i) {
+    if (consumeToken(budgets[(own_budget + i) % NumTokenBudgets].tokens_)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LocalRateLimiterImpl::consumeToken(std::atomic<uint32_t>& tokens) const {
   // Relaxed consistency is used for all operations because we don't care about ordering, just the
   // final atomic correctness.
-  uint32_t expected_tokens = tokens.tokens_.load(std::memory_order_relaxed);
+  uint32_t expected_tokens = tokens.load(std::memory_order_relaxed);
   do {
     // expected_tokens is either initialized above or reloaded during the CAS failure below.
     if (expected_tokens == 0) {
@@ -150,8 +222,8 @@ bool LocalRateLimiterImpl::requestAllowedHelper(const TokenState& tokens) const
     synchronizer_.syncPoint("allowed_pre_cas");
 
     // Loop while the weak CAS fails trying to subtract 1 from expected.
-  } while (!tokens.tokens_.compare_exchange_weak(expected_tokens, expected_tokens - 1,
-                                                 std::memory_order_relaxed));
+  } while (!tokens.compare_exchange_weak(expected_tokens, expected_tokens - 1,
+                                         std::memory_order_relaxed));
 
   // We successfully decremented the counter by 1.
   return true;
@@ -219,9 +291,19 @@ uint32_t LocalRateLimiterImpl::remainingTokens(
     absl::Span<const RateLimit::LocalDescriptor> request_descriptors) const {
   auto descriptor = descriptorHelper(request_descriptors);
 
-  return descriptor.has_value()
-             ? descriptor.value().get().token_state_->tokens_.load(std::memory_order_relaxed)
-             : tokens_.tokens_.load(std::memory_order_relaxed);
+  return descriptor.has_value() ? remainingTokensHelper(*descriptor.value().get().token_state_)
+                                : remainingTokensHelper(tokens_);
+}
+
+uint32_t LocalRateLimiterImpl::remainingTokensHelper(const TokenState& tokens) const {
+  if (tokens.budgets_ == nullptr) {
+    return tokens.tokens_.load(std::memory_order_relaxed);
+  }
+  uint32_t remaining = 0;
+  for (const auto& budget : *tokens.budgets_) {
+    remaining += budget.tokens_.load(std::memory_order_relaxed);
+  }
+  return remaining;
 }
 
 int64_t LocalRateLimiterImpl::remainingFillInterval(
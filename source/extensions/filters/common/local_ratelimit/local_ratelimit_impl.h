@@ -1,12 +1,15 @@
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <memory>
 
 #include "envoy/event/dispatcher.h"
 #include "envoy/event/timer.h"
 #include "envoy/extensions/common/ratelimit/v3/ratelimit.pb.h"
 #include "envoy/ratelimit/ratelimit.h"
 
+#include "source/common/common/thread_shard.h"
 #include "source/common/common/thread_synchronizer.h"
 #include "source/common/protobuf/protobuf.h"
 
@@ -23,7 +26,7 @@ public:
       const uint32_t tokens_per_fill, Event::Dispatcher& dispatcher,
       const Protobuf::RepeatedPtrField<
           envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors,
-      bool always_consume_default_token_bucket = true);
+      bool always_consume_default_token_bucket = true, bool per_worker_token_budgets = false);
   ~LocalRateLimiterImpl();
 
   bool requestAllowed(absl::Span<const RateLimit::LocalDescriptor> request_descriptors) const;
@@ -33,9 +36,23 @@ public:
   remainingFillInterval(absl::Span<const RateLimit::LocalDescriptor> request_descriptors) const;
 
 private:
+  static constexpr size_t NumTokenBudgets = 16;
+
+  // The share of a bucket's tokens which is consumed by the threads assigned to it. Each budget
+  // has its own cache line, so that threads consuming their own budget do not write to memory
+  // shared with other threads.
+  struct alignas(CacheLineSize) TokenBudget {
+    std::atomic<uint32_t> tokens_{0};
+    // Requests seen since the last fill, which decides the budget's share of the bucket.
+    std::atomic<uint32_t> demand_{0};
+  };
+  using TokenBudgets = std::array<TokenBudget, NumTokenBudgets>;
+
   struct TokenState {
     mutable std::atomic<uint32_t> tokens_;
     MonotonicTime fill_time_;
+    // Set if the tokens are split into per-worker budgets, in which case tokens_ is not used.
+    std::unique_ptr<TokenBudgets> budgets_;
   };
   // Refill counter is incremented per each refill timer hit.
   uint64_t refill_counter_{0};
@@ -71,11 +88,17 @@ private:
   };
 
   void onFillTimer();
+  void initTokens(TokenState& state, uint32_t tokens);
   void onFillTimerHelper(TokenState& state, const RateLimit::TokenBucket& bucket);
+  void onFillTimerBudgetsHelper(TokenBudgets& budgets, const RateLimit::TokenBucket& bucket);
   void onFillTimerDescriptorHelper();
   OptRef<const LocalDescriptorImpl>
   descriptorHelper(absl::Span<const RateLimit::LocalDescriptor> request_descriptors) const;
   bool requestAllowedHelper(const TokenState& tokens) const;
+  bool consumeToken(std::atomic<uint32_t>& tokens) const;
+  uint32_t remainingTokensHelper(const TokenState& tokens) const;
+  // Threads are assigned budgets round robin when they first consume a token.
+  static uint32_t budgetIndex();
   int tokensFillPerSecond(LocalDescriptorImpl& descriptor);
 
   RateLimit::TokenBucket token_bucket_;
@@ -86,6 +109,7 @@ private:
   std::vector<LocalDescriptorImpl> sorted_descriptors_;
   mutable Thread::ThreadSynchronizer synchronizer_; // Used for testing only.
   const bool always_consume_default_token_bucket_{};
+  const bool per_worker_token_budgets_{};
 
   friend class LocalRateLimiterImplTest;
 };
@@ -14,8 +14,28 @@ namespace Filters {
 namespace Common {
 namespace Lua {
 
-Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state)
-    : coroutine_state_(new_thread_state, false) {}
+namespace {
+
+int appendBytecode(lua_State*, const void* data, size_t size, void* bytecode) {
+  static_cast<std::string*>(bytecode)->append(static_cast<const char*>(data), size);
+  return 0;
+}
+
+} // namespace
+
+Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state,
+                     CoroutinePool* pool)
+    : coroutine_state_(new_thread_state, false), pool_(pool) {}
+
+Coroutine::~Coroutine() {
+  // A thread which has errored is dead, and one which has yielded can not be made to run another
+  // function, so only threads which never started or ran to completion are reused.
+  if (pool_ != nullptr && !failed_ && state_ != State::Yielded) {
+    lua_settop(coroutine_state_.get(), 0);
+    coroutine_state_.pushStack();
+    pool_->push(coroutine_state_.get());
+  }
+}
 
 void Coroutine::start(int function_ref, int num_args, const std::function<void()>& yield_callback) {
   ASSERT(state_ == State::NotStarted);
@@ -43,6 +63,7 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
     yield_callback();
   } else {
     state_ = State::Finished;
+    failed_ = true;
     const char* error = lua_tostring(coroutine_state_.get(), -1);
     if (!error) {
       error = "unspecified lua error";
@@ -59,12 +80,17 @@ ThreadLocalState::ThreadLocalState(const std::string& code, ThreadLocal::SlotAll
   RELEASE_ASSERT(state.get() != nullptr, "unable to create new Lua state object");
   luaL_openlibs(state.get());
 
-  if (0 != luaL_dostring(state.get(), code.c_str())) {
+  // The code is only parsed here. The workers load the resulting bytecode.
+  std::string bytecode;
+  if (0 != luaL_loadstring(state.get(), code.c_str()) ||
+      0 != lua_dump(state.get(), appendBytecode, &bytecode) ||
+      0 != lua_pcall(state.get(), 0, LUA_MULTRET, 0)) {
     throw LuaException(fmt::format("script load error: {}", lua_tostring(state.get(), -1)));
   }
 
   // Now initialize on all threads.
-  tls_slot_->set([code](Event::Dispatcher&) { return std::make_shared<LuaThreadLocal>(code); });
+  tls_slot_->set(
+      [bytecode](Event::Dispatcher&) { return std::make_shared<LuaThreadLocal>(bytecode); });
 }
 
 int ThreadLocalState::getGlobalRef(uint64_t slot) {
@@ -93,19 +119,50 @@ uint64_t ThreadLocalState::registerGlobal(const std::string& global,
 }
 
 CoroutinePtr ThreadLocalState::createCoroutine() {
-  lua_State* state = tlsState().get();
-  return std::make_unique<Coroutine>(std::make_pair(lua_newthread(state), state));
+  LuaThreadLocal& tls = **tls_slot_;
+  lua_State* state = tls.state_.get();
+  lua_State* thread = tls.coroutine_pool_.pop();
+  if (thread == nullptr) {
+    thread = lua_newthread(state);
+  }
+  return std::make_unique<Coroutine>(std::make_pair(thread, state), &tls.coroutine_pool_);
 }
 
-ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& code)
-    : state_(luaL_newstate()) {
+ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& bytecode)
+    : state_(luaL_newstate()), coroutine_pool_(state_.get()) {
 
   RELEASE_ASSERT(state_.get() != nullptr, "unable to create new Lua state object");
   luaL_openlibs(state_.get());
-  int rc = luaL_dostring(state_.get(), code.c_str());
+  int rc = luaL_loadbuffer(state_.get(), bytecode.data(), bytecode.size(), "bytecode") ||
+           lua_pcall(state_.get(), 0, LUA_MULTRET, 0);
   ASSERT(rc == 0);
 }
 
+CoroutinePool::~CoroutinePool() {
+  for (const auto& [thread, ref] : idle_threads_) {
+    luaL_unref(state_, LUA_REGISTRYINDEX, ref);
+  }
+}
+
+lua_State* CoroutinePool::pop() {
+  if (idle_threads_.empty()) {
+    return nullptr;
+  }
+  const auto [thread, ref] = idle_threads_.back();
+  idle_threads_.pop_back();
+  lua_rawgeti(state_, LUA_REGISTRYINDEX, ref);
+  luaL_unref(state_, LUA_REGISTRYINDEX, ref);
+  return thread;
+}
+
+void CoroutinePool::push(lua_State* thread) {
+  if (idle_threads_.size() >= MaxIdleThreads) {
+    lua_pop(state_, 1);
+    return;
+  }
+  idle_threads_.emplace_back(thread, luaL_ref(state_, LUA_REGISTRYINDEX));
+}
+
 } // namespace Lua
 } // namespace Common
 } // namespace Filters
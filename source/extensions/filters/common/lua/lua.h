@@ -343,6 +343,8 @@ public:
   }
 };
 
+class CoroutinePool;
+
 /**
  * This is a wrapper for a Lua coroutine. Lua intermixes coroutine and "thread." Lua does not have
  * real threads, only cooperatively scheduled coroutines.
@@ -351,7 +353,14 @@ class Coroutine : Logger::Loggable<Logger::Id::lua> {
 public:
   enum class State { NotStarted, Yielded, Finished };
 
-  Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state);
+  /**
+   * @param new_thread_state supplies the coroutine thread and the state it was created in.
+   * @param pool supplies the pool the thread is returned to on destruction, if it can still be
+   *        used to run another function.
+   */
+  Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state,
+            CoroutinePool* pool = nullptr);
+  ~Coroutine();
   lua_State* luaState() { return coroutine_state_.get(); }
   State state() { return state_; }
 
@@ -375,10 +384,42 @@ public:
 
 private:
   LuaRef<lua_State> coroutine_state_;
+  CoroutinePool* pool_;
   State state_{State::NotStarted};
+  bool failed_{};
 };
 
 using CoroutinePtr = std::unique_ptr<Coroutine>;
+
+/**
+ * Coroutine threads which have finished, kept so that they can run another function rather than
+ * a new thread being created and garbage collected for every coroutine.
+ */
+class CoroutinePool {
+public:
+  explicit CoroutinePool(lua_State* state) : state_(state) {}
+  ~CoroutinePool();
+
+  /**
+   * Takes a thread from the pool and pushes it onto the stack of the state.
+   * @return the thread, or nullptr if the pool is empty, in which case nothing is pushed.
+   */
+  lua_State* pop();
+
+  /**
+   * Adds the thread at the top of the stack of the state to the pool, popping it.
+   */
+  void push(lua_State* thread);
+
+private:
+  // Bounds the threads kept per worker, so that a burst of concurrent requests does not pin its
+  // memory forever.
+  static constexpr size_t MaxIdleThreads = 1024;
+
+  lua_State* const state_;
+  // The idle threads along with their registry references.
+  std::vector<std::pair<lua_State*, int>> idle_threads_;
+};
 using Initializer = std::function<void(lua_State*)>;
 using InitializerList = std::vector<Initializer>;
 
@@ -436,10 +477,11 @@ public:
 
 private:
   struct LuaThreadLocal : public ThreadLocal::ThreadLocalObject {
-    LuaThreadLocal(const std::string& code);
+    LuaThreadLocal(const std::string& bytecode);
 
     CSmartPtr<lua_State, lua_close> state_;
     std::vector<int> global_slots_;
+    CoroutinePool coroutine_pool_;
   };
 
   CSmartPtr<lua_State, lua_close>& tlsState() { return (*tls_slot_)->state_; }
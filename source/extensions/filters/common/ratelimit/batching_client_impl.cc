@@ -0,0 +1,249 @@
+#include "source/extensions/filters/common/ratelimit/batching_client_impl.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/empty_string.h"
+#include "source/common/tracing/null_span_impl.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RateLimit {
+
+RateLimitBatcher::Batch::Batch(RateLimitBatcher& parent, const std::string& domain,
+                               uint32_t hits_addend)
+    : parent_(parent) {
+  request_.set_domain(domain);
+  request_.set_hits_addend(hits_addend);
+}
+
+void RateLimitBatcher::Batch::onSuccess(
+    std::unique_ptr<envoy::service::ratelimit::v3::RateLimitResponse>&& response,
+    Tracing::Span&) {
+  ASSERT(response->overall_code() != envoy::service::ratelimit::v3::RateLimitResponse::UNKNOWN);
+  parent_.onBatchComplete(*this, response.get());
+}
+
+void RateLimitBatcher::Batch::onFailure(Grpc::Status::GrpcStatus status, const std::string& msg,
+                                        Tracing::Span&) {
+  ASSERT(status != Grpc::Status::WellKnownGrpcStatus::Ok);
+  ENVOY_LOG_TO_LOGGER(Logger::Registry::getLog(Logger::Id::filter), debug,
+                      "batched rate limit fail, status={} msg={}", status, msg);
+  parent_.onBatchComplete(*this, nullptr);
+}
+
+RateLimitBatcher::RateLimitBatcher(const Grpc::RawAsyncClientSharedPtr& async_client,
+                                   const absl::optional<std::chrono::milliseconds>& timeout,
+                                   Event::Dispatcher& dispatcher, std::chrono::milliseconds window,
+                                   uint32_t max_descriptors,
+                                   std::chrono::milliseconds ok_lease_duration)
+    : async_client_(async_client), timeout_(timeout), dispatcher_(dispatcher), window_(window),
+      max_descriptors_(max_descriptors), ok_lease_duration_(ok_lease_duration),
+      service_method_(*Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
+          "envoy.service.ratelimit.v3.RateLimitService.ShouldRateLimit")),
+      flush_timer_(dispatcher.createTimer([this]() { flush(); })) {}
+
+RateLimitBatcher::~RateLimitBatcher() {
+  for (BatchPtr& batch : in_flight_) {
+    if (batch->rpc_ != nullptr) {
+      batch->rpc_->cancel();
+    }
+  }
+}
+
+void RateLimitBatcher::limit(BatchingClientImpl& client, const std::string& domain,
+                             const std::vector<Envoy::RateLimit::Descriptor>& descriptors,
+                             uint32_t hits_addend) {
+  std::string lease_key;
+  if (ok_lease_duration_.count() > 0) {
+    lease_key = leaseKey(domain, descriptors, hits_addend);
+    if (hasLease(lease_key)) {
+      client.complete(LimitStatus::OK, nullptr);
+      return;
+    }
+  }
+
+  const auto key = std::make_pair(domain, hits_addend);
+  BatchPtr& batch = pending_[key];
+  if (batch == nullptr) {
+    batch = std::make_unique<Batch>(*this, domain, hits_addend);
+  }
+  const int first_descriptor = batch->request_.descriptors_size();
+  GrpcClientImpl::createRequest(batch->request_, domain, descriptors, hits_addend);
+  batch->checks_.push_back(Check{&client, first_descriptor,
+                                 batch->request_.descriptors_size() - first_descriptor,
+                                 std::move(lease_key)});
+
+  if (static_cast<uint32_t>(batch->request_.descriptors_size()) >= max_descriptors_) {
+    BatchPtr full = std::move(batch);
+    pending_.erase(key);
+    send(std::move(full));
+  } else if (!flush_timer_->enabled()) {
+    flush_timer_->enableTimer(window_);
+  }
+}
+
+void RateLimitBatcher::cancel(BatchingClientImpl& client) {
+  const auto cancel_in = [&client](Batch& batch) {
+    for (Check& check : batch.checks_) {
+      if (check.client_ == &client) {
+        check.client_ = nullptr;
+        return true;
+      }
+    }
+    return false;
+  };
+  for (auto& [key, batch] : pending_) {
+    if (cancel_in(*batch)) {
+      return;
+    }
+  }
+  for (BatchPtr& batch : in_flight_) {
+    if (cancel_in(*batch)) {
+      return;
+    }
+  }
+}
+
+std::string
+RateLimitBatcher::leaseKey(const std::string& domain,
+                           const std::vector<Envoy::RateLimit::Descriptor>& descriptors,
+                           uint32_t hits_addend) {
+  // Separators that cannot be confused with each other, so that different descriptors never share
+  // a key.
+  std::string key = absl::StrCat(domain, "\x1d", hits_addend);
+  for (const Envoy::RateLimit::Descriptor& descriptor : descriptors) {
+    absl::StrAppend(&key, "\x1d");
+    for (const Envoy::RateLimit::DescriptorEntry& entry : descriptor.entries_) {
+      absl::StrAppend(&key, entry.key_, "\x1f", entry.value_, "\x1e");
+    }
+    if (descriptor.limit_) {
+      absl::StrAppend(&key, descriptor.limit_->requests_per_unit_, "/",
+                      static_cast<int>(descriptor.limit_->unit_));
+    }
+  }
+  return key;
+}
+
+bool RateLimitBatcher::hasLease(const std::string& lease_key) {
+  auto it = leases_.find(lease_key);
+  if (it == leases_.end()) {
+    return false;
+  }
+  if (it->second <= dispatcher_.timeSource().monotonicTime()) {
+    leases_.erase(it);
+    return false;
+  }
+  return true;
+}
+
+void RateLimitBatcher::flush() {
+  absl::flat_hash_map<std::pair<std::string, uint32_t>, BatchPtr> pending = std::move(pending_);
+  pending_.clear();
+  for (auto& [key, batch] : pending) {
+    send(std::move(batch));
+  }
+}
+
+void RateLimitBatcher::send(BatchPtr&& batch) {
+  Batch& sent = *batch;
+  in_flight_.push_front(std::move(batch));
+  sent.in_flight_position_ = in_flight_.begin();
+  // The batch may fail inline, in which case it has already been completed and is only deleted
+  // once this call returns.
+  sent.rpc_ = async_client_->send(service_method_, sent.request_, sent,
+                                  Tracing::NullSpan::instance(),
+                                  Http::AsyncClient::RequestOptions().setTimeout(timeout_));
+}
+
+void RateLimitBatcher::onBatchComplete(
+    Batch& batch, const envoy::service::ratelimit::v3::RateLimitResponse* response) {
+  // The batch stays in flight while its checks complete, so that clients cancelled by the callbacks
+  // of other clients are found.
+  const bool split_statuses =
+      response != nullptr && response->statuses_size() == batch.request_.descriptors_size();
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  for (Check& check : batch.checks_) {
+    BatchingClientImpl* client = check.client_;
+    if (client == nullptr) {
+      continue;
+    }
+    check.client_ = nullptr;
+    if (response == nullptr) {
+      client->complete(LimitStatus::Error, nullptr);
+      continue;
+    }
+
+    LimitStatus status = LimitStatus::OK;
+    DescriptorStatusListPtr descriptor_statuses;
+    if (split_statuses) {
+      const auto first = response->statuses().begin() + check.first_descriptor_;
+      descriptor_statuses =
+          std::make_unique<DescriptorStatusList>(first, first + check.num_descriptors_);
+      for (const auto& descriptor_status : *descriptor_statuses) {
+        if (descriptor_status.code() ==
+            envoy::service::ratelimit::v3::RateLimitResponse::OVER_LIMIT) {
+          status = LimitStatus::OverLimit;
+        }
+      }
+    } else if (response->overall_code() ==
+               envoy::service::ratelimit::v3::RateLimitResponse::OVER_LIMIT) {
+      // Without a status per descriptor, the checks in the batch cannot be told apart.
+      status = LimitStatus::OverLimit;
+    }
+
+    if (status == LimitStatus::OK && !check.lease_key_.empty()) {
+      if (leases_.size() >= MaxLeases) {
+        leases_.clear();
+      }
+      leases_[check.lease_key_] = now + ok_lease_duration_;
+    }
+    client->complete(status, std::move(descriptor_statuses));
+  }
+
+  batch.rpc_ = nullptr;
+  dispatcher_.deferredDelete(std::move(*batch.in_flight_position_));
+  in_flight_.erase(batch.in_flight_position_);
+}
+
+BatchingClientImpl::BatchingClientImpl(RateLimitBatcherSharedPtr batcher)
+    : batcher_(std::move(batcher)) {}
+
+BatchingClientImpl::~BatchingClientImpl() { ASSERT(!callbacks_); }
+
+void BatchingClientImpl::cancel() {
+  ASSERT(callbacks_ != nullptr);
+  batcher_->cancel(*this);
+  callbacks_ = nullptr;
+}
+
+void BatchingClientImpl::limit(RequestCallbacks& callbacks, const std::string& domain,
+                               const std::vector<Envoy::RateLimit::Descriptor>& descriptors,
+                               Tracing::Span&, const StreamInfo::StreamInfo&,
+                               uint32_t hits_addend) {
+  ASSERT(callbacks_ == nullptr);
+  callbacks_ = &callbacks;
+  batcher_->limit(*this, domain, descriptors, hits_addend);
+}
+
+void BatchingClientImpl::complete(LimitStatus status,
+                                  DescriptorStatusListPtr&& descriptor_statuses) {
+  ASSERT(callbacks_ != nullptr);
+  RequestCallbacks* callbacks = callbacks_;
+  callbacks_ = nullptr;
+  callbacks->complete(status, std::move(descriptor_statuses), nullptr, nullptr, EMPTY_STRING,
+                      nullptr);
+}
+
+} // namespace RateLimit
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
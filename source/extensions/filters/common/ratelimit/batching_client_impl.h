@@ -0,0 +1,150 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "envoy/event/deferred_deletable.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/grpc/async_client.h"
+#include "envoy/ratelimit/ratelimit.h"
+#include "envoy/service/ratelimit/v3/rls.pb.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/grpc/typed_async_client.h"
+#include "source/extensions/filters/common/ratelimit/ratelimit.h"
+#include "source/extensions/filters/common/ratelimit/ratelimit_impl.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RateLimit {
+
+class BatchingClientImpl;
+
+/**
+ * Collects the limit checks made on one worker for a short window and sends them to the rate limit
+ * service in one request per domain. Shared by the clients of all filters on the worker.
+ */
+class RateLimitBatcher : public Logger::Loggable<Logger::Id::filter> {
+public:
+  /**
+   * @param window how long checks are collected before they are sent.
+   * @param max_descriptors the most descriptors sent in one request.
+   * @param ok_lease_duration how long an allowed set of descriptors is allowed again without asking
+   *     the service. Zero disables leases.
+   */
+  RateLimitBatcher(const Grpc::RawAsyncClientSharedPtr& async_client,
+                   const absl::optional<std::chrono::milliseconds>& timeout,
+                   Event::Dispatcher& dispatcher, std::chrono::milliseconds window,
+                   uint32_t max_descriptors, std::chrono::milliseconds ok_lease_duration);
+  ~RateLimitBatcher();
+
+  /**
+   * Queues a check for client, or completes it immediately if the descriptors hold a lease.
+   */
+  void limit(BatchingClientImpl& client, const std::string& domain,
+             const std::vector<Envoy::RateLimit::Descriptor>& descriptors, uint32_t hits_addend);
+
+  /**
+   * Drops the outstanding check of client. Its request to the service is still made for the other
+   * checks in the same batch.
+   */
+  void cancel(BatchingClientImpl& client);
+
+  // How many leases are kept before they are all dropped.
+  static constexpr size_t MaxLeases = 16 * 1024;
+
+private:
+  struct Check {
+    BatchingClientImpl* client_;
+    // The range of this check's descriptors in the batched request.
+    int first_descriptor_;
+    int num_descriptors_;
+    std::string lease_key_;
+  };
+
+  class Batch : public RateLimitAsyncCallbacks, public Event::DeferredDeletable {
+  public:
+    Batch(RateLimitBatcher& parent, const std::string& domain, uint32_t hits_addend);
+
+    // Grpc::AsyncRequestCallbacks
+    void onCreateInitialMetadata(Http::RequestHeaderMap&) override {}
+    void onSuccess(std::unique_ptr<envoy::service::ratelimit::v3::RateLimitResponse>&& response,
+                   Tracing::Span& span) override;
+    void onFailure(Grpc::Status::GrpcStatus status, const std::string& message,
+                   Tracing::Span& span) override;
+
+    RateLimitBatcher& parent_;
+    envoy::service::ratelimit::v3::RateLimitRequest request_;
+    std::vector<Check> checks_;
+    Grpc::AsyncRequest* rpc_{};
+    std::list<std::unique_ptr<Batch>>::iterator in_flight_position_;
+  };
+  using BatchPtr = std::unique_ptr<Batch>;
+
+  static std::string leaseKey(const std::string& domain,
+                              const std::vector<Envoy::RateLimit::Descriptor>& descriptors,
+                              uint32_t hits_addend);
+  bool hasLease(const std::string& lease_key);
+  void flush();
+  void send(BatchPtr&& batch);
+  void onBatchComplete(Batch& batch,
+                       const envoy::service::ratelimit::v3::RateLimitResponse* response);
+
+  Grpc::AsyncClient<envoy::service::ratelimit::v3::RateLimitRequest,
+                    envoy::service::ratelimit::v3::RateLimitResponse>
+      async_client_;
+  const absl::optional<std::chrono::milliseconds> timeout_;
+  Event::Dispatcher& dispatcher_;
+  const std::chrono::milliseconds window_;
+  const uint32_t max_descriptors_;
+  const std::chrono::milliseconds ok_lease_duration_;
+  const Protobuf::MethodDescriptor& service_method_;
+  Event::TimerPtr flush_timer_;
+  // Batches still collecting checks, by domain and hits addend.
+  absl::flat_hash_map<std::pair<std::string, uint32_t>, BatchPtr> pending_;
+  std::list<BatchPtr> in_flight_;
+  absl::flat_hash_map<std::string, MonotonicTime> leases_;
+};
+
+using RateLimitBatcherSharedPtr = std::shared_ptr<RateLimitBatcher>;
+
+/**
+ * A client whose checks are sent through the worker's RateLimitBatcher.
+ */
+class BatchingClientImpl : public Client {
+public:
+  explicit BatchingClientImpl(RateLimitBatcherSharedPtr batcher);
+  ~BatchingClientImpl() override;
+
+  // Filters::Common::RateLimit::Client
+  void cancel() override;
+  void limit(RequestCallbacks& callbacks, const std::string& domain,
+             const std::vector<Envoy::RateLimit::Descriptor>& descriptors,
+             Tracing::Span& parent_span, const StreamInfo::StreamInfo& stream_info,
+             uint32_t hits_addend = 0) override;
+
+  /**
+   * Called by the batcher with the result of this client's check.
+   */
+  void complete(LimitStatus status, DescriptorStatusListPtr&& descriptor_statuses);
+
+private:
+  const RateLimitBatcherSharedPtr batcher_;
+  RequestCallbacks* callbacks_{};
+};
+
+} // namespace RateLimit
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
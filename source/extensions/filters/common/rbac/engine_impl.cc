@@ -42,12 +42,20 @@ void generateLog(StreamInfo::StreamInfo& info, EnforcementMode mode, bool log) {
 
 RoleBasedAccessControlEngineImpl::RoleBasedAccessControlEngineImpl(
     const envoy::config::rbac::v3::RBAC& rules,
-    ProtobufMessage::ValidationVisitor& validation_visitor, const EnforcementMode mode)
+    ProtobufMessage::ValidationVisitor& validation_visitor, const EnforcementMode mode,
+    Expr::BuilderInstanceSharedPtr builder)
     : action_(rules.action()), mode_(mode) {
   // guard expression builder by presence of a condition in policies
   for (const auto& policy : rules.policies()) {
     if (policy.second.has_condition()) {
-      builder_ = Expr::createBuilder(&constant_arena_);
+      if (builder != nullptr) {
+        builder_ = std::move(builder);
+      } else {
+        auto constant_arena = std::make_unique<Protobuf::Arena>();
+        auto own_builder = Expr::createBuilder(constant_arena.get());
+        builder_ = std::make_shared<Expr::BuilderInstance>(std::move(own_builder),
+                                                           std::move(constant_arena));
+      }
       break;
     }
   }
@@ -56,6 +64,16 @@ RoleBasedAccessControlEngineImpl::RoleBasedAccessControlEngineImpl(
     policies_.emplace(policy.first, std::make_unique<PolicyMatcher>(policy.second, builder_.get(),
                                                                     validation_visitor));
   }
+
+  std::vector<const envoy::config::rbac::v3::Policy*> ordered_policies;
+  for (auto it = policies_.begin(); it != policies_.end(); ++it) {
+    policy_positions_.push_back(it);
+    ordered_policies.push_back(&rules.policies().at(it->first));
+  }
+  auto policy_index = std::make_unique<PolicyIndex>(ordered_policies);
+  if (policy_index->indexesPolicies()) {
+    policy_index_ = std::move(policy_index);
+  }
 }
 
 bool RoleBasedAccessControlEngineImpl::handleAction(const Network::Connection& connection,
@@ -91,6 +109,20 @@ bool RoleBasedAccessControlEngineImpl::checkPolicyMatch(
     const Envoy::Http::RequestHeaderMap& headers, std::string* effective_policy_id) const {
   bool matched = false;
 
+  if (policy_index_ != nullptr) {
+    // Only the policies that may match are evaluated, in the same order as the full list.
+    for (const uint32_t position : policy_index_->candidates(connection, headers, info)) {
+      const auto& policy = *policy_positions_[position];
+      if (policy.second->matches(connection, headers, info)) {
+        if (effective_policy_id != nullptr) {
+          *effective_policy_id = policy.first;
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
   for (const auto& policy : policies_) {
     if (policy.second->matches(connection, headers, info)) {
       matched = true;
@@ -6,6 +6,7 @@
 #include "source/common/matcher/matcher.h"
 #include "source/extensions/filters/common/rbac/engine.h"
 #include "source/extensions/filters/common/rbac/matchers.h"
+#include "source/extensions/filters/common/rbac/policy_index.h"
 
 #include "xds/type/matcher/v3/matcher.pb.h"
 
@@ -63,9 +64,12 @@ void generateLog(StreamInfo::StreamInfo& info, EnforcementMode mode, bool log);
 
 class RoleBasedAccessControlEngineImpl : public RoleBasedAccessControlEngine, NonCopyable {
 public:
+  // Conditions are built with builder if one is given, which shares them with the other users of
+  // the builder. Otherwise, the engine creates its own builder.
   RoleBasedAccessControlEngineImpl(const envoy::config::rbac::v3::RBAC& rules,
                                    ProtobufMessage::ValidationVisitor& validation_visitor,
-                                   const EnforcementMode mode = EnforcementMode::Enforced);
+                                   const EnforcementMode mode = EnforcementMode::Enforced,
+                                   Expr::BuilderInstanceSharedPtr builder = nullptr);
 
   bool handleAction(const Network::Connection& connection,
                     const Envoy::Http::RequestHeaderMap& headers, StreamInfo::StreamInfo& info,
@@ -83,10 +87,14 @@ private:
   const envoy::config::rbac::v3::RBAC::Action action_;
   const EnforcementMode mode_;
 
-  std::map<std::string, std::unique_ptr<PolicyMatcher>> policies_;
+  using PolicyMap = std::map<std::string, std::unique_ptr<PolicyMatcher>>;
+  PolicyMap policies_;
+  // The policies by their position in policies_, which is the one used by policy_index_.
+  std::vector<PolicyMap::const_iterator> policy_positions_;
+  // Only set if any policy could be indexed.
+  std::unique_ptr<PolicyIndex> policy_index_;
 
-  Protobuf::Arena constant_arena_;
-  Expr::BuilderPtr builder_;
+  Expr::BuilderInstanceSharedPtr builder_;
 };
 
 class RoleBasedAccessControlMatcherEngineImpl : public RoleBasedAccessControlEngine, NonCopyable {
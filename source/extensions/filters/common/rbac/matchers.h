@@ -151,6 +151,12 @@ public:
   bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
                const StreamInfo::StreamInfo& info) const override;
 
+  /**
+   * @return the address of a request that a matcher of the given type matches against.
+   */
+  static const Network::Address::InstanceConstSharedPtr&
+  address(Type type, const Network::Connection& connection, const StreamInfo::StreamInfo& info);
+
 private:
   const Network::Address::CidrRange range_;
   const Type type_;
@@ -210,12 +216,12 @@ private:
  */
 class PolicyMatcher : public Matcher, NonCopyable {
 public:
-  PolicyMatcher(const envoy::config::rbac::v3::Policy& policy, Expr::Builder* builder,
+  PolicyMatcher(const envoy::config::rbac::v3::Policy& policy, Expr::BuilderInstance* builder,
                 ProtobufMessage::ValidationVisitor& validation_visitor)
       : permissions_(policy.permissions(), validation_visitor), principals_(policy.principals()),
         condition_(policy.condition()) {
     if (policy.has_condition()) {
-      expr_ = Expr::createExpression(*builder, condition_);
+      expr_ = builder->createSharedExpression(condition_);
     }
   }
 
@@ -226,7 +232,7 @@ private:
   const OrMatcher permissions_;
   const OrMatcher principals_;
   const google::api::expr::v1alpha1::Expr condition_;
-  Expr::ExpressionPtr expr_;
+  Expr::ExpressionSharedPtr expr_;
 };
 
 class MetadataMatcher : public Matcher {
@@ -0,0 +1,195 @@
+#include "source/extensions/filters/common/rbac/policy_index.h"
+
+#include <algorithm>
+
+#include "source/common/http/path_utility.h"
+#include "source/common/network/cidr_range.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+
+namespace {
+
+using AddressRanges = std::pair<IPMatcher::Type, std::vector<Network::Address::CidrRange>>;
+
+// Returns the kind and ranges of the addresses, if all ids are address ranges of the same kind.
+absl::optional<AddressRanges>
+principalAddressRanges(const Protobuf::RepeatedPtrField<envoy::config::rbac::v3::Principal>& ids) {
+  absl::optional<AddressRanges> ranges;
+  for (const auto& id : ids) {
+    IPMatcher::Type type;
+    const envoy::config::core::v3::CidrRange* range;
+    switch (id.identifier_case()) {
+    case envoy::config::rbac::v3::Principal::IdentifierCase::kSourceIp:
+      type = IPMatcher::Type::ConnectionRemote;
+      range = &id.source_ip();
+      break;
+    case envoy::config::rbac::v3::Principal::IdentifierCase::kDirectRemoteIp:
+      type = IPMatcher::Type::DownstreamDirectRemote;
+      range = &id.direct_remote_ip();
+      break;
+    case envoy::config::rbac::v3::Principal::IdentifierCase::kRemoteIp:
+      type = IPMatcher::Type::DownstreamRemote;
+      range = &id.remote_ip();
+      break;
+    default:
+      return absl::nullopt;
+    }
+    if (!ranges.has_value()) {
+      ranges.emplace(type, std::vector<Network::Address::CidrRange>());
+    } else if (ranges->first != type) {
+      return absl::nullopt;
+    }
+    ranges->second.push_back(Network::Address::CidrRange::create(*range));
+  }
+  return ranges;
+}
+
+// Returns the destination address ranges, if all rules are destination address ranges.
+absl::optional<AddressRanges> permissionAddressRanges(
+    const Protobuf::RepeatedPtrField<envoy::config::rbac::v3::Permission>& rules) {
+  if (rules.empty()) {
+    return absl::nullopt;
+  }
+  AddressRanges ranges{IPMatcher::Type::DownstreamLocal, {}};
+  for (const auto& rule : rules) {
+    if (rule.rule_case() != envoy::config::rbac::v3::Permission::RuleCase::kDestinationIp) {
+      return absl::nullopt;
+    }
+    ranges.second.push_back(Network::Address::CidrRange::create(rule.destination_ip()));
+  }
+  return ranges;
+}
+
+void append(PolicyIndex::Candidates& candidates, const std::vector<uint32_t>& positions) {
+  candidates.insert(candidates.end(), positions.begin(), positions.end());
+}
+
+} // namespace
+
+PolicyIndex::PolicyIndex(const std::vector<const envoy::config::rbac::v3::Policy*>& policies) {
+  std::array<std::vector<std::pair<uint32_t, std::vector<Network::Address::CidrRange>>>,
+             NumAddressTypes>
+      address_ranges;
+  for (uint32_t position = 0; position < policies.size(); ++position) {
+    const envoy::config::rbac::v3::Policy& policy = *policies[position];
+    if (indexedByExactPath(position, policy)) {
+      continue;
+    }
+    absl::optional<AddressRanges> ranges = principalAddressRanges(policy.principals());
+    if (!ranges.has_value()) {
+      ranges = permissionAddressRanges(policy.permissions());
+    }
+    if (ranges.has_value()) {
+      // Invalid ranges never match, so they are left out.
+      auto& valid_ranges = address_ranges[ranges->first].emplace_back(position, ranges->second);
+      valid_ranges.second.erase(
+          std::remove_if(valid_ranges.second.begin(), valid_ranges.second.end(),
+                         [](const Network::Address::CidrRange& range) { return !range.isValid(); }),
+          valid_ranges.second.end());
+      indexed_ = true;
+      continue;
+    }
+    if (indexedByPort(position, policy)) {
+      continue;
+    }
+    unindexed_.push_back(position);
+  }
+
+  for (size_t type = 0; type < NumAddressTypes; ++type) {
+    if (!address_ranges[type].empty()) {
+      address_tries_[type] = std::make_unique<AddressTrie>(address_ranges[type]);
+    }
+  }
+}
+
+bool PolicyIndex::indexedByExactPath(uint32_t position,
+                                     const envoy::config::rbac::v3::Policy& policy) {
+  if (policy.permissions().empty()) {
+    return false;
+  }
+  for (const auto& rule : policy.permissions()) {
+    if (rule.rule_case() != envoy::config::rbac::v3::Permission::RuleCase::kUrlPath ||
+        !rule.url_path().has_path() ||
+        rule.url_path().path().match_pattern_case() !=
+            envoy::type::matcher::v3::StringMatcher::MatchPatternCase::kExact ||
+        rule.url_path().path().ignore_case()) {
+      return false;
+    }
+  }
+  for (const auto& rule : policy.permissions()) {
+    std::vector<uint32_t>& positions = exact_paths_[rule.url_path().path().exact()];
+    if (positions.empty() || positions.back() != position) {
+      positions.push_back(position);
+    }
+  }
+  indexed_ = true;
+  return true;
+}
+
+bool PolicyIndex::indexedByPort(uint32_t position, const envoy::config::rbac::v3::Policy& policy) {
+  if (policy.permissions().empty()) {
+    return false;
+  }
+  for (const auto& rule : policy.permissions()) {
+    if (rule.rule_case() != envoy::config::rbac::v3::Permission::RuleCase::kDestinationPort) {
+      return false;
+    }
+  }
+  for (const auto& rule : policy.permissions()) {
+    std::vector<uint32_t>& positions = ports_[rule.destination_port()];
+    if (positions.empty() || positions.back() != position) {
+      positions.push_back(position);
+    }
+  }
+  indexed_ = true;
+  return true;
+}
+
+PolicyIndex::Candidates PolicyIndex::candidates(const Network::Connection& connection,
+                                                const Envoy::Http::RequestHeaderMap& headers,
+                                                const StreamInfo::StreamInfo& info) const {
+  Candidates candidates(unindexed_.begin(), unindexed_.end());
+
+  if (!exact_paths_.empty() && headers.Path() != nullptr) {
+    const auto it =
+        exact_paths_.find(Http::PathUtil::removeQueryAndFragment(headers.getPathValue()));
+    if (it != exact_paths_.end()) {
+      append(candidates, it->second);
+    }
+  }
+
+  for (size_t type = 0; type < NumAddressTypes; ++type) {
+    if (address_tries_[type] == nullptr) {
+      continue;
+    }
+    const Network::Address::InstanceConstSharedPtr& address =
+        IPMatcher::address(static_cast<IPMatcher::Type>(type), connection, info);
+    if (address != nullptr) {
+      append(candidates, address_tries_[type]->getData(address));
+    }
+  }
+
+  if (!ports_.empty()) {
+    const Network::Address::Ip* ip = info.downstreamAddressProvider().localAddress()->ip();
+    if (ip != nullptr) {
+      const auto it = ports_.find(ip->port());
+      if (it != ports_.end()) {
+        append(candidates, it->second);
+      }
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+  return candidates;
+}
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
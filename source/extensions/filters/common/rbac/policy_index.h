@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/config/rbac/v3/rbac.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/network/connection.h"
+#include "envoy/stream_info/stream_info.h"
+
+#include "source/common/network/lc_trie.h"
+#include "source/extensions/filters/common/rbac/matchers.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+
+/**
+ * Indexes RBAC policies by a condition that every request matching the policy meets, so that only
+ * the policies that may match a request are evaluated for it. A policy is indexed if all of its
+ * permissions are exact URL paths, all of its principals are address ranges of one kind, all of
+ * its permissions are destination address ranges, or all of its permissions are destination ports,
+ * in this order of preference. The other policies may match any request.
+ */
+class PolicyIndex {
+public:
+  using Candidates = absl::InlinedVector<uint32_t, 16>;
+
+  /**
+   * @param policies the policies in the order they are evaluated in.
+   */
+  explicit PolicyIndex(const std::vector<const envoy::config::rbac::v3::Policy*>& policies);
+
+  /**
+   * @return whether any of the policies could be indexed.
+   */
+  bool indexesPolicies() const { return indexed_; }
+
+  /**
+   * @return the positions of the policies that may match the request, in evaluation order.
+   */
+  Candidates candidates(const Network::Connection& connection,
+                        const Envoy::Http::RequestHeaderMap& headers,
+                        const StreamInfo::StreamInfo& info) const;
+
+private:
+  using AddressTrie = Network::LcTrie::LcTrie<uint32_t>;
+  // The number of IPMatcher types.
+  static constexpr size_t NumAddressTypes = 4;
+
+  bool indexedByExactPath(uint32_t position, const envoy::config::rbac::v3::Policy& policy);
+  bool indexedByPort(uint32_t position, const envoy::config::rbac::v3::Policy& policy);
+
+  bool indexed_{};
+  std::vector<uint32_t> unindexed_;
+  absl::flat_hash_map<std::string, std::vector<uint32_t>> exact_paths_;
+  absl::flat_hash_map<uint32_t, std::vector<uint32_t>> ports_;
+  // The address tries, by IPMatcher::Type.
+  std::array<std::unique_ptr<AddressTrie>, NumAddressTypes> address_tries_;
+};
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -50,8 +50,8 @@ createEngine(const ConfigType& config, Server::Configuration::ServerFactoryConte
         config.matcher(), context, action_validation_visitor, EnforcementMode::Enforced);
   }
   if (config.has_rules()) {
-    return std::make_unique<RoleBasedAccessControlEngineImpl>(config.rules(), validation_visitor,
-                                                              EnforcementMode::Enforced);
+    return std::make_unique<RoleBasedAccessControlEngineImpl>(
+        config.rules(), validation_visitor, EnforcementMode::Enforced, Expr::getBuilder(context));
   }
 
   return nullptr;
@@ -71,7 +71,8 @@ createShadowEngine(const ConfigType& config, Server::Configuration::ServerFactor
   }
   if (config.has_shadow_rules()) {
     return std::make_unique<RoleBasedAccessControlEngineImpl>(
-        config.shadow_rules(), validation_visitor, EnforcementMode::Shadow);
+        config.shadow_rules(), validation_visitor, EnforcementMode::Shadow,
+        Expr::getBuilder(context));
   }
 
   return nullptr;
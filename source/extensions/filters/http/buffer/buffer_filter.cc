@@ -37,6 +37,14 @@ BufferFilterConfig::BufferFilterConfig(
 BufferFilter::BufferFilter(BufferFilterConfigSharedPtr config)
     : config_(config), settings_(config->settings()) {}
 
+void BufferFilter::resetForReuse() {
+  settings_ = config_->settings();
+  callbacks_ = nullptr;
+  request_headers_ = nullptr;
+  content_length_ = 0;
+  config_initialized_ = false;
+}
+
 void BufferFilter::initConfig() {
   ASSERT(!config_initialized_);
   config_initialized_ = true;
@@ -9,6 +9,7 @@
 #include "envoy/http/filter.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/stream_filter_pool.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -21,6 +22,7 @@ public:
   BufferFilterSettings(const envoy::extensions::filters::http::buffer::v3::BufferPerRoute&);
 
   bool disabled() const { return disabled_; }
+  bool disablesFilter() const override { return disabled_; }
   uint64_t maxRequestBytes() const { return max_request_bytes_; }
 
 private:
@@ -46,10 +48,13 @@ using BufferFilterConfigSharedPtr = std::shared_ptr<BufferFilterConfig>;
 /**
  * A filter that is capable of buffering an entire request before dispatching it upstream.
  */
-class BufferFilter : public Http::StreamDecoderFilter {
+class BufferFilter : public Http::StreamDecoderFilter, public Http::ReusableStreamFilter {
 public:
   BufferFilter(BufferFilterConfigSharedPtr config);
 
+  // Http::ReusableStreamFilter
+  void resetForReuse() override;
+
   // Http::StreamFilterBase
   void onDestroy() override {}
 
@@ -7,6 +7,7 @@
 #include "envoy/extensions/filters/http/buffer/v3/buffer.pb.h"
 #include "envoy/extensions/filters/http/buffer/v3/buffer.pb.validate.h"
 #include "envoy/registry/registry.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/extensions/filters/http/buffer/buffer_filter.h"
 
@@ -15,14 +16,26 @@ namespace Extensions {
 namespace HttpFilters {
 namespace BufferFilter {
 
+namespace {
+
+using FilterPool = Http::StreamFilterPool<BufferFilter>;
+
+} // namespace
+
 absl::StatusOr<Http::FilterFactoryCb> BufferFilterFactory::createFilterFactoryFromProtoTyped(
     const envoy::extensions::filters::http::buffer::v3::Buffer& proto_config, const std::string&,
-    DualInfo, Server::Configuration::ServerFactoryContext&) {
+    DualInfo, Server::Configuration::ServerFactoryContext& context) {
   ASSERT(proto_config.has_max_request_bytes());
 
   BufferFilterConfigSharedPtr filter_config(new BufferFilterConfig(proto_config));
-  return [filter_config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addStreamDecoderFilter(std::make_shared<BufferFilter>(filter_config));
+  // The filters of each worker are reused for later streams. The pools are owned by the factory
+  // callback rather than the config, which the pooled filters reference.
+  std::shared_ptr<ThreadLocal::TypedSlot<FilterPool>> pool =
+      ThreadLocal::TypedSlot<FilterPool>::makeUnique(context.threadLocal());
+  pool->set([](Event::Dispatcher&) { return std::make_shared<FilterPool>(); });
+  return [filter_config, pool](Http::FilterChainFactoryCallbacks& callbacks) -> void {
+    callbacks.addStreamDecoderFilter(
+        (*pool)->acquire([&]() { return std::make_unique<BufferFilter>(filter_config); }));
   };
 }
 
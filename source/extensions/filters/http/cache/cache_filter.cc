@@ -175,6 +175,10 @@ Http::FilterHeadersStatus CacheFilter::encodeHeaders(Http::ResponseHeaderMap& he
     // insertion yet.
   } else {
     insert_status_ = InsertStatus::NoInsertResponseNotCacheable;
+    // The lookup is no longer needed. Releasing it now lets a cache that coalesces concurrent
+    // misses resume the lookups waiting for this response.
+    lookup_->onDestroy();
+    lookup_ = nullptr;
   }
   filter_state_ = FilterState::NotServingFromCache;
   return Http::FilterHeadersStatus::Continue;
@@ -441,7 +445,13 @@ void CacheFilter::onBody(Buffer::InstancePtr&& body) {
   ASSERT(!remaining_ranges_.empty(),
          "CacheFilter doesn't call getBody unless there's more body to get, so this is a "
          "bogus callback.");
-  ASSERT(body, "Cache said it had a body, but isn't giving it to us.");
+  if (body == nullptr) {
+    // The cache failed to read the body, e.g. because a response it was streaming was never
+    // completed. The headers have been sent, so the response can only be aborted.
+    filter_state_ == FilterState::DecodeServingFromCache ? decoder_callbacks_->resetStream()
+                                                         : encoder_callbacks_->resetStream();
+    return;
+  }
 
   const uint64_t bytes_from_cache = body->length();
   if (bytes_from_cache < remaining_ranges_[0].length()) {
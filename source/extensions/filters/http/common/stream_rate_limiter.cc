@@ -20,11 +20,11 @@ StreamRateLimiter::StreamRateLimiter(
     std::function<void(uint64_t, bool, std::chrono::milliseconds)> write_stats_cb,
     TimeSource& time_source, Event::Dispatcher& dispatcher, const ScopeTrackedObject& scope,
     std::shared_ptr<TokenBucket> token_bucket, std::chrono::milliseconds fill_interval)
-    : fill_interval_(std::move(fill_interval)), write_data_cb_(write_data_cb),
-      continue_cb_(continue_cb), write_stats_cb_(std::move(write_stats_cb)), scope_(scope),
-      token_bucket_(std::move(token_bucket)),
+    : fill_interval_(std::move(fill_interval)), write_data_cb_(std::move(write_data_cb)),
+      continue_cb_(std::move(continue_cb)), write_stats_cb_(std::move(write_stats_cb)),
+      scope_(scope), token_bucket_(std::move(token_bucket)),
       token_timer_(dispatcher.createTimer([this] { onTokenTimer(); })),
-      buffer_(resume_data_cb, pause_data_cb,
+      buffer_(std::move(resume_data_cb), std::move(pause_data_cb),
               []() -> void { /* TODO(adisuissa): Handle overflow watermark */ }) {
   ASSERT(max_buffered_data > 0);
   ASSERT(fill_interval_.count() > 0);
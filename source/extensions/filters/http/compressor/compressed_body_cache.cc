@@ -0,0 +1,57 @@
+#include "source/extensions/filters/http/compressor/compressed_body_cache.h"
+
+#include <utility>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Compressor {
+
+CompressedBodyCache::CompressedBodyCache(uint32_t max_body_bytes, uint64_t max_size_bytes)
+    : max_body_bytes_(max_body_bytes), max_size_bytes_(max_size_bytes) {}
+
+std::shared_ptr<const std::string> CompressedBodyCache::lookup(const std::string& body) {
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(body);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position_);
+  return it->second.compressed_;
+}
+
+void CompressedBodyCache::insert(std::string body, std::string compressed) {
+  ASSERT(body.size() <= max_body_bytes_);
+  const uint64_t entry_size = body.size() + compressed.size();
+  if (entry_size > max_size_bytes_) {
+    return;
+  }
+  absl::MutexLock lock(&mutex_);
+  auto [it, inserted] = entries_.try_emplace(std::move(body));
+  if (!inserted) {
+    // Another stream compressed the same body at the same time.
+    return;
+  }
+  lru_.push_front(&it->first);
+  it->second = Entry{std::make_shared<const std::string>(std::move(compressed)), lru_.begin()};
+  size_bytes_ += entry_size;
+  while (size_bytes_ > max_size_bytes_) {
+    auto oldest = entries_.find(*lru_.back());
+    ASSERT(oldest != entries_.end());
+    size_bytes_ -= oldest->first.size() + oldest->second.compressed_->size();
+    lru_.pop_back();
+    entries_.erase(oldest);
+  }
+}
+
+uint64_t CompressedBodyCache::sizeBytes() {
+  absl::MutexLock lock(&mutex_);
+  return size_bytes_;
+}
+
+} // namespace Compressor
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/node_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Compressor {
+
+/**
+ * Remembers the compressed form of small response bodies, so that a body which is sent over and
+ * over, such as a direct response or a cached asset, is compressed only once. Shared by all
+ * workers, and bounded by evicting the least recently used bodies.
+ */
+class CompressedBodyCache {
+public:
+  /**
+   * @param max_body_bytes the size of the largest uncompressed body that is remembered.
+   * @param max_size_bytes the total size of the uncompressed and compressed bodies remembered.
+   */
+  CompressedBodyCache(uint32_t max_body_bytes, uint64_t max_size_bytes);
+
+  uint32_t maxBodyBytes() const { return max_body_bytes_; }
+
+  /**
+   * @param body an uncompressed body.
+   * @return the compressed form of body, or nullptr if it is not remembered.
+   */
+  std::shared_ptr<const std::string> lookup(const std::string& body) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  /**
+   * Remembers the compressed form of body.
+   * @param body an uncompressed body of at most maxBodyBytes() bytes.
+   * @param compressed the complete compressed stream for body.
+   */
+  void insert(std::string body, std::string compressed) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  uint64_t sizeBytes() ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  struct Entry {
+    std::shared_ptr<const std::string> compressed_;
+    std::list<const std::string*>::iterator lru_position_;
+  };
+
+  const uint32_t max_body_bytes_;
+  const uint64_t max_size_bytes_;
+
+  absl::Mutex mutex_;
+  // node_hash_map keeps its keys in place, so that lru_ can point at them.
+  absl::node_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  // The keys of entries_, most recently used first.
+  std::list<const std::string*> lru_ ABSL_GUARDED_BY(mutex_);
+  uint64_t size_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+using CompressedBodyCacheSharedPtr = std::shared_ptr<CompressedBodyCache>;
+
+} // namespace Compressor
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
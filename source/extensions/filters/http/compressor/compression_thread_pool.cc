@@ -0,0 +1,69 @@
+#include "source/extensions/filters/http/compressor/compression_thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Compressor {
+
+CompressionThreadPool::CompressionThreadPool(uint32_t thread_count) {
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  thread_pool_.reserve(thread_count);
+  while (thread_pool_.size() < thread_count) {
+    thread_pool_.emplace_back([this]() { worker(); });
+  }
+}
+
+CompressionThreadPool::~CompressionThreadPool() {
+  {
+    absl::MutexLock lock(&queue_mutex_);
+    terminate_ = true;
+  }
+  while (!thread_pool_.empty()) {
+    thread_pool_.back().join();
+    thread_pool_.pop_back();
+  }
+}
+
+void CompressionThreadPool::post(std::function<void()> job) {
+  absl::MutexLock lock(&queue_mutex_);
+  queue_.push(std::move(job));
+}
+
+CompressionThreadPoolSharedPtr CompressionThreadPoolRegistry::get(uint32_t thread_count) {
+  std::weak_ptr<CompressionThreadPool>& weak_pool = pools_[thread_count];
+  CompressionThreadPoolSharedPtr pool = weak_pool.lock();
+  if (pool == nullptr) {
+    pool = std::make_shared<CompressionThreadPool>(thread_count);
+    weak_pool = pool;
+  }
+  return pool;
+}
+
+void CompressionThreadPool::worker() {
+  while (true) {
+    const auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(queue_mutex_) {
+      return !queue_.empty() || terminate_;
+    };
+    std::function<void()> job;
+    {
+      absl::MutexLock lock(&queue_mutex_);
+      queue_mutex_.Await(absl::Condition(&condition));
+      if (terminate_) {
+        return;
+      }
+      job = std::move(queue_.front());
+      queue_.pop();
+    }
+    job();
+  }
+}
+
+} // namespace Compressor
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
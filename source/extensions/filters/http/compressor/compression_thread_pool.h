@@ -0,0 +1,61 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "envoy/singleton/instance.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Compressor {
+
+/**
+ * Threads shared by all workers which compress response bodies, so that slow compression does not
+ * hold up the event loops of the workers.
+ */
+class CompressionThreadPool {
+public:
+  // A thread_count of 0 uses one thread per hardware thread.
+  explicit CompressionThreadPool(uint32_t thread_count);
+  // Jobs that have not started yet are dropped.
+  ~CompressionThreadPool() ABSL_LOCKS_EXCLUDED(queue_mutex_);
+
+  // Runs job on one of the pool's threads. Jobs start in the order they are posted.
+  void post(std::function<void()> job) ABSL_LOCKS_EXCLUDED(queue_mutex_);
+
+private:
+  void worker() ABSL_LOCKS_EXCLUDED(queue_mutex_);
+
+  absl::Mutex queue_mutex_;
+  std::queue<std::function<void()>> queue_ ABSL_GUARDED_BY(queue_mutex_);
+  bool terminate_ ABSL_GUARDED_BY(queue_mutex_) = false;
+  std::vector<std::thread> thread_pool_;
+};
+using CompressionThreadPoolSharedPtr = std::shared_ptr<CompressionThreadPool>;
+
+/**
+ * The compression thread pools of the process. Filter configs with the same thread count share one
+ * pool, which lives as long as any of them, so that HCMs and their LDS updates do not each start
+ * their own threads. Only used on the main thread.
+ */
+class CompressionThreadPoolRegistry : public Singleton::Instance {
+public:
+  CompressionThreadPoolSharedPtr get(uint32_t thread_count);
+
+private:
+  absl::flat_hash_map<uint32_t, std::weak_ptr<CompressionThreadPool>> pools_;
+};
+using CompressionThreadPoolRegistrySharedPtr = std::shared_ptr<CompressionThreadPoolRegistry>;
+
+} // namespace Compressor
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -9,6 +9,8 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Compressor {
 
+SINGLETON_MANAGER_REGISTRATION(compression_thread_pool_registry);
+
 namespace {
 
 using envoy::extensions::filters::http::compressor::v3::CompressorPerRoute;
@@ -22,6 +24,11 @@ Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::Respons
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders>
     vary_handle(Http::CustomHeaders::get().Vary);
 
+// Names the dictionary that a client has, see https://www.rfc-editor.org/rfc/rfc9842.
+const Http::LowerCaseString& availableDictionaryHeader() {
+  CONSTRUCT_ON_FIRST_USE(Http::LowerCaseString, "available-dictionary");
+}
+
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
     request_content_encoding_handle(Http::CustomHeaders::get().ContentEncoding);
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders>
@@ -30,6 +37,12 @@ Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::Respons
 // Default minimum length of an upstream response that allows compression.
 const uint64_t DefaultMinimumContentLength = 30;
 
+// Default number of response body bytes after which compression is offloaded.
+const uint32_t DefaultOffloadMinBodyBytes = 64 * 1024;
+
+// Default size of the largest response body whose compressed form is remembered.
+const uint32_t DefaultCompressedBodyCacheMaxBodyBytes = 64 * 1024;
+
 // Default content types will be used if any is provided by the user.
 const std::vector<std::string>& defaultContentEncoding() {
   CONSTRUCT_ON_FIRST_USE(std::vector<std::string>, {"text/html",
@@ -62,6 +75,32 @@ struct CompressorRegistry : public StreamInfo::FilterState::Object {
 // Key to per stream CompressorRegistry objects.
 const std::string& compressorRegistryKey() { CONSTRUCT_ON_FIRST_USE(std::string, "compressors"); }
 
+CompressedBodyCacheSharedPtr makeCompressedBodyCache(
+    const envoy::extensions::filters::http::compressor::v3::Compressor& config) {
+  if (!config.has_compressed_body_cache()) {
+    return nullptr;
+  }
+  const auto& cache_config = config.compressed_body_cache();
+  return std::make_shared<CompressedBodyCache>(
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(cache_config, max_body_bytes,
+                                      DefaultCompressedBodyCacheMaxBodyBytes),
+      cache_config.max_size_bytes().value());
+}
+
+CompressionThreadPoolSharedPtr
+makeOffloadThreadPool(const envoy::extensions::filters::http::compressor::v3::Compressor& config,
+                      Singleton::Manager& singleton_manager) {
+  if (!config.has_offload()) {
+    return nullptr;
+  }
+  // The configs only keep their pools, so the registry is pinned to still find them next time.
+  return singleton_manager
+      .getTyped<CompressionThreadPoolRegistry>(
+          SINGLETON_MANAGER_REGISTERED_NAME(compression_thread_pool_registry),
+          [] { return std::make_shared<CompressionThreadPoolRegistry>(); }, /* pin = */ true)
+      ->get(config.offload().thread_count());
+}
+
 void compressAndUpdateStats(const Compression::Compressor::CompressorPtr& compressor,
                             const CompressorStats& stats, Buffer::Instance& data, bool end_stream) {
   ASSERT(compressor != nullptr);
@@ -86,6 +125,7 @@ CompressorFilterConfig::DirectionConfig::DirectionConfig(
 CompressorFilterConfig::CompressorFilterConfig(
     const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config,
     const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
+    Singleton::Manager& singleton_manager,
     Compression::Compressor::CompressorFactoryPtr compressor_factory)
     : common_stats_prefix_(fmt::format("{}compressor.{}.{}", stats_prefix,
                                        proto_config.compressor_library().name(),
@@ -94,7 +134,11 @@ CompressorFilterConfig::CompressorFilterConfig(
       response_direction_config_(proto_config, common_stats_prefix_, scope, runtime),
       content_encoding_(compressor_factory->contentEncoding()),
       compressor_factory_(std::move(compressor_factory)),
-      choose_first_(proto_config.choose_first()) {}
+      choose_first_(proto_config.choose_first()),
+      offload_thread_pool_(makeOffloadThreadPool(proto_config, singleton_manager)),
+      offload_min_body_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+          proto_config.offload(), min_body_bytes, DefaultOffloadMinBodyBytes)),
+      compressed_body_cache_(makeCompressedBodyCache(proto_config)) {}
 
 StringUtil::CaseUnorderedSet CompressorFilterConfig::DirectionConfig::contentTypeSet(
     const Protobuf::RepeatedPtrField<std::string>& types) {
@@ -200,6 +244,11 @@ Http::FilterHeadersStatus CompressorFilter::decodeHeaders(Http::RequestHeaderMap
     // decision on compressing the corresponding HTTP response.
     accept_encoding_ = std::make_unique<std::string>(accept_encoding->value().getStringView());
   }
+  const auto available_dictionary = headers.get(availableDictionaryHeader());
+  if (!available_dictionary.empty()) {
+    available_dictionary_ = std::string(
+        StringUtil::trim(available_dictionary[0]->value().getStringView()));
+  }
 
   const auto& response_config = config_->responseDirectionConfig();
   const auto* per_route_config =
@@ -309,6 +358,27 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
 }
 
 Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool end_stream) {
+  const bool whole_body = end_stream && !response_data_seen_;
+  response_data_seen_ = true;
+  CompressedBodyCache* compressed_body_cache = config_->compressedBodyCache();
+  if (response_compressor_ != nullptr && whole_body && compressed_body_cache != nullptr &&
+      data.length() <= compressed_body_cache->maxBodyBytes()) {
+    compressWholeBody(*compressed_body_cache, data);
+    return Http::FilterDataStatus::Continue;
+  }
+  if (response_compressor_ != nullptr && config_->offloadThreadPool() != nullptr) {
+    response_body_bytes_ += data.length();
+    if (response_body_bytes_ >= config_->offloadMinBodyBytes()) {
+      offload_compressor_ = std::move(response_compressor_);
+    }
+  }
+  if (offload_compressor_ != nullptr) {
+    offload_pending_.move(data);
+    offload_end_stream_ = end_stream;
+    maybeOffloadCompression();
+    updateOffloadWatermark();
+    return Http::FilterDataStatus::StopIterationNoBuffer;
+  }
   if (response_compressor_ != nullptr) {
     compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(), data,
                            end_stream);
@@ -317,6 +387,13 @@ Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool
 }
 
 Http::FilterTrailersStatus CompressorFilter::encodeTrailers(Http::ResponseTrailerMap&) {
+  if (offload_compressor_ != nullptr) {
+    // The trailers continue once the rest of the body has been compressed and sent.
+    offload_end_stream_ = true;
+    offload_trailers_ = true;
+    maybeOffloadCompression();
+    return Http::FilterTrailersStatus::StopIteration;
+  }
   if (response_compressor_ != nullptr) {
     Buffer::OwnedImpl empty_buffer;
     // The presence of trailers means the stream is ended, but encodeData()
@@ -329,6 +406,93 @@ Http::FilterTrailersStatus CompressorFilter::encodeTrailers(Http::ResponseTraile
   return Http::FilterTrailersStatus::Continue;
 }
 
+void CompressorFilter::compressWholeBody(CompressedBodyCache& cache, Buffer::Instance& data) {
+  const auto& config = config_->responseDirectionConfig();
+  std::string body = data.toString();
+  config.stats().total_uncompressed_bytes_.add(body.size());
+  if (std::shared_ptr<const std::string> compressed = cache.lookup(body); compressed != nullptr) {
+    config.responseStats().compressed_body_cache_hit_.inc();
+    data.drain(data.length());
+    data.add(*compressed);
+  } else {
+    response_compressor_->compress(data, Envoy::Compression::Compressor::State::Finish);
+    cache.insert(std::move(body), data.toString());
+  }
+  config.stats().total_compressed_bytes_.add(data.length());
+}
+
+void CompressorFilter::onDestroy() {
+  *alive_ = false;
+  if (offload_above_watermark_) {
+    offload_above_watermark_ = false;
+    encoder_callbacks_->onEncoderFilterBelowWriteBufferLowWatermark();
+  }
+}
+
+void CompressorFilter::maybeOffloadCompression() {
+  if (offload_in_flight_ || offload_finished_ ||
+      (offload_pending_.length() == 0 && !offload_end_stream_)) {
+    return;
+  }
+  auto data = std::make_shared<Buffer::OwnedImpl>();
+  data->move(offload_pending_);
+  const bool end_stream = offload_end_stream_;
+  offload_in_flight_ = true;
+  offload_in_flight_bytes_ = data->length();
+  offload_finished_ = end_stream;
+  config_->offloadThreadPool()->post([this, compressor = offload_compressor_, data, end_stream,
+                                      uncompressed_bytes = offload_in_flight_bytes_,
+                                      alive = alive_,
+                                      &dispatcher = encoder_callbacks_->dispatcher()]() {
+    compressor->compress(*data, end_stream ? Envoy::Compression::Compressor::State::Finish
+                                           : Envoy::Compression::Compressor::State::Flush);
+    if (!*alive) {
+      // Nobody is waiting for the result, and the worker may be shutting down.
+      return;
+    }
+    dispatcher.post([this, data, uncompressed_bytes, end_stream, alive]() {
+      if (*alive) {
+        onOffloadedCompressionDone(*data, uncompressed_bytes, end_stream);
+      }
+    });
+  });
+}
+
+void CompressorFilter::onOffloadedCompressionDone(Buffer::Instance& data,
+                                                  uint64_t uncompressed_bytes, bool end_stream) {
+  const CompressorStats& stats = config_->responseDirectionConfig().stats();
+  stats.total_uncompressed_bytes_.add(uncompressed_bytes);
+  stats.total_compressed_bytes_.add(data.length());
+  offload_in_flight_ = false;
+  offload_in_flight_bytes_ = 0;
+  const bool end_data = end_stream && !offload_trailers_;
+  if (data.length() > 0 || end_data) {
+    encoder_callbacks_->injectEncodedDataToFilterChain(data, end_data);
+  }
+  if (end_stream && offload_trailers_) {
+    updateOffloadWatermark();
+    encoder_callbacks_->continueEncoding();
+    return;
+  }
+  maybeOffloadCompression();
+  updateOffloadWatermark();
+}
+
+void CompressorFilter::updateOffloadWatermark() {
+  const uint64_t buffered_bytes = offload_pending_.length() + offload_in_flight_bytes_;
+  const uint64_t limit = encoder_callbacks_->encoderBufferLimit();
+  if (limit == 0) {
+    return;
+  }
+  if (!offload_above_watermark_ && buffered_bytes > limit) {
+    offload_above_watermark_ = true;
+    encoder_callbacks_->onEncoderFilterAboveWriteBufferHighWatermark();
+  } else if (offload_above_watermark_ && buffered_bytes <= limit / 2) {
+    offload_above_watermark_ = false;
+    encoder_callbacks_->onEncoderFilterBelowWriteBufferLowWatermark();
+  }
+}
+
 bool CompressorFilter::hasCacheControlNoTransform(Http::ResponseHeaderMap& headers) const {
   const Http::HeaderEntry* cache_control = headers.getInline(cache_control_handle.handle());
   if (cache_control) {
@@ -386,6 +550,13 @@ CompressorFilter::chooseEncoding(const Http::ResponseHeaderMap& headers) const {
       }
     }
 
+    // A compressor using a dictionary shared with clients can only be used if the client has
+    // announced that it has the same dictionary.
+    const std::string dictionary = filter_config->availableDictionary();
+    if (!dictionary.empty() && dictionary != available_dictionary_) {
+      continue;
+    }
+
     // There could be many compressors registered for the same content encoding, e.g. consider a
     // case when there are two gzip filters using different compression levels for different content
     // sizes. In such case we ignore duplicates (or different filters for the same encoding)
@@ -609,18 +780,23 @@ bool CompressorFilter::isTransferEncodingAllowed(Http::RequestOrResponseHeaderMa
 }
 
 void CompressorFilter::insertVaryHeader(Http::ResponseHeaderMap& headers) {
+  appendVaryValue(headers, Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+  if (!config_->availableDictionary().empty()) {
+    appendVaryValue(headers, availableDictionaryHeader().get());
+  }
+}
+
+void CompressorFilter::appendVaryValue(Http::ResponseHeaderMap& headers,
+                                       const std::string& value) {
   const Http::HeaderEntry* vary = headers.getInline(vary_handle.handle());
   if (vary != nullptr) {
-    if (!StringUtil::findToken(vary->value().getStringView(), ",",
-                               Http::CustomHeaders::get().VaryValues.AcceptEncoding, true)) {
+    if (!StringUtil::findToken(vary->value().getStringView(), ",", value, true)) {
       std::string new_header;
-      absl::StrAppend(&new_header, vary->value().getStringView(), ", ",
-                      Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+      absl::StrAppend(&new_header, vary->value().getStringView(), ", ", value);
       headers.setInline(vary_handle.handle(), new_header);
     }
   } else {
-    headers.setReferenceInline(vary_handle.handle(),
-                               Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+    headers.setReferenceInline(vary_handle.handle(), value);
   }
 }
 
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 #include "envoy/compression/compressor/factory.h"
 #include "envoy/extensions/filters/http/compressor/v3/compressor.pb.h"
+#include "envoy/singleton/manager.h"
 #include "envoy/stats/stats_macros.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/runtime/runtime_protos.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
+#include "source/extensions/filters/http/compressor/compressed_body_cache.h"
+#include "source/extensions/filters/http/compressor/compression_thread_pool.h"
 
 #include "absl/types/optional.h"
 
@@ -47,7 +54,8 @@ namespace Compressor {
   COUNTER(header_compressor_overshadowed)                                                          \
   COUNTER(header_wildcard)                                                                         \
   COUNTER(header_not_valid)                                                                        \
-  COUNTER(not_compressed_etag)
+  COUNTER(not_compressed_etag)                                                                     \
+  COUNTER(compressed_body_cache_hit)
 
 /**
  * Struct definitions for compressor stats. @see stats_macros.h
@@ -142,14 +150,22 @@ public:
   CompressorFilterConfig(
       const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config,
       const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
+      Singleton::Manager& singleton_manager,
       Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory);
 
   Envoy::Compression::Compressor::CompressorPtr makeCompressor();
 
   const std::string contentEncoding() const { return content_encoding_; };
+  // The dictionary a client must have to decode the output, or empty if it is self-contained.
+  std::string availableDictionary() const { return compressor_factory_->availableDictionary(); }
   bool chooseFirst() const { return choose_first_; };
   const RequestDirectionConfig& requestDirectionConfig() { return request_direction_config_; }
   const ResponseDirectionConfig& responseDirectionConfig() { return response_direction_config_; }
+  // nullptr if response compression is not offloaded.
+  CompressionThreadPool* offloadThreadPool() const { return offload_thread_pool_.get(); }
+  uint32_t offloadMinBodyBytes() const { return offload_min_body_bytes_; }
+  // nullptr if compressed bodies are not remembered.
+  CompressedBodyCache* compressedBodyCache() const { return compressed_body_cache_.get(); }
 
 private:
   const std::string common_stats_prefix_;
@@ -159,6 +175,9 @@ private:
   const std::string content_encoding_;
   const Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory_;
   const bool choose_first_;
+  const CompressionThreadPoolSharedPtr offload_thread_pool_;
+  const uint32_t offload_min_body_bytes_;
+  const CompressedBodyCacheSharedPtr compressed_body_cache_;
 };
 using CompressorFilterConfigSharedPtr = std::shared_ptr<CompressorFilterConfig>;
 
@@ -197,6 +216,9 @@ public:
   Http::FilterDataStatus encodeData(Buffer::Instance& buffer, bool end_stream) override;
   Http::FilterTrailersStatus encodeTrailers(Http::ResponseTrailerMap&) override;
 
+  // Http::StreamFilterBase
+  void onDestroy() override;
+
 private:
   bool compressionEnabled(const CompressorFilterConfig::ResponseDirectionConfig& config,
                           const CompressorPerRouteFilterConfig* per_route_config) const;
@@ -209,6 +231,8 @@ private:
 
   void sanitizeEtagHeader(Http::ResponseHeaderMap& headers);
   void insertVaryHeader(Http::ResponseHeaderMap& headers);
+  // value must outlive headers.
+  static void appendVaryValue(Http::ResponseHeaderMap& headers, const std::string& value);
 
   class EncodingDecision : public StreamInfo::FilterState::Object {
   public:
@@ -231,10 +255,37 @@ private:
   std::unique_ptr<EncodingDecision> chooseEncoding(const Http::ResponseHeaderMap& headers) const;
   bool shouldCompress(const EncodingDecision& decision) const;
 
+  // Hands the buffered response body to the offload thread pool, unless a chunk is already being
+  // compressed there.
+  void maybeOffloadCompression();
+  void onOffloadedCompressionDone(Buffer::Instance& data, uint64_t uncompressed_bytes,
+                                  bool end_stream);
+  void updateOffloadWatermark();
+  // Compresses a whole response body received in one piece, reusing the compressed form of a body
+  // which has been compressed before.
+  void compressWholeBody(CompressedBodyCache& cache, Buffer::Instance& data);
+
   Envoy::Compression::Compressor::CompressorPtr response_compressor_;
   Envoy::Compression::Compressor::CompressorPtr request_compressor_;
   const CompressorFilterConfigSharedPtr config_;
   std::unique_ptr<std::string> accept_encoding_;
+  std::string available_dictionary_;
+
+  // Response compression on the offload thread pool. The compressor is shared with the job
+  // compressing a chunk, so that it outlives the filter if the stream ends first.
+  std::shared_ptr<Envoy::Compression::Compressor::Compressor> offload_compressor_;
+  uint64_t response_body_bytes_{};
+  bool response_data_seen_{};
+  // Body received while a chunk is being compressed, and sent for compression after it.
+  Buffer::OwnedImpl offload_pending_;
+  uint64_t offload_in_flight_bytes_{};
+  bool offload_in_flight_{};
+  bool offload_end_stream_{};
+  bool offload_finished_{};
+  bool offload_trailers_{};
+  bool offload_above_watermark_{};
+  // Lets compression jobs detect that the stream has been destroyed.
+  const std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
 };
 
 } // namespace Compressor
@@ -25,9 +25,14 @@ Http::FilterFactoryCb ExtAuthzFilterConfig::createFilterFactoryFromProtoTyped(
     const std::string& stats_prefix, Server::Configuration::FactoryContext& context) {
   auto& server_context = context.serverFactoryContext();
 
+  DecisionCacheConfigPtr decision_cache;
+  if (proto_config.has_decision_cache()) {
+    decision_cache = std::make_unique<DecisionCacheConfig>(
+        proto_config.decision_cache(), server_context.threadLocal(), server_context.timeSource());
+  }
   const auto filter_config = std::make_shared<FilterConfig>(
       proto_config, context.scope(), server_context.runtime(), server_context.httpContext(),
-      stats_prefix, server_context.bootstrap());
+      stats_prefix, server_context.bootstrap(), std::move(decision_cache));
   // The callback is created in main thread and executed in worker thread, variables except factory
   // context must be captured by value into the callback.
   Http::FilterFactoryCb callback;
@@ -0,0 +1,177 @@
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/http/path_utility.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+namespace {
+
+using KeyPartProto = envoy::extensions::filters::http::ext_authz::v3::DecisionCache::KeyPart;
+
+// Each value is prefixed with its length, so that no two requests with different values share a
+// key. Missing values are marked separately from empty ones.
+void appendKeyValue(std::string& key, absl::string_view value) {
+  absl::StrAppend(&key, value.size(), ":", value, ";");
+}
+
+void appendMissingKeyValue(std::string& key) { key.append("-;"); }
+
+} // namespace
+
+DecisionCache::DecisionCache(uint32_t max_entries, TimeSource& time_source)
+    : max_entries_(max_entries), time_source_(time_source) {}
+
+Filters::Common::ExtAuthz::ResponsePtr DecisionCache::lookup(const std::string& key) {
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  if (it->second.expiry_ <= time_source_.monotonicTime()) {
+    eraseLocked(it);
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position_);
+  return std::make_unique<Filters::Common::ExtAuthz::Response>(it->second.response_);
+}
+
+void DecisionCache::insert(const std::string& key,
+                           const Filters::Common::ExtAuthz::Response& response,
+                           std::chrono::milliseconds ttl) {
+  const MonotonicTime expiry = time_source_.monotonicTime() + ttl;
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    it->second.response_ = response;
+    it->second.expiry_ = expiry;
+    lru_.splice(lru_.begin(), lru_, it->second.lru_position_);
+    return;
+  }
+  if (entries_.size() >= max_entries_) {
+    auto oldest = entries_.find(lru_.back());
+    ASSERT(oldest != entries_.end());
+    eraseLocked(oldest);
+  }
+  lru_.push_front(key);
+  entries_.emplace(key, Entry{response, expiry, lru_.begin()});
+}
+
+size_t DecisionCache::size() {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+void DecisionCache::eraseLocked(absl::flat_hash_map<std::string, Entry>::iterator it) {
+  lru_.erase(it->second.lru_position_);
+  entries_.erase(it);
+}
+
+DecisionCacheConfig::DecisionCacheConfig(
+    const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+    ThreadLocal::SlotAllocator& tls, TimeSource& time_source)
+    : default_ttl_(PROTOBUF_GET_MS_REQUIRED(config, default_ttl)),
+      ttl_metadata_field_(config.ttl_metadata_field()),
+      tls_(ThreadLocal::TypedSlot<DecisionCache>::makeUnique(tls)) {
+  for (const KeyPartProto& part : config.key_parts()) {
+    KeyPart& key_part = key_parts_.emplace_back();
+    key_part.type_ = part.part_case();
+    if (part.part_case() == KeyPartProto::kHeader) {
+      key_part.header_ = Http::LowerCaseString(part.header());
+    } else if (part.part_case() == KeyPartProto::kDynamicMetadata) {
+      key_part.metadata_key_.emplace(part.dynamic_metadata());
+    }
+  }
+
+  const uint32_t max_entries = PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries, 1000);
+  if (config.shared_across_workers()) {
+    auto shared = std::make_shared<DecisionCache>(max_entries, time_source);
+    tls_->set([shared](Event::Dispatcher&) { return shared; });
+  } else {
+    tls_->set([max_entries, &time_source](Event::Dispatcher&) {
+      return std::make_shared<DecisionCache>(max_entries, time_source);
+    });
+  }
+}
+
+std::string DecisionCacheConfig::key(const Http::RequestHeaderMap& headers,
+                                     const StreamInfo::StreamInfo& stream_info,
+                                     const Router::Route* route) const {
+  std::string key;
+  for (const KeyPart& part : key_parts_) {
+    switch (part.type_) {
+    case KeyPartProto::kHeader: {
+      const auto values = headers.get(part.header_);
+      if (values.empty()) {
+        appendMissingKeyValue(key);
+      }
+      for (size_t i = 0; i < values.size(); ++i) {
+        appendKeyValue(key, values[i]->value().getStringView());
+      }
+      break;
+    }
+    case KeyPartProto::kDynamicMetadata: {
+      const ProtobufWkt::Value& value =
+          Config::Metadata::metadataValue(&stream_info.dynamicMetadata(), *part.metadata_key_);
+      switch (value.kind_case()) {
+      case ProtobufWkt::Value::kStringValue:
+        appendKeyValue(key, value.string_value());
+        break;
+      case ProtobufWkt::Value::KIND_NOT_SET:
+        appendMissingKeyValue(key);
+        break;
+      default:
+        appendKeyValue(key, absl::StrCat(MessageUtil::hash(value)));
+        break;
+      }
+      break;
+    }
+    case KeyPartProto::kMethod:
+      appendKeyValue(key, headers.getMethodValue());
+      break;
+    case KeyPartProto::kPath:
+      appendKeyValue(key, Http::PathUtil::removeQueryAndFragment(headers.getPathValue()));
+      break;
+    case KeyPartProto::kRouteName:
+      if (route == nullptr) {
+        appendMissingKeyValue(key);
+      } else {
+        appendKeyValue(key, route->routeName());
+      }
+      break;
+    case KeyPartProto::PART_NOT_SET:
+      PANIC_DUE_TO_CORRUPT_ENUM;
+    }
+  }
+  return key;
+}
+
+void DecisionCacheConfig::insert(const std::string& key,
+                                 const Filters::Common::ExtAuthz::Response& response) {
+  if (response.status == Filters::Common::ExtAuthz::CheckStatus::Error) {
+    return;
+  }
+  std::chrono::milliseconds ttl = default_ttl_;
+  if (!ttl_metadata_field_.empty()) {
+    const auto it = response.dynamic_metadata.fields().find(ttl_metadata_field_);
+    if (it != response.dynamic_metadata.fields().end() &&
+        it->second.kind_case() == ProtobufWkt::Value::kNumberValue) {
+      ttl = std::chrono::milliseconds(static_cast<int64_t>(it->second.number_value() * 1000));
+    }
+  }
+  if (ttl.count() <= 0) {
+    return;
+  }
+  cache().insert(key, response, ttl);
+}
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
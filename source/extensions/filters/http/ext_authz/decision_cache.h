@@ -0,0 +1,112 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/router/router.h"
+#include "envoy/stream_info/stream_info.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/config/metadata.h"
+#include "source/extensions/filters/common/ext_authz/ext_authz.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+/**
+ * A bounded cache of authorization decisions, evicting the least recently used decision once it
+ * is full.
+ */
+class DecisionCache : public ThreadLocal::ThreadLocalObject {
+public:
+  DecisionCache(uint32_t max_entries, TimeSource& time_source);
+
+  /**
+   * @return a copy of the decision cached for key, or nullptr if there is none that is still
+   *     valid.
+   */
+  Filters::Common::ExtAuthz::ResponsePtr lookup(const std::string& key) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  /**
+   * Caches response for key for the given TTL, replacing any decision cached for key.
+   */
+  void insert(const std::string& key, const Filters::Common::ExtAuthz::Response& response,
+              std::chrono::milliseconds ttl) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  size_t size() ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  struct Entry {
+    Filters::Common::ExtAuthz::Response response_;
+    MonotonicTime expiry_;
+    std::list<std::string>::iterator lru_position_;
+  };
+
+  void eraseLocked(absl::flat_hash_map<std::string, Entry>::iterator it)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const uint32_t max_entries_;
+  TimeSource& time_source_;
+  // Only contended if the cache is shared by all workers.
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  // The keys of entries_, most recently used first.
+  std::list<std::string> lru_ ABSL_GUARDED_BY(mutex_);
+};
+
+/**
+ * How decisions are cached, and the caches used by the workers.
+ */
+class DecisionCacheConfig {
+public:
+  DecisionCacheConfig(const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+                      ThreadLocal::SlotAllocator& tls, TimeSource& time_source);
+
+  /**
+   * @return the cache key for a request.
+   */
+  std::string key(const Http::RequestHeaderMap& headers, const StreamInfo::StreamInfo& stream_info,
+                  const Router::Route* route) const;
+
+  /**
+   * @return the cache of the current worker.
+   */
+  DecisionCache& cache() { return *tls_->get(); }
+
+  /**
+   * Caches response, unless it is an error or the authorization server gave it a TTL of 0.
+   */
+  void insert(const std::string& key, const Filters::Common::ExtAuthz::Response& response);
+
+private:
+  struct KeyPart {
+    envoy::extensions::filters::http::ext_authz::v3::DecisionCache::KeyPart::PartCase type_;
+    Http::LowerCaseString header_{""};
+    absl::optional<Config::MetadataKey> metadata_key_;
+  };
+
+  std::vector<KeyPart> key_parts_;
+  const std::chrono::milliseconds default_ttl_;
+  const std::string ttl_metadata_field_;
+  ThreadLocal::TypedSlotPtr<DecisionCache> tls_;
+};
+
+using DecisionCacheConfigPtr = std::unique_ptr<DecisionCacheConfig>;
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -68,11 +68,39 @@ void FilterConfigPerRoute::merge(const FilterConfigPerRoute& other) {
   }
 }
 
+bool Filter::completeFromDecisionCache(const Http::RequestHeaderMap& headers) {
+  DecisionCacheConfig* decision_cache = config_->decisionCache();
+  if (decision_cache == nullptr) {
+    return false;
+  }
+  std::string key = decision_cache->key(headers, decoder_callbacks_->streamInfo(),
+                                        decoder_callbacks_->route().get());
+  Filters::Common::ExtAuthz::ResponsePtr cached = decision_cache->cache().lookup(key);
+  if (cached == nullptr) {
+    stats_.decision_cache_miss_.inc();
+    decision_cache_key_ = std::move(key);
+    return false;
+  }
+
+  ENVOY_STREAM_LOG(trace, "ext_authz filter using cached decision", *decoder_callbacks_);
+  stats_.decision_cache_hit_.inc();
+  filter_return_ = FilterReturn::StopDecoding;
+  cluster_ = decoder_callbacks_->clusterInfo();
+  initiating_call_ = true;
+  onComplete(std::move(cached));
+  initiating_call_ = false;
+  return true;
+}
+
 void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
   if (filter_return_ == FilterReturn::StopDecoding) {
     return;
   }
 
+  if (completeFromDecisionCache(headers)) {
+    return;
+  }
+
   auto&& maybe_merged_per_route_config =
       Http::Utility::getMergedPerFilterConfig<FilterConfigPerRoute>(
           decoder_callbacks_, [](FilterConfigPerRoute& cfg_base, const FilterConfigPerRoute& cfg) {
@@ -268,6 +296,10 @@ void Filter::onDestroy() {
 
 void Filter::onComplete(Filters::Common::ExtAuthz::ResponsePtr&& response) {
   state_ = State::Complete;
+  if (decision_cache_key_.has_value()) {
+    config_->decisionCache()->insert(*decision_cache_key_, *response);
+    decision_cache_key_.reset();
+  }
   using Filters::Common::ExtAuthz::CheckStatus;
   Stats::StatName empty_stat_name;
 
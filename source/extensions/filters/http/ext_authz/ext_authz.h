@@ -24,6 +24,7 @@
 #include "source/extensions/filters/common/ext_authz/ext_authz.h"
 #include "source/extensions/filters/common/ext_authz/ext_authz_grpc_impl.h"
 #include "source/extensions/filters/common/ext_authz/ext_authz_http_impl.h"
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -39,7 +40,9 @@ namespace ExtAuthz {
   COUNTER(denied)                                                                                  \
   COUNTER(error)                                                                                   \
   COUNTER(disabled)                                                                                \
-  COUNTER(failure_mode_allowed)
+  COUNTER(failure_mode_allowed)                                                                    \
+  COUNTER(decision_cache_hit)                                                                      \
+  COUNTER(decision_cache_miss)
 
 /**
  * Wrapper struct for ext_authz filter stats. @see stats_macros.h
@@ -57,7 +60,8 @@ class FilterConfig {
 public:
   FilterConfig(const envoy::extensions::filters::http::ext_authz::v3::ExtAuthz& config,
                Stats::Scope& scope, Runtime::Loader& runtime, Http::Context& http_context,
-               const std::string& stats_prefix, envoy::config::bootstrap::v3::Bootstrap& bootstrap)
+               const std::string& stats_prefix, envoy::config::bootstrap::v3::Bootstrap& bootstrap,
+               DecisionCacheConfigPtr decision_cache = nullptr)
       : allow_partial_message_(config.with_request_body().allow_partial_message()),
         failure_mode_allow_(config.failure_mode_allow()),
         failure_mode_allow_header_add_(config.failure_mode_allow_header_add()),
@@ -97,6 +101,7 @@ public:
         include_tls_session_(config.include_tls_session()),
         charge_cluster_response_stats_(
             PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, charge_cluster_response_stats, true)),
+        decision_cache_(std::move(decision_cache)),
         stats_(generateStats(stats_prefix, config.stat_prefix(), scope)),
         ext_authz_ok_(pool_.add(createPoolStatName(config.stat_prefix(), "ok"))),
         ext_authz_denied_(pool_.add(createPoolStatName(config.stat_prefix(), "denied"))),
@@ -198,6 +203,9 @@ public:
     return request_header_matchers_;
   }
 
+  // nullptr if decisions are not cached.
+  DecisionCacheConfig* decisionCache() const { return decision_cache_.get(); }
+
 private:
   static Http::Code toErrorCode(uint64_t status) {
     const auto code = static_cast<Http::Code>(status);
@@ -251,6 +259,8 @@ private:
   const bool include_tls_session_;
   const bool charge_cluster_response_stats_;
 
+  const DecisionCacheConfigPtr decision_cache_;
+
   // The stats for the filter.
   ExtAuthzFilterStats stats_;
 
@@ -352,6 +362,8 @@ private:
   absl::optional<MonotonicTime> start_time_;
   void addResponseHeaders(Http::HeaderMap& header_map, const Http::HeaderVector& headers);
   void initiateCall(const Http::RequestHeaderMap& headers);
+  // Completes the check with a cached decision, if there is one.
+  bool completeFromDecisionCache(const Http::RequestHeaderMap& headers);
   void continueDecoding();
   bool isBufferFull(uint64_t num_bytes_processing) const;
 
@@ -395,6 +407,8 @@ private:
   bool buffer_data_{};
   bool skip_check_{false};
   envoy::service::auth::v3::CheckRequest check_request_{};
+  // The key under which the decision of the pending check is cached.
+  absl::optional<std::string> decision_cache_key_;
 };
 
 } // namespace ExtAuthz
@@ -353,6 +353,11 @@ FilterHeadersStatus Filter::onHeaders(ProcessorState& state,
   MutationUtils::headersToProto(headers, config_->allowedHeaders(), config_->disallowedHeaders(),
                                 *headers_req->mutable_headers());
   headers_req->set_end_of_stream(end_stream);
+  if (config_->asyncMode()) {
+    ENVOY_LOG(debug, "Sending headers message without waiting for a response");
+    sendObservation(std::move(req));
+    return FilterHeadersStatus::Continue;
+  }
   state.onStartProcessorCall(std::bind(&Filter::onMessageTimeout, this), config_->messageTimeout(),
                              ProcessorState::CallbackState::HeadersCallback);
   ENVOY_LOG(debug, "Sending headers message");
@@ -382,7 +387,9 @@ FilterHeadersStatus Filter::decodeHeaders(RequestHeaderMap& headers, bool end_st
     ENVOY_LOG(trace, "decodeHeaders: Skipped header processing");
   }
 
-  if (!processing_complete_ && decoding_state_.shouldRemoveContentLength()) {
+  // In async mode the body is never changed, so the content-length stays valid.
+  if (!processing_complete_ && !config_->asyncMode() &&
+      decoding_state_.shouldRemoveContentLength()) {
     headers.removeContentLength();
   }
   return status;
@@ -401,6 +408,9 @@ FilterDataStatus Filter::onData(ProcessorState& state, Buffer::Instance& data, b
     ENVOY_LOG(trace, "Continuing (processing complete)");
     return FilterDataStatus::Continue;
   }
+  if (config_->asyncMode()) {
+    return observeData(state, data, end_stream);
+  }
 
   if (state.callbackState() == ProcessorState::CallbackState::HeadersCallback) {
     ENVOY_LOG(trace, "Header processing still in progress -- holding body data");
@@ -539,6 +549,32 @@ FilterDataStatus Filter::onData(ProcessorState& state, Buffer::Instance& data, b
   return result;
 }
 
+FilterDataStatus Filter::observeData(ProcessorState& state, Buffer::Instance& data,
+                                     bool end_stream) {
+  if (state.bodyMode() == ProcessingMode::NONE) {
+    return FilterDataStatus::Continue;
+  }
+  // In STREAMED mode every chunk is sent as it arrives. In the buffered modes chunks are batched
+  // into one message until either the buffer limit or the end of the stream is reached, without
+  // holding up the data itself.
+  state.observedBody().add(data);
+  if (state.bodyMode() == ProcessingMode::STREAMED || end_stream ||
+      state.observedBody().length() >= state.bufferLimit()) {
+    sendObservedBody(state, end_stream);
+  }
+  return FilterDataStatus::Continue;
+}
+
+void Filter::sendObservedBody(ProcessorState& state, bool end_stream) {
+  if (openStream() != StreamOpenState::Ok) {
+    state.observedBody().drain(state.observedBody().length());
+    return;
+  }
+  auto req = setupBodyChunk(state, state.observedBody(), end_stream);
+  state.observedBody().drain(state.observedBody().length());
+  sendObservation(std::move(req));
+}
+
 std::pair<bool, Http::FilterDataStatus> Filter::sendStreamChunk(ProcessorState& state) {
   switch (openStream()) {
   case StreamOpenState::Error:
@@ -577,6 +613,23 @@ FilterTrailersStatus Filter::onTrailers(ProcessorState& state, Http::HeaderMap&
   state.setTrailersAvailable(true);
   state.setTrailers(&trailers);
 
+  if (config_->asyncMode()) {
+    if (state.bodyMode() != ProcessingMode::NONE && state.observedBody().length() > 0) {
+      sendObservedBody(state, false);
+    }
+    if (state.sendTrailers() && openStream() == StreamOpenState::Ok) {
+      ProcessingRequest req;
+      addAttributes(state, req);
+      addDynamicMetadata(state, req);
+      MutationUtils::headersToProto(trailers, config_->allowedHeaders(),
+                                    config_->disallowedHeaders(),
+                                    *state.mutableTrailers(req)->mutable_trailers());
+      ENVOY_LOG(debug, "Sending trailers message without waiting for a response");
+      sendObservation(std::move(req));
+    }
+    return FilterTrailersStatus::Continue;
+  }
+
   if (state.callbackState() != ProcessorState::CallbackState::Idle) {
     ENVOY_LOG(trace, "Previous callback still executing -- holding header iteration");
     state.setPaused(true);
@@ -665,7 +718,8 @@ FilterHeadersStatus Filter::encodeHeaders(ResponseHeaderMap& headers, bool end_s
   // (2) side stream processing has been completed. For example, it could be caused by stream error
   // that triggers the local reply or due to spurious message that skips the side stream
   // mutation.
-  if (!processing_complete_ && encoding_state_.shouldRemoveContentLength()) {
+  if (!processing_complete_ && !config_->asyncMode() &&
+      encoding_state_.shouldRemoveContentLength()) {
     headers.removeContentLength();
   }
   return status;
@@ -719,6 +773,13 @@ void Filter::sendTrailers(ProcessorState& state, const Http::HeaderMap& trailers
   stats_.stream_msgs_sent_.inc();
 }
 
+void Filter::sendObservation(ProcessingRequest&& req) {
+  // No timer is started, since the filter chain does not wait for a response.
+  req.set_async_mode(true);
+  stream_->send(std::move(req), false);
+  stats_.stream_msgs_sent_.inc();
+}
+
 void Filter::logGrpcStreamInfo() {
   if (stream_ != nullptr && logging_info_ != nullptr && grpc_service_.has_envoy_grpc()) {
     const auto& upstream_meter = stream_->streamInfo().getUpstreamBytesMeter();
@@ -873,6 +934,15 @@ void Filter::onReceiveMessage(std::unique_ptr<ProcessingResponse>&& r) {
 
   auto response = std::move(r);
 
+  if (config_->asyncMode()) {
+    // The server must not respond in async mode, and the request has already moved on, so there is
+    // nothing that the response could change.
+    ENVOY_LOG(debug, "Ignoring {} response in async mode",
+              responseCaseToString(response->response_case()));
+    stats_.spurious_msgs_received_.inc();
+    return;
+  }
+
   // Check whether the server is asking to extend the timer.
   if (response->has_override_message_timeout()) {
     onNewTimeout(response->override_message_timeout());
@@ -980,8 +1050,9 @@ void Filter::onGrpcError(Grpc::Status::GrpcStatus status) {
     return;
   }
 
-  if (config_->failureModeAllow()) {
-    // Ignore this and treat as a successful close
+  if (config_->failureModeAllow() || config_->asyncMode()) {
+    // Ignore this and treat as a successful close. In async mode the request never depends on the
+    // processor, so it is not failed either.
     onGrpcClose();
     stats_.failure_mode_allowed_.inc();
 
@@ -130,7 +130,7 @@ public:
                const std::string& stats_prefix,
                Extensions::Filters::Common::Expr::BuilderInstanceSharedPtr builder,
                const LocalInfo::LocalInfo& local_info)
-      : failure_mode_allow_(config.failure_mode_allow()),
+      : failure_mode_allow_(config.failure_mode_allow()), async_mode_(config.async_mode()),
         disable_clear_route_cache_(config.disable_clear_route_cache()),
         message_timeout_(message_timeout), max_message_timeout_ms_(max_message_timeout_ms),
         stats_(generateStats(stats_prefix, config.stat_prefix(), scope)),
@@ -154,6 +154,8 @@ public:
 
   bool failureModeAllow() const { return failure_mode_allow_; }
 
+  bool asyncMode() const { return async_mode_; }
+
   const std::chrono::milliseconds& messageTimeout() const { return message_timeout_; }
 
   uint32_t maxMessageTimeout() const { return max_message_timeout_ms_; }
@@ -201,6 +203,9 @@ private:
     return {ALL_EXT_PROC_FILTER_STATS(POOL_COUNTER_PREFIX(scope, final_prefix))};
   }
   const bool failure_mode_allow_;
+  // If set to true, messages are sent to the processor without waiting for its responses, which
+  // are ignored.
+  const bool async_mode_;
   const bool disable_clear_route_cache_;
   const std::chrono::milliseconds message_timeout_;
   const uint32_t max_message_timeout_ms_;
@@ -341,6 +346,7 @@ public:
                      envoy::service::ext_proc::v3::ProcessingRequest& req);
 
   void sendTrailers(ProcessorState& state, const Http::HeaderMap& trailers);
+  void sendObservation(envoy::service::ext_proc::v3::ProcessingRequest&& req);
   bool inHeaderProcessState() {
     return (decoding_state_.callbackState() == ProcessorState::CallbackState::HeadersCallback ||
             encoding_state_.callbackState() == ProcessorState::CallbackState::HeadersCallback);
@@ -365,6 +371,10 @@ private:
   std::pair<bool, Http::FilterDataStatus> sendStreamChunk(ProcessorState& state);
   Http::FilterDataStatus onData(ProcessorState& state, Buffer::Instance& data, bool end_stream);
   Http::FilterTrailersStatus onTrailers(ProcessorState& state, Http::HeaderMap& trailers);
+  // In async mode, the body is copied to the processor and the filter chain always continues.
+  Http::FilterDataStatus observeData(ProcessorState& state, Buffer::Instance& data,
+                                     bool end_stream);
+  void sendObservedBody(ProcessorState& state, bool end_stream);
   void setDynamicMetadata(Http::StreamFilterCallbacks* cb, const ProcessorState& state,
                           const envoy::service::ext_proc::v3::ProcessingResponse& response);
   void setEncoderDynamicMetadata(const envoy::service::ext_proc::v3::ProcessingResponse& response);
@@ -25,9 +25,8 @@ ExpressionManager::initExpressions(const Protobuf::RepeatedPtrField<std::string>
                            parse_status.status().ToString());
     }
 
-    Filters::Common::Expr::ExpressionPtr expression =
-        Extensions::Filters::Common::Expr::createExpression(builder_->builder(),
-                                                            parse_status.value().expr());
+    Filters::Common::Expr::ExpressionSharedPtr expression =
+        builder_->createSharedExpression(parse_status.value().expr());
 
     expressions.emplace(
         matcher, ExpressionManager::CelExpression{parse_status.value(), std::move(expression)});
@@ -14,7 +14,7 @@ class ExpressionManager : public Logger::Loggable<Logger::Id::ext_proc> {
 public:
   struct CelExpression {
     google::api::expr::v1alpha1::ParsedExpr parsed_expr_;
-    Filters::Common::Expr::ExpressionPtr compiled_expr_;
+    Filters::Common::Expr::ExpressionSharedPtr compiled_expr_;
   };
 
   ExpressionManager(Extensions::Filters::Common::Expr::BuilderInstanceSharedPtr builder,
@@ -175,6 +175,8 @@ public:
   // Consolidate all the chunks on the queue into a single one and return a reference.
   const QueuedChunk& consolidateStreamedChunks() { return chunk_queue_.consolidate(); }
   bool queueOverHighLimit() const { return chunk_queue_.bytesEnqueued() > bufferLimit(); }
+  // In async mode, a copy of the body data that has not been sent to the processor yet.
+  Buffer::OwnedImpl& observedBody() { return observed_body_; }
   bool queueBelowLowLimit() const { return chunk_queue_.bytesEnqueued() < bufferLimit() / 2; }
   bool shouldRemoveContentLength() const {
     // Always remove the content length in 3 cases below:
@@ -260,6 +262,7 @@ protected:
   // Envoy should receive at most one such message in one particular state.
   bool new_timeout_received_{false};
   ChunkQueue chunk_queue_;
+  Buffer::OwnedImpl observed_body_;
   absl::optional<MonotonicTime> call_start_time_ = absl::nullopt;
   const envoy::config::core::v3::TrafficDirection traffic_direction_;
 
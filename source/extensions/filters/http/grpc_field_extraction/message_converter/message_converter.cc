@@ -28,7 +28,7 @@ absl::StatusOr<StreamMessagePtr> MessageConverter::accumulateMessage(Envoy::Buff
   // Append the input data to buffer that will be parsed.
   parsing_buffer_.move(data);
 
-  ENVOY_LOG_MISC(info, "Checking buffer limits: actual {} > limit {}?", bytesBuffered(),
+  ENVOY_LOG_MISC(debug, "Checking buffer limits: actual {} > limit {}?", bytesBuffered(),
                  buffer_limit_);
   if (bytesBuffered() > buffer_limit_) {
     return absl::FailedPreconditionError("Rejected because internal buffer limits are exceeded.");
@@ -42,11 +42,11 @@ absl::StatusOr<StreamMessagePtr> MessageConverter::accumulateMessage(Envoy::Buff
   bool is_final_message = end_stream && parsing_buffer_.length() == 0;
   if (parsed_output->needs_more_data) {
     if (is_final_message) {
-      ENVOY_LOG_MISC(info, "final placeholder message in the stream, not being parsed");
+      ENVOY_LOG_MISC(debug, "final placeholder message in the stream, not being parsed");
     } else if (end_stream) {
       return absl::InvalidArgumentError("Did not receive enough data for gRPC message parsing.");
     } else {
-      ENVOY_LOG_MISC(info, "expecting more data for gRPC message parsing");
+      ENVOY_LOG_MISC(debug, "expecting more data for gRPC message parsing");
       return nullptr;
     }
   }
@@ -59,10 +59,10 @@ absl::StatusOr<StreamMessagePtr> MessageConverter::accumulateMessage(Envoy::Buff
   message_data->setIsFinalMessage(is_final_message);
   conversions_to_message_data_++;
 
-  ENVOY_LOG_MISC(info, "len(parsing_buffer_)={}", parsing_buffer_.length());
+  ENVOY_LOG_MISC(debug, "len(parsing_buffer_)={}", parsing_buffer_.length());
   if (parsed_output->owned_bytes != nullptr) {
     ABSL_DCHECK(!parsed_output->needs_more_data);
-    ENVOY_LOG_MISC(info, "len(parsed owned_bytes)={}", parsed_output->owned_bytes->length());
+    ENVOY_LOG_MISC(debug, "len(parsed owned_bytes)={}", parsed_output->owned_bytes->length());
   }
   return message_data;
 }
@@ -140,18 +140,18 @@ MessageConverter::convertBackToBuffer(StreamMessagePtr message) {
   // Edge case handling: If StreamMessage is empty, then just let it go out of
   // scope and return buffer with only delimiter.
   if (is_empty) {
-    ENVOY_LOG_MISC(info, "converted back empty raw_message");
+    ENVOY_LOG_MISC(debug, "converted back empty raw_message");
     ABSL_DCHECK_EQ(output_message->length(), google::grpc::transcoding::kGrpcDelimiterByteSize);
     return output_message;
   }
 
-  ENVOY_LOG_MISC(info, "converted back len(raw_message)={}, len(output_message)={}",
+  ENVOY_LOG_MISC(debug, "converted back len(raw_message)={}, len(output_message)={}",
                  message_lifetime->size(), output_message->length());
   return output_message;
 }
 
 uint64_t MessageConverter::bytesBuffered() const {
-  ENVOY_LOG_MISC(info, "{} + {}", parsing_buffer_.length(), *parsed_bytes_usage_);
+  ENVOY_LOG_MISC(debug, "{} + {}", parsing_buffer_.length(), *parsed_bytes_usage_);
   return parsing_buffer_.length() + *parsed_bytes_usage_;
 }
 
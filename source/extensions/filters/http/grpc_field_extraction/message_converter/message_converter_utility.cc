@@ -22,7 +22,7 @@ absl::StatusOr<ParsedGrpcMessage> parseGrpcMessage(CreateMessageDataFunc& factor
                                                    Envoy::Buffer::Instance& request_in) {
   // Parse the gRPC frame header.
   if (request_in.length() < kGrpcDelimiterByteSize) {
-    ENVOY_LOG_MISC(info, "Need more data for gRPC frame header parsing. Current size={}",
+    ENVOY_LOG_MISC(debug, "Need more data for gRPC frame header parsing. Current size={}",
                    request_in.length());
     ParsedGrpcMessage ret;
     ret.needs_more_data = true;
@@ -39,7 +39,7 @@ absl::StatusOr<ParsedGrpcMessage> parseGrpcMessage(CreateMessageDataFunc& factor
   const uint64_t message_size = message_size_status.value();
   const uint64_t total_size = message_size + kGrpcDelimiterByteSize;
   if (request_in.length() < total_size) {
-    ENVOY_LOG_MISC(info, "Need more data for gRPC frame. Current size={}, needed={}",
+    ENVOY_LOG_MISC(debug, "Need more data for gRPC frame. Current size={}, needed={}",
                    request_in.length(), total_size);
     ParsedGrpcMessage ret;
     ret.needs_more_data = true;
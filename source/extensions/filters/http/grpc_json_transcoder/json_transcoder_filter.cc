@@ -104,6 +104,18 @@ private:
   TranscoderInputStreamPtr response_stream_;
 };
 
+// Hands the body over to the response without copying it, as a HttpBody may carry a large payload.
+void moveToBuffer(std::string&& body, Buffer::Instance& data) {
+  auto* owned_body = new std::string(std::move(body));
+  auto* fragment = new Buffer::BufferFragmentImpl(
+      owned_body->data(), owned_body->size(),
+      [owned_body](const void*, size_t, const Buffer::BufferFragmentImpl* fragment) {
+        delete owned_body;
+        delete fragment;
+      });
+  data.addBufferFragment(*fragment);
+}
+
 } // namespace
 
 JsonTranscoderConfig::JsonTranscoderConfig(
@@ -899,14 +911,14 @@ bool JsonTranscoderFilter::buildResponseFromHttpBodyOutput(
         encoder_callbacks_->resetStream();
         return true;
       }
-      const auto& body = http_body.data();
+      const uint64_t body_size = http_body.data().size();
 
-      data.add(body);
+      moveToBuffer(std::move(*http_body.mutable_data()), data);
 
       if (!method_->descriptor_->server_streaming()) {
         // Non streaming case: single message with content type / length
         response_headers.setContentType(http_body.content_type());
-        response_headers.setContentLength(body.size());
+        response_headers.setContentLength(body_size);
         return true;
       } else if (!http_body_response_headers_set_) {
         // Streaming case: set content type only once from first HttpBody message
@@ -116,6 +116,7 @@ public:
     // convert unique_ptr to shared_ptr
     JwksConstSharedPtr shared_jwks = std::move(jwks);
     tls_->jwks_ = shared_jwks;
+    tls_->jwt_cache_->clear();
     tls_->expire_ = time_source_.monotonicTime() +
                     JwksAsyncFetcher::getCacheDuration(jwt_provider_.remote_jwks());
     return shared_jwks.get();
@@ -143,6 +144,7 @@ private:
     JwksConstSharedPtr shared_jwks = std::move(jwks);
     tls_.runOnAllThreads([shared_jwks](OptRef<ThreadLocalCache> obj) {
       obj->jwks_ = shared_jwks;
+      obj->jwt_cache_->clear();
       obj->expire_ = std::chrono::steady_clock::time_point::max();
     });
   }
@@ -2,6 +2,7 @@
 
 #include "source/common/common/assert.h"
 
+#include "openssl/sha.h"
 #include "simple_lru_cache/simple_lru_cache_inl.h"
 
 using ::google::simple_lru_cache::SimpleLRUCache;
@@ -17,6 +18,15 @@ constexpr int kJwtCacheDefaultSize = 100;
 // The maximum size of JWT to be cached.
 constexpr int kMaxJwtSizeForCache = 4 * 1024; // 4KiB
 
+// The cache is keyed by the SHA-256 digest of the token, rather than the token itself, so that
+// the parsed JWT is the only copy of a cached token.
+std::string tokenDigest(const std::string& token) {
+  std::string digest(SHA256_DIGEST_LENGTH, '\0');
+  SHA256(reinterpret_cast<const uint8_t*>(token.data()), token.size(),
+         reinterpret_cast<uint8_t*>(digest.data()));
+  return digest;
+}
+
 class JwtCacheImpl : public JwtCache {
 public:
   JwtCacheImpl(bool enable_cache, const JwtCacheConfig& config, TimeSource& time_source)
@@ -40,16 +50,19 @@ public:
     if (!jwt_lru_cache_) {
       return nullptr;
     }
+    const std::string key = tokenDigest(token);
     SimpleLRUCache<std::string, ::google::jwt_verify::Jwt>::ScopedLookup lookup(
-        jwt_lru_cache_.get(), token);
+        jwt_lru_cache_.get(), key);
     if (lookup.found()) {
       ::google::jwt_verify::Jwt* const found_jwt = lookup.value();
       ASSERT(found_jwt != nullptr);
-      if (found_jwt->verifyTimeConstraint(DateUtil::nowToSeconds(time_source_)) !=
-          ::google::jwt_verify::Status::JwtExpired) {
+      // Both `exp` and `nbf` are checked, so that a token is only served from the cache while it
+      // would also pass verification.
+      if (found_jwt->verifyTimeConstraint(DateUtil::nowToSeconds(time_source_)) ==
+          ::google::jwt_verify::Status::Ok) {
         return found_jwt;
       } else {
-        jwt_lru_cache_->remove(token);
+        jwt_lru_cache_->remove(key);
       }
     }
     return nullptr;
@@ -58,7 +71,13 @@ public:
   void insert(const std::string& token, std::unique_ptr<::google::jwt_verify::Jwt>&& jwt) override {
     if (jwt_lru_cache_ && token.size() <= kMaxJwtSizeForCache) {
       // pass the ownership of jwt to cache
-      jwt_lru_cache_->insert(token, jwt.release(), 1);
+      jwt_lru_cache_->insert(tokenDigest(token), jwt.release(), 1);
+    }
+  }
+
+  void clear() override {
+    if (jwt_lru_cache_) {
+      jwt_lru_cache_->clear();
     }
   }
 
@@ -17,7 +17,7 @@ namespace Extensions {
 namespace HttpFilters {
 namespace JwtAuthn {
 
-// Cache key is the JWT string, value is parsed JWT struct.
+// Cache key is the SHA-256 digest of the JWT string, value is parsed JWT struct.
 
 class JwtCache;
 using JwtCachePtr = std::unique_ptr<JwtCache>;
@@ -35,6 +35,10 @@ public:
   virtual void insert(const std::string& token,
                       std::unique_ptr<::google::jwt_verify::Jwt>&& jwt) PURE;
 
+  // Remove all JWT tokens from the cache. Tokens are only cached once their signature has been
+  // verified, so this is needed whenever the keys they were verified with may have changed.
+  virtual void clear() PURE;
+
   // JwtCache factory function.
   static JwtCachePtr create(bool enable_cache, const JwtCacheConfig& config,
                             TimeSource& time_source);
@@ -39,7 +39,7 @@ FilterConfig::FilterConfig(
               : true),
       rate_limiter_(new Filters::Common::LocalRateLimit::LocalRateLimiterImpl(
           fill_interval_, max_tokens_, tokens_per_fill_, dispatcher, descriptors_,
-          always_consume_default_token_bucket_)),
+          always_consume_default_token_bucket_, config.per_worker_token_budgets())),
       local_info_(local_info), runtime_(runtime),
       filter_enabled_(
           config.has_filter_enabled()
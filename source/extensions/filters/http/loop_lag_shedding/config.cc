@@ -0,0 +1,33 @@
+#include "source/extensions/filters/http/loop_lag_shedding/config.h"
+
+#include <string>
+
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/filters/http/loop_lag_shedding/loop_lag_shedding.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace LoopLagShedding {
+
+Http::FilterFactoryCb LoopLagSheddingFilterFactory::createFilterFactoryFromProtoTyped(
+    const envoy::extensions::filters::http::loop_lag_shedding::v3::LoopLagShedding& proto_config,
+    const std::string& stats_prefix, Server::Configuration::FactoryContext& context) {
+  FilterConfigSharedPtr filter_config = std::make_shared<FilterConfig>(
+      proto_config, context.serverFactoryContext().threadLocal(),
+      context.serverFactoryContext().singletonManager(), context.scope(), stats_prefix);
+  return [filter_config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
+    callbacks.addStreamDecoderFilter(std::make_shared<LoopLagSheddingFilter>(filter_config));
+  };
+}
+
+/**
+ * Static registration for the loop lag shedding filter. @see RegisterFactory.
+ */
+REGISTER_FACTORY(LoopLagSheddingFilterFactory, Server::Configuration::NamedHttpFilterConfigFactory);
+
+} // namespace LoopLagShedding
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "envoy/extensions/filters/http/loop_lag_shedding/v3/loop_lag_shedding.pb.h"
+#include "envoy/extensions/filters/http/loop_lag_shedding/v3/loop_lag_shedding.pb.validate.h"
+
+#include "source/extensions/filters/http/common/factory_base.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace LoopLagShedding {
+
+/**
+ * Config registration for the loop lag shedding filter. @see NamedHttpFilterConfigFactory.
+ */
+class LoopLagSheddingFilterFactory
+    : public Common::FactoryBase<
+          envoy::extensions::filters::http::loop_lag_shedding::v3::LoopLagShedding> {
+public:
+  LoopLagSheddingFilterFactory() : FactoryBase("envoy.filters.http.loop_lag_shedding") {}
+
+private:
+  Http::FilterFactoryCb createFilterFactoryFromProtoTyped(
+      const envoy::extensions::filters::http::loop_lag_shedding::v3::LoopLagShedding& proto_config,
+      const std::string& stats_prefix, Server::Configuration::FactoryContext& context) override;
+};
+
+} // namespace LoopLagShedding
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
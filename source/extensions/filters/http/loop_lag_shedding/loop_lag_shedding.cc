@@ -0,0 +1,142 @@
+#include "source/extensions/filters/http/loop_lag_shedding/loop_lag_shedding.h"
+
+#include <algorithm>
+
+#include "envoy/common/exception.h"
+#include "envoy/http/codes.h"
+
+#include "source/common/common/macros.h"
+#include "source/common/config/metadata.h"
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace LoopLagShedding {
+
+SINGLETON_MANAGER_REGISTRATION(lag_controller_registry);
+
+namespace {
+
+constexpr uint32_t DefaultMaxPriority = 1;
+constexpr uint32_t DefaultProbesPerInterval = 10;
+
+const std::string& filterName() {
+  CONSTRUCT_ON_FIRST_USE(std::string, "envoy.filters.http.loop_lag_shedding");
+}
+
+const std::string& priorityKey() { CONSTRUCT_ON_FIRST_USE(std::string, "priority"); }
+
+LagControllerConfig controllerConfig(const LoopLagSheddingProto& proto_config) {
+  const std::chrono::milliseconds interval(PROTOBUF_GET_MS_REQUIRED(proto_config, interval));
+  return {std::chrono::milliseconds(PROTOBUF_GET_MS_REQUIRED(proto_config, target)), interval,
+          std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
+              proto_config, probe_interval,
+              std::max<int64_t>(1, interval.count() / DefaultProbesPerInterval))),
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, max_priority, DefaultMaxPriority)};
+}
+
+} // namespace
+
+LagController::LagController(Event::Dispatcher& dispatcher, const LagControllerConfig& config)
+    : config_(config), time_source_(dispatcher.timeSource()),
+      probe_timer_(dispatcher.createTimer([this]() { onProbe(); })),
+      interval_start_(time_source_.monotonicTime()), shed_from_(config_.max_priority_ + 1) {
+  scheduleProbe();
+}
+
+void LagController::scheduleProbe() {
+  probe_scheduled_ = time_source_.monotonicTime();
+  probe_timer_->enableTimer(config_.probe_interval_);
+}
+
+void LagController::onProbe() {
+  const MonotonicTime now = time_source_.monotonicTime();
+  const std::chrono::nanoseconds lag =
+      std::max<std::chrono::nanoseconds>(now - probe_scheduled_ - config_.probe_interval_,
+                                         std::chrono::nanoseconds::zero());
+  min_lag_ = std::min(min_lag_, lag);
+
+  if (now - interval_start_ >= config_.interval_) {
+    if (min_lag_ >= config_.target_) {
+      // Priority 0 is never shed.
+      shed_from_ = std::max<uint32_t>(1, shed_from_ - 1);
+      ENVOY_LOG(debug, "loop lag shedding: worker saturated, min lag {}us, shedding priority {}+",
+                std::chrono::duration_cast<std::chrono::microseconds>(min_lag_).count(),
+                shed_from_);
+    } else {
+      shed_from_ = std::min(config_.max_priority_ + 1, shed_from_ + 1);
+    }
+    interval_start_ = now;
+    min_lag_ = std::chrono::nanoseconds::max();
+  }
+
+  scheduleProbe();
+}
+
+LagControllerSlotSharedPtr LagControllerRegistry::get(const LagControllerConfig& config) {
+  std::weak_ptr<LagControllerSlot>& weak_slot = slots_[config];
+  LagControllerSlotSharedPtr slot = weak_slot.lock();
+  if (slot == nullptr) {
+    slot = LagControllerSlot::makeUnique(tls_);
+    slot->set([config](Event::Dispatcher& dispatcher) {
+      return std::make_shared<LagController>(dispatcher, config);
+    });
+    weak_slot = slot;
+  }
+  return slot;
+}
+
+FilterConfig::FilterConfig(const LoopLagSheddingProto& proto_config,
+                           ThreadLocal::SlotAllocator& tls, Singleton::Manager& singleton_manager,
+                           Stats::Scope& scope, const std::string& stats_prefix)
+    : controller_config_(controllerConfig(proto_config)),
+      default_priority_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, default_priority,
+                                                        controller_config_.max_priority_)),
+      // The configs only keep their controllers, so the registry is pinned to still find them
+      // next time.
+      controllers_(singleton_manager
+                       .getTyped<LagControllerRegistry>(
+                           SINGLETON_MANAGER_REGISTERED_NAME(lag_controller_registry),
+                           [&tls] { return std::make_shared<LagControllerRegistry>(tls); },
+                           /* pin = */ true)
+                       ->get(controller_config_)),
+      stats_(generateStats(scope, stats_prefix + "loop_lag_shedding.")) {
+  if (default_priority_ > controller_config_.max_priority_) {
+    throw EnvoyException(
+        fmt::format("loop lag shedding: default_priority {} is above max_priority {}",
+                    default_priority_, controller_config_.max_priority_));
+  }
+}
+
+Http::FilterHeadersStatus LoopLagSheddingFilter::decodeHeaders(Http::RequestHeaderMap&, bool) {
+  const uint32_t priority = requestPriority();
+  if (!config_->controller().shouldShed(priority)) {
+    return Http::FilterHeadersStatus::Continue;
+  }
+
+  ENVOY_LOG(debug, "loop lag shedding: shedding request of priority {}", priority);
+  config_->stats().rq_shed_.inc();
+  decoder_callbacks_->sendLocalReply(Http::Code::ServiceUnavailable, "", nullptr, absl::nullopt,
+                                     "shed_by_loop_lag");
+  return Http::FilterHeadersStatus::StopIteration;
+}
+
+uint32_t LoopLagSheddingFilter::requestPriority() const {
+  Router::RouteConstSharedPtr route = decoder_callbacks_->route();
+  if (route == nullptr) {
+    return config_->defaultPriority();
+  }
+  const ProtobufWkt::Value& value =
+      Config::Metadata::metadataValue(&route->metadata(), filterName(), priorityKey());
+  if (value.kind_case() != ProtobufWkt::Value::kNumberValue) {
+    return config_->defaultPriority();
+  }
+  return static_cast<uint32_t>(
+      std::clamp<double>(value.number_value(), 0, config_->maxPriority()));
+}
+
+} // namespace LoopLagShedding
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
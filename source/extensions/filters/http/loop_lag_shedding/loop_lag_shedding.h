@@ -0,0 +1,165 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/extensions/filters/http/loop_lag_shedding/v3/loop_lag_shedding.pb.h"
+#include "envoy/http/filter.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/logger.h"
+#include "source/extensions/filters/http/common/pass_through_filter.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace LoopLagShedding {
+
+/**
+ * All stats for the loop lag shedding filter.
+ */
+#define ALL_LOOP_LAG_SHEDDING_STATS(COUNTER) COUNTER(rq_shed)
+
+/**
+ * Wrapper struct for loop lag shedding filter stats. @see stats_macros.h
+ */
+struct LoopLagSheddingStats {
+  ALL_LOOP_LAG_SHEDDING_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+using LoopLagSheddingProto =
+    envoy::extensions::filters::http::loop_lag_shedding::v3::LoopLagShedding;
+
+/**
+ * The parameters of the lag controllers of the workers.
+ */
+struct LagControllerConfig {
+  std::chrono::milliseconds target_;
+  std::chrono::milliseconds interval_;
+  std::chrono::milliseconds probe_interval_;
+  uint32_t max_priority_;
+
+  bool operator==(const LagControllerConfig& other) const {
+    return target_ == other.target_ && interval_ == other.interval_ &&
+           probe_interval_ == other.probe_interval_ && max_priority_ == other.max_priority_;
+  }
+
+  template <typename H> friend H AbslHashValue(H h, const LagControllerConfig& config) {
+    return H::combine(std::move(h), config.target_.count(), config.interval_.count(),
+                      config.probe_interval_.count(), config.max_priority_);
+  }
+};
+
+/**
+ * Samples the event loop lag of a worker and decides which priority classes the worker sheds. The
+ * lag is how late the probe timer fires. Following CoDel, the worker is saturated when the lowest
+ * lag of an interval is above the target: it then sheds one more priority class, from the least
+ * important one. It admits one more class again after every interval it is not saturated.
+ */
+class LagController : public ThreadLocal::ThreadLocalObject,
+                      Logger::Loggable<Logger::Id::filter> {
+public:
+  LagController(Event::Dispatcher& dispatcher, const LagControllerConfig& config);
+
+  /**
+   * @return whether requests of the priority class are currently shed.
+   */
+  bool shouldShed(uint32_t priority) const { return priority >= shed_from_; }
+
+  /**
+   * @return the most important priority class currently shed, or max priority + 1 if none is.
+   */
+  uint32_t shedFrom() const { return shed_from_; }
+
+private:
+  void scheduleProbe();
+  void onProbe();
+
+  const LagControllerConfig config_;
+  TimeSource& time_source_;
+  const Event::TimerPtr probe_timer_;
+  MonotonicTime probe_scheduled_;
+  MonotonicTime interval_start_;
+  std::chrono::nanoseconds min_lag_{std::chrono::nanoseconds::max()};
+  uint32_t shed_from_;
+};
+
+using LagControllerSlot = ThreadLocal::TypedSlot<LagController>;
+using LagControllerSlotSharedPtr = std::shared_ptr<LagControllerSlot>;
+
+/**
+ * The lag controllers of the process. Filter configs with the same controller parameters share
+ * the controller of each worker, which lives as long as any of them, so that HCMs and their LDS
+ * updates do not each probe the event loops. Only used on the main thread.
+ */
+class LagControllerRegistry : public Singleton::Instance {
+public:
+  explicit LagControllerRegistry(ThreadLocal::SlotAllocator& tls) : tls_(tls) {}
+
+  LagControllerSlotSharedPtr get(const LagControllerConfig& config);
+
+private:
+  ThreadLocal::SlotAllocator& tls_;
+  absl::flat_hash_map<LagControllerConfig, std::weak_ptr<LagControllerSlot>> slots_;
+};
+
+/**
+ * Configuration for the loop lag shedding filter.
+ */
+class FilterConfig {
+public:
+  FilterConfig(const LoopLagSheddingProto& proto_config, ThreadLocal::SlotAllocator& tls,
+               Singleton::Manager& singleton_manager, Stats::Scope& scope,
+               const std::string& stats_prefix);
+
+  LagController& controller() const { return **controllers_; }
+  uint32_t maxPriority() const { return controller_config_.max_priority_; }
+  uint32_t defaultPriority() const { return default_priority_; }
+  LoopLagSheddingStats& stats() { return stats_; }
+
+private:
+  static LoopLagSheddingStats generateStats(Stats::Scope& scope, const std::string& prefix) {
+    return {ALL_LOOP_LAG_SHEDDING_STATS(POOL_COUNTER_PREFIX(scope, prefix))};
+  }
+
+  const LagControllerConfig controller_config_;
+  const uint32_t default_priority_;
+  const LagControllerSlotSharedPtr controllers_;
+  LoopLagSheddingStats stats_;
+};
+
+using FilterConfigSharedPtr = std::shared_ptr<FilterConfig>;
+
+/**
+ * A filter that rejects the requests of the least important priority classes while the event loop
+ * of its worker is saturated.
+ */
+class LoopLagSheddingFilter : public Http::PassThroughDecoderFilter,
+                              Logger::Loggable<Logger::Id::filter> {
+public:
+  explicit LoopLagSheddingFilter(FilterConfigSharedPtr config) : config_(std::move(config)) {}
+
+  // Http::StreamDecoderFilter
+  Http::FilterHeadersStatus decodeHeaders(Http::RequestHeaderMap& headers,
+                                          bool end_stream) override;
+
+private:
+  uint32_t requestPriority() const;
+
+  const FilterConfigSharedPtr config_;
+};
+
+} // namespace LoopLagShedding
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -441,6 +441,7 @@ public:
   }
 
   bool disabled() const { return disabled_; }
+  bool disablesFilter() const override { return disabled_; }
   const std::string& name() const { return name_; }
   PerLuaCodeSetup* perLuaCodeSetup() const { return per_lua_code_setup_ptr_.get(); }
 
@@ -6,9 +6,11 @@
 #include "envoy/extensions/filters/http/ratelimit/v3/rate_limit.pb.h"
 #include "envoy/extensions/filters/http/ratelimit/v3/rate_limit.pb.validate.h"
 #include "envoy/registry/registry.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/config/utility.h"
 #include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/common/ratelimit/batching_client_impl.h"
 #include "source/extensions/filters/common/ratelimit/ratelimit_impl.h"
 #include "source/extensions/filters/http/ratelimit/ratelimit.h"
 
@@ -17,6 +19,18 @@ namespace Extensions {
 namespace HttpFilters {
 namespace RateLimitFilter {
 
+namespace {
+
+// The batcher of a worker, created when the worker builds its first filter.
+struct ThreadLocalBatcher : public ThreadLocal::ThreadLocalObject {
+  explicit ThreadLocalBatcher(Event::Dispatcher& dispatcher) : dispatcher_(dispatcher) {}
+
+  Event::Dispatcher& dispatcher_;
+  Filters::Common::RateLimit::RateLimitBatcherSharedPtr batcher_;
+};
+
+} // namespace
+
 Http::FilterFactoryCb RateLimitFilterConfig::createFilterFactoryFromProtoTyped(
     const envoy::extensions::filters::http::ratelimit::v3::RateLimit& proto_config,
     const std::string&, Server::Configuration::FactoryContext& context) {
@@ -32,6 +46,38 @@ Http::FilterFactoryCb RateLimitFilterConfig::createFilterFactoryFromProtoTyped(
   THROW_IF_NOT_OK(Config::Utility::checkTransportVersion(proto_config.rate_limit_service()));
   Grpc::GrpcServiceConfigWithHashKey config_with_hash_key =
       Grpc::GrpcServiceConfigWithHashKey(proto_config.rate_limit_service().grpc_service());
+  if (proto_config.has_batching()) {
+    const auto& batching = proto_config.batching();
+    const std::chrono::milliseconds window(PROTOBUF_GET_MS_REQUIRED(batching, window));
+    const uint32_t max_descriptors =
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(batching, max_descriptors, 100);
+    const std::chrono::milliseconds ok_lease_duration(
+        PROTOBUF_GET_MS_OR_DEFAULT(batching, ok_lease_duration, 0));
+    std::shared_ptr<ThreadLocal::TypedSlot<ThreadLocalBatcher>> tls =
+        ThreadLocal::TypedSlot<ThreadLocalBatcher>::makeUnique(server_context.threadLocal());
+    tls->set([](Event::Dispatcher& dispatcher) {
+      return std::make_shared<ThreadLocalBatcher>(dispatcher);
+    });
+    return [config_with_hash_key, &context, timeout, window, max_descriptors, ok_lease_duration,
+            tls, filter_config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
+      ThreadLocalBatcher& local = *tls->get();
+      if (local.batcher_ == nullptr) {
+        auto client_or_error =
+            context.serverFactoryContext()
+                .clusterManager()
+                .grpcAsyncClientManager()
+                .getOrCreateRawAsyncClientWithHashKey(config_with_hash_key, context.scope(), true);
+        THROW_IF_STATUS_NOT_OK(client_or_error, throw);
+        local.batcher_ = std::make_shared<Filters::Common::RateLimit::RateLimitBatcher>(
+            client_or_error.value(), timeout, local.dispatcher_, window, max_descriptors,
+            ok_lease_duration);
+      }
+      callbacks.addStreamFilter(std::make_shared<Filter>(
+          filter_config,
+          std::make_unique<Filters::Common::RateLimit::BatchingClientImpl>(local.batcher_)));
+    };
+  }
+
   return [config_with_hash_key, &context, timeout,
           filter_config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addStreamFilter(std::make_shared<Filter>(
@@ -19,6 +19,7 @@
 #include "source/common/common/empty_string.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/hex.h"
+#include "source/common/common/macros.h"
 #include "source/common/common/safe_memcpy.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/address_impl.h"
@@ -48,6 +49,14 @@ namespace Extensions {
 namespace ListenerFilters {
 namespace ProxyProtocol {
 
+namespace {
+
+const std::string& defaultMetadataNamespace() {
+  CONSTRUCT_ON_FIRST_USE(std::string, "envoy.filters.listener.proxy_protocol");
+}
+
+} // namespace
+
 Config::Config(
     Stats::Scope& scope,
     const envoy::extensions::filters::listener::proxy_protocol::v3::ProxyProtocol& proto_config)
@@ -407,6 +416,10 @@ bool Filter::parseV1Header(const char* buf, size_t len) {
  *        See https://www.haproxy.org/download/2.1/doc/proxy-protocol.txt for details
  */
 bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
+  // The TLVs saved to dynamic metadata are gathered per metadata namespace, starting from the
+  // metadata already set, and set once all the TLVs have been read.
+  absl::flat_hash_map<std::string, ProtobufWkt::Struct> tlv_metadata;
+  bool parsed = true;
   size_t idx{0};
   while (idx < len) {
     const uint8_t tlv_type = buf[idx];
@@ -417,7 +430,8 @@ bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
                 fmt::format("failed to read proxy protocol extension. No bytes for TLV length. "
                             "Extension length is {}, current index is {}, current type is {}.",
                             len, idx, tlv_type));
-      return false;
+      parsed = false;
+      break;
     }
 
     const uint8_t tlv_length_upper = buf[idx];
@@ -433,7 +447,8 @@ bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
                       "Extension length is {}, current index is {}, current type is {}, current "
                       "value length is {}.",
                       len, idx, tlv_type, tlv_length_upper));
-      return false;
+      parsed = false;
+      break;
     }
 
     // Only save to dynamic metadata if this type of TLV is needed.
@@ -445,14 +460,15 @@ bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
       auto sanitised_tlv_value = MessageUtil::sanitizeUtf8String(tlv_value);
       metadata_value.set_string_value(sanitised_tlv_value.data(), sanitised_tlv_value.size());
 
-      std::string metadata_key = key_value_pair->metadata_namespace().empty()
-                                     ? "envoy.filters.listener.proxy_protocol"
-                                     : key_value_pair->metadata_namespace();
+      const std::string& metadata_key = key_value_pair->metadata_namespace().empty()
+                                            ? defaultMetadataNamespace()
+                                            : key_value_pair->metadata_namespace();
 
-      ProtobufWkt::Struct metadata(
-          (*cb_->dynamicMetadata().mutable_filter_metadata())[metadata_key]);
-      metadata.mutable_fields()->insert({key_value_pair->key(), metadata_value});
-      cb_->setDynamicMetadata(metadata_key, metadata);
+      auto [metadata, inserted] = tlv_metadata.try_emplace(metadata_key);
+      if (inserted) {
+        metadata->second = (*cb_->dynamicMetadata().mutable_filter_metadata())[metadata_key];
+      }
+      metadata->second.mutable_fields()->insert({key_value_pair->key(), metadata_value});
     } else {
       ENVOY_LOG(trace,
                 "proxy_protocol: Skip TLV of type {} since it's not needed for dynamic metadata",
@@ -468,7 +484,11 @@ bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
     idx += tlv_value_length;
     ASSERT(idx <= len);
   }
-  return true;
+
+  for (const auto& [metadata_key, metadata] : tlv_metadata) {
+    cb_->setDynamicMetadata(metadata_key, metadata);
+  }
+  return parsed;
 }
 
 ReadOrParseState Filter::readExtensions(Network::ListenerFilterBuffer& buffer) {
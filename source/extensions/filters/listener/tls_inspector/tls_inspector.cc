@@ -96,11 +96,7 @@ Config::Config(
 bssl::UniquePtr<SSL> Config::newSsl() { return bssl::UniquePtr<SSL>{SSL_new(ssl_ctx_.get())}; }
 
 Filter::Filter(const ConfigSharedPtr& config)
-    : config_(config), ssl_(config_->newSsl()),
-      requested_read_bytes_(config->initialReadBufferSize()) {
-  SSL_set_app_data(ssl_.get(), this);
-  SSL_set_accept_state(ssl_.get());
-}
+    : config_(config), requested_read_bytes_(config->initialReadBufferSize()) {}
 
 Network::FilterStatus Filter::onAccept(Network::ListenerFilterCallbacks& cb) {
   ENVOY_LOG(trace, "tls inspector: new connection accepted");
@@ -171,6 +167,21 @@ Network::FilterStatus Filter::onData(Network::ListenerFilterBuffer& buffer) {
 
 ParseState Filter::parseClientHello(const void* data, size_t len,
                                     uint64_t bytes_already_processed) {
+  // A TLS connection starts with a handshake record, so that other protocols are told apart on
+  // their first byte, without creating an SSL object for them.
+  if (bytes_already_processed == 0 &&
+      static_cast<const uint8_t*>(data)[0] != SSL3_RT_HANDSHAKE) {
+    config_->stats().tls_not_found_.inc();
+    config_->stats().bytes_processed_.recordValue(1);
+    return ParseState::Done;
+  }
+
+  if (ssl_ == nullptr) {
+    ssl_ = config_->newSsl();
+    SSL_set_app_data(ssl_.get(), this);
+    SSL_set_accept_state(ssl_.get());
+  }
+
   // Ownership remains here though we pass a reference to it in `SSL_set0_rbio()`.
   bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(data, len));
 
@@ -458,7 +458,10 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
       } else {
         ASSERT(current_value.value_->type() == RespType::BulkString);
         if (!pending_integer_.negative_) {
-          // TODO(mattklein123): reserve and define max length since we don't stream currently.
+          // Large values span many slices, reserving avoids copying them again as they grow.
+          // TODO(mattklein123): define max length since we don't stream currently.
+          current_value.value_->asString().reserve(
+              std::min(static_cast<uint64_t>(pending_integer_.integer_), MaxBulkStringReserve));
           state_ = State::BulkStringBody;
         } else {
           // Null bulk string. Switch type to null and move to value complete.
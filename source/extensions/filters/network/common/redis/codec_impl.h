@@ -26,6 +26,11 @@ public:
   // RedisProxy::Decoder
   void decode(Buffer::Instance& data) override;
 
+  // Bulk strings up to this length are allocated in one go before their body is received. Longer
+  // ones grow as their body arrives, so that a peer announcing a huge length without sending it
+  // does not get the whole length allocated.
+  static constexpr uint64_t MaxBulkStringReserve = 1024 * 1024;
+
 private:
   enum class State {
     ValueRootStart,
@@ -5,8 +5,10 @@
 #include <vector>
 
 #include "source/common/common/macros.h"
+#include "source/common/common/utility.h"
 
 #include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -106,8 +108,18 @@ struct SupportedCommands {
                            "zremrangebylex", "zremrangebyrank", "zremrangebyscore", "unlink");
   }
 
-  static bool isReadCommand(const std::string& command) {
-    return !writeCommands().contains(command);
+  /**
+   * @return true if the command, in any case, does not alter the state of redis. This is checked
+   *         for each fragment of split commands, so the command is not lowercased first.
+   */
+  static bool isReadCommand(absl::string_view command) {
+    return !caseInsensitiveWriteCommands().contains(command);
+  }
+
+private:
+  static const StringUtil::CaseUnorderedSet& caseInsensitiveWriteCommands() {
+    CONSTRUCT_ON_FIRST_USE(StringUtil::CaseUnorderedSet, writeCommands().begin(),
+                           writeCommands().end());
   }
 };
 
@@ -30,9 +30,7 @@ bool MirrorPolicyImpl::shouldMirror(const std::string& command) const {
     return false;
   }
 
-  std::string to_lower_string = absl::AsciiStrToLower(command);
-
-  if (exclude_read_commands_ && Common::Redis::SupportedCommands::isReadCommand(to_lower_string)) {
+  if (exclude_read_commands_ && Common::Redis::SupportedCommands::isReadCommand(command)) {
     return false;
   }
 
@@ -60,11 +58,8 @@ Prefix::Prefix(
 
 ConnPool::InstanceSharedPtr Prefix::upstream(const std::string& command) const {
 
-  if (read_upstream_) {
-    std::string to_lower_string = absl::AsciiStrToLower(command);
-    if (Common::Redis::SupportedCommands::isReadCommand(to_lower_string)) {
-      return read_upstream_;
-    }
+  if (read_upstream_ && Common::Redis::SupportedCommands::isReadCommand(command)) {
+    return read_upstream_;
   }
 
   return upstream_;
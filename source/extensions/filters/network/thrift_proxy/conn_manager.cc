@@ -211,7 +211,9 @@ DecoderEventHandler& ConnectionManager::newDecoderEventHandler() {
 }
 
 bool ConnectionManager::ResponseDecoder::passthroughEnabled() const {
-  return parent_.parent_.passthroughEnabled();
+  // With pipelined requests, the most recent request may have been routed differently than the one
+  // this response is for, so only the filter chain of the latter decides.
+  return parent_.parent_.config_.payloadPassthrough() && parent_.passthroughSupported();
 }
 
 bool ConnectionManager::passthroughEnabled() const {
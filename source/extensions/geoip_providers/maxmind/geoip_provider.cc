@@ -133,9 +133,7 @@ void GeoipProvider::lookupInCityDb(
     MMDB_lookup_result_s mmdb_lookup_result = MMDB_lookup_sockaddr(
         city_db_.get(), reinterpret_cast<const sockaddr*>(remote_address->sockAddr()), &mmdb_error);
     if (!mmdb_error) {
-      MMDB_entry_data_list_s* entry_data_list;
-      int status = MMDB_get_entry_data_list(&mmdb_lookup_result.entry, &entry_data_list);
-      if (status == MMDB_SUCCESS) {
+      if (mmdb_lookup_result.found_entry) {
         if (config_->isLookupEnabledForHeader(config_->cityHeader())) {
           populateGeoLookupResult(mmdb_lookup_result, lookup_result, config_->cityHeader().value(),
                                   MMDB_CITY_LOOKUP_ARGS[0], MMDB_CITY_LOOKUP_ARGS[1],
@@ -154,7 +152,6 @@ void GeoipProvider::lookupInCityDb(
         if (lookup_result.size() > n_prev_hits) {
           config_->incHit("city_db");
         }
-        MMDB_free_entry_data_list(entry_data_list);
       }
 
     } else {
@@ -174,12 +171,9 @@ void GeoipProvider::lookupInAsnDb(
     MMDB_lookup_result_s mmdb_lookup_result = MMDB_lookup_sockaddr(
         isp_db_.get(), reinterpret_cast<const sockaddr*>(remote_address->sockAddr()), &mmdb_error);
     if (!mmdb_error) {
-      MMDB_entry_data_list_s* entry_data_list;
-      int status = MMDB_get_entry_data_list(&mmdb_lookup_result.entry, &entry_data_list);
-      if (status == MMDB_SUCCESS && entry_data_list) {
+      if (mmdb_lookup_result.found_entry) {
         populateGeoLookupResult(mmdb_lookup_result, lookup_result, config_->asnHeader().value(),
                                 MMDB_ASN_LOOKUP_ARGS[0]);
-        MMDB_free_entry_data_list(entry_data_list);
         if (lookup_result.size() > n_prev_hits) {
           config_->incHit("isp_db");
         }
@@ -201,9 +195,7 @@ void GeoipProvider::lookupInAnonDb(
     MMDB_lookup_result_s mmdb_lookup_result = MMDB_lookup_sockaddr(
         anon_db_.get(), reinterpret_cast<const sockaddr*>(remote_address->sockAddr()), &mmdb_error);
     if (!mmdb_error) {
-      MMDB_entry_data_list_s* entry_data_list;
-      int status = MMDB_get_entry_data_list(&mmdb_lookup_result.entry, &entry_data_list);
-      if (status == MMDB_SUCCESS) {
+      if (mmdb_lookup_result.found_entry) {
         if (config_->isLookupEnabledForHeader(config_->anonHeader())) {
           populateGeoLookupResult(mmdb_lookup_result, lookup_result, config_->anonHeader().value(),
                                   MMDB_ANON_LOOKUP_ARGS[0]);
@@ -227,9 +219,6 @@ void GeoipProvider::lookupInAnonDb(
         if (lookup_result.size() > n_prev_hits) {
           config_->incHit("anon_db");
         }
-        MMDB_free_entry_data_list(entry_data_list);
-      } else {
-        config_->incLookupError("anon_db");
       }
     }
     config_->incTotal("anon_db");
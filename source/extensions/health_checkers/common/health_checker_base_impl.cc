@@ -37,6 +37,8 @@ HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
           PROTOBUF_GET_MS_OR_DEFAULT(config, unhealthy_edge_interval, unhealthy_interval_.count())),
       healthy_edge_interval_(
           PROTOBUF_GET_MS_OR_DEFAULT(config, healthy_edge_interval, interval_.count())),
+      eds_healthy_interval_(
+          PROTOBUF_GET_MS_OR_DEFAULT(config, eds_healthy_interval, interval_.count())),
       transport_socket_options_(initTransportSocketOptions(config)),
       transport_socket_match_metadata_(initTransportSocketMatchMetadata(config)),
       member_update_cb_{cluster_.prioritySet().addMemberUpdateCb(
@@ -97,7 +99,7 @@ void HealthCheckerImplBase::incHealthy() { stats_.healthy_.add(1); }
 
 void HealthCheckerImplBase::incDegraded() { stats_.degraded_.add(1); }
 
-std::chrono::milliseconds HealthCheckerImplBase::interval(HealthState state,
+std::chrono::milliseconds HealthCheckerImplBase::interval(const Host& host, HealthState state,
                                                           HealthTransition changed_state) const {
   // See if the cluster has ever made a connection. If not, we use a much slower interval to keep
   // the host info relatively up to date in case we suddenly start sending traffic to this cluster.
@@ -122,9 +124,14 @@ std::chrono::milliseconds HealthCheckerImplBase::interval(HealthState state,
                          : unhealthy_interval_.count();
       break;
     default:
-      base_time_ms = changed_state == HealthTransition::ChangePending
-                         ? healthy_edge_interval_.count()
-                         : interval_.count();
+      if (changed_state == HealthTransition::ChangePending) {
+        base_time_ms = healthy_edge_interval_.count();
+      } else if (host.edsHealthStatus() == envoy::config::core::v3::HEALTHY) {
+        // The health reported by EDS only needs to be verified sparsely.
+        base_time_ms = eds_healthy_interval_.count();
+      } else {
+        base_time_ms = interval_.count();
+      }
       break;
     }
   } else {
@@ -334,7 +341,7 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degrade
   parent_.runCallbacks(host_, changed_state);
 
   timeout_timer_->disableTimer();
-  interval_timer_->enableTimer(parent_.interval(HealthState::Healthy, changed_state));
+  interval_timer_->enableTimer(parent_.interval(*host_, HealthState::Healthy, changed_state));
 }
 
 namespace {
@@ -402,7 +409,7 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleFailure(
   }
 
   if (interval_timer_ != nullptr) {
-    interval_timer_->enableTimer(parent_.interval(HealthState::Unhealthy, changed_state));
+    interval_timer_->enableTimer(parent_.interval(*host_, HealthState::Unhealthy, changed_state));
   }
 }
 
@@ -69,6 +69,7 @@ HttpHealthCheckerImpl::HttpHealthCheckerImpl(const Cluster& cluster,
       request_headers_parser_(
           Router::HeaderParser::configure(config.http_health_check().request_headers_to_add(),
                                           config.http_health_check().request_headers_to_remove())),
+      request_headers_constant_(request_headers_parser_->isConstant()),
       http_status_checker_(config.http_health_check().expected_statuses(),
                            config.http_health_check().retriable_statuses(),
                            static_cast<uint64_t>(Http::Code::OK)),
@@ -267,11 +268,16 @@ void HttpHealthCheckerImpl::HttpActiveHealthCheckSession::onInterval() {
       // Here there is no downstream connection so scheme will be based on
       // upstream crypto
       host_->transportSocketFactory().implementsSecureTransport());
-  StreamInfo::StreamInfoImpl stream_info(protocol_, parent_.dispatcher_.timeSource(),
-                                         local_connection_info_provider_);
-  stream_info.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
-  stream_info.upstreamInfo()->setUpstreamHost(host_);
-  parent_.request_headers_parser_->evaluateHeaders(*request_headers, stream_info);
+  if (parent_.request_headers_constant_) {
+    // Constant headers need no stream info, which would cost allocations for every check.
+    parent_.request_headers_parser_->evaluateHeaders(*request_headers, nullptr);
+  } else {
+    StreamInfo::StreamInfoImpl stream_info(protocol_, parent_.dispatcher_.timeSource(),
+                                           local_connection_info_provider_);
+    stream_info.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
+    stream_info.upstreamInfo()->setUpstreamHost(host_);
+    parent_.request_headers_parser_->evaluateHeaders(*request_headers, stream_info);
+  }
   auto status = request_encoder->encodeHeaders(*request_headers, true);
   // Encoding will only fail if required request headers are missing.
   ASSERT(status.ok());
@@ -179,6 +179,7 @@ private:
   absl::optional<Matchers::StringMatcherImpl<envoy::type::matcher::v3::StringMatcher>>
       service_name_matcher_;
   Router::HeaderParserPtr request_headers_parser_;
+  const bool request_headers_constant_;
   const HttpStatusChecker http_status_checker_;
 
 protected:
@@ -83,6 +83,12 @@ FileSystemHttpCache::FileSystemHttpCache(
     : owner_(owner), async_file_manager_(async_file_manager),
       shared_(std::make_shared<CacheShared>(config, stats_scope)),
       cache_eviction_thread_(cache_eviction_thread) {
+  if (shared_->config_.has_memory_tier()) {
+    const auto& memory_tier = shared_->config_.memory_tier();
+    memory_tier_ = std::make_unique<MemoryTier>(
+        memory_tier.max_size_bytes().value(),
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(memory_tier, promote_after_hits, 2));
+  }
   cache_eviction_thread_.addCache(shared_);
 }
 
@@ -319,7 +325,15 @@ std::shared_ptr<Cleanup> FileSystemHttpCache::maybeStartWritingEntry(const Key&
   if (!entries_being_written_.emplace(key).second) {
     return nullptr;
   }
+  if (memory_tier_ != nullptr) {
+    memory_tier_->invalidate(key);
+  }
   return std::make_shared<Cleanup>([this, key]() {
+    if (memory_tier_ != nullptr) {
+      // Also invalidate at the end, so that a lookup which read the old file while it was
+      // being replaced does not promote it.
+      memory_tier_->invalidate(key);
+    }
     absl::MutexLock lock(&cache_mu_);
     entries_being_written_.erase(key);
   });
@@ -7,6 +7,7 @@
 #include "source/common/common/logger.h"
 #include "source/extensions/common/async_files/async_file_manager.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/file_system_http_cache/memory_tier.h"
 #include "source/extensions/http/cache/file_system_http_cache/stats.h"
 
 #include "absl/base/thread_annotations.h"
@@ -168,6 +169,12 @@ public:
     return async_file_manager_;
   }
 
+  /**
+   * Returns the in-memory tier of this cache, if one is configured.
+   * @return the MemoryTier, or nullptr if the cache is disk-only.
+   */
+  MemoryTier* memoryTier() const { return memory_tier_.get(); }
+
   /**
    * Updates stats to reflect that a file has been added to the cache.
    * @param file_size The size in bytes of the file that was added.
@@ -218,6 +225,9 @@ private:
 
   std::shared_ptr<Common::AsyncFiles::AsyncFileManager> async_file_manager_;
 
+  // Small frequently read cache files, if configured.
+  std::unique_ptr<MemoryTier> memory_tier_;
+
   // Stats and config are held in a shared_ptr so that CacheEvictionThread can use
   // them even if the cache instance has been deleted while it performed work.
   std::shared_ptr<CacheShared> shared_;
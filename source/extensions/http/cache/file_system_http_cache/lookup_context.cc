@@ -1,5 +1,6 @@
 #include "source/extensions/http/cache/file_system_http_cache/lookup_context.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/extensions/http/cache/file_system_http_cache/cache_file_fixed_block.h"
 #include "source/extensions/http/cache/file_system_http_cache/cache_file_header.pb.h"
 #include "source/extensions/http/cache/file_system_http_cache/cache_file_header_proto_util.h"
@@ -27,6 +28,17 @@ void FileLookupContext::getHeaders(LookupHeadersCallback&& cb) {
 
 void FileLookupContext::getHeadersWithLock(LookupHeadersCallback cb) {
   mu_.AssertHeld();
+  read_ahead_ = nullptr;
+  from_memory_ = false;
+  if (MemoryTier* memory_tier = cache_.memoryTier()) {
+    read_ahead_ = memory_tier->lookup(key_);
+    if (read_ahead_ != nullptr) {
+      from_memory_ = true;
+      onFileStartRead(std::move(cb));
+      return;
+    }
+    memory_tier_generation_ = memory_tier->generation();
+  }
   cancel_action_in_flight_ = cache_.asyncFileManager()->openExistingFile(
       filepath(), Common::AsyncFiles::AsyncFileManager::Mode::ReadOnly,
       [this, cb](absl::StatusOr<AsyncFileHandle> open_result) {
@@ -39,75 +51,113 @@ void FileLookupContext::getHeadersWithLock(LookupHeadersCallback cb) {
         }
         ASSERT(!file_handle_);
         file_handle_ = std::move(open_result.value());
+        // Read past the fixed block so that, for most entries, the headers and small bodies come
+        // back from the same read instead of costing another trip through the file thread pool.
         auto queued = file_handle_->read(
-            0, CacheFileFixedBlock::size(),
+            0, CacheFileFixedBlock::size() + ReadAheadSize,
             [this, cb](absl::StatusOr<Buffer::InstancePtr> read_result) {
               absl::MutexLock lock(&mu_);
               cancel_action_in_flight_ = nullptr;
               if (!read_result.ok() ||
-                  read_result.value()->length() != CacheFileFixedBlock::size()) {
+                  read_result.value()->length() < CacheFileFixedBlock::size()) {
                 invalidateCacheEntry();
                 cache_.stats().cache_miss_.inc();
                 cb(LookupResult{});
                 return;
               }
-              header_block_.populateFromStringView(read_result.value()->toString());
-              if (!header_block_.isValid()) {
-                invalidateCacheEntry();
-                cache_.stats().cache_miss_.inc();
-                cb(LookupResult{});
-                return;
-              }
-              auto queued = file_handle_->read(
-                  header_block_.offsetToHeaders(), header_block_.headerSize(),
-                  [this, cb](absl::StatusOr<Buffer::InstancePtr> read_result) {
-                    absl::MutexLock lock(&mu_);
-                    cancel_action_in_flight_ = nullptr;
-                    if (!read_result.ok() ||
-                        read_result.value()->length() != header_block_.headerSize()) {
-                      invalidateCacheEntry();
-                      cache_.stats().cache_miss_.inc();
-                      cb(LookupResult{});
-                      return;
-                    }
-                    auto header_proto = makeCacheFileHeaderProto(*read_result.value());
-                    if (header_proto.headers_size() == 1 &&
-                        header_proto.headers().at(0).key() == "vary") {
-                      auto maybe_vary_key = cache_.makeVaryKey(
-                          key_, lookup().varyAllowList(),
-                          absl::StrSplit(header_proto.headers().at(0).value(), ','),
-                          lookup().requestHeaders());
-                      if (!maybe_vary_key.has_value()) {
-                        cache_.stats().cache_miss_.inc();
-                        cb(LookupResult{});
-                        return;
-                      }
-                      key_ = maybe_vary_key.value();
-                      auto fh = std::move(file_handle_);
-                      file_handle_ = nullptr;
-                      // It should be possible to cancel close, to make this safe.
-                      // (it should still close the file, but cancel the callback.)
-                      auto queued = fh->close([this, cb](absl::Status) {
-                        absl::MutexLock lock(&mu_);
-                        // Restart getHeaders with the new key.
-                        return getHeadersWithLock(cb);
-                      });
-                      ASSERT(queued.ok(), queued.ToString());
-                      return;
-                    }
-                    cache_.stats().cache_hit_.inc();
-                    cb(lookup().makeLookupResult(
-                        headersFromHeaderProto(header_proto), metadataFromHeaderProto(header_proto),
-                        header_block_.bodySize(), header_block_.trailerSize() > 0));
-                  });
-              ASSERT(queued.ok(), queued.status().ToString());
-              cancel_action_in_flight_ = queued.value();
+              read_ahead_ =
+                  std::make_shared<const std::string>(read_result.value()->toString());
+              onFileStartRead(cb);
             });
         ASSERT(queued.ok(), queued.status().ToString());
         cancel_action_in_flight_ = queued.value();
       });
 }
 
+void FileLookupContext::onFileStartRead(LookupHeadersCallback cb) {
+  mu_.AssertHeld();
+  header_block_.populateFromStringView(
+      absl::string_view(*read_ahead_).substr(0, CacheFileFixedBlock::size()));
+  if (!header_block_.isValid()) {
+    invalidateCacheEntry();
+    cache_.stats().cache_miss_.inc();
+    cb(LookupResult{});
+    return;
+  }
+  if (readAheadCovers(header_block_.offsetToHeaders(), header_block_.headerSize())) {
+    Buffer::OwnedImpl headers(absl::string_view(*read_ahead_).substr(
+        header_block_.offsetToHeaders(), header_block_.headerSize()));
+    onHeadersRead(cb, headers);
+    return;
+  }
+  if (file_handle_ == nullptr) {
+    // The entry came from memory but is truncated, which should not happen.
+    cache_.stats().cache_miss_.inc();
+    cb(LookupResult{});
+    return;
+  }
+  auto queued = file_handle_->read(
+      header_block_.offsetToHeaders(), header_block_.headerSize(),
+      [this, cb](absl::StatusOr<Buffer::InstancePtr> read_result) {
+        absl::MutexLock lock(&mu_);
+        cancel_action_in_flight_ = nullptr;
+        if (!read_result.ok() || read_result.value()->length() != header_block_.headerSize()) {
+          invalidateCacheEntry();
+          cache_.stats().cache_miss_.inc();
+          cb(LookupResult{});
+          return;
+        }
+        onHeadersRead(cb, *read_result.value());
+      });
+  ASSERT(queued.ok(), queued.status().ToString());
+  cancel_action_in_flight_ = queued.value();
+}
+
+void FileLookupContext::onHeadersRead(LookupHeadersCallback cb, Buffer::Instance& headers) {
+  mu_.AssertHeld();
+  auto header_proto = makeCacheFileHeaderProto(headers);
+  if (header_proto.headers_size() == 1 && header_proto.headers().at(0).key() == "vary") {
+    auto maybe_vary_key =
+        cache_.makeVaryKey(key_, lookup().varyAllowList(),
+                           absl::StrSplit(header_proto.headers().at(0).value(), ','),
+                           lookup().requestHeaders());
+    if (!maybe_vary_key.has_value()) {
+      cache_.stats().cache_miss_.inc();
+      cb(LookupResult{});
+      return;
+    }
+    key_ = maybe_vary_key.value();
+    if (file_handle_ == nullptr) {
+      // The vary entry came from memory, so there is no file to close.
+      getHeadersWithLock(std::move(cb));
+      return;
+    }
+    auto fh = std::move(file_handle_);
+    file_handle_ = nullptr;
+    // It should be possible to cancel close, to make this safe.
+    // (it should still close the file, but cancel the callback.)
+    auto queued = fh->close([this, cb](absl::Status) {
+      absl::MutexLock lock(&mu_);
+      // Restart getHeaders with the new key.
+      return getHeadersWithLock(cb);
+    });
+    ASSERT(queued.ok(), queued.ToString());
+    return;
+  }
+  MemoryTier* memory_tier = cache_.memoryTier();
+  if (memory_tier != nullptr && !from_memory_ && readAheadCovers(0, header_block_.offsetToEnd())) {
+    memory_tier->onDiskHit(key_, read_ahead_, memory_tier_generation_);
+  }
+  cache_.stats().cache_hit_.inc();
+  cb(lookup().makeLookupResult(headersFromHeaderProto(header_proto),
+                               metadataFromHeaderProto(header_proto), header_block_.bodySize(),
+                               header_block_.trailerSize() > 0));
+}
+
+bool FileLookupContext::readAheadCovers(uint64_t offset, uint64_t length) const {
+  return read_ahead_ != nullptr && offset + length <= read_ahead_->size();
+}
+
 void FileLookupContext::invalidateCacheEntry() {
   cache_.asyncFileManager()->stat(
       filepath(), [file = filepath(),
@@ -127,6 +177,11 @@ void FileLookupContext::invalidateCacheEntry() {
 void FileLookupContext::getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) {
   absl::MutexLock lock(&mu_);
   ASSERT(!cancel_action_in_flight_);
+  if (readAheadCovers(header_block_.offsetToBody() + range.begin(), range.length())) {
+    cb(std::make_unique<Buffer::OwnedImpl>(absl::string_view(*read_ahead_).substr(
+        header_block_.offsetToBody() + range.begin(), range.length())));
+    return;
+  }
   auto queued = file_handle_->read(
       header_block_.offsetToBody() + range.begin(), range.length(),
       [this, cb, range](absl::StatusOr<Buffer::InstancePtr> read_result) {
@@ -148,6 +203,13 @@ void FileLookupContext::getTrailers(LookupTrailersCallback&& cb) {
   ASSERT(cb);
   absl::MutexLock lock(&mu_);
   ASSERT(!cancel_action_in_flight_);
+  if (readAheadCovers(header_block_.offsetToTrailers(), header_block_.trailerSize())) {
+    CacheFileTrailer trailer;
+    trailer.ParseFromString(
+        read_ahead_->substr(header_block_.offsetToTrailers(), header_block_.trailerSize()));
+    cb(trailersFromTrailerProto(trailer));
+    return;
+  }
   auto queued = file_handle_->read(header_block_.offsetToTrailers(), header_block_.trailerSize(),
                                    [this, cb](absl::StatusOr<Buffer::InstancePtr> read_result) {
                                      absl::MutexLock lock(&mu_);
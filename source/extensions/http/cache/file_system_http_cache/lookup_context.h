@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "source/extensions/common/async_files/async_file_handle.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
@@ -35,9 +36,22 @@ public:
   const Key& key() const { return key_; }
   bool workInProgress() const;
 
+  // How much of the cache file, beyond the fixed block, is read when the file is opened.
+  static constexpr size_t ReadAheadSize = 16 * 1024;
+
 private:
   void getHeadersWithLock(LookupHeadersCallback cb) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Continues getHeaders once read_ahead_ holds the start of the cache file.
+  void onFileStartRead(LookupHeadersCallback cb) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Finishes getHeaders once the serialized headers have been read.
+  void onHeadersRead(LookupHeadersCallback cb, Buffer::Instance& headers)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // True if the given part of the cache file was included in the first read of the file.
+  bool readAheadCovers(uint64_t offset, uint64_t length) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   // In the event that the cache failed to retrieve, remove the cache entry from the
   // cache so we don't keep repeating the same failure.
   void invalidateCacheEntry() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
@@ -55,6 +69,12 @@ private:
   CancelFunction cancel_action_in_flight_ ABSL_GUARDED_BY(mu_);
   CacheFileFixedBlock header_block_ ABSL_GUARDED_BY(mu_);
   Key key_ ABSL_GUARDED_BY(mu_);
+  // The start of the cache file, as returned by the first read after opening it, or the whole
+  // file if it came from the cache's memory tier.
+  std::shared_ptr<const std::string> read_ahead_ ABSL_GUARDED_BY(mu_);
+  bool from_memory_ ABSL_GUARDED_BY(mu_) = false;
+  // The memory tier's generation when the file was opened.
+  uint64_t memory_tier_generation_ ABSL_GUARDED_BY(mu_) = 0;
 
   const LookupRequest lookup_;
 };
@@ -0,0 +1,80 @@
+#include "source/extensions/http/cache/file_system_http_cache/memory_tier.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace FileSystemHttpCache {
+
+namespace {
+// How many not-yet-promoted keys have their hits counted before the counts are reset.
+constexpr size_t MaxTrackedDiskHits = 16 * 1024;
+} // namespace
+
+MemoryTier::MemoryTier(uint64_t max_size_bytes, uint32_t promote_after_hits)
+    : max_size_bytes_(max_size_bytes), promote_after_hits_(promote_after_hits) {}
+
+std::shared_ptr<const std::string> MemoryTier::lookup(const Key& key) {
+  absl::MutexLock lock(&mu_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position_);
+  return it->second.contents_;
+}
+
+void MemoryTier::onDiskHit(const Key& key, std::shared_ptr<const std::string> contents,
+                           uint64_t generation) {
+  if (contents->size() > max_size_bytes_) {
+    return;
+  }
+  absl::MutexLock lock(&mu_);
+  if (generation != generation_.load() || entries_.contains(key)) {
+    return;
+  }
+  if (promote_after_hits_ > 1) {
+    if (disk_hits_.size() >= MaxTrackedDiskHits) {
+      disk_hits_.clear();
+    }
+    uint32_t& hits = disk_hits_[key];
+    if (++hits < promote_after_hits_) {
+      return;
+    }
+    disk_hits_.erase(key);
+  }
+  size_bytes_ += contents->size();
+  lru_.push_front(key);
+  entries_.emplace(key, Entry{std::move(contents), lru_.begin()});
+  while (size_bytes_ > max_size_bytes_) {
+    auto it = entries_.find(lru_.back());
+    ASSERT(it != entries_.end());
+    size_bytes_ -= it->second.contents_->size();
+    entries_.erase(it);
+    lru_.pop_back();
+  }
+}
+
+void MemoryTier::invalidate(const Key& key) {
+  absl::MutexLock lock(&mu_);
+  ++generation_;
+  disk_hits_.erase(key);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return;
+  }
+  size_bytes_ -= it->second.contents_->size();
+  lru_.erase(it->second.lru_position_);
+  entries_.erase(it);
+}
+
+uint64_t MemoryTier::sizeBytes() {
+  absl::MutexLock lock(&mu_);
+  return size_bytes_;
+}
+
+} // namespace FileSystemHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/cache/key.pb.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace FileSystemHttpCache {
+
+/**
+ * A bounded in-memory copy of small, frequently read cache files, so that hits on them need no
+ * file operations at all.
+ *
+ * Entries are promoted when a lookup has read a whole cache file from disk and the file has been
+ * hit often enough. All cache files stay on disk, so evicting an entry from memory only means its
+ * next hit is read from the file again. Entries are dropped whenever their cache file is written.
+ *
+ * See DESIGN.md for details of cache behavior.
+ **/
+class MemoryTier {
+public:
+  /**
+   * @param max_size_bytes the total size of cache files kept in memory.
+   * @param promote_after_hits how many hits read from disk promote a cache file to memory.
+   */
+  MemoryTier(uint64_t max_size_bytes, uint32_t promote_after_hits);
+
+  /**
+   * Returns the contents of the cache file for key, if it is held in memory.
+   * @param key the key of the cache entry.
+   * @return the whole cache file, or nullptr if it is not held in memory.
+   */
+  std::shared_ptr<const std::string> lookup(const Key& key) ABSL_LOCKS_EXCLUDED(mu_);
+
+  /**
+   * Records a hit that was read from disk, and keeps the file in memory if it has now been hit
+   * often enough.
+   * @param key the key of the cache entry.
+   * @param contents the whole cache file.
+   * @param generation the value of generation() when the file was opened. If any entry has been
+   *     invalidated since then, the contents may be out of date and the hit is ignored.
+   */
+  void onDiskHit(const Key& key, std::shared_ptr<const std::string> contents, uint64_t generation)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  /**
+   * Drops the entry for key, because its cache file is being written.
+   * @param key the key of the cache entry.
+   */
+  void invalidate(const Key& key) ABSL_LOCKS_EXCLUDED(mu_);
+
+  /**
+   * @return a value that changes whenever an entry is invalidated.
+   */
+  uint64_t generation() const { return generation_.load(); }
+
+  /**
+   * @return the total size of the cache files held in memory.
+   */
+  uint64_t sizeBytes() ABSL_LOCKS_EXCLUDED(mu_);
+
+private:
+  struct Entry {
+    std::shared_ptr<const std::string> contents_;
+    std::list<Key>::iterator lru_position_;
+  };
+
+  const uint64_t max_size_bytes_;
+  const uint32_t promote_after_hits_;
+  std::atomic<uint64_t> generation_{0};
+
+  absl::Mutex mu_;
+  absl::flat_hash_map<Key, Entry, MessageUtil, MessageUtil> entries_ ABSL_GUARDED_BY(mu_);
+  // The keys of entries_, most recently used first.
+  std::list<Key> lru_ ABSL_GUARDED_BY(mu_);
+  uint64_t size_bytes_ ABSL_GUARDED_BY(mu_) = 0;
+  // Disk hits of files not yet held in memory. Cleared when it grows large, so that only files
+  // which are hit often within a while get promoted.
+  absl::flat_hash_map<Key, uint32_t, MessageUtil, MessageUtil> disk_hits_ ABSL_GUARDED_BY(mu_);
+};
+
+} // namespace FileSystemHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
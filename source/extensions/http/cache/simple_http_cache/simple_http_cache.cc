@@ -1,11 +1,17 @@
 #include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "envoy/extensions/http/cache/simple_http_cache/v3/config.pb.h"
 #include "envoy/registry/registry.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/http/header_map_impl.h"
 
+#include "absl/hash/hash.h"
+#include "absl/strings/numbers.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -36,17 +42,65 @@ public:
   SimpleLookupContext(SimpleHttpCache& cache, LookupRequest&& request)
       : cache_(cache), request_(std::move(request)) {}
 
+  SimpleLookupContext(SimpleHttpCache& cache, LookupRequest&& request,
+                      Event::Dispatcher& dispatcher)
+      : cache_(cache), request_(std::move(request)), dispatcher_(&dispatcher),
+        // Only requests that may insert their response are worth waiting for.
+        coalesce_(request_.requestHeaders().getMethodValue() ==
+                      Http::Headers::get().MethodValues.Get &&
+                  !request_.requestCacheControl().no_store_) {}
+
+  ~SimpleLookupContext() override {
+    *alive_ = false;
+    if (fetching_) {
+      // The response was never handed to an insert context, so nobody will insert it.
+      cache_.finishFetch(request_.key());
+    }
+  }
+
   void getHeaders(LookupHeadersCallback&& cb) override {
-    auto entry = cache_.lookup(request_);
-    body_ = std::move(entry.body_);
-    trailers_ = std::move(entry.trailers_);
-    cb(entry.response_headers_ ? request_.makeLookupResult(std::move(entry.response_headers_),
-                                                           std::move(entry.metadata_), body_.size(),
-                                                           trailers_ != nullptr)
-                               : LookupResult{});
+    if (!coalesce_) {
+      deliverHeaders(cache_.lookup(request_), cb);
+      return;
+    }
+    // A lookup that has been woken up looks again without waiting a second time, so that it goes
+    // upstream itself if the response it waited for turned out not to be cacheable.
+    std::function<void()> wake;
+    if (std::exchange(may_wait_, false)) {
+      wake = [this, alive = alive_, &dispatcher = *dispatcher_]() {
+        dispatcher.post([this, alive]() {
+          if (*alive) {
+            getHeaders(std::move(waiting_cb_));
+          }
+        });
+      };
+    }
+    absl::optional<SimpleHttpCache::Entry> entry =
+        cache_.lookupOrWait(request_, std::move(wake), fetching_, in_progress_);
+    if (in_progress_) {
+      // Trailers are not known yet, so a streamed response is served without them.
+      cb(request_.makeLookupResult(in_progress_->copyHeaders(),
+                                   ResponseMetadata(in_progress_->metadata()),
+                                   in_progress_->contentLength(), false));
+      return;
+    }
+    if (!entry.has_value()) {
+      waiting_cb_ = std::move(cb);
+      return;
+    }
+    deliverHeaders(std::move(entry.value()), cb);
   }
 
   void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
+    if (in_progress_) {
+      in_progress_->readBody(range, [&dispatcher = *dispatcher_,
+                                     cb = std::move(cb)](Buffer::InstancePtr body) mutable {
+        dispatcher.post([cb = std::move(cb), body = std::move(body)]() mutable {
+          cb(std::move(body));
+        });
+      });
+      return;
+    }
     ASSERT(range.end() <= body_.length(), "Attempt to read past end of body.");
     cb(std::make_unique<Buffer::OwnedImpl>(&body_[range.begin()], range.length()));
   }
@@ -60,11 +114,32 @@ public:
   const LookupRequest& request() const { return request_; }
   void onDestroy() override {}
 
+  // Hands responsibility for finishing this lookup's fetch to the caller. Returns true if this
+  // lookup was fetching the response for a coalescing cache.
+  bool releaseFetch() { return std::exchange(fetching_, false); }
+
 private:
+  void deliverHeaders(SimpleHttpCache::Entry&& entry, LookupHeadersCallback& cb) {
+    body_ = std::move(entry.body_);
+    trailers_ = std::move(entry.trailers_);
+    cb(entry.response_headers_ ? request_.makeLookupResult(std::move(entry.response_headers_),
+                                                           std::move(entry.metadata_), body_.size(),
+                                                           trailers_ != nullptr)
+                               : LookupResult{});
+  }
+
   SimpleHttpCache& cache_;
   const LookupRequest request_;
   std::string body_;
   Http::ResponseTrailerMapPtr trailers_;
+  Event::Dispatcher* const dispatcher_{};
+  const bool coalesce_{};
+  bool may_wait_ = coalesce_;
+  bool fetching_{};
+  SimpleHttpCache::InProgressEntrySharedPtr in_progress_;
+  LookupHeadersCallback waiting_cb_;
+  // Lets wake-ups posted by other threads detect that this lookup has been destroyed.
+  const std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
 };
 
 class SimpleInsertContext : public InsertContext {
@@ -75,7 +150,18 @@ public:
             dynamic_cast<SimpleLookupContext&>(lookup_context).request().requestHeaders()),
         vary_allow_list_(
             dynamic_cast<SimpleLookupContext&>(lookup_context).request().varyAllowList()),
-        cache_(cache) {}
+        cache_(cache),
+        fetching_(dynamic_cast<SimpleLookupContext&>(lookup_context).releaseFetch()) {}
+
+  ~SimpleInsertContext() override {
+    if (fetching_) {
+      cache_.finishFetch(key_);
+    }
+    if (in_progress_ && !committed_) {
+      cache_.stopStreaming(key_);
+      in_progress_->finish();
+    }
+  }
 
   void insertHeaders(const Http::ResponseHeaderMap& response_headers,
                      const ResponseMetadata& metadata, InsertCallback insert_success,
@@ -85,9 +171,19 @@ public:
     metadata_ = metadata;
     if (end_stream) {
       insert_success(commit());
-    } else {
-      insert_success(true);
+      return;
+    }
+    uint64_t content_length;
+    // Lookups waiting for this response can stream it once they know how long its body is. Varied
+    // responses are only streamed once inserted, since they may not match the waiting requests.
+    if (fetching_ && !VaryHeaderUtils::hasVary(response_headers) &&
+        absl::SimpleAtoi(response_headers.getContentLengthValue(), &content_length)) {
+      in_progress_ = std::make_shared<SimpleHttpCache::InProgressEntry>(response_headers,
+                                                                        metadata, content_length);
+      fetching_ = false;
+      cache_.startStreaming(key_, in_progress_);
     }
+    insert_success(true);
   }
 
   void insertBody(const Buffer::Instance& chunk, InsertCallback ready_for_next_chunk,
@@ -96,6 +192,9 @@ public:
     ASSERT(ready_for_next_chunk || end_stream);
 
     body_.add(chunk);
+    if (in_progress_) {
+      in_progress_->appendBody(chunk);
+    }
     if (end_stream) {
       ready_for_next_chunk(commit());
     } else {
@@ -115,14 +214,24 @@ public:
 private:
   bool commit() {
     committed_ = true;
+    bool inserted;
     if (VaryHeaderUtils::hasVary(*response_headers_)) {
-      return cache_.varyInsert(key_, std::move(response_headers_), std::move(metadata_),
-                               body_.toString(), request_headers_, vary_allow_list_,
-                               std::move(trailers_));
+      inserted = cache_.varyInsert(key_, std::move(response_headers_), std::move(metadata_),
+                                   body_.toString(), request_headers_, vary_allow_list_,
+                                   std::move(trailers_));
     } else {
-      return cache_.insert(key_, std::move(response_headers_), std::move(metadata_),
-                           body_.toString(), std::move(trailers_));
+      inserted = cache_.insert(key_, std::move(response_headers_), std::move(metadata_),
+                               body_.toString(), std::move(trailers_));
+    }
+    if (fetching_) {
+      fetching_ = false;
+      cache_.finishFetch(key_);
+    }
+    if (in_progress_) {
+      cache_.stopStreaming(key_);
+      in_progress_->finish();
     }
+    return inserted;
   }
 
   Key key_;
@@ -134,101 +243,299 @@ private:
   Buffer::OwnedImpl body_;
   bool committed_ = false;
   Http::ResponseTrailerMapPtr trailers_;
+  // True if lookups for key_ are waiting for this response.
+  bool fetching_;
+  // Set while lookups can stream this response before it has been committed.
+  SimpleHttpCache::InProgressEntrySharedPtr in_progress_;
 };
 } // namespace
 
+SimpleHttpCache::SimpleHttpCache(uint64_t max_size_bytes)
+    : max_shard_size_bytes_(
+          max_size_bytes == 0 ? 0 : std::max<uint64_t>(max_size_bytes / NumShards, 1)) {}
+
 LookupContextPtr SimpleHttpCache::makeLookupContext(LookupRequest&& request,
                                                     Http::StreamDecoderFilterCallbacks&) {
   return std::make_unique<SimpleLookupContext>(*this, std::move(request));
 }
 
+LookupContextPtr
+SimpleHttpCache::makeCoalescingLookupContext(LookupRequest&& request,
+                                             Http::StreamDecoderFilterCallbacks& callbacks) {
+  return std::make_unique<SimpleLookupContext>(*this, std::move(request), callbacks.dispatcher());
+}
+
+SimpleHttpCache::Shard& SimpleHttpCache::shardFor(const Key& key) {
+  // Varied responses only differ from their resource's key in custom_fields, so they are left out.
+  return shards_[absl::HashOf(key.cluster_name(), key.host(), key.path(), key.query()) %
+                 NumShards];
+}
+
 void SimpleHttpCache::updateHeaders(const LookupContext& lookup_context,
                                     const Http::ResponseHeaderMap& response_headers,
                                     const ResponseMetadata& metadata,
                                     std::function<void(bool)> on_complete) {
   const auto& simple_lookup_context = static_cast<const SimpleLookupContext&>(lookup_context);
   const Key& key = simple_lookup_context.request().key();
-  absl::WriterMutexLock lock(&mutex_);
-  auto iter = map_.find(key);
-  if (iter == map_.end() || !iter->second.response_headers_) {
+  Shard& shard = shardFor(key);
+  absl::MutexLock lock(&shard.mutex_);
+  StoredEntry* stored = findLocked(shard, key);
+  if (stored == nullptr || !stored->entry_.response_headers_) {
     on_complete(false);
     return;
   }
-  if (VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
+  if (VaryHeaderUtils::hasVary(*stored->entry_.response_headers_)) {
     absl::optional<Key> varied_key =
-        variedRequestKey(simple_lookup_context.request(), *iter->second.response_headers_);
+        variedRequestKey(simple_lookup_context.request(), *stored->entry_.response_headers_);
     if (!varied_key.has_value()) {
       on_complete(false);
       return;
     }
-    iter = map_.find(varied_key.value());
-    if (iter == map_.end() || !iter->second.response_headers_) {
+    stored = findLocked(shard, varied_key.value());
+    if (stored == nullptr || !stored->entry_.response_headers_) {
       on_complete(false);
       return;
     }
   }
-  Entry& entry = iter->second;
+  Entry& entry = stored->entry_;
 
   applyHeaderUpdate(response_headers, *entry.response_headers_);
   entry.metadata_ = metadata;
+  const uint64_t size_bytes = entrySize(*stored->lru_position_, entry);
+  shard.size_bytes_ = shard.size_bytes_ - stored->size_bytes_ + size_bytes;
+  stored->size_bytes_ = size_bytes;
+  evictLocked(shard);
   on_complete(true);
 }
 
 SimpleHttpCache::Entry SimpleHttpCache::lookup(const LookupRequest& request) {
-  absl::ReaderMutexLock lock(&mutex_);
-  auto iter = map_.find(request.key());
-  if (iter == map_.end()) {
-    return Entry{};
+  Shard& shard = shardFor(request.key());
+  absl::MutexLock lock(&shard.mutex_);
+  return lookupLocked(shard, request);
+}
+
+absl::optional<SimpleHttpCache::Entry>
+SimpleHttpCache::lookupOrWait(const LookupRequest& request, std::function<void()> wake,
+                              bool& fetching, InProgressEntrySharedPtr& in_progress) {
+  fetching = false;
+  Shard& shard = shardFor(request.key());
+  absl::MutexLock lock(&shard.mutex_);
+  Entry entry = lookupLocked(shard, request);
+  if (entry.response_headers_) {
+    return entry;
   }
-  ASSERT(iter->second.response_headers_);
+  auto streaming = shard.in_progress_.find(request.key());
+  if (streaming != shard.in_progress_.end()) {
+    in_progress = streaming->second;
+    return entry;
+  }
+  if (!wake) {
+    return entry;
+  }
+  auto [iter, inserted] = shard.fetches_.try_emplace(request.key());
+  if (inserted) {
+    fetching = true;
+    return entry;
+  }
+  iter->second.push_back(std::move(wake));
+  return absl::nullopt;
+}
 
-  if (VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
-    return varyLookup(request, iter->second.response_headers_);
-  } else {
-    Http::ResponseTrailerMapPtr trailers_map;
-    if (iter->second.trailers_) {
-      trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*iter->second.trailers_);
+void SimpleHttpCache::finishFetch(const Key& key) {
+  std::vector<std::function<void()>> waiters;
+  {
+    Shard& shard = shardFor(key);
+    absl::MutexLock lock(&shard.mutex_);
+    auto iter = shard.fetches_.find(key);
+    if (iter == shard.fetches_.end()) {
+      return;
     }
-    return SimpleHttpCache::Entry{
-        Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*iter->second.response_headers_),
-        iter->second.metadata_, iter->second.body_, std::move(trailers_map)};
+    waiters = std::move(iter->second);
+    shard.fetches_.erase(iter);
+  }
+  for (auto& wake : waiters) {
+    wake();
   }
 }
 
-bool SimpleHttpCache::insert(const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
-                             ResponseMetadata&& metadata, std::string&& body,
-                             Http::ResponseTrailerMapPtr&& trailers) {
-  absl::WriterMutexLock lock(&mutex_);
-  map_[key] = SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
-                                     std::move(body), std::move(trailers)};
-  return true;
+void SimpleHttpCache::startStreaming(const Key& key, InProgressEntrySharedPtr entry) {
+  {
+    Shard& shard = shardFor(key);
+    absl::MutexLock lock(&shard.mutex_);
+    shard.in_progress_[key] = std::move(entry);
+  }
+  finishFetch(key);
+}
+
+void SimpleHttpCache::stopStreaming(const Key& key) {
+  Shard& shard = shardFor(key);
+  absl::MutexLock lock(&shard.mutex_);
+  shard.in_progress_.erase(key);
+}
+
+SimpleHttpCache::InProgressEntry::InProgressEntry(const Http::ResponseHeaderMap& response_headers,
+                                                  const ResponseMetadata& metadata,
+                                                  uint64_t content_length)
+    : response_headers_(Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers)),
+      metadata_(metadata), content_length_(content_length) {}
+
+Http::ResponseHeaderMapPtr SimpleHttpCache::InProgressEntry::copyHeaders() const {
+  return Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*response_headers_);
+}
+
+void SimpleHttpCache::InProgressEntry::appendBody(const Buffer::Instance& chunk) {
+  std::vector<std::pair<std::function<void(Buffer::InstancePtr)>, Buffer::InstancePtr>> ready;
+  {
+    absl::MutexLock lock(&mutex_);
+    body_.append(chunk.toString());
+    for (auto it = pending_reads_.begin(); it != pending_reads_.end();) {
+      if (it->range_.begin() >= body_.size()) {
+        ++it;
+        continue;
+      }
+      ready.emplace_back(std::move(it->cb_), readLocked(it->range_));
+      it = pending_reads_.erase(it);
+    }
+  }
+  for (auto& [cb, body] : ready) {
+    cb(std::move(body));
+  }
 }
 
-SimpleHttpCache::Entry
-SimpleHttpCache::varyLookup(const LookupRequest& request,
-                            const Http::ResponseHeaderMapPtr& response_headers) {
-  // This method should be called from lookup, which holds the mutex for reading.
-  mutex_.AssertReaderHeld();
+Buffer::InstancePtr SimpleHttpCache::InProgressEntry::readLocked(const AdjustedByteRange& range) {
+  const uint64_t end = std::min<uint64_t>(range.end(), body_.size());
+  return std::make_unique<Buffer::OwnedImpl>(&body_[range.begin()], end - range.begin());
+}
 
-  absl::optional<Key> varied_key = variedRequestKey(request, *response_headers);
-  if (!varied_key.has_value()) {
-    return SimpleHttpCache::Entry{};
+void SimpleHttpCache::InProgressEntry::finish() {
+  std::vector<PendingRead> failed;
+  {
+    absl::MutexLock lock(&mutex_);
+    finished_ = true;
+    failed = std::move(pending_reads_);
+    pending_reads_.clear();
+  }
+  for (auto& read : failed) {
+    read.cb_(nullptr);
   }
-  Key& varied_request_key = varied_key.value();
+}
 
-  auto iter = map_.find(varied_request_key);
-  if (iter == map_.end()) {
-    return SimpleHttpCache::Entry{};
+void SimpleHttpCache::InProgressEntry::readBody(const AdjustedByteRange& range,
+                                                std::function<void(Buffer::InstancePtr)> cb) {
+  Buffer::InstancePtr body;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (range.begin() < body_.size()) {
+      body = readLocked(range);
+    } else if (!finished_) {
+      pending_reads_.push_back(PendingRead{range, std::move(cb)});
+      return;
+    }
   }
-  ASSERT(iter->second.response_headers_);
-  Http::ResponseTrailerMapPtr trailers_map;
-  if (iter->second.trailers_) {
-    trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*iter->second.trailers_);
+  cb(std::move(body));
+}
+
+SimpleHttpCache::Entry SimpleHttpCache::lookupLocked(Shard& shard, const LookupRequest& request) {
+  const StoredEntry* stored = findLocked(shard, request.key());
+  if (stored == nullptr) {
+    return Entry{};
+  }
+  ASSERT(stored->entry_.response_headers_);
+
+  if (VaryHeaderUtils::hasVary(*stored->entry_.response_headers_)) {
+    // Look for the response matching the request's varied headers.
+    absl::optional<Key> varied_key = variedRequestKey(request, *stored->entry_.response_headers_);
+    if (!varied_key.has_value()) {
+      return Entry{};
+    }
+    stored = findLocked(shard, varied_key.value());
+    if (stored == nullptr) {
+      return Entry{};
+    }
+    ASSERT(stored->entry_.response_headers_);
   }
 
+  Http::ResponseTrailerMapPtr trailers_map;
+  if (stored->entry_.trailers_) {
+    trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*stored->entry_.trailers_);
+  }
   return SimpleHttpCache::Entry{
-      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*iter->second.response_headers_),
-      iter->second.metadata_, iter->second.body_, std::move(trailers_map)};
+      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*stored->entry_.response_headers_),
+      stored->entry_.metadata_, stored->entry_.body_, std::move(trailers_map)};
+}
+
+SimpleHttpCache::StoredEntry* SimpleHttpCache::findLocked(Shard& shard, const Key& key) {
+  auto iter = shard.map_.find(key);
+  if (iter == shard.map_.end()) {
+    return nullptr;
+  }
+  shard.lru_.splice(shard.lru_.begin(), shard.lru_, iter->second.lru_position_);
+  return &iter->second;
+}
+
+bool SimpleHttpCache::storeLocked(Shard& shard, const Key& key, Entry&& entry) {
+  const uint64_t size_bytes = entrySize(key, entry);
+  if (max_shard_size_bytes_ > 0 && size_bytes > max_shard_size_bytes_) {
+    return false;
+  }
+  auto [iter, inserted] = shard.map_.try_emplace(key);
+  StoredEntry& stored = iter->second;
+  if (inserted) {
+    shard.lru_.push_front(key);
+  } else {
+    shard.lru_.splice(shard.lru_.begin(), shard.lru_, stored.lru_position_);
+    shard.size_bytes_ -= stored.size_bytes_;
+  }
+  stored.lru_position_ = shard.lru_.begin();
+  stored.entry_ = std::move(entry);
+  stored.size_bytes_ = size_bytes;
+  shard.size_bytes_ += size_bytes;
+  evictLocked(shard);
+  return true;
+}
+
+void SimpleHttpCache::evictLocked(Shard& shard) {
+  if (max_shard_size_bytes_ == 0) {
+    return;
+  }
+  while (shard.size_bytes_ > max_shard_size_bytes_ && !shard.lru_.empty()) {
+    auto iter = shard.map_.find(shard.lru_.back());
+    ASSERT(iter != shard.map_.end());
+    shard.size_bytes_ -= iter->second.size_bytes_;
+    shard.map_.erase(iter);
+    shard.lru_.pop_back();
+  }
+}
+
+uint64_t SimpleHttpCache::entrySize(const Key& key, const Entry& entry) {
+  // The key is stored twice, in the map and in the LRU list.
+  uint64_t size_bytes = 2 * key.ByteSizeLong() + entry.body_.size();
+  if (entry.response_headers_) {
+    size_bytes += entry.response_headers_->byteSize();
+  }
+  if (entry.trailers_) {
+    size_bytes += entry.trailers_->byteSize();
+  }
+  return size_bytes;
+}
+
+uint64_t SimpleHttpCache::sizeBytes() {
+  uint64_t size_bytes = 0;
+  for (Shard& shard : shards_) {
+    absl::MutexLock lock(&shard.mutex_);
+    size_bytes += shard.size_bytes_;
+  }
+  return size_bytes;
+}
+
+bool SimpleHttpCache::insert(const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
+                             ResponseMetadata&& metadata, std::string&& body,
+                             Http::ResponseTrailerMapPtr&& trailers) {
+  Shard& shard = shardFor(key);
+  absl::MutexLock lock(&shard.mutex_);
+  return storeLocked(shard, key,
+                     SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
+                                            std::move(body), std::move(trailers)});
 }
 
 bool SimpleHttpCache::varyInsert(const Key& request_key,
@@ -237,8 +544,6 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
                                  const Http::RequestHeaderMap& request_headers,
                                  const VaryAllowList& vary_allow_list,
                                  Http::ResponseTrailerMapPtr&& trailers) {
-  absl::WriterMutexLock lock(&mutex_);
-
   absl::btree_set<absl::string_view> vary_header_values =
       VaryHeaderUtils::getVaryValues(*response_headers);
   ASSERT(!vary_header_values.empty());
@@ -253,23 +558,30 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
   }
 
   varied_request_key.add_custom_fields(vary_identifier.value());
-  map_[varied_request_key] = SimpleHttpCache::Entry{
-      std::move(response_headers), std::move(metadata), std::move(body), std::move(trailers)};
+  // Build the special entry flagging that this request generates varied responses before the
+  // response headers are moved into the cache.
+  Envoy::Http::ResponseHeaderMapPtr vary_only_map =
+      Envoy::Http::createHeaderMap<Envoy::Http::ResponseHeaderMapImpl>({});
+  vary_only_map->setCopy(Envoy::Http::CustomHeaders::get().Vary,
+                         absl::StrJoin(vary_header_values, ","));
+
+  Shard& shard = shardFor(request_key);
+  absl::MutexLock lock(&shard.mutex_);
+  if (!storeLocked(shard, varied_request_key,
+                   SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
+                                          std::move(body), std::move(trailers)})) {
+    return false;
+  }
 
   // Add a special entry to flag that this request generates varied responses.
-  auto iter = map_.find(request_key);
-  if (iter == map_.end()) {
-    Envoy::Http::ResponseHeaderMapPtr vary_only_map =
-        Envoy::Http::createHeaderMap<Envoy::Http::ResponseHeaderMapImpl>({});
-    vary_only_map->setCopy(Envoy::Http::CustomHeaders::get().Vary,
-                           absl::StrJoin(vary_header_values, ","));
-    // TODO(cbdm): In a cache that evicts entries, we could maintain a list of the "varykey"s that
-    // we have inserted as the body for this first lookup. This way, we would know which keys we
-    // have inserted for that resource. For the first entry simply use vary_identifier as the
+  if (findLocked(shard, request_key) == nullptr) {
+    // TODO(cbdm): We could maintain a list of the "varykey"s that we have inserted as the body for
+    // this first lookup. This way, we would know which keys we have inserted for that resource, and
+    // could evict them together. For the first entry simply use vary_identifier as the
     // entry_list; for future entries append vary_identifier to existing list.
     std::string entry_list;
-    map_[request_key] =
-        SimpleHttpCache::Entry{std::move(vary_only_map), {}, std::move(entry_list), {}};
+    storeLocked(shard, request_key,
+                SimpleHttpCache::Entry{std::move(vary_only_map), {}, std::move(entry_list), {}});
   }
   return true;
 }
@@ -290,6 +602,55 @@ CacheInfo SimpleHttpCache::cacheInfo() const {
 
 SINGLETON_MANAGER_REGISTRATION(simple_http_cache_singleton);
 
+namespace {
+
+// The shared SimpleHttpCache as seen by filters that coalesce concurrent misses.
+class CoalescingSimpleHttpCache : public HttpCache {
+public:
+  explicit CoalescingSimpleHttpCache(std::shared_ptr<SimpleHttpCache> cache)
+      : cache_(std::move(cache)) {}
+
+  // HttpCache
+  LookupContextPtr makeLookupContext(LookupRequest&& request,
+                                     Http::StreamDecoderFilterCallbacks& callbacks) override {
+    return cache_->makeCoalescingLookupContext(std::move(request), callbacks);
+  }
+  InsertContextPtr makeInsertContext(LookupContextPtr&& lookup_context,
+                                     Http::StreamEncoderFilterCallbacks& callbacks) override {
+    return cache_->makeInsertContext(std::move(lookup_context), callbacks);
+  }
+  void updateHeaders(const LookupContext& lookup_context,
+                     const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata,
+                     std::function<void(bool)> on_complete) override {
+    cache_->updateHeaders(lookup_context, response_headers, metadata, std::move(on_complete));
+  }
+  CacheInfo cacheInfo() const override { return cache_->cacheInfo(); }
+
+private:
+  const std::shared_ptr<SimpleHttpCache> cache_;
+};
+
+// Filters configured with the same size limit share one cache.
+class SimpleHttpCacheSingleton : public Singleton::Instance {
+public:
+  std::shared_ptr<SimpleHttpCache> get(uint64_t max_size_bytes) {
+    absl::MutexLock lock(&mutex_);
+    std::shared_ptr<SimpleHttpCache> cache = caches_[max_size_bytes].lock();
+    if (cache == nullptr) {
+      cache = std::make_shared<SimpleHttpCache>(max_size_bytes);
+      caches_[max_size_bytes] = cache;
+    }
+    return cache;
+  }
+
+private:
+  absl::Mutex mutex_;
+  absl::flat_hash_map<uint64_t, std::weak_ptr<SimpleHttpCache>> caches_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace
+
 class SimpleHttpCacheFactory : public HttpCacheFactory {
 public:
   // From UntypedFactory
@@ -301,15 +662,26 @@ public:
   }
   // From HttpCacheFactory
   std::shared_ptr<HttpCache>
-  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig&,
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
            Server::Configuration::FactoryContext& context) override {
-    return context.serverFactoryContext().singletonManager().getTyped<SimpleHttpCache>(
-        SINGLETON_MANAGER_REGISTERED_NAME(simple_http_cache_singleton), &createCache);
+    envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig config;
+    MessageUtil::unpackTo(filter_config.typed_config(), config);
+    std::shared_ptr<SimpleHttpCache> cache =
+        context.serverFactoryContext()
+            .singletonManager()
+            .getTyped<SimpleHttpCacheSingleton>(
+                SINGLETON_MANAGER_REGISTERED_NAME(simple_http_cache_singleton), &createSingleton,
+                /* pin = */ true)
+            ->get(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_cache_size_bytes, 0));
+    if (config.coalesce_concurrent_misses()) {
+      return std::make_shared<CoalescingSimpleHttpCache>(std::move(cache));
+    }
+    return cache;
   }
 
 private:
-  static std::shared_ptr<Singleton::Instance> createCache() {
-    return std::make_shared<SimpleHttpCache>();
+  static std::shared_ptr<Singleton::Instance> createSingleton() {
+    return std::make_shared<SimpleHttpCacheSingleton>();
   }
 };
 
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <array>
+#include <functional>
+#include <list>
+#include <memory>
+#include <vector>
+
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
 
@@ -12,9 +18,11 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Cache {
 
-// Example cache backend that never evicts. Not suitable for production use.
-class SimpleHttpCache : public HttpCache, public Singleton::Instance {
-private:
+// In-memory cache backend. Entries are spread over independently locked shards, and if a size
+// limit is given, each shard evicts its least recently used entries to stay within its share of
+// the limit.
+class SimpleHttpCache : public HttpCache {
+public:
   struct Entry {
     Http::ResponseHeaderMapPtr response_headers_;
     ResponseMetadata metadata_;
@@ -22,17 +30,51 @@ private:
     Http::ResponseTrailerMapPtr trailers_;
   };
 
-  // Looks for a response that has been varied. Only called from lookup.
-  Entry varyLookup(const LookupRequest& request,
-                   const Http::ResponseHeaderMapPtr& response_headers);
+  // A response that is still being inserted. Lookups for its key stream the body from here as it
+  // arrives, instead of waiting for the whole response or going upstream themselves.
+  class InProgressEntry {
+  public:
+    InProgressEntry(const Http::ResponseHeaderMap& response_headers,
+                    const ResponseMetadata& metadata, uint64_t content_length);
 
-  // A list of headers that we do not want to update upon validation
-  // We skip these headers because either it's updated by other application logic
-  // or they are fall into categories defined in the IETF doc below
-  // https://www.ietf.org/archive/id/draft-ietf-httpbis-cache-18.html s3.2
-  static const absl::flat_hash_set<Http::LowerCaseString> headersNotToUpdate();
+    Http::ResponseHeaderMapPtr copyHeaders() const;
+    const ResponseMetadata& metadata() const { return metadata_; }
+    uint64_t contentLength() const { return content_length_; }
+
+    void appendBody(const Buffer::Instance& chunk) ABSL_LOCKS_EXCLUDED(mutex_);
+
+    // Called when the insert has committed or been abandoned. Reads that the body received so far
+    // cannot satisfy are failed.
+    void finish() ABSL_LOCKS_EXCLUDED(mutex_);
+
+    // Calls cb with the start of the range once some of it has arrived, or with nullptr if the
+    // insert ends without it. cb may be called from any thread.
+    void readBody(const AdjustedByteRange& range, std::function<void(Buffer::InstancePtr)> cb)
+        ABSL_LOCKS_EXCLUDED(mutex_);
+
+  private:
+    struct PendingRead {
+      AdjustedByteRange range_;
+      std::function<void(Buffer::InstancePtr)> cb_;
+    };
+
+    // Returns as much of range as has arrived.
+    Buffer::InstancePtr readLocked(const AdjustedByteRange& range)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+    const Http::ResponseHeaderMapPtr response_headers_;
+    const ResponseMetadata metadata_;
+    const uint64_t content_length_;
+    absl::Mutex mutex_;
+    std::string body_ ABSL_GUARDED_BY(mutex_);
+    bool finished_ ABSL_GUARDED_BY(mutex_){};
+    std::vector<PendingRead> pending_reads_ ABSL_GUARDED_BY(mutex_);
+  };
+  using InProgressEntrySharedPtr = std::shared_ptr<InProgressEntry>;
+
+  // max_size_bytes of 0 means that the cache never evicts.
+  explicit SimpleHttpCache(uint64_t max_size_bytes = 0);
 
-public:
   // HttpCache
   LookupContextPtr makeLookupContext(LookupRequest&& request,
                                      Http::StreamDecoderFilterCallbacks& callbacks) override;
@@ -44,7 +86,33 @@ public:
                      std::function<void(bool)> on_complete) override;
   CacheInfo cacheInfo() const override;
 
+  // Like makeLookupContext, but a lookup that misses while another lookup for the same key is
+  // already fetching the response from upstream waits for that fetch instead of also going
+  // upstream. Once the fetched response's headers are being inserted, waiting and later lookups
+  // stream its body while it is still arriving.
+  LookupContextPtr makeCoalescingLookupContext(LookupRequest&& request,
+                                               Http::StreamDecoderFilterCallbacks& callbacks);
+
   Entry lookup(const LookupRequest& request);
+
+  // Like lookup, but sets in_progress if the response is still being inserted. Otherwise, on a
+  // miss, either marks the key as being fetched by the caller, setting fetching to true, or, if it
+  // is already being fetched, queues wake to be called once that fetch finishes or starts
+  // streaming and returns nullopt. wake may be called from any thread. If wake is empty, a miss
+  // neither waits nor registers a fetch.
+  absl::optional<Entry> lookupOrWait(const LookupRequest& request, std::function<void()> wake,
+                                     bool& fetching, InProgressEntrySharedPtr& in_progress);
+
+  // Called when the fetch registered by lookupOrWait has been inserted or abandoned. Wakes all
+  // lookups waiting for it.
+  void finishFetch(const Key& key);
+
+  // Makes entry visible to lookups for key until stopStreaming is called, finishing the fetch
+  // registered for key.
+  void startStreaming(const Key& key, InProgressEntrySharedPtr entry);
+  void stopStreaming(const Key& key);
+
+  // Returns false if the response was not stored because it is larger than a shard's size limit.
   bool insert(const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
               ResponseMetadata&& metadata, std::string&& body,
               Http::ResponseTrailerMapPtr&& trailers);
@@ -55,8 +123,54 @@ public:
                   const Http::RequestHeaderMap& request_headers,
                   const VaryAllowList& vary_allow_list, Http::ResponseTrailerMapPtr&& trailers);
 
-  absl::Mutex mutex_;
-  absl::flat_hash_map<Key, Entry, MessageUtil, MessageUtil> map_ ABSL_GUARDED_BY(mutex_);
+  // The approximate memory used by all stored entries.
+  uint64_t sizeBytes();
+
+  static constexpr size_t NumShards = 16;
+
+private:
+  struct StoredEntry {
+    Entry entry_;
+    uint64_t size_bytes_{};
+    std::list<Key>::iterator lru_position_;
+  };
+
+  struct Shard {
+    absl::Mutex mutex_;
+    absl::flat_hash_map<Key, StoredEntry, MessageUtil, MessageUtil> map_ ABSL_GUARDED_BY(mutex_);
+    // The keys of map_, most recently used first.
+    std::list<Key> lru_ ABSL_GUARDED_BY(mutex_);
+    uint64_t size_bytes_ ABSL_GUARDED_BY(mutex_){};
+    // Keys currently being fetched from upstream by a coalescing lookup, with the lookups waiting
+    // for them.
+    absl::flat_hash_map<Key, std::vector<std::function<void()>>, MessageUtil, MessageUtil>
+        fetches_ ABSL_GUARDED_BY(mutex_);
+    // Responses which are being inserted and can already be streamed.
+    absl::flat_hash_map<Key, InProgressEntrySharedPtr, MessageUtil, MessageUtil>
+        in_progress_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  // All the entries for a resource, including its varied responses, live in the same shard.
+  Shard& shardFor(const Key& key);
+
+  // Looks for a response for the request, marking what it finds as recently used.
+  Entry lookupLocked(Shard& shard, const LookupRequest& request)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  // Finds the entry for key, marking it as recently used. Returns nullptr if there is none.
+  StoredEntry* findLocked(Shard& shard, const Key& key) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  // Stores entry under key, evicting least recently used entries if the shard grows past its limit.
+  bool storeLocked(Shard& shard, const Key& key, Entry&& entry)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  void evictLocked(Shard& shard) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  static uint64_t entrySize(const Key& key, const Entry& entry);
+
+  // 0 if the cache never evicts.
+  const uint64_t max_shard_size_bytes_;
+  std::array<Shard, NumShards> shards_;
 };
 
 } // namespace Cache
@@ -99,10 +99,11 @@ HeaderValidator::validateMethodHeader(const HeaderString& value) {
   if (config_.restrict_http_methods()) {
     is_valid = kHttpMethodRegistry.contains(method);
   } else {
-    is_valid = !method.empty();
-    for (auto iter = method.begin(); iter != method.end() && is_valid; ++iter) {
-      is_valid &= testCharInTable(kMethodHeaderCharTable, *iter);
-    }
+    static constexpr ::Envoy::Http::VectorizedCharTable kVectorizedMethodHeaderCharTable{
+        kMethodHeaderCharTable};
+    is_valid = !method.empty() &&
+               ::Envoy::Http::findFirstCharNotInTable(kVectorizedMethodHeaderCharTable, method) ==
+                   absl::string_view::npos;
   }
 
   if (!is_valid) {
@@ -193,6 +194,14 @@ HeaderValidator::validateGenericHeaderName(const HeaderString& name) {
 
   const bool reject_header_names_with_underscores =
       config_.headers_with_underscores_action() == HeaderValidatorConfig::REJECT_REQUEST;
+  // Names with only valid characters are accepted after a single vectorized pass. Otherwise the
+  // scalar pass below finds the reason for the rejection.
+  if (::Envoy::Http::findFirstCharNotInTable(::Envoy::Http::kVectorizedGenericHeaderNameCharTable,
+                                             key_string_view) == absl::string_view::npos &&
+      (!reject_header_names_with_underscores || !absl::StrContains(key_string_view, '_'))) {
+    return HeaderEntryValidationResult::success();
+  }
+
   bool is_valid = true;
   bool reject_due_to_underscore = false;
   char c = '\0';
@@ -236,14 +245,12 @@ HeaderValidator::validateGenericHeaderValue(const HeaderString& value) {
   //
   // VCHAR          =  %x21-7E
   //                   ; visible (printing) characters
+  static constexpr ::Envoy::Http::VectorizedCharTable kVectorizedGenericHeaderValueCharTable{
+      kGenericHeaderValueCharTable};
   const auto& value_string_view = value.getStringView();
-  bool is_valid = true;
 
-  for (auto iter = value_string_view.begin(); iter != value_string_view.end() && is_valid; ++iter) {
-    is_valid &= testCharInTable(kGenericHeaderValueCharTable, *iter);
-  }
-
-  if (!is_valid) {
+  if (::Envoy::Http::findFirstCharNotInTable(kVectorizedGenericHeaderValueCharTable,
+                                             value_string_view) != absl::string_view::npos) {
     return {HeaderValueValidationResult::Action::Reject,
             UhvResponseCodeDetail::get().InvalidValueCharacters};
   }
@@ -390,63 +397,54 @@ HeaderValidator::validateHostHeaderRegName(absl::string_view host) {
 
 HeaderValidator::HeaderValueValidationResult
 HeaderValidator::validatePathHeaderCharacters(const HeaderString& value) {
-  return validatePathHeaderCharacterSet(value, kPathHeaderCharTable,
-                                        ::Envoy::Http::kUriQueryAndFragmentCharTable);
+  static constexpr PathCharacterTables kPathCharacterTables{
+      kPathHeaderCharTable, ::Envoy::Http::kUriQueryAndFragmentCharTable};
+  return validatePathHeaderCharacterSet(value, kPathCharacterTables);
 }
 
-HeaderValidator::HeaderValueValidationResult HeaderValidator::validatePathHeaderCharacterSet(
-    const HeaderString& value, const std::array<uint32_t, 8>& allowed_path_chracters,
-    const std::array<uint32_t, 8>& allowed_query_fragment_characters) {
+HeaderValidator::HeaderValueValidationResult
+HeaderValidator::validatePathHeaderCharacterSet(const HeaderString& value,
+                                                const PathCharacterTables& allowed_characters) {
   static const HeaderValueValidationResult bad_path_result{
       HeaderValueValidationResult::Action::Reject, UhvResponseCodeDetail::get().InvalidUrl};
-  const auto& path = value.getStringView();
+  absl::string_view path = value.getStringView();
   if (path.empty()) {
     return bad_path_result;
   }
 
-  auto iter = path.begin();
-  auto end = path.end();
+  // Validate the path component of the URI. The path table does not contain the '?' and '#'
+  // characters, so the first character not in it is either invalid or the start of the query or
+  // fragment portion of the path which uses a different character table.
+  size_t end = ::Envoy::Http::findFirstCharNotInTable(allowed_characters.path_, path);
+  if (end == absl::string_view::npos) {
+    return HeaderValueValidationResult::success();
+  }
+  if (path[end] != '?' && path[end] != '#') {
+    return bad_path_result;
+  }
 
-  // Validate the path component of the URI
-  for (; iter != end; ++iter) {
-    if (*iter == '?' || *iter == '#') {
-      // This is the start of the query or fragment portion of the path which uses a different
-      // character table.
-      break;
+  if (path[end] == '?') {
+    // Validate the query component of the URI
+    path.remove_prefix(end + 1);
+    end = ::Envoy::Http::findFirstCharNotInTable(allowed_characters.query_, path);
+    if (end == absl::string_view::npos) {
+      return HeaderValueValidationResult::success();
     }
-
-    if (!testCharInTable(allowed_path_chracters, *iter)) {
+    if (path[end] != '#') {
       return bad_path_result;
     }
   }
 
-  if (iter != end && *iter == '?') {
-    // Validate the query component of the URI
-    ++iter;
-    for (; iter != end; ++iter) {
-      if (*iter == '#') {
-        break;
-      }
-
-      if (!testCharInTable(allowed_query_fragment_characters, *iter)) {
-        return bad_path_result;
-      }
-    }
+  ASSERT(path[end] == '#');
+  if (!config_.strip_fragment_from_path()) {
+    return {HeaderValueValidationResult::Action::Reject,
+            UhvResponseCodeDetail::get().FragmentInUrlPath};
   }
-
-  if (iter != end) {
-    ASSERT(*iter == '#');
-    if (!config_.strip_fragment_from_path()) {
-      return {HeaderValueValidationResult::Action::Reject,
-              UhvResponseCodeDetail::get().FragmentInUrlPath};
-    }
-    // Validate the fragment component of the URI
-    ++iter;
-    for (; iter != end; ++iter) {
-      if (!testCharInTable(allowed_query_fragment_characters, *iter)) {
-        return bad_path_result;
-      }
-    }
+  // Validate the fragment component of the URI
+  path.remove_prefix(end + 1);
+  if (::Envoy::Http::findFirstCharNotInTable(allowed_characters.fragment_, path) !=
+      absl::string_view::npos) {
+    return bad_path_result;
   }
 
   return HeaderValueValidationResult::success();
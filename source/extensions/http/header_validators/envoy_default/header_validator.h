@@ -5,6 +5,7 @@
 #include "envoy/extensions/http/header_validators/envoy_default/v3/header_validator.pb.h"
 #include "envoy/http/header_validator.h"
 
+#include "source/common/http/character_set_validation.h"
 #include "source/common/http/headers.h"
 #include "source/extensions/http/header_validators/envoy_default/config_overrides.h"
 #include "source/extensions/http/header_validators/envoy_default/path_normalizer.h"
@@ -165,13 +166,28 @@ protected:
    */
   void sanitizeHeadersWithUnderscores(::Envoy::Http::HeaderMap& header_map);
 
+  /*
+   * The character sets allowed in the components of the :path pseudo header, in the vectorized
+   * form. The '?' and '#' delimiters are removed from the tables of the components they end.
+   */
+  struct PathCharacterTables {
+    constexpr PathCharacterTables(const std::array<uint32_t, 8>& allowed_path_characters,
+                                  const std::array<uint32_t, 8>& allowed_query_fragment_characters)
+        : path_(::Envoy::Http::removeCharsFromTable(allowed_path_characters, "?#")),
+          query_(::Envoy::Http::removeCharsFromTable(allowed_query_fragment_characters, "#")),
+          fragment_(allowed_query_fragment_characters) {}
+
+    const ::Envoy::Http::VectorizedCharTable path_;
+    const ::Envoy::Http::VectorizedCharTable query_;
+    const ::Envoy::Http::VectorizedCharTable fragment_;
+  };
+
   /*
    * Validate the :path pseudo header using specific allowed character set.
    */
   HeaderValueValidationResult
   validatePathHeaderCharacterSet(const ::Envoy::Http::HeaderString& value,
-                                 const std::array<uint32_t, 8>& allowed_path_chracters,
-                                 const std::array<uint32_t, 8>& allowed_query_fragment_characters);
+                                 const PathCharacterTables& allowed_characters);
 
   // URL-encode additional characters in URL path. This method is called iff
   // `envoy.uhv.allow_non_compliant_characters_in_path` is true.
@@ -97,9 +97,10 @@ Http1HeaderValidator::validatePathHeaderWithAdditionalCharacters(
       0b00000000000000000000000000000000,
       0b00000000000000000000000000000000,
   };
-  return HeaderValidator::validatePathHeaderCharacterSet(
-      path_header_value, kPathHeaderCharTableWithAdditionalCharacters,
-      kQueryAndFragmentCharTableWithAdditionalCharacters);
+  static constexpr PathCharacterTables kPathCharacterTables{
+      kPathHeaderCharTableWithAdditionalCharacters,
+      kQueryAndFragmentCharTableWithAdditionalCharacters};
+  return HeaderValidator::validatePathHeaderCharacterSet(path_header_value, kPathCharacterTables);
 }
 
 HeaderValidator::HeaderEntryValidationResult
@@ -152,9 +152,10 @@ Http2HeaderValidator::validatePathHeaderWithAdditionalCharactersHttp2(
       0b11111111111111111111111111111111,
       0b11111111111111111111111111111111,
   };
-  return HeaderValidator::validatePathHeaderCharacterSet(
-      path_header_value, kPathHeaderCharTableWithAdditionalCharacters,
-      kQueryAndFragmentCharTableWithAdditionalCharacters);
+  static constexpr PathCharacterTables kPathCharacterTables{
+      kPathHeaderCharTableWithAdditionalCharacters,
+      kQueryAndFragmentCharTableWithAdditionalCharacters};
+  return HeaderValidator::validatePathHeaderCharacterSet(path_header_value, kPathCharacterTables);
 }
 
 HeaderValidator::HeaderValueValidationResult
@@ -200,9 +201,10 @@ Http2HeaderValidator::validatePathHeaderWithAdditionalCharactersHttp3(
       0b00000000000000000000000000000000,
       0b00000000000000000000000000000000,
   };
-  return HeaderValidator::validatePathHeaderCharacterSet(
-      path_header_value, kPathHeaderCharTableWithAdditionalCharacters,
-      kQueryAndFragmentCharTableWithAdditionalCharacters);
+  static constexpr PathCharacterTables kPathCharacterTables{
+      kPathHeaderCharTableWithAdditionalCharacters,
+      kQueryAndFragmentCharTableWithAdditionalCharacters};
+  return HeaderValidator::validatePathHeaderCharacterSet(path_header_value, kPathCharacterTables);
 }
 
 ValidationResult
@@ -473,6 +475,18 @@ Http2HeaderValidator::validateGenericHeaderName(const HeaderString& name) {
 
   const bool reject_header_names_with_underscores =
       config_.headers_with_underscores_action() == HeaderValidatorConfig::REJECT_REQUEST;
+
+  // Names with only valid characters are accepted after a single vectorized pass. Otherwise the
+  // scalar pass below finds the reason for the rejection.
+  static constexpr ::Envoy::Http::VectorizedCharTable kVectorizedLowercaseHeaderNameCharTable{
+      ::Envoy::Http::removeCharsFromTable(::Envoy::Http::kGenericHeaderNameCharTable,
+                                          "ABCDEFGHIJKLMNOPQRSTUVWXYZ")};
+  if (::Envoy::Http::findFirstCharNotInTable(kVectorizedLowercaseHeaderNameCharTable,
+                                             key_string_view) == absl::string_view::npos &&
+      (!reject_header_names_with_underscores || !absl::StrContains(key_string_view, '_'))) {
+    return HeaderEntryValidationResult::success();
+  }
+
   bool is_valid = true;
   char c = '\0';
   bool reject_due_to_underscore = false;
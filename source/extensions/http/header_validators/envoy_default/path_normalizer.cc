@@ -24,6 +24,32 @@ using ::Envoy::Http::RequestHeaderMap;
 using ::Envoy::Http::testCharInTable;
 using ::Envoy::Http::UhvResponseCodeDetail;
 
+namespace {
+
+// Returns true if none of the normalization passes would change the path, i.e. it has no
+// percent-encoded octets, back slashes, duplicate slashes or segments starting with a dot.
+bool isNormalizedPath(absl::string_view path) {
+  // All characters except the ones which start a percent-encoded octet or may become a slash.
+  static constexpr ::Envoy::Http::VectorizedCharTable kPlainPathCharTable{
+      ::Envoy::Http::removeCharsFromTable({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+                                           0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                                          "%\\")};
+  if (::Envoy::Http::findFirstCharNotInTable(kPlainPathCharTable, path) !=
+      absl::string_view::npos) {
+    return false;
+  }
+
+  for (size_t slash = path.find('/'); slash != absl::string_view::npos;
+       slash = path.find('/', slash + 1)) {
+    if (slash + 1 < path.size() && (path[slash + 1] == '/' || path[slash + 1] == '.')) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
 PathNormalizer::PathNormalizer(const HeaderValidatorConfig& config,
                                const ConfigOverrides& config_overrides)
     : config_(config), config_overrides_(config_overrides) {}
@@ -199,6 +225,11 @@ PathNormalizer::normalizePathUri(RequestHeaderMap& header_map) const {
 
   // Split the path and the query parameters / fragment component.
   auto [path_view, query] = splitPathAndQueryParams(original_path);
+  if (isNormalizedPath(path_view)) {
+    // Nothing to normalize, which is the case for most paths.
+    return PathNormalizationResult::success();
+  }
+
   // Make a copy of the original path and then create a readonly string_view to it. The string_view
   // is used for optimized sub-strings and the path is modified in place.
   std::string path{path_view.data(), path_view.length()};
@@ -105,7 +105,7 @@ Api::IoCallUint64Result IoHandleImpl::readv(uint64_t max_length, Buffer::RawSlic
   // The read bytes can not exceed the provided buffer size or pending received size.
   const auto max_bytes_to_read = std::min(pending_received_data_.length(), max_length);
   uint64_t bytes_offset = 0;
-  for (uint64_t i = 0; i < num_slice && bytes_offset < max_length; i++) {
+  for (uint64_t i = 0; i < num_slice && bytes_offset < max_bytes_to_read; i++) {
     auto bytes_to_read_in_this_slice =
         std::min(max_bytes_to_read - bytes_offset, uint64_t(slices[i].len_));
     // Copy and drain, so pending_received_data_ always copy from offset 0.
@@ -147,7 +147,11 @@ private:
 
 /**
  * This maglev implementation leverages the number of hosts to more efficiently
- * populate the maglev table.
+ * populate the maglev table. Each slot holds the index of its host in a dense host
+ * array, using only as many bits as the number of hosts requires, and the index is
+ * only resolved to a host at selection time. It is used whenever it is smaller than
+ * the original table, which is the case for any realistic number of hosts. A table
+ * is built once per host update and shared by the load balancers of all workers.
  * TODO(kbaichoo): Re-evaluate whether we should have the abstraction on the
  * table representation.
  */
@@ -1,5 +1,6 @@
 #include "source/extensions/load_balancing_policies/subset/subset_lb.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "envoy/common/optref.h"
@@ -853,8 +854,10 @@ void SubsetLoadBalancer::HostSubsetImpl::update(const HostHashSet& matching_host
 
   // TODO(snowp): If we had a unhealthyHosts() function we could avoid potentially traversing
   // the list of hosts twice.
+  // The matching hosts are an upper bound of the hosts of each kind, and usually much smaller than
+  // the hosts of the original host set, which subsets would otherwise all reserve room for.
   auto hosts = std::make_shared<HostVector>();
-  hosts->reserve(original_host_set_.hosts().size());
+  hosts->reserve(matching_hosts.size());
   for (const auto& host : original_host_set_.hosts()) {
     if (cached_predicate(*host)) {
       hosts->emplace_back(host);
@@ -862,7 +865,8 @@ void SubsetLoadBalancer::HostSubsetImpl::update(const HostHashSet& matching_host
   }
 
   auto healthy_hosts = std::make_shared<HealthyHostVector>();
-  healthy_hosts->get().reserve(original_host_set_.healthyHosts().size());
+  healthy_hosts->get().reserve(
+      std::min(matching_hosts.size(), original_host_set_.healthyHosts().size()));
   for (const auto& host : original_host_set_.healthyHosts()) {
     if (cached_predicate(*host)) {
       healthy_hosts->get().emplace_back(host);
@@ -870,7 +874,8 @@ void SubsetLoadBalancer::HostSubsetImpl::update(const HostHashSet& matching_host
   }
 
   auto degraded_hosts = std::make_shared<DegradedHostVector>();
-  degraded_hosts->get().reserve(original_host_set_.degradedHosts().size());
+  degraded_hosts->get().reserve(
+      std::min(matching_hosts.size(), original_host_set_.degradedHosts().size()));
   for (const auto& host : original_host_set_.degradedHosts()) {
     if (cached_predicate(*host)) {
       degraded_hosts->get().emplace_back(host);
@@ -878,7 +883,8 @@ void SubsetLoadBalancer::HostSubsetImpl::update(const HostHashSet& matching_host
   }
 
   auto excluded_hosts = std::make_shared<ExcludedHostVector>();
-  excluded_hosts->get().reserve(original_host_set_.excludedHosts().size());
+  excluded_hosts->get().reserve(
+      std::min(matching_hosts.size(), original_host_set_.excludedHosts().size()));
   for (const auto& host : original_host_set_.excludedHosts()) {
     if (cached_predicate(*host)) {
       excluded_hosts->get().emplace_back(host);
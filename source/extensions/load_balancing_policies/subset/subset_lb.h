@@ -335,43 +335,58 @@ private:
       return subset_.lb_->chooseHost(context);
     }
     void pushHost(uint32_t priority, HostSharedPtr host) override {
-      while (host_sets_.size() <= priority) {
-        host_sets_.push_back({HostHashSet(), HostHashSet()});
+      while (new_hosts_.size() <= priority) {
+        new_hosts_.emplace_back();
       }
-      host_sets_[priority].second.emplace(std::move(host));
+      new_hosts_[priority].emplace(std::move(host));
     }
     // Called after pushHost. Update subset by the hosts that pushed in the pushHost. If no any host
     // is pushed then subset_ will be set to empty.
     void finalize(uint32_t priority, uint64_t seed) override {
-      while (host_sets_.size() <= priority) {
-        host_sets_.push_back({HostHashSet(), HostHashSet()});
+      while (new_hosts_.size() <= priority) {
+        new_hosts_.emplace_back();
       }
-      auto& [old_hosts, new_hosts] = host_sets_[priority];
+      HostHashSet& new_hosts = new_hosts_[priority];
 
+      // The hosts of the subset are the ones pushed for the previous update, so they are diffed
+      // against rather than kept in a set of their own.
       HostVector added;
       HostVector removed;
-
-      for (const auto& host : old_hosts) {
-        if (new_hosts.count(host) == 0) {
-          removed.emplace_back(host);
+      const HostVector* old_hosts = nullptr;
+      if (priority < subset_.hostSetsPerPriority().size()) {
+        old_hosts = &subset_.hostSetsPerPriority()[priority]->hosts();
+        for (const auto& host : *old_hosts) {
+          if (new_hosts.count(host) == 0) {
+            removed.emplace_back(host);
+          }
         }
       }
 
-      for (const auto& host : new_hosts) {
-        if (old_hosts.count(host) == 0) {
-          added.emplace_back(host);
+      // Every new host is either added or was already there, so most updates of a subset, which
+      // add nothing, can skip looking for added hosts.
+      const size_t num_old_hosts = old_hosts == nullptr ? 0 : old_hosts->size();
+      if (new_hosts.size() + removed.size() > num_old_hosts) {
+        HostHashSet old_host_set;
+        if (old_hosts != nullptr) {
+          old_host_set.insert(old_hosts->begin(), old_hosts->end());
+        }
+        for (const auto& host : new_hosts) {
+          if (old_host_set.count(host) == 0) {
+            added.emplace_back(host);
+          }
         }
       }
 
       subset_.update(priority, new_hosts, added, removed, seed);
 
-      old_hosts.swap(new_hosts);
-      new_hosts.clear();
+      // Release the memory of the set, which is only needed during updates.
+      HostHashSet().swap(new_hosts);
     }
 
     bool active() const override { return !subset_.empty(); }
 
-    std::vector<std::pair<HostHashSet, HostHashSet>> host_sets_;
+    // The hosts pushed for the ongoing update, per priority.
+    std::vector<HostHashSet> new_hosts_;
     PrioritySubsetImpl subset_;
   };
 
@@ -16,6 +16,7 @@
 #include "source/common/network/address_impl.h"
 #include "source/common/network/resolver_impl.h"
 #include "source/common/network/utility.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/strings/str_join.h"
@@ -35,6 +36,8 @@ DnsResolverImpl::DnsResolverImpl(
       use_resolvers_as_fallback_(config.use_resolvers_as_fallback()),
       resolvers_csv_(maybeBuildResolversCsv(resolvers)),
       filter_unroutable_families_(config.filter_unroutable_families()),
+      coalesce_concurrent_queries_(config.coalesce_concurrent_queries()),
+      negative_cache_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, negative_cache_ttl, 0)),
       scope_(root_scope.createScope("dns.cares.")), stats_(generateCaresDnsResolverStats(*scope_)) {
   AresOptions options = defaultAresOptions();
   initializeChannel(&options.options_, options.optmask_);
@@ -253,6 +256,8 @@ void DnsResolverImpl::AddrInfoPendingResolution::onAresGetAddrInfoCallback(
   }
 
   if (completed_) {
+    parent_.maybeAddNegativeCacheEntry({dns_name_, dns_lookup_family_}, pending_response_.status_,
+                                       pending_response_.address_list_);
     finishResolve();
     // Nothing can follow a call to finishResolve due to the deletion of this object upon
     // finishResolve().
@@ -284,29 +289,20 @@ void DnsResolverImpl::PendingResolution::finishResolve() {
                   "dns resolution for {} completed with status {}", dns_name_,
                   static_cast<int>(pending_response_.status_));
 
-  if (!cancelled_) {
-    // Use a raw try here because it is used in both main thread and filter.
-    // Can not convert to use status code as there may be unexpected exceptions in server fuzz
-    // tests, which must be handled. Potential exception may come from getAddressWithPort() or
-    // portFromTcpUrl().
-    // TODO(chaoqin-li1123): remove try catch pattern here once we figure how to handle unexpected
-    // exception in fuzz tests.
-    TRY_NEEDS_AUDIT {
-      callback_(pending_response_.status_, std::move(pending_response_.address_list_));
-    }
-    END_TRY
-    catch (const EnvoyException& e) {
-      ENVOY_LOG(critical, "EnvoyException in c-ares callback: {}", e.what());
-      dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
-    }
-    catch (const std::exception& e) {
-      ENVOY_LOG(critical, "std::exception in c-ares callback: {}", e.what());
-      dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
-    }
-    catch (...) {
-      ENVOY_LOG(critical, "Unknown exception in c-ares callback");
-      dispatcher_.post([] { throw EnvoyException("unknown"); });
+  // Later resolutions of the same key must issue a query of their own, even if they are started by
+  // the callbacks below.
+  const auto in_flight = parent_.in_flight_queries_.find({dns_name_, dns_lookup_family_});
+  if (in_flight != parent_.in_flight_queries_.end() && in_flight->second == this) {
+    parent_.in_flight_queries_.erase(in_flight);
+  }
+  for (const CoalescedResolutionPtr& coalesced : coalesced_resolutions_) {
+    if (!coalesced->cancelled_) {
+      runCallback(coalesced->callback_, std::list<DnsResponse>(pending_response_.address_list_));
     }
+  }
+
+  if (!cancelled_) {
+    runCallback(callback_, std::move(pending_response_.address_list_));
   } else {
     ENVOY_LOG_EVENT(debug, "cares_dns_callback_cancelled",
                     "dns resolution callback for {} not issued. Cancelled with reason={}",
@@ -318,6 +314,30 @@ void DnsResolverImpl::PendingResolution::finishResolve() {
   }
 }
 
+void DnsResolverImpl::PendingResolution::runCallback(const ResolveCb& callback,
+                                                     std::list<DnsResponse>&& response) {
+  // Use a raw try here because it is used in both main thread and filter.
+  // Can not convert to use status code as there may be unexpected exceptions in server fuzz
+  // tests, which must be handled. Potential exception may come from getAddressWithPort() or
+  // portFromTcpUrl().
+  // TODO(chaoqin-li1123): remove try catch pattern here once we figure how to handle unexpected
+  // exception in fuzz tests.
+  TRY_NEEDS_AUDIT { callback(pending_response_.status_, std::move(response)); }
+  END_TRY
+  catch (const EnvoyException& e) {
+    ENVOY_LOG(critical, "EnvoyException in c-ares callback: {}", e.what());
+    dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
+  }
+  catch (const std::exception& e) {
+    ENVOY_LOG(critical, "std::exception in c-ares callback: {}", e.what());
+    dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
+  }
+  catch (...) {
+    ENVOY_LOG(critical, "Unknown exception in c-ares callback");
+    dispatcher_.post([] { throw EnvoyException("unknown"); });
+  }
+}
+
 void DnsResolverImpl::updateAresTimer() {
   // Update the timeout for events.
   timeval timeout;
@@ -375,6 +395,33 @@ ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
     initializeChannel(&options.options_, options.optmask_);
   }
 
+  QueryKey key{dns_name, dns_lookup_family};
+  if (!negative_cache_.empty()) {
+    const auto negative = negative_cache_.find(key);
+    if (negative != negative_cache_.end()) {
+      if (negative->second.expiry_ > dispatcher_.timeSource().monotonicTime()) {
+        ENVOY_LOG_EVENT(debug, "cares_dns_negative_cache_hit",
+                        "dns resolution for {} completed from the negative cache", dns_name);
+        stats_.negative_cache_hit_.inc();
+        callback(negative->second.status_, {});
+        return nullptr;
+      }
+      negative_cache_.erase(negative);
+    }
+  }
+
+  if (coalesce_concurrent_queries_) {
+    const auto in_flight = in_flight_queries_.find(key);
+    if (in_flight != in_flight_queries_.end()) {
+      ENVOY_LOG_EVENT(debug, "cares_dns_resolution_coalesced",
+                      "dns resolution for {} coalesced with the query in flight", dns_name);
+      stats_.coalesced_.inc();
+      return in_flight->second->coalesced_resolutions_
+          .emplace_back(std::make_unique<CoalescedResolution>(std::move(callback)))
+          .get();
+    }
+  }
+
   auto pending_resolution = std::make_unique<AddrInfoPendingResolution>(
       *this, callback, dispatcher_, channel_, dns_name, dns_lookup_family);
   pending_resolution->startResolution();
@@ -390,6 +437,9 @@ ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
     // if ~DnsResolverImpl() happens via ares_destroy() and subsequent handling of ARES_EDESTRUCTION
     // in DnsResolverImpl::PendingResolution::onAresGetAddrInfoCallback()).
     pending_resolution->owned_ = true;
+    if (coalesce_concurrent_queries_) {
+      in_flight_queries_.emplace(std::move(key), pending_resolution.get());
+    }
     return pending_resolution.release();
   }
 }
@@ -409,11 +459,29 @@ void DnsResolverImpl::chargeGetAddrInfoErrorStats(int status, int timeouts) {
   }
 }
 
+void DnsResolverImpl::maybeAddNegativeCacheEntry(const QueryKey& key, ResolutionStatus status,
+                                                 const std::list<DnsResponse>& response) {
+  if (negative_cache_ttl_.count() == 0 ||
+      (status == ResolutionStatus::Success && !response.empty())) {
+    return;
+  }
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  // Bound the memory of the cache by the names that are failing at nearly the same time.
+  if (negative_cache_.size() >= MaxNegativeCacheEntries) {
+    absl::erase_if(negative_cache_,
+                   [now](const auto& entry) { return entry.second.expiry_ <= now; });
+    if (negative_cache_.size() >= MaxNegativeCacheEntries) {
+      return;
+    }
+  }
+  negative_cache_.insert_or_assign(key, NegativeCacheEntry{status, now + negative_cache_ttl_});
+}
+
 DnsResolverImpl::AddrInfoPendingResolution::AddrInfoPendingResolution(
     DnsResolverImpl& parent, ResolveCb callback, Event::Dispatcher& dispatcher,
     ares_channel channel, const std::string& dns_name, DnsLookupFamily dns_lookup_family)
-    : PendingResolution(parent, callback, dispatcher, channel, dns_name),
-      dns_lookup_family_(dns_lookup_family), available_interfaces_(availableInterfaces()) {
+    : PendingResolution(parent, callback, dispatcher, channel, dns_name, dns_lookup_family),
+      available_interfaces_(availableInterfaces()) {
   if (dns_lookup_family == DnsLookupFamily::Auto ||
       dns_lookup_family == DnsLookupFamily::V4Preferred) {
     dual_resolution_ = true;
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
+#include <list>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "envoy/common/platform.h"
 #include "envoy/event/dispatcher.h"
@@ -14,6 +18,7 @@
 #include "source/common/common/utility.h"
 #include "source/common/network/dns_resolver/dns_factory_util.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "ares.h"
 
@@ -28,7 +33,9 @@ namespace Network {
   GAUGE(pending_resolutions, NeverImport)                                                          \
   COUNTER(not_found)                                                                               \
   COUNTER(get_addr_failure)                                                                        \
-  COUNTER(timeouts)
+  COUNTER(timeouts)                                                                                \
+  COUNTER(coalesced)                                                                               \
+  COUNTER(negative_cache_hit)
 
 /**
  * Struct definition for all DNS stats. @see stats_macros.h
@@ -60,10 +67,36 @@ public:
   void resetNetworking() override {
     // Dirty the channel so that the next query will recreate it.
     dirty_channel_ = true;
+    negative_cache_.clear();
   }
 
 private:
   friend class DnsResolverImplPeer;
+
+  // The resolutions of the same name and lookup family share their queries and negative results.
+  using QueryKey = std::pair<std::string, DnsLookupFamily>;
+
+  // A resolution completed with the result of a query started by an earlier resolution.
+  class CoalescedResolution : public ActiveDnsQuery {
+  public:
+    explicit CoalescedResolution(ResolveCb callback) : callback_(std::move(callback)) {}
+
+    // Network::ActiveDnsQuery
+    void cancel(CancelReason) override { cancelled_ = true; }
+
+    const ResolveCb callback_;
+    bool cancelled_ = false;
+  };
+  using CoalescedResolutionPtr = std::unique_ptr<CoalescedResolution>;
+
+  // The failing names remembered at once, beyond which further failures are not remembered.
+  static constexpr size_t MaxNegativeCacheEntries = 1024;
+
+  struct NegativeCacheEntry {
+    ResolutionStatus status_;
+    MonotonicTime expiry_;
+  };
+
   class PendingResolution : public ActiveDnsQuery {
   public:
     void cancel(CancelReason reason) override {
@@ -78,15 +111,19 @@ private:
     bool owned_ = false;
     // Has the query completed? Only meaningful if !owned_;
     bool completed_ = false;
+    // The resolutions completed with the result of this query once it completes.
+    std::list<CoalescedResolutionPtr> coalesced_resolutions_;
 
   protected:
     // Network::ActiveDnsQuery
     PendingResolution(DnsResolverImpl& parent, ResolveCb callback, Event::Dispatcher& dispatcher,
-                      ares_channel channel, const std::string& dns_name)
+                      ares_channel channel, const std::string& dns_name,
+                      DnsLookupFamily dns_lookup_family)
         : parent_(parent), callback_(callback), dispatcher_(dispatcher), channel_(channel),
-          dns_name_(dns_name) {}
+          dns_name_(dns_name), dns_lookup_family_(dns_lookup_family) {}
 
     void finishResolve();
+    void runCallback(const ResolveCb& callback, std::list<DnsResponse>&& response);
 
     DnsResolverImpl& parent_;
     // Caller supplied callback to invoke on query completion or error.
@@ -97,6 +134,7 @@ private:
     bool cancelled_ = false;
     const ares_channel channel_;
     const std::string dns_name_;
+    const DnsLookupFamily dns_lookup_family_;
     CancelReason cancel_reason_;
 
     // Small wrapping struct to accumulate addresses from firings of the
@@ -158,7 +196,6 @@ private:
     // all concurrent queries are unwound before cleaning up the resolution.
     uint32_t pending_resolutions_ = 0;
     int family_ = AF_INET;
-    const DnsLookupFamily dns_lookup_family_;
     // Queried for at construction time.
     const AvailableInterfaces available_interfaces_;
   };
@@ -186,6 +223,9 @@ private:
   AresOptions defaultAresOptions();
 
   void chargeGetAddrInfoErrorStats(int status, int timeouts);
+  // Remember the result of a completed query if it failed or returned no records.
+  void maybeAddNegativeCacheEntry(const QueryKey& key, ResolutionStatus status,
+                                  const std::list<DnsResponse>& response);
 
   Event::Dispatcher& dispatcher_;
   Event::TimerPtr timer_;
@@ -197,6 +237,11 @@ private:
   const bool use_resolvers_as_fallback_;
   const absl::optional<std::string> resolvers_csv_;
   const bool filter_unroutable_families_;
+  const bool coalesce_concurrent_queries_;
+  const std::chrono::milliseconds negative_cache_ttl_;
+  // The queries in flight which later resolutions of the same key are coalesced with.
+  absl::flat_hash_map<QueryKey, PendingResolution*> in_flight_queries_;
+  absl::flat_hash_map<QueryKey, NegativeCacheEntry> negative_cache_;
   Stats::ScopeSharedPtr scope_;
   CaresDnsResolverStats stats_;
 };
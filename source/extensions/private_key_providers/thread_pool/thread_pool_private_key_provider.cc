@@ -0,0 +1,385 @@
+#include "source/extensions/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+#include <memory>
+
+#include "envoy/server/transport_socket_config.h"
+#include "envoy/singleton/manager.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/config/datasource.h"
+#include "source/common/protobuf/utility.h"
+#include "source/common/stats/symbol_table.h"
+
+#include "openssl/evp.h"
+#include "openssl/rsa.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+SINGLETON_MANAGER_REGISTRATION(thread_pool_private_key_registry);
+
+namespace {
+
+ThreadPoolPrivateKeyConnection* getConnection(SSL* ssl) {
+  return static_cast<ThreadPoolPrivateKeyConnection*>(
+      SSL_get_ex_data(ssl, ThreadPoolPrivateKeyMethodProvider::connectionIndex()));
+}
+
+ssl_private_key_result_t privateKeySign(SSL* ssl, uint8_t*, size_t*, size_t max_out,
+                                        uint16_t signature_algorithm, const uint8_t* in,
+                                        size_t in_len) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection(ssl);
+  if (connection == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return connection->start(OperationType::Sign, signature_algorithm, in, in_len, max_out);
+}
+
+ssl_private_key_result_t privateKeyDecrypt(SSL* ssl, uint8_t*, size_t*, size_t max_out,
+                                           const uint8_t* in, size_t in_len) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection(ssl);
+  if (connection == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return connection->start(OperationType::Decrypt, 0, in, in_len, max_out);
+}
+
+ssl_private_key_result_t privateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                            size_t max_out) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection(ssl);
+  if (connection == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return connection->complete(out, out_len, max_out);
+}
+
+int createIndex() {
+  int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  RELEASE_ASSERT(index >= 0, "Failed to get SSL user data index.");
+  return index;
+}
+
+} // namespace
+
+PrivateKeyOperation::PrivateKeyOperation(ThreadPoolPrivateKeyConnection& connection,
+                                         Event::Dispatcher& dispatcher, TimeSource& time_source,
+                                         bssl::UniquePtr<EVP_PKEY> pkey, OperationType type,
+                                         uint16_t signature_algorithm, const uint8_t* in,
+                                         size_t in_len, size_t max_out)
+    : connection_(&connection), dispatcher_(dispatcher), time_source_(time_source),
+      pkey_(std::move(pkey)), type_(type), signature_algorithm_(signature_algorithm),
+      input_(in, in + in_len), max_out_(max_out), enqueue_time_(time_source.monotonicTime()) {}
+
+void PrivateKeyOperation::execute() {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (connection_ == nullptr) {
+      // The connection went away while the operation was queued.
+      return;
+    }
+  }
+
+  start_time_ = time_source_.monotonicTime();
+  succeeded_ = type_ == OperationType::Sign ? sign() : decrypt();
+  end_time_ = time_source_.monotonicTime();
+  postCompletion();
+}
+
+void PrivateKeyOperation::fail() {
+  start_time_ = time_source_.monotonicTime();
+  end_time_ = start_time_;
+  succeeded_ = false;
+  postCompletion();
+}
+
+void PrivateKeyOperation::postCompletion() {
+  // The connection is destroyed on its worker thread before the dispatcher of the worker, and it
+  // cancels the operation first. Posting while holding the lock therefore never races with the
+  // destruction of the dispatcher.
+  absl::MutexLock lock(&mutex_);
+  if (connection_ != nullptr) {
+    dispatcher_.post([operation = shared_from_this()]() { operation->onComplete(); });
+  }
+}
+
+void PrivateKeyOperation::cancel() {
+  absl::MutexLock lock(&mutex_);
+  connection_ = nullptr;
+}
+
+void PrivateKeyOperation::onComplete() {
+  ThreadPoolPrivateKeyConnection* connection;
+  {
+    absl::MutexLock lock(&mutex_);
+    connection = connection_;
+  }
+  // Both the cancellation and this run on the worker thread, so the connection, if any, stays
+  // alive until it is told about the result.
+  if (connection != nullptr) {
+    connection->onOperationComplete();
+  }
+}
+
+std::chrono::microseconds PrivateKeyOperation::queueTime() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(start_time_ - enqueue_time_);
+}
+
+std::chrono::microseconds PrivateKeyOperation::operationTime() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(end_time_ - start_time_);
+}
+
+bool PrivateKeyOperation::sign() {
+  if (SSL_get_signature_algorithm_key_type(signature_algorithm_) != EVP_PKEY_id(pkey_.get())) {
+    return false;
+  }
+
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pkey_ctx;
+  const EVP_MD* md = SSL_get_signature_algorithm_digest(signature_algorithm_);
+  if (!EVP_DigestSignInit(ctx.get(), &pkey_ctx, md, nullptr, pkey_.get())) {
+    return false;
+  }
+  if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm_) &&
+      (!EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ||
+       !EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1))) {
+    return false;
+  }
+
+  size_t out_len = max_out_;
+  output_.resize(max_out_);
+  if (!EVP_DigestSign(ctx.get(), output_.data(), &out_len, input_.data(), input_.size())) {
+    return false;
+  }
+  output_.resize(out_len);
+  return true;
+}
+
+bool PrivateKeyOperation::decrypt() {
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey_.get());
+  if (rsa == nullptr) {
+    return false;
+  }
+
+  size_t out_len;
+  output_.resize(max_out_);
+  if (!RSA_decrypt(rsa, &out_len, output_.data(), max_out_, input_.data(), input_.size(),
+                   RSA_NO_PADDING)) {
+    return false;
+  }
+  output_.resize(out_len);
+  return true;
+}
+
+PrivateKeyThreadPool::PrivateKeyThreadPool(Thread::ThreadFactory& thread_factory,
+                                           uint32_t thread_count, uint32_t max_queue_depth,
+                                           Stats::Gauge& queue_depth)
+    : max_queue_depth_(max_queue_depth), queue_depth_(queue_depth) {
+  ENVOY_LOG(debug, "Creating private key thread pool with {} threads", thread_count);
+  threads_.reserve(thread_count);
+  while (threads_.size() < thread_count) {
+    threads_.push_back(thread_factory.createThread([this]() { threadRoutine(); },
+                                                   Thread::Options{"tls-pkey-ops"}));
+  }
+}
+
+PrivateKeyThreadPool::~PrivateKeyThreadPool() {
+  std::queue<PrivateKeyOperationSharedPtr> queue;
+  {
+    absl::MutexLock lock(&mutex_);
+    terminate_ = true;
+    queue_depth_.sub(queue_.size());
+    queue.swap(queue_);
+  }
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+  while (!queue.empty()) {
+    queue.front()->fail();
+    queue.pop();
+  }
+}
+
+bool PrivateKeyThreadPool::enqueue(PrivateKeyOperationSharedPtr operation) {
+  absl::MutexLock lock(&mutex_);
+  if (queue_.size() >= max_queue_depth_) {
+    return false;
+  }
+  queue_.push(std::move(operation));
+  queue_depth_.inc();
+  return true;
+}
+
+void PrivateKeyThreadPool::threadRoutine() {
+  while (true) {
+    const auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+      return !queue_.empty() || terminate_;
+    };
+    PrivateKeyOperationSharedPtr operation;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(&condition));
+      if (terminate_) {
+        return;
+      }
+      operation = std::move(queue_.front());
+      queue_.pop();
+      queue_depth_.dec();
+    }
+    operation->execute();
+  }
+}
+
+PrivateKeyThreadPoolSharedPtr
+PrivateKeyThreadPoolRegistry::get(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                                  uint32_t max_queue_depth, Stats::Scope& scope) {
+  absl::MutexLock lock(&mutex_);
+  std::weak_ptr<PrivateKeyThreadPool>& weak_pool = pools_[{thread_count, max_queue_depth}];
+  PrivateKeyThreadPoolSharedPtr pool = weak_pool.lock();
+  if (pool == nullptr) {
+    Stats::Gauge& queue_depth = scope.gaugeFromStatName(
+        Stats::StatNameManagedStorage("thread_pool_private_key.queue_depth", scope.symbolTable())
+            .statName(),
+        Stats::Gauge::ImportMode::Accumulate);
+    pool = std::make_shared<PrivateKeyThreadPool>(thread_factory, thread_count, max_queue_depth,
+                                                  queue_depth);
+    weak_pool = pool;
+  }
+  return pool;
+}
+
+ThreadPoolPrivateKeyConnection::ThreadPoolPrivateKeyConnection(
+    Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher& dispatcher,
+    TimeSource& time_source, bssl::UniquePtr<EVP_PKEY> pkey, PrivateKeyThreadPool& pool,
+    ThreadPoolPrivateKeyStats& stats)
+    : cb_(cb), dispatcher_(dispatcher), time_source_(time_source), pkey_(std::move(pkey)),
+      pool_(pool), stats_(stats) {}
+
+ThreadPoolPrivateKeyConnection::~ThreadPoolPrivateKeyConnection() {
+  if (operation_ != nullptr) {
+    operation_->cancel();
+  }
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::start(OperationType type,
+                                                               uint16_t signature_algorithm,
+                                                               const uint8_t* in, size_t in_len,
+                                                               size_t max_out) {
+  // BoringSSL only starts an operation once the previous one has completed.
+  ASSERT(operation_ == nullptr);
+  auto operation =
+      std::make_shared<PrivateKeyOperation>(*this, dispatcher_, time_source_, bssl::UpRef(pkey_),
+                                            type, signature_algorithm, in, in_len, max_out);
+  if (!pool_.enqueue(operation)) {
+    stats_.queue_overflow_.inc();
+    return ssl_private_key_failure;
+  }
+  operation_ = std::move(operation);
+  done_ = false;
+  return ssl_private_key_retry;
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::complete(uint8_t* out, size_t* out_len,
+                                                                  size_t max_out) {
+  if (operation_ == nullptr) {
+    return ssl_private_key_failure;
+  }
+  if (!done_) {
+    return ssl_private_key_retry;
+  }
+
+  PrivateKeyOperationSharedPtr operation = std::move(operation_);
+  const std::vector<uint8_t>& output = operation->output();
+  if (!operation->succeeded() || output.size() > max_out) {
+    return ssl_private_key_failure;
+  }
+  std::copy(output.begin(), output.end(), out);
+  *out_len = output.size();
+  return ssl_private_key_success;
+}
+
+void ThreadPoolPrivateKeyConnection::onOperationComplete() {
+  done_ = true;
+  stats_.queue_time_us_.recordValue(operation_->queueTime().count());
+  stats_.operation_time_us_.recordValue(operation_->operationTime().count());
+  // Resuming the handshake may close the connection and destroy this object.
+  cb_.onPrivateKeyMethodComplete();
+}
+
+ThreadPoolPrivateKeyMethodProvider::ThreadPoolPrivateKeyMethodProvider(
+    const envoy::extensions::private_key_providers::thread_pool::v3::
+        ThreadPoolPrivateKeyMethodConfig& conf,
+    Server::Configuration::TransportSocketFactoryContext& factory_context)
+    : time_source_(factory_context.serverFactoryContext().api().timeSource()),
+      stats_{ALL_THREAD_POOL_PRIVATE_KEY_STATS(
+          POOL_COUNTER_PREFIX(factory_context.statsScope(), "thread_pool_private_key"),
+          POOL_HISTOGRAM_PREFIX(factory_context.statsScope(), "thread_pool_private_key"))} {
+  Api::Api& api = factory_context.serverFactoryContext().api();
+  std::string private_key =
+      THROW_OR_RETURN_VALUE(Config::DataSource::read(conf.private_key(), false, api), std::string);
+
+  bssl::UniquePtr<BIO> bio(
+      BIO_new_mem_buf(const_cast<char*>(private_key.data()), private_key.size()));
+  bssl::UniquePtr<EVP_PKEY> pkey(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  if (pkey == nullptr) {
+    throw EnvoyException("Failed to read private key.");
+  }
+  if (EVP_PKEY_id(pkey.get()) != EVP_PKEY_RSA && EVP_PKEY_id(pkey.get()) != EVP_PKEY_EC) {
+    throw EnvoyException("Not supported key type, only EC and RSA are supported.");
+  }
+  pkey_ = std::move(pkey);
+
+  method_ = std::make_shared<SSL_PRIVATE_KEY_METHOD>();
+  method_->sign = privateKeySign;
+  method_->decrypt = privateKeyDecrypt;
+  method_->complete = privateKeyComplete;
+
+  Server::Configuration::ServerFactoryContext& server_context =
+      factory_context.serverFactoryContext();
+  registry_ = server_context.singletonManager().getTyped<PrivateKeyThreadPoolRegistry>(
+      SINGLETON_MANAGER_REGISTERED_NAME(thread_pool_private_key_registry),
+      [] { return std::make_shared<PrivateKeyThreadPoolRegistry>(); });
+  // The pool outlives the TLS context owning this provider if it is shared, so its queue depth is
+  // tracked in the server scope.
+  pool_ = registry_->get(api.threadFactory(),
+                         PROTOBUF_GET_WRAPPED_OR_DEFAULT(conf, thread_count, 1),
+                         PROTOBUF_GET_WRAPPED_OR_DEFAULT(conf, max_queue_depth, 1024),
+                         server_context.scope());
+}
+
+void ThreadPoolPrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher& dispatcher) {
+  if (getConnection(ssl) != nullptr) {
+    throw EnvoyException("Not registering the thread pool provider twice for same context");
+  }
+
+  auto* connection = new ThreadPoolPrivateKeyConnection(cb, dispatcher, time_source_,
+                                                        bssl::UpRef(pkey_), *pool_, stats_);
+  SSL_set_ex_data(ssl, connectionIndex(), connection);
+}
+
+void ThreadPoolPrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection(ssl);
+  SSL_set_ex_data(ssl, connectionIndex(), nullptr);
+  delete connection;
+}
+
+bool ThreadPoolPrivateKeyMethodProvider::checkFips() {
+  if (EVP_PKEY_id(pkey_.get()) == EVP_PKEY_RSA) {
+    RSA* rsa_private_key = EVP_PKEY_get0_RSA(pkey_.get());
+    return rsa_private_key != nullptr && RSA_check_fips(rsa_private_key);
+  }
+  const EC_KEY* ecdsa_private_key = EVP_PKEY_get0_EC_KEY(pkey_.get());
+  return ecdsa_private_key != nullptr && EC_KEY_check_fips(ecdsa_private_key);
+}
+
+int ThreadPoolPrivateKeyMethodProvider::connectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
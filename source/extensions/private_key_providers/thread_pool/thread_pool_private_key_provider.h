@@ -0,0 +1,213 @@
+#pragma once
+
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/private_key_providers/thread_pool/v3/thread_pool.pb.h"
+#include "envoy/server/transport_socket_config.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/ssl/private_key/private_key_config.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+/**
+ * All thread pool private key provider stats. @see stats_macros.h
+ */
+#define ALL_THREAD_POOL_PRIVATE_KEY_STATS(COUNTER, HISTOGRAM)                                      \
+  COUNTER(queue_overflow)                                                                          \
+  HISTOGRAM(queue_time_us, Microseconds)                                                           \
+  HISTOGRAM(operation_time_us, Microseconds)
+
+/**
+ * Struct definition for all thread pool private key provider stats. @see stats_macros.h
+ */
+struct ThreadPoolPrivateKeyStats {
+  ALL_THREAD_POOL_PRIVATE_KEY_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
+};
+
+enum class OperationType { Sign, Decrypt };
+
+class ThreadPoolPrivateKeyConnection;
+
+// A private key operation of a single handshake. It is created on the worker thread which owns
+// the connection, performed on a thread of the pool, and its result is handed back to the worker
+// thread by posting to its dispatcher.
+class PrivateKeyOperation : public std::enable_shared_from_this<PrivateKeyOperation> {
+public:
+  PrivateKeyOperation(ThreadPoolPrivateKeyConnection& connection, Event::Dispatcher& dispatcher,
+                      TimeSource& time_source, bssl::UniquePtr<EVP_PKEY> pkey, OperationType type,
+                      uint16_t signature_algorithm, const uint8_t* in, size_t in_len,
+                      size_t max_out);
+
+  /**
+   * Performs the operation and posts its completion to the dispatcher of the connection, unless
+   * the operation was cancelled. Called on a thread of the pool.
+   */
+  void execute();
+
+  /**
+   * Fails the operation without performing it, and posts its completion to the dispatcher of the
+   * connection, unless the operation was cancelled. Called when the pool terminates before a
+   * thread took the operation.
+   */
+  void fail();
+
+  /**
+   * Detaches the operation from its connection, which is being destroyed. The operation is then
+   * skipped if it is still queued, or its result is dropped. Called on the worker thread.
+   */
+  void cancel();
+
+  bool succeeded() const { return succeeded_; }
+  const std::vector<uint8_t>& output() const { return output_; }
+  std::chrono::microseconds queueTime() const;
+  std::chrono::microseconds operationTime() const;
+
+private:
+  bool sign();
+  bool decrypt();
+  void postCompletion();
+  void onComplete();
+
+  absl::Mutex mutex_;
+  ThreadPoolPrivateKeyConnection* connection_ ABSL_GUARDED_BY(mutex_);
+  Event::Dispatcher& dispatcher_;
+  TimeSource& time_source_;
+  const bssl::UniquePtr<EVP_PKEY> pkey_;
+  const OperationType type_;
+  const uint16_t signature_algorithm_;
+  const std::vector<uint8_t> input_;
+  const size_t max_out_;
+  const MonotonicTime enqueue_time_;
+
+  // Written on the thread of the pool before the completion is posted, and only read on the
+  // worker thread afterwards.
+  std::vector<uint8_t> output_;
+  bool succeeded_{};
+  MonotonicTime start_time_;
+  MonotonicTime end_time_;
+};
+
+using PrivateKeyOperationSharedPtr = std::shared_ptr<PrivateKeyOperation>;
+
+// A bounded queue of private key operations and the threads performing them. Operations still
+// queued when the pool is destroyed fail, so that their handshakes do not wait forever.
+class PrivateKeyThreadPool : public Logger::Loggable<Logger::Id::connection> {
+public:
+  PrivateKeyThreadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                       uint32_t max_queue_depth, Stats::Gauge& queue_depth);
+  ~PrivateKeyThreadPool() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  /**
+   * Queues an operation for the next available thread.
+   * @return false if the queue is full, in which case the operation is not queued.
+   */
+  bool enqueue(PrivateKeyOperationSharedPtr operation) ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  void threadRoutine() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  absl::Mutex mutex_;
+  std::queue<PrivateKeyOperationSharedPtr> queue_ ABSL_GUARDED_BY(mutex_);
+  bool terminate_ ABSL_GUARDED_BY(mutex_){};
+  const uint32_t max_queue_depth_;
+  Stats::Gauge& queue_depth_;
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+using PrivateKeyThreadPoolSharedPtr = std::shared_ptr<PrivateKeyThreadPool>;
+
+// The thread pools of the process. Providers configured with the same thread count and queue depth
+// share one pool, which lives as long as any of them, so that TLS contexts and their SDS updates
+// do not each start their own threads.
+class PrivateKeyThreadPoolRegistry : public Singleton::Instance {
+public:
+  PrivateKeyThreadPoolSharedPtr get(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                                    uint32_t max_queue_depth, Stats::Scope& scope)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::pair<uint32_t, uint32_t>, std::weak_ptr<PrivateKeyThreadPool>>
+      pools_ ABSL_GUARDED_BY(mutex_);
+};
+
+using PrivateKeyThreadPoolRegistrySharedPtr = std::shared_ptr<PrivateKeyThreadPoolRegistry>;
+
+// ThreadPoolPrivateKeyConnection maintains the data needed by a given SSL connection. It is only
+// accessed on the worker thread which owns the connection.
+class ThreadPoolPrivateKeyConnection {
+public:
+  ThreadPoolPrivateKeyConnection(Ssl::PrivateKeyConnectionCallbacks& cb,
+                                 Event::Dispatcher& dispatcher, TimeSource& time_source,
+                                 bssl::UniquePtr<EVP_PKEY> pkey, PrivateKeyThreadPool& pool,
+                                 ThreadPoolPrivateKeyStats& stats);
+  ~ThreadPoolPrivateKeyConnection();
+
+  ssl_private_key_result_t start(OperationType type, uint16_t signature_algorithm,
+                                 const uint8_t* in, size_t in_len, size_t max_out);
+  ssl_private_key_result_t complete(uint8_t* out, size_t* out_len, size_t max_out);
+  void onOperationComplete();
+
+private:
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  Event::Dispatcher& dispatcher_;
+  TimeSource& time_source_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  PrivateKeyThreadPool& pool_;
+  ThreadPoolPrivateKeyStats& stats_;
+  PrivateKeyOperationSharedPtr operation_;
+  bool done_{};
+};
+
+// ThreadPoolPrivateKeyMethodProvider performs the private key operations of the SSL connections
+// using its certificate on a pool of threads shared with the providers configured alike.
+class ThreadPoolPrivateKeyMethodProvider : public virtual Ssl::PrivateKeyMethodProvider,
+                                           public Logger::Loggable<Logger::Id::connection> {
+public:
+  ThreadPoolPrivateKeyMethodProvider(
+      const envoy::extensions::private_key_providers::thread_pool::v3::
+          ThreadPoolPrivateKeyMethodConfig& config,
+      Server::Configuration::TransportSocketFactoryContext& private_key_provider_context);
+
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  bool checkFips() override;
+  bool isAvailable() override { return true; }
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override {
+    return method_;
+  }
+
+  static int connectionIndex();
+
+private:
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_{};
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  TimeSource& time_source_;
+  ThreadPoolPrivateKeyStats stats_;
+  PrivateKeyThreadPoolRegistrySharedPtr registry_;
+  PrivateKeyThreadPoolSharedPtr pool_;
+};
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
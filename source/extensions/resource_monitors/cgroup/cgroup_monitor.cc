@@ -0,0 +1,130 @@
+#include "source/extensions/resource_monitors/cgroup/cgroup_monitor.h"
+
+#include <algorithm>
+
+#include "envoy/common/exception.h"
+#include "envoy/extensions/resource_monitors/cgroup/v3/cgroup.pb.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/logger.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CgroupMonitor {
+
+namespace {
+
+using CgroupConfig = envoy::extensions::resource_monitors::cgroup::v3::CgroupConfig;
+
+constexpr absl::string_view DefaultCgroupPath = "/sys/fs/cgroup";
+
+absl::StatusOr<uint64_t> parseBytes(absl::string_view name, absl::string_view contents) {
+  uint64_t bytes;
+  if (!absl::SimpleAtoi(absl::StripAsciiWhitespace(contents), &bytes)) {
+    return absl::InvalidArgumentError(absl::StrCat("failed to parse cgroup ", name));
+  }
+  return bytes;
+}
+
+// Returns the value of a "key value" line of memory.stat.
+absl::StatusOr<uint64_t> statValue(absl::string_view contents, absl::string_view key) {
+  for (absl::string_view line : absl::StrSplit(contents, '\n', absl::SkipEmpty())) {
+    if (absl::ConsumePrefix(&line, key) && absl::ConsumePrefix(&line, " ")) {
+      return parseBytes(absl::StrCat("memory.stat ", key), line);
+    }
+  }
+  return absl::NotFoundError(absl::StrCat("cgroup memory.stat has no ", key));
+}
+
+} // namespace
+
+CgroupMonitor::CgroupMonitor(const CgroupConfig& config, Filesystem::Instance& file_system)
+    : cgroup_path_(config.cgroup_path().empty() ? std::string(DefaultCgroupPath)
+                                                : config.cgroup_path()),
+      resource_(config.resource()), file_system_(file_system) {}
+
+void CgroupMonitor::updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) {
+  absl::StatusOr<double> pressure;
+  switch (resource_) {
+    PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
+  case CgroupConfig::MEMORY:
+    pressure = memoryUsage();
+    break;
+  case CgroupConfig::MEMORY_PRESSURE:
+    pressure = stallPressure("memory.pressure");
+    break;
+  case CgroupConfig::CPU_PRESSURE:
+    pressure = stallPressure("cpu.pressure");
+    break;
+  }
+
+  if (!pressure.ok()) {
+    callbacks.onFailure(EnvoyException(std::string(pressure.status().message())));
+    return;
+  }
+  ENVOY_LOG_MISC(trace, "CgroupMonitor: path={}, resource={}, pressure={}", cgroup_path_,
+                 CgroupConfig::Resource_Name(resource_), *pressure);
+  callbacks.onSuccess({std::min(*pressure, 1.0)});
+}
+
+absl::StatusOr<std::string> CgroupMonitor::readFile(absl::string_view name) {
+  return file_system_.fileReadToEnd(absl::StrCat(cgroup_path_, "/", name));
+}
+
+absl::StatusOr<double> CgroupMonitor::memoryUsage() {
+  absl::StatusOr<std::string> max = readFile("memory.max");
+  RETURN_IF_STATUS_NOT_OK(max);
+  if (absl::StripAsciiWhitespace(*max) == "max") {
+    return absl::FailedPreconditionError("cgroup has no memory limit");
+  }
+  absl::StatusOr<uint64_t> limit = parseBytes("memory.max", *max);
+  RETURN_IF_STATUS_NOT_OK(limit);
+  if (*limit == 0) {
+    return 1.0;
+  }
+
+  absl::StatusOr<std::string> current = readFile("memory.current");
+  RETURN_IF_STATUS_NOT_OK(current);
+  absl::StatusOr<uint64_t> used = parseBytes("memory.current", *current);
+  RETURN_IF_STATUS_NOT_OK(used);
+
+  // Inactive page cache is reclaimed before the cgroup runs out of memory, so it is not counted.
+  absl::StatusOr<std::string> stat = readFile("memory.stat");
+  RETURN_IF_STATUS_NOT_OK(stat);
+  absl::StatusOr<uint64_t> inactive_file = statValue(*stat, "inactive_file");
+  RETURN_IF_STATUS_NOT_OK(inactive_file);
+
+  const uint64_t working_set = *used - std::min(*used, *inactive_file);
+  return working_set / static_cast<double>(*limit);
+}
+
+absl::StatusOr<double> CgroupMonitor::stallPressure(absl::string_view name) {
+  absl::StatusOr<std::string> contents = readFile(name);
+  RETURN_IF_STATUS_NOT_OK(contents);
+  // The first line reads "some avg10=<percent> avg60=<percent> avg300=<percent> total=<us>".
+  for (absl::string_view line : absl::StrSplit(*contents, '\n', absl::SkipEmpty())) {
+    if (!absl::ConsumePrefix(&line, "some ")) {
+      continue;
+    }
+    for (absl::string_view field : absl::StrSplit(line, ' ', absl::SkipEmpty())) {
+      double percent;
+      if (absl::ConsumePrefix(&field, "avg10=") && absl::SimpleAtod(field, &percent) &&
+          percent >= 0) {
+        return percent / 100;
+      }
+    }
+  }
+  return absl::InvalidArgumentError(absl::StrCat("failed to parse cgroup ", name));
+}
+
+} // namespace CgroupMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
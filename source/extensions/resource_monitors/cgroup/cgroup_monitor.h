@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+
+#include "envoy/extensions/resource_monitors/cgroup/v3/cgroup.pb.h"
+#include "envoy/filesystem/filesystem.h"
+#include "envoy/server/resource_monitor.h"
+
+#include "absl/status/statusor.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CgroupMonitor {
+
+/**
+ * A monitor for a resource of a cgroup v2, read from the interface files of the cgroup on each
+ * update: the memory used as a fraction of the memory limit, or the memory or CPU pressure stall
+ * information (PSI) of the cgroup.
+ */
+class CgroupMonitor : public Server::ResourceMonitor {
+public:
+  CgroupMonitor(const envoy::extensions::resource_monitors::cgroup::v3::CgroupConfig& config,
+                Filesystem::Instance& file_system);
+
+  // Server::ResourceMonitor
+  void updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) override;
+
+private:
+  absl::StatusOr<std::string> readFile(absl::string_view name);
+  absl::StatusOr<double> memoryUsage();
+  absl::StatusOr<double> stallPressure(absl::string_view name);
+
+  const std::string cgroup_path_;
+  const envoy::extensions::resource_monitors::cgroup::v3::CgroupConfig::Resource resource_;
+  Filesystem::Instance& file_system_;
+};
+
+} // namespace CgroupMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
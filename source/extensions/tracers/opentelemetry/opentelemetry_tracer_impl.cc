@@ -84,9 +84,15 @@ Driver::Driver(const envoy::config::trace::v3::OpenTelemetryConfig& opentelemetr
   // Create the sampler if configured
   SamplerSharedPtr sampler = tryCreateSamper(opentelemetry_config, context);
 
+  TailSamplingPolicyConstSharedPtr tail_sampling_policy;
+  if (opentelemetry_config.has_tail_sampling()) {
+    tail_sampling_policy =
+        std::make_shared<const TailSamplingPolicy>(opentelemetry_config.tail_sampling());
+  }
+
   // Create the tracer in Thread Local Storage.
-  tls_slot_ptr_->set([opentelemetry_config, &factory_context, this, resource_ptr,
-                      sampler](Event::Dispatcher& dispatcher) {
+  tls_slot_ptr_->set([opentelemetry_config, &factory_context, this, resource_ptr, sampler,
+                      tail_sampling_policy](Event::Dispatcher& dispatcher) {
     OpenTelemetryTraceExporterPtr exporter;
     if (opentelemetry_config.has_grpc_service()) {
       auto factory_or_error =
@@ -103,7 +109,8 @@ Driver::Driver(const envoy::config::trace::v3::OpenTelemetryConfig& opentelemetr
     }
     TracerPtr tracer = std::make_unique<Tracer>(
         std::move(exporter), factory_context.timeSource(), factory_context.api().randomGenerator(),
-        factory_context.runtime(), dispatcher, tracing_stats_, resource_ptr, sampler);
+        factory_context.runtime(), dispatcher, tracing_stats_, resource_ptr, sampler,
+        tail_sampling_policy);
     return std::make_shared<TlsTracer>(std::move(tracer));
   });
 }
@@ -7,6 +7,8 @@
 
 #include "source/common/common/empty_string.h"
 #include "source/common/common/hex.h"
+#include "source/common/protobuf/utility.h"
+#include "source/common/tracing/common_values.h"
 #include "source/common/tracing/trace_context_impl.h"
 #include "source/extensions/tracers/opentelemetry/otlp_utils.h"
 
@@ -20,8 +22,6 @@ namespace OpenTelemetry {
 
 constexpr absl::string_view kDefaultVersion = "00";
 
-using opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest;
-
 namespace {
 
 const Tracing::TraceContextHandler& traceParentHeader() {
@@ -111,24 +111,92 @@ void Span::setAttribute(absl::string_view name, const OTelAttribute& attribute_v
     }
   }
   // If we haven't found an existing match already, we can add a new key/value.
-  opentelemetry::proto::common::v1::KeyValue key_value =
-      opentelemetry::proto::common::v1::KeyValue();
-  opentelemetry::proto::common::v1::AnyValue value_proto =
-      opentelemetry::proto::common::v1::AnyValue();
-  OtlpUtils::populateAnyValue(value_proto, attribute_value);
-  key_value.set_key(std::string{name});
-  *key_value.mutable_value() = value_proto;
-  *span_.add_attributes() = key_value;
+  opentelemetry::proto::common::v1::KeyValue* key_value = span_.add_attributes();
+  key_value->set_key(std::string{name});
+  OtlpUtils::populateAnyValue(*key_value->mutable_value(), attribute_value);
 }
 
 void Span::setTag(absl::string_view name, absl::string_view value) { setAttribute(name, value); }
 
+TailSamplingPolicy::TailSamplingPolicy(
+    const envoy::config::trace::v3::OpenTelemetryConfig::TailSampling& config)
+    : max_buffered_spans_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_buffered_spans, 1000)),
+      slow_span_threshold_ns_(PROTOBUF_GET_MS_OR_DEFAULT(config, slow_span_threshold, 0) *
+                              1000000),
+      ignore_errors_(config.ignore_errors()) {
+  tag_rules_.reserve(config.tags_size());
+  for (const auto& rule : config.tags()) {
+    tag_rules_.push_back({rule.name(), Matchers::StringMatcherImpl(rule.value())});
+  }
+}
+
+bool TailSamplingPolicy::selects(const ::opentelemetry::proto::trace::v1::Span& span) const {
+  if (slow_span_threshold_ns_ > 0 && span.end_time_unix_nano() >= span.start_time_unix_nano() &&
+      span.end_time_unix_nano() - span.start_time_unix_nano() >= slow_span_threshold_ns_) {
+    return true;
+  }
+  for (const auto& attribute : span.attributes()) {
+    if (!attribute.value().has_string_value()) {
+      continue;
+    }
+    const std::string& value = attribute.value().string_value();
+    if (!ignore_errors_ && attribute.key() == Tracing::Tags::get().Error &&
+        value == Tracing::Tags::get().True) {
+      return true;
+    }
+    for (const auto& rule : tag_rules_) {
+      if (attribute.key() == rule.name_ && rule.value_.match(value)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+TailSampler::TailSampler(TailSamplingPolicyConstSharedPtr policy, OpenTelemetryTracerStats& stats)
+    : policy_(std::move(policy)), stats_(stats), ring_(policy_->maxBufferedSpans()) {}
+
+bool TailSampler::onSpanFinished(
+    const ::opentelemetry::proto::trace::v1::Span& span,
+    Protobuf::RepeatedPtrField<::opentelemetry::proto::trace::v1::Span>& selected) {
+  if (!selected_traces_.contains(span.trace_id())) {
+    if (!policy_->selects(span)) {
+      BufferedSpan& slot = ring_[next_slot_];
+      if (slot.occupied_) {
+        stats_.tail_sampling_dropped_spans_.inc();
+      }
+      // Copying into the slot reuses the memory of the span it held before.
+      slot.span_ = span;
+      slot.occupied_ = true;
+      next_slot_ = (next_slot_ + 1) % ring_.size();
+      return false;
+    }
+    if (selected_traces_.size() >= ring_.size()) {
+      selected_traces_.clear();
+    }
+    selected_traces_.insert(span.trace_id());
+    stats_.tail_sampling_selected_traces_.inc();
+  }
+  for (auto& slot : ring_) {
+    if (slot.occupied_ && slot.span_.trace_id() == span.trace_id()) {
+      *selected.Add() = std::move(slot.span_);
+      slot.occupied_ = false;
+    }
+  }
+  return true;
+}
+
 Tracer::Tracer(OpenTelemetryTraceExporterPtr exporter, Envoy::TimeSource& time_source,
                Random::RandomGenerator& random, Runtime::Loader& runtime,
                Event::Dispatcher& dispatcher, OpenTelemetryTracerStats tracing_stats,
-               const ResourceConstSharedPtr resource, SamplerSharedPtr sampler)
+               const ResourceConstSharedPtr resource, SamplerSharedPtr sampler,
+               TailSamplingPolicyConstSharedPtr tail_sampling_policy)
     : exporter_(std::move(exporter)), time_source_(time_source), random_(random), runtime_(runtime),
       tracing_stats_(tracing_stats), resource_(resource), sampler_(sampler) {
+  if (tail_sampling_policy) {
+    tail_sampler_ = std::make_unique<TailSampler>(std::move(tail_sampling_policy), tracing_stats_);
+  }
+  initExportRequest();
   flush_timer_ = dispatcher.createTimer([this]() -> void {
     tracing_stats_.timer_flushed_.inc();
     flushSpans();
@@ -143,45 +211,44 @@ void Tracer::enableTimer() {
   flush_timer_->enableTimer(std::chrono::milliseconds(flush_interval));
 }
 
-void Tracer::flushSpans() {
-  ExportTraceServiceRequest request;
+void Tracer::initExportRequest() {
   // A request consists of ResourceSpans.
-  ::opentelemetry::proto::trace::v1::ResourceSpans* resource_span = request.add_resource_spans();
+  ::opentelemetry::proto::trace::v1::ResourceSpans* resource_span =
+      export_request_.add_resource_spans();
   resource_span->set_schema_url(resource_->schema_url_);
 
   // add resource attributes
   for (auto const& att : resource_->attributes_) {
-    opentelemetry::proto::common::v1::KeyValue key_value =
-        opentelemetry::proto::common::v1::KeyValue();
-    opentelemetry::proto::common::v1::AnyValue value_proto =
-        opentelemetry::proto::common::v1::AnyValue();
-    value_proto.set_string_value(std::string{att.second});
-    key_value.set_key(std::string{att.first});
-    *key_value.mutable_value() = value_proto;
-    (*resource_span->mutable_resource()->add_attributes()) = key_value;
+    opentelemetry::proto::common::v1::KeyValue* key_value =
+        resource_span->mutable_resource()->add_attributes();
+    key_value->set_key(std::string{att.first});
+    key_value->mutable_value()->set_string_value(std::string{att.second});
   }
 
-  ::opentelemetry::proto::trace::v1::ScopeSpans* scope_span = resource_span->add_scope_spans();
-  for (const auto& pending_span : span_buffer_) {
-    (*scope_span->add_spans()) = pending_span;
-  }
+  span_buffer_ = resource_span->add_scope_spans();
+}
+
+void Tracer::flushSpans() {
   if (exporter_) {
-    tracing_stats_.spans_sent_.add(span_buffer_.size());
-    if (!exporter_->log(request)) {
+    tracing_stats_.spans_sent_.add(span_buffer_->spans_size());
+    if (!exporter_->log(export_request_)) {
       // TODO: should there be any sort of retry or reporting here?
       ENVOY_LOG(trace, "Unsuccessful log request to OpenTelemetry trace collector.");
     }
   } else {
     ENVOY_LOG(info, "Skipping log request to OpenTelemetry: no exporter configured");
   }
-  span_buffer_.clear();
+  span_buffer_->clear_spans();
 }
 
 void Tracer::sendSpan(::opentelemetry::proto::trace::v1::Span& span) {
-  span_buffer_.push_back(span);
+  if (tail_sampler_ && !tail_sampler_->onSpanFinished(span, *span_buffer_->mutable_spans())) {
+    return;
+  }
+  *span_buffer_->add_spans() = span;
   const uint64_t min_flush_spans =
       runtime_.snapshot().getInteger("tracing.opentelemetry.min_flush_spans", 5U);
-  if (span_buffer_.size() >= min_flush_spans) {
+  if (static_cast<uint64_t>(span_buffer_->spans_size()) >= min_flush_spans) {
     flushSpans();
   }
 }
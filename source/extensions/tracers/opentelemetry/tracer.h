@@ -10,13 +10,16 @@
 #include "envoy/tracing/trace_driver.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/common/matchers.h"
 #include "source/extensions/tracers/common/factory_base.h"
 #include "source/extensions/tracers/opentelemetry/grpc_trace_exporter.h"
 #include "source/extensions/tracers/opentelemetry/resource_detectors/resource_detector.h"
 #include "source/extensions/tracers/opentelemetry/samplers/sampler.h"
 #include "source/extensions/tracers/opentelemetry/span_context.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/escaping.h"
+#include "opentelemetry/proto/collector/trace/v1/trace_service.pb.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -25,12 +28,83 @@ namespace OpenTelemetry {
 
 #define OPENTELEMETRY_TRACER_STATS(COUNTER)                                                        \
   COUNTER(spans_sent)                                                                              \
+  COUNTER(tail_sampling_dropped_spans)                                                             \
+  COUNTER(tail_sampling_selected_traces)                                                           \
   COUNTER(timer_flushed)
 
 struct OpenTelemetryTracerStats {
   OPENTELEMETRY_TRACER_STATS(GENERATE_COUNTER_STRUCT)
 };
 
+/**
+ * Decides which spans select their trace for export when tail sampling is configured. It is shared
+ * by the tail samplers of all workers.
+ */
+class TailSamplingPolicy {
+public:
+  explicit TailSamplingPolicy(
+      const envoy::config::trace::v3::OpenTelemetryConfig::TailSampling& config);
+
+  /**
+   * @return whether the finished span selects its trace for export.
+   */
+  bool selects(const ::opentelemetry::proto::trace::v1::Span& span) const;
+
+  /**
+   * @return the number of spans each worker buffers while their traces are not selected.
+   */
+  uint32_t maxBufferedSpans() const { return max_buffered_spans_; }
+
+private:
+  struct TagRule {
+    std::string name_;
+    Matchers::StringMatcherImpl<envoy::type::matcher::v3::StringMatcher> value_;
+  };
+
+  const uint32_t max_buffered_spans_;
+  // Zero if the duration of spans does not select traces.
+  const uint64_t slow_span_threshold_ns_;
+  const bool ignore_errors_;
+  std::vector<TagRule> tag_rules_;
+};
+
+using TailSamplingPolicyConstSharedPtr = std::shared_ptr<const TailSamplingPolicy>;
+
+/**
+ * The per-worker tail sampling buffer. Finished spans are kept in a fixed size ring until a span
+ * of their trace is selected by the policy, or until they are overwritten by newer spans.
+ */
+class TailSampler {
+public:
+  TailSampler(TailSamplingPolicyConstSharedPtr policy, OpenTelemetryTracerStats& stats);
+
+  /**
+   * Handles a finished span. If the span's trace is selected, the buffered spans of the trace are
+   * moved into selected and true is returned, and the caller exports the span itself. Otherwise
+   * the span is buffered and false is returned.
+   */
+  bool onSpanFinished(
+      const ::opentelemetry::proto::trace::v1::Span& span,
+      Protobuf::RepeatedPtrField<::opentelemetry::proto::trace::v1::Span>& selected);
+
+private:
+  struct BufferedSpan {
+    ::opentelemetry::proto::trace::v1::Span span_;
+    bool occupied_{};
+  };
+
+  const TailSamplingPolicyConstSharedPtr policy_;
+  OpenTelemetryTracerStats& stats_;
+  std::vector<BufferedSpan> ring_;
+  // The slot that the next buffered span is written to.
+  size_t next_slot_{};
+  // The traces selected recently, so that their spans which finish later are exported too. Cleared
+  // when it grows as large as the ring.
+  absl::flat_hash_set<std::string> selected_traces_;
+};
+
+using TailSamplerPtr = std::unique_ptr<TailSampler>;
+
 /**
  * OpenTelemetry Tracer. It is stored in TLS and contains the exporter.
  */
@@ -39,7 +113,7 @@ public:
   Tracer(OpenTelemetryTraceExporterPtr exporter, Envoy::TimeSource& time_source,
          Random::RandomGenerator& random, Runtime::Loader& runtime, Event::Dispatcher& dispatcher,
          OpenTelemetryTracerStats tracing_stats, const ResourceConstSharedPtr resource,
-         SamplerSharedPtr sampler);
+         SamplerSharedPtr sampler, TailSamplingPolicyConstSharedPtr tail_sampling_policy);
 
   void sendSpan(::opentelemetry::proto::trace::v1::Span& span);
 
@@ -63,16 +137,26 @@ private:
    * Removes all spans from the span buffer and sends them to the collector.
    */
   void flushSpans();
+  /**
+   * Builds the parts of the export request which are the same for every flush.
+   */
+  void initExportRequest();
 
   OpenTelemetryTraceExporterPtr exporter_;
   Envoy::TimeSource& time_source_;
   Random::RandomGenerator& random_;
-  std::vector<::opentelemetry::proto::trace::v1::Span> span_buffer_;
+  // The request is built once with the resource, and only its spans are cleared after each flush.
+  // Cleared spans are kept by the repeated field and reused for the following spans, so buffering
+  // a span mostly reuses memory from earlier exports.
+  opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest export_request_;
+  ::opentelemetry::proto::trace::v1::ScopeSpans* span_buffer_;
   Runtime::Loader& runtime_;
   Event::TimerPtr flush_timer_;
   OpenTelemetryTracerStats tracing_stats_;
   const ResourceConstSharedPtr resource_;
   SamplerSharedPtr sampler_;
+  // Null if tail sampling is not configured.
+  TailSamplerPtr tail_sampler_;
 };
 
 /**
@@ -105,6 +189,9 @@ public:
 
   bool sampled() const { return sampled_; }
 
+  // Unsampled spans are dropped when they finish.
+  bool isRecording() const override { return sampled_; }
+
   std::string getBaggage(absl::string_view /*key*/) override { return EMPTY_STRING; };
   void setBaggage(absl::string_view /*key*/, absl::string_view /*value*/) override{};
 
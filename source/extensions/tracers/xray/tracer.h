@@ -153,6 +153,11 @@ public:
    */
   void setSampled(bool sampled) override { sampled_ = sampled; };
 
+  /**
+   * Spans which are not sampled are not sent to the daemon.
+   */
+  bool isRecording() const override { return sampled_; }
+
   /**
    * Sets the server error as true for the traced operation/request.
    */
@@ -79,6 +79,9 @@ public:
 
   void setSampled(bool sampled) override;
 
+  // Unsampled spans are not reported when they finish.
+  bool isRecording() const override { return span_.sampled(); }
+
   // TODO(#11622): Implement baggage storage for zipkin spans
   void setBaggage(absl::string_view, absl::string_view) override;
   std::string getBaggage(absl::string_view) override;
@@ -54,7 +54,8 @@ UpstreamTapSocketConfigFactory::createTransportSocketFactory(
       std::make_unique<SocketTapConfigFactoryImpl>(
           server_context.mainThreadDispatcher().timeSource(), context),
       server_context.admin(), server_context.singletonManager(), server_context.threadLocal(),
-      server_context.mainThreadDispatcher(), std::move(inner_transport_factory));
+      server_context.mainThreadDispatcher(), server_context.api().randomGenerator(),
+      std::move(inner_transport_factory));
 }
 
 Network::DownstreamTransportSocketFactoryPtr
@@ -77,7 +78,8 @@ DownstreamTapSocketConfigFactory::createTransportSocketFactory(
       std::make_unique<SocketTapConfigFactoryImpl>(
           server_context.mainThreadDispatcher().timeSource(), context),
       server_context.admin(), server_context.singletonManager(), server_context.threadLocal(),
-      server_context.mainThreadDispatcher(), std::move(inner_transport_factory));
+      server_context.mainThreadDispatcher(), server_context.api().randomGenerator(),
+      std::move(inner_transport_factory));
 }
 
 ProtobufTypes::MessagePtr TapSocketConfigFactory::createEmptyConfigProto() {
@@ -3,6 +3,7 @@
 #include "envoy/extensions/transport_sockets/tap/v3/tap.pb.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/protobuf/utility.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -37,28 +38,48 @@ Network::IoResult TapSocket::doRead(Buffer::Instance& buffer) {
 }
 
 Network::IoResult TapSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
+  if (tapper_ == nullptr || !tapper_->tappingWrites()) {
+    return transport_socket_->doWrite(buffer, end_stream);
+  }
+
   // TODO(htuch): avoid copy.
   Buffer::OwnedImpl copy(buffer);
   Network::IoResult result = transport_socket_->doWrite(buffer, end_stream);
-  if (tapper_ != nullptr && result.bytes_processed_ > 0) {
+  if (result.bytes_processed_ > 0) {
     tapper_->onWrite(copy, result.bytes_processed_, end_stream);
   }
   return result;
 }
 
+ConnectionSampler::ConnectionSampler(
+    const envoy::extensions::transport_sockets::tap::v3::Tap& proto_config,
+    Random::RandomGenerator& random)
+    : sampling_(proto_config.has_sampling()
+                    ? absl::make_optional(proto_config.sampling())
+                    : absl::nullopt),
+      random_(random) {}
+
+bool ConnectionSampler::sampled() const {
+  return !sampling_.has_value() ||
+         ProtobufPercentHelper::evaluateFractionalPercent(sampling_.value(), random_.random());
+}
+
 TapSocketFactory::TapSocketFactory(
     const envoy::extensions::transport_sockets::tap::v3::Tap& proto_config,
     Common::Tap::TapConfigFactoryPtr&& config_factory, OptRef<Server::Admin> admin,
     Singleton::Manager& singleton_manager, ThreadLocal::SlotAllocator& tls,
-    Event::Dispatcher& main_thread_dispatcher,
+    Event::Dispatcher& main_thread_dispatcher, Random::RandomGenerator& random,
     Network::UpstreamTransportSocketFactoryPtr&& transport_socket_factory)
     : ExtensionConfigBase(proto_config.common_config(), std::move(config_factory), admin,
                           singleton_manager, tls, main_thread_dispatcher),
-      PassthroughFactory(std::move(transport_socket_factory)) {}
+      PassthroughFactory(std::move(transport_socket_factory)), sampler_(proto_config, random) {}
 
 Network::TransportSocketPtr
 TapSocketFactory::createTransportSocket(Network::TransportSocketOptionsConstSharedPtr options,
                                         Upstream::HostDescriptionConstSharedPtr host) const {
+  if (!sampler_.sampled()) {
+    return transport_socket_factory_->createTransportSocket(options, host);
+  }
   return std::make_unique<TapSocket>(
       currentConfigHelper<SocketTapConfig>(),
       transport_socket_factory_->createTransportSocket(options, host));
@@ -68,13 +89,17 @@ DownstreamTapSocketFactory::DownstreamTapSocketFactory(
     const envoy::extensions::transport_sockets::tap::v3::Tap& proto_config,
     Common::Tap::TapConfigFactoryPtr&& config_factory, OptRef<Server::Admin> admin,
     Singleton::Manager& singleton_manager, ThreadLocal::SlotAllocator& tls,
-    Event::Dispatcher& main_thread_dispatcher,
+    Event::Dispatcher& main_thread_dispatcher, Random::RandomGenerator& random,
     Network::DownstreamTransportSocketFactoryPtr&& transport_socket_factory)
     : ExtensionConfigBase(proto_config.common_config(), std::move(config_factory), admin,
                           singleton_manager, tls, main_thread_dispatcher),
-      DownstreamPassthroughFactory(std::move(transport_socket_factory)) {}
+      DownstreamPassthroughFactory(std::move(transport_socket_factory)),
+      sampler_(proto_config, random) {}
 
 Network::TransportSocketPtr DownstreamTapSocketFactory::createDownstreamTransportSocket() const {
+  if (!sampler_.sampled()) {
+    return transport_socket_factory_->createDownstreamTransportSocket();
+  }
   return std::make_unique<TapSocket>(currentConfigHelper<SocketTapConfig>(),
                                      transport_socket_factory_->createDownstreamTransportSocket());
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "envoy/common/random_generator.h"
 #include "envoy/event/timer.h"
 #include "envoy/extensions/transport_sockets/tap/v3/tap.pb.h"
 #include "envoy/network/transport_socket.h"
@@ -28,18 +29,39 @@ private:
   PerSocketTapperPtr tapper_;
 };
 
+/**
+ * Decides which connections are tapped, according to the sampling of the tap configuration.
+ */
+class ConnectionSampler {
+public:
+  ConnectionSampler(const envoy::extensions::transport_sockets::tap::v3::Tap& proto_config,
+                    Random::RandomGenerator& random);
+
+  /**
+   * @return whether a new connection is tapped.
+   */
+  bool sampled() const;
+
+private:
+  const absl::optional<envoy::type::v3::FractionalPercent> sampling_;
+  Random::RandomGenerator& random_;
+};
+
 class TapSocketFactory : public Common::Tap::ExtensionConfigBase, public PassthroughFactory {
 public:
   TapSocketFactory(const envoy::extensions::transport_sockets::tap::v3::Tap& proto_config,
                    Common::Tap::TapConfigFactoryPtr&& config_factory, OptRef<Server::Admin> admin,
                    Singleton::Manager& singleton_manager, ThreadLocal::SlotAllocator& tls,
-                   Event::Dispatcher& main_thread_dispatcher,
+                   Event::Dispatcher& main_thread_dispatcher, Random::RandomGenerator& random,
                    Network::UpstreamTransportSocketFactoryPtr&& transport_socket_factory);
 
   // Network::UpstreamTransportSocketFactory
   Network::TransportSocketPtr
   createTransportSocket(Network::TransportSocketOptionsConstSharedPtr options,
                         Upstream::HostDescriptionConstSharedPtr host) const override;
+
+private:
+  const ConnectionSampler sampler_;
 };
 
 class DownstreamTapSocketFactory : public Common::Tap::ExtensionConfigBase,
@@ -49,11 +71,14 @@ public:
       const envoy::extensions::transport_sockets::tap::v3::Tap& proto_config,
       Common::Tap::TapConfigFactoryPtr&& config_factory, OptRef<Server::Admin> admin,
       Singleton::Manager& singleton_manager, ThreadLocal::SlotAllocator& tls,
-      Event::Dispatcher& main_thread_dispatcher,
+      Event::Dispatcher& main_thread_dispatcher, Random::RandomGenerator& random,
       Network::DownstreamTransportSocketFactoryPtr&& transport_socket_factory);
 
   // Network::UpstreamTransportSocketFactory
   Network::TransportSocketPtr createDownstreamTransportSocket() const override;
+
+private:
+  const ConnectionSampler sampler_;
 };
 
 } // namespace Tap
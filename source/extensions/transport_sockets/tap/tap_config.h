@@ -38,6 +38,12 @@ public:
    * @param end_stream supplies whether this is the end of socket writes.
    */
   virtual void onWrite(const Buffer::Instance& data, uint32_t bytes_written, bool end_stream) PURE;
+
+  /**
+   * @return whether onWrite() may still record written data. If not, the socket does not need to
+   *         keep a copy of the data it writes.
+   */
+  virtual bool tappingWrites() const PURE;
 };
 
 using PerSocketTapperPtr = std::unique_ptr<PerSocketTapper>;
@@ -100,6 +100,14 @@ void PerSocketTapperImpl::onRead(const Buffer::Instance& data, uint32_t bytes_re
   }
 }
 
+bool PerSocketTapperImpl::tappingWrites() const {
+  if (!config_->rootMatcher().matchStatus(statuses_).matches_) {
+    return false;
+  }
+  return config_->streaming() || buffered_trace_ == nullptr ||
+         !buffered_trace_->socket_buffered_trace().write_truncated();
+}
+
 void PerSocketTapperImpl::onWrite(const Buffer::Instance& data, uint32_t bytes_written,
                                   bool end_stream) {
   if (!config_->rootMatcher().matchStatus(statuses_).matches_) {
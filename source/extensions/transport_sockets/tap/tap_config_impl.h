@@ -21,6 +21,7 @@ public:
   void closeSocket(Network::ConnectionEvent event) override;
   void onRead(const Buffer::Instance& data, uint32_t bytes_read) override;
   void onWrite(const Buffer::Instance& data, uint32_t bytes_written, bool end_stream) override;
+  bool tappingWrites() const override;
 
 private:
   void initEvent(envoy::data::tap::v3::SocketEvent&);
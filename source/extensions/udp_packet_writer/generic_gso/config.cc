@@ -0,0 +1,28 @@
+#include "source/extensions/udp_packet_writer/generic_gso/config.h"
+
+#include "envoy/extensions/udp_packet_writer/v3/udp_generic_gso_batch_writer_factory.pb.validate.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/udp_packet_writer/generic_gso/udp_generic_gso_batch_writer.h"
+
+namespace Envoy {
+namespace Network {
+
+UdpPacketWriterFactoryPtr UdpGenericGsoBatchWriterFactoryFactory::createUdpPacketWriterFactory(
+    const envoy::config::core::v3::TypedExtensionConfig& config) {
+  const auto writer_config = MessageUtil::anyConvertAndValidate<
+      envoy::extensions::udp_packet_writer::v3::UdpGenericGsoBatchWriterFactory>(
+      config.typed_config(), ProtobufMessage::getStrictValidationVisitor());
+  if (!Api::OsSysCallsSingleton::get().supportsUdpGso()) {
+    throwEnvoyExceptionOrPanic("UDP generic segmentation offload is not supported on this host.");
+  }
+  return std::make_unique<UdpGenericGsoBatchWriterFactory>(
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(writer_config, max_segments, 64));
+}
+
+REGISTER_FACTORY(UdpGenericGsoBatchWriterFactoryFactory, UdpPacketWriterFactoryFactory);
+
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "envoy/extensions/udp_packet_writer/v3/udp_generic_gso_batch_writer_factory.pb.h"
+#include "envoy/network/udp_packet_writer_handler.h"
+#include "envoy/registry/registry.h"
+
+namespace Envoy {
+namespace Network {
+
+class UdpGenericGsoBatchWriterFactoryFactory : public Network::UdpPacketWriterFactoryFactory {
+public:
+  std::string name() const override { return "envoy.udp_packet_writer.generic_gso"; }
+  UdpPacketWriterFactoryPtr createUdpPacketWriterFactory(
+      const envoy::config::core::v3::TypedExtensionConfig& config) override;
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<
+        envoy::extensions::udp_packet_writer::v3::UdpGenericGsoBatchWriterFactory>();
+  }
+};
+
+DECLARE_FACTORY(UdpGenericGsoBatchWriterFactoryFactory);
+
+} // namespace Network
+} // namespace Envoy
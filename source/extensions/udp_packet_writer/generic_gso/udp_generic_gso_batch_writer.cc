@@ -0,0 +1,206 @@
+#include "source/extensions/udp_packet_writer/generic_gso/udp_generic_gso_batch_writer.h"
+
+#include <cstring>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/safe_memcpy.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/network/io_socket_error_impl.h"
+
+namespace Envoy {
+namespace Network {
+
+UdpGenericGsoBatchWriter::UdpGenericGsoBatchWriter(IoHandle& io_handle, Stats::Scope& scope,
+                                                   uint32_t max_segments)
+    : io_handle_(io_handle), max_segments_(max_segments),
+      stats_({UDP_GENERIC_GSO_BATCH_WRITER_STATS(POOL_COUNTER(scope), POOL_GAUGE(scope),
+                                                 POOL_HISTOGRAM(scope))}) {
+  batch_.reserve(MaxBatchSize);
+}
+
+Api::IoCallUint64Result
+UdpGenericGsoBatchWriter::writePacket(const Buffer::Instance& buffer, const Address::Ip* local_ip,
+                                      const Address::Instance& peer_address) {
+  if (write_blocked_) {
+    return {/*rc=*/0, IoSocketError::getIoSocketEagainError()};
+  }
+  const auto* address_base = dynamic_cast<const Address::InstanceBase*>(&peer_address);
+  const sockaddr* sock_addr = address_base != nullptr ? address_base->sockAddr() : nullptr;
+  if (sock_addr == nullptr || peer_address.ip() == nullptr) {
+    return IoSocketError::ioResultSocketInvalidAddress();
+  }
+  const socklen_t sock_addr_length = address_base->sockAddrLen();
+  const absl::optional<LocalIp> self_ip = toLocalIp(local_ip);
+  const uint64_t length = buffer.length();
+
+  if (!batch_.empty() && !canAppend(length, self_ip, sock_addr, sock_addr_length)) {
+    Api::IoCallUint64Result result = flush();
+    if (!result.ok()) {
+      return result;
+    }
+  }
+
+  if (length > MaxBatchSize) {
+    // Too large to be buffered, the batch was flushed above.
+    const Buffer::RawSliceVector slices = buffer.getRawSlices();
+    ASSERT(!slices.empty());
+    if (slices.size() == 1) {
+      return send(slices[0].mem_, length, self_ip, sock_addr, sock_addr_length, 0);
+    }
+    std::vector<uint8_t> data(length);
+    buffer.copyOut(0, length, data.data());
+    return send(data.data(), length, self_ip, sock_addr, sock_addr_length, 0);
+  }
+
+  if (batch_.empty()) {
+    segment_size_ = length;
+    local_ip_ = self_ip;
+    if (sock_addr->sa_family == AF_INET) {
+      safeMemcpyUnsafeSrc(reinterpret_cast<sockaddr_in*>(&peer_address_), sock_addr);
+    } else {
+      ASSERT(sock_addr->sa_family == AF_INET6);
+      safeMemcpyUnsafeSrc(reinterpret_cast<sockaddr_in6*>(&peer_address_), sock_addr);
+    }
+    peer_address_length_ = sock_addr_length;
+  }
+  const uint64_t offset = batch_.size();
+  batch_.resize(offset + length);
+  buffer.copyOut(0, length, batch_.data() + offset);
+  ++segments_;
+  stats_.internal_buffer_size_.set(batch_.size());
+
+  // Only the last segment of a batch may be shorter than the others.
+  if (length < segment_size_ || segments_ >= max_segments_) {
+    Api::IoCallUint64Result result = flush();
+    if (!result.ok() && !write_blocked_) {
+      return result;
+    }
+    // Otherwise the datagram was either written or is buffered until the socket is writable.
+  }
+  return {length, Api::IoError::none()};
+}
+
+Api::IoCallUint64Result UdpGenericGsoBatchWriter::flush() {
+  if (batch_.empty()) {
+    return {/*rc=*/0, Api::IoError::none()};
+  }
+  Api::IoCallUint64Result result =
+      send(batch_.data(), batch_.size(), local_ip_,
+           reinterpret_cast<const sockaddr*>(&peer_address_), peer_address_length_,
+           segments_ > 1 ? static_cast<uint16_t>(segment_size_) : 0);
+  if (!result.ok() && write_blocked_) {
+    // Keep the batch until the socket is writable again.
+    return result;
+  }
+  if (result.ok()) {
+    stats_.pkts_sent_per_batch_.recordValue(segments_);
+  }
+  // The batch is dropped on other errors, as a single datagram would be.
+  batch_.clear();
+  segments_ = 0;
+  stats_.internal_buffer_size_.set(0);
+  if (!result.ok()) {
+    return result;
+  }
+  return {/*rc=*/0, Api::IoError::none()};
+}
+
+absl::optional<UdpGenericGsoBatchWriter::LocalIp>
+UdpGenericGsoBatchWriter::toLocalIp(const Address::Ip* local_ip) {
+  if (local_ip == nullptr) {
+    return absl::nullopt;
+  }
+  LocalIp self_ip{local_ip->version()};
+  if (local_ip->version() == Address::IpVersion::v4) {
+    self_ip.ipv4_ = local_ip->ipv4()->address();
+  } else {
+    self_ip.ipv6_ = local_ip->ipv6()->address();
+  }
+  return self_ip;
+}
+
+bool UdpGenericGsoBatchWriter::canAppend(uint64_t length, const absl::optional<LocalIp>& local_ip,
+                                         const sockaddr* peer_address,
+                                         socklen_t peer_address_length) const {
+  return length <= segment_size_ && batch_.size() + length <= MaxBatchSize &&
+         local_ip == local_ip_ && peer_address_length == peer_address_length_ &&
+         memcmp(peer_address, &peer_address_, peer_address_length) == 0;
+}
+
+Api::IoCallUint64Result UdpGenericGsoBatchWriter::send(const void* data, uint64_t length,
+                                                       const absl::optional<LocalIp>& local_ip,
+                                                       const sockaddr* peer_address,
+                                                       socklen_t peer_address_length,
+                                                       uint16_t segment_size) {
+  iovec iov;
+  iov.iov_base = const_cast<void*>(data);
+  iov.iov_len = length;
+
+  msghdr message;
+  message.msg_name = const_cast<sockaddr*>(peer_address);
+  message.msg_namelen = peer_address_length;
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_flags = 0;
+
+  // Large enough for the packet info of either IP version and the segment size.
+  constexpr size_t cmsg_space = CMSG_SPACE(sizeof(in6_pktinfo)) + CMSG_SPACE(sizeof(uint16_t));
+  alignas(cmsghdr) char cbuf[cmsg_space];
+  memset(cbuf, 0, cmsg_space);
+  message.msg_control = cbuf;
+  message.msg_controllen = cmsg_space;
+  size_t controllen = 0;
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+
+  if (local_ip.has_value()) {
+    if (local_ip->version_ == Address::IpVersion::v4) {
+      cmsg->cmsg_level = IPPROTO_IP;
+      cmsg->cmsg_type = IP_PKTINFO;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+      auto pktinfo = reinterpret_cast<in_pktinfo*>(CMSG_DATA(cmsg));
+      pktinfo->ipi_ifindex = 0;
+#ifdef WIN32
+      pktinfo->ipi_addr.s_addr = local_ip->ipv4_;
+#else
+      pktinfo->ipi_spec_dst.s_addr = local_ip->ipv4_;
+#endif
+      controllen += CMSG_SPACE(sizeof(in_pktinfo));
+    } else {
+      cmsg->cmsg_level = IPPROTO_IPV6;
+      cmsg->cmsg_type = IPV6_PKTINFO;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(in6_pktinfo));
+      auto pktinfo = reinterpret_cast<in6_pktinfo*>(CMSG_DATA(cmsg));
+      pktinfo->ipi6_ifindex = 0;
+      *(reinterpret_cast<absl::uint128*>(pktinfo->ipi6_addr.s6_addr)) = local_ip->ipv6_;
+      controllen += CMSG_SPACE(sizeof(in6_pktinfo));
+    }
+    cmsg = CMSG_NXTHDR(&message, cmsg);
+  }
+  if (segment_size > 0) {
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    safeMemcpyUnsafeDst(CMSG_DATA(cmsg), &segment_size);
+    controllen += CMSG_SPACE(sizeof(uint16_t));
+  }
+  message.msg_controllen = controllen;
+  if (controllen == 0) {
+    message.msg_control = nullptr;
+  }
+
+  const Api::SysCallSizeResult result =
+      Api::OsSysCallsSingleton::get().sendmsg(io_handle_.fdDoNotUse(), &message, 0);
+  if (result.return_value_ < 0) {
+    if (result.errno_ == SOCKET_ERROR_AGAIN) {
+      write_blocked_ = true;
+      return {/*rc=*/0, IoSocketError::getIoSocketEagainError()};
+    }
+    return {/*rc=*/0, IoSocketError::create(result.errno_)};
+  }
+  stats_.total_bytes_sent_.add(result.return_value_);
+  return {static_cast<uint64_t>(result.return_value_), Api::IoError::none()};
+}
+
+} // namespace Network
+} // namespace Envoy
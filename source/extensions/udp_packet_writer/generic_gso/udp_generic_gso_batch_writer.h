@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "envoy/common/platform.h"
+#include "envoy/network/io_handle.h"
+#include "envoy/network/udp_packet_writer_handler.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "absl/numeric/int128.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * All UDP generic GSO batch writer stats. @see stats_macros.h
+ *
+ * @total_bytes_sent: bytes written to the socket.
+ * @internal_buffer_size: bytes buffered and not written yet.
+ * @pkts_sent_per_batch: datagrams written by each call to the socket.
+ */
+#define UDP_GENERIC_GSO_BATCH_WRITER_STATS(COUNTER, GAUGE, HISTOGRAM)                              \
+  COUNTER(total_bytes_sent)                                                                        \
+  GAUGE(internal_buffer_size, NeverImport)                                                         \
+  HISTOGRAM(pkts_sent_per_batch, Unspecified)
+
+/**
+ * Struct definition for all UDP generic GSO batch writer stats. @see stats_macros.h
+ */
+struct UdpGenericGsoBatchWriterStats {
+  UDP_GENERIC_GSO_BATCH_WRITER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT,
+                                     GENERATE_HISTOGRAM_STRUCT)
+};
+
+/**
+ * UdpPacketWriter buffering consecutive datagrams of the same size sent to the same peer from the
+ * same local address, and writing them with a single sendmsg() using UDP generic segmentation
+ * offload. The batch is written when a datagram which cannot be appended to it is sent, when a
+ * datagram shorter than the previous ones ends it, when it is full, or on flush().
+ */
+class UdpGenericGsoBatchWriter : public UdpPacketWriter {
+public:
+  UdpGenericGsoBatchWriter(IoHandle& io_handle, Stats::Scope& scope, uint32_t max_segments);
+
+  // UdpPacketWriter
+  Api::IoCallUint64Result writePacket(const Buffer::Instance& buffer, const Address::Ip* local_ip,
+                                      const Address::Instance& peer_address) override;
+  bool isWriteBlocked() const override { return write_blocked_; }
+  void setWritable() override { write_blocked_ = false; }
+  uint64_t getMaxPacketSize(const Address::Instance&) const override {
+    return UdpMaxOutgoingPacketSize;
+  }
+  bool isBatchMode() const override { return true; }
+  UdpPacketWriterBuffer getNextWriteLocation(const Address::Ip*,
+                                             const Address::Instance&) override {
+    return {nullptr, 0, nullptr};
+  }
+  Api::IoCallUint64Result flush() override;
+
+  // The largest batch written at once, below the 64KiB limit of a datagram including its headers.
+  static constexpr uint64_t MaxBatchSize = 63 * 1024;
+
+private:
+  // The local address a datagram is sent from, if any.
+  struct LocalIp {
+    bool operator==(const LocalIp& other) const {
+      return version_ == other.version_ && ipv4_ == other.ipv4_ && ipv6_ == other.ipv6_;
+    }
+
+    Address::IpVersion version_;
+    uint32_t ipv4_{};
+    absl::uint128 ipv6_{};
+  };
+
+  static absl::optional<LocalIp> toLocalIp(const Address::Ip* local_ip);
+  bool canAppend(uint64_t length, const absl::optional<LocalIp>& local_ip,
+                 const sockaddr* peer_address, socklen_t peer_address_length) const;
+  Api::IoCallUint64Result send(const void* data, uint64_t length,
+                               const absl::optional<LocalIp>& local_ip,
+                               const sockaddr* peer_address, socklen_t peer_address_length,
+                               uint16_t segment_size);
+
+  IoHandle& io_handle_;
+  const uint32_t max_segments_;
+  UdpGenericGsoBatchWriterStats stats_;
+  bool write_blocked_{};
+
+  // The current batch.
+  std::vector<uint8_t> batch_;
+  uint64_t segment_size_{};
+  uint32_t segments_{};
+  absl::optional<LocalIp> local_ip_;
+  sockaddr_storage peer_address_{};
+  socklen_t peer_address_length_{};
+};
+
+class UdpGenericGsoBatchWriterFactory : public UdpPacketWriterFactory {
+public:
+  explicit UdpGenericGsoBatchWriterFactory(uint32_t max_segments) : max_segments_(max_segments) {}
+
+  // UdpPacketWriterFactory
+  UdpPacketWriterPtr createUdpPacketWriter(IoHandle& io_handle, Stats::Scope& scope) override {
+    return std::make_unique<UdpGenericGsoBatchWriter>(io_handle, scope, max_segments_);
+  }
+
+private:
+  const uint32_t max_segments_;
+};
+
+} // namespace Network
+} // namespace Envoy
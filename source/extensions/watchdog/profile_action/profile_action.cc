@@ -2,12 +2,15 @@
 
 #include <chrono>
 
+#include "envoy/filesystem/filesystem.h"
 #include "envoy/thread/thread.h"
 
+#include "source/common/common/mutex_tracer_impl.h"
 #include "source/common/profiler/profiler.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 
 namespace Envoy {
@@ -33,6 +36,7 @@ ProfileAction::ProfileAction(
       duration_(
           std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(config, profile_duration, 5000))),
       max_profiles_(config.max_profiles() == 0 ? DefaultMaxProfiles : config.max_profiles()),
+      mutex_tracer_(config.mutex_contention() ? &MutexTracerImpl::getOrCreateTracer() : nullptr),
       profiles_attempted_(context.stats_.counterFromStatName(
           Stats::StatNameManagedStorage(
               absl::StrCat(context.guarddog_name_, ".profile_action.attempted"),
@@ -47,6 +51,7 @@ ProfileAction::ProfileAction(
         if (Profiler::Cpu::profilerEnabled()) {
           Profiler::Cpu::stopProfiler();
           running_profile_ = false;
+          writeMutexContention();
         } else {
           ENVOY_LOG_MISC(error,
                          "Profile Action's stop() was scheduled, but profiler isn't running!");
@@ -96,6 +101,10 @@ void ProfileAction::run(
       // Update state
       running_profile_ = true;
       ++profiles_started_;
+      if (mutex_tracer_ != nullptr) {
+        contentions_at_start_ = mutex_tracer_->numContentions();
+        wait_cycles_at_start_ = mutex_tracer_->lifetimeWaitCycles();
+      }
 
       // Schedule callback to stop
       timer_cb_->enableTimer(duration_);
@@ -107,6 +116,26 @@ void ProfileAction::run(
   }
 }
 
+void ProfileAction::writeMutexContention() {
+  if (mutex_tracer_ == nullptr) {
+    return;
+  }
+  static constexpr Filesystem::FlagSet DefaultFlags{1 << Filesystem::File::Operation::Write |
+                                                    1 << Filesystem::File::Operation::Create};
+  const std::string filename = absl::StrCat(profile_filename_, ".contention");
+  Filesystem::FilePathAndType file_info{Filesystem::DestinationType::File, filename};
+  auto file = context_.api_.fileSystem().createFile(file_info);
+  if (!file || !file->open(DefaultFlags).return_value_) {
+    ENVOY_LOG_MISC(error, "Profile Action failed to write mutex contention to {}.", filename);
+    return;
+  }
+  file->write(absl::StrCat(
+      "num_contentions: ", mutex_tracer_->numContentions() - contentions_at_start_, "\n",
+      "lifetime_wait_cycles: ", mutex_tracer_->lifetimeWaitCycles() - wait_cycles_at_start_, "\n",
+      "current_wait_cycles: ", mutex_tracer_->currentWaitCycles(), "\n"));
+  file->close();
+}
+
 } // namespace ProfileAction
 } // namespace Watchdog
 } // namespace Extensions
@@ -2,6 +2,7 @@
 
 #include <chrono>
 
+#include "envoy/common/mutex_tracer.h"
 #include "envoy/extensions/watchdog/profile_action/v3/profile_action.pb.h"
 #include "envoy/server/guarddog_config.h"
 #include "envoy/thread/thread.h"
@@ -14,7 +15,8 @@ namespace Watchdog {
 namespace ProfileAction {
 
 /**
- * A GuardDogAction that will start CPU profiling.
+ * A GuardDogAction that will start CPU profiling, and optionally record the mutex contention seen
+ * while profiling.
  */
 class ProfileAction : public Server::Configuration::GuardDogAction {
 public:
@@ -26,9 +28,15 @@ public:
            MonotonicTime now) override;
 
 private:
+  // Writes the mutex contention seen since the profile started, if it is recorded.
+  void writeMutexContention();
+
   const std::string path_;
   const std::chrono::milliseconds duration_;
   const uint64_t max_profiles_;
+  MutexTracer* const mutex_tracer_;
+  int64_t contentions_at_start_ = 0;
+  int64_t wait_cycles_at_start_ = 0;
   bool running_profile_ = false;
   std::string profile_filename_;
   Stats::Counter& profiles_attempted_;
@@ -3,6 +3,7 @@
 #include "envoy/config/core/v3/health_check.pb.h"
 #include "envoy/config/endpoint/v3/endpoint.pb.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/matchers.h"
 #include "source/common/common/regex.h"
 #include "source/common/common/statusor.h"
@@ -142,6 +143,19 @@ buildNameMatcher(const Http::Utility::QueryParamsMulti& params) {
   }
 }
 
+// Hands the serialized dump over to the response without copying it, so that a large dump is not
+// held twice.
+void moveToResponse(std::string&& data, Buffer::Instance& response) {
+  auto* owned_data = new std::string(std::move(data));
+  auto* fragment = new Buffer::BufferFragmentImpl(
+      owned_data->data(), owned_data->size(),
+      [owned_data](const void*, size_t, const Buffer::BufferFragmentImpl* fragment) {
+        delete owned_data;
+        delete fragment;
+      });
+  response.addBufferFragment(*fragment);
+}
+
 } // namespace
 
 ConfigDumpHandler::ConfigDumpHandler(ConfigTracker& config_tracker, Server::Instance& server)
@@ -160,6 +174,12 @@ Http::Code ConfigDumpHandler::handlerConfigDump(Http::ResponseHeaderMap& respons
     response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Text);
     return Http::Code::BadRequest;
   }
+  const std::string format = query_params.getFirstValue("format").value_or("json");
+  if (format != "json" && format != "proto") {
+    response.add(fmt::format("Unsupported format: {}", format));
+    response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Text);
+    return Http::Code::BadRequest;
+  }
 
   envoy::admin::v3::ConfigDump dump;
 
@@ -176,10 +196,16 @@ Http::Code ConfigDumpHandler::handlerConfigDump(Http::ResponseHeaderMap& respons
     response.add(err.value().second);
     return err.value().first;
   }
-  MessageUtil::redact(dump);
 
-  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
-  response.add(MessageUtil::getJsonStringFromMessageOrError(dump, true)); // pretty-print
+  // The configs were redacted as they were added to the dump.
+  if (format == "proto") {
+    response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Protobuf);
+    moveToResponse(dump.SerializeAsString(), response);
+  } else {
+    response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+    moveToResponse(MessageUtil::getJsonStringFromMessageOrError(dump, true), // pretty-print
+                   response);
+  }
   return Http::Code::OK;
 }
 
@@ -214,8 +240,9 @@ absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addResourc
                       field_descriptor->name(), field_descriptor->name()))};
     }
 
-    auto repeated = reflection->GetRepeatedPtrField<Protobuf::Message>(*message, field_descriptor);
-    for (Protobuf::Message& msg : repeated) {
+    auto* repeated =
+        reflection->MutableRepeatedPtrField<Protobuf::Message>(message.get(), field_descriptor);
+    for (Protobuf::Message& msg : *repeated) {
       if (mask.has_value()) {
         Protobuf::FieldMask field_mask;
         ProtobufUtil::FieldMaskUtil::FromString(mask.value(), &field_mask);
@@ -225,6 +252,7 @@ absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addResourc
                                                    " could not be successfully used."))};
         }
       }
+      MessageUtil::redact(msg);
       auto* config = dump.add_configs();
       config->PackFrom(msg);
     }
@@ -269,6 +297,7 @@ absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addAllConf
       }
     }
 
+    MessageUtil::redact(*message);
     auto* config = dump.add_configs();
     config->PackFrom(*message);
   }
@@ -128,150 +128,167 @@ std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
   return output;
 };
 
-/**
- * Processes a stat type (counter, gauge, histogram) by generating all output lines, sorting
- * them by tag-extracted metric name, and then outputting them in the correct sorted order into
- * response.
+/*
+ * From
+ * https:*github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
  *
- * @param response The buffer to put the output into.
- * @param used_only Whether to only output stats that are used.
- * @param regex A filter on which stats to output.
- * @param metrics The metrics to output stats for. This must contain all stats of the given type
- *        to be included in the same output.
- * @param generate_output A function which returns the output text for this metric.
- * @param type The name of the prometheus metric type for used in TYPE annotations.
+ * All lines for a given metric must be provided as one single group, with the optional HELP and
+ * TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
+ * expositions is preferred but not required, i.e. do not sort if the computational cost is
+ * prohibitive.
+ *
+ * The groups below are sorted by tag-extracted metric name. Each group is an unsorted collection
+ * of dumb-pointers (no need to increment then decrement every refcount; ownership is held
+ * throughout by the caller). It is only sorted when the group is rendered to satisfy the
+ * "preferred" ordering from the prometheus spec: metrics will be sorted by their tags' textual
+ * representation, which will be consistent across calls.
  */
-template <class StatType>
-uint64_t outputStatType(
-    Buffer::Instance& response, const StatsParams& params,
-    const std::vector<Stats::RefcountPtr<StatType>>& metrics,
-    const std::function<std::string(
-        const StatType& metric, const std::string& prefixed_tag_extracted_name)>& generate_output,
-    absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces) {
-
-  /*
-   * From
-   * https:*github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
-   *
-   * All lines for a given metric must be provided as one single group, with the optional HELP and
-   * TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
-   * expositions is preferred but not required, i.e. do not sort if the computational cost is
-   * prohibitive.
-   */
 
-  // This is an unsorted collection of dumb-pointers (no need to increment then decrement every
-  // refcount; ownership is held throughout by `metrics`). It is unsorted for efficiency, but will
-  // be sorted before producing the final output to satisfy the "preferred" ordering from the
-  // prometheus spec: metrics will be sorted by their tags' textual representation, which will be
-  // consistent across calls.
-  using StatTypeUnsortedCollection = std::vector<const StatType*>;
+/**
+ * Groups of a stat type (counter, gauge, text readout, histogram).
+ */
+template <class StatType> class MetricGroups : public PrometheusStatsFormatter::Groups {
+public:
+  using GenerateOutputFn = std::function<std::string(
+      const StatType& metric, const std::string& prefixed_tag_extracted_name)>;
+
+  /**
+   * @param symbol_table the symbol table of all of the metrics.
+   * @param params the parameters used to filter the metrics.
+   * @param metrics The metrics to output stats for. This must contain all stats of the given type
+   *        to be included in the same output, and must outlive the groups.
+   * @param generate_output A function which returns the output text for this metric.
+   * @param type The name of the prometheus metric type for used in TYPE annotations.
+   */
+  MetricGroups(const Stats::SymbolTable& symbol_table, const StatsParams& params,
+               const std::vector<Stats::RefcountPtr<StatType>>& metrics,
+               GenerateOutputFn generate_output, absl::string_view type,
+               const Stats::CustomStatNamespaces& custom_namespaces)
+      : symbol_table_(symbol_table), groups_(symbol_table),
+        generate_output_(std::move(generate_output)), type_(type),
+        custom_namespaces_(custom_namespaces) {
+    for (const auto& metric : metrics) {
+      // There should only be one symbol table for all of the stats in the admin
+      // interface. If this assumption changes, the name comparisons in this class
+      // will have to change to compare to convert all StatNames to strings before
+      // comparison.
+      ASSERT(&symbol_table_ == &metric->constSymbolTable());
+      if (!params.shouldShowMetric(*metric)) {
+        continue;
+      }
+      groups_[metric->tagExtractedStatName()].push_back(metric.get());
+    }
+  }
 
-  // Return early to avoid crashing when getting the symbol table from the first metric.
-  if (metrics.empty()) {
-    return 0;
+  // PrometheusStatsFormatter::Groups
+  bool empty() const override { return groups_.empty(); }
+  bool renderNextGroup(Buffer::Instance& response) override {
+    auto group = groups_.begin();
+    const absl::optional<std::string> prefixed_tag_extracted_name =
+        PrometheusStatsFormatter::metricName(symbol_table_.toString(group->first),
+                                             custom_namespaces_);
+    const bool rendered = prefixed_tag_extracted_name.has_value();
+    if (rendered) {
+      response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type_));
+      std::sort(group->second.begin(), group->second.end(), MetricLessThan());
+      for (const StatType* metric : group->second) {
+        response.add(generate_output_(*metric, prefixed_tag_extracted_name.value()));
+      }
+    }
+    groups_.erase(group);
+    return rendered;
   }
 
-  // There should only be one symbol table for all of the stats in the admin
-  // interface. If this assumption changes, the name comparisons in this function
-  // will have to change to compare to convert all StatNames to strings before
-  // comparison.
-  const Stats::SymbolTable& global_symbol_table = metrics.front()->constSymbolTable();
-
-  // Sorted collection of metrics sorted by their tagExtractedName, to satisfy the requirements
-  // of the exposition format.
-  std::map<Stats::StatName, StatTypeUnsortedCollection, Stats::StatNameLessThan> groups(
-      global_symbol_table);
-
-  for (const auto& metric : metrics) {
-    ASSERT(&global_symbol_table == &metric->constSymbolTable());
-    if (!params.shouldShowMetric(*metric)) {
-      continue;
+private:
+  const Stats::SymbolTable& symbol_table_;
+  std::map<Stats::StatName, std::vector<const StatType*>, Stats::StatNameLessThan> groups_;
+  const GenerateOutputFn generate_output_;
+  const absl::string_view type_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+};
+
+/**
+ * Groups of a primitive stat type (host counter, host gauge).
+ */
+template <class StatType> class PrimitiveMetricGroups : public PrometheusStatsFormatter::Groups {
+public:
+  /**
+   * @param params the parameters used to filter the metrics.
+   * @param metrics The metrics to output stats for, which must outlive the groups.
+   * @param type The name of the prometheus metric type for used in TYPE annotations.
+   */
+  PrimitiveMetricGroups(const StatsParams& params, const std::vector<StatType>& metrics,
+                        absl::string_view type,
+                        const Stats::CustomStatNamespaces& custom_namespaces)
+      : type_(type), custom_namespaces_(custom_namespaces) {
+    for (const auto& metric : metrics) {
+      if (!params.shouldShowMetric(metric)) {
+        continue;
+      }
+      groups_[metric.tagExtractedName()].push_back(&metric);
     }
-    groups[metric->tagExtractedStatName()].push_back(metric.get());
   }
 
-  auto result = groups.size();
-  for (auto& group : groups) {
+  // PrometheusStatsFormatter::Groups
+  bool empty() const override { return groups_.empty(); }
+  bool renderNextGroup(Buffer::Instance& response) override {
+    auto group = groups_.begin();
     const absl::optional<std::string> prefixed_tag_extracted_name =
-        PrometheusStatsFormatter::metricName(global_symbol_table.toString(group.first),
-                                             custom_namespaces);
-    if (!prefixed_tag_extracted_name.has_value()) {
-      --result;
-      continue;
+        PrometheusStatsFormatter::metricName(group->first, custom_namespaces_);
+    const bool rendered = prefixed_tag_extracted_name.has_value();
+    if (rendered) {
+      response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type_));
+      std::sort(group->second.begin(), group->second.end(), PrimitiveMetricSnapshotLessThan());
+      for (const StatType* metric : group->second) {
+        response.add(generateNumericOutput(metric->value(), metric->tags(),
+                                           prefixed_tag_extracted_name.value()));
+      }
     }
-    response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type));
+    groups_.erase(group);
+    return rendered;
+  }
 
-    // Sort before producing the final output to satisfy the "preferred" ordering from the
-    // prometheus spec: metrics will be sorted by their tags' textual representation, which will
-    // be consistent across calls.
-    std::sort(group.second.begin(), group.second.end(), MetricLessThan());
+private:
+  std::map<std::string, std::vector<const StatType*>> groups_;
+  const absl::string_view type_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+};
 
-    for (const auto& metric : group.second) {
-      response.add(generate_output(*metric, prefixed_tag_extracted_name.value()));
+/**
+ * Renders all of the groups into response.
+ * @return uint64_t the number of groups rendered.
+ */
+uint64_t outputGroups(PrometheusStatsFormatter::Groups& groups, Buffer::Instance& response) {
+  uint64_t result = 0;
+  while (!groups.empty()) {
+    if (groups.renderNextGroup(response)) {
+      ++result;
     }
   }
   return result;
 }
 
 template <class StatType>
-uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams& params,
-                                 const std::vector<StatType>& metrics, absl::string_view type,
-                                 const Stats::CustomStatNamespaces& custom_namespaces) {
-
-  /*
-   * From
-   * https:*github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
-   *
-   * All lines for a given metric must be provided as one single group, with the optional HELP and
-   * TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
-   * expositions is preferred but not required, i.e. do not sort if the computational cost is
-   * prohibitive.
-   */
-
-  // This is an unsorted collection of dumb-pointers (no need to increment then decrement every
-  // refcount; ownership is held throughout by `metrics`). It is unsorted for efficiency, but will
-  // be sorted before producing the final output to satisfy the "preferred" ordering from the
-  // prometheus spec: metrics will be sorted by their tags' textual representation, which will be
-  // consistent across calls.
-  using StatTypeUnsortedCollection = std::vector<const StatType*>;
-
+uint64_t
+outputStatType(Buffer::Instance& response, const StatsParams& params,
+               const std::vector<Stats::RefcountPtr<StatType>>& metrics,
+               const typename MetricGroups<StatType>::GenerateOutputFn& generate_output,
+               absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces) {
   // Return early to avoid crashing when getting the symbol table from the first metric.
   if (metrics.empty()) {
     return 0;
   }
+  MetricGroups<StatType> groups(metrics.front()->constSymbolTable(), params, metrics,
+                                generate_output, type, custom_namespaces);
+  return outputGroups(groups, response);
+}
 
-  // Sorted collection of metrics sorted by their tagExtractedName, to satisfy the requirements
-  // of the exposition format.
-  std::map<std::string, StatTypeUnsortedCollection> groups;
-
-  for (const auto& metric : metrics) {
-    if (!params.shouldShowMetric(metric)) {
-      continue;
-    }
-    groups[metric.tagExtractedName()].push_back(&metric);
-  }
-
-  auto result = groups.size();
-  for (auto& group : groups) {
-    const absl::optional<std::string> prefixed_tag_extracted_name =
-        PrometheusStatsFormatter::metricName(group.first, custom_namespaces);
-    if (!prefixed_tag_extracted_name.has_value()) {
-      --result;
-      continue;
-    }
-    response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type));
-
-    // Sort before producing the final output to satisfy the "preferred" ordering from the
-    // prometheus spec: metrics will be sorted by their tags' textual representation, which will
-    // be consistent across calls.
-    std::sort(group.second.begin(), group.second.end(), PrimitiveMetricSnapshotLessThan());
-
-    for (const auto& metric : group.second) {
-      response.add(generateNumericOutput(metric->value(), metric->tags(),
-                                         prefixed_tag_extracted_name.value()));
-    }
-  }
-  return result;
+template <class StatType>
+uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams& params,
+                                 const std::vector<StatType>& metrics, absl::string_view type,
+                                 const Stats::CustomStatNamespaces& custom_namespaces) {
+  PrimitiveMetricGroups<StatType> groups(params, metrics, type, custom_namespaces);
+  return outputGroups(groups, response);
 }
 
 } // namespace
@@ -356,5 +373,109 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
   return metric_name_count;
 }
 
+PrometheusStatsRequest::PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                                               const Upstream::ClusterManager& cluster_manager,
+                                               const Stats::CustomStatNamespaces& custom_namespaces)
+    : params_(params), stats_(stats), cluster_manager_(cluster_manager),
+      custom_namespaces_(custom_namespaces) {}
+
+Http::Code PrometheusStatsRequest::start(Http::ResponseHeaderMap&) {
+  startNextPhase();
+  return Http::Code::OK;
+}
+
+bool PrometheusStatsRequest::nextChunk(Buffer::Instance& response) {
+  // nextChunk's contract is to add up to chunk_size_ additional bytes. The
+  // caller is not required to drain the bytes after each call to nextChunk.
+  // Groups are rendered as a whole, so a chunk may be larger by up to the
+  // size of one group.
+  const uint64_t starting_response_length = response.length();
+  while (response.length() - starting_response_length < chunk_size_) {
+    while (groups_ == nullptr || groups_->empty()) {
+      if (phase_ == Phase::Done) {
+        return false;
+      }
+      startNextPhase();
+    }
+    groups_->renderNextGroup(response);
+  }
+  return true;
+}
+
+void PrometheusStatsRequest::startNextPhase() {
+  groups_.reset();
+  const Stats::SymbolTable& symbol_table = stats_.constSymbolTable();
+  switch (phase_) {
+  case Phase::Start:
+    phase_ = Phase::Counters;
+    counters_ = stats_.counters();
+    groups_ = std::make_unique<MetricGroups<Stats::Counter>>(
+        symbol_table, params_, counters_, generateStatNumericOutput<Stats::Counter>, "counter",
+        custom_namespaces_);
+    break;
+  case Phase::Counters:
+    phase_ = Phase::Gauges;
+    counters_.clear();
+    counters_.shrink_to_fit();
+    gauges_ = stats_.gauges();
+    groups_ = std::make_unique<MetricGroups<Stats::Gauge>>(
+        symbol_table, params_, gauges_, generateStatNumericOutput<Stats::Gauge>, "gauge",
+        custom_namespaces_);
+    break;
+  case Phase::Gauges:
+    phase_ = Phase::TextReadouts;
+    gauges_.clear();
+    gauges_.shrink_to_fit();
+    if (params_.prometheus_text_readouts_) {
+      text_readouts_ = stats_.textReadouts();
+      // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
+      groups_ = std::make_unique<MetricGroups<Stats::TextReadout>>(
+          symbol_table, params_, text_readouts_, generateTextReadoutOutput, "gauge",
+          custom_namespaces_);
+    }
+    break;
+  case Phase::TextReadouts:
+    phase_ = Phase::Histograms;
+    text_readouts_.clear();
+    text_readouts_.shrink_to_fit();
+    histograms_ = stats_.histograms();
+    groups_ = std::make_unique<MetricGroups<Stats::ParentHistogram>>(
+        symbol_table, params_, histograms_, generateHistogramOutput, "histogram",
+        custom_namespaces_);
+    break;
+  case Phase::Histograms:
+    // As in statsAsPrometheus(), this assumes that there is no overlap in stat name between
+    // per-endpoint stats and all other stats.
+    phase_ = Phase::HostCounters;
+    histograms_.clear();
+    histograms_.shrink_to_fit();
+    Upstream::HostUtility::forEachHostMetric(
+        cluster_manager_,
+        [this](Stats::PrimitiveCounterSnapshot&& metric) {
+          host_counters_.emplace_back(std::move(metric));
+        },
+        [this](Stats::PrimitiveGaugeSnapshot&& metric) {
+          host_gauges_.emplace_back(std::move(metric));
+        });
+    groups_ = std::make_unique<PrimitiveMetricGroups<Stats::PrimitiveCounterSnapshot>>(
+        params_, host_counters_, "counter", custom_namespaces_);
+    break;
+  case Phase::HostCounters:
+    phase_ = Phase::HostGauges;
+    host_counters_.clear();
+    host_counters_.shrink_to_fit();
+    groups_ = std::make_unique<PrimitiveMetricGroups<Stats::PrimitiveGaugeSnapshot>>(
+        params_, host_gauges_, "gauge", custom_namespaces_);
+    break;
+  case Phase::HostGauges:
+    phase_ = Phase::Done;
+    host_gauges_.clear();
+    host_gauges_.shrink_to_fit();
+    break;
+  case Phase::Done:
+    break;
+  }
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -4,9 +4,12 @@
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/server/admin.h"
 #include "envoy/stats/custom_stat_namespaces.h"
 #include "envoy/stats/histogram.h"
+#include "envoy/stats/primitive_stats.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/store.h"
 
 #include "source/server/admin/stats_params.h"
 
@@ -46,6 +49,82 @@ public:
   static absl::optional<std::string>
   metricName(const std::string& extracted_name,
              const Stats::CustomStatNamespaces& custom_namespace_factory);
+
+  /**
+   * The metrics of one type grouped by tag-extracted name, in the order they are rendered. All
+   * lines of a metric are rendered together, a group at a time, so the output can be produced in
+   * chunks. Defined in the .cc file.
+   */
+  class Groups {
+  public:
+    virtual ~Groups() = default;
+
+    /**
+     * @return true if all groups have been rendered.
+     */
+    virtual bool empty() const PURE;
+
+    /**
+     * Renders the next group into response and drops it. Must not be called if empty().
+     * @return true if the group was rendered, false if it was skipped as its name is not a valid
+     *         Prometheus metric name.
+     */
+    virtual bool renderNextGroup(Buffer::Instance& response) PURE;
+  };
+  using GroupsPtr = std::unique_ptr<Groups>;
+};
+
+/**
+ * Streams the stats of a store in Prometheus format, in the same order as statsAsPrometheus().
+ * Only the stats of one type are held at a time, and each call to nextChunk() renders whole
+ * metric groups until about chunk size bytes were added, so the full response is never built in
+ * memory.
+ */
+class PrometheusStatsRequest : public Admin::Request {
+public:
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                         const Upstream::ClusterManager& cluster_manager,
+                         const Stats::CustomStatNamespaces& custom_namespaces);
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
+
+private:
+  enum class Phase {
+    Start,
+    Counters,
+    Gauges,
+    TextReadouts,
+    Histograms,
+    HostCounters,
+    HostGauges,
+    Done,
+  };
+
+  // Advances to the next phase, releasing the stats of the current one and grouping the stats
+  // of the new one into groups_.
+  void startNextPhase();
+
+  const StatsParams params_;
+  Stats::Store& stats_;
+  const Upstream::ClusterManager& cluster_manager_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  Phase phase_{Phase::Start};
+  PrometheusStatsFormatter::GroupsPtr groups_;
+  // The stats of the current phase, referenced by groups_.
+  std::vector<Stats::CounterSharedPtr> counters_;
+  std::vector<Stats::GaugeSharedPtr> gauges_;
+  std::vector<Stats::TextReadoutSharedPtr> text_readouts_;
+  std::vector<Stats::ParentHistogramSharedPtr> histograms_;
+  std::vector<Stats::PrimitiveCounterSnapshot> host_counters_;
+  std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges_;
+  uint64_t chunk_size_{DefaultChunkSize};
 };
 
 } // namespace Server
@@ -83,7 +83,8 @@ bool FilterChainUtility::buildQuicFilterChain(
 
 StatsConfigImpl::StatsConfigImpl(const envoy::config::bootstrap::v3::Bootstrap& bootstrap,
                                  absl::Status& status)
-    : deferred_stat_options_(bootstrap.deferred_stat_options()) {
+    : flush_only_changed_(bootstrap.stats_flush_only_changed()),
+      deferred_stat_options_(bootstrap.deferred_stat_options()) {
   status = absl::OkStatus();
   if (bootstrap.has_stats_flush_interval() &&
       bootstrap.stats_flush_case() !=
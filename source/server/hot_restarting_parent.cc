@@ -167,13 +167,30 @@ HotRestartingParent::Internal::getListenSocketsForChild(const HotRestartMessage:
 // magnitude of memory usage that they are meant to avoid, since this map holds full-string
 // names. The problem can be solved by splitting the export up over many chunks.
 void HotRestartingParent::Internal::exportStatsToChild(HotRestartMessage::Reply::Stats* stats) {
+  ++export_pass_;
   server_->stats().forEachSinkedGauge(nullptr, [this, stats](Stats::Gauge& gauge) mutable {
     if (gauge.used()) {
+      // The child keeps the last value it was sent, so only changed gauges are included.
+      const uint64_t value = gauge.value();
+      auto [it, inserted] =
+          exported_gauges_.try_emplace(&gauge, ExportedGauge{&gauge, value, export_pass_});
+      if (!inserted) {
+        it->second.export_pass_ = export_pass_;
+        if (it->second.value_ == value) {
+          return;
+        }
+        it->second.value_ = value;
+      }
       const std::string name = gauge.name();
-      (*stats->mutable_gauges())[name] = gauge.value();
+      (*stats->mutable_gauges())[name] = value;
       recordDynamics(stats, name, gauge.statName());
     }
   });
+  // Gauges which are no longer exported are dropped, as are gauges only kept alive by the map,
+  // i.e. which were removed from the store.
+  absl::erase_if(exported_gauges_, [this](const auto& entry) {
+    return entry.second.export_pass_ != export_pass_ || entry.second.gauge_->use_count() == 1;
+  });
 
   server_->stats().forEachSinkedCounter(nullptr, [this, stats](Stats::Counter& counter) mutable {
     if (counter.used()) {
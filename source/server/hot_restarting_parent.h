@@ -1,8 +1,12 @@
 #pragma once
 
+#include "envoy/stats/stats.h"
+
 #include "source/common/common/hash.h"
 #include "source/server/hot_restarting_base.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -40,13 +44,25 @@ public:
     void recordDynamics(envoy::HotRestartMessage::Reply::Stats* stats, const std::string& name,
                         Stats::StatName stat_name);
     void drainListeners();
+    size_t exportedGaugeCountForTest() const { return exported_gauges_.size(); }
 
     // Network::NonDispatchedUdpPacketHandler
     void handle(uint32_t worker_index, const Network::UdpRecvData& packet) override;
 
   private:
+    // A gauge sent to the child, with the value it was last sent with. Holding a reference keeps
+    // the address of the gauge from being reused by another one. export_pass_ is the last export
+    // which included the gauge.
+    struct ExportedGauge {
+      Stats::GaugeSharedPtr gauge_;
+      uint64_t value_;
+      uint64_t export_pass_;
+    };
+
     Server::Instance* const server_{};
     HotRestartMessageSender& udp_sender_;
+    absl::flat_hash_map<const Stats::Gauge*, ExportedGauge> exported_gauges_;
+    uint64_t export_pass_{};
   };
 
 private:
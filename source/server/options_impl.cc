@@ -109,6 +109,10 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
       "Logger mode: enable file level log control (Fine-Grain Logger) or not", cmd, false);
   TCLAP::ValueArg<std::string> log_path("", "log-path", "Path to logfile", false, "", "string",
                                         cmd);
+  TCLAP::ValueArg<std::string> log_async(
+      "", "log-async",
+      "Write application logs from a background thread: 'disabled', 'drop' or 'block' when full",
+      false, "disabled", "string", cmd);
   TCLAP::ValueArg<uint32_t> restart_epoch("", "restart-epoch", "Hot restart epoch #", false, 0,
                                           "uint32_t", cmd);
   TCLAP::SwitchArg hot_restart_version_option("", "hot-restart-version",
@@ -122,6 +126,13 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   TCLAP::ValueArg<uint32_t> file_flush_interval_msec("", "file-flush-interval-msec",
                                                      "Interval for log flushing in msec", false,
                                                      10000, "uint32_t", cmd);
+  TCLAP::ValueArg<uint64_t> file_flush_max_buffer_bytes(
+      "", "file-flush-max-buffer-bytes",
+      "Maximum size of the data buffered for each log file, 0 for unbounded", false, 0,
+      "uint64_t", cmd);
+  TCLAP::SwitchArg file_flush_block_when_full(
+      "", "file-flush-block-when-full",
+      "Make writes to a log file whose buffer is full wait, rather than dropping them", cmd, false);
   TCLAP::ValueArg<uint32_t> drain_time_s("", "drain-time-s",
                                          "Hot restart and LDS removal drain time in seconds", false,
                                          600, "uint32_t", cmd);
@@ -142,6 +153,9 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
       "", "enable-mutex-tracing", "Enable mutex contention tracing functionality", cmd, false);
   TCLAP::SwitchArg cpuset_threads(
       "", "cpuset-threads", "Get the default # of worker threads from cpuset size", cmd, false);
+  TCLAP::SwitchArg pin_worker_threads(
+      "", "pin-worker-threads", "Pin each worker thread to one of the CPUs of the process", cmd,
+      false);
 
   TCLAP::ValueArg<std::string> disable_extensions("", "disable-extensions",
                                                   "Comma-separated list of extensions to disable",
@@ -188,6 +202,7 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   core_dump_enabled_ = enable_core_dump.getValue();
 
   cpuset_threads_ = cpuset_threads.getValue();
+  pin_worker_threads_ = pin_worker_threads.getValue();
 
   if (log_level.isSet()) {
     auto status_or_error = parseAndValidateLogLevel(log_level.getValue());
@@ -262,10 +277,22 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   ignore_unknown_dynamic_fields_ = ignore_unknown_dynamic_fields.getValue();
   admin_address_path_ = admin_address_path.getValue();
   log_path_ = log_path.getValue();
+  if (log_async.getValue() == "disabled") {
+    async_log_mode_ = Server::AsyncLogMode::Disabled;
+  } else if (log_async.getValue() == "drop") {
+    async_log_mode_ = Server::AsyncLogMode::Drop;
+  } else if (log_async.getValue() == "block") {
+    async_log_mode_ = Server::AsyncLogMode::Block;
+  } else {
+    throw MalformedArgvException(
+        fmt::format("error: unknown log-async mode '{}'", log_async.getValue()));
+  }
   service_cluster_ = service_cluster.getValue();
   service_node_ = service_node.getValue();
   service_zone_ = service_zone.getValue();
   file_flush_interval_msec_ = std::chrono::milliseconds(file_flush_interval_msec.getValue());
+  file_flush_max_buffer_bytes_ = file_flush_max_buffer_bytes.getValue();
+  file_flush_block_when_full_ = file_flush_block_when_full.getValue();
   drain_time_ = std::chrono::seconds(drain_time_s.getValue());
   parent_shutdown_time_ = std::chrono::seconds(parent_shutdown_time_s.getValue());
   socket_path_ = socket_path.getValue();
@@ -404,6 +431,8 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   }
   command_line_options->mutable_file_flush_interval()->MergeFrom(
       Protobuf::util::TimeUtil::MillisecondsToDuration(fileFlushIntervalMsec().count()));
+  command_line_options->set_file_flush_max_buffer_bytes(fileFlushMaxBufferBytes());
+  command_line_options->set_file_flush_block_when_full(fileFlushBlockWhenFull());
 
   command_line_options->mutable_drain_time()->MergeFrom(
       Protobuf::util::TimeUtil::SecondsToDuration(drainTime().count()));
@@ -416,6 +445,7 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   command_line_options->set_disable_hot_restart(hotRestartDisabled());
   command_line_options->set_enable_mutex_tracing(mutexTracingEnabled());
   command_line_options->set_cpuset_threads(cpusetThreadsEnabled());
+  command_line_options->set_pin_worker_threads(pinWorkerThreadsEnabled());
   command_line_options->set_restart_epoch(restartEpoch());
   for (const auto& e : disabledExtensions()) {
     command_line_options->add_disabled_extensions(e);
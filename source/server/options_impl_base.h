@@ -60,11 +60,18 @@ public:
     log_format_set_ = true;
   }
   void setLogPath(const std::string& log_path) { log_path_ = log_path; }
+  void setAsyncLogMode(Server::AsyncLogMode async_log_mode) { async_log_mode_ = async_log_mode; }
   void setRestartEpoch(uint64_t restart_epoch) { restart_epoch_ = restart_epoch; }
   void setMode(Server::Mode mode) { mode_ = mode; }
   void setFileFlushIntervalMsec(std::chrono::milliseconds file_flush_interval_msec) {
     file_flush_interval_msec_ = file_flush_interval_msec;
   }
+  void setFileFlushMaxBufferBytes(uint64_t file_flush_max_buffer_bytes) {
+    file_flush_max_buffer_bytes_ = file_flush_max_buffer_bytes;
+  }
+  void setFileFlushBlockWhenFull(bool file_flush_block_when_full) {
+    file_flush_block_when_full_ = file_flush_block_when_full;
+  }
   void setServiceClusterName(const std::string& service_cluster) {
     service_cluster_ = service_cluster;
   }
@@ -77,6 +84,9 @@ public:
     signal_handling_enabled_ = signal_handling_enabled;
   }
   void setCpusetThreads(bool cpuset_threads_enabled) { cpuset_threads_ = cpuset_threads_enabled; }
+  void setPinWorkerThreads(bool pin_worker_threads_enabled) {
+    pin_worker_threads_ = pin_worker_threads_enabled;
+  }
   void setAllowUnknownFields(bool allow_unknown_static_fields) {
     allow_unknown_static_fields_ = allow_unknown_static_fields;
   }
@@ -124,11 +134,14 @@ public:
   bool logFormatEscaped() const override { return log_format_escaped_; }
   bool enableFineGrainLogging() const override { return enable_fine_grain_logging_; }
   const std::string& logPath() const override { return log_path_; }
+  Server::AsyncLogMode asyncLogMode() const override { return async_log_mode_; }
   uint64_t restartEpoch() const override { return restart_epoch_; }
   Server::Mode mode() const override { return mode_; }
   std::chrono::milliseconds fileFlushIntervalMsec() const override {
     return file_flush_interval_msec_;
   }
+  uint64_t fileFlushMaxBufferBytes() const override { return file_flush_max_buffer_bytes_; }
+  bool fileFlushBlockWhenFull() const override { return file_flush_block_when_full_; }
   const std::string& serviceClusterName() const override { return service_cluster_; }
   const std::string& serviceNodeName() const override { return service_node_; }
   const std::string& serviceZone() const override { return service_zone_; }
@@ -138,6 +151,7 @@ public:
   bool coreDumpEnabled() const override { return core_dump_enabled_; }
   const Stats::TagVector& statsTags() const override { return stats_tags_; }
   bool cpusetThreadsEnabled() const override { return cpuset_threads_; }
+  bool pinWorkerThreadsEnabled() const override { return pin_worker_threads_; }
   const std::vector<std::string>& disabledExtensions() const override {
     return disabled_extensions_;
   }
@@ -185,11 +199,14 @@ private:
   bool log_format_set_{false};
   bool log_format_escaped_{false};
   std::string log_path_;
+  Server::AsyncLogMode async_log_mode_{Server::AsyncLogMode::Disabled};
   uint64_t restart_epoch_{0};
   std::string service_cluster_;
   std::string service_node_;
   std::string service_zone_;
   std::chrono::milliseconds file_flush_interval_msec_{10000};
+  uint64_t file_flush_max_buffer_bytes_{0};
+  bool file_flush_block_when_full_{false};
   std::chrono::seconds drain_time_{600};
   std::chrono::seconds parent_shutdown_time_{900};
   Server::DrainStrategy drain_strategy_{Server::DrainStrategy::Gradual};
@@ -199,6 +216,7 @@ private:
   bool mutex_tracing_enabled_{false};
   bool core_dump_enabled_{false};
   bool cpuset_threads_{false};
+  bool pin_worker_threads_{false};
   std::vector<std::string> disabled_extensions_;
   Stats::TagVector stats_tags_;
   uint32_t count_{0};
@@ -79,7 +79,46 @@ private:
   OverloadActionState state_;
 };
 
-TriggerPtr createTriggerFromConfig(const envoy::config::overload::v3::Trigger& trigger_config) {
+class TrendTriggerImpl final : public Trigger {
+public:
+  TrendTriggerImpl(const envoy::config::overload::v3::TrendTrigger& config,
+                   TimeSource& time_source)
+      : threshold_(config.value()),
+        lookahead_(std::chrono::milliseconds(PROTOBUF_GET_MS_REQUIRED(config, lookahead))),
+        time_source_(time_source), state_(OverloadActionState::inactive()) {}
+
+  bool updateValue(double value) override {
+    const OverloadActionState old_state = actionState();
+    const MonotonicTime now = time_source_.monotonicTime();
+    double projected_value = value;
+    if (last_update_.has_value() && now > last_update_->first) {
+      const std::chrono::duration<double> elapsed = now - last_update_->first;
+      const double rate = (value - last_update_->second) / elapsed.count();
+      // Only growing pressure is extrapolated, so a falling pressure above the threshold still
+      // saturates the trigger.
+      if (rate > 0) {
+        projected_value += rate * lookahead_.count();
+      }
+    }
+    last_update_.emplace(now, value);
+    state_ = projected_value >= threshold_ ? OverloadActionState::saturated()
+                                           : OverloadActionState::inactive();
+    return state_.value() != old_state.value();
+  }
+
+  OverloadActionState actionState() const override { return state_; }
+
+private:
+  const double threshold_;
+  // The lookahead in seconds, the unit of the computed rates.
+  const std::chrono::duration<double> lookahead_;
+  TimeSource& time_source_;
+  absl::optional<std::pair<MonotonicTime, double>> last_update_;
+  OverloadActionState state_;
+};
+
+TriggerPtr createTriggerFromConfig(const envoy::config::overload::v3::Trigger& trigger_config,
+                                   TimeSource& time_source) {
   TriggerPtr trigger;
 
   switch (trigger_config.trigger_oneof_case()) {
@@ -89,6 +128,9 @@ TriggerPtr createTriggerFromConfig(const envoy::config::overload::v3::Trigger& t
   case envoy::config::overload::v3::Trigger::TriggerOneofCase::kScaled:
     trigger = std::make_unique<ScaledTriggerImpl>(trigger_config.scaled());
     break;
+  case envoy::config::overload::v3::Trigger::TriggerOneofCase::kTrend:
+    trigger = std::make_unique<TrendTriggerImpl>(trigger_config.trend(), time_source);
+    break;
   case envoy::config::overload::v3::Trigger::TriggerOneofCase::TRIGGER_ONEOF_NOT_SET:
     throw EnvoyException(absl::StrCat("action not set for trigger ", trigger_config.name()));
   }
@@ -265,14 +307,16 @@ const absl::string_view NamedOverloadActionSymbolTable::name(Symbol symbol) cons
 }
 
 OverloadAction::OverloadAction(const envoy::config::overload::v3::OverloadAction& config,
-                               Stats::Scope& stats_scope)
+                               Stats::Scope& stats_scope, TimeSource& time_source)
     : state_(OverloadActionState::inactive()),
       active_gauge_(
           makeGauge(stats_scope, config.name(), "active", Stats::Gauge::ImportMode::NeverImport)),
       scale_percent_gauge_(makeGauge(stats_scope, config.name(), "scale_percent",
                                      Stats::Gauge::ImportMode::NeverImport)) {
   for (const auto& trigger_config : config.triggers()) {
-    if (!triggers_.try_emplace(trigger_config.name(), createTriggerFromConfig(trigger_config))
+    if (!triggers_
+             .try_emplace(trigger_config.name(),
+                          createTriggerFromConfig(trigger_config, time_source))
              .second) {
       throw EnvoyException(
           absl::StrCat("Duplicate trigger resource for overload action ", config.name()));
@@ -314,12 +358,15 @@ OverloadActionState OverloadAction::getState() const { return state_; }
 
 LoadShedPointImpl::LoadShedPointImpl(const envoy::config::overload::v3::LoadShedPoint& config,
                                      Stats::Scope& stats_scope,
-                                     Random::RandomGenerator& random_generator)
+                                     Random::RandomGenerator& random_generator,
+                                     TimeSource& time_source)
     : scale_percent_(makeGauge(stats_scope, config.name(), "scale_percent",
                                Stats::Gauge::ImportMode::NeverImport)),
       random_generator_(random_generator) {
   for (const auto& trigger_config : config.triggers()) {
-    if (!triggers_.try_emplace(trigger_config.name(), createTriggerFromConfig(trigger_config))
+    if (!triggers_
+             .try_emplace(trigger_config.name(),
+                          createTriggerFromConfig(trigger_config, time_source))
              .second) {
       throw EnvoyException(
           absl::StrCat("Duplicate trigger resource for LoadShedPoint ", config.name()));
@@ -431,7 +478,7 @@ OverloadManagerImpl::OverloadManagerImpl(Event::Dispatcher& dispatcher, Stats::S
     // We cannot currently use in place construction as the OverloadAction constructor may throw,
     // causing an inconsistent internal state of the actions_ map, which on destruction results in
     // an invalid free.
-    auto result = actions_.try_emplace(symbol, OverloadAction(action, stats_scope));
+    auto result = actions_.try_emplace(symbol, OverloadAction(action, stats_scope, time_source_));
     if (!result.second) {
       throw EnvoyException(absl::StrCat("Duplicate overload action ", name));
     }
@@ -476,7 +523,8 @@ OverloadManagerImpl::OverloadManagerImpl(Event::Dispatcher& dispatcher, Stats::S
 
     const auto result = loadshed_points_.try_emplace(
         point.name(),
-        std::make_unique<LoadShedPointImpl>(point, api.rootScope(), api.randomGenerator()));
+        std::make_unique<LoadShedPointImpl>(point, api.rootScope(), api.randomGenerator(),
+                                            time_source_));
 
     if (!result.second) {
       throw EnvoyException(absl::StrCat("Duplicate loadshed point ", point.name()));
@@ -98,9 +98,11 @@ InstanceBase::InstanceBase(Init::Manager& init_manager, const Options& options,
           watermark_factory)),
       dispatcher_(api_->allocateDispatcher("main_thread")),
       access_log_manager_(options.fileFlushIntervalMsec(), *api_, *dispatcher_, access_log_lock,
-                          store),
+                          store,
+                          {options.fileFlushMaxBufferBytes(), options.fileFlushBlockWhenFull()}),
       singleton_manager_(new Singleton::ManagerImpl(api_->threadFactory())),
-      handler_(getHandler(*dispatcher_)), worker_factory_(thread_local_, *api_, hooks),
+      handler_(getHandler(*dispatcher_)), worker_factory_(thread_local_, *api_, hooks,
+                                                          options.pinWorkerThreadsEnabled()),
       mutex_tracer_(options.mutexTracingEnabled() ? &Envoy::MutexTracerImpl::getOrCreateTracer()
                                                   : nullptr),
       grpc_context_(store.symbolTable()), http_context_(store.symbolTable()),
@@ -125,7 +127,9 @@ InstanceBase::~InstanceBase() {
   terminate();
 
   // Stop logging to file before all the AccessLogManager and its dependencies are
-  // destructed to avoid crashing at shutdown.
+  // destructed to avoid crashing at shutdown. The async logger writes through the file logger, so
+  // it goes first.
+  async_logger_.reset();
   file_logger_.reset();
 
   // Destruct the ListenerManager explicitly, before InstanceBase's local init_manager_ is
@@ -181,33 +185,51 @@ void InstanceBase::failHealthcheck(bool fail) {
 
 MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
                                        Upstream::ClusterManager& cluster_manager,
-                                       TimeSource& time_source) {
+                                       TimeSource& time_source, bool only_changed) {
+  // When only changed stats are flushed, most stats are expected to be idle so the vectors are not
+  // sized up front for all of them.
   store.forEachSinkedCounter(
-      [this](std::size_t size) {
-        snapped_counters_.reserve(size);
-        counters_.reserve(size);
+      [this, only_changed](std::size_t size) {
+        if (!only_changed) {
+          snapped_counters_.reserve(size);
+          counters_.reserve(size);
+        }
       },
-      [this](Stats::Counter& counter) {
+      [this, only_changed](Stats::Counter& counter) {
+        const uint64_t delta = counter.latch();
+        if (only_changed && delta == 0) {
+          return;
+        }
         snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
-        counters_.push_back({counter.latch(), counter});
+        counters_.push_back({delta, counter});
       });
 
   store.forEachSinkedGauge(
-      [this](std::size_t size) {
-        snapped_gauges_.reserve(size);
-        gauges_.reserve(size);
+      [this, only_changed](std::size_t size) {
+        if (!only_changed) {
+          snapped_gauges_.reserve(size);
+          gauges_.reserve(size);
+        }
       },
-      [this](Stats::Gauge& gauge) {
+      [this, only_changed](Stats::Gauge& gauge) {
+        if (only_changed && !gauge.latchChanged()) {
+          return;
+        }
         snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
         gauges_.push_back(gauge);
       });
 
   store.forEachSinkedHistogram(
-      [this](std::size_t size) {
-        snapped_histograms_.reserve(size);
-        histograms_.reserve(size);
+      [this, only_changed](std::size_t size) {
+        if (!only_changed) {
+          snapped_histograms_.reserve(size);
+          histograms_.reserve(size);
+        }
       },
-      [this](Stats::ParentHistogram& histogram) {
+      [this, only_changed](Stats::ParentHistogram& histogram) {
+        if (only_changed && histogram.intervalStatistics().sampleCount() == 0) {
+          return;
+        }
         snapped_histograms_.push_back(Stats::ParentHistogramSharedPtr(&histogram));
         histograms_.push_back(histogram);
       });
@@ -224,7 +246,10 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
 
   Upstream::HostUtility::forEachHostMetric(
       cluster_manager,
-      [this](Stats::PrimitiveCounterSnapshot&& metric) {
+      [this, only_changed](Stats::PrimitiveCounterSnapshot&& metric) {
+        if (only_changed && metric.delta() == 0) {
+          return;
+        }
         host_counters_.emplace_back(std::move(metric));
       },
       [this](Stats::PrimitiveGaugeSnapshot&& metric) {
@@ -235,12 +260,13 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
 }
 
 void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                       Upstream::ClusterManager& cm, TimeSource& time_source) {
+                                       Upstream::ClusterManager& cm, TimeSource& time_source,
+                                       bool only_changed) {
   // Create a snapshot and flush to all sinks.
   // NOTE: Even if there are no sinks, creating the snapshot has the important property that it
   //       latches all counters on a periodic basis. The hot restart code assumes this is being
   //       done so this should not be removed.
-  MetricSnapshotImpl snapshot(store, cm, time_source);
+  MetricSnapshotImpl snapshot(store, cm, time_source, only_changed);
   for (const auto& sink : sinks) {
     sink->flush(snapshot);
   }
@@ -300,7 +326,7 @@ void InstanceBase::flushStatsInternal() {
   updateServerStats();
   auto& stats_config = config_.statsConfig();
   InstanceUtil::flushMetricsToSinks(stats_config.sinks(), stats_store_, clusterManager(),
-                                    timeSource());
+                                    timeSource(), stats_config.flushOnlyChanged());
   // TODO(ramaraochavali): consider adding different flush interval for histograms.
   if (stat_flush_timer_ != nullptr) {
     stat_flush_timer_->enableTimer(stats_config.flushInterval());
@@ -423,6 +449,12 @@ void InstanceBase::initialize(Network::Address::InstanceConstSharedPtr local_add
     if (!options_.logPath().empty()) {
       set_up_logger();
     }
+    if (options_.asyncLogMode() != AsyncLogMode::Disabled) {
+      async_logger_ = std::make_unique<Logger::AsyncSinkDelegate>(
+          Logger::Registry::getSink(), api_->threadFactory(),
+          options_.asyncLogMode() == AsyncLogMode::Drop ? Logger::AsyncLogOverflowPolicy::Drop
+                                                        : Logger::AsyncLogOverflowPolicy::Block);
+    }
     restarter_.initialize(*dispatcher_, *this);
     drain_manager_ = component_factory.createDrainManager(*this);
     THROW_IF_NOT_OK(initializeOrThrow(std::move(local_address), component_factory));
@@ -525,6 +557,8 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
       bootstrap_.stats_config(), stats_store_.symbolTable()));
   stats_store_.setHistogramSettings(
       std::make_unique<Stats::HistogramSettingsImpl>(bootstrap_.stats_config()));
+  stats_store_.setShardHotCounters(bootstrap_.stats_config().shard_hot_counters());
+  stats_store_.setMaxStatsPerScope(bootstrap_.stats_config().max_stats_per_scope());
 
   const std::string server_stats_prefix = "server.";
   const std::string server_compilation_settings_stats_prefix = "server.compilation_settings";
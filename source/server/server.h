@@ -129,9 +129,11 @@ public:
    * flush() on each sink.
    * @param sinks supplies the list of sinks.
    * @param store provides the store being flushed.
+   * @param only_changed flush only the stats which changed since the previous flush.
    */
   static void flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                  Upstream::ClusterManager& cm, TimeSource& time_source);
+                                  Upstream::ClusterManager& cm, TimeSource& time_source,
+                                  bool only_changed = false);
 
   /**
    * Load a bootstrap config and perform validation.
@@ -394,6 +396,7 @@ private:
   std::unique_ptr<Server::GuardDog> worker_guard_dog_;
   bool terminated_{false};
   std::unique_ptr<Logger::FileSinkDelegate> file_logger_;
+  std::unique_ptr<Logger::AsyncSinkDelegate> async_logger_;
   ConfigTracker::EntryOwnerPtr config_tracker_entry_;
   SystemTime bootstrap_config_update_time_;
   Grpc::AsyncClientManagerPtr async_client_manager_;
@@ -437,10 +440,16 @@ private:
 // TODO(mattklein123): One thing we probably want to do is switch from returning vectors of metrics
 //                     to a lambda based callback iteration API. This would require less vector
 //                     copying and probably be a cleaner API in general.
+/**
+ * Snapshot of the stats flushed to sinks. Counters are always latched. If only_changed is set,
+ * the snapshot leaves out the counters with a zero delta, the gauges which were not changed and
+ * the histograms without values since the previous snapshot, as well as host counters with a zero
+ * delta, so sinks only spend time on the stats that moved.
+ */
 class MetricSnapshotImpl : public Stats::MetricSnapshot {
 public:
   explicit MetricSnapshotImpl(Stats::Store& store, Upstream::ClusterManager& cluster_manager,
-                              TimeSource& time_source);
+                              TimeSource& time_source, bool only_changed = false);
 
   // Stats::MetricSnapshot
   const std::vector<CounterSnapshot>& counters() override { return counters_; }
@@ -9,13 +9,23 @@
 #include "envoy/server/configuration.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/buffer/slice_allocator.h"
+#include "source/common/common/utility.h"
 #include "source/common/config/utility.h"
 #include "source/server/listener_manager_factory.h"
 
+#if defined(__linux__)
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
 namespace Envoy {
 namespace Server {
 namespace {
 
+// The interval of publishing the buffer stats of the worker, and of dropping the cached buffer
+// memory while the heap is being shrunk.
+constexpr std::chrono::milliseconds BufferStatsFlushInterval{5000};
+
 std::unique_ptr<ConnectionHandler> getHandler(Event::Dispatcher& dispatcher, uint32_t index,
                                               OverloadManager& overload_manager) {
 
@@ -28,24 +38,60 @@ std::unique_ptr<ConnectionHandler> getHandler(Event::Dispatcher& dispatcher, uin
   return nullptr;
 }
 
+// Returns the CPUs the calling thread is allowed to run on.
+std::vector<uint32_t> allowedCpus() {
+  std::vector<uint32_t> cpus;
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().sched_getaffinity(0, sizeof(mask), &mask);
+  if (result.return_value_ == -1) {
+    ENVOY_LOG_MISC(warn, "Not pinning worker threads, unable to get the CPU affinity: {}",
+                   errorDetails(result.errno_));
+    return cpus;
+  }
+  for (uint32_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &mask)) {
+      cpus.push_back(cpu);
+    }
+  }
+#else
+  ENVOY_LOG_MISC(warn, "Not pinning worker threads, which is only supported on Linux");
+#endif
+  return cpus;
+}
+
 } // namespace
 
+ProdWorkerFactory::ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api,
+                                     ListenerHooks& hooks, bool pin_worker_threads)
+    : tls_(tls), api_(api), stat_names_(api.rootScope().symbolTable()), hooks_(hooks) {
+  if (pin_worker_threads) {
+    worker_cpus_ = allowedCpus();
+  }
+}
+
 WorkerPtr ProdWorkerFactory::createWorker(uint32_t index, OverloadManager& overload_manager,
                                           const std::string& worker_name) {
   Event::DispatcherPtr dispatcher(
       api_.allocateDispatcher(worker_name, overload_manager.scaledTimerFactory()));
   auto conn_handler = getHandler(*dispatcher, index, overload_manager);
+  const absl::optional<uint32_t> cpu =
+      worker_cpus_.empty() ? absl::nullopt
+                           : absl::make_optional(worker_cpus_[index % worker_cpus_.size()]);
   return std::make_unique<WorkerImpl>(tls_, hooks_, std::move(dispatcher), std::move(conn_handler),
-                                      overload_manager, api_, stat_names_);
+                                      overload_manager, api_, stat_names_, cpu);
 }
 
 WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
                        Event::DispatcherPtr&& dispatcher, Network::ConnectionHandlerPtr handler,
                        OverloadManager& overload_manager, Api::Api& api,
-                       WorkerStatNames& stat_names)
+                       WorkerStatNames& stat_names, absl::optional<uint32_t> cpu)
     : tls_(tls), hooks_(hooks), dispatcher_(std::move(dispatcher)), handler_(std::move(handler)),
       api_(api), reset_streams_counter_(
-                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)) {
+                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)),
+      cpu_(cpu) {
   tls_.registerThread(*dispatcher_, false);
   overload_manager.registerForAction(
       OverloadActionNames::get().StopAcceptingConnections, *dispatcher_,
@@ -56,6 +102,9 @@ WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
   overload_manager.registerForAction(
       OverloadActionNames::get().ResetStreams, *dispatcher_,
       [this](OverloadActionState state) { resetStreamsUsingExcessiveMemory(state); });
+  overload_manager.registerForAction(
+      OverloadActionNames::get().ShrinkHeap, *dispatcher_,
+      [this](OverloadActionState state) { shrinkBufferCacheCb(state); });
 }
 
 void WorkerImpl::addListener(absl::optional<uint64_t> overridden_listener,
@@ -116,7 +165,21 @@ void WorkerImpl::start(OptRef<GuardDog> guard_dog, const std::function<void()>&
       [this, guard_dog, cb]() -> void { threadRoutine(guard_dog, cb); }, options);
 }
 
-void WorkerImpl::initializeStats(Stats::Scope& scope) { dispatcher_->initializeStats(scope); }
+void WorkerImpl::initializeStats(Stats::Scope& scope) {
+  dispatcher_->initializeStats(scope);
+  // The slice allocator is thread local, so its stats are flushed on the worker thread.
+  dispatcher_->post([this, &scope]() {
+    const std::string prefix = absl::StrCat(dispatcher_->name(), ".buffer.");
+    buffer_stats_ = std::make_unique<WorkerBufferStats>(
+        WorkerBufferStats{ALL_WORKER_BUFFER_STATS(POOL_COUNTER_PREFIX(scope, prefix),
+                                                  POOL_GAUGE_PREFIX(scope, prefix))});
+    buffer_stats_flush_timer_ = dispatcher_->createTimer([this]() {
+      flushBufferStats();
+      buffer_stats_flush_timer_->enableTimer(BufferStatsFlushInterval);
+    });
+    buffer_stats_flush_timer_->enableTimer(BufferStatsFlushInterval);
+  });
+}
 
 void WorkerImpl::stop() {
   // It's possible for the server to cleanly shut down while cluster initialization during startup
@@ -139,7 +202,29 @@ void WorkerImpl::stopListener(Network::ListenerConfig& listener,
   });
 }
 
+void WorkerImpl::pinToCpu() {
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(*cpu_, &mask);
+  // A pid of zero sets the affinity of the calling thread only.
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().sched_setaffinity(0, sizeof(mask), &mask);
+  if (result.return_value_ == -1) {
+    ENVOY_LOG(warn, "unable to pin {} to CPU {}: {}", dispatcher_->name(), *cpu_,
+              errorDetails(result.errno_));
+    return;
+  }
+  ENVOY_LOG(debug, "pinned {} to CPU {}", dispatcher_->name(), *cpu_);
+#endif
+}
+
 void WorkerImpl::threadRoutine(OptRef<GuardDog> guard_dog, const std::function<void()>& cb) {
+  if (cpu_.has_value()) {
+    // Pin before the dispatch loop runs, so that the memory of the worker is first touched, and
+    // with the default NUMA policy allocated, on the node of its CPU.
+    pinToCpu();
+  }
   ENVOY_LOG(debug, "worker entering dispatch loop");
   // The watch dog must be created after the dispatcher starts running and has post events flushed,
   // as this is when TLS stat scopes start working.
@@ -163,6 +248,7 @@ void WorkerImpl::threadRoutine(OptRef<GuardDog> guard_dog, const std::function<v
   handler_.reset();
   tls_.shutdownThread();
   watch_dog_.reset();
+  buffer_stats_flush_timer_.reset();
 }
 
 void WorkerImpl::stopAcceptingConnectionsCb(OverloadActionState state) {
@@ -183,5 +269,33 @@ void WorkerImpl::resetStreamsUsingExcessiveMemory(OverloadActionState state) {
   reset_streams_counter_.add(streams_reset_count);
 }
 
+void WorkerImpl::shrinkBufferCacheCb(OverloadActionState state) {
+  shrink_buffer_cache_ = state.isSaturated();
+  if (shrink_buffer_cache_) {
+    // The memory goes back to the heap, which the heap shrinker returns to the OS.
+    const uint64_t released = Buffer::SliceAllocator::releaseFreeMemory();
+    ENVOY_LOG(debug, "released {} bytes of cached buffer memory", released);
+  }
+}
+
+void WorkerImpl::flushBufferStats() {
+  if (shrink_buffer_cache_) {
+    Buffer::SliceAllocator::releaseFreeMemory();
+  }
+  if (buffer_stats_ == nullptr) {
+    return;
+  }
+  const Buffer::SliceAllocator::Stats& stats = Buffer::SliceAllocator::threadStats();
+  buffer_stats_->slice_cache_bytes_.set(stats.cached_bytes_);
+  // The counters may also hold the values merged from a hot restart parent, so only what changed
+  // since the last flush is added to them.
+  buffer_stats_->slice_cache_hits_.add(stats.cache_hits_ - flushed_buffer_stats_.cache_hits_);
+  buffer_stats_->slice_cache_released_bytes_.add(stats.released_bytes_ -
+                                                 flushed_buffer_stats_.released_bytes_);
+  buffer_stats_->slice_heap_allocations_.add(stats.heap_allocations_ -
+                                             flushed_buffer_stats_.heap_allocations_);
+  flushed_buffer_stats_ = stats;
+}
+
 } // namespace Server
 } // namespace Envoy
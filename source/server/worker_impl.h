@@ -8,14 +8,32 @@
 #include "envoy/server/guarddog.h"
 #include "envoy/server/listener_manager.h"
 #include "envoy/server/worker.h"
+#include "envoy/stats/stats_macros.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/buffer/slice_allocator.h"
 #include "source/common/common/logger.h"
 #include "source/server/listener_hooks.h"
 
 namespace Envoy {
 namespace Server {
 
+/**
+ * Memory usage of the worker's Buffer::SliceAllocator. @see stats_macros.h
+ */
+#define ALL_WORKER_BUFFER_STATS(COUNTER, GAUGE)                                                    \
+  COUNTER(slice_cache_hits)                                                                        \
+  COUNTER(slice_cache_released_bytes)                                                              \
+  COUNTER(slice_heap_allocations)                                                                  \
+  GAUGE(slice_cache_bytes, NeverImport)
+
+/**
+ * Struct definition for the memory usage of the worker's buffers. @see stats_macros.h
+ */
+struct WorkerBufferStats {
+  ALL_WORKER_BUFFER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
 // Captures a set of stat names for the workers.
 struct WorkerStatNames {
   explicit WorkerStatNames(Stats::SymbolTable& symbol_table)
@@ -28,8 +46,8 @@ struct WorkerStatNames {
 
 class ProdWorkerFactory : public WorkerFactory, Logger::Loggable<Logger::Id::main> {
 public:
-  ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks)
-      : tls_(tls), api_(api), stat_names_(api.rootScope().symbolTable()), hooks_(hooks) {}
+  ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks,
+                    bool pin_worker_threads);
 
   // Server::WorkerFactory
   WorkerPtr createWorker(uint32_t index, OverloadManager& overload_manager,
@@ -40,6 +58,8 @@ private:
   Api::Api& api_;
   WorkerStatNames stat_names_;
   ListenerHooks& hooks_;
+  // The CPUs that workers are pinned to round robin by their index, empty if they aren't pinned.
+  std::vector<uint32_t> worker_cpus_;
 };
 
 /**
@@ -49,7 +69,7 @@ class WorkerImpl : public Worker, Logger::Loggable<Logger::Id::main> {
 public:
   WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks, Event::DispatcherPtr&& dispatcher,
              Network::ConnectionHandlerPtr handler, OverloadManager& overload_manager,
-             Api::Api& api, WorkerStatNames& stat_names);
+             Api::Api& api, WorkerStatNames& stat_names, absl::optional<uint32_t> cpu);
 
   // Server::Worker
   void addListener(absl::optional<uint64_t> overridden_listener, Network::ListenerConfig& listener,
@@ -69,10 +89,15 @@ public:
                     std::function<void()> completion) override;
 
 private:
+  friend class WorkerImplTest;
+
   void threadRoutine(OptRef<GuardDog> guard_dog, const std::function<void()>& cb);
+  void pinToCpu();
   void stopAcceptingConnectionsCb(OverloadActionState state);
   void rejectIncomingConnectionsCb(OverloadActionState state);
   void resetStreamsUsingExcessiveMemory(OverloadActionState state);
+  void shrinkBufferCacheCb(OverloadActionState state);
+  void flushBufferStats();
 
   ThreadLocal::Instance& tls_;
   ListenerHooks& hooks_;
@@ -80,8 +105,16 @@ private:
   Network::ConnectionHandlerPtr handler_;
   Api::Api& api_;
   Stats::Counter& reset_streams_counter_;
+  // The CPU the worker thread is pinned to, if any.
+  const absl::optional<uint32_t> cpu_;
   Thread::ThreadPtr thread_;
   WatchDogSharedPtr watch_dog_;
+  // Only accessed on the worker thread.
+  std::unique_ptr<WorkerBufferStats> buffer_stats_;
+  // The slice allocator stats of the worker thread as of the last flush.
+  Buffer::SliceAllocator::Stats flushed_buffer_stats_;
+  Event::TimerPtr buffer_stats_flush_timer_;
+  bool shrink_buffer_cache_{false};
 };
 
 } // namespace Server
@@ -4,6 +4,7 @@
 
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
+#include "source/common/memory/stats.h"
 
 #include "test/test_common/environment.h"
 #include "test/test_common/test_runtime.h"
@@ -16,6 +17,22 @@ using namespace Envoy;
 static bool skip_expensive_benchmarks = false;
 static std::function<void()> cleanup_hook = []() {};
 
+// Reports how much the allocated heap grew over the extra run Google Benchmark makes for memory
+// measurements, e.g. to catch a benchmark which started to retain memory. This relies on the
+// allocator statistics, so it reports no growth in builds without tcmalloc.
+class HeapGrowthMemoryManager : public ::benchmark::MemoryManager {
+public:
+  void Start() override { allocated_at_start_ = Memory::Stats::totalCurrentlyAllocated(); }
+
+  void Stop(Result& result) override {
+    result.net_heap_growth = static_cast<int64_t>(Memory::Stats::totalCurrentlyAllocated()) -
+                             static_cast<int64_t>(allocated_at_start_);
+  }
+
+private:
+  uint64_t allocated_at_start_{};
+};
+
 // Boilerplate main(), which discovers benchmarks and runs them. This uses two
 // different flag parsers, so the order of flags matters: flags defined here
 // must be passed first, and flags defined in benchmark::Initialize second,
@@ -58,6 +75,9 @@ int main(int argc, char** argv) {
   TCLAP::CmdLine cmd("envoy-benchmark-test", ' ', "0.1");
   TCLAP::SwitchArg skip_switch("s", "skip_expensive_benchmarks",
                                "skip or minimize expensive benchmarks", cmd, false);
+  TCLAP::SwitchArg heap_growth_switch(
+      "m", "report_heap_growth",
+      "report the heap growth of each benchmark, in the JSON output format", cmd, false);
   TCLAP::MultiArg<std::string> runtime_features(
       "r", "runtime_feature", "runtime feature settings each of the form: <flag_name>:<flag_value>",
       false, "string", cmd);
@@ -103,7 +123,12 @@ int main(int argc, char** argv) {
         critical,
         "Expensive benchmarks are being skipped; see test/README.md for more information");
   }
+  HeapGrowthMemoryManager memory_manager;
+  if (heap_growth_switch.getValue()) {
+    ::benchmark::RegisterMemoryManager(&memory_manager);
+  }
   ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::RegisterMemoryManager(nullptr);
   cleanup_hook();
 }
 
@@ -11,6 +11,7 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/synchronization/notification.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -442,6 +443,96 @@ TEST_F(AccessLogManagerImplTest, BigDataChunkShouldBeFlushedWithoutTimer) {
   EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+TEST_F(AccessLogManagerImplTest, DropWritesBeyondBufferLimit) {
+  AccessLogManagerImpl access_log_manager(timeout_40ms_, api_, dispatcher_, lock_, store_,
+                                          {8, false});
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  std::vector<std::string> written;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        written.emplace_back(data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  // The first write is flushed right away.
+  log_file->write("prime");
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 1));
+  waitForGaugeEq("filesystem.write_total_buffered", 0);
+
+  log_file->write("1234");
+  log_file->write("5678");
+  log_file->write("9");
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_dropped").value());
+  EXPECT_EQ(3UL, store_.counter("filesystem.write_buffered").value());
+
+  log_file->flush();
+  log_file->write("9");
+  log_file->flush();
+  EXPECT_EQ(std::vector<std::string>({"prime", "12345678", "9"}), written);
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_dropped").value());
+  EXPECT_EQ(0UL, store_.counter("filesystem.write_blocked").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerImplTest, BlockWritesBeyondBufferLimit) {
+  NiceMock<Event::MockTimer>* timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  AccessLogManagerImpl access_log_manager(timeout_40ms_, api_, dispatcher_, lock_, store_,
+                                          {8, true});
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  absl::Notification disk_stalled;
+  absl::Notification disk_unstalled;
+  Sequence sq;
+  EXPECT_CALL(*file_, write_(_))
+      .InSequence(sq)
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  EXPECT_CALL(*file_, write_(_))
+      .InSequence(sq)
+      .WillOnce(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ("1234", data);
+        disk_stalled.Notify();
+        disk_unstalled.WaitForNotification();
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  EXPECT_CALL(*file_, write_(_))
+      .InSequence(sq)
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ("56789", data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  log_file->write("prime");
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 1));
+  waitForGaugeEq("filesystem.write_total_buffered", 0);
+
+  // The flush thread stalls while writing "1234", so a write which does not fit next to it waits.
+  log_file->write("1234");
+  timer->invokeCallback();
+  disk_stalled.WaitForNotification();
+  Thread::ThreadPtr writer = thread_factory_.createThread([&]() { log_file->write("56789"); });
+  waitForCounterEq("filesystem.write_blocked", 1);
+
+  disk_unstalled.Notify();
+  writer->join();
+  log_file->flush();
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 3));
+  EXPECT_EQ(0UL, store_.counter("filesystem.write_dropped").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
 
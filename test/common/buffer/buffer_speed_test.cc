@@ -423,6 +423,33 @@ static void bufferSearchPartialMatch(benchmark::State& state) {
 }
 BENCHMARK(bufferSearchPartialMatch)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
 
+// Test buffer search in a buffer made of small slices, where the pattern and its partial matches
+// span slice boundaries.
+static void bufferSearchAcrossSlices(benchmark::State& state) {
+  const std::string Pattern(16, 'b');
+  const std::string PartialMatch("babbabbbabbbbabbbbbabbbbbbabbbbbbbabbbbbbbba");
+  std::string data;
+  size_t num_partial_matches = 1 + state.range(0) / PartialMatch.length();
+  data.reserve(PartialMatch.length() * num_partial_matches + Pattern.length());
+  for (size_t i = 0; i < num_partial_matches; i++) {
+    data += PartialMatch;
+  }
+  data += Pattern;
+
+  constexpr size_t SliceSize = 37;
+  Buffer::OwnedImpl buffer;
+  for (size_t i = 0; i < data.size(); i += SliceSize) {
+    buffer.appendSliceForTest(absl::string_view(data).substr(i, SliceSize));
+  }
+  ssize_t result = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    result += buffer.search(Pattern.c_str(), Pattern.length(), 0, 0);
+  }
+  benchmark::DoNotOptimize(result);
+}
+BENCHMARK(bufferSearchAcrossSlices)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
+
 // Test buffer startsWith, for the simple case where there is no match for the pattern at the start
 // of the buffer.
 static void bufferStartsWith(benchmark::State& state) {
@@ -1000,6 +1000,21 @@ TEST_F(OwnedImplTest, SearchWithLengthLimit) {
   EXPECT_EQ(12, buffer.search("ba", 2, 11, 10e6));
 }
 
+TEST_F(OwnedImplTest, SearchWithinSlice) {
+  Buffer::OwnedImpl buffer;
+  buffer.appendSliceForTest("abcabdabcabe");
+
+  EXPECT_EQ(3, buffer.search("abd", 3, 0, 0));
+  EXPECT_EQ(9, buffer.search("abe", 3, 0, 0));
+  EXPECT_EQ(9, buffer.search("abe", 3, 4, 0));
+  EXPECT_EQ(-1, buffer.search("abf", 3, 0, 0));
+  // The needle fits in the slice, but not in the searched length.
+  EXPECT_EQ(-1, buffer.search("abd", 3, 0, 5));
+  EXPECT_EQ(3, buffer.search("abd", 3, 0, 6));
+  EXPECT_EQ(-1, buffer.search("abe", 3, 6, 5));
+  EXPECT_EQ(9, buffer.search("abe", 3, 6, 6));
+}
+
 TEST_F(OwnedImplTest, StartsWith) {
   // Populate a buffer with a string split across many small slices, to
   // exercise edge cases in the startsWith implementation.
@@ -0,0 +1,90 @@
+#include "source/common/buffer/slice_allocator.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+TEST(SliceAllocatorTest, ReuseCachedStorage) {
+  SliceAllocator::releaseFreeMemory();
+  const SliceAllocator::Stats& stats = SliceAllocator::threadStats();
+  const uint64_t cache_hits = stats.cache_hits_;
+  const uint64_t heap_allocations = stats.heap_allocations_;
+
+  uint8_t* mem = SliceAllocator::allocate(4096);
+  EXPECT_EQ(heap_allocations + 1, stats.heap_allocations_);
+  SliceAllocator::deallocate(mem, 4096);
+  EXPECT_EQ(4096, stats.cached_bytes_);
+
+  // Storage of the same size class is reused, other size classes go to the heap.
+  EXPECT_EQ(mem, SliceAllocator::allocate(4096));
+  EXPECT_EQ(cache_hits + 1, stats.cache_hits_);
+  EXPECT_EQ(0, stats.cached_bytes_);
+  uint8_t* other = SliceAllocator::allocate(8192);
+  EXPECT_EQ(heap_allocations + 2, stats.heap_allocations_);
+
+  SliceAllocator::deallocate(mem, 4096);
+  SliceAllocator::deallocate(other, 8192);
+  EXPECT_EQ(4096 + 8192, stats.cached_bytes_);
+}
+
+TEST(SliceAllocatorTest, LargeStorageIsNotCached) {
+  SliceAllocator::releaseFreeMemory();
+  const SliceAllocator::Stats& stats = SliceAllocator::threadStats();
+
+  uint8_t* mem = SliceAllocator::allocate(SliceAllocator::MaxCachedSize + 4096);
+  SliceAllocator::deallocate(mem, SliceAllocator::MaxCachedSize + 4096);
+  EXPECT_EQ(0, stats.cached_bytes_);
+
+  SliceAllocator::deallocate(nullptr, 4096);
+  EXPECT_EQ(0, stats.cached_bytes_);
+}
+
+TEST(SliceAllocatorTest, CacheIsBounded) {
+  SliceAllocator::releaseFreeMemory();
+  const SliceAllocator::Stats& stats = SliceAllocator::threadStats();
+
+  constexpr uint64_t size = SliceAllocator::MaxCachedSize;
+  constexpr uint64_t max_cached = SliceAllocator::MaxCachedBytesPerSizeClass / size;
+  std::vector<uint8_t*> storages;
+  for (uint64_t i = 0; i < max_cached + 2; i++) {
+    storages.push_back(SliceAllocator::allocate(size));
+  }
+  for (uint8_t* mem : storages) {
+    SliceAllocator::deallocate(mem, size);
+  }
+  EXPECT_EQ(max_cached * size, stats.cached_bytes_);
+}
+
+TEST(SliceAllocatorTest, ReleaseFreeMemory) {
+  SliceAllocator::releaseFreeMemory();
+  const SliceAllocator::Stats& stats = SliceAllocator::threadStats();
+  const uint64_t released_bytes = stats.released_bytes_;
+
+  SliceAllocator::deallocate(SliceAllocator::allocate(4096), 4096);
+  SliceAllocator::deallocate(SliceAllocator::allocate(16384), 16384);
+  EXPECT_EQ(4096 + 16384, SliceAllocator::releaseFreeMemory());
+  EXPECT_EQ(0, stats.cached_bytes_);
+  EXPECT_EQ(released_bytes + 4096 + 16384, stats.released_bytes_);
+  EXPECT_EQ(0, SliceAllocator::releaseFreeMemory());
+}
+
+TEST(SliceAllocatorTest, PerThreadCache) {
+  SliceAllocator::releaseFreeMemory();
+  uint8_t* mem = SliceAllocator::allocate(4096);
+
+  // Storage released on another thread is cached by that thread.
+  Thread::ThreadPtr thread = Thread::threadFactoryForTest().createThread([mem]() {
+    SliceAllocator::deallocate(mem, 4096);
+    EXPECT_EQ(4096, SliceAllocator::threadStats().cached_bytes_);
+  });
+  thread->join();
+  EXPECT_EQ(0, SliceAllocator::threadStats().cached_bytes_);
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,96 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "source/common/common/logger.h"
+#include "source/common/common/logger_delegates.h"
+
+#include "test/test_common/logging.h"
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::HasSubstr;
+
+namespace Envoy {
+namespace Logger {
+namespace {
+
+// Long enough for the background thread not to drain during a test.
+constexpr std::chrono::milliseconds NoBackgroundDrain = std::chrono::hours(1);
+
+class AsyncSinkDelegateTest : public testing::Test {
+protected:
+  LogLevelSetter save_levels_{spdlog::level::info};
+  LogRecordingSink recorder_{Registry::getSink()};
+};
+
+TEST_F(AsyncSinkDelegateTest, WritesLinesToPreviousDelegate) {
+  {
+    AsyncSinkDelegate async_sink(Registry::getSink(), Thread::threadFactoryForTest(),
+                                 AsyncLogOverflowPolicy::Drop);
+    ENVOY_LOG_MISC(info, "first line");
+    ENVOY_LOG_MISC(info, "second line");
+    async_sink.flush();
+    EXPECT_THAT(recorder_.messages(),
+                ElementsAre(HasSubstr("first line"), HasSubstr("second line")));
+
+    // Lines logged before destruction are written out by it.
+    ENVOY_LOG_MISC(info, "third line");
+  }
+  EXPECT_THAT(recorder_.messages(), ElementsAre(HasSubstr("first line"), HasSubstr("second line"),
+                                                HasSubstr("third line")));
+}
+
+TEST_F(AsyncSinkDelegateTest, DropsLinesWhenFull) {
+  AsyncSinkDelegate async_sink(Registry::getSink(), Thread::threadFactoryForTest(),
+                               AsyncLogOverflowPolicy::Drop, 2, NoBackgroundDrain);
+  ENVOY_LOG_MISC(info, "line 1");
+  ENVOY_LOG_MISC(info, "line 2");
+  ENVOY_LOG_MISC(info, "line 3");
+  EXPECT_EQ(1, async_sink.droppedMessages());
+
+  async_sink.flush();
+  EXPECT_THAT(recorder_.messages(), ElementsAre(HasSubstr("line 1"), HasSubstr("line 2"),
+                                                HasSubstr("dropped 1 log lines")));
+}
+
+TEST_F(AsyncSinkDelegateTest, BlocksWhenFull) {
+  AsyncSinkDelegate async_sink(Registry::getSink(), Thread::threadFactoryForTest(),
+                               AsyncLogOverflowPolicy::Block, 2, NoBackgroundDrain);
+  for (int i = 0; i < 5; ++i) {
+    ENVOY_LOG_MISC(info, "line {}", i);
+  }
+  EXPECT_EQ(0, async_sink.droppedMessages());
+
+  async_sink.flush();
+  EXPECT_THAT(recorder_.messages(),
+              ElementsAre(HasSubstr("line 0"), HasSubstr("line 1"), HasSubstr("line 2"),
+                          HasSubstr("line 3"), HasSubstr("line 4")));
+}
+
+TEST_F(AsyncSinkDelegateTest, WritesLinesOfAllThreads) {
+  AsyncSinkDelegate async_sink(Registry::getSink(), Thread::threadFactoryForTest(),
+                               AsyncLogOverflowPolicy::Block, 4);
+  std::vector<Thread::ThreadPtr> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.push_back(Thread::threadFactoryForTest().createThread([i]() {
+      for (int j = 0; j < 10; ++j) {
+        ENVOY_LOG_MISC(info, "thread {} line {}", i, j);
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+
+  async_sink.flush();
+  EXPECT_EQ(40, recorder_.messages().size());
+  EXPECT_EQ(0, async_sink.droppedMessages());
+}
+
+} // namespace
+} // namespace Logger
+} // namespace Envoy
@@ -0,0 +1,62 @@
+#include <list>
+#include <string>
+
+#include "source/common/common/node_arena.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+TEST(NodeArenaTest, ReuseReleasedNodes) {
+  NodeArena arena;
+  void* first = arena.allocate(32);
+  void* second = arena.allocate(32);
+  EXPECT_NE(first, second);
+
+  arena.deallocate(first, 32);
+  EXPECT_EQ(first, arena.allocate(32));
+  arena.deallocate(second, 32);
+  arena.deallocate(first, 32);
+}
+
+TEST(NodeArenaTest, NodesOfAChunkAreContiguous) {
+  NodeArena arena;
+  char* first = static_cast<char*>(arena.allocate(48));
+  for (size_t i = 1; i < NodeArena::FirstChunkNodes; ++i) {
+    EXPECT_EQ(first + i * 48, arena.allocate(48));
+  }
+}
+
+TEST(NodeArenaTest, OtherSizesUseTheHeap) {
+  NodeArena arena;
+  void* node = arena.allocate(32);
+  void* other = arena.allocate(64);
+  arena.deallocate(other, 64);
+  // The arena did not take the larger allocation onto its free list.
+  EXPECT_NE(other, arena.allocate(32));
+  arena.deallocate(node, 32);
+}
+
+TEST(NodeArenaTest, List) {
+  NodeArena arena;
+  std::list<std::string, NodeArenaAllocator<std::string>> list{
+      NodeArenaAllocator<std::string>(arena)};
+  for (int i = 0; i < 1000; ++i) {
+    list.push_back(std::string(100, 'a' + i % 26));
+  }
+  EXPECT_EQ(1000, list.size());
+  for (int i = 0; i < 500; ++i) {
+    list.pop_front();
+  }
+  for (int i = 0; i < 500; ++i) {
+    list.push_front(std::to_string(i));
+  }
+  EXPECT_EQ("499", list.front());
+  EXPECT_EQ(std::string(100, 'a' + 999 % 26), list.back());
+  list.clear();
+  EXPECT_TRUE(list.empty());
+}
+
+} // namespace
+} // namespace Envoy
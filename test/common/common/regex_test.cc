@@ -138,6 +138,30 @@ TEST(Utility, ParseRegex) {
   }
 }
 
+TEST(GoogleReEngine, SharesCompiledRegexes) {
+  GoogleReEngine engine;
+  CompiledMatcherPtr first = engine.matcher("/asdf/.*");
+  CompiledMatcherPtr second = engine.matcher("/asdf/.*");
+  CompiledMatcherPtr other = engine.matcher("/qwer/.*");
+  const auto& first_regex = dynamic_cast<CompiledGoogleReMatcher&>(*first).regex();
+  EXPECT_EQ(first_regex, dynamic_cast<CompiledGoogleReMatcher&>(*second).regex());
+  EXPECT_NE(first_regex, dynamic_cast<CompiledGoogleReMatcher&>(*other).regex());
+  EXPECT_TRUE(second->match("/asdf/1"));
+  EXPECT_FALSE(second->match("/qwer/1"));
+
+  // Released regexes are compiled again.
+  std::weak_ptr<const re2::RE2> released = first_regex;
+  first.reset();
+  second.reset();
+  EXPECT_TRUE(released.expired());
+  CompiledMatcherPtr third = engine.matcher("/asdf/.*");
+  EXPECT_TRUE(third->match("/asdf/1"));
+
+  // Invalid regexes are not remembered.
+  EXPECT_THROW(engine.matcher("(+invalid)"), EnvoyException);
+  EXPECT_THROW(engine.matcher("(+invalid)"), EnvoyException);
+}
+
 } // namespace
 } // namespace Regex
 } // namespace Envoy
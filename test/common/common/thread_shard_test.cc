@@ -0,0 +1,33 @@
+#include <cstdint>
+#include <set>
+
+#include "source/common/common/thread_shard.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+TEST(ThreadShardTest, ThreadsKeepTheirShard) {
+  const uint32_t shard = threadShardIndex<3>();
+  EXPECT_LT(shard, 3);
+  EXPECT_EQ(shard, threadShardIndex<3>());
+}
+
+TEST(ThreadShardTest, ThreadsAreAssignedRoundRobin) {
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  std::set<uint32_t> shards;
+  for (int i = 0; i < 3; ++i) {
+    uint32_t shard = 0;
+    Thread::ThreadPtr thread =
+        thread_factory.createThread([&shard]() { shard = threadShardIndex<3>(); });
+    thread->join();
+    shards.insert(shard);
+  }
+  EXPECT_EQ((std::set<uint32_t>{0, 1, 2}), shards);
+}
+
+} // namespace
+} // namespace Envoy
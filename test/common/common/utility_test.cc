@@ -1102,6 +1102,44 @@ TEST(TrieLookupTable, LongestPrefix) {
   EXPECT_EQ(nullptr, trie.findLongestPrefix(" "));
 }
 
+TEST(PerfectHashLookupTable, Empty) {
+  PerfectHashLookupTable<int> table;
+  EXPECT_EQ(0, table.size());
+  EXPECT_EQ(nullptr, table.find(""));
+  EXPECT_EQ(nullptr, table.find("foo"));
+}
+
+TEST(PerfectHashLookupTable, FindItems) {
+  PerfectHashLookupTable<int> table({{"foo", 1}, {"bar", 2}, {"", 3}});
+  EXPECT_EQ(3, table.size());
+  EXPECT_EQ(1, *table.find("foo"));
+  EXPECT_EQ(2, *table.find("bar"));
+  EXPECT_EQ(3, *table.find(""));
+  EXPECT_EQ(nullptr, table.find("fo"));
+  EXPECT_EQ(nullptr, table.find("foos"));
+  EXPECT_EQ(nullptr, table.find("baz"));
+}
+
+TEST(PerfectHashLookupTable, ManyItems) {
+  std::vector<std::pair<std::string, int>> entries;
+  for (int i = 0; i < 1000; ++i) {
+    entries.emplace_back(absl::StrCat("x-header-", i), i);
+  }
+  PerfectHashLookupTable<int> table(entries);
+  EXPECT_EQ(1000, table.size());
+  for (int i = 0; i < 1000; ++i) {
+    const int* value = table.find(absl::StrCat("x-header-", i));
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(i, *value);
+    EXPECT_EQ(nullptr, table.find(absl::StrCat("y-header-", i)));
+  }
+}
+
+TEST(PerfectHashLookupTable, DuplicateKeys) {
+  EXPECT_DEATH(PerfectHashLookupTable<int>({{"foo", 1}, {"foo", 2}}),
+               "unable to build perfect hash lookup table");
+}
+
 TEST(InlineStorageTest, InlineString) {
   InlineStringPtr hello = InlineString::create("Hello, world!");
   EXPECT_EQ("Hello, world!", hello->toStringView());
@@ -6,6 +6,7 @@
 #include "gtest/gtest.h"
 
 using ::testing::InvokeWithoutArgs;
+using ::testing::NiceMock;
 using ::testing::Return;
 
 namespace Envoy {
@@ -112,6 +113,7 @@ TEST(DecodedResourceImplTest, All) {
     EXPECT_EQ("foo", decoded_resource.version());
     EXPECT_THAT(decoded_resource.resource(), ProtoEq(ProtobufWkt::Empty()));
     EXPECT_FALSE(decoded_resource.hasResource());
+    EXPECT_FALSE(decoded_resource.serializedHash().has_value());
   }
 
   {
@@ -147,9 +149,36 @@ TEST(DecodedResourceImplTest, All) {
     EXPECT_EQ("foo", decoded_resource.version());
     EXPECT_THAT(decoded_resource.resource(), ProtoEq(ProtobufWkt::Empty()));
     EXPECT_TRUE(decoded_resource.hasResource());
+    EXPECT_FALSE(decoded_resource.serializedHash().has_value());
   }
 }
 
+// The serialized hash only depends on the serialized resource, with or without a wrapper.
+TEST(DecodedResourceImplTest, SerializedHash) {
+  NiceMock<MockOpaqueResourceDecoder> resource_decoder;
+  ON_CALL(resource_decoder, decodeResource(_))
+      .WillByDefault(InvokeWithoutArgs(
+          []() -> ProtobufTypes::MessagePtr { return std::make_unique<ProtobufWkt::Empty>(); }));
+  ON_CALL(resource_decoder, resourceName(_)).WillByDefault(Return("some_name"));
+
+  ProtobufWkt::Any resource;
+  resource.PackFrom(ValueUtil::stringValue("foo"));
+  ProtobufWkt::Any other_resource;
+  other_resource.PackFrom(ValueUtil::stringValue("bar"));
+  envoy::service::discovery::v3::Resource resource_wrapper;
+  resource_wrapper.set_name("some_name");
+  resource_wrapper.mutable_resource()->MergeFrom(resource);
+
+  const absl::optional<uint64_t> hash =
+      DecodedResourceImpl::fromResource(resource_decoder, resource, "1")->serializedHash();
+  ASSERT_TRUE(hash.has_value());
+  EXPECT_EQ(hash,
+            DecodedResourceImpl::fromResource(resource_decoder, resource, "2")->serializedHash());
+  EXPECT_EQ(hash, DecodedResourceImpl(resource_decoder, resource_wrapper).serializedHash());
+  EXPECT_NE(hash, DecodedResourceImpl::fromResource(resource_decoder, other_resource, "1")
+                      ->serializedHash());
+}
+
 } // namespace
 } // namespace Config
 } // namespace Envoy
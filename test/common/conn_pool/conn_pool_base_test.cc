@@ -82,6 +82,7 @@ public:
 class TestConnPoolImplBase : public ConnPoolImplBase {
 public:
   using ConnPoolImplBase::ConnPoolImplBase;
+  using ConnPoolImplBase::readyStreamCapacity;
   ConnectionPool::Cancellable* newPendingStream(AttachContext& context,
                                                 bool can_send_early_data) override {
     auto entry = std::make_unique<TestPendingStream>(*this, context, can_send_early_data);
@@ -453,6 +454,40 @@ TEST_F(ConnPoolImplDispatcherBaseTest, MaxConnectionDurationCallbackWhileConnect
   pool_.destructAllConnections();
 }
 
+// With adaptive preconnect, a stream arriving more often than a connection takes to establish
+// triggers an extra connection.
+TEST_F(ConnPoolImplDispatcherBaseTest, AdaptivePreconnect) {
+  ON_CALL(*cluster_, adaptivePreconnect).WillByDefault(Return(true));
+
+  // Without any samples, only the connection for the new stream is created.
+  EXPECT_CALL(pool_, instantiateActiveClient);
+  pool_.newStreamImpl(context_, /*can_send_early_data=*/false);
+  ASSERT_EQ(1, clients_.size());
+
+  // The connection takes 10ms to establish.
+  advanceTimeAndRun(10);
+  EXPECT_CALL(pool_, onPoolReady);
+  clients_.back()->onEvent(Network::ConnectionEvent::Connected);
+  EXPECT_EQ(ActiveClient::State::Busy, clients_.back()->state());
+
+  // The next stream arrives 5ms later, so one more stream is anticipated while a connection is
+  // established: one connection is created for the pending stream and one is preconnected.
+  advanceTimeAndRun(5);
+  EXPECT_CALL(pool_, instantiateActiveClient).Times(2);
+  pool_.newStreamImpl(context_, /*can_send_early_data=*/false);
+  ASSERT_EQ(3, clients_.size());
+
+  // The pending stream is served by the first connection to be established, leaving the
+  // preconnected one ready for the next stream.
+  EXPECT_CALL(pool_, onPoolReady);
+  clients_[1]->onEvent(Network::ConnectionEvent::Connected);
+  clients_[2]->onEvent(Network::ConnectionEvent::Connected);
+  EXPECT_EQ(ActiveClient::State::Busy, clients_[1]->state());
+  EXPECT_EQ(ActiveClient::State::Ready, clients_[2]->state());
+
+  pool_.destructAllConnections();
+}
+
 // Test the behavior of a client created with 0 zero streams available.
 TEST_F(ConnPoolImplDispatcherBaseTest, NoAvailableStreams) {
   // Start with a concurrent stream limit of 0.
@@ -473,6 +508,38 @@ TEST_F(ConnPoolImplDispatcherBaseTest, NoAvailableStreams) {
   pool_.destructAllConnections();
 }
 
+// The ready stream capacity follows the streams of ready clients and their state changes.
+TEST_F(ConnPoolImplBaseTest, ReadyStreamCapacity) {
+  concurrent_streams_ = 3;
+  EXPECT_CALL(pool_, instantiateActiveClient);
+  pool_.newStreamImpl(context_, /*can_send_early_data=*/false);
+  ASSERT_EQ(1, clients_.size());
+  EXPECT_EQ(0, pool_.readyStreamCapacity());
+
+  EXPECT_CALL(pool_, onPoolReady);
+  clients_.back()->onEvent(Network::ConnectionEvent::Connected);
+  EXPECT_EQ(ActiveClient::State::Ready, clients_.back()->state());
+  EXPECT_EQ(2, pool_.readyStreamCapacity());
+
+  EXPECT_CALL(pool_, onPoolReady).Times(2);
+  pool_.newStreamImpl(context_, /*can_send_early_data=*/false);
+  EXPECT_EQ(1, pool_.readyStreamCapacity());
+  pool_.newStreamImpl(context_, /*can_send_early_data=*/false);
+  EXPECT_EQ(ActiveClient::State::Busy, clients_.back()->state());
+  EXPECT_EQ(0, pool_.readyStreamCapacity());
+
+  while (clients_.back()->active_streams_ > 0) {
+    --clients_.back()->active_streams_;
+    pool_.onStreamClosed(*clients_.back(), false);
+    EXPECT_EQ(ActiveClient::State::Ready, clients_.back()->state());
+    EXPECT_EQ(3 - clients_.back()->active_streams_, pool_.readyStreamCapacity());
+  }
+
+  clients_.back()->onEvent(Network::ConnectionEvent::RemoteClose);
+  EXPECT_EQ(0, pool_.readyStreamCapacity());
+  dispatcher_.clearDeferredDeleteList();
+}
+
 // Verify that not fully connected active client calls
 // idle callbacks upon destruction.
 TEST_F(ConnPoolImplBaseTest, PoolIdleNotConnected) {
@@ -386,10 +386,16 @@ protected:
 // TODO(mergeconflict): We also need integration testing to validate that the expected histograms
 // are written when `enable_dispatcher_stats` is true. See issue #6582.
 TEST_F(DispatcherImplTest, InitializeStats) {
+  EXPECT_CALL(store_, histogram("test.dispatcher.deferred_delete_duration_us",
+                                Stats::Histogram::Unit::Microseconds));
   EXPECT_CALL(store_,
               histogram("test.dispatcher.loop_duration_us", Stats::Histogram::Unit::Microseconds));
   EXPECT_CALL(store_,
               histogram("test.dispatcher.poll_delay_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.post_duration_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.post_queue_size", Stats::Histogram::Unit::Unspecified));
   dispatcher_->initializeStats(scope_, "test.");
 }
 
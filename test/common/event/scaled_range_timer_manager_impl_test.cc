@@ -389,6 +389,27 @@ TEST_F(ScaledRangeTimerManagerTest, SingleTimerSameMinMax) {
   EXPECT_FALSE(timer->enabled());
 }
 
+TEST_F(ScaledRangeTimerManagerTest, SameMinMaxTimerIgnoresScaleFactor) {
+  ScaledRangeTimerManagerImpl manager(dispatcher_);
+
+  MockFunction<TimerCb> callback;
+  auto timer = manager.createTimer(ScaledMinimum(UnitFloat(1.0)), callback.AsStdFunction());
+
+  timer->enableTimer(std::chrono::seconds(10));
+  manager.setScaleFactor(UnitFloat(0.5));
+  simTime().advanceTimeAndRun(std::chrono::seconds(6), dispatcher_, Dispatcher::RunType::Block);
+  EXPECT_TRUE(timer->enabled());
+
+  // Re-enabling the timer restarts its duration.
+  timer->enableTimer(std::chrono::seconds(10));
+  simTime().advanceTimeAndRun(std::chrono::seconds(9), dispatcher_, Dispatcher::RunType::Block);
+  EXPECT_TRUE(timer->enabled());
+
+  EXPECT_CALL(callback, Call());
+  simTime().advanceTimeAndRun(std::chrono::seconds(1), dispatcher_, Dispatcher::RunType::Block);
+  EXPECT_FALSE(timer->enabled());
+}
+
 TEST_F(ScaledRangeTimerManagerTest, ScaledMinimumFactorGreaterThan1) {
   ScaledRangeTimerManagerImpl manager(dispatcher_);
 
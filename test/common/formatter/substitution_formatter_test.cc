@@ -3782,6 +3782,56 @@ TEST(SubstitutionFormatterTest, JsonFormatterWithOrderedPropertiesTest) {
   EXPECT_EQ(out_json, expected);
 }
 
+TEST(SubstitutionFormatterTest, JsonFormatterOmitsEmptyValuesTest) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{"first", "quoted \"value\""}};
+  HttpFormatterContext formatter_context(&request_header);
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    present: '%REQ(first)%'
+    absent: '%REQ(missing)%'
+    empty_level:
+      absent: '%REQ(missing)%'
+    list:
+      - '%REQ(missing)%'
+      - '%REQ(first)%'
+      - absent: '%REQ(missing)%'
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl formatter(key_mapping, false, true, false);
+
+  EXPECT_EQ("{\"list\":[\"quoted \\\"value\\\"\"],\"present\":\"quoted \\\"value\\\"\"}\n",
+            formatter.formatWithContext(formatter_context, stream_info));
+}
+
+TEST(SubstitutionFormatterTest, JsonFormatterPreservesTypesTest) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header;
+  HttpFormatterContext formatter_context(&request_header);
+
+  envoy::config::core::v3::Metadata metadata;
+  populateMetadataTestData(metadata);
+  EXPECT_CALL(Const(stream_info), dynamicMetadata()).WillRepeatedly(ReturnRef(metadata));
+  EXPECT_CALL(stream_info, responseCode()).WillRepeatedly(Return(200));
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    code: '%RESPONSE_CODE%'
+    metadata: '%DYNAMIC_METADATA(com.test)%'
+    missing: '%REQ(missing)%'
+    number: 2.5
+    text: plain
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl formatter(key_mapping, true, false, true);
+
+  EXPECT_EQ("{\"code\":200,\"metadata\":{\"test_key\":\"test_value\",\"test_obj\":"
+            "{\"inner_key\":\"inner_value\"}},\"missing\":null,\"number\":2.5,"
+            "\"text\":\"plain\"}\n",
+            formatter.formatWithContext(formatter_context, stream_info));
+}
+
 TEST(SubstitutionFormatterTest, CompositeFormatterSuccess) {
   Http::TestRequestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
   Http::TestResponseHeaderMapImpl response_header{{"second", "PUT"}, {"test", "test"}};
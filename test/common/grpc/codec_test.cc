@@ -221,6 +221,31 @@ TEST(GrpcCodecTest, decodeMultipleFrame) {
   }
 }
 
+// Frame data is moved out of the input, keeping the slices it spans.
+TEST(GrpcCodecTest, decodeFrameAcrossSlices) {
+  const std::string data(64 * 1024, 'a');
+  Buffer::OwnedImpl buffer;
+  std::array<uint8_t, 5> header;
+  Encoder encoder;
+  encoder.newFrame(GRPC_FH_DEFAULT, 2 * data.size(), header);
+  buffer.add(header.data(), 2);
+  Buffer::OwnedImpl rest;
+  rest.add(header.data() + 2, 3);
+  rest.add(data);
+  Buffer::OwnedImpl second_slice(data);
+  buffer.move(rest);
+  buffer.move(second_slice);
+
+  std::vector<Frame> frames;
+  Decoder decoder;
+  EXPECT_TRUE(decoder.decode(buffer, frames));
+  EXPECT_EQ(0, buffer.length());
+  ASSERT_EQ(1, frames.size());
+  EXPECT_EQ(2 * data.size(), frames[0].length_);
+  EXPECT_EQ(data + data, frames[0].data_->toString());
+  EXPECT_EQ(2, frames[0].data_->getRawSlices().size());
+}
+
 TEST(GrpcCodecTest, decodeSingleFrameOverLimit) {
   helloworld::HelloRequest request;
   std::string test_str = std::string(64 * 1024, 'a');
@@ -1,3 +1,5 @@
+#include <string>
+
 #include "source/common/http/character_set_validation.h"
 
 #include "gtest/gtest.h"
@@ -33,5 +35,58 @@ TEST(CharacterSetValidationTest, Test) {
   }
 }
 
+size_t referenceFindFirstCharNotInTable(const std::array<uint32_t, 8>& table,
+                                        absl::string_view input) {
+  for (size_t i = 0; i < input.size(); ++i) {
+    if (!testCharInTable(table, input[i])) {
+      return i;
+    }
+  }
+  return absl::string_view::npos;
+}
+
+// Every character at every position of inputs covering the vectorized blocks and the tail.
+void testFindFirstCharNotInTable(const std::array<uint32_t, 8>& table, char filler) {
+  const VectorizedCharTable vectorized_table(table);
+  EXPECT_EQ(absl::string_view::npos, findFirstCharNotInTable(vectorized_table, ""));
+  for (size_t length = 1; length <= 80; ++length) {
+    for (size_t position = 0; position < length; ++position) {
+      for (unsigned c = 0; c < 256; ++c) {
+        std::string input(length, filler);
+        input[position] = static_cast<char>(c);
+        ASSERT_EQ(referenceFindFirstCharNotInTable(table, input),
+                  findFirstCharNotInTable(vectorized_table, input))
+            << "length " << length << " position " << position << " character " << c;
+      }
+    }
+  }
+}
+
+TEST(CharacterSetValidationTest, FindFirstCharNotInTable) {
+  testFindFirstCharNotInTable(kGenericHeaderNameCharTable, 'a');
+  testFindFirstCharNotInTable(kUriQueryAndFragmentCharTable, '=');
+}
+
+TEST(CharacterSetValidationTest, FindFirstCharNotInTableWithExtendedCharacters) {
+  constexpr std::array<uint32_t, 8> kAllButControlCharTable = {
+      0b00000000000000000000000000000000, 0b11111111111111111111111111111111,
+      0b11111111111111111111111111111111, 0b11111111111111111111111111111110,
+      0b11111111111111111111111111111111, 0b11111111111111111111111111111111,
+      0b11111111111111111111111111111111, 0b11111111111111111111111111111111,
+  };
+  testFindFirstCharNotInTable(kAllButControlCharTable, '\xff');
+}
+
+TEST(CharacterSetValidationTest, FindFirstCharNotInTableWithSomeExtendedCharacters) {
+  constexpr std::array<uint32_t, 8> kSomeExtendedCharTable = {
+      0b00000000000000000000000000000000, 0b00000000000000001111111111000000,
+      0b00000000000000000000000000000000, 0b00000000000000000000000000000000,
+      0b00000000000000000000000000000000, 0b11111111111111111111111111111111,
+      0b00000000000000000000000000000000, 0b00000000000000000000000000000000,
+  };
+  testFindFirstCharNotInTable(kSomeExtendedCharTable, '\xa0');
+  testFindFirstCharNotInTable(kSomeExtendedCharTable, '5');
+}
+
 } // namespace Http
 } // namespace Envoy
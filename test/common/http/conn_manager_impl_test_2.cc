@@ -1,5 +1,7 @@
 #include <chrono>
 
+#include "envoy/config/overload/v3/overload.pb.h"
+
 #include "test/common/http/conn_manager_impl_test_base.h"
 #include "test/common/http/custom_header_extension.h"
 #include "test/test_common/logging.h"
@@ -2891,6 +2893,41 @@ TEST_F(HttpConnectionManagerImplTest, TestSessionTrace) {
   filter_callbacks_.connection_.raiseEvent(Network::ConnectionEvent::RemoteClose);
 }
 
+// The header maps of a stream are charged to its buffer memory account until it is destroyed.
+TEST_F(HttpConnectionManagerImplTest, HeadersChargedToStreamAccount) {
+  setup(false, "");
+  envoy::config::overload::v3::BufferFactoryConfig buffer_factory_config;
+  buffer_factory_config.set_minimum_account_to_track_power_of_two(20);
+  Buffer::WatermarkBufferFactory buffer_factory(buffer_factory_config);
+  Buffer::BufferMemoryAccountSharedPtr account =
+      buffer_factory.createAccount(response_encoder_.stream_);
+  EXPECT_CALL(filter_callbacks_.connection_.dispatcher_.buffer_factory_, createAccount(_))
+      .WillOnce(Return(account));
+
+  setupFilterChain(1, 0);
+  uint64_t request_headers_size = 0;
+  EXPECT_CALL(*decoder_filters_[0], decodeHeaders(_, true))
+      .WillOnce(Invoke([&](RequestHeaderMap& headers, bool) -> FilterHeadersStatus {
+        request_headers_size = headers.byteSize();
+        return FilterHeadersStatus::StopIteration;
+      }));
+  EXPECT_CALL(*decoder_filters_[0], decodeComplete());
+  startRequest(true);
+  EXPECT_GT(request_headers_size, 0);
+  EXPECT_LE(account->balance(), request_headers_size);
+  EXPECT_GT(account->balance(), 0);
+
+  std::stringstream out;
+  dynamic_cast<const ScopeTrackedObject&>(*decoder_).dumpState(out);
+  EXPECT_THAT(out.str(), testing::HasSubstr(absl::StrCat("account_balance: ", account->balance())));
+
+  expectOnDestroy();
+  filter_callbacks_.connection_.raiseEvent(Network::ConnectionEvent::RemoteClose);
+  filter_callbacks_.connection_.dispatcher_.to_delete_.clear();
+  EXPECT_EQ(0, account->balance());
+  account->clearDownstream();
+}
+
 // SRDS no scope found.
 TEST_F(HttpConnectionManagerImplTest, TestSrdsRouteNotFound) {
   setup(false, "", true, true);
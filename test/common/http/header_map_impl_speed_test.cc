@@ -1,3 +1,4 @@
+#include "source/common/common/utility.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
 
@@ -295,5 +296,120 @@ static void headerMapImplRemovePrefix(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplRemovePrefix)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
 
+/**
+ * Compare the lookup of the O(1) headers through a trie, which HeaderMapImpl used to do, and
+ * through the perfect hash it uses now. The numeric Arg selects whether the keys are O(1) headers
+ * (0) or other headers (1).
+ */
+static std::vector<std::string> lookupKeys(bool inline_headers) {
+  std::vector<std::string> keys;
+  if (inline_headers) {
+    for (const auto& header :
+         CustomInlineHeaderRegistry::headers<CustomInlineHeaderRegistry::Type::RequestHeaders>()) {
+      keys.push_back(header.first.get());
+    }
+  } else {
+    for (size_t i = 0; i < 20; i++) {
+      keys.push_back("dummy-key-" + std::to_string(i));
+    }
+  }
+  return keys;
+}
+
+static void headerMapImplStaticLookupTrie(benchmark::State& state) {
+  // Make sure that the registry of the O(1) headers is finalized.
+  Http::RequestHeaderMapImpl::create();
+  TrieLookupTable<const LowerCaseString*> trie;
+  for (const auto& header :
+       CustomInlineHeaderRegistry::headers<CustomInlineHeaderRegistry::Type::RequestHeaders>()) {
+    trie.add(header.first.get(), &header.first);
+  }
+  const std::vector<std::string> keys = lookupKeys(state.range(0) == 0);
+  for (auto _ : state) { // NOLINT
+    for (const std::string& key : keys) {
+      benchmark::DoNotOptimize(trie.find(key));
+    }
+  }
+}
+BENCHMARK(headerMapImplStaticLookupTrie)->Arg(0)->Arg(1);
+
+static void headerMapImplStaticLookupPerfectHash(benchmark::State& state) {
+  // Make sure that the registry of the O(1) headers is finalized.
+  Http::RequestHeaderMapImpl::create();
+  std::vector<std::pair<std::string, const LowerCaseString*>> entries;
+  for (const auto& header :
+       CustomInlineHeaderRegistry::headers<CustomInlineHeaderRegistry::Type::RequestHeaders>()) {
+    entries.emplace_back(header.first.get(), &header.first);
+  }
+  const PerfectHashLookupTable<const LowerCaseString*> table(std::move(entries));
+  const std::vector<std::string> keys = lookupKeys(state.range(0) == 0);
+  for (auto _ : state) { // NOLINT
+    for (const std::string& key : keys) {
+      benchmark::DoNotOptimize(table.find(key));
+    }
+  }
+}
+BENCHMARK(headerMapImplStaticLookupPerfectHash)->Arg(0)->Arg(1);
+
+/** Measure the speed of adding a mix of O(1) and other headers by name to a new header map. */
+static void headerMapImplAddCopyInline(benchmark::State& state) {
+  const std::vector<std::pair<LowerCaseString, std::string>> headers_to_add = {
+      {LowerCaseString("host"), "example.com"},
+      {LowerCaseString("user-agent"), "curl/8.0"},
+      {LowerCaseString("accept"), "*/*"},
+      {LowerCaseString("content-type"), "application/grpc"},
+      {LowerCaseString("te"), "trailers"},
+      {LowerCaseString("grpc-timeout"), "1S"},
+      {LowerCaseString("x-request-id"), "01234567890123456789"},
+      {LowerCaseString("x-custom-header"), "value"},
+  };
+  for (auto _ : state) { // NOLINT
+    auto headers = Http::RequestHeaderMapImpl::create();
+    for (const auto& [key, value] : headers_to_add) {
+      headers->addCopy(key, value);
+    }
+    benchmark::DoNotOptimize(headers->size());
+  }
+}
+BENCHMARK(headerMapImplAddCopyInline);
+
+/**
+ * Measure the speed of decoding typical response headers by moving the names and values into a new
+ * header map, and then copying the names out again as the HTTP/2 codec does for its encoder.
+ */
+static void headerMapImplDecodeAndEncodeStaticTableNames(benchmark::State& state) {
+  const std::vector<std::pair<std::string, std::string>> headers_to_add = {
+      {"cache-control", "private, max-age=0"},
+      {"content-encoding", "gzip"},
+      {"date", "Thu, 01 Jan 1970 00:00:00 GMT"},
+      {"etag", "\"0123456789\""},
+      {"expires", "-1"},
+      {"last-modified", "Thu, 01 Jan 1970 00:00:00 GMT"},
+      {"set-cookie", "session=0123456789; path=/"},
+      {"strict-transport-security", "max-age=31536000"},
+      {"vary", "accept-encoding"},
+      {"x-custom-header", "value"},
+  };
+  std::vector<std::string> encoded_names;
+  encoded_names.reserve(headers_to_add.size());
+  for (auto _ : state) { // NOLINT
+    auto headers = Http::ResponseHeaderMapImpl::create();
+    for (const auto& [key, value] : headers_to_add) {
+      HeaderString key_string;
+      key_string.setCopy(key);
+      HeaderString value_string;
+      value_string.setCopy(value);
+      headers->addViaMove(std::move(key_string), std::move(value_string));
+    }
+    encoded_names.clear();
+    headers->iterate([&encoded_names](const HeaderEntry& header) -> HeaderMap::Iterate {
+      encoded_names.emplace_back(header.key().getStringView());
+      return HeaderMap::Iterate::Continue;
+    });
+    benchmark::DoNotOptimize(encoded_names.size());
+  }
+}
+BENCHMARK(headerMapImplDecodeAndEncodeStaticTableNames);
+
 } // namespace Http
 } // namespace Envoy
@@ -475,6 +475,35 @@ TEST(HeaderMapImplTest, SetReferenceKey) {
   EXPECT_EQ("monde", headers.get(foo)[0]->value().getStringView());
 }
 
+// Names of the HPACK and QPACK static tables which are not O(1) headers are stored as references
+// to a single static copy.
+TEST(HeaderMapImplTest, StaticTableNameKeysAreReferences) {
+  TestResponseHeaderMapImpl headers1;
+  TestResponseHeaderMapImpl headers2;
+  headers1.addCopy(LowerCaseString("vary"), "accept-encoding");
+  headers2.addCopy(LowerCaseString("vary"), "origin");
+  headers1.addCopy(LowerCaseString("x-not-static"), "a");
+  headers2.addCopy(LowerCaseString("x-not-static"), "b");
+
+  const auto vary1 = headers1.get(LowerCaseString("vary"));
+  const auto vary2 = headers2.get(LowerCaseString("vary"));
+  ASSERT_EQ(1, vary1.size());
+  ASSERT_EQ(1, vary2.size());
+  EXPECT_EQ("vary", vary1[0]->key().getStringView());
+  EXPECT_EQ(vary1[0]->key().getStringView().data(), vary2[0]->key().getStringView().data());
+  EXPECT_EQ("accept-encoding", vary1[0]->value().getStringView());
+  EXPECT_EQ("origin", vary2[0]->value().getStringView());
+
+  const auto other1 = headers1.get(LowerCaseString("x-not-static"));
+  const auto other2 = headers2.get(LowerCaseString("x-not-static"));
+  EXPECT_NE(other1[0]->key().getStringView().data(), other2[0]->key().getStringView().data());
+
+  // Static table names still behave like any other header.
+  headers1.remove(LowerCaseString("vary"));
+  EXPECT_TRUE(headers1.get(LowerCaseString("vary")).empty());
+  EXPECT_EQ(1, headers1.size());
+}
+
 TEST(HeaderMapImplTest, SetCopy) {
   TestRequestHeaderMapImpl headers;
   LowerCaseString foo("hello");
@@ -195,6 +195,19 @@ TEST(GetAllOfHeaderAsStringTest, All) {
     EXPECT_EQ(ret2.result().value().data(), ret2.backingString().data());
     EXPECT_NE(ret2.result().value().data(), ret.backingString().data());
   }
+  {
+    TestRequestHeaderMapImpl headers{{"test", "foo"}};
+    auto ret = HeaderUtility::getAllOfHeaderAsString(headers, test_header);
+    EXPECT_EQ("foo", std::move(ret).resultAsString());
+  }
+  {
+    TestRequestHeaderMapImpl headers{{"test", "foo"}, {"test", "bar"}};
+    auto ret = HeaderUtility::getAllOfHeaderAsString(headers, test_header);
+    const char* backing_data = ret.backingString().data();
+    const std::string result = std::move(ret).resultAsString();
+    EXPECT_EQ("foo,bar", result);
+    EXPECT_EQ(backing_data, result.data());
+  }
 }
 
 TEST(HeaderDataConstructorTest, NoSpecifierSet) {
@@ -0,0 +1,84 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "source/common/http/http1/balsa_parser.h"
+#include "source/common/http/http1/header_scanner.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+class NullParserCallbacks : public ParserCallbacks {
+public:
+  CallbackResult onMessageBegin() override { return CallbackResult::Success; }
+  CallbackResult onUrl(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onStatus(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onHeaderField(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onHeaderValue(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onHeadersComplete() override { return CallbackResult::Success; }
+  void bufferBody(const char*, size_t) override {}
+  CallbackResult onMessageComplete() override { return CallbackResult::Success; }
+  void onChunkHeader(bool) override {}
+};
+
+// A request as sent by a browser, with the given number of additional headers.
+std::string request(int64_t extra_headers) {
+  std::string request = "GET /static/app/main.js?version=1234 HTTP/1.1\r\n"
+                        "Host: www.example.com\r\n"
+                        "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, "
+                        "like Gecko) Chrome/120.0.0.0 Safari/537.36\r\n"
+                        "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+                        "Accept-Language: en-US,en;q=0.5\r\n"
+                        "Accept-Encoding: gzip, deflate, br\r\n"
+                        "Connection: keep-alive\r\n"
+                        "Cookie: session=0123456789abcdef0123456789abcdef; theme=dark\r\n";
+  for (int64_t i = 0; i < extra_headers; ++i) {
+    absl::StrAppend(&request, "X-Custom-Request-Header-", i, ": ", std::string(48, 'v'), "\r\n");
+  }
+  request += "\r\n";
+  return request;
+}
+
+void bmParseRequest(benchmark::State& state) {
+  const std::string input = request(state.range(0));
+  NullParserCallbacks callbacks;
+  for (auto _ : state) { // NOLINT
+    BalsaParser parser(MessageType::Request, &callbacks, 80 * 1024, /*enable_trailers=*/false,
+                       /*allow_custom_methods=*/false);
+    benchmark::DoNotOptimize(parser.execute(input.data(), input.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+  state.SetLabel(std::string(HeaderScanner::implementationName()));
+}
+BENCHMARK(bmParseRequest)->Arg(0)->Arg(10)->Arg(50);
+
+void bmIsValidToken(benchmark::State& state) {
+  const std::string input(state.range(0), 'x');
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(HeaderScanner::isValidToken(input));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+  state.SetLabel(std::string(HeaderScanner::implementationName()));
+}
+BENCHMARK(bmIsValidToken)->Arg(8)->Arg(32)->Arg(128);
+
+void bmFindCrOrLf(benchmark::State& state) {
+  const std::string input(state.range(0), 'v');
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(HeaderScanner::findCrOrLf(input));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+  state.SetLabel(std::string(HeaderScanner::implementationName()));
+}
+BENCHMARK(bmFindCrOrLf)->Arg(8)->Arg(64)->Arg(512);
+
+} // namespace
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,70 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "source/common/http/http1/codec_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/server/overload_manager.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+// A request with typical browser-like headers and a body of the given size.
+std::string requestPayload(int64_t body_size) {
+  std::string payload = absl::StrCat("POST /api/v1/orders?page=1 HTTP/1.1\r\n"
+                                     "host: host.example.com\r\n"
+                                     "user-agent: Mozilla/5.0 (X11; Linux x86_64)\r\n"
+                                     "accept: application/json\r\n"
+                                     "accept-encoding: gzip, deflate, br\r\n"
+                                     "content-type: application/json\r\n"
+                                     "content-length: ",
+                                     body_size, "\r\n\r\n");
+  payload.append(body_size, 'a');
+  return payload;
+}
+
+// Measures decoding of one request by a fresh server codec. The first argument selects BalsaParser
+// (1) or http-parser (0), the second is the size of the request body.
+void serverDecodeRequest(benchmark::State& state) {
+  Stats::IsolatedStoreImpl stats_store;
+  Http1::CodecStats::AtomicPtr http1_stats;
+  Http1Settings settings;
+  settings.use_balsa_parser_ = state.range(0) != 0;
+  NiceMock<MockRequestDecoder> request_decoder;
+  NiceMock<Network::MockConnection> connection;
+  NiceMock<MockServerConnectionCallbacks> callbacks;
+  ON_CALL(callbacks, newStream(testing::_, testing::_)).WillByDefault(ReturnRef(request_decoder));
+  NiceMock<Server::MockOverloadManager> overload_manager;
+
+  const std::string payload = requestPayload(state.range(1));
+  for (auto _ : state) { // NOLINT
+    ServerConnectionImpl server(connection,
+                                Http1::CodecStats::atomicGet(http1_stats, *stats_store.rootScope()),
+                                callbacks, settings, Http::DEFAULT_MAX_REQUEST_HEADERS_KB,
+                                Http::DEFAULT_MAX_HEADERS_COUNT,
+                                envoy::config::core::v3::HttpProtocolOptions::ALLOW,
+                                overload_manager);
+    Buffer::OwnedImpl data(payload);
+    const Status status = server.dispatch(data);
+    benchmark::DoNotOptimize(status.ok());
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(serverDecodeRequest)->ArgsProduct({{0, 1}, {0, 1024, 64 * 1024}});
+
+} // namespace
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
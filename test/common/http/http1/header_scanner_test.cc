@@ -0,0 +1,76 @@
+#include <string>
+
+#include "source/common/http/character_set_validation.h"
+#include "source/common/http/http1/header_scanner.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+size_t referenceFindCrOrLf(absl::string_view input) { return input.find_first_of("\r\n"); }
+
+bool referenceIsValidToken(absl::string_view input) {
+  for (char c : input) {
+    if (!testCharInTable(kGenericHeaderNameCharTable, c)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(HeaderScannerTest, ImplementationName) {
+  EXPECT_FALSE(HeaderScanner::implementationName().empty());
+}
+
+TEST(HeaderScannerTest, FindCrOrLf) {
+  EXPECT_EQ(absl::string_view::npos, HeaderScanner::findCrOrLf(""));
+  EXPECT_EQ(absl::string_view::npos, HeaderScanner::findCrOrLf("text/html"));
+  EXPECT_EQ(0, HeaderScanner::findCrOrLf("\r\n"));
+  EXPECT_EQ(4, HeaderScanner::findCrOrLf("text\nhtml"));
+}
+
+// Every character at every position of inputs covering the vectorized blocks and the tail.
+TEST(HeaderScannerTest, FindCrOrLfAllPositions) {
+  for (size_t length = 1; length <= 80; ++length) {
+    for (size_t position = 0; position < length; ++position) {
+      for (int c = 0; c < 256; ++c) {
+        std::string input(length, 'a');
+        input[position] = static_cast<char>(c);
+        ASSERT_EQ(referenceFindCrOrLf(input), HeaderScanner::findCrOrLf(input))
+            << "length " << length << " position " << position << " character " << c;
+      }
+    }
+  }
+}
+
+TEST(HeaderScannerTest, IsValidToken) {
+  EXPECT_TRUE(HeaderScanner::isValidToken(""));
+  EXPECT_TRUE(HeaderScanner::isValidToken("content-type"));
+  EXPECT_TRUE(HeaderScanner::isValidToken("X-Forwarded-For"));
+  EXPECT_TRUE(HeaderScanner::isValidToken("x-envoy-upstream-service-time"));
+  EXPECT_TRUE(HeaderScanner::isValidToken("!#$%&'*+-.^_`|~"));
+  EXPECT_FALSE(HeaderScanner::isValidToken("content type"));
+  EXPECT_FALSE(HeaderScanner::isValidToken("x-envoy-upstream-service-time:"));
+  EXPECT_FALSE(HeaderScanner::isValidToken("x-envoy-upstream-service-\xe9"));
+}
+
+TEST(HeaderScannerTest, IsValidTokenAllPositions) {
+  for (size_t length = 1; length <= 80; ++length) {
+    for (size_t position = 0; position < length; ++position) {
+      for (int c = 0; c < 256; ++c) {
+        std::string input(length, 'a');
+        input[position] = static_cast<char>(c);
+        ASSERT_EQ(referenceIsValidToken(input), HeaderScanner::isValidToken(input))
+            << "length " << length << " position " << position << " character " << c;
+      }
+    }
+  }
+}
+
+} // namespace
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
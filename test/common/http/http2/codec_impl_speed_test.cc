@@ -0,0 +1,81 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+#include <vector>
+
+#include "source/common/http/http2/codec_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/common/http/http2/http2_frame.h"
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/server/overload_manager.h"
+#include "test/test_common/test_runtime.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http2 {
+namespace {
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+// The client side of a connection carrying the given number of small header-only requests, as
+// seen on gRPC-heavy mesh traffic.
+std::string clientPayload(int64_t num_streams) {
+  std::string payload(Http2Frame::Preamble, 24);
+  const Http2Frame settings = Http2Frame::makeEmptySettingsFrame();
+  payload.append(reinterpret_cast<const char*>(settings.data()), settings.size());
+  for (int64_t i = 0; i < num_streams; ++i) {
+    const Http2Frame request =
+        Http2Frame::makeRequest(Http2Frame::makeClientStreamId(i), "host.example.com",
+                                "/package.Service/Method",
+                                {{"content-type", "application/grpc"}, {"te", "trailers"}});
+    payload.append(reinterpret_cast<const char*>(request.data()), request.size());
+  }
+  return payload;
+}
+
+// Measures decoding of many small streams by a fresh server codec. The first argument selects
+// oghttp2 (1) or nghttp2 (0), the second is the number of streams on the connection.
+void serverDecodeSmallStreams(benchmark::State& state) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.http2_use_oghttp2", state.range(0) ? "true" : "false"}});
+
+  Stats::IsolatedStoreImpl stats_store;
+  Http2::CodecStats::AtomicPtr http2_stats;
+  const envoy::config::core::v3::Http2ProtocolOptions options(
+      ::Envoy::Http2::Utility::initializeAndValidateOptions(
+          envoy::config::core::v3::Http2ProtocolOptions())
+          .value());
+  NiceMock<MockRequestDecoder> request_decoder;
+  NiceMock<Network::MockConnection> connection;
+  NiceMock<MockServerConnectionCallbacks> callbacks;
+  ON_CALL(callbacks, newStream(testing::_, testing::_)).WillByDefault(ReturnRef(request_decoder));
+  NiceMock<Random::MockRandomGenerator> random;
+  NiceMock<Server::MockOverloadManager> overload_manager;
+
+  const std::string payload = clientPayload(state.range(1));
+  for (auto _ : state) { // NOLINT
+    ServerConnectionImpl server(connection, callbacks,
+                                Http2::CodecStats::atomicGet(http2_stats, *stats_store.rootScope()),
+                                random, options, Http::DEFAULT_MAX_REQUEST_HEADERS_KB,
+                                Http::DEFAULT_MAX_HEADERS_COUNT,
+                                envoy::config::core::v3::HttpProtocolOptions::ALLOW,
+                                overload_manager);
+    Buffer::OwnedImpl data(payload);
+    const Status status = server.dispatch(data);
+    benchmark::DoNotOptimize(status.ok());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(serverDecodeSmallStreams)->ArgsProduct({{0, 1}, {1, 10, 100}});
+
+} // namespace
+} // namespace Http2
+} // namespace Http
+} // namespace Envoy
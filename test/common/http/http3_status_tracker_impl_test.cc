@@ -193,6 +193,55 @@ TEST_F(Http3StatusTrackerImplTest, MarkFailedRecentlyAndThenBroken) {
   EXPECT_FALSE(tracker_.hasHttp3FailedRecently());
 }
 
+TEST_F(Http3StatusTrackerImplTest, MarkBrokenUntil) {
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  tracker_.markHttp3BrokenUntil(now);
+  EXPECT_FALSE(tracker_.isHttp3Broken());
+
+  EXPECT_CALL(*timer_, enableTimer(std::chrono::milliseconds(60 * 1000), nullptr));
+  tracker_.markHttp3BrokenUntil(now + std::chrono::seconds(60));
+  EXPECT_TRUE(tracker_.isHttp3Broken());
+
+  timer_->invokeCallback();
+  EXPECT_FALSE(tracker_.isHttp3Broken());
+
+  // The next break backs off.
+  EXPECT_CALL(*timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*timer_, enableTimer(std::chrono::milliseconds(10 * 60 * 1000), nullptr));
+  tracker_.markHttp3Broken();
+}
+
+TEST_F(Http3StatusTrackerImplTest, MarkBrokenUntilFarFutureIsClamped) {
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  EXPECT_CALL(*timer_, enableTimer(std::chrono::milliseconds(5 * 256 * 60 * 1000), nullptr));
+  tracker_.markHttp3BrokenUntil(now + std::chrono::hours(24 * 365));
+  EXPECT_TRUE(tracker_.isHttp3Broken());
+}
+
+TEST_F(Http3StatusTrackerImplTest, BrokenStatusChangedCallback) {
+  MockTimer* timer = new NiceMock<MockTimer>(&dispatcher_);
+  std::vector<absl::optional<MonotonicTime>> changes;
+  Http3StatusTrackerImpl tracker(dispatcher_, [&changes](absl::optional<MonotonicTime> until) {
+    changes.push_back(until);
+  });
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+
+  tracker.markHttp3Broken();
+  ASSERT_EQ(1, changes.size());
+  EXPECT_EQ(now + std::chrono::minutes(5), changes[0]);
+
+  timer->invokeCallback();
+  ASSERT_EQ(2, changes.size());
+  EXPECT_EQ(absl::nullopt, changes[1]);
+
+  // Restoring the status does not report it.
+  tracker.markHttp3BrokenUntil(now + std::chrono::minutes(1));
+  EXPECT_EQ(2, changes.size());
+  tracker.markHttp3Confirmed();
+  ASSERT_EQ(3, changes.size());
+  EXPECT_EQ(absl::nullopt, changes[2]);
+}
+
 } // namespace
 } // namespace Http
 } // namespace Envoy
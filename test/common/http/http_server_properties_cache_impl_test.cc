@@ -287,6 +287,7 @@ TEST_F(HttpServerPropertiesCacheImplTest, ToAndFromString) {
   testAltSvc("h3-29=\":443\"; ma=86400|0|0", "h3-29=\":443\"; ma=86400|0|0");
   testAltSvc("h3-29=\":443\"; ma=86400,h3=\":443\"; ma=60|2|0",
              "h3-29=\":443\"; ma=86400,h3=\":443\"; ma=60|2|0");
+  testAltSvc("h3-29=\":443\"; ma=86400|0|0|300", "h3-29=\":443\"; ma=86400|0|0|300");
 
   // Test once more to make sure we handle time advancing correctly.
   // the absolute expiration time in testAltSvc is expected to be 86400 so add
@@ -300,7 +301,12 @@ TEST_F(HttpServerPropertiesCacheImplTest, InvalidString) {
   // Too many numbers
   EXPECT_FALSE(
       HttpServerPropertiesCacheImpl::originDataFromString(
-          "h3-29=\":443\"; ma=86400,h3=\":443\"; ma=60|1|2|3", dispatcher_.timeSource(), true)
+          "h3-29=\":443\"; ma=86400,h3=\":443\"; ma=60|1|2|3|4", dispatcher_.timeSource(), true)
+          .has_value());
+  // Non-numeric HTTP/3 broken time
+  EXPECT_FALSE(
+      HttpServerPropertiesCacheImpl::originDataFromString(
+          "h3-29=\":443\"; ma=86400,h3=\":443\"; ma=60|1|2|a", dispatcher_.timeSource(), true)
           .has_value());
   // Non-numeric rtt
   EXPECT_FALSE(
@@ -373,6 +379,46 @@ TEST_F(HttpServerPropertiesCacheImplTest, GetOrCreateHttp3StatusTracker) {
   EXPECT_FALSE(protocols_->getOrCreateHttp3StatusTracker(origin1_).isHttp3Broken());
 }
 
+TEST_F(HttpServerPropertiesCacheImplTest, Http3BrokenStatusCached) {
+  initialize();
+  protocols_->setAlternatives(origin1_, protocols1_);
+
+  EXPECT_CALL(*store_,
+              addOrUpdate("https://hostname1:1", "alpn1=\"hostname1:1\"; ma=5|0|0|300", kNoTtl));
+  protocols_->getOrCreateHttp3StatusTracker(origin1_).markHttp3Broken();
+
+  EXPECT_CALL(*store_,
+              addOrUpdate("https://hostname1:1", "alpn1=\"hostname1:1\"; ma=5|0|0", kNoTtl));
+  protocols_->getOrCreateHttp3StatusTracker(origin1_).markHttp3Confirmed();
+}
+
+TEST_F(HttpServerPropertiesCacheImplTest, CacheLoadHttp3Broken) {
+  EXPECT_CALL(*store_, iterate(_)).WillOnce(Invoke([&](KeyValueStore::ConstIterateCb fn) {
+    fn("https://hostname1:1", "alpn1=\"hostname1:1\"; ma=5|2|3|300");
+    // HTTP/3 stopped being broken already.
+    fn("https://hostname2:2", "alpn2=\"hostname2:2\"; ma=10|2|3|0");
+  }));
+  initialize();
+
+  EXPECT_CALL(*store_, addOrUpdate(_, _, _)).Times(0);
+  EXPECT_TRUE(protocols_->getOrCreateHttp3StatusTracker(origin1_).isHttp3Broken());
+  EXPECT_FALSE(protocols_->getOrCreateHttp3StatusTracker(origin2_).isHttp3Broken());
+}
+
+TEST_F(HttpServerPropertiesCacheImplTest, CacheLoadHttp3BrokenFarFutureIsClamped) {
+  // Persisted by a run whose monotonic clock started long before this one's.
+  EXPECT_CALL(*store_, iterate(_)).WillOnce(Invoke([&](KeyValueStore::ConstIterateCb fn) {
+    fn("https://hostname1:1", "alpn1=\"hostname1:1\"; ma=5|2|3|1000000000");
+  }));
+  initialize();
+  EXPECT_TRUE(protocols_->getOrCreateHttp3StatusTracker(origin1_).isHttp3Broken());
+
+  // The restored period is at most the longest backoff, 5 * 256 minutes.
+  EXPECT_CALL(*store_,
+              addOrUpdate("https://hostname1:1", "alpn1=\"hostname1:1\"; ma=5|2|3|76800", kNoTtl));
+  protocols_->setAlternatives(origin1_, protocols1_);
+}
+
 TEST_F(HttpServerPropertiesCacheImplTest, CanonicalSuffix) {
   std::string suffix = ".example.com";
   std::string host1 = "first.example.com";
@@ -0,0 +1,77 @@
+#include <memory>
+#include <vector>
+
+#include "source/common/http/stream_filter_pool.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+class TestFilter : public ReusableStreamFilter {
+public:
+  explicit TestFilter(int& created) { ++created; }
+
+  void resetForReuse() override {
+    ++resets_;
+    state_ = 0;
+  }
+
+  int resets_{};
+  int state_{};
+};
+
+TEST(StreamFilterPoolTest, ReusesReleasedFilters) {
+  auto pool = std::make_shared<StreamFilterPool<TestFilter>>();
+  int created = 0;
+  auto create = [&created]() { return std::make_unique<TestFilter>(created); };
+
+  std::shared_ptr<TestFilter> first = pool->acquire(create);
+  std::shared_ptr<TestFilter> second = pool->acquire(create);
+  EXPECT_EQ(2, created);
+  first->state_ = 1;
+  TestFilter* first_filter = first.get();
+
+  first.reset();
+  EXPECT_EQ(1, pool->idleFilters());
+  EXPECT_EQ(1, first_filter->resets_);
+  EXPECT_EQ(0, first_filter->state_);
+
+  std::shared_ptr<TestFilter> third = pool->acquire(create);
+  EXPECT_EQ(first_filter, third.get());
+  EXPECT_EQ(2, created);
+  EXPECT_EQ(0, pool->idleFilters());
+}
+
+TEST(StreamFilterPoolTest, BoundsIdleFilters) {
+  auto pool = std::make_shared<StreamFilterPool<TestFilter>>();
+  int created = 0;
+  auto create = [&created]() { return std::make_unique<TestFilter>(created); };
+
+  std::vector<std::shared_ptr<TestFilter>> filters;
+  for (uint32_t i = 0; i < StreamFilterPool<TestFilter>::MaxIdleFilters + 1; ++i) {
+    filters.push_back(pool->acquire(create));
+  }
+  filters.clear();
+  EXPECT_EQ(StreamFilterPool<TestFilter>::MaxIdleFilters, pool->idleFilters());
+}
+
+// Filters still in use keep their pool alive.
+TEST(StreamFilterPoolTest, FiltersOutliveReleasedPool) {
+  auto pool = std::make_shared<StreamFilterPool<TestFilter>>();
+  std::weak_ptr<StreamFilterPool<TestFilter>> weak_pool = pool;
+  int created = 0;
+
+  std::shared_ptr<TestFilter> filter =
+      pool->acquire([&created]() { return std::make_unique<TestFilter>(created); });
+  pool.reset();
+  EXPECT_FALSE(weak_pool.expired());
+
+  filter.reset();
+  EXPECT_TRUE(weak_pool.expired());
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
@@ -388,6 +388,49 @@ TEST_F(IoUringImplTest, PrepareReadvQueueOverflow) {
   EXPECT_EQ(completions_nr, 3);
 }
 
+TEST_F(IoUringImplTest, PrepareReadProvidedBuffer) {
+  if (!io_uring_->registerProvidedBuffers(2, 16)) {
+    GTEST_SKIP() << "provided buffer rings are not supported";
+  }
+  EXPECT_TRUE(io_uring_->hasProvidedBuffers());
+
+  os_fd_t fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  ASSERT_EQ(5, write(fds[1], "hello", 5));
+
+  auto dispatcher = api_->allocateDispatcher("test_thread");
+  os_fd_t event_fd = io_uring_->registerEventfd();
+  const Event::FileTriggerType trigger = Event::PlatformDefaultTriggerType;
+  int32_t completions_nr = 0;
+  auto file_event = dispatcher->createFileEvent(
+      event_fd,
+      [this, &completions_nr, d = dispatcher.get()](uint32_t) {
+        io_uring_->forEveryCompletion([&completions_nr](Request* user_data, int32_t res, bool) {
+          completions_nr++;
+          EXPECT_EQ(5, res);
+          Buffer::BufferFragment* buffer = user_data->releaseProvidedBuffer();
+          ASSERT_NE(nullptr, buffer);
+          EXPECT_EQ("hello",
+                    absl::string_view(static_cast<const char*>(buffer->data()), buffer->size()));
+          buffer->done();
+        });
+        d->exit();
+      },
+      trigger, Event::FileReadyType::Read);
+
+  int data = 1;
+  TestRequest request(data);
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->prepareReadProvidedBuffer(fds[0], &request));
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->submit());
+  dispatcher->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_EQ(1, completions_nr);
+  // The buffer went back to the ring when it was released.
+  EXPECT_TRUE(io_uring_->hasProvidedBuffers());
+  close(fds[0]);
+  close(fds[1]);
+}
+
 } // namespace
 } // namespace Io
 } // namespace Envoy
@@ -336,6 +336,101 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterRead) {
   EXPECT_EQ(0, worker.getSockets().size());
 }
 
+TEST(IoUringWorkerImplTest, ServerSocketReadProvidedBuffer) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  // The read request added by server socket constructor selects a provided buffer.
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, hasProvidedBuffers()).WillOnce(Return(true));
+  EXPECT_CALL(mock_io_uring, prepareReadProvidedBuffer(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  IoUringSocket* socket = nullptr;
+  std::string data_read;
+  auto& io_uring_socket = worker.addServerSocket(
+      fd,
+      [&socket, &data_read](uint32_t) {
+        data_read = socket->getReadParam()->buf_.toString();
+        socket->getReadParam()->buf_.drain(socket->getReadParam()->buf_.length());
+      },
+      false);
+  socket = &io_uring_socket;
+
+  // The provided buffer is moved into the read buffer and released once drained. The ring is
+  // empty, so the next read allocates its own buffer.
+  char data[] = "hello";
+  bool buffer_released = false;
+  Buffer::BufferFragmentImpl provided_buffer(
+      data, 5, [&buffer_released](const void*, size_t, const Buffer::BufferFragmentImpl*) {
+        buffer_released = true;
+      });
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req, &provided_buffer](const CompletionCb& cb) {
+        read_req->setProvidedBuffer(provided_buffer);
+        cb(read_req, 5, false);
+      }));
+  EXPECT_CALL(mock_io_uring, hasProvidedBuffers()).WillOnce(Return(false));
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  file_event_callback(Event::FileReadyType::Read);
+  EXPECT_EQ("hello", data_read);
+  EXPECT_TRUE(buffer_released);
+
+  // A read which finds the ring empty is retried without notifying the handler.
+  data_read.clear();
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) { cb(read_req, -ENOBUFS, false); }));
+  EXPECT_CALL(mock_io_uring, hasProvidedBuffers()).WillOnce(Return(false));
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  file_event_callback(Event::FileReadyType::Read);
+  EXPECT_TRUE(data_read.empty());
+
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.close(false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req, &cancel_req](const CompletionCb& cb) {
+        cb(read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  file_event_callback(Event::FileReadyType::Read);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  file_event_callback(Event::FileReadyType::Read);
+
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
 TEST(IoUringWorkerImplTest, CloseAllSocketsWhenDestruction) {
   Event::MockDispatcher dispatcher;
   IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
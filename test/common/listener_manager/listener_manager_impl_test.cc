@@ -19,6 +19,7 @@
 #include "source/common/config/metadata.h"
 #include "source/common/init/manager_impl.h"
 #include "source/common/network/address_impl.h"
+#include "source/common/network/connection_balancer_impl.h"
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/socket_interface_impl.h"
 #include "source/common/network/utility.h"
@@ -8042,6 +8043,24 @@ TEST_P(ListenerManagerImplWithRealFiltersTest, InvalidExtendConnectionBalanceCon
 #endif
 }
 
+TEST_P(ListenerManagerImplWithRealFiltersTest, PowerOfTwoChoicesConnectionBalanceConfig) {
+// Envoy always use ExactBalance at WIN32, so ignore it.
+#ifndef WIN32
+  auto listener = createIPv4Listener("TCPListener");
+  listener.mutable_connection_balance_config()->mutable_power_of_two_choices_balance();
+
+  auto listener_impl = ListenerImpl(listener, "version", *manager_, "foo", true, false,
+                                    /*hash=*/static_cast<uint64_t>(0));
+  auto socket_factory = std::make_unique<Network::MockListenSocketFactory>();
+  Network::Address::InstanceConstSharedPtr address(
+      new Network::Address::Ipv4Instance("192.168.0.1", 80, nullptr));
+  EXPECT_CALL(*socket_factory, localAddress()).WillOnce(ReturnRef(address));
+  listener_impl.addSocketFactory(std::move(socket_factory));
+  EXPECT_NE(nullptr, dynamic_cast<Network::PowerOfTwoChoicesConnectionBalancerImpl*>(
+                         &listener_impl.connectionBalancer(*address)));
+#endif
+}
+
 TEST_P(ListenerManagerImplWithRealFiltersTest, EmptyConnectionBalanceConfig) {
 // Envoy always use ExactBalance at WIN32, so ignore it.
 #ifndef WIN32
@@ -0,0 +1,74 @@
+#include "source/common/network/connection_balancer_impl.h"
+
+#include "test/mocks/common.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::Return;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class TestBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  explicit TestBalancedConnectionHandler(uint64_t num_connections)
+      : num_connections_(num_connections) {}
+
+  // BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  void post(ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(ConnectionSocketPtr&&, bool, bool) override {}
+
+  uint64_t num_connections_;
+};
+
+TEST(PowerOfTwoChoicesConnectionBalancerImplTest, SingleHandler) {
+  Random::MockRandomGenerator random;
+  PowerOfTwoChoicesConnectionBalancerImpl balancer(random);
+  TestBalancedConnectionHandler handler(0);
+  balancer.registerHandler(handler);
+
+  EXPECT_CALL(random, random()).Times(0);
+  EXPECT_EQ(&handler, &balancer.pickTargetHandler(handler));
+  EXPECT_EQ(1, handler.numConnections());
+}
+
+TEST(PowerOfTwoChoicesConnectionBalancerImplTest, PicksLeastLoadedOfTwoChoices) {
+  Random::MockRandomGenerator random;
+  PowerOfTwoChoicesConnectionBalancerImpl balancer(random);
+  TestBalancedConnectionHandler handler0(0);
+  TestBalancedConnectionHandler handler1(5);
+  TestBalancedConnectionHandler handler2(3);
+  balancer.registerHandler(handler0);
+  balancer.registerHandler(handler1);
+  balancer.registerHandler(handler2);
+
+  // The second choice skips over the first one, so 1 picks handler2.
+  EXPECT_CALL(random, random()).WillOnce(Return(1)).WillOnce(Return(1));
+  EXPECT_EQ(&handler2, &balancer.pickTargetHandler(handler1));
+  EXPECT_EQ(4, handler2.numConnections());
+  EXPECT_EQ(5, handler1.numConnections());
+
+  // The least loaded handler is only picked when it is one of the choices.
+  EXPECT_CALL(random, random()).WillOnce(Return(2)).WillOnce(Return(1));
+  EXPECT_EQ(&handler2, &balancer.pickTargetHandler(handler0));
+  EXPECT_EQ(5, handler2.numConnections());
+  EXPECT_EQ(0, handler0.numConnections());
+
+  EXPECT_CALL(random, random()).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(&handler0, &balancer.pickTargetHandler(handler1));
+  EXPECT_EQ(1, handler0.numConnections());
+
+  // Unregistered handlers are never picked.
+  balancer.unregisterHandler(handler0);
+  EXPECT_CALL(random, random()).WillOnce(Return(0)).WillOnce(Return(0));
+  EXPECT_EQ(&handler1, &balancer.pickTargetHandler(handler2));
+  EXPECT_EQ(6, handler1.numConnections());
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,261 @@
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/network/io_uring_socket_handle_impl.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/io/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::ByMove;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class IoUringSocketHandleImplTest : public testing::Test {
+public:
+  IoUringSocketHandleImplTest() : os_calls_(&os_sys_calls_) {
+    ON_CALL(worker_factory_, currentThreadRegistered()).WillByDefault(Return(true));
+    ON_CALL(worker_factory_, getIoUringWorker())
+        .WillByDefault(Return(OptRef<Io::IoUringWorker>(worker_)));
+    ON_CALL(worker_, dispatcher()).WillByDefault(ReturnRef(dispatcher_));
+    ON_CALL(socket_, getReadParam()).WillByDefault(ReturnRef(read_param_));
+    ON_CALL(socket_, getWriteParam()).WillByDefault(ReturnRef(write_param_));
+    ON_CALL(socket_, getStatus()).WillByDefault(Return(Io::IoUringSocketStatus::ReadEnabled));
+  }
+
+  // Create a server handle registered with the mock worker.
+  std::unique_ptr<IoUringSocketHandleImpl> createServerHandle() {
+    auto handle =
+        std::make_unique<IoUringSocketHandleImpl>(worker_factory_, 42, false, AF_INET, true);
+    EXPECT_CALL(worker_, addServerSocket(42, _, true)).WillOnce(ReturnRef(socket_));
+    handle->initializeFileEvent(
+        dispatcher_, [](uint32_t) {}, Event::PlatformDefaultTriggerType,
+        Event::FileReadyType::Read | Event::FileReadyType::Closed);
+    EXPECT_TRUE(handle->usingIoUring());
+    return handle;
+  }
+
+  void closeHandle(IoUringSocketHandleImpl& handle) {
+    EXPECT_CALL(socket_, close(false, _));
+    handle.close();
+    EXPECT_FALSE(handle.isOpen());
+  }
+
+  NiceMock<Api::MockOsSysCalls> os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<Io::MockIoUringWorkerFactory> worker_factory_;
+  NiceMock<Io::MockIoUringWorker> worker_;
+  NiceMock<Io::MockIoUringSocket> socket_;
+  OptRef<Io::ReadParam> read_param_;
+  OptRef<Io::WriteParam> write_param_;
+};
+
+TEST_F(IoUringSocketHandleImplTest, SocketType) {
+  IoUringSocketHandleImpl client_handle(worker_factory_, 42);
+  EXPECT_EQ(IoUringSocketType::Unknown, client_handle.ioUringSocketType());
+  EXPECT_CALL(worker_, addClientSocket(42, _, false)).WillOnce(ReturnRef(socket_));
+  client_handle.initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read | Event::FileReadyType::Write);
+  EXPECT_EQ(IoUringSocketType::Client, client_handle.ioUringSocketType());
+  closeHandle(client_handle);
+
+  IoUringSocketHandleImpl server_handle(worker_factory_, 43, false, AF_INET, true);
+  EXPECT_EQ(IoUringSocketType::Server, server_handle.ioUringSocketType());
+}
+
+TEST_F(IoUringSocketHandleImplTest, AcceptSocketUsesFileEvent) {
+  IoUringSocketHandleImpl handle(worker_factory_, 42);
+  EXPECT_CALL(os_sys_calls_, listen(42, 128)).WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  handle.listen(128);
+  EXPECT_EQ(IoUringSocketType::Accept, handle.ioUringSocketType());
+
+  EXPECT_CALL(worker_, addServerSocket(_, _, _)).Times(0);
+  EXPECT_CALL(dispatcher_, createFileEvent_(42, _, _, Event::FileReadyType::Read));
+  handle.initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+  EXPECT_FALSE(handle.usingIoUring());
+
+  EXPECT_CALL(os_sys_calls_, accept(42, _, _)).WillOnce(Return(Api::SysCallSocketResult{43, 0}));
+  IoHandlePtr accepted = handle.accept(nullptr, nullptr);
+  ASSERT_NE(nullptr, accepted);
+  EXPECT_EQ(IoUringSocketType::Server,
+            dynamic_cast<IoUringSocketHandleImpl&>(*accepted).ioUringSocketType());
+}
+
+TEST_F(IoUringSocketHandleImplTest, FallbackWithoutWorker) {
+  EXPECT_CALL(worker_factory_, currentThreadRegistered()).WillRepeatedly(Return(false));
+  IoUringSocketHandleImpl handle(worker_factory_, 42, false, AF_INET, true);
+  EXPECT_CALL(worker_, addServerSocket(_, _, _)).Times(0);
+  EXPECT_CALL(dispatcher_, createFileEvent_(42, _, _, Event::FileReadyType::Read));
+  handle.initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+  EXPECT_FALSE(handle.usingIoUring());
+
+  char buf[4];
+  EXPECT_CALL(os_sys_calls_, recv(42, buf, 4, 0))
+      .WillOnce(Return(Api::SysCallSizeResult{4, 0}));
+  EXPECT_EQ(4, handle.recv(buf, 4, 0).return_value_);
+
+  EXPECT_CALL(socket_, close(_, _)).Times(0);
+  EXPECT_CALL(os_sys_calls_, close(42)).WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  handle.close();
+}
+
+TEST_F(IoUringSocketHandleImplTest, Read) {
+  auto handle = createServerHandle();
+
+  // No read event is being delivered.
+  Buffer::OwnedImpl buffer;
+  auto result = handle->read(buffer, absl::nullopt);
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+
+  Buffer::OwnedImpl read_buf("hello world");
+  Io::ReadParam read_param{read_buf, static_cast<int32_t>(read_buf.length())};
+  read_param_ = read_param;
+  result = handle->read(buffer, 5);
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(5, result.return_value_);
+  EXPECT_EQ("hello", buffer.toString());
+  EXPECT_EQ(" world", read_buf.toString());
+
+  char data[6];
+  Buffer::RawSlice slice{data, sizeof(data)};
+  result = handle->readv(6, &slice, 1);
+  EXPECT_EQ(6, result.return_value_);
+  EXPECT_EQ(" world", absl::string_view(data, 6));
+
+  // The data of this read event has been consumed.
+  result = handle->readv(6, &slice, 1);
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+
+  // Remote close.
+  Io::ReadParam closed_param{read_buf, 0};
+  read_param_ = closed_param;
+  result = handle->read(buffer, absl::nullopt);
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(0, result.return_value_);
+
+  Io::ReadParam error_param{read_buf, -ECONNRESET};
+  read_param_ = error_param;
+  result = handle->read(buffer, absl::nullopt);
+  EXPECT_EQ(Api::IoError::IoErrorCode::ConnectionReset, result.err_->getErrorCode());
+
+  closeHandle(*handle);
+}
+
+TEST_F(IoUringSocketHandleImplTest, PeekAndDrain) {
+  auto handle = createServerHandle();
+
+  Buffer::OwnedImpl read_buf("hello");
+  Io::ReadParam read_param{read_buf, static_cast<int32_t>(read_buf.length())};
+  read_param_ = read_param;
+
+  char data[5];
+  auto result = handle->recv(data, sizeof(data), MSG_PEEK);
+  EXPECT_EQ(5, result.return_value_);
+  EXPECT_EQ(5, read_buf.length());
+
+  result = handle->recv(data, 2, 0);
+  EXPECT_EQ(2, result.return_value_);
+  EXPECT_EQ("llo", read_buf.toString());
+
+  closeHandle(*handle);
+}
+
+TEST_F(IoUringSocketHandleImplTest, Write) {
+  auto handle = createServerHandle();
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(socket_, write(testing::Matcher<Buffer::Instance&>(_)))
+      .WillOnce([](Buffer::Instance& data) { data.drain(data.length()); });
+  auto result = handle->write(buffer);
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(5, result.return_value_);
+
+  Buffer::RawSlice slice{const_cast<char*>("world"), 5};
+  EXPECT_CALL(socket_, write(&slice, 1)).WillOnce(Return(5));
+  result = handle->writev(&slice, 1);
+  EXPECT_EQ(5, result.return_value_);
+
+  // A failed write is reported while its write event is delivered.
+  Io::WriteParam write_param{-EPIPE};
+  write_param_ = write_param;
+  EXPECT_CALL(socket_, write(&slice, 1)).Times(0);
+  result = handle->writev(&slice, 1);
+  EXPECT_FALSE(result.ok());
+
+  closeHandle(*handle);
+}
+
+TEST_F(IoUringSocketHandleImplTest, ConnectResult) {
+  IoUringSocketHandleImpl handle(worker_factory_, 42);
+  EXPECT_CALL(worker_, addClientSocket(42, _, false)).WillOnce(ReturnRef(socket_));
+  handle.initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read | Event::FileReadyType::Write);
+
+  auto address = std::make_shared<Address::Ipv4Instance>("127.0.0.1", 80);
+  EXPECT_CALL(socket_, connect(_));
+  auto result = handle.connect(address);
+  EXPECT_EQ(-1, result.return_value_);
+  EXPECT_EQ(SOCKET_ERROR_IN_PROGRESS, result.errno_);
+
+  Io::WriteParam write_param{-ECONNREFUSED};
+  write_param_ = write_param;
+  int error = 0;
+  socklen_t error_size = sizeof(error);
+  EXPECT_CALL(os_sys_calls_, getsockopt_(_, _, _, _, _)).Times(0);
+  EXPECT_EQ(0, handle.getOption(SOL_SOCKET, SO_ERROR, &error, &error_size).return_value_);
+  EXPECT_EQ(ECONNREFUSED, error);
+
+  closeHandle(handle);
+}
+
+TEST_F(IoUringSocketHandleImplTest, FileEvents) {
+  auto handle = createServerHandle();
+
+  EXPECT_CALL(socket_, enableCloseEvent(false));
+  EXPECT_CALL(socket_, disableRead());
+  handle->enableFileEvents(Event::FileReadyType::Write);
+
+  EXPECT_CALL(socket_, enableCloseEvent(true));
+  EXPECT_CALL(socket_, enableRead());
+  handle->enableFileEvents(Event::FileReadyType::Read | Event::FileReadyType::Closed);
+
+  EXPECT_CALL(socket_, injectCompletion(Io::Request::RequestType::Read));
+  EXPECT_CALL(socket_, injectCompletion(Io::Request::RequestType::Write));
+  handle->activateFileEvents(Event::FileReadyType::Read | Event::FileReadyType::Write);
+
+  // The io_uring socket is kept for the next owner of the handle.
+  EXPECT_CALL(socket_, disableRead());
+  EXPECT_CALL(socket_, enableCloseEvent(false)).Times(2);
+  EXPECT_CALL(socket_, setFileReadyCb(_));
+  handle->resetFileEvents();
+  EXPECT_TRUE(handle->usingIoUring());
+
+  EXPECT_CALL(worker_, addServerSocket(_, _, _)).Times(0);
+  EXPECT_CALL(socket_, setFileReadyCb(_));
+  EXPECT_CALL(socket_, enableRead());
+  handle->initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+
+  EXPECT_CALL(socket_, shutdown(SHUT_WR));
+  EXPECT_EQ(0, handle->shutdown(SHUT_WR).return_value_);
+
+  closeHandle(*handle);
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
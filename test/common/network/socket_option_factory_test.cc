@@ -74,6 +74,28 @@ TEST_F(SocketOptionFactoryTest, TestBuildSocketMarkOptions) {
                                             envoy::config::core::v3::SocketOption::STATE_PREBIND));
 }
 
+TEST_F(SocketOptionFactoryTest, TestBuildTcpNotsentLowatOptions) {
+  std::shared_ptr<Socket::Options> options =
+      SocketOptionFactory::buildTcpNotsentLowatOptions(16384);
+
+  const auto expected_option = ENVOY_SOCKET_TCP_NOTSENT_LOWAT;
+  CHECK_OPTION_SUPPORTED(expected_option);
+
+  const int type = expected_option.level();
+  const int option = expected_option.option();
+  EXPECT_CALL(socket_mock_, setSocketOption(_, _, _, sizeof(int)))
+      .WillOnce(Invoke([type, option](int input_type, int input_option, const void* optval,
+                                      socklen_t) -> Api::SysCallIntResult {
+        EXPECT_EQ(16384, *static_cast<const int*>(optval));
+        EXPECT_EQ(type, input_type);
+        EXPECT_EQ(option, input_option);
+        return {0, 0};
+      }));
+
+  EXPECT_TRUE(Network::Socket::applyOptions(options, socket_mock_,
+                                            envoy::config::core::v3::SocketOption::STATE_PREBIND));
+}
+
 TEST_F(SocketOptionFactoryTest, TestBuildIpv4TransparentOptions) {
   makeSocketV4();
 
@@ -43,6 +43,7 @@
 #include "gtest/gtest.h"
 
 using testing::_;
+using testing::AnyNumber;
 using testing::Invoke;
 using testing::ReturnRef;
 
@@ -268,6 +269,38 @@ TEST_P(UdpListenerImplBatchWriterTest, WriteBlocked) {
   }
 }
 
+/**
+ * Tests that the datagrams sent while processing the received packets, such as replies, are
+ * flushed once all the packets of the read event have been processed.
+ */
+TEST_P(UdpListenerImplBatchWriterTest, FlushAfterRead) {
+  client_.write("request", *send_to_addr_);
+
+  const std::string reply("reply");
+  EXPECT_CALL(listener_callbacks_, onReadReady());
+  EXPECT_CALL(listener_callbacks_, onData(_)).WillOnce(Invoke([&](const UdpRecvData& data) {
+    Buffer::OwnedImpl buffer(reply);
+    UdpSendData send_data{data.addresses_.local_->ip(), *data.addresses_.peer_, buffer};
+    EXPECT_TRUE(listener_->send(send_data).ok());
+    // The reply is buffered until the end of the read event.
+    EXPECT_EQ(listener_config_.listenerScope()
+                  .gaugeFromString("internal_buffer_size", Stats::Gauge::ImportMode::NeverImport)
+                  .value(),
+              reply.length());
+    dispatcher_->exit();
+  }));
+  EXPECT_CALL(listener_callbacks_, onWriteReady(_)).Times(AnyNumber());
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_EQ(listener_config_.listenerScope()
+                .gaugeFromString("internal_buffer_size", Stats::Gauge::ImportMode::NeverImport)
+                .value(),
+            0);
+  UdpRecvData received;
+  client_.recv(received);
+  EXPECT_EQ(reply, received.buffer_->toString());
+}
+
 } // namespace
 } // namespace Network
 } // namespace Envoy
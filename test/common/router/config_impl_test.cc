@@ -1172,6 +1172,122 @@ virtual_hosts:
             config.route(genHeaders("example.com", "/", "GET"), 0)->routeEntry()->clusterName());
 }
 
+// Virtual hosts with many prefix and exact routes are matched through a path index. The first
+// matching route in config order must still win, including over routes which are not indexed.
+TEST_F(RouteMatcherTest, TestRoutesWithPathIndex) {
+  std::string yaml = R"EOF(
+virtual_hosts:
+  - name: indexed
+    domains: ["*"]
+    routes:
+      - match: { path: "/exact" }
+        route: { cluster: "exact" }
+      - match:
+          prefix: "/api"
+          headers:
+            - name: x-api
+              string_match: { exact: "yes" }
+        route: { cluster: "api_header" }
+      - match: { safe_regex: { regex: "/api/re.*" } }
+        route: { cluster: "regex" }
+      - match: { safe_regex: { regex: "/api/v[0-9]+/special" } }
+        route: { cluster: "regex_special" }
+      - match: { prefix: "/API/case", case_sensitive: false }
+        route: { cluster: "case_insensitive" }
+)EOF";
+  for (int i = 0; i < RoutePathIndex::MinIndexedRoutes; ++i) {
+    absl::StrAppend(&yaml, "      - match: { prefix: \"/api/v", i, "\" }\n",
+                    "        route: { cluster: \"v", i, "\" }\n");
+  }
+  absl::StrAppend(&yaml, R"EOF(      - match: { path: "/api/v1" }
+        route: { cluster: "exact_after_prefix" }
+      - match: { prefix: "/" }
+        route: { cluster: "default" }
+)EOF");
+
+  std::vector<std::string> clusters{"exact", "api_header", "regex", "regex_special",
+                                    "case_insensitive", "exact_after_prefix", "default"};
+  for (int i = 0; i < RoutePathIndex::MinIndexedRoutes; ++i) {
+    clusters.push_back(absl::StrCat("v", i));
+  }
+  factory_context_.cluster_manager_.initializeClusters(clusters, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  auto cluster = [&config](Http::TestRequestHeaderMapImpl headers) -> std::string {
+    auto route = config.route(headers, 0);
+    return route != nullptr ? route->routeEntry()->clusterName() : "";
+  };
+  EXPECT_EQ("exact", cluster(genHeaders("www.lyft.com", "/exact", "GET")));
+  EXPECT_EQ("default", cluster(genHeaders("www.lyft.com", "/exact/more", "GET")));
+  EXPECT_EQ("exact", cluster(genHeaders("www.lyft.com", "/exact?query", "GET")));
+  EXPECT_EQ("v1", cluster(genHeaders("www.lyft.com", "/api/v1", "GET")));
+  EXPECT_EQ("v1", cluster(genHeaders("www.lyft.com", "/api/v12", "GET")));
+  EXPECT_EQ("v7", cluster(genHeaders("www.lyft.com", "/api/v7/foo", "GET")));
+  EXPECT_EQ("regex", cluster(genHeaders("www.lyft.com", "/api/regex", "GET")));
+  EXPECT_EQ("regex_special", cluster(genHeaders("www.lyft.com", "/api/v7/special", "GET")));
+  EXPECT_EQ("v7", cluster(genHeaders("www.lyft.com", "/api/v7/special/more", "GET")));
+  EXPECT_EQ("case_insensitive", cluster(genHeaders("www.lyft.com", "/api/CASE", "GET")));
+  EXPECT_EQ("default", cluster(genHeaders("www.lyft.com", "/other", "GET")));
+
+  Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/api/v3", "GET");
+  EXPECT_EQ("v3", cluster(headers));
+  headers.addCopy("x-api", "yes");
+  EXPECT_EQ("api_header", cluster(headers));
+}
+
+// Virtual hosts whose config did not change are shared with the config which is replaced, as long
+// as the rest of the route configuration did not change either.
+TEST_F(RouteMatcherTest, VirtualHostsSharedWithPreviousConfig) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: foo
+    domains: ["foo.com"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "foo" }
+  - name: bar
+    domains: ["bar.com"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "bar" }
+)EOF";
+  factory_context_.cluster_manager_.initializeClusters({"foo", "bar", "baz"}, {});
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  auto virtual_host = [&stream_info](const ConfigImpl& config, const std::string& host) {
+    return &config.route(genHeaders(host, "/", "GET"), stream_info, 0)->virtualHost();
+  };
+
+  const auto proto_config = parseRouteConfigurationFromYaml(yaml);
+  const ConfigImpl config(proto_config, factory_context_,
+                          ProtobufMessage::getNullValidationVisitor(), false);
+
+  auto changed_proto_config = proto_config;
+  changed_proto_config.mutable_virtual_hosts(1)
+      ->mutable_routes(0)
+      ->mutable_route()
+      ->set_cluster("baz");
+  const ConfigImpl changed_config(changed_proto_config, factory_context_,
+                                  ProtobufMessage::getNullValidationVisitor(), false, &config);
+  EXPECT_EQ(virtual_host(config, "foo.com"), virtual_host(changed_config, "foo.com"));
+  EXPECT_NE(virtual_host(config, "bar.com"), virtual_host(changed_config, "bar.com"));
+  EXPECT_EQ("baz", changed_config.route(genHeaders("bar.com", "/", "GET"), stream_info, 0)
+                       ->routeEntry()
+                       ->clusterName());
+
+  // The virtual hosts refer to the global route config, so none are shared when it changes.
+  auto global_change_proto_config = proto_config;
+  global_change_proto_config.add_internal_only_headers("x-internal");
+  const ConfigImpl global_change_config(global_change_proto_config, factory_context_,
+                                        ProtobufMessage::getNullValidationVisitor(), false,
+                                        &config);
+  EXPECT_NE(virtual_host(config, "foo.com"), virtual_host(global_change_config, "foo.com"));
+
+  // Clusters are validated while virtual hosts are built, so none are shared then.
+  const ConfigImpl validating_config(proto_config, factory_context_,
+                                     ProtobufMessage::getNullValidationVisitor(), true, &config);
+  EXPECT_NE(virtual_host(config, "foo.com"), virtual_host(validating_config, "foo.com"));
+}
+
 TEST_F(RouteMatcherTest, TestRoutesWithInvalidRegex) {
   std::string invalid_route = R"EOF(
 virtual_hosts:
@@ -3217,6 +3333,22 @@ TEST_F(RouterMatcherHashPolicyTest, HashQueryParameters) {
     auto val2 = route1->routeEntry()->hashPolicy()->generateHash(nullptr, headers2, add_cookie_nop_,
                                                                  nullptr);
     EXPECT_EQ(val1, val2);
+
+    // Other parameters, including ones prefixed with the name, are skipped.
+    Http::TestRequestHeaderMapImpl headers3 =
+        genHeaders("www.lyft.com", "/foo?params=abc&p=1&param=xyz", "GET");
+    EXPECT_EQ(val1, route1->routeEntry()->hashPolicy()->generateHash(nullptr, headers3,
+                                                                     add_cookie_nop_, nullptr));
+
+    // A parameter without a value hashes as an empty value.
+    Http::TestRequestHeaderMapImpl headers4 = genHeaders("www.lyft.com", "/foo?param", "GET");
+    Http::TestRequestHeaderMapImpl headers5 = genHeaders("www.lyft.com", "/foo?param=", "GET");
+    auto val4 = route1->routeEntry()->hashPolicy()->generateHash(nullptr, headers4, add_cookie_nop_,
+                                                                 nullptr);
+    EXPECT_TRUE(val4);
+    EXPECT_EQ(val4, route1->routeEntry()->hashPolicy()->generateHash(nullptr, headers5,
+                                                                     add_cookie_nop_, nullptr));
+    EXPECT_NE(val1, val4);
   }
   {
     Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/bar?param=xyz", "GET");
@@ -10323,6 +10455,9 @@ public:
       : registered_factory_(factory_), registered_default_factory_(default_factory_) {}
 
   struct DerivedFilterConfig : public RouteSpecificFilterConfig {
+    // Negative seconds make the test filter a no-op.
+    bool disablesFilter() const override { return config_.seconds() < 0; }
+
     ProtobufWkt::Timestamp config_;
   };
   class TestFilterConfig : public Extensions::HttpFilters::Common::EmptyHttpFilterConfig {
@@ -10880,6 +11015,42 @@ virtual_hosts:
   EXPECT_TRUE(route5->filterDisabled("test.filter").value());
 }
 
+TEST_F(PerFilterConfigsTest, RouteFilterDisabledByTypedConfig) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: bar
+    domains: ["*"]
+    routes:
+      - match: { prefix: "/route1" }
+        route: { cluster: baz }
+        # test.filter will be disabled for this route because its config turns it into a no-op.
+        typed_per_filter_config:
+          test.filter:
+            "@type": type.googleapis.com/google.protobuf.Timestamp
+            value:
+              seconds: -1
+      - match: { prefix: "/route2" }
+        route: { cluster: baz }
+    typed_per_filter_config:
+      test.filter:
+        "@type": type.googleapis.com/google.protobuf.Timestamp
+        value:
+          seconds: 123
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"baz"}, {});
+
+  const TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  const auto route1 = config.route(genHeaders("www.foo.com", "/route1", "GET"), 0);
+  EXPECT_TRUE(route1->filterDisabled("test.filter").value());
+  // The config is still available to the filter.
+  EXPECT_NE(nullptr, route1->mostSpecificPerFilterConfig("test.filter"));
+
+  const auto route2 = config.route(genHeaders("www.foo.com", "/route2", "GET"), 0);
+  EXPECT_FALSE(route2->filterDisabled("test.filter").value());
+}
+
 class RouteMatchOverrideTest : public testing::Test, public ConfigImplTestBase {};
 
 TEST_F(RouteMatchOverrideTest, VerifyAllMatchableRoutes) {
@@ -0,0 +1,101 @@
+#include <memory>
+#include <string>
+
+#include "source/common/router/domain_index.h"
+
+#include "absl/strings/match.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using TestIndex = DomainIndex<std::shared_ptr<std::string>>;
+
+std::string find(const TestIndex& index, absl::string_view host) {
+  const std::shared_ptr<std::string>* value = index.find(host);
+  return value != nullptr ? **value : "";
+}
+
+bool add(TestIndex& index, absl::string_view domain) {
+  auto value = std::make_shared<std::string>(domain);
+  if (absl::StartsWith(domain, "*")) {
+    return index.addSuffix(domain.substr(1), value);
+  }
+  if (absl::EndsWith(domain, "*")) {
+    return index.addPrefix(domain.substr(0, domain.size() - 1), value);
+  }
+  return index.addExact(domain, value);
+}
+
+TEST(DomainIndexTest, Empty) {
+  TestIndex index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ("", find(index, "foo.com"));
+  EXPECT_EQ("", find(index, ""));
+}
+
+TEST(DomainIndexTest, Duplicates) {
+  TestIndex index;
+  EXPECT_TRUE(add(index, "foo.com"));
+  EXPECT_FALSE(index.empty());
+  EXPECT_FALSE(add(index, "foo.com"));
+  EXPECT_TRUE(add(index, "*foo.com"));
+  EXPECT_FALSE(add(index, "*foo.com"));
+  EXPECT_TRUE(add(index, "foo.com*"));
+  EXPECT_FALSE(add(index, "foo.com*"));
+}
+
+TEST(DomainIndexTest, Exact) {
+  TestIndex index;
+  add(index, "foo.com");
+  add(index, "bar.foo.com");
+  add(index, "oo.com");
+
+  EXPECT_EQ("foo.com", find(index, "foo.com"));
+  EXPECT_EQ("foo.com", find(index, "FoO.cOm"));
+  EXPECT_EQ("bar.foo.com", find(index, "bar.foo.com"));
+  EXPECT_EQ("oo.com", find(index, "oo.com"));
+  EXPECT_EQ("", find(index, "o.com"));
+  EXPECT_EQ("", find(index, "baz.foo.com"));
+  EXPECT_EQ("", find(index, "afoo.com"));
+}
+
+TEST(DomainIndexTest, LongestSuffixWins) {
+  TestIndex index;
+  add(index, "*.foo.com");
+  add(index, "*-bar.foo.com");
+  add(index, "*com");
+  add(index, "baz-bar.foo.com");
+
+  EXPECT_EQ("baz-bar.foo.com", find(index, "baz-bar.foo.com"));
+  EXPECT_EQ("*-bar.foo.com", find(index, "qux-bar.foo.com"));
+  EXPECT_EQ("*-bar.foo.com", find(index, "A.QUX-BAR.FOO.COM"));
+  EXPECT_EQ("*.foo.com", find(index, "bar.foo.com"));
+  EXPECT_EQ("*.foo.com", find(index, "a.foo.com"));
+  // The wildcard must match at least one character.
+  EXPECT_EQ("*com", find(index, ".foo.com"));
+  EXPECT_EQ("*.foo.com", find(index, "-bar.foo.com"));
+  EXPECT_EQ("", find(index, "com"));
+  EXPECT_EQ("", find(index, "foo.org"));
+}
+
+TEST(DomainIndexTest, SuffixBeforePrefix) {
+  TestIndex index;
+  add(index, "foo.*");
+  add(index, "foo.bar.*");
+  add(index, "*.com");
+
+  EXPECT_EQ("foo.bar.*", find(index, "foo.bar.org"));
+  EXPECT_EQ("foo.*", find(index, "foo.baz.org"));
+  EXPECT_EQ("foo.*", find(index, "Foo.Bar"));
+  EXPECT_EQ("*.com", find(index, "foo.bar.com"));
+  EXPECT_EQ("", find(index, "foo."));
+  EXPECT_EQ("", find(index, "foo"));
+  EXPECT_EQ("", find(index, "bar.org"));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -969,6 +969,47 @@ response_headers_to_remove: ["x-foo-header"]
   EXPECT_EQ("bar", header_map.get_("x-foo-header"));
 }
 
+TEST(HeaderParserTest, EvaluateConstantAndFormattedHeaders) {
+  const std::string yaml = R"EOF(
+match: { prefix: "/new_endpoint" }
+route:
+  cluster: www2
+request_headers_to_add:
+  - header:
+      key: "x-constant"
+      value: "constant"
+  - header:
+      key: "x-protocol"
+      value: "%PROTOCOL%"
+  - header:
+      key: "x-escaped"
+      value: "100%%"
+  - header:
+      key: "x-empty"
+      value: ""
+)EOF";
+
+  const auto route = parseRouteFromV3Yaml(yaml);
+  EXPECT_TRUE(HeadersToAddEntry(route.request_headers_to_add(0)).is_constant_);
+  EXPECT_FALSE(HeadersToAddEntry(route.request_headers_to_add(1)).is_constant_);
+  EXPECT_FALSE(HeadersToAddEntry(route.request_headers_to_add(2)).is_constant_);
+
+  HeaderParserPtr req_header_parser = HeaderParser::configure(route.request_headers_to_add());
+  EXPECT_FALSE(req_header_parser->isConstant());
+  EXPECT_TRUE(
+      HeaderParser::configure(Protobuf::RepeatedPtrField<HeaderValueOption>())->isConstant());
+  Http::TestRequestHeaderMapImpl header_map{{":method", "POST"}};
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  absl::optional<Envoy::Http::Protocol> protocol = Envoy::Http::Protocol::Http11;
+  ON_CALL(stream_info, protocol()).WillByDefault(ReturnPointee(&protocol));
+
+  req_header_parser->evaluateHeaders(header_map, stream_info);
+  EXPECT_EQ("constant", header_map.get_("x-constant"));
+  EXPECT_EQ("HTTP/1.1", header_map.get_("x-protocol"));
+  EXPECT_EQ("100%", header_map.get_("x-escaped"));
+  EXPECT_FALSE(header_map.has("x-empty"));
+}
+
 TEST(HeaderParserTest, GetHeaderTransformsWithFormatting) {
   const std::string yaml = R"EOF(
 match: { prefix: "/new_endpoint" }
@@ -0,0 +1,133 @@
+#include <string>
+#include <vector>
+
+#include "source/common/router/route_path_index.h"
+
+#include "absl/strings/match.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+std::vector<uint32_t> findCandidates(const RoutePathIndex& index, absl::string_view path) {
+  RoutePathIndex::Candidates candidates;
+  index.findCandidates(path, candidates);
+  return {candidates.begin(), candidates.end()};
+}
+
+TEST(RoutePathIndexTest, Empty) {
+  RoutePathIndex index;
+  index.compile();
+  EXPECT_EQ(0, index.indexedRoutes());
+  EXPECT_THAT(findCandidates(index, "/"), IsEmpty());
+  EXPECT_THAT(findCandidates(index, ""), IsEmpty());
+}
+
+TEST(RoutePathIndexTest, PrefixAndExact) {
+  RoutePathIndex index;
+  index.addPrefix("/api/v1", 0);
+  index.addExact("/api", 1);
+  index.addPrefix("/api/v2", 2);
+  index.addPrefix("/a", 3);
+  index.addExact("/api/v1", 4);
+  index.addPrefix("/", 5);
+  index.addPrefix("", 6);
+  index.compile();
+  EXPECT_EQ(7, index.indexedRoutes());
+
+  EXPECT_THAT(findCandidates(index, "/api/v1/foo"), ElementsAre(0, 3, 5, 6));
+  EXPECT_THAT(findCandidates(index, "/api/v1"), ElementsAre(0, 3, 4, 5, 6));
+  EXPECT_THAT(findCandidates(index, "/api/v"), ElementsAre(3, 5, 6));
+  EXPECT_THAT(findCandidates(index, "/api"), ElementsAre(1, 3, 5, 6));
+  EXPECT_THAT(findCandidates(index, "/api/v2"), ElementsAre(2, 3, 5, 6));
+  EXPECT_THAT(findCandidates(index, "/b"), ElementsAre(5, 6));
+  EXPECT_THAT(findCandidates(index, "x"), ElementsAre(6));
+  EXPECT_THAT(findCandidates(index, ""), ElementsAre(6));
+}
+
+TEST(RoutePathIndexTest, SameKey) {
+  RoutePathIndex index;
+  index.addPrefix("/foo", 0);
+  index.addExact("/foo", 1);
+  index.addPrefix("/foo", 2);
+  index.addExact("/foo", 3);
+  index.compile();
+
+  EXPECT_THAT(findCandidates(index, "/foo"), ElementsAre(0, 1, 2, 3));
+  EXPECT_THAT(findCandidates(index, "/foobar"), ElementsAre(0, 2));
+  EXPECT_THAT(findCandidates(index, "/fo"), IsEmpty());
+}
+
+TEST(RoutePathIndexTest, UnindexedAreAlwaysCandidates) {
+  RoutePathIndex index;
+  index.addUnindexed(0);
+  index.addPrefix("/foo", 1);
+  index.addUnindexed(2);
+  index.addExact("/bar", 3);
+  index.compile();
+  EXPECT_EQ(2, index.indexedRoutes());
+
+  EXPECT_THAT(findCandidates(index, "/foo"), ElementsAre(0, 1, 2));
+  EXPECT_THAT(findCandidates(index, "/bar"), ElementsAre(0, 2, 3));
+  EXPECT_THAT(findCandidates(index, "/baz"), ElementsAre(0, 2));
+}
+
+TEST(RoutePathIndexTest, Regex) {
+  RoutePathIndex index;
+  EXPECT_TRUE(index.addRegex("/foo/[0-9]+", 0));
+  index.addPrefix("/foo", 1);
+  EXPECT_FALSE(index.addRegex("/foo/(", 2));
+  index.addUnindexed(2);
+  EXPECT_TRUE(index.addRegex(".*bar", 3));
+  EXPECT_TRUE(index.addRegex("/foo/1", 4));
+  index.compile();
+  EXPECT_EQ(4, index.indexedRoutes());
+
+  EXPECT_THAT(findCandidates(index, "/foo/1"), ElementsAre(0, 1, 2, 4));
+  EXPECT_THAT(findCandidates(index, "/foo/12"), ElementsAre(0, 1, 2));
+  // Regexes must match the whole path.
+  EXPECT_THAT(findCandidates(index, "/foo/1x"), ElementsAre(1, 2));
+  EXPECT_THAT(findCandidates(index, "/foo/bar"), ElementsAre(1, 2, 3));
+  EXPECT_THAT(findCandidates(index, "/bar/baz"), ElementsAre(2));
+}
+
+// Compares the index with a linear scan over many routes whose keys share prefixes, so that
+// nodes are split in all possible places.
+TEST(RoutePathIndexTest, MatchesLinearScan) {
+  std::vector<std::pair<std::string, bool>> routes;
+  for (const std::string& a : {"/", "/a", "/ab", "/abc", "/b", "/ba", "/abd", "/a/b", "/abcd"}) {
+    routes.emplace_back(a, true);
+    routes.emplace_back(a, false);
+    routes.emplace_back(a + "/x", true);
+  }
+  RoutePathIndex index;
+  for (uint32_t i = 0; i < routes.size(); ++i) {
+    if (routes[i].second) {
+      index.addPrefix(routes[i].first, i);
+    } else {
+      index.addExact(routes[i].first, i);
+    }
+  }
+  index.compile();
+
+  for (const std::string& path : {"", "/", "/a", "/ab", "/abc", "/abcd", "/abcde", "/abd", "/abx",
+                                  "/a/b", "/a/b/x", "/abc/x", "/b", "/ba", "/bb", "/c"}) {
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < routes.size(); ++i) {
+      if (routes[i].second ? absl::StartsWith(path, routes[i].first) : path == routes[i].first) {
+        expected.push_back(i);
+      }
+    }
+    EXPECT_EQ(expected, findCandidates(index, path)) << path;
+  }
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
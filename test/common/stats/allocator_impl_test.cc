@@ -64,6 +64,39 @@ TEST_F(AllocatorImplTest, CountersWithSameName) {
   EXPECT_EQ(2, c2->value());
 }
 
+// Sharded counters sum the increments of all threads.
+TEST_F(AllocatorImplTest, ShardedCounter) {
+  StatName counter_name = makeStat("counter.name");
+  CounterSharedPtr counter = alloc_.makeShardedCounter(counter_name, StatName(), {});
+  EXPECT_EQ(counter.get(), alloc_.makeCounter(counter_name, StatName(), {}).get());
+  EXPECT_FALSE(counter->used());
+
+  constexpr uint32_t num_threads = 20;
+  constexpr uint32_t num_increments = 1000;
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    threads.push_back(thread_factory.createThread([&counter]() {
+      for (uint32_t j = 0; j < num_increments; ++j) {
+        counter->inc();
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+
+  EXPECT_TRUE(counter->used());
+  EXPECT_EQ(num_threads * num_increments, counter->value());
+  EXPECT_EQ(num_threads * num_increments, counter->latch());
+  EXPECT_EQ(0, counter->latch());
+  counter->add(5);
+  EXPECT_EQ(num_threads * num_increments + 5, counter->value());
+  EXPECT_EQ(5, counter->latch());
+  counter->reset();
+  EXPECT_EQ(0, counter->value());
+}
+
 TEST_F(AllocatorImplTest, GaugesWithSameName) {
   StatName gauge_name = makeStat("gauges.name");
   GaugeSharedPtr g1 = alloc_.makeGauge(gauge_name, StatName(), {}, Gauge::ImportMode::Accumulate);
@@ -231,7 +231,7 @@ TEST_F(StatNameTest, TestSuccessfulDecode) {
 class StatNameDeathTest : public StatNameTest {
 public:
   void decodeSymbolVec(const SymbolVec& symbol_vec) {
-    Thread::LockGuard lock(table_.lock_);
+    absl::ReaderMutexLock lock(&table_.lock_);
     for (Symbol symbol : symbol_vec) {
       table_.fromSymbol(symbol);
     }
@@ -599,20 +599,10 @@ TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
-  //
-  // Thus it is better to avoid symbol-table contention by refactoring
-  // all stat-creation code to symbolize all stat string elements at
-  // construction, as composition does not require a lock.
-  //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
-  //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
+  // Encoding existing symbols only takes the symbol table lock shared, so the
+  // accesses above don't contend with each other on it. We can't EXPECT that
+  // the number of contentions is unchanged though, as the tracer also counts
+  // contentions on the mutexes of the ConditionalInitializers used here.
   //
   // Note also that we cannot guarantee there *will* be contentions
   // as a machine or OS is free to run all threads serially.
@@ -623,6 +613,36 @@ TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
   }
 }
 
+// Validates that symbols are removed exactly once when threads race to free
+// and re-encode them.
+TEST_F(StatNameTest, RacingSymbolFree) {
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+
+  constexpr int num_threads = 16;
+  std::vector<Thread::ThreadPtr> threads;
+  threads.reserve(num_threads);
+  ConditionalInitializer start;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(thread_factory.createThread([this, i, &start]() {
+      start.wait();
+      for (int count = 0; count < 1000; ++count) {
+        // Overlapping names, so that symbols reach a zero ref-count while
+        // other threads encode them.
+        StatNameStorage storage(absl::StrCat("shared.symbol", (i + count) % 4, ".tenant", i % 2),
+                                table_);
+        EXPECT_EQ(absl::StrCat("shared.symbol", (i + count) % 4, ".tenant", i % 2),
+                  table_.toString(storage.statName()));
+        storage.free(table_);
+      }
+    }));
+  }
+  start.setReady();
+  for (auto& thread : threads) {
+    thread->join();
+  }
+  EXPECT_EQ(0, table_.numSymbols());
+}
+
 TEST_F(StatNameTest, SharedStatNameStorageSetInsertAndFind) {
   StatNameStorageSet set;
   const int iters = 10;
@@ -63,6 +63,52 @@ static void bmCreateRace(benchmark::State& state) {
 }
 BENCHMARK(bmCreateRace)->Unit(::benchmark::kMillisecond);
 
+// Measures encoding and freeing names made of existing symbols from many threads
+// at once, as when dynamic stat names are created on the request path.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmEncodeExistingRace(benchmark::State& state) {
+  const int num_threads = state.range(0);
+  Envoy::Thread::ThreadFactory& thread_factory = Envoy::Thread::threadFactoryForTest();
+  Envoy::Stats::SymbolTableImpl table;
+  std::vector<std::string> stat_name_strings;
+  std::vector<Envoy::Stats::StatNameStorage> initial;
+  for (int i = 0; i < 16; ++i) {
+    stat_name_strings.push_back(absl::StrCat("cluster.tenant_", i, ".upstream_rq_total"));
+  }
+  initial.reserve(stat_name_strings.size());
+  for (const std::string& stat_name_string : stat_name_strings) {
+    // NOLINTNEXTLINE(clang-analyzer-unix.Malloc)
+    initial.emplace_back(stat_name_string, table);
+  }
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    std::vector<Envoy::Thread::ThreadPtr> threads;
+    threads.reserve(num_threads);
+    Envoy::ConditionalInitializer access;
+    for (int i = 0; i < num_threads; ++i) {
+      threads.push_back(thread_factory.createThread([&access, &table, &stat_name_strings, i]() {
+        access.wait();
+        for (int count = 0; count < 1000; ++count) {
+          // NOLINTNEXTLINE(clang-analyzer-unix.Malloc)
+          Envoy::Stats::StatNameStorage storage(
+              stat_name_strings[(i + count) % stat_name_strings.size()], table);
+          storage.free(table);
+        }
+      }));
+    }
+    access.setReady();
+    for (auto& thread : threads) {
+      thread->join();
+    }
+  }
+
+  for (Envoy::Stats::StatNameStorage& storage : initial) {
+    storage.free(table);
+  }
+}
+BENCHMARK(bmEncodeExistingRace)->Arg(1)->Arg(8)->Arg(64)->Unit(::benchmark::kMillisecond);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void bmJoinStatNames(benchmark::State& state) {
   Envoy::Stats::SymbolTableImpl symbol_table;
@@ -528,6 +528,20 @@ TEST_F(TagExtractorTokensTest, Prefix) {
   EXPECT_EQ("", TagExtractorTokensImpl("name", "$").prefixToken());
 }
 
+// Stat names without the longest literal token are skipped before being split into tokens, which
+// must not change what is matched.
+TEST_F(TagExtractorTokensTest, RequiredSubstr) {
+  EXPECT_FALSE(extract("name", "http.*.user_agent.$.**", "http.prefix.downstream_rq_total"));
+  EXPECT_FALSE(extract("name", "*.foo.$", "foo.bar.baz"));
+  EXPECT_FALSE(extract("name", "http.*.fault.$.**", "http.prefix.faulty.cluster"));
+  EXPECT_TRUE(extract("name", "http.*.fault.$.**", "http.prefix.fault.cluster.aborts_injected"));
+  EXPECT_THAT(tags_, ElementsAre(Tag{"name", "cluster"}));
+  EXPECT_TRUE(extract("name", "$.**.aid", "now.aid"));
+  EXPECT_THAT(tags_, ElementsAre(Tag{"name", "now"}));
+  EXPECT_TRUE(extract("name", "foo.$.**", "foo.bar"));
+  EXPECT_THAT(tags_, ElementsAre(Tag{"name", "bar"}));
+}
+
 TEST_F(TagExtractorTokensTest, TokensMatchStart) {
   EXPECT_TRUE(extract("when", "$.is.the.time", "now.is.the.time"));
   EXPECT_THAT(tags_, ElementsAre(Tag{"when", "now"}));
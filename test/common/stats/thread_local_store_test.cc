@@ -856,6 +856,87 @@ TEST_F(StatsThreadLocalStoreTest, ExtractAndAppendTagsRegexBuiltinExpression) {
   EXPECT_EQ("foo", symbol_table_.toString(tags[1].second));
 }
 
+// Allocator which records the names of the counters created sharded.
+class ShardedCounterTrackingAllocator : public AllocatorImpl {
+public:
+  using AllocatorImpl::AllocatorImpl;
+
+  std::vector<std::string> sharded_counters_;
+
+protected:
+  Counter* makeShardedCounterInternal(StatName name, StatName tag_extracted_name,
+                                      const StatNameTagVector& stat_name_tags) override {
+    sharded_counters_.push_back(symbolTable().toString(name));
+    return AllocatorImpl::makeShardedCounterInternal(name, tag_extracted_name, stat_name_tags);
+  }
+};
+
+TEST(StatsThreadLocalStoreShardingTest, ShardHotCounters) {
+  SymbolTableImpl symbol_table;
+  ShardedCounterTrackingAllocator alloc(symbol_table);
+  ThreadLocalStoreImpl store(alloc);
+  envoy::config::metrics::v3::StatsConfig stats_config;
+  store.setTagProducer(std::make_unique<TagProducerImpl>(stats_config));
+
+  // Counters are not sharded by default.
+  store.rootScope()->counterFromString("cluster.a.upstream_rq_total");
+  EXPECT_TRUE(alloc.sharded_counters_.empty());
+
+  store.setShardHotCounters(true);
+  Counter& rq_total = store.rootScope()->counterFromString("cluster.b.upstream_rq_total");
+  Counter& rq_2xx = store.rootScope()->counterFromString("cluster.b.upstream_rq_2xx");
+  Counter& rq_200 = store.rootScope()->counterFromString("cluster.b.upstream_rq_200");
+  store.rootScope()->counterFromString("cluster.b.upstream_rq_retry");
+  store.rootScope()->counterFromString("listener.127.0.0.1_80.downstream_cx_total");
+  store.rootScope()->counterFromString("http.ingress.downstream_rq_total");
+  EXPECT_THAT(alloc.sharded_counters_,
+              testing::ElementsAre("cluster.b.upstream_rq_total", "cluster.b.upstream_rq_2xx",
+                                   "cluster.b.upstream_rq_200",
+                                   "listener.127.0.0.1_80.downstream_cx_total",
+                                   "http.ingress.downstream_rq_total"));
+
+  // Sharded counters behave like any other counter.
+  EXPECT_FALSE(rq_total.used());
+  rq_total.inc();
+  rq_total.add(2);
+  EXPECT_TRUE(rq_total.used());
+  EXPECT_EQ(3, rq_total.value());
+  EXPECT_EQ(3, rq_total.latch());
+  EXPECT_EQ(0, rq_total.latch());
+  EXPECT_EQ(&rq_2xx, &store.rootScope()->counterFromString("cluster.b.upstream_rq_2xx"));
+  EXPECT_EQ(0, rq_200.value());
+
+  // Existing counters are unaffected by turning sharding off.
+  store.setShardHotCounters(false);
+  store.rootScope()->counterFromString("cluster.c.upstream_rq_total");
+  EXPECT_EQ(5, alloc.sharded_counters_.size());
+}
+
+TEST(StatsThreadLocalStoreLimitTest, MaxStatsPerScope) {
+  SymbolTableImpl symbol_table;
+  AllocatorImpl alloc(symbol_table);
+  ThreadLocalStoreImpl store(alloc);
+  store.setMaxStatsPerScope(2);
+  ScopeSharedPtr scope = store.rootScope()->createScope("scope.");
+
+  Counter& c1 = scope->counterFromString("c1");
+  Gauge& g1 = scope->gaugeFromString("g1", Gauge::ImportMode::Accumulate);
+  EXPECT_EQ("scope.c1", c1.name());
+  EXPECT_EQ("scope.g1", g1.name());
+  EXPECT_EQ(&c1, &scope->counterFromString("c1"));
+
+  // The scope is full, so new stats of any kind are null stats.
+  EXPECT_EQ("", scope->counterFromString("c2").name());
+  EXPECT_EQ("", scope->histogramFromString("h1", Histogram::Unit::Unspecified).name());
+  EXPECT_EQ("", scope->textReadoutFromString("t1").name());
+  EXPECT_EQ(3, TestUtility::findCounter(store, "stats.scope_stats_overflow")->value());
+
+  // The root scope is not limited.
+  EXPECT_EQ("c3", store.rootScope()->counterFromString("c3").name());
+  EXPECT_EQ("c4", store.rootScope()->counterFromString("c4").name());
+  EXPECT_EQ(3, TestUtility::findCounter(store, "stats.scope_stats_overflow")->value());
+}
+
 class LookupWithStatNameTest : public ThreadLocalStoreNoMocksMixin, public testing::Test {};
 
 TEST_F(LookupWithStatNameTest, All) {
@@ -1668,6 +1749,25 @@ TEST_F(HistogramTest, MultiHistogramMultipleMerges) {
   EXPECT_EQ(2, validateMerge());
 }
 
+// Merging an idle histogram keeps the statistics of the last interval with values in the
+// cumulative statistics and an empty interval, and values recorded afterwards are still merged.
+TEST_F(HistogramTest, IdleHistogramMerges) {
+  Histogram& h1 = scope_.histogramFromString("h1", Histogram::Unit::Unspecified);
+  expectCallAndAccumulate(h1, 1);
+  EXPECT_EQ(1, validateMerge());
+
+  // The interval becomes empty.
+  EXPECT_EQ(1, validateMerge());
+  // Nothing changes while the histogram stays idle.
+  EXPECT_EQ(1, validateMerge());
+  EXPECT_EQ(1, validateMerge());
+
+  expectCallAndAccumulate(h1, 5);
+  expectCallAndAccumulate(h1, 7);
+  EXPECT_EQ(1, validateMerge());
+  EXPECT_EQ(1, validateMerge());
+}
+
 TEST_F(HistogramTest, BasicScopeHistogramMerge) {
   ScopeSharedPtr scope1 = store_->createScope("scope1.");
 
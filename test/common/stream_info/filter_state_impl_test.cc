@@ -412,6 +412,22 @@ TEST_F(FilterStateImplTest, HasDataAtOrAboveLifeSpan) {
   EXPECT_TRUE(filterState().hasDataAtOrAboveLifeSpan(FilterState::LifeSpan::Connection));
 }
 
+TEST_F(FilterStateImplTest, ParentsCreatedOnWrite) {
+  EXPECT_FALSE(filterState().hasDataWithName("test_1"));
+  EXPECT_EQ(nullptr, filterState().parent());
+
+  filterState().setData("test_1", std::make_unique<SimpleType>(1), FilterState::StateType::ReadOnly,
+                        FilterState::LifeSpan::FilterChain);
+  EXPECT_EQ(nullptr, filterState().parent());
+
+  filterState().setData("test_2", std::make_unique<SimpleType>(2), FilterState::StateType::ReadOnly,
+                        FilterState::LifeSpan::Connection);
+  ASSERT_NE(nullptr, filterState().parent());
+  ASSERT_NE(nullptr, filterState().parent()->parent());
+  EXPECT_TRUE(filterState().parent()->parent()->hasDataWithName("test_2"));
+  EXPECT_TRUE(filterState().hasDataWithName("test_2"));
+}
+
 TEST_F(FilterStateImplTest, SetSameDataWithDifferentLifeSpan) {
   filterState().setData("test_1", std::make_unique<SimpleType>(1), FilterState::StateType::Mutable,
                         FilterState::LifeSpan::Connection);
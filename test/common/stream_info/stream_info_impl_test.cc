@@ -472,6 +472,28 @@ TEST_F(StreamInfoImplTest, SetFrom) {
   EXPECT_EQ(s1.isShadow(), s2.isShadow());
 }
 
+TEST_F(StreamInfoImplTest, DynamicMetadataAllocatedOnWrite) {
+  StreamInfoImpl stream_info(Http::Protocol::Http2, test_time_.timeSystem(), nullptr);
+  const StreamInfo& const_stream_info = stream_info;
+
+  // Reading the metadata of a stream without any returns the shared empty instance.
+  EXPECT_EQ(&envoy::config::core::v3::Metadata::default_instance(),
+            &const_stream_info.dynamicMetadata());
+
+  StreamInfoImpl copy(Http::Protocol::Http2, test_time_.timeSystem(), nullptr);
+  copy.setFrom(stream_info, nullptr);
+  EXPECT_EQ(&envoy::config::core::v3::Metadata::default_instance(),
+            &static_cast<const StreamInfo&>(copy).dynamicMetadata());
+
+  stream_info.setDynamicMetadata("com.test", MessageUtil::keyValueStruct("test_key", "test_value"));
+  EXPECT_NE(&envoy::config::core::v3::Metadata::default_instance(),
+            &const_stream_info.dynamicMetadata());
+  copy.setFrom(stream_info, nullptr);
+  EXPECT_EQ("test_value",
+            Config::Metadata::metadataValue(&copy.dynamicMetadata(), "com.test", "test_key")
+                .string_value());
+}
+
 TEST_F(StreamInfoImplTest, DynamicMetadataTest) {
   StreamInfoImpl stream_info(Http::Protocol::Http2, test_time_.timeSystem(), nullptr);
 
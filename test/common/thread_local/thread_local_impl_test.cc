@@ -262,6 +262,36 @@ TEST_F(ThreadLocalInstanceImplTest, NoDataCallback) {
   tls_.shutdownThread();
 }
 
+// The initialize and update callbacks are shared by all threads instead of being copied for each
+// worker.
+TEST_F(ThreadLocalInstanceImplTest, CallbacksSharedBetweenThreads) {
+  InSequence s;
+  TypedSlot<StringSlotObject> slot(tls_);
+
+  std::vector<const std::string*> captures;
+  EXPECT_CALL(thread_dispatcher_, post(_));
+  slot.set([&captures, capture = std::string("capture")](
+               Event::Dispatcher&) -> std::shared_ptr<StringSlotObject> {
+    captures.push_back(&capture);
+    return nullptr;
+  });
+  ASSERT_EQ(2, captures.size()); // 1 worker, 1 main thread.
+  EXPECT_EQ(captures[0], captures[1]);
+
+  captures.clear();
+  auto update_cb = [&captures, capture = std::string("capture")](OptRef<StringSlotObject>) {
+    captures.push_back(&capture);
+  };
+  EXPECT_CALL(thread_dispatcher_, post(_));
+  slot.runOnAllThreads(update_cb);
+
+  ASSERT_EQ(2, captures.size()); // 1 worker, 1 main thread.
+  EXPECT_EQ(captures[0], captures[1]);
+
+  tls_.shutdownGlobalThreading();
+  tls_.shutdownThread();
+}
+
 // TODO(ramaraochavali): Run this test with real threads. The current issue in the unit
 // testing environment is, the post to main_dispatcher is not working as expected.
 
@@ -3,10 +3,13 @@
 
 #include "source/common/tls/cert_validator/default_validator.h"
 #include "source/common/tls/cert_validator/san_matcher.h"
+#include "source/common/tls/cert_validator/utility.h"
+#include "source/common/tls/utility.h"
 
 #include "test/common/tls/cert_validator/test_common.h"
 #include "test/common/tls/ssl_test_utility.h"
 #include "test/test_common/environment.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
@@ -283,6 +286,58 @@ TEST(DefaultCertValidatorTest, WithVerifyDepth) {
   EXPECT_EQ(X509_STORE_CTX_get_error(store_ctx.get()), X509_V_OK);
 }
 
+TEST(DefaultCertValidatorTest, VerifiedCertChainCache) {
+  Stats::TestUtil::TestStore test_store;
+  SslStats stats = generateSslStats(*test_store.rootScope());
+  Event::SimulatedTimeSystem time_system;
+  envoy::config::core::v3::TypedExtensionConfig typed_conf;
+
+  bssl::UniquePtr<STACK_OF(X509)> dns_cert_chain = readCertChainFromFile(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_cert.pem"));
+  bssl::UniquePtr<STACK_OF(X509)> uri_cert_chain = readCertChainFromFile(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_uri_cert.pem"));
+  const std::string ca_cert = TestEnvironment::readFileToStringForTest(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem"));
+
+  // The certificate expiration is ignored by the verification, so that the expiration of the cache
+  // entries can be simulated.
+  auto test_config = std::make_unique<TestCertificateValidationContextConfig>(
+      typed_conf, /*allow_expired_certificate=*/true, /*san_matchers=*/
+      std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher>{}, ca_cert,
+      absl::nullopt, /*verified_certificate_cache_size=*/1);
+  auto default_validator =
+      std::make_unique<Extensions::TransportSockets::Tls::DefaultCertValidator>(
+          test_config.get(), stats, time_system);
+  SSLContextPtr ssl_ctx = SSL_CTX_new(TLS_method());
+  default_validator->initializeSslContexts({ssl_ctx.get()}, false);
+  time_system.setSystemTime(
+      Utility::getExpirationTime(*sk_X509_value(dns_cert_chain.get(), 0)) - std::chrono::hours(1));
+
+  const auto verify = [&](STACK_OF(X509)& cert_chain) {
+    ValidationResults results = default_validator->doVerifyCertChain(
+        cert_chain, /*callback=*/nullptr, /*transport_socket_options=*/nullptr, *ssl_ctx, {},
+        false, "");
+    EXPECT_EQ(ValidationResults::ValidationStatus::Successful, results.status);
+    EXPECT_EQ(Ssl::ClientValidationStatus::Validated, results.detailed_status);
+  };
+
+  verify(*dns_cert_chain);
+  EXPECT_EQ(0, stats.verify_cache_hit_.value());
+  verify(*dns_cert_chain);
+  EXPECT_EQ(1, stats.verify_cache_hit_.value());
+
+  // The cache only holds one chain, so this evicts the first one.
+  verify(*uri_cert_chain);
+  EXPECT_EQ(1, stats.verify_cache_hit_.value());
+  verify(*dns_cert_chain);
+  EXPECT_EQ(1, stats.verify_cache_hit_.value());
+
+  // An entry expires with the certificates of the chain.
+  time_system.advanceTimeWait(std::chrono::hours(2));
+  verify(*dns_cert_chain);
+  EXPECT_EQ(1, stats.verify_cache_hit_.value());
+}
+
 class MockCertificateValidationContextConfig : public Ssl::CertificateValidationContextConfig {
 public:
   MockCertificateValidationContextConfig() : MockCertificateValidationContextConfig("") {}
@@ -313,6 +368,7 @@ public:
   MOCK_METHOD(Api::Api&, api, (), (const override));
   bool onlyVerifyLeafCertificateCrl() const override { return false; }
   absl::optional<uint32_t> maxVerifyDepth() const override { return absl::nullopt; }
+  uint32_t verifiedCertificateCacheSize() const override { return 0; }
 
 private:
   std::string s_;
@@ -352,6 +408,54 @@ TEST(DefaultCertValidatorTest, TestInitializeSslContextFailure) {
                           "Failed to load trusted CA certificates from.*");
 }
 
+// Validators trusting the same CA bundle add the same parsed certificate to their stores.
+TEST(DefaultCertValidatorTest, ValidatorsShareParsedCaBundle) {
+  Stats::TestUtil::TestStore test_store;
+  SslStats stats = generateSslStats(*test_store.rootScope());
+  envoy::config::core::v3::TypedExtensionConfig typed_conf;
+  const std::string ca_cert = TestEnvironment::readFileToStringForTest(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem"));
+  auto test_config = std::make_unique<TestCertificateValidationContextConfig>(
+      typed_conf, /*allow_expired_certificate=*/false, /*san_matchers=*/
+      std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher>{}, ca_cert);
+
+  const auto trusted_cert = [&](DefaultCertValidator& validator, SSL_CTX* ctx) -> X509* {
+    validator.initializeSslContexts({ctx}, false);
+    STACK_OF(X509_OBJECT)* objects = X509_STORE_get0_objects(SSL_CTX_get_cert_store(ctx));
+    EXPECT_EQ(1, sk_X509_OBJECT_num(objects));
+    return X509_OBJECT_get0_X509(sk_X509_OBJECT_value(objects, 0));
+  };
+
+  // The first validator is still in use when the second one is created, so the bundle is not
+  // parsed again.
+  DefaultCertValidator first(test_config.get(), stats, Event::GlobalTimeSystem().timeSystem());
+  SSLContextPtr first_ctx = SSL_CTX_new(TLS_method());
+  X509* first_cert = trusted_cert(first, first_ctx.get());
+  DefaultCertValidator second(test_config.get(), stats, Event::GlobalTimeSystem().timeSystem());
+  SSLContextPtr second_ctx = SSL_CTX_new(TLS_method());
+  EXPECT_EQ(first_cert, trusted_cert(second, second_ctx.get()));
+}
+
+// Identical bundles share their parsed certificates while they are in use.
+TEST(CertValidatorUtilTest, ParseX509InfosSharesIdenticalBundles) {
+  const std::string ca_cert = TestEnvironment::readFileToStringForTest(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem"));
+  const std::string other_ca_cert = TestEnvironment::readFileToStringForTest(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/fake_ca_cert.pem"));
+
+  std::shared_ptr<STACK_OF(X509_INFO)> infos = CertValidatorUtil::parseX509Infos(ca_cert);
+  ASSERT_NE(nullptr, infos);
+  EXPECT_EQ(1, sk_X509_INFO_num(infos.get()));
+  EXPECT_EQ(infos, CertValidatorUtil::parseX509Infos(std::string(ca_cert)));
+  EXPECT_NE(infos, CertValidatorUtil::parseX509Infos(other_ca_cert));
+
+  std::weak_ptr<STACK_OF(X509_INFO)> weak_infos = infos;
+  infos.reset();
+  EXPECT_TRUE(weak_infos.expired());
+  infos = CertValidatorUtil::parseX509Infos(ca_cert);
+  EXPECT_NE(nullptr, infos);
+}
+
 } // namespace Tls
 } // namespace TransportSockets
 } // namespace Extensions
@@ -302,6 +302,21 @@ TEST_F(HttpConnManFinalizerImplTest, NoUpstreamClusterTagSetWhenNoClusterInfo) {
   HttpTracerUtility::finalizeDownstreamSpan(span, nullptr, nullptr, nullptr, stream_info, config);
 }
 
+TEST_F(HttpConnManFinalizerImplTest, NoTagsForSpanNotRecording) {
+  Http::TestRequestHeaderMapImpl request_headers{
+      {"x-request-id", "id"}, {":method", "GET"}, {":path", "/"}, {":scheme", "http"}};
+
+  ON_CALL(span, isRecording()).WillByDefault(Return(false));
+  EXPECT_CALL(stream_info, bytesReceived()).Times(0);
+  EXPECT_CALL(span, setTag(_, _)).Times(0);
+  EXPECT_CALL(span, log(_, _)).Times(0);
+  EXPECT_CALL(span, finishSpan()).Times(2);
+
+  HttpTracerUtility::finalizeDownstreamSpan(span, &request_headers, nullptr, nullptr, stream_info,
+                                            config);
+  HttpTracerUtility::finalizeUpstreamSpan(span, stream_info, config);
+}
+
 TEST_F(HttpConnManFinalizerImplTest, SpanOptionalHeaders) {
   Http::TestRequestHeaderMapImpl request_headers{
       {"x-request-id", "id"}, {":path", "/test"}, {":method", "GET"}, {":scheme", "https"}};
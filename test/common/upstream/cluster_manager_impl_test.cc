@@ -2349,6 +2349,7 @@ TEST_P(ClusterManagerLifecycleTest, AddOrUpdateClusterStaticExists) {
   cluster1->initialize_callback_();
 
   EXPECT_FALSE(cluster_manager_->addOrUpdateCluster(defaultStaticCluster("fake_cluster"), ""));
+  EXPECT_FALSE(cluster_manager_->addOrUpdateCluster(defaultStaticCluster("fake_cluster"), "", 1));
 
   // Attempt to remove a static cluster.
   EXPECT_FALSE(cluster_manager_->removeCluster("fake_cluster"));
@@ -2358,6 +2359,42 @@ TEST_P(ClusterManagerLifecycleTest, AddOrUpdateClusterStaticExists) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(cluster1.get()));
 }
 
+// Updates with the serialized hash of the running cluster are blocked without comparing configs.
+TEST_P(ClusterManagerLifecycleTest, AddOrUpdateClusterSerializedHash) {
+  create(defaultConfig());
+
+  std::shared_ptr<MockClusterMockPrioritySet> cluster1(new NiceMock<MockClusterMockPrioritySet>());
+  EXPECT_CALL(factory_, clusterFromProto_(_, _, _, _))
+      .WillOnce(Return(std::make_pair(cluster1, nullptr)));
+  EXPECT_CALL(*cluster1, initialize(_));
+  EXPECT_TRUE(cluster_manager_->addOrUpdateCluster(defaultStaticCluster("fake_cluster"), "", 1));
+  cluster1->initialize_callback_();
+  checkStats(1 /*added*/, 0 /*modified*/, 0 /*removed*/, 1 /*active*/, 0 /*warming*/);
+
+  auto update_cluster = defaultStaticCluster("fake_cluster");
+  update_cluster.mutable_per_connection_buffer_limit_bytes()->set_value(12345);
+  // A matching serialized hash blocks the update before the configs are compared, which a real
+  // management server can only send for an identical config.
+  EXPECT_FALSE(cluster_manager_->addOrUpdateCluster(update_cluster, "", 1));
+  // Serializations of the same config may differ, the config hash then blocks the update.
+  EXPECT_FALSE(cluster_manager_->addOrUpdateCluster(defaultStaticCluster("fake_cluster"), "", 2));
+  EXPECT_FALSE(cluster_manager_->addOrUpdateCluster(defaultStaticCluster("fake_cluster"), ""));
+
+  std::shared_ptr<MockClusterMockPrioritySet> cluster2(new NiceMock<MockClusterMockPrioritySet>());
+  EXPECT_CALL(factory_, clusterFromProto_(_, _, _, _))
+      .WillOnce(Return(std::make_pair(cluster2, nullptr)));
+  EXPECT_CALL(*cluster2, initialize(_));
+  EXPECT_TRUE(cluster_manager_->addOrUpdateCluster(update_cluster, "", 3));
+  checkStats(1 /*added*/, 1 /*modified*/, 0 /*removed*/, 1 /*active*/, 1 /*warming*/);
+  // The warming cluster blocks updates with its own serialized hash.
+  EXPECT_FALSE(cluster_manager_->addOrUpdateCluster(update_cluster, "", 3));
+  EXPECT_FALSE(cluster_manager_->addOrUpdateCluster(update_cluster, "", 1));
+  EXPECT_EQ(1, cluster_manager_->warmingClusterCount());
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(cluster1.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(cluster2.get()));
+}
+
 // Verifies that we correctly propagate the host_set state to the TLS clusters.
 TEST_P(ClusterManagerLifecycleTest, HostsPostedToTlsCluster) {
   const std::string json = fmt::sprintf("{\"static_resources\":{%s}}",
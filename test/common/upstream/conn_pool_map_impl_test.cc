@@ -322,6 +322,24 @@ TEST_F(ConnPoolMapImplTest, GetPoolLimitHitManyIdleOnlyOneFreed) {
   EXPECT_EQ(test_map->size(), 3);
 }
 
+// Show that the least recently used idle pool is the one freed.
+TEST_F(ConnPoolMapImplTest, GetPoolLimitHitFreesLeastRecentlyUsedIdle) {
+  TestMapPtr test_map = makeTestMapWithLimit(3);
+
+  test_map->getPool(1, getBasicFactory());
+  test_map->getPool(2, getBasicFactory());
+  test_map->getPool(3, getActivePoolFactory());
+
+  // Using 1 again makes 2 the least recently used idle pool, and 3 is busy.
+  test_map->getPool(1, getNeverCalledFactory());
+  test_map->getPool(4, getBasicFactory());
+
+  EXPECT_EQ(test_map->size(), 3);
+  test_map->getPool(1, getNeverCalledFactory());
+  test_map->getPool(3, getNeverCalledFactory());
+  test_map->getPool(4, getNeverCalledFactory());
+}
+
 // Show that if we hit the limit once, then again with the same keys, we don't clean out the
 // previously cleaned entries. Essentially, ensure we clean up any state related to being full.
 TEST_F(ConnPoolMapImplTest, GetPoolFailStateIsCleared) {
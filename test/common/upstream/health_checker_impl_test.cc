@@ -2852,6 +2852,65 @@ TEST_F(HttpHealthCheckerImplTest, HealthCheckIntervals) {
   respond(0, "200", false);
 }
 
+// Healthy hosts whose health EDS reports are checked at the EDS healthy interval.
+TEST_F(HttpHealthCheckerImplTest, EdsHealthyInterval) {
+  allocHealthChecker(R"EOF(
+    timeout: 1s
+    interval: 1s
+    unhealthy_interval: 2s
+    eds_healthy_interval: 10s
+    interval_jitter: 0s
+    unhealthy_threshold: 3
+    healthy_threshold: 3
+    http_health_check:
+      service_name_matcher:
+        prefix: locations
+      path: /healthcheck
+    )EOF");
+  addCompletionCallback();
+
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://128.0.0.1:80", simTime())};
+  cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->setEdsHealthStatus(
+      envoy::config::core::v3::HEALTHY);
+  cluster_->info_->trafficStats()->upstream_cx_total_.inc();
+  expectSessionCreate();
+  expectStreamCreate(0);
+  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, enableTimer(_, _));
+  health_checker_->start();
+
+  EXPECT_CALL(*this, onHostStatus(_, HealthTransition::Unchanged));
+  EXPECT_CALL(*test_sessions_[0]->interval_timer_,
+              enableTimer(std::chrono::milliseconds(10000), _));
+  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
+  respond(0, "200", false);
+
+  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, enableTimer(_, _));
+  expectStreamCreate(0);
+  test_sessions_[0]->interval_timer_->invokeCallback();
+
+  // Hosts whose health EDS does not report are checked at the regular interval.
+  cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->setEdsHealthStatus(
+      envoy::config::core::v3::UNKNOWN);
+  EXPECT_CALL(*this, onHostStatus(_, HealthTransition::Unchanged));
+  EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(std::chrono::milliseconds(1000), _));
+  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
+  respond(0, "200", false);
+
+  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, enableTimer(_, _));
+  expectStreamCreate(0);
+  test_sessions_[0]->interval_timer_->invokeCallback();
+
+  // Failed checks are followed up at the unhealthy interval whatever EDS reports.
+  cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->setEdsHealthStatus(
+      envoy::config::core::v3::HEALTHY);
+  EXPECT_CALL(*this, onHostStatus(_, HealthTransition::Changed));
+  EXPECT_CALL(event_logger_, logEjectUnhealthy(_, _, _));
+  EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(std::chrono::milliseconds(2000), _));
+  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
+  respond(0, "503", false);
+}
+
 TEST_F(HttpHealthCheckerImplTest, RemoteCloseBetweenChecks) {
   setupNoServiceValidationHC();
   EXPECT_CALL(*this, onHostStatus(_, HealthTransition::Unchanged)).Times(2);
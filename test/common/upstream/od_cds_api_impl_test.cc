@@ -4,6 +4,7 @@
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/common/upstream/od_cds_api_impl.h"
 
+#include "test/mocks/event/mocks.h"
 #include "test/mocks/protobuf/mocks.h"
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/mocks/upstream/missing_cluster_notifier.h"
@@ -24,14 +25,15 @@ public:
   void SetUp() override {
     envoy::config::core::v3::ConfigSource odcds_config;
     OptRef<xds::core::v3::ResourceLocator> null_locator;
-    odcds_ = OdCdsApiImpl::create(odcds_config, null_locator, cm_, notifier_, *store_.rootScope(),
-                                  validation_visitor_);
+    odcds_ = OdCdsApiImpl::create(odcds_config, null_locator, cm_, notifier_, dispatcher_,
+                                  *store_.rootScope(), validation_visitor_);
     odcds_callbacks_ = cm_.subscription_factory_.callbacks_;
   }
 
   NiceMock<MockClusterManager> cm_;
   Stats::IsolatedStoreImpl store_;
   MockMissingClusterNotifier notifier_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
   OdCdsApiSharedPtr odcds_;
   Config::SubscriptionCallbacks* odcds_callbacks_ = nullptr;
   NiceMock<ProtobufMessage::MockValidationVisitor> validation_visitor_;
@@ -119,8 +121,8 @@ TEST_F(OdCdsApiImplTest, NothingIsRequestedOnEmptyAwaitingList) {
                                          nullptr);
 }
 
-// Check that we send the requests for clusters after receiving the initial response instead of
-// putting the names into the awaiting list.
+// Check that after receiving the initial response, the clusters requested during an event loop
+// iteration are sent in a single request at its end.
 TEST_F(OdCdsApiImplTest, OnDemandUpdateIsRequestedAfterInitialFetch) {
   InSequence s;
 
@@ -129,9 +131,22 @@ TEST_F(OdCdsApiImplTest, OnDemandUpdateIsRequestedAfterInitialFetch) {
   cluster.set_name("fake_cluster");
   const auto decoded_resources = TestUtility::decodeResources({cluster});
   ASSERT_TRUE(odcds_callbacks_->onConfigUpdate(decoded_resources.refvec_, {}, "0").ok());
-  EXPECT_CALL(*cm_.subscription_factory_.subscription_,
-              requestOnDemandUpdate(UnorderedElementsAre("another_cluster")));
+
+  auto* send_awaiting_cb = new NiceMock<Event::MockSchedulableCallback>(&dispatcher_);
+  EXPECT_CALL(*cm_.subscription_factory_.subscription_, requestOnDemandUpdate(_)).Times(0);
+  odcds_->updateOnDemand("another_cluster");
   odcds_->updateOnDemand("another_cluster");
+  odcds_->updateOnDemand("third_cluster");
+  EXPECT_TRUE(send_awaiting_cb->enabled_);
+
+  EXPECT_CALL(*cm_.subscription_factory_.subscription_,
+              requestOnDemandUpdate(UnorderedElementsAre("another_cluster", "third_cluster")));
+  send_awaiting_cb->invokeCallback();
+
+  EXPECT_CALL(*cm_.subscription_factory_.subscription_,
+              requestOnDemandUpdate(UnorderedElementsAre("fourth_cluster")));
+  odcds_->updateOnDemand("fourth_cluster");
+  send_awaiting_cb->invokeCallback();
 }
 
 // Check that we report an error when we received a duplicated cluster.
@@ -3921,6 +3921,25 @@ TEST_F(ClusterInfoImplTest, Metadata) {
   EXPECT_EQ("envoy.load_balancing_policies.maglev", cluster->info()->loadBalancerFactory()->name());
 }
 
+// The load report stats are created on first use and kept out of the cluster's stats scope.
+TEST_F(ClusterInfoImplTest, LoadReportStats) {
+  const std::string yaml = R"EOF(
+    name: name
+    connect_timeout: 0.25s
+    type: STRICT_DNS
+    lb_policy: ROUND_ROBIN
+  )EOF";
+
+  auto cluster = makeCluster(yaml);
+  ClusterLoadReportStats& load_report_stats = cluster->info()->loadReportStats();
+  EXPECT_EQ(&load_report_stats, &cluster->info()->loadReportStats());
+
+  load_report_stats.upstream_rq_dropped_.add(3);
+  EXPECT_EQ(3, cluster->info()->loadReportStats().upstream_rq_dropped_.latch());
+  EXPECT_EQ(0, cluster->info()->loadReportStats().upstream_rq_dropped_.latch());
+  EXPECT_EQ(nullptr, TestUtility::findCounter(stats_, "cluster.name.upstream_rq_dropped"));
+}
+
 // Verify retry budget default values are honored.
 TEST_F(ClusterInfoImplTest, RetryBudgetDefaultPopulation) {
   std::string yaml = R"EOF(
@@ -4202,6 +4221,42 @@ TEST_F(ClusterInfoImplTest, TestTrackRequestResponseSizes) {
   EXPECT_EQ(Stats::Histogram::Unit::Bytes, req_resp_stats.upstream_rs_body_size_.unit());
 }
 
+// With deferred creation of stats, the optional stats are only created on first use.
+TEST_F(ClusterInfoImplTest, TestDeferredCreationOfOptionalStats) {
+  ON_CALL(server_context_.stats_config_, enableDeferredCreationStats())
+      .WillByDefault(Return(true));
+  const std::string yaml = R"EOF(
+    name: name
+    connect_timeout: 0.25s
+    type: STRICT_DNS
+    lb_policy: ROUND_ROBIN
+    track_cluster_stats: { request_response_sizes : true, timeout_budgets : true }
+  )EOF";
+
+  auto cluster = makeCluster(yaml);
+  EXPECT_EQ(
+      0, stats_.findGaugeByString("cluster.name.ClusterRequestResponseSizeStats.initialized")
+             ->get()
+             .value());
+  EXPECT_FALSE(stats_.findHistogramByString("cluster.name.upstream_rq_headers_size").has_value());
+  EXPECT_FALSE(stats_.findHistogramByString("cluster.name.upstream_rq_timeout_budget_percent_used")
+                   .has_value());
+
+  ASSERT_TRUE(cluster->info()->requestResponseSizeStats().has_value());
+  cluster->info()->requestResponseSizeStats()->get().upstream_rq_headers_size_.recordValue(1);
+  EXPECT_EQ(
+      1, stats_.findGaugeByString("cluster.name.ClusterRequestResponseSizeStats.initialized")
+             ->get()
+             .value());
+  EXPECT_TRUE(stats_.findHistogramByString("cluster.name.upstream_rq_headers_size").has_value());
+
+  ASSERT_TRUE(cluster->info()->timeoutBudgetStats().has_value());
+  cluster->info()->timeoutBudgetStats()->get().upstream_rq_timeout_budget_percent_used_.recordValue(
+      1);
+  EXPECT_TRUE(stats_.findHistogramByString("cluster.name.upstream_rq_timeout_budget_percent_used")
+                  .has_value());
+}
+
 TEST_F(ClusterInfoImplTest, TestTrackRemainingResourcesGauges) {
   const std::string yaml = R"EOF(
     name: name
@@ -94,6 +94,14 @@ private:
     num_clears_++;
   }
 
+  void mergeBatch(ProtobufWkt::Struct&& batch) override {
+    for (const auto& [key, count] : batch.fields()) {
+      for (int i = 0; i < count.number_value(); ++i) {
+        mockAddEntry(key);
+      }
+    }
+  }
+
   int num_inits_ = 0;
   int num_clears_ = 0;
 };
@@ -332,6 +340,43 @@ TEST_F(StreamingGrpcAccessLogTest, Flushing) {
   timer_->invokeCallback();
 }
 
+// Test that batches are sent on the stream of the logger that owns the shared stream.
+TEST_F(StreamingGrpcAccessLogTest, SharedStream) {
+  config_.set_share_stream_between_workers(true);
+  initLogger(FlushInterval, 0);
+  auto shared_stream = std::make_shared<MockGrpcAccessLoggerImpl::SharedStream>();
+  logger_->setSharedStream(shared_stream);
+  EXPECT_TRUE(logger_->sharesStream());
+
+  // The batch is kept until the shared stream has an owner.
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).Times(0);
+  logger_->log(mockHttpEntry());
+  EXPECT_EQ(0, logger_->numClears());
+
+  NiceMock<Event::MockDispatcher> main_dispatcher;
+  Grpc::MockAsyncClient* main_async_client = new Grpc::MockAsyncClient;
+  auto owner = std::make_shared<MockGrpcAccessLoggerImpl>(
+      Grpc::RawAsyncClientPtr{main_async_client}, config_, main_dispatcher,
+      *stats_store_.rootScope(), "mock_access_log_prefix.", mockMethodDescriptor(), true);
+  shared_stream->setOwner(main_dispatcher, owner);
+
+  MockAccessLogStream stream;
+  EXPECT_CALL(*main_async_client, startRaw(_, _, _, _)).WillOnce(Return(&stream));
+  expectFlushedLogEntriesCount(stream, MOCK_HTTP_LOG_FIELD_NAME, 2);
+  logger_->log(mockHttpEntry());
+  EXPECT_EQ(1, logger_->numClears());
+  // Only the owner adds the identifier.
+  EXPECT_EQ(0, logger_->numInits());
+  EXPECT_EQ(1, owner->numInits());
+  EXPECT_EQ(2,
+            TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_written")->value());
+
+  // Batches sent after the owner is gone are dropped.
+  owner.reset();
+  logger_->log(mockHttpEntry());
+  EXPECT_EQ(2, logger_->numClears());
+}
+
 class UnaryGrpcAccessLogTest : public testing::Test {
 public:
   using MockAccessLogStream = Grpc::MockAsyncStream;
@@ -1,4 +1,5 @@
 #include "envoy/config/accesslog/v3/accesslog.pb.h"
+#include "envoy/data/accesslog/v3/accesslog.pb.h"
 #include "envoy/extensions/access_loggers/file/v3/file.pb.h"
 #include "envoy/registry/registry.h"
 
@@ -47,7 +48,8 @@ class FileAccessLogTest : public testing::Test {
 public:
   FileAccessLogTest() = default;
 
-  void runTest(const std::string& yaml, absl::string_view expected, bool is_json) {
+  // Logs one entry with the given config and returns what was written to the file.
+  std::string logEntry(const std::string& yaml) {
     envoy::extensions::access_loggers::file::v3::FileAccessLog fal_config;
     TestUtility::loadFromYaml(yaml, fal_config);
 
@@ -67,14 +69,21 @@ public:
     stream_info_.upstreamInfo()->setUpstreamHost(nullptr);
     stream_info_.setResponseCode(200);
 
-    EXPECT_CALL(*file, write(_)).WillOnce(Invoke([expected, is_json](absl::string_view got) {
-      if (is_json) {
-        EXPECT_TRUE(TestUtility::jsonStringEqual(std::string(got), std::string(expected)));
-      } else {
-        EXPECT_EQ(got, expected);
-      }
+    std::string written;
+    EXPECT_CALL(*file, write(_)).WillOnce(Invoke([&written](absl::string_view got) {
+      written = std::string(got);
     }));
     logger->log({&request_headers_, &response_headers_, &response_trailers_}, stream_info_);
+    return written;
+  }
+
+  void runTest(const std::string& yaml, absl::string_view expected, bool is_json) {
+    const std::string got = logEntry(yaml);
+    if (is_json) {
+      EXPECT_TRUE(TestUtility::jsonStringEqual(got, std::string(expected)));
+    } else {
+      EXPECT_EQ(got, expected);
+    }
   }
 
   Http::TestRequestHeaderMapImpl request_headers_{{":method", "GET"}, {":path", "/bar/foo"}};
@@ -176,6 +185,28 @@ TEST_F(FileAccessLogTest, LogFormatJson) {
       true);
 }
 
+TEST_F(FileAccessLogTest, BinaryFormat) {
+  response_headers_.addCopy("x-response", "value");
+  const std::string written = logEntry(R"(
+  path: "/foo"
+  binary_format:
+    additional_response_headers_to_log: ["x-response"]
+)");
+
+  Protobuf::io::ArrayInputStream stream(written.data(), written.size());
+  Protobuf::io::CodedInputStream coded_stream(&stream);
+  uint32_t length;
+  ASSERT_TRUE(coded_stream.ReadVarint32(&length));
+  EXPECT_EQ(written.size() - coded_stream.CurrentPosition(), length);
+  envoy::data::accesslog::v3::HTTPAccessLogEntry log_entry;
+  ASSERT_TRUE(log_entry.ParseFromArray(written.data() + coded_stream.CurrentPosition(), length));
+
+  EXPECT_EQ("/bar/foo", log_entry.request().path());
+  EXPECT_EQ(envoy::config::core::v3::GET, log_entry.request().request_method());
+  EXPECT_EQ(200, log_entry.response().response_code().value());
+  EXPECT_EQ("value", log_entry.response().response_headers().at("x-response"));
+}
+
 } // namespace
 } // namespace File
 } // namespace AccessLoggers
@@ -0,0 +1,166 @@
+#include "envoy/config/accesslog/v3/accesslog.pb.h"
+#include "envoy/extensions/access_loggers/filters/adaptive_sampling/v3/adaptive_sampling.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/access_loggers/filters/adaptive_sampling/adaptive_sampling.h"
+#include "source/extensions/access_loggers/filters/adaptive_sampling/config.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/common.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Filters {
+namespace AdaptiveSampling {
+namespace {
+
+class AdaptiveSamplingFilterTest : public testing::Test {
+public:
+  void initialize(const std::string& yaml) {
+    envoy::extensions::access_loggers::filters::adaptive_sampling::v3::AdaptiveSamplingFilter
+        config;
+    TestUtility::loadFromYaml(yaml, config);
+    filter_ = std::make_unique<AdaptiveSamplingFilter>(config, *store_.rootScope(), tls_,
+                                                       time_system_, random_);
+    stream_info_.setResponseCode(200);
+  }
+
+  bool evaluate() { return filter_->evaluate({}, stream_info_); }
+
+  uint64_t counter(const std::string& name) {
+    return store_.counter("access_logs.adaptive_sampling.test." + name).value();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Stats::TestUtil::TestStore store_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+  std::unique_ptr<AdaptiveSamplingFilter> filter_;
+};
+
+const std::string BasicConfig = R"EOF(
+stat_prefix: test
+max_sampled_entries_per_second: 2
+slow_request_threshold: 0.1s
+)EOF";
+
+TEST_F(AdaptiveSamplingFilterTest, FailedAndSlowRequestsAreAlwaysLogged) {
+  initialize(BasicConfig);
+  EXPECT_CALL(random_, random()).Times(0);
+
+  stream_info_.setResponseCode(503);
+  EXPECT_TRUE(evaluate());
+  stream_info_.response_code_ = absl::nullopt;
+  EXPECT_TRUE(evaluate());
+  stream_info_.setResponseCode(200);
+  stream_info_.setResponseFlag(StreamInfo::CoreResponseFlag::UpstreamRequestTimeout);
+  EXPECT_TRUE(evaluate());
+
+  NiceMock<StreamInfo::MockStreamInfo> slow_stream_info;
+  slow_stream_info.setResponseCode(200);
+  slow_stream_info.end_time_ = std::chrono::milliseconds(100);
+  EXPECT_TRUE(filter_->evaluate({}, slow_stream_info));
+
+  EXPECT_EQ(4, counter("always_logged"));
+  EXPECT_EQ(0, counter("sampled"));
+}
+
+TEST_F(AdaptiveSamplingFilterTest, ErrorStatusThreshold) {
+  initialize(R"EOF(
+stat_prefix: test
+max_sampled_entries_per_second: 1
+error_status_threshold: 400
+)EOF");
+
+  stream_info_.setResponseCode(404);
+  EXPECT_TRUE(evaluate());
+  EXPECT_EQ(1, counter("always_logged"));
+}
+
+TEST_F(AdaptiveSamplingFilterTest, SampledRequestsAreCappedPerSecond) {
+  initialize(BasicConfig);
+  stream_info_.end_time_ = std::chrono::milliseconds(10);
+  ON_CALL(random_, random()).WillByDefault(Return(0));
+
+  // Nothing is known about the traffic yet, so the token bucket limits the first second.
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(i < 2, evaluate());
+  }
+  EXPECT_EQ(2, counter("sampled"));
+  EXPECT_EQ(6, counter("not_sampled"));
+
+  // After a second with 8 requests, each request is logged with a probability of 1/4.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  const Random::MockRandomGenerator::result_type quarter = random_.max() / 4;
+  EXPECT_CALL(random_, random())
+      .WillOnce(Return(quarter + 1))
+      .WillOnce(Return(quarter - 1))
+      .WillOnce(Return(quarter + 1))
+      .WillOnce(Return(quarter - 1))
+      .WillOnce(Return(quarter - 1));
+  EXPECT_FALSE(evaluate());
+  EXPECT_TRUE(evaluate());
+  EXPECT_FALSE(evaluate());
+  EXPECT_TRUE(evaluate());
+  // The token bucket is empty again.
+  EXPECT_FALSE(evaluate());
+  EXPECT_EQ(4, counter("sampled"));
+  EXPECT_EQ(9, counter("not_sampled"));
+}
+
+TEST_F(AdaptiveSamplingFilterTest, ProbabilityRecoversWhenTrafficDrops) {
+  initialize(BasicConfig);
+  stream_info_.end_time_ = std::chrono::milliseconds(10);
+  ON_CALL(random_, random()).WillByDefault(Return(random_.max() / 2));
+
+  for (int i = 0; i < 8; ++i) {
+    evaluate();
+  }
+  // One request in the second window keeps the probability at 1/4 for it, but the third window
+  // logs everything again.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_FALSE(evaluate());
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_TRUE(evaluate());
+  EXPECT_TRUE(evaluate());
+}
+
+TEST(AdaptiveSamplingFilterFactoryTest, CreateFilter) {
+  auto* factory = Registry::FactoryRegistry<AccessLog::ExtensionFilterFactory>::getFactory(
+      "envoy.access_loggers.extension_filters.adaptive_sampling");
+  ASSERT_NE(nullptr, factory);
+
+  envoy::extensions::access_loggers::filters::adaptive_sampling::v3::AdaptiveSamplingFilter
+      sampling_config;
+  TestUtility::loadFromYaml(BasicConfig, sampling_config);
+  envoy::config::accesslog::v3::ExtensionFilter config;
+  config.set_name("envoy.access_loggers.extension_filters.adaptive_sampling");
+  config.mutable_typed_config()->PackFrom(sampling_config);
+
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  EXPECT_NE(nullptr, factory->createFilter(config, context));
+
+  config.mutable_typed_config()->PackFrom(
+      envoy::extensions::access_loggers::filters::adaptive_sampling::v3::AdaptiveSamplingFilter());
+  EXPECT_THROW(factory->createFilter(config, context), ProtoValidationException);
+}
+
+} // namespace
+} // namespace AdaptiveSampling
+} // namespace Filters
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -309,6 +309,39 @@ TEST_F(OriginalDstClusterTest, AddressCollision) {
   EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
 }
 
+TEST_F(OriginalDstClusterTest, ReuseAddedHost) {
+  std::string yaml = R"EOF(
+    name: name
+    connect_timeout: 1.250s
+    type: ORIGINAL_DST
+    lb_policy: CLUSTER_PROVIDED
+  )EOF";
+
+  EXPECT_CALL(initialized_, ready());
+  setupFromYaml(yaml);
+
+  NiceMock<Network::MockConnection> connection;
+  TestLoadBalancerContext lb_context(&connection);
+  connection.stream_info_.downstream_connection_info_provider_->restoreLocalAddress(
+      std::make_shared<Network::Address::Ipv4Instance>("10.10.11.11"));
+
+  // The same load balancer adds a single host for repeated requests to a new address.
+  OriginalDstCluster::LoadBalancer lb(handle_);
+  Event::PostCb post_cb;
+  EXPECT_CALL(server_context_.dispatcher_, post(_)).WillOnce([&post_cb](Event::PostCb cb) {
+    post_cb = std::move(cb);
+  });
+  HostConstSharedPtr host1 = lb.chooseHost(&lb_context);
+  ASSERT_NE(host1, nullptr);
+  HostConstSharedPtr host2 = lb.chooseHost(&lb_context);
+  EXPECT_EQ(host1, host2);
+
+  EXPECT_CALL(membership_updated_, ready());
+  post_cb();
+  EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+  EXPECT_EQ(host1, OriginalDstCluster::LoadBalancer(handle_).chooseHost(&lb_context));
+}
+
 TEST_F(OriginalDstClusterTest, HostInUse) {
   std::string yaml = R"EOF(
     name: name
@@ -438,6 +438,12 @@ TEST_F(RedisLoadBalancerContextImplTest, Basic) {
   EXPECT_EQ(absl::optional<uint64_t>(44950), context2.computeHashKey());
   EXPECT_EQ(false, context2.isReadCommand());
   EXPECT_EQ(NetworkFilters::Common::Redis::Client::ReadPolicy::Primary, context2.readPolicy());
+
+  // Commands are matched in any case.
+  set_request.asArray()[0].asString() = "SET";
+  RedisLoadBalancerContextImpl context3("foo", true, true, set_request,
+                                        NetworkFilters::Common::Redis::Client::ReadPolicy::Primary);
+  EXPECT_EQ(false, context3.isReadCommand());
 }
 
 TEST_F(RedisLoadBalancerContextImplTest, CompositeArray) {
@@ -1625,6 +1625,54 @@ TEST_F(DnsCacheImplTest, CacheLoad) {
   }
 }
 
+// Entries loaded stale from the key value store are served while they are refreshed.
+TEST_F(DnsCacheImplTest, CacheLoadRefreshesStaleEntries) {
+  auto* time_source = new NiceMock<MockTimeSystem>();
+  ON_CALL(*time_source, monotonicTime())
+      .WillByDefault(Return(MonotonicTime(std::chrono::seconds(100))));
+  context_.server_factory_context_.dispatcher_.time_system_.reset(time_source);
+
+  MockKeyValueStoreFactory factory;
+  EXPECT_CALL(factory, createEmptyConfigProto()).WillRepeatedly(Invoke([]() {
+    return std::make_unique<
+        envoy::extensions::key_value::file_based::v3::FileBasedKeyValueStoreConfig>();
+  }));
+  EXPECT_CALL(factory, createStore(_, _, _, _)).WillOnce(Invoke([]() {
+    auto store = std::make_unique<NiceMock<MockKeyValueStore>>();
+    // Resolved 100s ago with a TTL of 40s.
+    EXPECT_CALL(*store, iterate).WillOnce(Invoke([&](KeyValueStore::ConstIterateCb fn) {
+      fn("foo.com:80", "10.0.0.2:80|40|0");
+    }));
+    return store;
+  }));
+  Registry::InjectFactory<KeyValueStoreFactory> injector(factory);
+  auto* key_value_config = config_.mutable_key_value_config()->mutable_config();
+  key_value_config->set_name("mock_key_value_store_factory");
+  key_value_config->mutable_typed_config()->PackFrom(
+      envoy::extensions::key_value::file_based::v3::FileBasedKeyValueStoreConfig());
+
+  Event::MockTimer* resolve_timer =
+      new Event::MockTimer(&context_.server_factory_context_.dispatcher_);
+  Event::MockTimer* timeout_timer =
+      new Event::MockTimer(&context_.server_factory_context_.dispatcher_);
+  EXPECT_CALL(*resolve_timer, enableTimer(std::chrono::milliseconds(0), _));
+  initialize();
+
+  MockLoadDnsCacheEntryCallbacks callbacks;
+  auto result = dns_cache_->loadDnsCacheEntry("foo.com", 80, false, callbacks);
+  EXPECT_EQ(DnsCache::LoadDnsCacheEntryStatus::InCache, result.status_);
+  ASSERT_NE(absl::nullopt, result.host_info_);
+  EXPECT_EQ("10.0.0.2:80", result.host_info_.value()->address()->asString());
+
+  EXPECT_CALL(*timeout_timer, enableTimer(std::chrono::milliseconds(5000), nullptr));
+  EXPECT_CALL(*resolver_, resolve("foo.com", _, _)).WillOnce(Return(&resolver_->active_query_));
+  resolve_timer->invokeCallback();
+
+  EXPECT_CALL(resolver_->active_query_,
+              cancel(Network::ActiveDnsQuery::CancelReason::QueryAbandoned));
+  dns_cache_.reset();
+}
+
 // Make sure the cache manager can handle the context going out of scope.
 TEST(DnsCacheManagerImplTest, TestLifetime) {
   NiceMock<Server::Configuration::MockGenericFactoryContext> context;
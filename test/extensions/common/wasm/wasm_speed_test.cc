@@ -1,3 +1,4 @@
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/thread.h"
 #include "source/common/common/thread_synchronizer.h"
 #include "source/extensions/common/wasm/wasm.h"
@@ -63,6 +64,50 @@ void bmWasmSpeedTest(benchmark::State& state) {
 
 BENCHMARK(bmWasmSpeedTest);
 
+// Measures copying a body of state.range(0) bytes into the VM, as done by
+// proxy_get_buffer_bytes when a plugin inspects the whole body.
+void bmWasmBodyInspection(benchmark::State& state) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logging_state(spdlog::level::warn,
+                                       Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  Envoy::Logger::Registry::getLog(Envoy::Logger::Id::wasm).set_level(spdlog::level::off);
+  Envoy::Stats::IsolatedStoreImpl stats_store;
+  Envoy::Api::ApiPtr api = Envoy::Api::createApiForTest(stats_store);
+  Envoy::Upstream::MockClusterManager cluster_manager;
+  Envoy::Event::DispatcherPtr dispatcher(api->allocateDispatcher("wasm_test"));
+  auto scope = Envoy::Stats::ScopeSharedPtr(stats_store.createScope("wasm."));
+
+  envoy::extensions::wasm::v3::PluginConfig plugin_config;
+  *plugin_config.mutable_vm_config()->mutable_runtime() = "envoy.wasm.runtime.null";
+  auto config = Envoy::Extensions::Common::Wasm::WasmConfig(plugin_config);
+  auto wasm = std::make_unique<Envoy::Extensions::Common::Wasm::Wasm>(config, "", scope, *api,
+                                                                      cluster_manager, *dispatcher);
+  // The name of the Null VM plugin.
+  RELEASE_ASSERT(wasm->load("CommonWasmTestCpp", false), "");
+  RELEASE_ASSERT(wasm->initialize(), "");
+
+  // The body is spread over slices, as it would be when read from the network.
+  Envoy::Buffer::OwnedImpl body;
+  const std::string chunk(16 * 1024, 'a');
+  while (body.length() < static_cast<uint64_t>(state.range(0))) {
+    body.appendSliceForTest(chunk);
+  }
+  Envoy::Extensions::Common::Wasm::Buffer buffer;
+  buffer.set(static_cast<const Envoy::Buffer::Instance*>(&body));
+
+  uint64_t pointer = 0;
+  uint64_t size = 0;
+  for (__attribute__((unused)) auto _ : state) {
+    // The Null VM accesses host memory, so the output arguments are host addresses.
+    buffer.copyTo(wasm.get(), 0, buffer.size(), reinterpret_cast<uint64_t>(&pointer),
+                  reinterpret_cast<uint64_t>(&size));
+    ::free(reinterpret_cast<void*>(pointer));
+  }
+  state.SetBytesProcessed(state.iterations() * body.length());
+}
+
+BENCHMARK(bmWasmBodyInspection)->Arg(16 * 1024)->Arg(1024 * 1024);
+
 } // namespace Envoy
 
 int main(int argc, char** argv) {
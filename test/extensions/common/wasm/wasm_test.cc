@@ -1297,6 +1297,33 @@ TEST_P(WasmCommonTest, ThreadLocalCopyRetainsEnforcement) {
   thread_local_wasm->start(plugin);
 }
 
+TEST(WasmCommonThreadLocalTest, LazyWorkerInitialization) {
+  NiceMock<LocalInfo::MockLocalInfo> local_info;
+  NiceMock<Event::MockDispatcher> dispatcher;
+  envoy::extensions::wasm::v3::PluginConfig plugin_config;
+  plugin_config.set_fail_open(true);
+  plugin_config.set_lazy_worker_initialization(true);
+  auto plugin = std::make_shared<Extensions::Common::Wasm::Plugin>(
+      plugin_config, envoy::config::core::v3::TrafficDirection::UNSPECIFIED, local_info, nullptr);
+
+  // The handle is only created on first use, and then kept.
+  int created = 0;
+  PluginHandleSharedPtrThreadLocal lazy(std::function<PluginHandleSharedPtr()>([&]() {
+    ++created;
+    return std::make_shared<PluginHandle>(nullptr, plugin);
+  }));
+  EXPECT_EQ(0, created);
+  PluginHandleSharedPtr handle = lazy.handle();
+  EXPECT_NE(nullptr, handle);
+  EXPECT_EQ(handle, lazy.handle());
+  EXPECT_EQ(1, created);
+
+  // Without a base VM, the plugin handle has no VM so that the plugin fails open or closed.
+  auto thread_local_handle = createThreadLocalPluginHandle(nullptr, plugin, dispatcher);
+  ASSERT_NE(nullptr, thread_local_handle->handle());
+  EXPECT_EQ(nullptr, thread_local_handle->handle()->wasmHandle());
+}
+
 class WasmCommonContextTest : public Common::Wasm::WasmHttpFilterTestBase<
                                   testing::TestWithParam<std::tuple<std::string, std::string>>> {
 public:
@@ -1,4 +1,6 @@
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/base64.h"
+#include "source/common/crypto/utility.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/compression/zstd/compressor/config.h"
 #include "source/extensions/compression/zstd/decompressor/zstd_decompressor_impl.h"
@@ -138,6 +140,55 @@ TEST_F(ZstdCompressorImplTest, IllegalConfig) {
                "assert failure: id != 0. Details: Illegal Zstd dictionary");
 }
 
+TEST_F(ZstdCompressorImplTest, SharedDictionaryProducesDcz) {
+  envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+  Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
+  NiceMock<Server::Configuration::MockFactoryContext> mock_context;
+  const std::string dictionary = R"({"id": 1, "name": "example", "tags": ["a", "b", "c"]})";
+  zstd.mutable_shared_dictionary()->set_inline_string(dictionary);
+  auto factory = lib_factory.createCompressorFactoryFromProto(zstd, mock_context);
+  EXPECT_EQ("dcz", factory->contentEncoding());
+  const std::vector<uint8_t> hash =
+      Envoy::Common::Crypto::UtilitySingleton::get().getSha256Digest(Buffer::OwnedImpl(dictionary));
+  EXPECT_EQ(absl::StrCat(":",
+                         Base64::encode(reinterpret_cast<const char*>(hash.data()), hash.size()),
+                         ":"),
+            factory->availableDictionary());
+
+  const std::string text = R"({"id": 2, "name": "example", "tags": ["a", "b", "c", "d"]})";
+  Buffer::OwnedImpl buffer(text);
+  factory->createCompressor()->compress(buffer,
+                                        Envoy::Compression::Compressor::State::Finish);
+
+  // The output starts with a skippable frame holding the dictionary's hash.
+  const std::string output = buffer.toString();
+  ASSERT_GT(output.size(), 40u);
+  EXPECT_EQ(std::string("\x5e\x2a\x4d\x18\x20\x00\x00\x00", 8), output.substr(0, 8));
+  EXPECT_EQ(std::string(hash.begin(), hash.end()), output.substr(8, 32));
+
+  // The rest is a zstd frame that decompresses with the dictionary as raw content.
+  std::string decompressed(text.size(), '\0');
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+  const size_t result =
+      ZSTD_decompress_usingDict(dctx.get(), decompressed.data(), decompressed.size(),
+                                output.data() + 40, output.size() - 40, dictionary.data(),
+                                dictionary.size());
+  ASSERT_FALSE(ZSTD_isError(result));
+  EXPECT_EQ(text.size(), result);
+  EXPECT_EQ(text, decompressed);
+}
+
+TEST_F(ZstdCompressorImplTest, SharedDictionaryConflictsWithDictionary) {
+  envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+  Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
+  NiceMock<Server::Configuration::MockFactoryContext> mock_context;
+  zstd.mutable_shared_dictionary()->set_inline_string("shared");
+  zstd.mutable_dictionary()->set_inline_string("trained");
+  EXPECT_THROW_WITH_MESSAGE(lib_factory.createCompressorFactoryFromProto(zstd, mock_context),
+                            EnvoyException,
+                            "zstd dictionary and shared_dictionary cannot both be set");
+}
+
 } // namespace
 } // namespace Compressor
 } // namespace Zstd
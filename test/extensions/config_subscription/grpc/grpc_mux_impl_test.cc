@@ -75,7 +75,7 @@ public:
         /*rate_limit_settings_=*/custom_rate_limit_settings,
         /*scope_=*/*stats_.rootScope(),
         /*config_validators_=*/std::move(config_validators_),
-        /*xds_resources_delegate_=*/XdsResourcesDelegateOptRef(),
+        /*xds_resources_delegate_=*/xds_resources_delegate_,
         /*xds_config_tracker_=*/XdsConfigTrackerOptRef(),
         /*backoff_strategy_=*/
         std::make_unique<JitteredExponentialBackOffStrategy>(
@@ -125,6 +125,7 @@ public:
   Stats::Gauge& control_plane_connected_state_;
   Stats::Gauge& control_plane_pending_requests_;
   MockEdsResourcesCache* eds_resources_cache_{nullptr};
+  XdsResourcesDelegateOptRef xds_resources_delegate_;
 };
 
 class GrpcMuxImplTest : public GrpcMuxImplTestBase {
@@ -659,6 +660,68 @@ TEST_F(GrpcMuxImplTest, WildcardWatch) {
   }
 }
 
+// A delegate returning fixed resources, which asks for them to be applied on start.
+class StartupXdsResourcesDelegate : public XdsResourcesDelegate {
+public:
+  std::vector<envoy::service::discovery::v3::Resource>
+  getResources(const XdsSourceId&, const absl::flat_hash_set<std::string>&) const override {
+    return resources_;
+  }
+  void onConfigUpdated(const XdsSourceId&, const std::vector<DecodedResourceRef>&) override {}
+  void onResourceLoadFailed(const XdsSourceId&, const std::string&,
+                            const absl::optional<EnvoyException>&) override {}
+  bool loadResourcesOnStart() const override { return true; }
+
+  std::vector<envoy::service::discovery::v3::Resource> resources_;
+};
+
+// Validate that persisted resources are applied on start, until the server responds.
+TEST_F(GrpcMuxImplTest, LoadDelegateResourcesOnStart) {
+  StartupXdsResourcesDelegate delegate;
+  envoy::config::endpoint::v3::ClusterLoadAssignment persisted_assignment;
+  persisted_assignment.set_cluster_name("x");
+  auto& persisted_resource = delegate.resources_.emplace_back();
+  persisted_resource.set_name("x");
+  persisted_resource.set_version("1");
+  persisted_resource.mutable_resource()->PackFrom(persisted_assignment);
+  xds_resources_delegate_ = delegate;
+  auto* startup_cb = new NiceMock<Event::MockSchedulableCallback>(&dispatcher_);
+  setup();
+
+  const std::string& type_url = Config::TypeUrl::get().ClusterLoadAssignment;
+  OpaqueResourceDecoderSharedPtr resource_decoder(
+      std::make_shared<TestUtility::TestOpaqueResourceDecoderImpl<
+          envoy::config::endpoint::v3::ClusterLoadAssignment>>("cluster_name"));
+  auto foo_sub = grpc_mux_->addWatch(type_url, {"x"}, callbacks_, resource_decoder, {});
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {"x"}, "", true);
+  EXPECT_CALL(*startup_cb, scheduleCallbackCurrentIteration());
+  grpc_mux_->start();
+
+  EXPECT_CALL(callbacks_, onConfigUpdate(_, "1"))
+      .WillOnce(Invoke([](const std::vector<DecodedResourceRef>& resources, const std::string&) {
+        EXPECT_EQ(1, resources.size());
+        EXPECT_EQ("x", resources[0].get().name());
+        return absl::OkStatus();
+      }));
+  startup_cb->invokeCallback();
+
+  auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+  response->set_type_url(type_url);
+  response->set_version_info("2");
+  envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment;
+  load_assignment.set_cluster_name("x");
+  response->add_resources()->PackFrom(load_assignment);
+  EXPECT_CALL(callbacks_, onConfigUpdate(_, "2"));
+  expectSendMessage(type_url, {"x"}, "2");
+  grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+
+  // Once the server responded, the persisted resources are not applied again.
+  EXPECT_CALL(callbacks_, onConfigUpdate(_, _)).Times(0);
+  startup_cb->enabled_ = true;
+  startup_cb->invokeCallback();
+}
+
 // Validate behavior when watches specify resources (potentially overlapping).
 TEST_F(GrpcMuxImplTest, WatchDemux) {
   setup();
@@ -40,6 +40,48 @@ TEST(Evaluator, Print) {
   EXPECT_EQ(print(CelValue::CreateError(&status)), "CelError value");
 }
 
+TEST(Evaluator, SharedExpressionsAreDeduplicated) {
+  auto constant_arena = std::make_unique<Protobuf::Arena>();
+  auto builder = createBuilder(constant_arena.get());
+  auto instance = std::make_shared<BuilderInstance>(std::move(builder), std::move(constant_arena));
+
+  google::api::expr::v1alpha1::Expr sum;
+  TestUtility::loadFromYaml(R"EOF(
+  call_expr:
+    function: _+_
+    args:
+    - const_expr:
+        int64_value: 1
+    - const_expr:
+        int64_value: 2
+  )EOF",
+                            sum);
+  google::api::expr::v1alpha1::Expr one;
+  TestUtility::loadFromYaml(R"EOF(
+  const_expr:
+    int64_value: 1
+  )EOF",
+                            one);
+
+  ExpressionSharedPtr first = instance->createSharedExpression(sum);
+  ExpressionSharedPtr second = instance->createSharedExpression(sum);
+  ExpressionSharedPtr other = instance->createSharedExpression(one);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_NE(first.get(), other.get());
+
+  Protobuf::Arena arena;
+  google::api::expr::runtime::Activation activation;
+  auto result = first->Evaluate(activation, &arena);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(3, result.value().Int64OrDie());
+
+  // The expressions keep the builder alive.
+  instance.reset();
+  result = second->Evaluate(activation, &arena);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(3, result.value().Int64OrDie());
+}
+
 } // namespace
 } // namespace Expr
 } // namespace Common
@@ -1,6 +1,7 @@
 #include "source/extensions/filters/common/local_ratelimit/local_ratelimit_impl.h"
 
 #include "test/mocks/event/mocks.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -208,6 +209,63 @@ TEST_F(LocalRateLimiterImplTest, TokenBucketStatus) {
   EXPECT_EQ(rate_limiter_->remainingFillInterval(route_descriptors_), 3);
 }
 
+// Verify that a single thread can consume all the tokens when they are split into per-worker
+// budgets, and that fills move the tokens to the budget that sees the requests.
+TEST_F(LocalRateLimiterImplTest, PerWorkerTokenBudgets) {
+  initializeTimer();
+  rate_limiter_ = std::make_shared<LocalRateLimiterImpl>(
+      std::chrono::milliseconds(200), 20, 10, dispatcher_, descriptors_, true, true);
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 20);
+
+  // 20 -> 0 tokens, taken from the budgets of other threads as well.
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  }
+  EXPECT_FALSE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 0);
+
+  // 0 -> 10 tokens
+  EXPECT_CALL(*fill_timer_, enableTimer(std::chrono::milliseconds(200), nullptr));
+  fill_timer_->invokeCallback();
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 10);
+
+  // 10 -> 20 tokens
+  EXPECT_CALL(*fill_timer_, enableTimer(std::chrono::milliseconds(200), nullptr));
+  fill_timer_->invokeCallback();
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 20);
+
+  // 20 -> 0 tokens
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  }
+  EXPECT_FALSE(rate_limiter_->requestAllowed(route_descriptors_));
+}
+
+// Verify that threads consuming their own budgets concurrently never get more tokens than the
+// bucket holds.
+TEST_F(LocalRateLimiterImplTest, PerWorkerTokenBudgetsConcurrentThreads) {
+  initializeTimer();
+  rate_limiter_ = std::make_shared<LocalRateLimiterImpl>(
+      std::chrono::milliseconds(200), 100, 100, dispatcher_, descriptors_, true, true);
+
+  std::atomic<uint32_t> allowed{0};
+  std::vector<Thread::ThreadPtr> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.push_back(Thread::threadFactoryForTest().createThread([this, &allowed]() {
+      for (int j = 0; j < 100; ++j) {
+        if (rate_limiter_->requestAllowed(route_descriptors_)) {
+          ++allowed;
+        }
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+  EXPECT_EQ(allowed.load(), 100U);
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 0);
+}
+
 class LocalRateLimiterDescriptorImplTest : public LocalRateLimiterImplTest {
 public:
   void initializeWithDescriptor(const std::chrono::milliseconds fill_interval,
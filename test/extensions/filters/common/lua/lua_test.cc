@@ -86,6 +86,49 @@ TEST_F(LuaTest, CoroutineRefCounting) {
   lua_gc(cr2->luaState(), LUA_GCCOLLECT, 0);
 }
 
+// Finished coroutine threads are reused, threads which errored or are still yielded are not.
+TEST_F(LuaTest, CoroutineReuse) {
+  const std::string SCRIPT{R"EOF(
+    function callMe(object)
+      if object == "yield" then
+        coroutine.yield()
+      elseif object == "error" then
+        error("boom")
+      end
+      return object
+    end
+  )EOF"};
+
+  setup(SCRIPT);
+  const int callMeRef = state_->getGlobalRef(state_->registerGlobal("callMe", initializers_));
+
+  CoroutinePtr cr(state_->createCoroutine());
+  lua_State* finished = cr->luaState();
+  lua_pushstring(cr->luaState(), "finish");
+  cr->start(callMeRef, 1, yield_callback_);
+  EXPECT_EQ(cr->state(), Coroutine::State::Finished);
+  cr.reset();
+
+  cr = state_->createCoroutine();
+  EXPECT_EQ(finished, cr->luaState());
+  EXPECT_EQ(0, lua_gettop(cr->luaState()));
+  lua_pushstring(cr->luaState(), "error");
+  EXPECT_THROW_WITH_MESSAGE(cr->start(callMeRef, 1, yield_callback_), LuaException,
+                            "[string \"...\"]:6: boom");
+  cr.reset();
+  cr = state_->createCoroutine();
+  EXPECT_NE(finished, cr->luaState());
+
+  lua_State* yielded = cr->luaState();
+  lua_pushstring(cr->luaState(), "yield");
+  EXPECT_CALL(on_yield_, ready());
+  cr->start(callMeRef, 1, yield_callback_);
+  EXPECT_EQ(cr->state(), Coroutine::State::Yielded);
+  cr.reset();
+  cr = state_->createCoroutine();
+  EXPECT_NE(yielded, cr->luaState());
+}
+
 // Test that we don't crash when empty errors are used (see PR #15471)
 TEST_F(LuaTest, EmptyError) {
   const std::string SCRIPT{R"EOF(
@@ -0,0 +1,208 @@
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "envoy/service/ratelimit/v3/rls.pb.h"
+
+#include "source/common/tracing/null_span_impl.h"
+#include "source/extensions/filters/common/ratelimit/batching_client_impl.h"
+#include "source/extensions/filters/common/ratelimit/ratelimit_impl.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/grpc/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Pointee;
+using testing::SizeIs;
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RateLimit {
+namespace {
+
+class MockRequestCallbacks : public RequestCallbacks {
+public:
+  void complete(LimitStatus status, DescriptorStatusListPtr&& descriptor_statuses,
+                Http::ResponseHeaderMapPtr&&, Http::RequestHeaderMapPtr&&, const std::string&,
+                DynamicMetadataPtr&&) override {
+    complete_(status, descriptor_statuses.get());
+  }
+
+  MOCK_METHOD(void, complete_,
+              (LimitStatus status, const DescriptorStatusList* descriptor_statuses));
+};
+
+class RateLimitBatcherTest : public testing::Test, public Event::TestUsingSimulatedTime {
+public:
+  void initialize(uint32_t max_descriptors, std::chrono::milliseconds ok_lease_duration) {
+    async_client_ = new Grpc::MockAsyncClient();
+    timer_ = new NiceMock<Event::MockTimer>(&dispatcher_);
+    batcher_ = std::make_shared<RateLimitBatcher>(
+        Grpc::RawAsyncClientPtr{async_client_}, absl::optional<std::chrono::milliseconds>(),
+        dispatcher_, std::chrono::milliseconds(5), max_descriptors, ok_lease_duration);
+    client_a_ = std::make_unique<BatchingClientImpl>(batcher_);
+    client_b_ = std::make_unique<BatchingClientImpl>(batcher_);
+  }
+
+  // Expects one request to the service and saves the callbacks of its batch.
+  void expectSend(const envoy::service::ratelimit::v3::RateLimitRequest& request) {
+    EXPECT_CALL(*async_client_, sendRaw(_, _, Grpc::ProtoBufferEq(request), _, _, _))
+        .WillOnce(Invoke([this](absl::string_view, absl::string_view, Buffer::InstancePtr&&,
+                                Grpc::RawAsyncRequestCallbacks& callbacks, Tracing::Span&,
+                                const Http::AsyncClient::RequestOptions&) -> Grpc::AsyncRequest* {
+          batch_callbacks_ = dynamic_cast<RateLimitAsyncCallbacks*>(&callbacks);
+          return &async_request_;
+        }));
+  }
+
+  static std::unique_ptr<envoy::service::ratelimit::v3::RateLimitResponse>
+  response(std::vector<envoy::service::ratelimit::v3::RateLimitResponse::Code> codes) {
+    auto response = std::make_unique<envoy::service::ratelimit::v3::RateLimitResponse>();
+    response->set_overall_code(envoy::service::ratelimit::v3::RateLimitResponse::OK);
+    for (const auto code : codes) {
+      response->add_statuses()->set_code(code);
+      if (code == envoy::service::ratelimit::v3::RateLimitResponse::OVER_LIMIT) {
+        response->set_overall_code(code);
+      }
+    }
+    return response;
+  }
+
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  Grpc::MockAsyncClient* async_client_{};
+  Event::MockTimer* timer_{};
+  Grpc::MockAsyncRequest async_request_;
+  RateLimitBatcherSharedPtr batcher_;
+  std::unique_ptr<BatchingClientImpl> client_a_;
+  std::unique_ptr<BatchingClientImpl> client_b_;
+  MockRequestCallbacks callbacks_a_;
+  MockRequestCallbacks callbacks_b_;
+  RateLimitAsyncCallbacks* batch_callbacks_{};
+  StreamInfo::MockStreamInfo stream_info_;
+};
+
+TEST_F(RateLimitBatcherTest, BatchesConcurrentChecks) {
+  initialize(100, std::chrono::milliseconds(0));
+
+  client_a_->limit(callbacks_a_, "foo", {{{{"foo", "bar"}}}}, Tracing::NullSpan::instance(),
+                   stream_info_);
+  client_b_->limit(callbacks_b_, "foo", {{{{"foo", "baz"}}}}, Tracing::NullSpan::instance(),
+                   stream_info_);
+  EXPECT_TRUE(timer_->enabled_);
+
+  envoy::service::ratelimit::v3::RateLimitRequest request;
+  GrpcClientImpl::createRequest(request, "foo", {{{{"foo", "bar"}}}, {{{"foo", "baz"}}}}, 0);
+  expectSend(request);
+  timer_->invokeCallback();
+  ASSERT_NE(nullptr, batch_callbacks_);
+
+  EXPECT_CALL(callbacks_a_, complete_(LimitStatus::OK, Pointee(SizeIs(1))));
+  EXPECT_CALL(callbacks_b_, complete_(LimitStatus::OverLimit, Pointee(SizeIs(1))));
+  batch_callbacks_->onSuccess(
+      response({envoy::service::ratelimit::v3::RateLimitResponse::OK,
+                envoy::service::ratelimit::v3::RateLimitResponse::OVER_LIMIT}),
+      Tracing::NullSpan::instance());
+}
+
+TEST_F(RateLimitBatcherTest, SendsFullBatchImmediately) {
+  initialize(2, std::chrono::milliseconds(0));
+
+  client_a_->limit(callbacks_a_, "foo", {{{{"foo", "bar"}}}}, Tracing::NullSpan::instance(),
+                   stream_info_);
+
+  // Checks for another domain go into their own request, which is sent once it is full.
+  envoy::service::ratelimit::v3::RateLimitRequest request;
+  GrpcClientImpl::createRequest(request, "bar", {{{{"foo", "bar"}}}, {{{"foo", "baz"}}}}, 0);
+  expectSend(request);
+  client_b_->limit(callbacks_b_, "bar", {{{{"foo", "bar"}}}, {{{"foo", "baz"}}}},
+                   Tracing::NullSpan::instance(), stream_info_);
+  EXPECT_CALL(callbacks_b_, complete_(LimitStatus::OK, Pointee(SizeIs(2))));
+  batch_callbacks_->onSuccess(
+      response({envoy::service::ratelimit::v3::RateLimitResponse::OK,
+                envoy::service::ratelimit::v3::RateLimitResponse::OK}),
+      Tracing::NullSpan::instance());
+
+  request.Clear();
+  GrpcClientImpl::createRequest(request, "foo", {{{{"foo", "bar"}}}}, 0);
+  expectSend(request);
+  timer_->invokeCallback();
+  EXPECT_CALL(callbacks_a_, complete_(LimitStatus::OK, Pointee(SizeIs(1))));
+  batch_callbacks_->onSuccess(response({envoy::service::ratelimit::v3::RateLimitResponse::OK}),
+                              Tracing::NullSpan::instance());
+}
+
+TEST_F(RateLimitBatcherTest, FailureCompletesUncancelledChecks) {
+  initialize(100, std::chrono::milliseconds(0));
+
+  client_a_->limit(callbacks_a_, "foo", {{{{"foo", "bar"}}}}, Tracing::NullSpan::instance(),
+                   stream_info_);
+  client_b_->limit(callbacks_b_, "foo", {{{{"foo", "baz"}}}}, Tracing::NullSpan::instance(),
+                   stream_info_);
+
+  envoy::service::ratelimit::v3::RateLimitRequest request;
+  GrpcClientImpl::createRequest(request, "foo", {{{{"foo", "bar"}}}, {{{"foo", "baz"}}}}, 0);
+  expectSend(request);
+  timer_->invokeCallback();
+  client_b_->cancel();
+
+  EXPECT_CALL(callbacks_a_, complete_(LimitStatus::Error, nullptr));
+  EXPECT_CALL(callbacks_b_, complete_(_, _)).Times(0);
+  batch_callbacks_->onFailure(Grpc::Status::Unavailable, "", Tracing::NullSpan::instance());
+}
+
+TEST_F(RateLimitBatcherTest, OkLeaseSkipsService) {
+  initialize(100, std::chrono::milliseconds(1000));
+
+  envoy::service::ratelimit::v3::RateLimitRequest request;
+  GrpcClientImpl::createRequest(request, "foo", {{{{"foo", "bar"}}}}, 0);
+
+  client_a_->limit(callbacks_a_, "foo", {{{{"foo", "bar"}}}}, Tracing::NullSpan::instance(),
+                   stream_info_);
+  expectSend(request);
+  timer_->invokeCallback();
+  EXPECT_CALL(callbacks_a_, complete_(LimitStatus::OK, _));
+  batch_callbacks_->onSuccess(response({envoy::service::ratelimit::v3::RateLimitResponse::OK}),
+                              Tracing::NullSpan::instance());
+
+  // The lease allows the same descriptors without asking the service.
+  EXPECT_CALL(callbacks_b_, complete_(LimitStatus::OK, nullptr));
+  client_b_->limit(callbacks_b_, "foo", {{{{"foo", "bar"}}}}, Tracing::NullSpan::instance(),
+                   stream_info_);
+  EXPECT_FALSE(timer_->enabled_);
+
+  // Other descriptors are still checked.
+  client_b_->limit(callbacks_b_, "foo", {{{{"foo", "baz"}}}}, Tracing::NullSpan::instance(),
+                   stream_info_);
+  EXPECT_TRUE(timer_->enabled_);
+  client_b_->cancel();
+
+  // Once the lease has expired, the service is asked again. The cancelled check is still sent.
+  simTime().advanceTimeWait(std::chrono::seconds(2));
+  client_a_->limit(callbacks_a_, "foo", {{{{"foo", "bar"}}}}, Tracing::NullSpan::instance(),
+                   stream_info_);
+  request.Clear();
+  GrpcClientImpl::createRequest(request, "foo", {{{{"foo", "baz"}}}, {{{"foo", "bar"}}}}, 0);
+  expectSend(request);
+  timer_->invokeCallback();
+  client_a_->cancel();
+
+  // Requests still in flight are cancelled with the batcher.
+  EXPECT_CALL(async_request_, cancel());
+}
+
+} // namespace
+} // namespace RateLimit
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -246,6 +246,81 @@ TEST(RoleBasedAccessControlEngineImpl, DeniedDenylist) {
   checkEngine(engine, true, LogResult::Undecided, info, conn, headers);
 }
 
+// Indexed policies are only evaluated for the requests that they may match, and still in order.
+TEST(RoleBasedAccessControlEngineImpl, IndexedPolicies) {
+  envoy::config::rbac::v3::RBAC rbac;
+  TestUtility::loadFromYaml(R"EOF(
+action: ALLOW
+policies:
+  a-path:
+    permissions:
+    - url_path:
+        path:
+          exact: /admin
+    principals:
+    - any: true
+  b-remote-address:
+    permissions:
+    - any: true
+    principals:
+    - direct_remote_ip:
+        address_prefix: 10.0.0.0
+        prefix_len: 8
+    - direct_remote_ip:
+        address_prefix: 10.1.0.0
+        prefix_len: 16
+  c-port:
+    permissions:
+    - destination_port: 8080
+    principals:
+    - any: true
+  d-header:
+    permissions:
+    - header:
+        name: x-debug
+        present_match: true
+    principals:
+    - any: true
+)EOF",
+                            rbac);
+  RBAC::RoleBasedAccessControlEngineImpl engine(rbac,
+                                                ProtobufMessage::getStrictValidationVisitor());
+
+  Envoy::Network::MockConnection conn;
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  info.downstream_connection_info_provider_->setLocalAddress(
+      Envoy::Network::Utility::parseInternetAddress("1.2.3.4", 443, false));
+  info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(
+      Envoy::Network::Utility::parseInternetAddress("192.168.0.1", 1234, false));
+
+  const auto effective_policy = [&](const Envoy::Http::RequestHeaderMap& headers) {
+    std::string policy_id;
+    return engine.handleAction(conn, headers, info, &policy_id) ? policy_id : "";
+  };
+
+  EXPECT_EQ("", effective_policy(Envoy::Http::TestRequestHeaderMapImpl{{":path", "/"}}));
+  EXPECT_EQ("a-path",
+            effective_policy(Envoy::Http::TestRequestHeaderMapImpl{{":path", "/admin?x=1"}}));
+  EXPECT_EQ("", effective_policy(Envoy::Http::TestRequestHeaderMapImpl{{":path", "/admin/x"}}));
+  EXPECT_EQ("d-header", effective_policy(Envoy::Http::TestRequestHeaderMapImpl{
+                            {":path", "/"}, {"x-debug", "1"}}));
+
+  info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(
+      Envoy::Network::Utility::parseInternetAddress("10.1.2.3", 1234, false));
+  EXPECT_EQ("b-remote-address",
+            effective_policy(Envoy::Http::TestRequestHeaderMapImpl{{":path", "/"}}));
+  // The first matching policy is still the effective one.
+  EXPECT_EQ("a-path",
+            effective_policy(Envoy::Http::TestRequestHeaderMapImpl{{":path", "/admin"}}));
+
+  info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(
+      Envoy::Network::Utility::parseInternetAddress("192.168.0.1", 1234, false));
+  info.downstream_connection_info_provider_->setLocalAddress(
+      Envoy::Network::Utility::parseInternetAddress("1.2.3.4", 8080, false));
+  EXPECT_EQ("c-port", effective_policy(Envoy::Http::TestRequestHeaderMapImpl{
+                          {":path", "/"}, {"x-debug", "1"}}));
+}
+
 TEST(RoleBasedAccessControlEngineImpl, BasicCondition) {
   envoy::config::rbac::v3::Policy policy;
   policy.add_permissions()->set_any(true);
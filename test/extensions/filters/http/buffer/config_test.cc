@@ -12,6 +12,7 @@
 
 using testing::_;
 using testing::NiceMock;
+using testing::SaveArg;
 
 namespace Envoy {
 namespace Extensions {
@@ -59,6 +60,24 @@ TEST(BufferFilterFactoryTest, BufferFilterCorrectProtoUpstreamFactory) {
   cb(filter_callback);
 }
 
+TEST(BufferFilterFactoryTest, BufferFilterReusedForLaterStreams) {
+  envoy::extensions::filters::http::buffer::v3::Buffer config;
+  config.mutable_max_request_bytes()->set_value(1028);
+
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  BufferFilterFactory factory;
+  Http::FilterFactoryCb cb = factory.createFilterFactoryFromProto(config, "stats", context).value();
+  Http::MockFilterChainFactoryCallbacks filter_callback;
+  Http::StreamDecoderFilterSharedPtr filter;
+  EXPECT_CALL(filter_callback, addStreamDecoderFilter(_)).WillRepeatedly(SaveArg<0>(&filter));
+
+  cb(filter_callback);
+  const Http::StreamDecoderFilter* first_filter = filter.get();
+  filter.reset();
+  cb(filter_callback);
+  EXPECT_EQ(first_filter, filter.get());
+}
+
 TEST(BufferFilterFactoryTest, BufferFilterEmptyProto) {
   BufferFilterFactory factory;
   auto empty_proto = factory.createEmptyConfigProto();
@@ -553,6 +553,39 @@ TEST_F(CacheFilterTest, BodyReadFromCacheLimitedToBufferSizeChunks) {
   filter.reset();
 }
 
+TEST_F(CacheFilterTest, BodyReadFailureResetsStream) {
+  request_headers_.setHost("BodyReadFailureResetsStream");
+  auto mock_http_cache = std::make_shared<MockHttpCache>();
+  auto mock_lookup_context = std::make_unique<MockLookupContext>();
+  EXPECT_CALL(*mock_http_cache, makeLookupContext(_, _))
+      .WillOnce([&](LookupRequest&&,
+                    Http::StreamDecoderFilterCallbacks&) -> std::unique_ptr<LookupContext> {
+        return std::move(mock_lookup_context);
+      });
+  EXPECT_CALL(*mock_lookup_context, getHeaders(_)).WillOnce([&](LookupHeadersCallback&& cb) {
+    std::unique_ptr<Http::ResponseHeaderMap> response_headers =
+        std::make_unique<Http::TestResponseHeaderMapImpl>(response_headers_);
+    cb(LookupResult{CacheEntryStatus::Ok, std::move(response_headers), 8, absl::nullopt});
+  });
+  EXPECT_CALL(*mock_lookup_context, getBody(RangeMatcher(0, 8), _))
+      .WillOnce([&](const AdjustedByteRange&, LookupBodyCallback&& cb) { cb(nullptr); });
+  EXPECT_CALL(*mock_lookup_context, onDestroy());
+
+  CacheFilterSharedPtr filter = makeFilter(mock_http_cache, false);
+
+  // The cached headers have been sent, so a failed body read aborts the response.
+  EXPECT_CALL(decoder_callbacks_, encodeHeaders_(IsSupersetOfHeaders(response_headers_), false));
+  EXPECT_CALL(decoder_callbacks_, encodeData(_, _)).Times(0);
+  EXPECT_CALL(decoder_callbacks_, resetStream(_, _));
+
+  EXPECT_EQ(filter->decodeHeaders(request_headers_, true),
+            Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  filter->onDestroy();
+  filter.reset();
+}
+
 TEST_F(CacheFilterTest, CacheInsertAbortedByCache) {
   request_headers_.setHost("CacheHitWithBody");
   const std::string body = "abc";
@@ -1,6 +1,7 @@
 #include "envoy/compression/compressor/factory.h"
 #include "envoy/extensions/filters/http/compressor/v3/compressor.pb.h"
 
+#include "source/common/singleton/manager_impl.h"
 #include "source/extensions/compression/brotli/compressor/brotli_compressor_impl.h"
 #include "source/extensions/compression/brotli/compressor/config.h"
 #include "source/extensions/compression/gzip/compressor/config.h"
@@ -11,6 +12,7 @@
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/test_common/thread_factory_for_test.h"
 
 #include "benchmark/benchmark.h"
 #include "gmock/gmock.h"
@@ -106,6 +108,7 @@ struct CompressionParams {
 
 CompressorFilterConfigSharedPtr makeGzipConfig(Stats::IsolatedStoreImpl& stats,
                                                testing::NiceMock<Runtime::MockLoader>& runtime,
+                                               Singleton::Manager& singleton_manager,
                                                const CompressionParams& params) {
 
   envoy::extensions::filters::http::compressor::v3::Compressor compressor;
@@ -121,13 +124,15 @@ CompressorFilterConfigSharedPtr makeGzipConfig(Stats::IsolatedStoreImpl& stats,
   Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory =
       std::make_unique<MockGzipCompressorFactory>(level, strategy, window_bits, memory_level);
   CompressorFilterConfigSharedPtr config = std::make_shared<CompressorFilterConfig>(
-      compressor, "test.", *stats.rootScope(), runtime, std::move(compressor_factory));
+      compressor, "test.", *stats.rootScope(), runtime, singleton_manager,
+      std::move(compressor_factory));
 
   return config;
 }
 
 CompressorFilterConfigSharedPtr makeZstdConfig(Stats::IsolatedStoreImpl& stats,
                                                testing::NiceMock<Runtime::MockLoader>& runtime,
+                                               Singleton::Manager& singleton_manager,
                                                const CompressionParams& params) {
 
   envoy::extensions::filters::http::compressor::v3::Compressor compressor;
@@ -137,13 +142,15 @@ CompressorFilterConfigSharedPtr makeZstdConfig(Stats::IsolatedStoreImpl& stats,
   Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory =
       std::make_unique<MockZstdCompressorFactory>(level, strategy);
   CompressorFilterConfigSharedPtr config = std::make_shared<CompressorFilterConfig>(
-      compressor, "test.", *stats.rootScope(), runtime, std::move(compressor_factory));
+      compressor, "test.", *stats.rootScope(), runtime, singleton_manager,
+      std::move(compressor_factory));
 
   return config;
 }
 
 CompressorFilterConfigSharedPtr makeBrotliConfig(Stats::IsolatedStoreImpl& stats,
                                                  testing::NiceMock<Runtime::MockLoader>& runtime,
+                                                 Singleton::Manager& singleton_manager,
                                                  const CompressionParams& params) {
 
   envoy::extensions::filters::http::compressor::v3::Compressor compressor;
@@ -152,7 +159,8 @@ CompressorFilterConfigSharedPtr makeBrotliConfig(Stats::IsolatedStoreImpl& stats
   Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory =
       std::make_unique<MockBrotliCompressorFactory>(quality);
   CompressorFilterConfigSharedPtr config = std::make_shared<CompressorFilterConfig>(
-      compressor, "test.", *stats.rootScope(), runtime, std::move(compressor_factory));
+      compressor, "test.", *stats.rootScope(), runtime, singleton_manager,
+      std::move(compressor_factory));
 
   return config;
 }
@@ -208,18 +216,19 @@ static Result compressWith(enum CompressorLibs lib, std::vector<Buffer::OwnedImp
   auto start = std::chrono::high_resolution_clock::now();
   Stats::IsolatedStoreImpl stats;
   testing::NiceMock<Runtime::MockLoader> runtime;
+  Singleton::ManagerImpl singleton_manager(Thread::threadFactoryForTest());
   CompressorFilterConfigSharedPtr config;
   std::string compressor = "";
   std::string encoding = "";
   if (lib == CompressorLibs::Brotli) {
-    config = makeBrotliConfig(stats, runtime, params);
+    config = makeBrotliConfig(stats, runtime, singleton_manager, params);
     encoding = "br";
     compressor = "brotli";
   } else if (lib == CompressorLibs::Gzip) {
-    config = makeGzipConfig(stats, runtime, params);
+    config = makeGzipConfig(stats, runtime, singleton_manager, params);
     encoding = compressor = "gzip";
   } else if (lib == CompressorLibs::Zstd) {
-    config = makeZstdConfig(stats, runtime, params);
+    config = makeZstdConfig(stats, runtime, singleton_manager, params);
     encoding = compressor = "zstd";
   }
 
@@ -1,9 +1,11 @@
+#include "source/common/singleton/manager_impl.h"
 #include "source/extensions/filters/http/compressor/compressor_filter.h"
 
 #include "test/mocks/compression/compressor/mocks.h"
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -30,12 +32,15 @@ public:
   }
   const std::string& statsPrefix() const override { CONSTRUCT_ON_FIRST_USE(std::string, "test."); }
   const std::string& contentEncoding() const override { return content_encoding_; }
+  std::string availableDictionary() const override { return available_dictionary_; }
 
   void setExpectedCompressCalls(uint32_t calls) { expected_compress_calls_ = calls; }
+  void setAvailableDictionary(const std::string& hash) { available_dictionary_ = hash; }
 
 private:
   uint32_t expected_compress_calls_{1};
   const std::string content_encoding_;
+  std::string available_dictionary_;
 };
 
 class CompressorFilterTest : public testing::Test {
@@ -64,8 +69,9 @@ public:
     TestUtility::loadFromJson(json, compressor);
     auto compressor_factory = std::make_unique<TestCompressorFactory>("test");
     compressor_factory_ = compressor_factory.get();
-    config_ = std::make_shared<CompressorFilterConfig>(compressor, "test.", *stats_.rootScope(),
-                                                       runtime_, std::move(compressor_factory));
+    config_ =
+        std::make_shared<CompressorFilterConfig>(compressor, "test.", *stats_.rootScope(), runtime_,
+                                                 singleton_manager_, std::move(compressor_factory));
     filter_ = std::make_unique<CompressorFilter>(config_);
     filter_->setDecoderFilterCallbacks(decoder_callbacks_);
     filter_->setEncoderFilterCallbacks(encoder_callbacks_);
@@ -179,6 +185,7 @@ public:
   std::string response_stats_prefix_{};
   Stats::TestUtil::TestStore stats_;
   NiceMock<Runtime::MockLoader> runtime_;
+  Singleton::ManagerImpl singleton_manager_{Thread::threadFactoryForTest()};
   NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
   NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks_;
 };
@@ -629,6 +636,197 @@ TEST_F(CompressorFilterTest, RemoveAcceptEncodingHeader) {
   }
 }
 
+class CompressorFilterOffloadTest : public CompressorFilterTest {
+protected:
+  void SetUp() override {
+    setUpFilter(R"EOF(
+{
+  "offload": {
+    "thread_count": 1,
+    "min_body_bytes": 100
+  },
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF");
+    // Callbacks posted by the compression thread are run by the test thread.
+    ON_CALL(encoder_callbacks_.dispatcher_, post(_))
+        .WillByDefault(Invoke([this](Event::PostCb cb) {
+          absl::MutexLock lock(&mutex_);
+          posted_.push_back(std::move(cb));
+        }));
+  }
+
+  // Waits for a chunk to be compressed, and hands it back to the filter.
+  void runNextPosted() {
+    Event::PostCb cb;
+    {
+      const auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+        return !posted_.empty();
+      };
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(&condition));
+      cb = std::move(posted_.front());
+      posted_.erase(posted_.begin());
+    }
+    cb();
+  }
+
+  void startResponse() {
+    doRequestNoCompression({{":method", "get"}, {"accept-encoding", "test"}});
+    Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "1000"}};
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+    EXPECT_EQ("test", headers.get_("content-encoding"));
+  }
+
+  absl::Mutex mutex_;
+  std::vector<Event::PostCb> posted_ ABSL_GUARDED_BY(mutex_);
+};
+
+TEST_F(CompressorFilterOffloadTest, SmallBodyIsCompressedInline) {
+  doRequestNoCompression({{":method", "get"}, {"accept-encoding", "test"}});
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "50"}};
+  doResponseCompression(headers, false);
+}
+
+TEST_F(CompressorFilterOffloadTest, LargeBodyIsCompressedOnThreadPool) {
+  compressor_factory_->setExpectedCompressCalls(2);
+  startResponse();
+  populateBuffer(1000);
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data_, false));
+
+  EXPECT_CALL(encoder_callbacks_, injectEncodedDataToFilterChain(_, false))
+      .WillOnce(Invoke([&](Buffer::Instance& data, bool) { data_.move(data); }));
+  runNextPosted();
+  verifyCompressedData();
+
+  // The trailers wait for the compressor to finish the body.
+  Http::TestResponseTrailerMapImpl trailers;
+  EXPECT_EQ(Http::FilterTrailersStatus::StopIteration, filter_->encodeTrailers(trailers));
+  EXPECT_CALL(encoder_callbacks_, continueEncoding());
+  runNextPosted();
+  filter_->onDestroy();
+}
+
+TEST_F(CompressorFilterOffloadTest, BufferedBodyAboveLimitPausesUpstream) {
+  EXPECT_CALL(encoder_callbacks_, encoderBufferLimit()).WillRepeatedly(Return(500));
+  startResponse();
+  populateBuffer(1000);
+  EXPECT_CALL(encoder_callbacks_, onEncoderFilterAboveWriteBufferHighWatermark());
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data_, true));
+
+  EXPECT_CALL(encoder_callbacks_, injectEncodedDataToFilterChain(_, true));
+  EXPECT_CALL(encoder_callbacks_, onEncoderFilterBelowWriteBufferLowWatermark());
+  runNextPosted();
+  filter_->onDestroy();
+}
+
+TEST_F(CompressorFilterOffloadTest, ConfigsShareThreadPool) {
+  envoy::extensions::filters::http::compressor::v3::Compressor compressor;
+  TestUtility::loadFromJson(R"EOF(
+{
+  "offload": {
+    "thread_count": 1
+  },
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF",
+                            compressor);
+  // A config replacing the one of the filter, e.g. by an LDS update, keeps its threads.
+  auto same_config = std::make_shared<CompressorFilterConfig>(
+      compressor, "test.", *stats_.rootScope(), runtime_, singleton_manager_,
+      std::make_unique<TestCompressorFactory>("test"));
+  EXPECT_EQ(config_->offloadThreadPool(), same_config->offloadThreadPool());
+
+  compressor.mutable_offload()->set_thread_count(2);
+  auto other_config = std::make_shared<CompressorFilterConfig>(
+      compressor, "test.", *stats_.rootScope(), runtime_, singleton_manager_,
+      std::make_unique<TestCompressorFactory>("test"));
+  EXPECT_NE(config_->offloadThreadPool(), other_config->offloadThreadPool());
+}
+
+TEST_F(CompressorFilterTest, SharedDictionaryRequiresMatchingAvailableDictionary) {
+  compressor_factory_->setAvailableDictionary(":aGFzaA==:");
+  Http::TestRequestHeaderMapImpl request_headers{{":method", "get"}, {"accept-encoding", "test"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  doResponseNoCompression(headers);
+  // Clients which announce the dictionary later may get a compressed response.
+  EXPECT_EQ("accept-encoding, available-dictionary", headers.get_("vary"));
+}
+
+TEST_F(CompressorFilterTest, SharedDictionaryCompressesWithMatchingAvailableDictionary) {
+  compressor_factory_->setAvailableDictionary(":aGFzaA==:");
+  Http::TestRequestHeaderMapImpl request_headers{
+      {":method", "get"}, {"accept-encoding", "test"}, {"available-dictionary", " :aGFzaA==: "}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  doResponseCompression(headers, false);
+  EXPECT_EQ("accept-encoding, available-dictionary", headers.get_("vary"));
+}
+
+TEST_F(CompressorFilterTest, CompressedBodyCacheReusesCompressedBody) {
+  setUpFilter(R"EOF(
+{
+  "compressed_body_cache": {
+    "max_body_bytes": 1000,
+    "max_size_bytes": 4096
+  },
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF");
+  const std::string body(500, 'a');
+  auto send_response = [&]() {
+    Http::TestRequestHeaderMapImpl request_headers{{":method", "get"}, {"accept-encoding", "test"}};
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+    Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "500"}};
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+    Buffer::OwnedImpl data(body);
+    EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(data, true));
+  };
+  send_response();
+  EXPECT_EQ(0, stats_.counter("test.compressor.test.test.compressed_body_cache_hit").value());
+  EXPECT_EQ(2 * body.size(), config_->compressedBodyCache()->sizeBytes());
+
+  // The same body sent again is not compressed a second time.
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+  filter_ = std::make_unique<CompressorFilter>(config_);
+  filter_->setDecoderFilterCallbacks(decoder_callbacks);
+  filter_->setEncoderFilterCallbacks(encoder_callbacks_);
+  compressor_factory_->setExpectedCompressCalls(0);
+  send_response();
+  EXPECT_EQ(1, stats_.counter("test.compressor.test.test.compressed_body_cache_hit").value());
+  EXPECT_EQ(2 * body.size(),
+            stats_.counter("test.compressor.test.test.total_uncompressed_bytes").value());
+}
+
+TEST(CompressedBodyCacheTest, EvictsLeastRecentlyUsedBodies) {
+  CompressedBodyCache cache(100, 300);
+  cache.insert(std::string(50, 'a'), std::string(50, '1'));
+  cache.insert(std::string(50, 'b'), std::string(50, '2'));
+  ASSERT_NE(cache.lookup(std::string(50, 'a')), nullptr);
+  // Makes room by evicting 'b', which was used longer ago than 'a'.
+  cache.insert(std::string(50, 'c'), std::string(50, '3'));
+  EXPECT_EQ(cache.sizeBytes(), 200);
+  EXPECT_EQ(cache.lookup(std::string(50, 'b')), nullptr);
+  EXPECT_EQ(*cache.lookup(std::string(50, 'a')), std::string(50, '1'));
+  EXPECT_EQ(*cache.lookup(std::string(50, 'c')), std::string(50, '3'));
+}
+
 class IsAcceptEncodingAllowedTest
     : public CompressorFilterTest,
       public testing::WithParamInterface<std::tuple<std::string, bool, int, int, int, int>> {};
@@ -930,7 +1128,8 @@ protected:
     auto compressor_factory1 = std::make_unique<TestCompressorFactory>("test1");
     compressor_factory1->setExpectedCompressCalls(0);
     auto config1 = std::make_shared<CompressorFilterConfig>(
-        compressor, "test1.", *stats1_.rootScope(), runtime_, std::move(compressor_factory1));
+        compressor, "test1.", *stats1_.rootScope(), runtime_, singleton_manager_,
+        std::move(compressor_factory1));
     filter1_ = std::make_unique<CompressorFilter>(config1);
 
     TestUtility::loadFromJson(R"EOF(
@@ -947,11 +1146,13 @@ protected:
     auto compressor_factory2 = std::make_unique<TestCompressorFactory>("test2");
     compressor_factory2->setExpectedCompressCalls(0);
     auto config2 = std::make_shared<CompressorFilterConfig>(
-        compressor, "test2.", *stats2_.rootScope(), runtime_, std::move(compressor_factory2));
+        compressor, "test2.", *stats2_.rootScope(), runtime_, singleton_manager_,
+        std::move(compressor_factory2));
     filter2_ = std::make_unique<CompressorFilter>(config2);
   }
 
   NiceMock<Runtime::MockLoader> runtime_;
+  Singleton::ManagerImpl singleton_manager_{Thread::threadFactoryForTest()};
   Stats::TestUtil::TestStore stats1_;
   Stats::TestUtil::TestStore stats2_;
   std::unique_ptr<CompressorFilter> filter1_;
@@ -1053,7 +1254,8 @@ protected:
                               compressor);
     auto compressor_factory1 = std::make_unique<TestCompressorFactory>("test1");
     auto config1 = std::make_shared<CompressorFilterConfig>(
-        compressor, "test1.", *stats1_.rootScope(), runtime_, std::move(compressor_factory1));
+        compressor, "test1.", *stats1_.rootScope(), runtime_, singleton_manager_,
+        std::move(compressor_factory1));
     filter1_ = std::make_unique<CompressorFilter>(config1);
 
     TestUtility::loadFromJson(fmt::format(R"EOF(
@@ -1071,7 +1273,8 @@ protected:
                               compressor);
     auto compressor_factory2 = std::make_unique<TestCompressorFactory>("test2");
     auto config2 = std::make_shared<CompressorFilterConfig>(
-        compressor, "test2.", *stats2_.rootScope(), runtime_, std::move(compressor_factory2));
+        compressor, "test2.", *stats2_.rootScope(), runtime_, singleton_manager_,
+        std::move(compressor_factory2));
     filter2_ = std::make_unique<CompressorFilter>(config2);
   }
 
@@ -0,0 +1,161 @@
+#include <chrono>
+#include <string>
+
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include "test/mocks/router/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+namespace {
+
+using Filters::Common::ExtAuthz::CheckStatus;
+using Filters::Common::ExtAuthz::Response;
+
+class DecisionCacheTest : public testing::Test {
+public:
+  void initialize(const std::string& yaml) {
+    envoy::extensions::filters::http::ext_authz::v3::DecisionCache proto_config;
+    TestUtility::loadFromYamlAndValidate(yaml, proto_config);
+    config_ = std::make_unique<DecisionCacheConfig>(proto_config, tls_, time_system_);
+  }
+
+  static Response response(CheckStatus status) {
+    Response response{};
+    response.status = status;
+    return response;
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+  DecisionCacheConfigPtr config_;
+};
+
+TEST_F(DecisionCacheTest, KeyFromRequestAttributes) {
+  initialize(R"EOF(
+  key_parts:
+  - header: x-tenant
+  - dynamic_metadata:
+      key: envoy.filters.http.jwt_authn
+      path:
+      - key: payload
+      - key: sub
+  - method: true
+  - path: true
+  default_ttl: 1s
+  )EOF");
+
+  ProtobufWkt::Struct payload;
+  (*payload.mutable_fields())["sub"] = ValueUtil::stringValue("alice");
+  ProtobufWkt::Struct jwt_metadata;
+  (*jwt_metadata.mutable_fields())["payload"] = ValueUtil::structValue(payload);
+  (*stream_info_.metadata_.mutable_filter_metadata())["envoy.filters.http.jwt_authn"] =
+      jwt_metadata;
+
+  Http::TestRequestHeaderMapImpl headers{
+      {":method", "GET"}, {":path", "/orders?page=1"}, {"x-tenant", "a"}};
+  const std::string key = config_->key(headers, stream_info_, nullptr);
+
+  // The query string is not part of the key.
+  Http::TestRequestHeaderMapImpl other_query{
+      {":method", "GET"}, {":path", "/orders?page=2"}, {"x-tenant", "a"}};
+  EXPECT_EQ(key, config_->key(other_query, stream_info_, nullptr));
+
+  Http::TestRequestHeaderMapImpl other_method{
+      {":method", "POST"}, {":path", "/orders"}, {"x-tenant", "a"}};
+  EXPECT_NE(key, config_->key(other_method, stream_info_, nullptr));
+
+  // A missing header differs from an empty one.
+  Http::TestRequestHeaderMapImpl no_tenant{{":method", "GET"}, {":path", "/orders"}};
+  Http::TestRequestHeaderMapImpl empty_tenant{
+      {":method", "GET"}, {":path", "/orders"}, {"x-tenant", ""}};
+  EXPECT_NE(config_->key(no_tenant, stream_info_, nullptr),
+            config_->key(empty_tenant, stream_info_, nullptr));
+
+  (*payload.mutable_fields())["sub"] = ValueUtil::stringValue("bob");
+  (*jwt_metadata.mutable_fields())["payload"] = ValueUtil::structValue(payload);
+  (*stream_info_.metadata_.mutable_filter_metadata())["envoy.filters.http.jwt_authn"] =
+      jwt_metadata;
+  EXPECT_NE(key, config_->key(headers, stream_info_, nullptr));
+}
+
+TEST_F(DecisionCacheTest, KeyFromRouteName) {
+  initialize(R"EOF(
+  key_parts:
+  - route_name: true
+  default_ttl: 1s
+  )EOF");
+
+  NiceMock<Router::MockRoute> route;
+  Http::TestRequestHeaderMapImpl headers{{":method", "GET"}, {":path", "/orders/1"}};
+  EXPECT_NE(config_->key(headers, stream_info_, nullptr),
+            config_->key(headers, stream_info_, &route));
+}
+
+TEST_F(DecisionCacheTest, DecisionsExpire) {
+  initialize(R"EOF(
+  key_parts:
+  - method: true
+  default_ttl: 1s
+  ttl_metadata_field: ttl
+  )EOF");
+
+  config_->insert("allowed", response(CheckStatus::OK));
+  config_->insert("denied", response(CheckStatus::Denied));
+  config_->insert("error", response(CheckStatus::Error));
+  Response uncacheable = response(CheckStatus::OK);
+  (*uncacheable.dynamic_metadata.mutable_fields())["ttl"] = ValueUtil::numberValue(0);
+  config_->insert("uncacheable", uncacheable);
+  Response long_lived = response(CheckStatus::OK);
+  (*long_lived.dynamic_metadata.mutable_fields())["ttl"] = ValueUtil::numberValue(10);
+  config_->insert("long_lived", long_lived);
+
+  ASSERT_NE(nullptr, config_->cache().lookup("allowed"));
+  EXPECT_EQ(CheckStatus::Denied, config_->cache().lookup("denied")->status);
+  EXPECT_EQ(nullptr, config_->cache().lookup("error"));
+  EXPECT_EQ(nullptr, config_->cache().lookup("uncacheable"));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(2));
+  EXPECT_EQ(nullptr, config_->cache().lookup("allowed"));
+  EXPECT_NE(nullptr, config_->cache().lookup("long_lived"));
+}
+
+TEST_F(DecisionCacheTest, EvictsLeastRecentlyUsed) {
+  initialize(R"EOF(
+  key_parts:
+  - method: true
+  default_ttl: 10s
+  max_entries: 2
+  )EOF");
+
+  config_->insert("a", response(CheckStatus::OK));
+  config_->insert("b", response(CheckStatus::OK));
+  EXPECT_NE(nullptr, config_->cache().lookup("a"));
+  config_->insert("c", response(CheckStatus::OK));
+
+  EXPECT_EQ(2U, config_->cache().size());
+  EXPECT_NE(nullptr, config_->cache().lookup("a"));
+  EXPECT_EQ(nullptr, config_->cache().lookup("b"));
+  EXPECT_NE(nullptr, config_->cache().lookup("c"));
+}
+
+} // namespace
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -24,10 +24,12 @@
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/router/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/mocks/tracing/mocks.h"
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/proto/helloworld.pb.h"
 #include "test/test_common/printers.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
@@ -2973,6 +2975,66 @@ TEST_P(HttpFilterTestParam, NoCluster) {
 }
 
 // Check that config validation for per-route filter works as expected.
+// Verifies that a cached decision is applied without calling the authorization server, and that
+// requests with another key still call it.
+TEST_F(HttpFilterTest, DecisionCacheSkipsRepeatedChecks) {
+  const std::string yaml = R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  decision_cache:
+    key_parts:
+    - header: x-user
+    default_ttl: 10s
+  )EOF";
+  envoy::extensions::filters::http::ext_authz::v3::ExtAuthz proto_config;
+  TestUtility::loadFromYaml(yaml, proto_config);
+  Event::SimulatedTimeSystem time_system;
+  NiceMock<ThreadLocal::MockInstance> tls;
+  config_ = std::make_shared<FilterConfig>(
+      proto_config, *stats_store_.rootScope(), runtime_, http_context_, "ext_authz_prefix",
+      bootstrap_,
+      std::make_unique<DecisionCacheConfig>(proto_config.decision_cache(), tls, time_system));
+  prepareCheck();
+
+  const auto check = [this](const std::string& user, bool expect_call,
+                            Filters::Common::ExtAuthz::CheckStatus status) {
+    client_ = new Filters::Common::ExtAuthz::MockClient();
+    filter_ = std::make_unique<Filter>(config_, Filters::Common::ExtAuthz::ClientPtr{client_});
+    filter_->setDecoderFilterCallbacks(decoder_filter_callbacks_);
+    request_headers_ = Http::TestRequestHeaderMapImpl{
+        {":method", "GET"}, {":path", "/"}, {":authority", "host"}, {"x-user", user}};
+    EXPECT_CALL(*client_, check(_, _, _, _))
+        .Times(expect_call ? 1 : 0)
+        .WillRepeatedly(Invoke([status](Filters::Common::ExtAuthz::RequestCallbacks& callbacks,
+                                        const envoy::service::auth::v3::CheckRequest&,
+                                        Tracing::Span&, const StreamInfo::StreamInfo&) -> void {
+          auto response = std::make_unique<Filters::Common::ExtAuthz::Response>();
+          response->status = status;
+          response->status_code = Http::Code::Forbidden;
+          callbacks.onComplete(std::move(response));
+        }));
+    return filter_->decodeHeaders(request_headers_, false);
+  };
+
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            check("alice", true, Filters::Common::ExtAuthz::CheckStatus::OK));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            check("alice", false, Filters::Common::ExtAuthz::CheckStatus::OK));
+
+  EXPECT_CALL(decoder_filter_callbacks_, sendLocalReply(Http::Code::Forbidden, _, _, _, _))
+      .Times(2);
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            check("bob", true, Filters::Common::ExtAuthz::CheckStatus::Denied));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            check("bob", false, Filters::Common::ExtAuthz::CheckStatus::Denied));
+
+  EXPECT_EQ(2U, config_->stats().decision_cache_miss_.value());
+  EXPECT_EQ(2U, config_->stats().decision_cache_hit_.value());
+  EXPECT_EQ(2U, config_->stats().ok_.value());
+  EXPECT_EQ(2U, config_->stats().denied_.value());
+}
+
 TEST_F(HttpFilterTest, PerRouteCheckSettingsConfigCheck) {
   // Set allow_partial_message to true and max_request_bytes to 5 on the per-route filter.
   envoy::extensions::filters::http::ext_authz::v3::BufferSettings buffer_settings;
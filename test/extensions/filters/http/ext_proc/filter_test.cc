@@ -2108,6 +2108,92 @@ TEST_F(HttpFilterTest, GetStreamingBodyAndChangeModeDifferentOrder) {
   EXPECT_EQ(1, config_->stats().streams_closed_.value());
 }
 
+// Using async mode, test that the filter sends everything to the processor
+// without ever stopping the filter chain, and batches buffered bodies.
+TEST_F(HttpFilterTest, AsyncModeObservesWithoutWaiting) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_proc_server"
+  async_mode: true
+  processing_mode:
+    request_header_mode: "SEND"
+    response_header_mode: "SEND"
+    request_body_mode: "STREAMED"
+    response_body_mode: "BUFFERED"
+    request_trailer_mode: "SEND"
+    response_trailer_mode: "SKIP"
+  )EOF");
+
+  request_headers_.setContentLength(3);
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+  EXPECT_TRUE(last_request_.async_mode());
+  EXPECT_TRUE(last_request_.has_request_headers());
+  // The body is not changed, so the content-length is kept.
+  EXPECT_EQ("3", request_headers_.getContentLengthValue());
+
+  Buffer::OwnedImpl req_data("foo");
+  EXPECT_EQ(FilterDataStatus::Continue, filter_->decodeData(req_data, false));
+  EXPECT_EQ("foo", req_data.toString());
+  EXPECT_TRUE(last_request_.async_mode());
+  EXPECT_EQ("foo", last_request_.request_body().body());
+  EXPECT_EQ(FilterTrailersStatus::Continue, filter_->decodeTrailers(request_trailers_));
+  EXPECT_TRUE(last_request_.has_request_trailers());
+
+  // Responses are ignored.
+  auto response = std::make_unique<ProcessingResponse>();
+  response->mutable_immediate_response();
+  EXPECT_CALL(encoder_callbacks_, sendLocalReply(_, _, _, _, _)).Times(0);
+  stream_callbacks_->onReceiveMessage(std::move(response));
+
+  response_headers_.addCopy(LowerCaseString(":status"), "200");
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers_, false));
+  EXPECT_TRUE(last_request_.has_response_headers());
+
+  // Buffered chunks are sent in one message.
+  Buffer::OwnedImpl resp_data_1("hello");
+  EXPECT_EQ(FilterDataStatus::Continue, filter_->encodeData(resp_data_1, false));
+  EXPECT_EQ("hello", resp_data_1.toString());
+  EXPECT_TRUE(last_request_.has_response_headers());
+  Buffer::OwnedImpl resp_data_2(" world");
+  EXPECT_EQ(FilterDataStatus::Continue, filter_->encodeData(resp_data_2, true));
+  EXPECT_EQ("hello world", last_request_.response_body().body());
+  EXPECT_TRUE(last_request_.response_body().end_of_stream());
+  filter_->onDestroy();
+
+  EXPECT_EQ(1, config_->stats().streams_started_.value());
+  EXPECT_EQ(5, config_->stats().stream_msgs_sent_.value());
+  EXPECT_EQ(0, config_->stats().stream_msgs_received_.value());
+  EXPECT_EQ(1, config_->stats().spurious_msgs_received_.value());
+  EXPECT_EQ(1, config_->stats().streams_closed_.value());
+}
+
+// Using async mode, test that a failed gRPC stream does not fail the request.
+TEST_F(HttpFilterTest, AsyncModeIgnoresGrpcError) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_proc_server"
+  async_mode: true
+  processing_mode:
+    request_body_mode: "STREAMED"
+  )EOF");
+
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+  EXPECT_CALL(encoder_callbacks_, sendLocalReply(_, _, _, _, _)).Times(0);
+  server_closed_stream_ = true;
+  stream_callbacks_->onGrpcError(Grpc::Status::Internal);
+
+  Buffer::OwnedImpl req_data("foo");
+  EXPECT_EQ(FilterDataStatus::Continue, filter_->decodeData(req_data, true));
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers_, true));
+  filter_->onDestroy();
+
+  EXPECT_EQ(1, config_->stats().stream_msgs_sent_.value());
+  EXPECT_EQ(1, config_->stats().streams_failed_.value());
+  EXPECT_EQ(1, config_->stats().failure_mode_allowed_.value());
+}
+
 // Using the default configuration, test the filter with a processor that
 // replies to the request_headers message with an empty immediate_response message
 TEST_F(HttpFilterTest, RespondImmediatelyDefault) {
@@ -120,6 +120,22 @@ TEST_F(JwksCacheTest, TestSetRemoteJwksWithDefaultCacheDuration) {
   EXPECT_FALSE(jwks->isExpired());
 }
 
+// Test setRemoteJwks drops the JWTs verified with the previous keys.
+TEST_F(JwksCacheTest, TestSetRemoteJwksClearsJwtCache) {
+  auto& provider0 = (*config_.mutable_providers())[std::string(ProviderName)];
+  provider0.mutable_jwt_cache_config()->set_jwt_cache_size(10);
+  cache_ = JwksCache::create(config_, context_, mock_fetcher_.AsStdFunction(), stats_);
+
+  auto jwks = cache_->findByProvider(ProviderName);
+  auto jwt = std::make_unique<::google::jwt_verify::Jwt>();
+  ASSERT_EQ(jwt->parseFromString(GoodToken), Status::Ok);
+  jwks->getJwtCache().insert(GoodToken, std::move(jwt));
+  EXPECT_TRUE(jwks->getJwtCache().lookup(GoodToken) != nullptr);
+
+  EXPECT_EQ(jwks->setRemoteJwks(std::move(jwks_))->getStatus(), Status::Ok);
+  EXPECT_TRUE(jwks->getJwtCache().lookup(GoodToken) == nullptr);
+}
+
 // Test a good local jwks
 TEST_F(JwksCacheTest, TestGoodInlineJwks) {
   auto& provider0 = (*config_.mutable_providers())[std::string(ProviderName)];
@@ -80,6 +80,27 @@ TEST_F(JwtCacheTest, TestExpiredToken) {
   EXPECT_TRUE(jwt == nullptr);
 }
 
+TEST_F(JwtCacheTest, TestNotYetValidToken) {
+  setupCache(true);
+  loadJwt(NotYetValidToken);
+
+  cache_->insert(NotYetValidToken, std::move(jwt_));
+
+  // not be found since it is not valid yet.
+  EXPECT_TRUE(cache_->lookup(NotYetValidToken) == nullptr);
+}
+
+TEST_F(JwtCacheTest, TestClear) {
+  setupCache(true);
+  loadJwt(GoodToken);
+
+  cache_->insert(GoodToken, std::move(jwt_));
+  EXPECT_TRUE(cache_->lookup(GoodToken) != nullptr);
+
+  cache_->clear();
+  EXPECT_TRUE(cache_->lookup(GoodToken) == nullptr);
+}
+
 } // namespace
 } // namespace JwtAuthn
 } // namespace HttpFilters
@@ -68,6 +68,7 @@ class MockJwtCache : public JwtCache {
 public:
   MOCK_METHOD(::google::jwt_verify::Jwt*, lookup, (const std::string&), ());
   MOCK_METHOD(void, insert, (const std::string&, std::unique_ptr<::google::jwt_verify::Jwt>&&), ());
+  MOCK_METHOD(void, clear, ());
 };
 
 class MockJwksData : public JwksCache::JwksData {
@@ -0,0 +1,44 @@
+#include "envoy/extensions/filters/http/loop_lag_shedding/v3/loop_lag_shedding.pb.h"
+#include "envoy/extensions/filters/http/loop_lag_shedding/v3/loop_lag_shedding.pb.validate.h"
+
+#include "source/extensions/filters/http/loop_lag_shedding/config.h"
+
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace LoopLagShedding {
+namespace {
+
+TEST(LoopLagSheddingFilterFactoryTest, CreateFilter) {
+  const std::string yaml = R"EOF(
+target: 0.005s
+interval: 0.1s
+)EOF";
+
+  LoopLagSheddingFilterFactory factory;
+  ProtobufTypes::MessagePtr proto_config = factory.createEmptyConfigProto();
+  TestUtility::loadFromYamlAndValidate(yaml, *proto_config);
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+
+  // Each worker arms its probe timer.
+  EXPECT_CALL(context.server_factory_context_.thread_local_.dispatcher_, createTimer_(_));
+  auto callback = factory.createFilterFactoryFromProto(*proto_config, "stats", context).value();
+  Http::MockFilterChainFactoryCallbacks filter_callback;
+  EXPECT_CALL(filter_callback, addStreamDecoderFilter(_));
+  callback(filter_callback);
+}
+
+} // namespace
+} // namespace LoopLagShedding
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,177 @@
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/filters/http/loop_lag_shedding/v3/loop_lag_shedding.pb.h"
+#include "envoy/extensions/filters/http/loop_lag_shedding/v3/loop_lag_shedding.pb.validate.h"
+
+#include "source/common/singleton/manager_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/http/loop_lag_shedding/loop_lag_shedding.h"
+
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/thread_factory_for_test.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace LoopLagShedding {
+namespace {
+
+class LoopLagSheddingTest : public testing::Test {
+public:
+  LoopLagSheddingTest()
+      : api_(Api::createApiForTest(time_system_)),
+        dispatcher_(api_->allocateDispatcher("test_thread")) {
+    tls_.setDispatcher(dispatcher_.get());
+  }
+
+  void initialize(const std::string& yaml) {
+    LoopLagSheddingProto proto_config;
+    TestUtility::loadFromYamlAndValidate(yaml, proto_config);
+    config_ = std::make_shared<FilterConfig>(proto_config, tls_, singleton_manager_,
+                                             *store_.rootScope(), "test.");
+    filter_ = std::make_unique<LoopLagSheddingFilter>(config_);
+    filter_->setDecoderFilterCallbacks(callbacks_);
+  }
+
+  // Runs the event loop for the duration, letting events wait for a step between each run. The
+  // probe timer fires late by the step less the probe interval.
+  void run(std::chrono::milliseconds duration, std::chrono::milliseconds step) {
+    for (std::chrono::milliseconds elapsed{0}; elapsed < duration; elapsed += step) {
+      time_system_.advanceTimeAndRun(step, *dispatcher_, Event::Dispatcher::RunType::NonBlock);
+    }
+  }
+
+  void setRoutePriority(uint32_t priority) {
+    ProtobufWkt::Struct metadata;
+    (*metadata.mutable_fields())["priority"] = ValueUtil::numberValue(priority);
+    auto& filter_metadata = *callbacks_.route_->metadata_.mutable_filter_metadata();
+    filter_metadata["envoy.filters.http.loop_lag_shedding"] = metadata;
+  }
+
+  uint64_t shedRequests() {
+    return TestUtility::findCounter(store_, "test.loop_lag_shedding.rq_shed")->value();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  Singleton::ManagerImpl singleton_manager_{Thread::threadFactoryForTest()};
+  Stats::IsolatedStoreImpl store_;
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> callbacks_;
+  Http::TestRequestHeaderMapImpl headers_{{":method", "GET"}, {":path", "/"}};
+  FilterConfigSharedPtr config_;
+  std::unique_ptr<LoopLagSheddingFilter> filter_;
+};
+
+const std::string Config = R"EOF(
+target: 0.005s
+interval: 0.1s
+probe_interval: 0.01s
+max_priority: 2
+)EOF";
+
+TEST_F(LoopLagSheddingTest, ShedsPriorityClassesWhileSaturated) {
+  initialize(Config);
+  EXPECT_EQ(3, config_->controller().shedFrom());
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(headers_, true));
+
+  // The probe timer fires 40ms late: one more class is shed every interval.
+  run(std::chrono::milliseconds(100), std::chrono::milliseconds(50));
+  EXPECT_EQ(2, config_->controller().shedFrom());
+  EXPECT_CALL(callbacks_, sendLocalReply(Http::Code::ServiceUnavailable, "", _, _,
+                                         "shed_by_loop_lag"));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration, filter_->decodeHeaders(headers_, true));
+  EXPECT_EQ(1, shedRequests());
+  setRoutePriority(1);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(headers_, true));
+
+  run(std::chrono::milliseconds(100), std::chrono::milliseconds(50));
+  EXPECT_EQ(1, config_->controller().shedFrom());
+  EXPECT_CALL(callbacks_, sendLocalReply(Http::Code::ServiceUnavailable, "", _, _,
+                                         "shed_by_loop_lag"));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration, filter_->decodeHeaders(headers_, true));
+  EXPECT_EQ(2, shedRequests());
+
+  // Priority 0 is never shed.
+  run(std::chrono::milliseconds(200), std::chrono::milliseconds(50));
+  EXPECT_EQ(1, config_->controller().shedFrom());
+  setRoutePriority(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(headers_, true));
+
+  // Once the worker keeps up again, one more class is admitted every interval.
+  run(std::chrono::milliseconds(100), std::chrono::milliseconds(10));
+  EXPECT_EQ(2, config_->controller().shedFrom());
+  run(std::chrono::milliseconds(200), std::chrono::milliseconds(10));
+  EXPECT_EQ(3, config_->controller().shedFrom());
+  EXPECT_EQ(2, shedRequests());
+}
+
+TEST_F(LoopLagSheddingTest, IgnoresShortLagBursts) {
+  initialize(Config);
+
+  // A single late probe does not make the lowest lag of the interval go above the target.
+  run(std::chrono::milliseconds(50), std::chrono::milliseconds(50));
+  run(std::chrono::milliseconds(50), std::chrono::milliseconds(10));
+  EXPECT_EQ(3, config_->controller().shedFrom());
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(headers_, true));
+}
+
+TEST_F(LoopLagSheddingTest, DefaultPriority) {
+  initialize(R"EOF(
+target: 0.005s
+interval: 0.1s
+max_priority: 2
+default_priority: 1
+)EOF");
+
+  run(std::chrono::milliseconds(100), std::chrono::milliseconds(50));
+  EXPECT_EQ(2, config_->controller().shedFrom());
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(headers_, true));
+
+  // Priorities above the least important class are clamped to it.
+  setRoutePriority(5);
+  EXPECT_CALL(callbacks_, sendLocalReply(Http::Code::ServiceUnavailable, "", _, _,
+                                         "shed_by_loop_lag"));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration, filter_->decodeHeaders(headers_, true));
+}
+
+TEST_F(LoopLagSheddingTest, ConfigsShareControllers) {
+  initialize(Config);
+  LoopLagSheddingProto proto_config;
+  TestUtility::loadFromYamlAndValidate(Config, proto_config);
+  // A config replacing the one of the filter, e.g. by an LDS update, keeps its controllers.
+  FilterConfig same_config(proto_config, tls_, singleton_manager_, *store_.rootScope(), "test.");
+  EXPECT_EQ(&config_->controller(), &same_config.controller());
+
+  proto_config.mutable_max_priority()->set_value(3);
+  FilterConfig other_config(proto_config, tls_, singleton_manager_, *store_.rootScope(), "test.");
+  EXPECT_NE(&config_->controller(), &other_config.controller());
+}
+
+TEST_F(LoopLagSheddingTest, DefaultPriorityAboveMaxPriority) {
+  EXPECT_THROW_WITH_MESSAGE(initialize(R"EOF(
+target: 0.005s
+interval: 0.1s
+default_priority: 2
+)EOF"),
+                            EnvoyException,
+                            "loop lag shedding: default_priority 2 is above max_priority 1");
+}
+
+} // namespace
+} // namespace LoopLagShedding
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
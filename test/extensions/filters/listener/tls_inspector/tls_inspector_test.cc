@@ -412,6 +412,25 @@ TEST_P(TlsInspectorTest, NotSsl) {
   const std::vector<uint64_t> bytes_processed =
       store_.histogramValues("tls_inspector.bytes_processed", false);
   ASSERT_EQ(1, bytes_processed.size());
+  EXPECT_EQ(1, bytes_processed[0]);
+}
+
+// Test that the filter fails on non-SSL data whose first byte is that of a handshake record.
+TEST_P(TlsInspectorTest, NotSslHandshakeRecordType) {
+  init();
+  std::vector<uint8_t> data;
+
+  // Use a handshake record type followed by zeroes. This is not valid as a ClientHello.
+  data.resize(100);
+  data[0] = SSL3_RT_HANDSHAKE;
+  mockSysCallForPeek(data);
+  file_event_callback_(Event::FileReadyType::Read);
+  auto state = filter_->onData(*buffer_);
+  EXPECT_EQ(Network::FilterStatus::Continue, state);
+  EXPECT_EQ(1, cfg_->stats().tls_not_found_.value());
+  const std::vector<uint64_t> bytes_processed =
+      store_.histogramValues("tls_inspector.bytes_processed", false);
+  ASSERT_EQ(1, bytes_processed.size());
   EXPECT_EQ(5, bytes_processed[0]);
 }
 
@@ -275,6 +275,21 @@ TEST_F(RedisEncoderDecoderImplTest, BulkString) {
   EXPECT_EQ(0UL, buffer_.length());
 }
 
+TEST_F(RedisEncoderDecoderImplTest, BulkStringAcrossSlices) {
+  RespValue value;
+  value.type(RespType::BulkString);
+  value.asString() = std::string(DecoderImpl::MaxBulkStringReserve + 1, 'v');
+  encoder_.encode(value, buffer_);
+  // Decode the value one slice at a time.
+  while (buffer_.length() > 0) {
+    Buffer::OwnedImpl slice;
+    slice.move(buffer_, std::min<uint64_t>(buffer_.length(), 16384));
+    decoder_.decode(slice);
+  }
+  ASSERT_EQ(1UL, decoded_values_.size());
+  EXPECT_EQ(value, *decoded_values_[0]);
+}
+
 TEST_F(RedisEncoderDecoderImplTest, Integer) {
   RespValue value;
   value.type(RespType::Integer);
@@ -2321,6 +2321,46 @@ payload_passthrough: true
       "name - passthrough_enabled=true framed binary call framed binary exception - 0 0 0 -\n");
 }
 
+// The response to each pipelined request is passed through according to the filter chain of that
+// request.
+TEST_F(ThriftConnectionManagerTest, PayloadPassthroughPipelinedResponse) {
+  const std::string yaml = R"EOF(
+transport: FRAMED
+protocol: BINARY
+stat_prefix: test
+payload_passthrough: true
+)EOF";
+
+  initializeFilter(yaml);
+  passthroughSupportedSetup();
+
+  ThriftFilters::DecoderFilterCallbacks* callbacks{};
+  EXPECT_CALL(*decoder_filter_, setDecoderFilterCallbacks(_))
+      .WillOnce(Invoke([&](ThriftFilters::DecoderFilterCallbacks& cb) -> void { callbacks = &cb; }))
+      .WillRepeatedly(Return());
+
+  writeFramedBinaryMessage(buffer_, MessageType::Call, 0x0F);
+  EXPECT_EQ(filter_->onData(buffer_, false), Network::FilterStatus::StopIteration);
+
+  // The next request goes through a filter which does not support passthrough.
+  auto non_passthrough_filter = std::make_shared<NiceMock<ThriftFilters::MockDecoderFilter>>();
+  EXPECT_CALL(*non_passthrough_filter, passthroughSupported()).WillRepeatedly(Return(false));
+  config_->custom_decoder_filter_ = non_passthrough_filter;
+  writeFramedBinaryMessage(buffer_, MessageType::Call, 0x10);
+  EXPECT_EQ(filter_->onData(buffer_, false), Network::FilterStatus::StopIteration);
+  EXPECT_EQ(2U, stats_.request_active_.value());
+
+  writeFramedBinaryTApplicationException(write_buffer_, 0x0F);
+
+  FramedTransportImpl transport;
+  BinaryProtocolImpl proto;
+  callbacks->startUpstreamResponse(transport, proto);
+
+  EXPECT_CALL(filter_callbacks_.connection_.dispatcher_, deferredDelete_(_));
+  EXPECT_EQ(ThriftFilters::ResponseStatus::Complete, callbacks->upstreamData(write_buffer_));
+  EXPECT_EQ(1U, store_.counter("test.response_passthrough").value());
+}
+
 TEST_F(ThriftConnectionManagerTest, PayloadPassthroughRequestAndErrorResponse) {
   const std::string yaml = fmt::format(R"EOF(
 stat_prefix: test
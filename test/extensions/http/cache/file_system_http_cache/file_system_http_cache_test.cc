@@ -10,6 +10,7 @@
 #include "source/extensions/http/cache/file_system_http_cache/cache_file_fixed_block.h"
 #include "source/extensions/http/cache/file_system_http_cache/cache_file_header_proto_util.h"
 #include "source/extensions/http/cache/file_system_http_cache/file_system_http_cache.h"
+#include "source/extensions/http/cache/file_system_http_cache/lookup_context.h"
 
 #include "test/extensions/common/async_files/mocks.h"
 #include "test/extensions/filters/http/cache/http_cache_implementation_test_common.h"
@@ -39,6 +40,9 @@ using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::StrictMock;
 
+// The length of the first read of a cache file by a lookup.
+constexpr size_t ReadAheadLength = CacheFileFixedBlock::size() + FileLookupContext::ReadAheadSize;
+
 absl::string_view yaml_config = R"(
   typed_config:
     "@type": type.googleapis.com/envoy.extensions.http.cache.file_system_http_cache.v3.FileSystemHttpCacheConfig
@@ -503,7 +507,7 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, FailedReadOfHeaderBlockInvalidatesT
   absl::Cleanup destroy_lookup([&lookup]() { lookup->onDestroy(); });
   LookupResult result;
   EXPECT_CALL(*mock_async_file_manager_, openExistingFile(_, _, _));
-  EXPECT_CALL(*mock_async_file_handle_, read(0, CacheFileFixedBlock::size(), _));
+  EXPECT_CALL(*mock_async_file_handle_, read(0, ReadAheadLength, _));
   lookup->getHeaders([&](LookupResult&& r) { result = std::move(r); });
   mock_async_file_manager_->nextActionCompletes(
       absl::StatusOr<AsyncFileHandle>(mock_async_file_handle_));
@@ -542,7 +546,7 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, ReadWithInvalidHeaderBlockInvalidat
   absl::Cleanup destroy_lookup([&lookup]() { lookup->onDestroy(); });
   LookupResult result;
   EXPECT_CALL(*mock_async_file_manager_, openExistingFile(_, _, _));
-  EXPECT_CALL(*mock_async_file_handle_, read(0, CacheFileFixedBlock::size(), _));
+  EXPECT_CALL(*mock_async_file_handle_, read(0, ReadAheadLength, _));
   lookup->getHeaders([&](LookupResult&& r) { result = std::move(r); });
   mock_async_file_manager_->nextActionCompletes(
       absl::StatusOr<AsyncFileHandle>(mock_async_file_handle_));
@@ -562,7 +566,7 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, FailedReadOfHeaderProtoInvalidatesT
   absl::Cleanup destroy_lookup([&lookup]() { lookup->onDestroy(); });
   LookupResult result;
   EXPECT_CALL(*mock_async_file_manager_, openExistingFile(_, _, _));
-  EXPECT_CALL(*mock_async_file_handle_, read(0, CacheFileFixedBlock::size(), _));
+  EXPECT_CALL(*mock_async_file_handle_, read(0, ReadAheadLength, _));
   EXPECT_CALL(*mock_async_file_handle_, read(CacheFileFixedBlock::size(), headers_size_, _));
   lookup->getHeaders([&](LookupResult&& r) { result = std::move(r); });
   mock_async_file_manager_->nextActionCompletes(
@@ -585,7 +589,7 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, FailedReadOfBodyInvalidatesTheCache
   absl::Cleanup destroy_lookup([&lookup]() { lookup->onDestroy(); });
   LookupResult result;
   EXPECT_CALL(*mock_async_file_manager_, openExistingFile(_, _, _));
-  EXPECT_CALL(*mock_async_file_handle_, read(0, CacheFileFixedBlock::size(), _));
+  EXPECT_CALL(*mock_async_file_handle_, read(0, ReadAheadLength, _));
   EXPECT_CALL(*mock_async_file_handle_, read(CacheFileFixedBlock::size(), headers_size_, _));
   lookup->getHeaders([&](LookupResult&& r) { result = std::move(r); });
   mock_async_file_manager_->nextActionCompletes(
@@ -614,7 +618,7 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, FailedReadOfTrailersInvalidatesTheC
   absl::Cleanup destroy_lookup([&lookup]() { lookup->onDestroy(); });
   LookupResult result;
   EXPECT_CALL(*mock_async_file_manager_, openExistingFile(_, _, _));
-  EXPECT_CALL(*mock_async_file_handle_, read(0, CacheFileFixedBlock::size(), _));
+  EXPECT_CALL(*mock_async_file_handle_, read(0, ReadAheadLength, _));
   EXPECT_CALL(*mock_async_file_handle_, read(CacheFileFixedBlock::size(), headers_size_, _));
   lookup->getHeaders([&](LookupResult&& r) { result = std::move(r); });
   mock_async_file_manager_->nextActionCompletes(
@@ -644,11 +648,32 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, FailedReadOfTrailersInvalidatesTheC
       absl::UnknownError("intentionally failed to unlink, for coverage"));
 }
 
+TEST_F(FileSystemHttpCacheTestWithMockFiles, SmallEntryIsServedFromTheFirstRead) {
+  auto lookup = testLookupContext();
+  absl::Cleanup destroy_lookup([&lookup]() { lookup->onDestroy(); });
+  LookupResult result;
+  EXPECT_CALL(*mock_async_file_manager_, openExistingFile(_, _, _));
+  // Only one read; the headers and body come from the read-ahead.
+  EXPECT_CALL(*mock_async_file_handle_, read(0, ReadAheadLength, _));
+  lookup->getHeaders([&](LookupResult&& r) { result = std::move(r); });
+  mock_async_file_manager_->nextActionCompletes(
+      absl::StatusOr<AsyncFileHandle>(mock_async_file_handle_));
+  Buffer::InstancePtr file_start = testHeaderBlock(8);
+  file_start->move(*testHeaderBuffer());
+  file_start->add("beepboop");
+  mock_async_file_manager_->nextActionCompletes(
+      absl::StatusOr<Buffer::InstancePtr>(std::move(file_start)));
+  EXPECT_NE(result.cache_entry_status_, CacheEntryStatus::Unusable);
+  std::string body;
+  lookup->getBody(AdjustedByteRange(4, 8), [&](Buffer::InstancePtr b) { body = b->toString(); });
+  EXPECT_EQ(body, "boop");
+}
+
 TEST_F(FileSystemHttpCacheTestWithMockFiles, ReadWithMultipleBlocksWorksCorrectly) {
   auto lookup = testLookupContext();
   LookupResult result;
   EXPECT_CALL(*mock_async_file_manager_, openExistingFile(_, _, _));
-  EXPECT_CALL(*mock_async_file_handle_, read(0, CacheFileFixedBlock::size(), _));
+  EXPECT_CALL(*mock_async_file_handle_, read(0, ReadAheadLength, _));
   EXPECT_CALL(*mock_async_file_handle_,
               read(CacheFileFixedBlock::offsetToHeaders(), headers_size_, _));
   lookup->getHeaders([&](LookupResult&& r) { result = std::move(r); });
@@ -0,0 +1,83 @@
+#include <memory>
+#include <string>
+
+#include "source/extensions/http/cache/file_system_http_cache/memory_tier.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace FileSystemHttpCache {
+namespace {
+
+Key keyForPath(absl::string_view path) {
+  Key key;
+  key.set_host("example.com");
+  key.set_path(std::string(path));
+  return key;
+}
+
+std::shared_ptr<const std::string> contents(size_t size) {
+  return std::make_shared<const std::string>(size, 'x');
+}
+
+TEST(MemoryTierTest, PromotesAfterConfiguredHits) {
+  MemoryTier tier(1000, 2);
+  const Key key = keyForPath("/a");
+  tier.onDiskHit(key, contents(10), tier.generation());
+  EXPECT_EQ(tier.lookup(key), nullptr);
+  tier.onDiskHit(key, contents(10), tier.generation());
+  ASSERT_NE(tier.lookup(key), nullptr);
+  EXPECT_EQ(tier.lookup(key)->size(), 10);
+  EXPECT_EQ(tier.sizeBytes(), 10);
+}
+
+TEST(MemoryTierTest, InvalidateDropsEntryAndStaleHits) {
+  MemoryTier tier(1000, 1);
+  const Key key = keyForPath("/a");
+  tier.onDiskHit(key, contents(10), tier.generation());
+  ASSERT_NE(tier.lookup(key), nullptr);
+
+  const uint64_t generation = tier.generation();
+  tier.invalidate(key);
+  EXPECT_EQ(tier.lookup(key), nullptr);
+  EXPECT_EQ(tier.sizeBytes(), 0);
+  // A file read before the invalidation may be out of date, so it is not promoted.
+  tier.onDiskHit(key, contents(10), generation);
+  EXPECT_EQ(tier.lookup(key), nullptr);
+  tier.onDiskHit(key, contents(10), tier.generation());
+  EXPECT_NE(tier.lookup(key), nullptr);
+}
+
+TEST(MemoryTierTest, EvictsLeastRecentlyUsed) {
+  MemoryTier tier(25, 1);
+  const Key a = keyForPath("/a");
+  const Key b = keyForPath("/b");
+  const Key c = keyForPath("/c");
+  tier.onDiskHit(a, contents(10), tier.generation());
+  tier.onDiskHit(b, contents(10), tier.generation());
+  // Touch a, so that b is the least recently used.
+  EXPECT_NE(tier.lookup(a), nullptr);
+  tier.onDiskHit(c, contents(10), tier.generation());
+  EXPECT_NE(tier.lookup(a), nullptr);
+  EXPECT_EQ(tier.lookup(b), nullptr);
+  EXPECT_NE(tier.lookup(c), nullptr);
+  EXPECT_EQ(tier.sizeBytes(), 20);
+}
+
+TEST(MemoryTierTest, IgnoresFilesLargerThanTheTier) {
+  MemoryTier tier(25, 1);
+  const Key key = keyForPath("/a");
+  tier.onDiskHit(key, contents(26), tier.generation());
+  EXPECT_EQ(tier.lookup(key), nullptr);
+  EXPECT_EQ(tier.sizeBytes(), 0);
+}
+
+} // namespace
+} // namespace FileSystemHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
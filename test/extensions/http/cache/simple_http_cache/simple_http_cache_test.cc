@@ -1,3 +1,4 @@
+#include "envoy/extensions/http/cache/simple_http_cache/v3/config.pb.h"
 #include "envoy/http/header_map.h"
 #include "envoy/registry/registry.h"
 
@@ -7,6 +8,7 @@
 #include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
 
 #include "test/extensions/filters/http/cache/http_cache_implementation_test_common.h"
+#include "test/mocks/http/mocks.h"
 #include "test/mocks/server/factory_context.h"
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
@@ -19,6 +21,9 @@ namespace HttpFilters {
 namespace Cache {
 namespace {
 
+using testing::_;
+using testing::Invoke;
+
 class SimpleHttpCacheTestDelegate : public HttpCacheTestDelegate {
 public:
   std::shared_ptr<HttpCache> cache() override { return cache_; }
@@ -45,6 +50,336 @@ TEST(Registration, GetFactory) {
             "envoy.extensions.http.cache.simple");
 }
 
+TEST(Registration, CachesWithSameSizeLimitAreShared) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig cache_config;
+  envoy::extensions::filters::http::cache::v3::CacheConfig unbounded;
+  unbounded.mutable_typed_config()->PackFrom(cache_config);
+  cache_config.mutable_max_cache_size_bytes()->set_value(1024 * 1024);
+  envoy::extensions::filters::http::cache::v3::CacheConfig bounded;
+  bounded.mutable_typed_config()->PackFrom(cache_config);
+
+  std::shared_ptr<HttpCache> unbounded_cache = factory->getCache(unbounded, factory_context);
+  std::shared_ptr<HttpCache> bounded_cache = factory->getCache(bounded, factory_context);
+  EXPECT_EQ(unbounded_cache, factory->getCache(unbounded, factory_context));
+  EXPECT_EQ(bounded_cache, factory->getCache(bounded, factory_context));
+  EXPECT_NE(unbounded_cache, bounded_cache);
+}
+
+// A config replacing another one, as on an LDS update, sees the entries inserted through the
+// previous config.
+TEST(Registration, ReplacedConfigSharesEntries) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  config.mutable_typed_config()->PackFrom(
+      envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig());
+
+  Event::SimulatedTimeSystem time_system;
+  DateFormatter formatter{"%a, %d %b %Y %H:%M:%S GMT"};
+  Http::TestRequestHeaderMapImpl request_headers{
+      {":method", "GET"}, {":authority", "example.com"}, {":scheme", "https"}, {":path", "/"}};
+  VaryAllowList vary_allow_list{
+      Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher>()};
+  testing::NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+  testing::NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks;
+
+  std::shared_ptr<HttpCache> previous_cache = factory->getCache(config, factory_context);
+  InsertContextPtr insert = previous_cache->makeInsertContext(
+      previous_cache->makeLookupContext(
+          LookupRequest(request_headers, time_system.systemTime(), vary_allow_list),
+          decoder_callbacks),
+      encoder_callbacks);
+  const Http::TestResponseHeaderMapImpl response_headers{
+      {":status", "200"},
+      {"date", formatter.fromTime(time_system.systemTime())},
+      {"cache-control", "public,max-age=3600"}};
+  insert->insertHeaders(response_headers, {time_system.systemTime()}, [](bool) {}, true);
+  insert->onDestroy();
+  insert.reset();
+
+  std::shared_ptr<HttpCache> cache = factory->getCache(config, factory_context);
+  previous_cache.reset();
+  LookupContextPtr lookup = cache->makeLookupContext(
+      LookupRequest(request_headers, time_system.systemTime(), vary_allow_list),
+      decoder_callbacks);
+  absl::optional<CacheEntryStatus> status;
+  lookup->getHeaders([&](LookupResult&& result) { status = result.cache_entry_status_; });
+  EXPECT_EQ(status, CacheEntryStatus::Ok);
+  lookup->onDestroy();
+}
+
+TEST(Registration, GetCoalescingCache) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig cache_config;
+  cache_config.set_coalesce_concurrent_misses(true);
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  config.mutable_typed_config()->PackFrom(cache_config);
+  EXPECT_EQ(factory->getCache(config, factory_context)->cacheInfo().name_,
+            "envoy.extensions.http.cache.simple");
+}
+
+class SimpleHttpCacheCoalescingTest : public testing::Test {
+protected:
+  SimpleHttpCacheCoalescingTest() {
+    request_headers_.setMethod("GET");
+    request_headers_.setHost("example.com");
+    request_headers_.setScheme("https");
+    request_headers_.setPath("/coalesced");
+    // Hold posted wake-ups so that the test controls when waiting lookups resume.
+    ON_CALL(decoder_callbacks_.dispatcher_, post(_))
+        .WillByDefault(Invoke([this](Event::PostCb cb) { posted_.push_back(std::move(cb)); }));
+  }
+
+  LookupContextPtr lookup() {
+    return cache_.makeCoalescingLookupContext(
+        LookupRequest(request_headers_, time_system_.systemTime(), vary_allow_list_),
+        decoder_callbacks_);
+  }
+
+  void runPosted() {
+    std::vector<Event::PostCb> posted = std::move(posted_);
+    posted_.clear();
+    for (auto& cb : posted) {
+      cb();
+    }
+  }
+
+  void insertResponse(LookupContextPtr lookup) {
+    InsertContextPtr insert = cache_.makeInsertContext(std::move(lookup), encoder_callbacks_);
+    const Http::TestResponseHeaderMapImpl response_headers{
+        {":status", "200"},
+        {"date", formatter_.fromTime(time_system_.systemTime())},
+        {"cache-control", "public,max-age=3600"}};
+    insert->insertHeaders(response_headers, {time_system_.systemTime()}, [](bool) {}, false);
+    insert->insertBody(Buffer::OwnedImpl("body"), [](bool) {}, true);
+    insert->onDestroy();
+  }
+
+  SimpleHttpCache cache_;
+  Event::SimulatedTimeSystem time_system_;
+  DateFormatter formatter_{"%a, %d %b %Y %H:%M:%S GMT"};
+  Http::TestRequestHeaderMapImpl request_headers_;
+  VaryAllowList vary_allow_list_{
+      Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher>()};
+  testing::NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
+  testing::NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks_;
+  std::vector<Event::PostCb> posted_;
+};
+
+TEST_F(SimpleHttpCacheCoalescingTest, ConcurrentMissWaitsForInsert) {
+  LookupContextPtr first = lookup();
+  absl::optional<CacheEntryStatus> first_status;
+  first->getHeaders([&](LookupResult&& result) { first_status = result.cache_entry_status_; });
+  EXPECT_EQ(first_status, CacheEntryStatus::Unusable);
+
+  LookupContextPtr second = lookup();
+  absl::optional<CacheEntryStatus> second_status;
+  second->getHeaders([&](LookupResult&& result) { second_status = result.cache_entry_status_; });
+  // The second lookup waits for the first one's response.
+  EXPECT_FALSE(second_status.has_value());
+
+  insertResponse(std::move(first));
+  EXPECT_FALSE(second_status.has_value());
+  runPosted();
+  EXPECT_EQ(second_status, CacheEntryStatus::Ok);
+}
+
+TEST_F(SimpleHttpCacheCoalescingTest, WaitingLookupMissesIfFetchIsAbandoned) {
+  LookupContextPtr first = lookup();
+  first->getHeaders([](LookupResult&&) {});
+
+  LookupContextPtr second = lookup();
+  absl::optional<CacheEntryStatus> second_status;
+  second->getHeaders([&](LookupResult&& result) { second_status = result.cache_entry_status_; });
+  LookupContextPtr third = lookup();
+  bool third_called = false;
+  third->getHeaders([&](LookupResult&&) { third_called = true; });
+
+  // The first response was not cacheable. The waiting lookups go upstream themselves, and a
+  // destroyed waiter is not called.
+  first->onDestroy();
+  first.reset();
+  third->onDestroy();
+  third.reset();
+  runPosted();
+  EXPECT_EQ(second_status, CacheEntryStatus::Unusable);
+  EXPECT_FALSE(third_called);
+
+  // The second lookup does not hold up later lookups.
+  LookupContextPtr fourth = lookup();
+  absl::optional<CacheEntryStatus> fourth_status;
+  fourth->getHeaders([&](LookupResult&& result) { fourth_status = result.cache_entry_status_; });
+  EXPECT_EQ(fourth_status, CacheEntryStatus::Unusable);
+}
+
+TEST_F(SimpleHttpCacheCoalescingTest, HeadRequestsAreNotCoalesced) {
+  request_headers_.setMethod("HEAD");
+  LookupContextPtr first = lookup();
+  first->getHeaders([](LookupResult&&) {});
+  LookupContextPtr second = lookup();
+  absl::optional<CacheEntryStatus> second_status;
+  second->getHeaders([&](LookupResult&& result) { second_status = result.cache_entry_status_; });
+  EXPECT_EQ(second_status, CacheEntryStatus::Unusable);
+}
+
+TEST_F(SimpleHttpCacheCoalescingTest, WaitingLookupStreamsBodyWhileInserting) {
+  LookupContextPtr first = lookup();
+  first->getHeaders([](LookupResult&&) {});
+  LookupContextPtr second = lookup();
+  absl::optional<LookupResult> second_result;
+  second->getHeaders([&](LookupResult&& result) { second_result = std::move(result); });
+
+  InsertContextPtr insert = cache_.makeInsertContext(std::move(first), encoder_callbacks_);
+  const Http::TestResponseHeaderMapImpl response_headers{
+      {":status", "200"},
+      {"date", formatter_.fromTime(time_system_.systemTime())},
+      {"cache-control", "public,max-age=3600"},
+      {"content-length", "8"}};
+  insert->insertHeaders(response_headers, {time_system_.systemTime()}, [](bool) {}, false);
+  runPosted();
+  // The waiting lookup is served as soon as the headers arrive.
+  ASSERT_TRUE(second_result.has_value());
+  EXPECT_EQ(second_result->cache_entry_status_, CacheEntryStatus::Ok);
+  EXPECT_EQ(second_result->content_length_, 8);
+
+  // Reads are answered with whatever part of their range has arrived.
+  std::string body;
+  auto on_body = [&](Buffer::InstancePtr&& data) {
+    ASSERT_NE(data, nullptr);
+    body = data->toString();
+  };
+  second->getBody(AdjustedByteRange(0, 6), on_body);
+  runPosted();
+  EXPECT_EQ(body, "");
+  insert->insertBody(Buffer::OwnedImpl("body"), [](bool) {}, false);
+  runPosted();
+  EXPECT_EQ(body, "body");
+  second->getBody(AdjustedByteRange(4, 6), on_body);
+  insert->insertBody(Buffer::OwnedImpl("more"), [](bool) {}, true);
+  runPosted();
+  EXPECT_EQ(body, "mo");
+
+  // Once inserted, the response is served as a regular cache entry.
+  insert->onDestroy();
+  insert.reset();
+  LookupContextPtr third = lookup();
+  absl::optional<LookupResult> third_result;
+  third->getHeaders([&](LookupResult&& result) { third_result = std::move(result); });
+  ASSERT_TRUE(third_result.has_value());
+  EXPECT_EQ(third_result->cache_entry_status_, CacheEntryStatus::Ok);
+  third->getBody(AdjustedByteRange(4, 8),
+                 [&](Buffer::InstancePtr&& data) { body = data->toString(); });
+  EXPECT_EQ(body, "more");
+}
+
+TEST_F(SimpleHttpCacheCoalescingTest, StreamedReadFailsIfInsertIsAbandoned) {
+  LookupContextPtr first = lookup();
+  first->getHeaders([](LookupResult&&) {});
+  InsertContextPtr insert = cache_.makeInsertContext(std::move(first), encoder_callbacks_);
+  const Http::TestResponseHeaderMapImpl response_headers{
+      {":status", "200"},
+      {"date", formatter_.fromTime(time_system_.systemTime())},
+      {"cache-control", "public,max-age=3600"},
+      {"content-length", "8"}};
+  insert->insertHeaders(response_headers, {time_system_.systemTime()}, [](bool) {}, false);
+
+  // A lookup arriving while the response is being inserted streams it.
+  LookupContextPtr second = lookup();
+  absl::optional<CacheEntryStatus> second_status;
+  second->getHeaders([&](LookupResult&& result) { second_status = result.cache_entry_status_; });
+  EXPECT_EQ(second_status, CacheEntryStatus::Ok);
+  bool body_called = false;
+  second->getBody(AdjustedByteRange(0, 8), [&](Buffer::InstancePtr&& data) {
+    EXPECT_EQ(data, nullptr);
+    body_called = true;
+  });
+
+  insert->onDestroy();
+  insert.reset();
+  runPosted();
+  EXPECT_TRUE(body_called);
+
+  // Nothing was inserted, so a later lookup misses.
+  LookupContextPtr third = lookup();
+  absl::optional<CacheEntryStatus> third_status;
+  third->getHeaders([&](LookupResult&& result) { third_status = result.cache_entry_status_; });
+  EXPECT_EQ(third_status, CacheEntryStatus::Unusable);
+}
+
+class SimpleHttpCacheEvictionTest : public testing::Test {
+protected:
+  // Each shard has room for three of the responses inserted by insert().
+  static constexpr uint64_t MaxShardSizeBytes = 4096;
+  static constexpr uint64_t BodySizeBytes = 1100;
+
+  SimpleHttpCacheEvictionTest() {
+    request_headers_.setMethod("GET");
+    request_headers_.setHost("example.com");
+    request_headers_.setScheme("https");
+  }
+
+  LookupRequest request(absl::string_view path) {
+    request_headers_.setPath(path);
+    return {request_headers_, time_system_.systemTime(), vary_allow_list_};
+  }
+
+  bool insert(absl::string_view path, uint64_t body_size = BodySizeBytes) {
+    return cache_.insert(request(path).key(),
+                         Http::createHeaderMap<Http::ResponseHeaderMapImpl>(
+                             {{Http::Headers::get().Status, "200"}}),
+                         {time_system_.systemTime()}, std::string(body_size, 'x'), nullptr);
+  }
+
+  bool cached(absl::string_view path) {
+    return cache_.lookup(request(path)).response_headers_ != nullptr;
+  }
+
+  SimpleHttpCache cache_{SimpleHttpCache::NumShards * MaxShardSizeBytes};
+  Event::SimulatedTimeSystem time_system_;
+  Http::TestRequestHeaderMapImpl request_headers_;
+  VaryAllowList vary_allow_list_{
+      Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher>()};
+};
+
+TEST_F(SimpleHttpCacheEvictionTest, StaysWithinSizeLimit) {
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_TRUE(insert(absl::StrCat("/path", i)));
+    EXPECT_TRUE(cached(absl::StrCat("/path", i)));
+  }
+  EXPECT_LE(cache_.sizeBytes(), SimpleHttpCache::NumShards * MaxShardSizeBytes);
+  EXPECT_GT(cache_.sizeBytes(), 0);
+  // Not every response fits.
+  int num_cached = 0;
+  for (int i = 0; i < 200; ++i) {
+    num_cached += cached(absl::StrCat("/path", i));
+  }
+  EXPECT_LT(num_cached, 200);
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, EvictsLeastRecentlyUsed) {
+  ASSERT_TRUE(insert("/hot"));
+  for (int i = 0; i < 200; ++i) {
+    ASSERT_TRUE(cached("/hot"));
+    EXPECT_TRUE(insert(absl::StrCat("/cold", i)));
+  }
+  EXPECT_TRUE(cached("/hot"));
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, ResponseLargerThanShardIsNotCached) {
+  EXPECT_FALSE(insert("/large", MaxShardSizeBytes));
+  EXPECT_FALSE(cached("/large"));
+  EXPECT_EQ(cache_.sizeBytes(), 0);
+}
+
 } // namespace
 } // namespace Cache
 } // namespace HttpFilters
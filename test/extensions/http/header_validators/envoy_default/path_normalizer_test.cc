@@ -176,6 +176,29 @@ TEST_F(PathNormalizerTest, NormalizePathUriRoot) {
   EXPECT_TRUE(result.ok());
 }
 
+TEST_F(PathNormalizerTest, NormalizePathUriAlreadyNormalized) {
+  ::Envoy::Http::TestRequestHeaderMapImpl headers{
+      {":path", "/static/app.v2/main.js/with-a-path-longer-than-a-vector?x=/../y"}};
+
+  auto normalizer = create(empty_config);
+  auto result = normalizer->normalizePathUri(headers);
+
+  EXPECT_EQ(headers.getPathValue(),
+            "/static/app.v2/main.js/with-a-path-longer-than-a-vector?x=/../y");
+  EXPECT_TRUE(result.ok());
+}
+
+TEST_F(PathNormalizerTest, NormalizePathUriDotSegmentAfterLongPrefix) {
+  ::Envoy::Http::TestRequestHeaderMapImpl headers{
+      {":path", "/static/app/with-a-path-longer-than-a-vector/../main.js"}};
+
+  auto normalizer = create(empty_config);
+  auto result = normalizer->normalizePathUri(headers);
+
+  EXPECT_EQ(headers.getPathValue(), "/static/app/main.js");
+  EXPECT_TRUE(result.ok());
+}
+
 TEST_F(PathNormalizerTest, NormalizePathUriRootPreserveQueryFragment) {
   ::Envoy::Http::TestRequestHeaderMapImpl headers{{":path", "/root/child?x=1#anchor"}};
 
@@ -323,6 +323,31 @@ TEST_F(MaglevLoadBalancerTest, BasicStability) {
   }
 }
 
+// The table of a priority is only rebuilt when the hosts of that priority change.
+TEST_F(MaglevLoadBalancerTest, OnlyUpdatedPriorityIsRebuilt) {
+  MockHostSet& failover_host_set = *priority_set_.getMockHostSet(1);
+  host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:90", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:91", simTime())};
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  host_set_.runCallbacks({}, {});
+  init(7);
+  EXPECT_EQ(3, lb_->stats().min_entries_per_host_.value());
+  LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+  TestLoadBalancerContext context(0);
+  const HostConstSharedPtr host = lb->chooseHost(&context);
+
+  // Building the table of a priority sets the gauge, so it is untouched if the priority 0 table
+  // is shared with the previous state. The empty failover priority never builds a table.
+  lb_->stats().min_entries_per_host_.set(0);
+  failover_host_set.runCallbacks({}, {});
+  EXPECT_EQ(0, lb_->stats().min_entries_per_host_.value());
+  EXPECT_EQ(host, lb_->factory()->create(lb_params_)->chooseHost(&context));
+
+  host_set_.runCallbacks({}, {});
+  EXPECT_EQ(3, lb_->stats().min_entries_per_host_.value());
+  EXPECT_EQ(host, lb_->factory()->create(lb_params_)->chooseHost(&context));
+}
+
 // Weighted sanity test.
 TEST_F(MaglevLoadBalancerTest, Weighted) {
   host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:90", simTime(), 1),
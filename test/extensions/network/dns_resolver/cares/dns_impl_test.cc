@@ -54,6 +54,7 @@ using testing::IsSupersetOf;
 using testing::NiceMock;
 using testing::Not;
 using testing::Return;
+using testing::UnorderedElementsAre;
 using testing::UnorderedElementsAreArray;
 
 namespace Envoy {
@@ -713,6 +714,10 @@ public:
     }
 
     cares.set_filter_unroutable_families(filterUnroutableFamilies());
+    if (coalesceAndCacheFailures()) {
+      cares.set_coalesce_concurrent_queries(true);
+      cares.mutable_negative_cache_ttl()->set_seconds(60);
+    }
 
     // Copy over the dns_resolver_options_.
     cares.mutable_dns_resolver_options()->MergeFrom(dns_resolver_options);
@@ -946,6 +951,7 @@ protected:
   virtual void updateDnsResolverOptions(){};
   virtual bool setResolverInConstructor() const { return false; }
   virtual bool filterUnroutableFamilies() const { return false; }
+  virtual bool coalesceAndCacheFailures() const { return false; }
   Stats::TestUtil::TestStore stats_store_;
   NiceMock<Runtime::MockLoader> runtime_;
   std::unique_ptr<TestDnsServer> server_;
@@ -1920,6 +1926,83 @@ TEST_P(DnsImplFilterUnroutableFamiliesDontFilterTest, DontFilterAllV6) {
   testFilterAddresses({"1.2.3.4:80"}, DnsLookupFamily::All, {"201.134.56.7", "1::2"});
 }
 
+class DnsImplCoalescingTest : public DnsImplTest {
+protected:
+  bool coalesceAndCacheFailures() const override { return true; }
+};
+
+INSTANTIATE_TEST_SUITE_P(IpVersions, DnsImplCoalescingTest,
+                         testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
+                         TestUtility::ipTestParamsToString);
+
+// Concurrent resolutions of the same name and lookup family share their query.
+TEST_P(DnsImplCoalescingTest, CoalesceConcurrentQueries) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+
+  uint32_t completed = 0;
+  auto callback = [&](DnsResolver::ResolutionStatus status, std::list<DnsResponse>&& results) {
+    EXPECT_EQ(DnsResolver::ResolutionStatus::Success, status);
+    EXPECT_THAT(getAddressAsStringList(results), UnorderedElementsAre("201.134.56.7"));
+    if (++completed == 2) {
+      dispatcher_->exit();
+    }
+  };
+  EXPECT_NE(nullptr, resolver_->resolve("some.good.domain", DnsLookupFamily::V4Only, callback));
+  EXPECT_NE(nullptr, resolver_->resolve("some.good.domain", DnsLookupFamily::V4Only, callback));
+  // Cancelled resolutions are not called back.
+  resolveWithUnreferencedParameters("some.good.domain", DnsLookupFamily::V4Only, false)
+      ->cancel(ActiveDnsQuery::CancelReason::QueryAbandoned);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_EQ(2, completed);
+  checkStats(1 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+  EXPECT_EQ(2, stats_store_.counter("dns.cares.coalesced").value());
+
+  // Resolutions started once the query completed issue a query of their own.
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Success,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  checkStats(2 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+}
+
+// Resolutions without records are remembered until the networking is reset.
+TEST_P(DnsImplCoalescingTest, NegativeCache) {
+  EXPECT_NE(nullptr, resolveWithNoRecordsExpectation("some.good.domain", DnsLookupFamily::V4Only));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  checkStats(1 /*resolve_total*/, 0 /*pending_resolutions*/, 1 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+
+  bool completed = false;
+  EXPECT_EQ(nullptr,
+            resolver_->resolve("some.good.domain", DnsLookupFamily::V4Only,
+                               [&](DnsResolver::ResolutionStatus status,
+                                   std::list<DnsResponse>&& results) {
+                                 EXPECT_EQ(DnsResolver::ResolutionStatus::Success, status);
+                                 EXPECT_TRUE(results.empty());
+                                 completed = true;
+                               }));
+  EXPECT_TRUE(completed);
+  EXPECT_EQ(1, stats_store_.counter("dns.cares.negative_cache_hit").value());
+
+  // Other lookup families are not affected.
+  EXPECT_NE(nullptr, resolveWithNoRecordsExpectation("some.good.domain", DnsLookupFamily::V6Only));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  checkStats(2 /*resolve_total*/, 0 /*pending_resolutions*/, 2 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+
+  resolver_->resetNetworking();
+  resetChannel();
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Success,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(1, stats_store_.counter("dns.cares.negative_cache_hit").value());
+}
+
 class DnsImplZeroTimeoutTest : public DnsImplTest {
 protected:
   bool zeroTimeout() const override { return true; }
@@ -0,0 +1,339 @@
+#include <string>
+#include <vector>
+
+#include "source/extensions/private_key_providers/thread_pool/config.h"
+#include "source/extensions/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/server/transport_socket_factory_context.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/evp.h"
+#include "openssl/rsa.h"
+#include "openssl/ssl.h"
+
+using testing::NiceMock;
+using testing::ReturnRef;
+using testing::StrictMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+namespace {
+
+class MockPrivateKeyConnectionCallbacks : public Ssl::PrivateKeyConnectionCallbacks {
+public:
+  MOCK_METHOD(void, onPrivateKeyMethodComplete, ());
+};
+
+class ThreadPoolPrivateKeyProviderTest : public testing::Test {
+protected:
+  ThreadPoolPrivateKeyProviderTest()
+      : api_(Api::createApiForTest(store_)), dispatcher_(api_->allocateDispatcher("test_thread")),
+        ssl_ctx_(SSL_CTX_new(TLS_method())), ssl_(SSL_new(ssl_ctx_.get())) {
+    ON_CALL(factory_context_.server_context_, api()).WillByDefault(ReturnRef(*api_));
+    ON_CALL(factory_context_, statsScope()).WillByDefault(ReturnRef(*store_.rootScope()));
+    ON_CALL(factory_context_.server_context_, scope())
+        .WillByDefault(ReturnRef(*store_.rootScope()));
+  }
+
+  Ssl::PrivateKeyMethodProviderSharedPtr createProvider(const std::string& key_file,
+                                                        uint32_t max_queue_depth = 1024) {
+    return createProvider(factory_context_, key_file, max_queue_depth);
+  }
+
+  Ssl::PrivateKeyMethodProviderSharedPtr
+  createProvider(Server::Configuration::TransportSocketFactoryContext& factory_context,
+                 const std::string& key_file, uint32_t max_queue_depth) {
+    const std::string yaml = fmt::format(R"EOF(
+      provider_name: thread_pool
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.private_key_providers.thread_pool.v3.ThreadPoolPrivateKeyMethodConfig
+        thread_count: 2
+        max_queue_depth: {}
+        private_key: {{ "filename": "{{{{ test_rundir }}}}/test/common/tls/test_data/{}" }}
+)EOF",
+                                         max_queue_depth, key_file);
+    envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider config;
+    TestUtility::loadFromYaml(TestEnvironment::substitute(yaml), config);
+    return factory_.createPrivateKeyMethodProviderInstance(config, factory_context);
+  }
+
+  bssl::UniquePtr<EVP_PKEY> readKey(const std::string& key_file) {
+    const std::string key = TestEnvironment::readFileToStringForTest(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/common/tls/test_data/" + key_file));
+    bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(key.data(), key.size()));
+    return bssl::UniquePtr<EVP_PKEY>(
+        PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  }
+
+  // Runs the dispatcher until the pending operation has completed and returns its output.
+  std::vector<uint8_t> completeOperation(SSL_PRIVATE_KEY_METHOD& method) {
+    EXPECT_CALL(callbacks_, onPrivateKeyMethodComplete()).WillOnce([this]() {
+      dispatcher_->exit();
+    });
+    dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+
+    std::vector<uint8_t> out(1024);
+    size_t out_len;
+    EXPECT_EQ(ssl_private_key_success,
+              method.complete(ssl_.get(), out.data(), &out_len, out.size()));
+    out.resize(out_len);
+    return out;
+  }
+
+  bool verify(EVP_PKEY* pkey, uint16_t signature_algorithm, const std::vector<uint8_t>& signature,
+              absl::string_view message) {
+    bssl::ScopedEVP_MD_CTX ctx;
+    EVP_PKEY_CTX* pkey_ctx;
+    if (!EVP_DigestVerifyInit(ctx.get(), &pkey_ctx,
+                              SSL_get_signature_algorithm_digest(signature_algorithm), nullptr,
+                              pkey)) {
+      return false;
+    }
+    if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm) &&
+        (!EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ||
+         !EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1))) {
+      return false;
+    }
+    return EVP_DigestVerify(ctx.get(), signature.data(), signature.size(),
+                            reinterpret_cast<const uint8_t*>(message.data()), message.size());
+  }
+
+  Stats::TestUtil::TestStore store_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context_;
+  ThreadPoolPrivateKeyMethodFactory factory_;
+  bssl::UniquePtr<SSL_CTX> ssl_ctx_;
+  bssl::UniquePtr<SSL> ssl_;
+  StrictMock<MockPrivateKeyConnectionCallbacks> callbacks_;
+};
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, EcdsaSign) {
+  Ssl::PrivateKeyMethodProviderSharedPtr provider =
+      createProvider("selfsigned_ecdsa_p256_key.pem");
+  EXPECT_TRUE(provider->isAvailable());
+  provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  SSL_PRIVATE_KEY_METHOD& method = *provider->getBoringSslPrivateKeyMethod();
+
+  const std::string message = "message to sign";
+  uint8_t unused[1];
+  size_t unused_len;
+  EXPECT_EQ(ssl_private_key_retry,
+            method.sign(ssl_.get(), unused, &unused_len, 1024, SSL_SIGN_ECDSA_SECP256R1_SHA256,
+                        reinterpret_cast<const uint8_t*>(message.data()), message.size()));
+  // The operation has not been handed back to the worker yet.
+  EXPECT_EQ(ssl_private_key_retry, method.complete(ssl_.get(), unused, &unused_len, 1));
+
+  const std::vector<uint8_t> signature = completeOperation(method);
+  EXPECT_TRUE(verify(readKey("selfsigned_ecdsa_p256_key.pem").get(),
+                     SSL_SIGN_ECDSA_SECP256R1_SHA256, signature, message));
+  EXPECT_EQ(0, store_.gauge("thread_pool_private_key.queue_depth",
+                            Stats::Gauge::ImportMode::Accumulate)
+                   .value());
+
+  provider->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, RsaPssSign) {
+  Ssl::PrivateKeyMethodProviderSharedPtr provider = createProvider("unittest_key.pem");
+  provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  SSL_PRIVATE_KEY_METHOD& method = *provider->getBoringSslPrivateKeyMethod();
+
+  const std::string message = "message to sign";
+  uint8_t unused[1];
+  size_t unused_len;
+  EXPECT_EQ(ssl_private_key_retry,
+            method.sign(ssl_.get(), unused, &unused_len, 1024, SSL_SIGN_RSA_PSS_RSAE_SHA256,
+                        reinterpret_cast<const uint8_t*>(message.data()), message.size()));
+
+  const std::vector<uint8_t> signature = completeOperation(method);
+  EXPECT_TRUE(verify(readKey("unittest_key.pem").get(), SSL_SIGN_RSA_PSS_RSAE_SHA256, signature,
+                     message));
+
+  provider->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, RsaDecrypt) {
+  Ssl::PrivateKeyMethodProviderSharedPtr provider = createProvider("unittest_key.pem");
+  provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  SSL_PRIVATE_KEY_METHOD& method = *provider->getBoringSslPrivateKeyMethod();
+
+  bssl::UniquePtr<EVP_PKEY> pkey = readKey("unittest_key.pem");
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey.get());
+  std::vector<uint8_t> plaintext(RSA_size(rsa), 0);
+  plaintext.back() = 42;
+  std::vector<uint8_t> ciphertext(RSA_size(rsa));
+  size_t ciphertext_len;
+  ASSERT_TRUE(RSA_encrypt(rsa, &ciphertext_len, ciphertext.data(), ciphertext.size(),
+                          plaintext.data(), plaintext.size(), RSA_NO_PADDING));
+
+  uint8_t unused[1];
+  size_t unused_len;
+  EXPECT_EQ(ssl_private_key_retry, method.decrypt(ssl_.get(), unused, &unused_len, 1024,
+                                                  ciphertext.data(), ciphertext_len));
+  EXPECT_EQ(plaintext, completeOperation(method));
+
+  provider->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, SignWithMismatchedAlgorithmFails) {
+  Ssl::PrivateKeyMethodProviderSharedPtr provider =
+      createProvider("selfsigned_ecdsa_p256_key.pem");
+  provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  SSL_PRIVATE_KEY_METHOD& method = *provider->getBoringSslPrivateKeyMethod();
+
+  const std::string message = "message to sign";
+  uint8_t out[1024];
+  size_t out_len;
+  EXPECT_EQ(ssl_private_key_retry,
+            method.sign(ssl_.get(), out, &out_len, sizeof(out), SSL_SIGN_RSA_PSS_RSAE_SHA256,
+                        reinterpret_cast<const uint8_t*>(message.data()), message.size()));
+  EXPECT_CALL(callbacks_, onPrivateKeyMethodComplete()).WillOnce([this]() {
+    dispatcher_->exit();
+  });
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  EXPECT_EQ(ssl_private_key_failure, method.complete(ssl_.get(), out, &out_len, sizeof(out)));
+
+  provider->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+// An operation of a connection which goes away before it completes never calls back into it.
+TEST_F(ThreadPoolPrivateKeyProviderTest, UnregisterCancelsOperation) {
+  Ssl::PrivateKeyMethodProviderSharedPtr provider =
+      createProvider("selfsigned_ecdsa_p256_key.pem");
+  provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  SSL_PRIVATE_KEY_METHOD& method = *provider->getBoringSslPrivateKeyMethod();
+
+  const std::string message = "message to sign";
+  uint8_t unused[1];
+  size_t unused_len;
+  EXPECT_EQ(ssl_private_key_retry,
+            method.sign(ssl_.get(), unused, &unused_len, 1024, SSL_SIGN_ECDSA_SECP256R1_SHA256,
+                        reinterpret_cast<const uint8_t*>(message.data()), message.size()));
+  provider->unregisterPrivateKeyMethod(ssl_.get());
+
+  // Joins the threads of the pool, so that a completion, if any, has been posted.
+  provider.reset();
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(ssl_private_key_failure, method.complete(ssl_.get(), unused, &unused_len, 1));
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, RegisterTwice) {
+  Ssl::PrivateKeyMethodProviderSharedPtr provider = createProvider("unittest_key.pem");
+  provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  EXPECT_THROW_WITH_MESSAGE(
+      provider->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_), EnvoyException,
+      "Not registering the thread pool provider twice for same context");
+  provider->unregisterPrivateKeyMethod(ssl_.get());
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, InvalidKey) {
+  EXPECT_THROW_WITH_MESSAGE(createProvider("unittest_cert.pem"), EnvoyException,
+                            "Failed to read private key.");
+}
+
+// Providers configured alike share one pool, including when one replaces the other, as on an SDS
+// update, and the pool is released with the last of them.
+TEST_F(ThreadPoolPrivateKeyProviderTest, ProvidersSharePool) {
+  Ssl::PrivateKeyMethodProviderSharedPtr provider =
+      createProvider("selfsigned_ecdsa_p256_key.pem");
+  auto& registry = *factory_context_.server_context_.singletonManager()
+                        .getTyped<PrivateKeyThreadPoolRegistry>(
+                            "thread_pool_private_key_registry_singleton");
+  PrivateKeyThreadPoolSharedPtr pool =
+      registry.get(api_->threadFactory(), 2, 1024, *store_.rootScope());
+  PrivateKeyThreadPoolSharedPtr other_pool =
+      registry.get(api_->threadFactory(), 2, 16, *store_.rootScope());
+  EXPECT_NE(pool, other_pool);
+
+  Ssl::PrivateKeyMethodProviderSharedPtr other_provider = createProvider("unittest_key.pem");
+  EXPECT_EQ(pool, registry.get(api_->threadFactory(), 2, 1024, *store_.rootScope()));
+
+  // The pool is shared across the providers of other TLS contexts too.
+  NiceMock<Server::Configuration::MockTransportSocketFactoryContext> other_context;
+  ON_CALL(other_context, serverFactoryContext())
+      .WillByDefault(ReturnRef(factory_context_.server_context_));
+  ON_CALL(other_context, statsScope()).WillByDefault(ReturnRef(*store_.rootScope()));
+  Ssl::PrivateKeyMethodProviderSharedPtr context_provider =
+      createProvider(other_context, "unittest_key.pem", 1024);
+
+  std::weak_ptr<PrivateKeyThreadPool> weak_pool = pool;
+  pool.reset();
+  provider.reset();
+  other_provider.reset();
+  EXPECT_FALSE(weak_pool.expired());
+  context_provider.reset();
+  EXPECT_TRUE(weak_pool.expired());
+}
+
+// Operations fail instead of waiting once the queue is full.
+TEST(PrivateKeyThreadPoolTest, QueueOverflow) {
+  Stats::TestUtil::TestStore store;
+  Api::ApiPtr api = Api::createApiForTest(store);
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Stats::Gauge& queue_depth = store.gauge("queue_depth", Stats::Gauge::ImportMode::Accumulate);
+  ThreadPoolPrivateKeyStats stats{ALL_THREAD_POOL_PRIVATE_KEY_STATS(
+      POOL_COUNTER_PREFIX(*store.rootScope(), "test"),
+      POOL_HISTOGRAM_PREFIX(*store.rootScope(), "test"))};
+  NiceMock<MockPrivateKeyConnectionCallbacks> callbacks;
+  bssl::UniquePtr<EVP_PKEY> pkey(EVP_PKEY_new());
+  const uint8_t in[1] = {};
+  {
+    // Without threads the queued operations are never taken off the queue.
+    PrivateKeyThreadPool pool(api->threadFactory(), 0, 1, queue_depth);
+    ThreadPoolPrivateKeyConnection connection(callbacks, *dispatcher, api->timeSource(),
+                                              bssl::UpRef(pkey), pool, stats);
+    ThreadPoolPrivateKeyConnection other_connection(callbacks, *dispatcher, api->timeSource(),
+                                                    bssl::UpRef(pkey), pool, stats);
+    EXPECT_EQ(ssl_private_key_retry,
+              connection.start(OperationType::Sign, SSL_SIGN_ECDSA_SECP256R1_SHA256, in, 1, 64));
+    EXPECT_EQ(1, queue_depth.value());
+    EXPECT_EQ(ssl_private_key_failure, other_connection.start(OperationType::Sign,
+                                                              SSL_SIGN_ECDSA_SECP256R1_SHA256,
+                                                              in, 1, 64));
+    EXPECT_EQ(1, queue_depth.value());
+    EXPECT_EQ(1, stats.queue_overflow_.value());
+  }
+  EXPECT_EQ(0, queue_depth.value());
+}
+
+// Operations still queued when the pool terminates fail their handshakes instead of leaving them
+// waiting.
+TEST(PrivateKeyThreadPoolTest, TerminationFailsQueuedOperations) {
+  Stats::TestUtil::TestStore store;
+  Api::ApiPtr api = Api::createApiForTest(store);
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Stats::Gauge& queue_depth = store.gauge("queue_depth", Stats::Gauge::ImportMode::Accumulate);
+  ThreadPoolPrivateKeyStats stats{ALL_THREAD_POOL_PRIVATE_KEY_STATS(
+      POOL_COUNTER_PREFIX(*store.rootScope(), "test"),
+      POOL_HISTOGRAM_PREFIX(*store.rootScope(), "test"))};
+  StrictMock<MockPrivateKeyConnectionCallbacks> callbacks;
+  bssl::UniquePtr<EVP_PKEY> pkey(EVP_PKEY_new());
+  const uint8_t in[1] = {};
+
+  auto pool = std::make_unique<PrivateKeyThreadPool>(api->threadFactory(), 0, 1, queue_depth);
+  ThreadPoolPrivateKeyConnection connection(callbacks, *dispatcher, api->timeSource(),
+                                            bssl::UpRef(pkey), *pool, stats);
+  EXPECT_EQ(ssl_private_key_retry,
+            connection.start(OperationType::Sign, SSL_SIGN_ECDSA_SECP256R1_SHA256, in, 1, 64));
+  pool.reset();
+  EXPECT_EQ(0, queue_depth.value());
+
+  EXPECT_CALL(callbacks, onPrivateKeyMethodComplete());
+  dispatcher->run(Event::Dispatcher::RunType::NonBlock);
+  uint8_t out[64];
+  size_t out_len;
+  EXPECT_EQ(ssl_private_key_failure, connection.complete(out, &out_len, sizeof(out)));
+}
+
+} // namespace
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,118 @@
+#include <string>
+
+#include "envoy/extensions/resource_monitors/cgroup/v3/cgroup.pb.h"
+
+#include "source/extensions/resource_monitors/cgroup/cgroup_monitor.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/match.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CgroupMonitor {
+namespace {
+
+using CgroupConfig = envoy::extensions::resource_monitors::cgroup::v3::CgroupConfig;
+
+class MockedCallbacks : public Server::ResourceUpdateCallbacks {
+public:
+  MOCK_METHOD(void, onSuccess, (const Server::ResourceUsage&));
+  MOCK_METHOD(void, onFailure, (const EnvoyException&));
+};
+
+MATCHER_P(ExceptionContains, rhs, "") { return absl::StrContains(arg.what(), rhs); }
+
+class CgroupMonitorTest : public testing::Test {
+protected:
+  CgroupMonitorTest()
+      : api_(Api::createApiForTest()), cgroup_path_(TestEnvironment::temporaryPath("cgroup")) {
+    TestEnvironment::createPath(cgroup_path_);
+  }
+
+  ~CgroupMonitorTest() override { TestEnvironment::removePath(cgroup_path_); }
+
+  void writeFile(const std::string& name, const std::string& contents) {
+    TestEnvironment::writeStringToFileForTest(cgroup_path_ + "/" + name, contents, true);
+  }
+
+  void update(CgroupConfig::Resource resource) {
+    CgroupConfig config;
+    config.set_cgroup_path(cgroup_path_);
+    config.set_resource(resource);
+    CgroupMonitor monitor(config, api_->fileSystem());
+    monitor.updateResourceUsage(cb_);
+  }
+
+  Api::ApiPtr api_;
+  const std::string cgroup_path_;
+  MockedCallbacks cb_;
+};
+
+TEST_F(CgroupMonitorTest, ReportsMemoryWorkingSet) {
+  writeFile("memory.max", "1000\n");
+  writeFile("memory.current", "800\n");
+  writeFile("memory.stat", "anon 500\nfile 300\ninactive_file 200\nactive_file 100\n");
+
+  EXPECT_CALL(cb_, onSuccess(Server::ResourceUsage{0.6}));
+  update(CgroupConfig::MEMORY);
+
+  // Page cache is never charged as negative usage.
+  writeFile("memory.stat", "inactive_file 1200\n");
+  EXPECT_CALL(cb_, onSuccess(Server::ResourceUsage{0}));
+  update(CgroupConfig::MEMORY);
+}
+
+TEST_F(CgroupMonitorTest, ReportsErrorWithoutMemoryLimit) {
+  writeFile("memory.max", "max\n");
+  writeFile("memory.current", "800\n");
+  writeFile("memory.stat", "inactive_file 200\n");
+
+  EXPECT_CALL(cb_, onFailure(ExceptionContains("cgroup has no memory limit")));
+  update(CgroupConfig::MEMORY);
+}
+
+TEST_F(CgroupMonitorTest, ReportsMemoryParseErrors) {
+  writeFile("memory.max", "1000\n");
+  writeFile("memory.current", "lots\n");
+  writeFile("memory.stat", "inactive_file 200\n");
+  EXPECT_CALL(cb_, onFailure(ExceptionContains("failed to parse cgroup memory.current")));
+  update(CgroupConfig::MEMORY);
+
+  writeFile("memory.current", "800\n");
+  writeFile("memory.stat", "anon 500\n");
+  EXPECT_CALL(cb_, onFailure(ExceptionContains("cgroup memory.stat has no inactive_file")));
+  update(CgroupConfig::MEMORY);
+}
+
+TEST_F(CgroupMonitorTest, ReportsStallPressure) {
+  writeFile("memory.pressure", "some avg10=12.50 avg60=3.00 avg300=1.00 total=123456\n"
+                               "full avg10=5.00 avg60=1.00 avg300=0.50 total=23456\n");
+  writeFile("cpu.pressure", "some avg10=40.00 avg60=20.00 avg300=10.00 total=654321\n"
+                            "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+
+  EXPECT_CALL(cb_, onSuccess(Server::ResourceUsage{0.125}));
+  update(CgroupConfig::MEMORY_PRESSURE);
+
+  EXPECT_CALL(cb_, onSuccess(Server::ResourceUsage{0.4}));
+  update(CgroupConfig::CPU_PRESSURE);
+
+  writeFile("cpu.pressure", "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+  EXPECT_CALL(cb_, onFailure(ExceptionContains("failed to parse cgroup cpu.pressure")));
+  update(CgroupConfig::CPU_PRESSURE);
+}
+
+TEST_F(CgroupMonitorTest, ReportsErrorOnFileRead) {
+  EXPECT_CALL(cb_, onFailure(ExceptionContains("Invalid path")));
+  update(CgroupConfig::CPU_PRESSURE);
+}
+
+} // namespace
+} // namespace CgroupMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
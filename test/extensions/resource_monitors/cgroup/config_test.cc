@@ -0,0 +1,40 @@
+#include "envoy/extensions/resource_monitors/cgroup/v3/cgroup.pb.h"
+#include "envoy/extensions/resource_monitors/cgroup/v3/cgroup.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/resource_monitors/cgroup/config.h"
+#include "source/server/resource_monitor_config_impl.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/server/options.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CgroupMonitor {
+namespace {
+
+TEST(CgroupMonitorFactoryTest, CreateMonitor) {
+  auto factory =
+      Registry::FactoryRegistry<Server::Configuration::ResourceMonitorFactory>::getFactory(
+          "envoy.resource_monitors.cgroup");
+  EXPECT_NE(factory, nullptr);
+
+  envoy::extensions::resource_monitors::cgroup::v3::CgroupConfig config;
+  config.set_resource(envoy::extensions::resource_monitors::cgroup::v3::CgroupConfig::CPU_PRESSURE);
+  Event::MockDispatcher dispatcher;
+  Api::ApiPtr api = Api::createApiForTest();
+  Server::MockOptions options;
+  Server::Configuration::ResourceMonitorFactoryContextImpl context(
+      dispatcher, options, *api, ProtobufMessage::getStrictValidationVisitor());
+  auto monitor = factory->createResourceMonitor(config, context);
+  EXPECT_NE(monitor, nullptr);
+}
+
+} // namespace
+} // namespace CgroupMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -75,6 +75,33 @@ public:
     setup(opentelemetry_config);
   }
 
+  void setupTailSamplingDriver(const std::string& tail_sampling_yaml) {
+    const std::string yaml_string = fmt::format(R"EOF(
+    grpc_service:
+      envoy_grpc:
+        cluster_name: fake-cluster
+      timeout: 0.250s
+    tail_sampling:
+      {}
+    )EOF",
+                                                tail_sampling_yaml);
+    envoy::config::trace::v3::OpenTelemetryConfig opentelemetry_config;
+    TestUtility::loadFromYaml(yaml_string, opentelemetry_config);
+
+    setup(opentelemetry_config);
+    ON_CALL(stream_info_, startTime()).WillByDefault(Return(time_system_.systemTime()));
+    // Give every span its own trace and span ids.
+    ON_CALL(context_.server_factory_context_.api_.random_, random())
+        .WillByDefault(Invoke([this]() { return ++random_value_; }));
+  }
+
+  Tracing::SpanPtr startSampledSpan() {
+    Tracing::TestTraceContextImpl request_headers{
+        {":authority", "test.com"}, {":path", "/"}, {":method", "GET"}};
+    return driver_->startSpan(mock_tracing_config_, request_headers, stream_info_, operation_name_,
+                              {Tracing::Reason::Sampling, true});
+  }
+
   void setupValidDriverWithHttpExporter() {
     const std::string yaml_string = R"EOF(
     http_service:
@@ -106,6 +133,7 @@ protected:
   NiceMock<Event::MockTimer>* timer_;
   NiceMock<Stats::MockIsolatedStatsStore> stats_;
   Stats::Scope& scope_{*stats_.rootScope()};
+  uint64_t random_value_{};
 };
 
 // Tests the tracer initialization with the gRPC exporter
@@ -345,6 +373,41 @@ TEST_F(OpenTelemetryDriverTest, ExportOTLPSpanWithBuffer) {
   EXPECT_EQ(2U, stats_.counter("tracing.opentelemetry.spans_sent").value());
 }
 
+// Verifies the reused export request keeps its resource and only holds the spans since the
+// previous flush.
+TEST_F(OpenTelemetryDriverTest, ExportOTLPSpanReusesRequest) {
+  setupValidDriver();
+  Tracing::TestTraceContextImpl request_headers{
+      {":authority", "test.com"}, {":path", "/"}, {":method", "GET"}};
+
+  EXPECT_CALL(runtime_.snapshot_, getInteger("tracing.opentelemetry.min_flush_spans", 5U))
+      .Times(2)
+      .WillRepeatedly(Return(1));
+  std::vector<opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest> requests;
+  EXPECT_CALL(*mock_stream_ptr_, sendMessageRaw_(_, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&requests](Buffer::InstancePtr& buffer, bool) {
+        requests.emplace_back();
+        EXPECT_TRUE(requests.back().ParseFromString(buffer->toString()));
+      }));
+
+  for (int i = 0; i < 2; ++i) {
+    Tracing::SpanPtr span =
+        driver_->startSpan(mock_tracing_config_, request_headers, stream_info_, operation_name_,
+                           {Tracing::Reason::Sampling, true});
+    span->finishSpan();
+  }
+
+  ASSERT_EQ(2U, requests.size());
+  for (const auto& request : requests) {
+    ASSERT_EQ(1, request.resource_spans_size());
+    EXPECT_EQ(2, request.resource_spans(0).resource().attributes_size());
+    ASSERT_EQ(1, request.resource_spans(0).scope_spans_size());
+    EXPECT_EQ(1, request.resource_spans(0).scope_spans(0).spans_size());
+  }
+  EXPECT_EQ(2U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+}
+
 // Verifies the export happens after a timeout
 TEST_F(OpenTelemetryDriverTest, ExportOTLPSpanWithFlushTimeout) {
   timer_ =
@@ -614,8 +677,10 @@ TEST_F(OpenTelemetryDriverTest, IgnoreNotSampledSpan) {
   Tracing::SpanPtr span = driver_->startSpan(mock_tracing_config_, request_headers, stream_info_,
                                              operation_name_, {Tracing::Reason::Sampling, true});
   EXPECT_NE(span.get(), nullptr);
+  EXPECT_TRUE(span->isRecording());
 
   span->setSampled(false);
+  EXPECT_FALSE(span->isRecording());
 
   EXPECT_CALL(runtime_.snapshot_, getInteger("tracing.opentelemetry.min_flush_spans", 5U)).Times(0);
   EXPECT_CALL(*mock_stream_ptr_, sendMessageRaw_(_, _)).Times(0);
@@ -743,6 +808,91 @@ TEST_F(OpenTelemetryDriverTest, ExportOTLPSpanHTTP) {
   EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.spans_sent").value());
 }
 
+// Verifies tail sampling drops the spans of traces that are not selected.
+TEST_F(OpenTelemetryDriverTest, TailSamplingDropsUnselectedSpans) {
+  setupTailSamplingDriver("max_buffered_spans: 1");
+
+  EXPECT_CALL(*mock_stream_ptr_, sendMessageRaw_(_, _)).Times(0);
+  startSampledSpan()->finishSpan();
+  EXPECT_EQ(0U, stats_.counter("tracing.opentelemetry.tail_sampling_dropped_spans").value());
+  // The buffer holds one span, so the first span is dropped to make room for the second.
+  startSampledSpan()->finishSpan();
+  EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.tail_sampling_dropped_spans").value());
+  EXPECT_EQ(0U, stats_.counter("tracing.opentelemetry.tail_sampling_selected_traces").value());
+  EXPECT_EQ(0U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+}
+
+// Verifies a failed span exports the buffered spans of its trace, and the spans of the trace that
+// finish later.
+TEST_F(OpenTelemetryDriverTest, TailSamplingSelectsFailedTrace) {
+  setupTailSamplingDriver("max_buffered_spans: 10");
+
+  Tracing::SpanPtr span = startSampledSpan();
+  Tracing::SpanPtr first_child =
+      span->spawnChild(mock_tracing_config_, operation_name_, time_system_.systemTime());
+  Tracing::SpanPtr second_child =
+      span->spawnChild(mock_tracing_config_, operation_name_, time_system_.systemTime());
+  // A span of another trace stays buffered.
+  startSampledSpan()->finishSpan();
+  first_child->finishSpan();
+
+  EXPECT_CALL(runtime_.snapshot_, getInteger("tracing.opentelemetry.min_flush_spans", 5U))
+      .Times(2)
+      .WillRepeatedly(Return(1));
+  EXPECT_CALL(*mock_stream_ptr_, sendMessageRaw_(_, _)).Times(2);
+  second_child->setTag(Tracing::Tags::get().Error, Tracing::Tags::get().True);
+  second_child->finishSpan();
+  EXPECT_EQ(2U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+  span->finishSpan();
+  EXPECT_EQ(3U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+  EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.tail_sampling_selected_traces").value());
+  EXPECT_EQ(0U, stats_.counter("tracing.opentelemetry.tail_sampling_dropped_spans").value());
+}
+
+// Verifies errors do not select traces when they are ignored, and tag rules do.
+TEST_F(OpenTelemetryDriverTest, TailSamplingTagRules) {
+  setupTailSamplingDriver(R"EOF(
+      ignore_errors: true
+      tags:
+      - name: http.status_code
+        value:
+          safe_regex:
+            regex: "5[0-9][0-9]"
+  )EOF");
+
+  Tracing::SpanPtr failed_span = startSampledSpan();
+  failed_span->setTag(Tracing::Tags::get().Error, Tracing::Tags::get().True);
+  failed_span->setTag(Tracing::Tags::get().HttpStatusCode, "404");
+  failed_span->finishSpan();
+  EXPECT_EQ(0U, stats_.counter("tracing.opentelemetry.tail_sampling_selected_traces").value());
+
+  EXPECT_CALL(runtime_.snapshot_, getInteger("tracing.opentelemetry.min_flush_spans", 5U))
+      .WillOnce(Return(1));
+  EXPECT_CALL(*mock_stream_ptr_, sendMessageRaw_(_, _));
+  Tracing::SpanPtr unavailable_span = startSampledSpan();
+  unavailable_span->setTag(Tracing::Tags::get().HttpStatusCode, "503");
+  unavailable_span->finishSpan();
+  EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.tail_sampling_selected_traces").value());
+  EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+}
+
+// Verifies slow spans select their trace.
+TEST_F(OpenTelemetryDriverTest, TailSamplingSelectsSlowSpan) {
+  setupTailSamplingDriver("slow_span_threshold: 1s");
+
+  startSampledSpan()->finishSpan();
+  EXPECT_EQ(0U, stats_.counter("tracing.opentelemetry.tail_sampling_selected_traces").value());
+
+  Tracing::SpanPtr span = startSampledSpan();
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_CALL(runtime_.snapshot_, getInteger("tracing.opentelemetry.min_flush_spans", 5U))
+      .WillOnce(Return(1));
+  EXPECT_CALL(*mock_stream_ptr_, sendMessageRaw_(_, _));
+  span->finishSpan();
+  EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.tail_sampling_selected_traces").value());
+  EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+}
+
 } // namespace OpenTelemetry
 } // namespace Tracers
 } // namespace Extensions
@@ -148,10 +148,22 @@ TEST_F(PerSocketTapperImplTest, NonMatchingFlow) {
   setup(true);
 
   EXPECT_CALL(*sink_manager_, submitTrace_(_)).Times(0);
+  EXPECT_FALSE(tapper_->tappingWrites());
   time_system_.setSystemTime(std::chrono::seconds(2));
   tapper_->closeSocket(Network::ConnectionEvent::RemoteClose);
 }
 
+// Buffered traces stop tapping writes once they are truncated.
+TEST_F(PerSocketTapperImplTest, BufferedTappingWritesUntilTruncated) {
+  setup(false);
+
+  EXPECT_TRUE(tapper_->tappingWrites());
+  tapper_->onWrite(Buffer::OwnedImpl("hello"), 5, false);
+  EXPECT_TRUE(tapper_->tappingWrites());
+  tapper_->onWrite(Buffer::OwnedImpl(std::string(2048, 'a')), 2048, false);
+  EXPECT_FALSE(tapper_->tappingWrites());
+}
+
 } // namespace
 } // namespace Tap
 } // namespace TransportSockets
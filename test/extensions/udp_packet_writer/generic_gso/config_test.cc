@@ -0,0 +1,49 @@
+#include "envoy/extensions/udp_packet_writer/v3/udp_generic_gso_batch_writer_factory.pb.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/extensions/udp_packet_writer/generic_gso/config.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+TEST(FactoryTest, Name) {
+  UdpGenericGsoBatchWriterFactoryFactory factory;
+  EXPECT_EQ(factory.name(), "envoy.udp_packet_writer.generic_gso");
+}
+
+TEST(FactoryTest, CreateEmptyConfigProto) {
+  UdpGenericGsoBatchWriterFactoryFactory factory;
+  EXPECT_TRUE(factory.createEmptyConfigProto() != nullptr);
+}
+
+TEST(FactoryTest, CreateUdpPacketWriterFactory) {
+  UdpGenericGsoBatchWriterFactoryFactory factory;
+  envoy::extensions::udp_packet_writer::v3::UdpGenericGsoBatchWriterFactory writer_config;
+  writer_config.mutable_max_segments()->set_value(8);
+  envoy::config::core::v3::TypedExtensionConfig config;
+  config.mutable_typed_config()->PackFrom(writer_config);
+  if (Api::OsSysCallsSingleton::get().supportsUdpGso()) {
+    EXPECT_TRUE(factory.createUdpPacketWriterFactory(config) != nullptr);
+  } else {
+    EXPECT_THROW_WITH_MESSAGE(factory.createUdpPacketWriterFactory(config), EnvoyException,
+                              "UDP generic segmentation offload is not supported on this host.");
+  }
+}
+
+TEST(FactoryTest, InvalidConfig) {
+  UdpGenericGsoBatchWriterFactoryFactory factory;
+  envoy::extensions::udp_packet_writer::v3::UdpGenericGsoBatchWriterFactory writer_config;
+  writer_config.mutable_max_segments()->set_value(65);
+  envoy::config::core::v3::TypedExtensionConfig config;
+  config.mutable_typed_config()->PackFrom(writer_config);
+  EXPECT_THROW(factory.createUdpPacketWriterFactory(config), EnvoyException);
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
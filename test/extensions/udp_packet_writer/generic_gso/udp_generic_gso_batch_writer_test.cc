@@ -0,0 +1,161 @@
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/udp_packet_writer/generic_gso/udp_generic_gso_batch_writer.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/network/io_handle.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+std::string getPayload(const msghdr* msg) {
+  std::string payload;
+  for (size_t i = 0; i < msg->msg_iovlen; ++i) {
+    payload.append(static_cast<const char*>(msg->msg_iov[i].iov_base), msg->msg_iov[i].iov_len);
+  }
+  return payload;
+}
+
+// Returns the segment size set on the message, or 0 if it is not segmented.
+uint16_t getSegmentSize(const msghdr* msg) {
+  if (msg->msg_controllen == 0) {
+    return 0;
+  }
+  for (const cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(const_cast<msghdr*>(msg), const_cast<cmsghdr*>(cmsg))) {
+    if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_SEGMENT) {
+      uint16_t segment_size;
+      memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+      return segment_size;
+    }
+  }
+  return 0;
+}
+
+class UdpGenericGsoBatchWriterTest : public testing::Test {
+protected:
+  UdpGenericGsoBatchWriterTest() { ON_CALL(io_handle_, fdDoNotUse()).WillByDefault(Return(10)); }
+
+  Api::IoCallUint64Result write(const std::string& payload, const Address::Instance& peer) {
+    Buffer::OwnedImpl buffer(payload);
+    return writer_.writePacket(buffer, nullptr, peer);
+  }
+
+  void expectSend(const std::string& payload, uint16_t segment_size) {
+    EXPECT_CALL(os_sys_calls_, sendmsg(10, _, 0))
+        .WillOnce(Invoke([payload, segment_size](os_fd_t, const msghdr* msg, int) {
+          EXPECT_EQ(payload, getPayload(msg));
+          EXPECT_EQ(segment_size, getSegmentSize(msg));
+          return Api::SysCallSizeResult{static_cast<ssize_t>(payload.size()), 0};
+        }));
+  }
+
+  uint64_t bufferedBytes() {
+    return store_.gaugeFromString("internal_buffer_size", Stats::Gauge::ImportMode::NeverImport)
+        .value();
+  }
+
+  NiceMock<Api::MockOsSysCalls> os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  Stats::IsolatedStoreImpl store_;
+  NiceMock<MockIoHandle> io_handle_;
+  UdpGenericGsoBatchWriter writer_{io_handle_, *store_.rootScope(), 4};
+  const Address::Ipv4Instance peer_{"127.0.0.1", 1234};
+  const Address::Ipv4Instance other_peer_{"127.0.0.1", 1235};
+};
+
+// Datagrams of the same size are buffered and written as one segmented message.
+TEST_F(UdpGenericGsoBatchWriterTest, SameSizeDatagrams) {
+  EXPECT_TRUE(writer_.isBatchMode());
+  EXPECT_CALL(os_sys_calls_, sendmsg(_, _, _)).Times(0);
+  EXPECT_EQ(4, write("aaaa", peer_).return_value_);
+  EXPECT_EQ(4, write("bbbb", peer_).return_value_);
+  EXPECT_EQ(8, bufferedBytes());
+  testing::Mock::VerifyAndClearExpectations(&os_sys_calls_);
+
+  expectSend("aaaabbbb", 4);
+  EXPECT_TRUE(writer_.flush().ok());
+  EXPECT_EQ(0, bufferedBytes());
+  EXPECT_EQ(8, store_.counterFromString("total_bytes_sent").value());
+
+  // Nothing left to write.
+  EXPECT_TRUE(writer_.flush().ok());
+}
+
+// A datagram shorter than the previous ones ends the batch.
+TEST_F(UdpGenericGsoBatchWriterTest, ShortDatagramEndsBatch) {
+  EXPECT_TRUE(write("aaaa", peer_).ok());
+  expectSend("aaaabb", 4);
+  EXPECT_EQ(2, write("bb", peer_).return_value_);
+  EXPECT_EQ(0, bufferedBytes());
+}
+
+// A longer datagram, or one sent to another peer, cannot be appended to the batch.
+TEST_F(UdpGenericGsoBatchWriterTest, DatagramNotAppended) {
+  EXPECT_TRUE(write("aaaa", peer_).ok());
+  expectSend("aaaa", 0);
+  EXPECT_TRUE(write("bbbbbb", peer_).ok());
+  EXPECT_EQ(6, bufferedBytes());
+
+  expectSend("bbbbbb", 0);
+  EXPECT_TRUE(write("cccccc", other_peer_).ok());
+  EXPECT_EQ(6, bufferedBytes());
+}
+
+// The batch is written once it holds the maximum number of segments.
+TEST_F(UdpGenericGsoBatchWriterTest, MaxSegments) {
+  EXPECT_TRUE(write("aa", peer_).ok());
+  EXPECT_TRUE(write("bb", peer_).ok());
+  EXPECT_TRUE(write("cc", peer_).ok());
+  expectSend("aabbccdd", 2);
+  EXPECT_TRUE(write("dd", peer_).ok());
+  EXPECT_EQ(0, bufferedBytes());
+}
+
+// The batch is kept while the socket is blocked, and new datagrams are rejected.
+TEST_F(UdpGenericGsoBatchWriterTest, WriteBlocked) {
+  EXPECT_TRUE(write("aaaa", peer_).ok());
+  EXPECT_CALL(os_sys_calls_, sendmsg(_, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+  Api::IoCallUint64Result result = writer_.flush();
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+  EXPECT_TRUE(writer_.isWriteBlocked());
+  EXPECT_EQ(4, bufferedBytes());
+
+  result = write("bbbb", peer_);
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+  EXPECT_EQ(4, bufferedBytes());
+
+  writer_.setWritable();
+  expectSend("aaaa", 0);
+  EXPECT_TRUE(writer_.flush().ok());
+  EXPECT_EQ(0, bufferedBytes());
+}
+
+// The batch is dropped on errors other than the socket being blocked.
+TEST_F(UdpGenericGsoBatchWriterTest, WriteError) {
+  EXPECT_TRUE(write("aaaa", peer_).ok());
+  EXPECT_CALL(os_sys_calls_, sendmsg(_, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_INVAL}));
+  EXPECT_FALSE(writer_.flush().ok());
+  EXPECT_FALSE(writer_.isWriteBlocked());
+  EXPECT_EQ(0, bufferedBytes());
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -21,6 +21,7 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/match.h"
 #include "absl/strings/substitute.h"
 #include "absl/synchronization/mutex.h"
 #include "gtest/gtest.h"
@@ -131,6 +132,55 @@ TEST_F(ProfileActionTest, CanDoSingleProfile) {
 #endif
 }
 
+TEST_F(ProfileActionTest, RecordsMutexContention) {
+  // Create configuration.
+  envoy::extensions::watchdog::profile_action::v3::ProfileActionConfig config;
+  config.set_profile_path(test_path_);
+  config.mutable_profile_duration()->set_seconds(1);
+  config.set_mutex_contention(true);
+
+  action_ = std::make_unique<ProfileAction>(config, context_);
+  Thread::ThreadPtr thread = api_->threadFactory().createThread(
+      [this]() -> void { dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit); });
+
+  // Create vector of relevant threads
+  const auto now = api_->timeSource().monotonicTime();
+  std::vector<std::pair<Thread::ThreadId, MonotonicTime>> tid_ltt_pairs = {
+      {Thread::ThreadId(10), now}};
+
+  dispatcher_->post([&tid_ltt_pairs, &now, this]() -> void {
+    action_->run(envoy::config::bootstrap::v3::Watchdog::WatchdogAction::MISS, tid_ltt_pairs, now);
+    absl::MutexLock lock(&mutex_);
+    outstanding_notifies_ += 1;
+  });
+
+  absl::MutexLock lock(&mutex_);
+  waitForOutstandingNotify();
+  time_system_->advanceTimeWait(std::chrono::seconds(2));
+
+  dispatcher_->exit();
+  thread->join();
+
+  int contention_files_found = 0;
+  Filesystem::Directory directory(test_path_);
+  for (const Filesystem::DirectoryEntry& entry : directory) {
+    if (entry.type_ == Filesystem::FileType::Regular &&
+        absl::EndsWith(entry.name_, ".contention")) {
+      const std::string contents =
+          api_->fileSystem().fileReadToEnd(test_path_ + "/" + entry.name_).value();
+      EXPECT_TRUE(absl::StrContains(contents, "num_contentions: "));
+      EXPECT_TRUE(absl::StrContains(contents, "lifetime_wait_cycles: "));
+      contention_files_found++;
+    }
+  }
+#ifdef PROFILER_AVAILABLE
+  EXPECT_EQ(contention_files_found, 1);
+#else
+  // Profiler won't run in this case, so no contention is recorded either.
+  EXPECT_EQ(contention_files_found, 0);
+#endif
+}
+
 TEST_F(ProfileActionTest, CanDoMultipleProfiles) {
   // Create configuration.
   envoy::extensions::watchdog::profile_action::v3::ProfileActionConfig config;
@@ -252,6 +252,11 @@ protected:
     }
     return counter;
   }
+  Stats::Counter* makeShardedCounterInternal(StatName name, StatName tag_extracted_name,
+                                             const StatNameTagVector& stat_name_tags) override {
+    // Sharding only affects performance, so sharded counters are made notifying counters too.
+    return makeCounterInternal(name, tag_extracted_name, stat_name_tags);
+  }
 
   virtual Stats::Counter* getCounterLockHeld(const std::string& name)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
@@ -367,6 +372,8 @@ public:
   void setTagProducer(TagProducerPtr&&) override {}
   void setStatsMatcher(StatsMatcherPtr&&) override {}
   void setHistogramSettings(HistogramSettingsConstPtr&&) override {}
+  void setShardHotCounters(bool) override {}
+  void setMaxStatsPerScope(uint32_t) override {}
   void initializeThreading(Event::Dispatcher&, ThreadLocal::Instance&) override {}
   void shutdownThreading() override {}
   void mergeHistograms(PostMergeCb cb) override { merge_cb_ = cb; }
@@ -61,6 +61,8 @@ public:
                             const std::string& /*resource_name*/,
                             const absl::optional<EnvoyException>& /*exception*/) override {}
 
+  bool loadResourcesOnStart() const override { return false; }
+
   static std::atomic<int> OnConfigUpdatedCount;
   static std::map<std::string, envoy::service::discovery::v3::Resource> ResourcesMap;
 
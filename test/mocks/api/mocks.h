@@ -142,6 +142,8 @@ class MockLinuxOsSysCalls : public LinuxOsSysCallsImpl {
 public:
   // Api::LinuxOsSysCalls
   MOCK_METHOD(SysCallIntResult, sched_getaffinity, (pid_t pid, size_t cpusetsize, cpu_set_t* mask));
+  MOCK_METHOD(SysCallIntResult, sched_setaffinity,
+              (pid_t pid, size_t cpusetsize, const cpu_set_t* mask));
 };
 #endif
 
@@ -38,8 +38,11 @@ public:
   MOCK_METHOD(bool, logFormatEscaped, (), (const));
   MOCK_METHOD(bool, enableFineGrainLogging, (), (const));
   MOCK_METHOD(const std::string&, logPath, (), (const));
+  MOCK_METHOD(Server::AsyncLogMode, asyncLogMode, (), (const));
   MOCK_METHOD(uint64_t, restartEpoch, (), (const));
   MOCK_METHOD(std::chrono::milliseconds, fileFlushIntervalMsec, (), (const));
+  MOCK_METHOD(uint64_t, fileFlushMaxBufferBytes, (), (const));
+  MOCK_METHOD(bool, fileFlushBlockWhenFull, (), (const));
   MOCK_METHOD(Mode, mode, (), (const));
   MOCK_METHOD(const std::string&, serviceClusterName, (), (const));
   MOCK_METHOD(const std::string&, serviceNodeName, (), (const));
@@ -49,6 +52,7 @@ public:
   MOCK_METHOD(bool, mutexTracingEnabled, (), (const));
   MOCK_METHOD(bool, coreDumpEnabled, (), (const));
   MOCK_METHOD(bool, cpusetThreadsEnabled, (), (const));
+  MOCK_METHOD(bool, pinWorkerThreadsEnabled, (), (const));
   MOCK_METHOD(const std::vector<std::string>&, disabledExtensions, (), (const));
   MOCK_METHOD(Server::CommandLineOptionsPtr, toCommandLineOptions, (), (const));
   MOCK_METHOD(const std::string&, socketPath, (), (const));
@@ -75,6 +79,7 @@ public:
   bool mutex_tracing_enabled_{};
   bool core_dump_enabled_{};
   bool cpuset_threads_enabled_{};
+  bool pin_worker_threads_enabled_{};
   std::vector<std::string> disabled_extensions_;
   std::string socket_path_;
   mode_t socket_mode_;
@@ -197,6 +197,7 @@ public:
               trustChainVerification, (), (const));
   MOCK_METHOD(bool, onlyVerifyLeafCertificateCrl, (), (const));
   MOCK_METHOD(absl::optional<uint32_t>, maxVerifyDepth, (), (const));
+  MOCK_METHOD(uint32_t, verifiedCertificateCacheSize, (), (const));
 };
 
 class MockPrivateKeyMethodManager : public PrivateKeyMethodManager {
@@ -162,6 +162,7 @@ public:
   MOCK_METHOD(void, set, (uint64_t value));
   MOCK_METHOD(void, setParentValue, (uint64_t parent_value));
   MOCK_METHOD(void, sub, (uint64_t amount));
+  MOCK_METHOD(bool, latchChanged, ());
   MOCK_METHOD(void, mergeImportMode, (ImportMode));
   MOCK_METHOD(bool, used, (), (const));
   MOCK_METHOD(bool, hidden, (), (const));
@@ -42,6 +42,7 @@ public:
               (Tracing::TraceContext & request_headers,
                const Upstream::HostDescriptionConstSharedPtr& upstream));
   MOCK_METHOD(void, setSampled, (const bool sampled));
+  MOCK_METHOD(bool, isRecording, (), (const));
   MOCK_METHOD(void, setBaggage, (absl::string_view key, absl::string_view value));
   MOCK_METHOD(std::string, getBaggage, (absl::string_view key));
   MOCK_METHOD(std::string, getTraceIdAsHex, (), (const));
@@ -130,6 +130,7 @@ public:
   MOCK_METHOD(const absl::optional<std::chrono::milliseconds>, grpcTimeoutHeaderOffset, (),
               (const));
   MOCK_METHOD(float, perUpstreamPreconnectRatio, (), (const));
+  MOCK_METHOD(bool, adaptivePreconnect, (), (const));
   MOCK_METHOD(float, peekaheadRatio, (), (const));
   MOCK_METHOD(uint32_t, perConnectionBufferLimitBytes, (), (const));
   MOCK_METHOD(uint64_t, features, (), (const));
@@ -35,6 +35,10 @@ public:
   void initializeThreadLocalClusters(const std::vector<std::string>& cluster_names);
 
   // Upstream::ClusterManager
+  bool addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
+                          const std::string& version_info, absl::optional<uint64_t>) override {
+    return addOrUpdateCluster(cluster, version_info);
+  }
   MOCK_METHOD(bool, addOrUpdateCluster,
               (const envoy::config::cluster::v3::Cluster& cluster,
                const std::string& version_info));
@@ -1,3 +1,5 @@
+#include "envoy/extensions/transport_sockets/tls/v3/secret.pb.h"
+
 #include "test/integration/filters/test_listener_filter.pb.h"
 #include "test/integration/filters/test_network_filter.pb.h"
 #include "test/server/admin/admin_instance.h"
@@ -61,6 +63,42 @@ TEST_P(AdminInstanceTest, ConfigDump) {
   EXPECT_EQ(expected_json, output);
 }
 
+TEST_P(AdminInstanceTest, ConfigDumpProtoFormat) {
+  Buffer::OwnedImpl response;
+  Http::TestResponseHeaderMapImpl header_map;
+  auto entry = admin_.getConfigTracker().add("secrets", [](const Matchers::StringMatcher&) {
+    auto msg = std::make_unique<envoy::admin::v3::SecretsConfigDump>();
+    envoy::extensions::transport_sockets::tls::v3::Secret secret;
+    secret.set_name("client_cert");
+    secret.mutable_tls_certificate()->mutable_private_key()->set_inline_string("key");
+    auto* dynamic_secret = msg->add_dynamic_active_secrets();
+    dynamic_secret->set_name("client_cert");
+    dynamic_secret->mutable_secret()->PackFrom(secret);
+    return msg;
+  });
+  EXPECT_EQ(Http::Code::OK,
+            getCallback("/config_dump?resource=dynamic_active_secrets&format=proto", header_map,
+                        response));
+  EXPECT_EQ(Http::Headers::get().ContentTypeValues.Protobuf, header_map.getContentTypeValue());
+
+  envoy::admin::v3::ConfigDump dump;
+  ASSERT_TRUE(dump.ParseFromString(response.toString()));
+  ASSERT_EQ(1, dump.configs_size());
+  envoy::admin::v3::SecretsConfigDump::DynamicSecret dynamic_secret;
+  ASSERT_TRUE(dump.configs(0).UnpackTo(&dynamic_secret));
+  envoy::extensions::transport_sockets::tls::v3::Secret secret;
+  ASSERT_TRUE(dynamic_secret.secret().UnpackTo(&secret));
+  // Resources are redacted in every format.
+  EXPECT_EQ("[redacted]", secret.tls_certificate().private_key().inline_string());
+}
+
+TEST_P(AdminInstanceTest, ConfigDumpUnsupportedFormat) {
+  Buffer::OwnedImpl response;
+  Http::TestResponseHeaderMapImpl header_map;
+  EXPECT_EQ(Http::Code::BadRequest, getCallback("/config_dump?format=yaml", header_map, response));
+  EXPECT_EQ("Unsupported format: yaml", response.toString());
+}
+
 TEST_P(AdminInstanceTest, ConfigDumpMaintainsOrder) {
   // Add configs in random order and validate config_dump dumps in the order.
   auto bootstrap_entry =
@@ -1413,6 +1413,65 @@ TEST_F(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusInvalidRegex) {
   EXPECT_THAT(code_response.second, HasSubstr("Invalid re2 regex"));
 }
 
+TEST_F(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusChunked) {
+  const std::string url = "/stats?format=prometheus";
+
+  createTestStats();
+  for (uint32_t i = 0; i < 10; ++i) {
+    store_->rootScope()->counterFromString(absl::StrCat("chunked.counter", i)).inc();
+  }
+  const CodeResponse code_response = handlerStats(url);
+  EXPECT_EQ(Http::Code::OK, code_response.first);
+
+  StatsParams params;
+  Buffer::OwnedImpl parse_response;
+  ASSERT_EQ(Http::Code::OK, params.parse(url, parse_response));
+  PrometheusStatsRequest request(*store_, params, endpoints_helper_.cm_, custom_namespaces_);
+  request.setChunkSize(1);
+  Http::TestResponseHeaderMapImpl response_headers;
+  EXPECT_EQ(Http::Code::OK, request.start(response_headers));
+
+  // Each chunk holds one whole metric group, and together they match the buffered output.
+  std::string output;
+  uint32_t num_chunks = 0;
+  bool more = true;
+  while (more) {
+    Buffer::OwnedImpl chunk;
+    more = request.nextChunk(chunk);
+    if (chunk.length() > 0) {
+      ++num_chunks;
+      const std::string chunk_str = chunk.toString();
+      EXPECT_TRUE(absl::StartsWith(chunk_str, "# TYPE ")) << chunk_str;
+      EXPECT_EQ(std::string::npos, chunk_str.find("# TYPE ", 1)) << chunk_str;
+    }
+    output += chunk.toString();
+  }
+  EXPECT_EQ(12, num_chunks);
+  EXPECT_EQ(code_response.second, output);
+}
+
+TEST_F(StatsHandlerPrometheusDefaultTest, StatsPrometheusEndpoint) {
+  createTestStats();
+  const CodeResponse code_response = handlerStats("/stats?format=prometheus");
+
+  NiceMock<MockInstance> instance;
+  EXPECT_CALL(admin_stream_, getRequestHeaders()).WillRepeatedly(ReturnRef(request_headers_));
+  EXPECT_CALL(instance, statsConfig()).WillRepeatedly(ReturnRef(stats_config_));
+  EXPECT_CALL(stats_config_, flushOnAdmin()).WillRepeatedly(Return(false));
+  ON_CALL(instance, stats()).WillByDefault(ReturnRef(*store_));
+  ON_CALL(instance, clusterManager()).WillByDefault(ReturnRef(endpoints_helper_.cm_));
+  EXPECT_CALL(instance, api()).WillRepeatedly(ReturnRef(api_));
+  StatsHandler handler(instance);
+  request_headers_.setPath("/stats/prometheus");
+  Admin::RequestPtr request = handler.makePrometheusRequest(admin_stream_);
+  Http::TestResponseHeaderMapImpl response_headers;
+  EXPECT_EQ(Http::Code::OK, request->start(response_headers));
+  Buffer::OwnedImpl data;
+  while (request->nextChunk(data)) {
+  }
+  EXPECT_EQ(code_response.second, data.toString());
+}
+
 class StatsHandlerPrometheusWithTextReadoutsTest
     : public StatsHandlerPrometheusTest,
       public testing::TestWithParam<std::tuple<Network::Address::IpVersion, std::string>> {};
@@ -93,6 +93,7 @@ TEST_F(ConfigurationImplTest, DefaultStatsFlushInterval) {
 
   EXPECT_EQ(std::chrono::milliseconds(5000), config.statsConfig().flushInterval());
   EXPECT_FALSE(config.statsConfig().flushOnAdmin());
+  EXPECT_FALSE(config.statsConfig().flushOnlyChanged());
 }
 
 TEST_F(ConfigurationImplTest, CustomStatsFlushInterval) {
@@ -161,6 +162,16 @@ TEST_F(ConfigurationImplTest, StatsOnAdmin) {
   EXPECT_TRUE(config.statsConfig().flushOnAdmin());
 }
 
+TEST_F(ConfigurationImplTest, StatsFlushOnlyChanged) {
+  envoy::config::bootstrap::v3::Bootstrap bootstrap;
+  bootstrap.set_stats_flush_only_changed(true);
+
+  MainImpl config;
+  EXPECT_TRUE(config.initialize(bootstrap, server_, cluster_manager_factory_).ok());
+
+  EXPECT_TRUE(config.statsConfig().flushOnlyChanged());
+}
+
 TEST_F(ConfigurationImplTest, NegativeStatsOnAdmin) {
   std::string json = R"EOF(
   {
@@ -1,6 +1,8 @@
 #include <memory>
 
 #include "source/common/network/address_impl.h"
+#include "source/common/stats/allocator_impl.h"
+#include "source/common/stats/thread_local_store.h"
 #include "source/server/hot_restarting_child.h"
 #include "source/server/hot_restarting_parent.h"
 
@@ -220,6 +222,8 @@ TEST_F(HotRestartingParentTest, GetListenSocketsForChildUnixDomainSocket) {
 
 TEST_F(HotRestartingParentTest, ExportStatsToChild) {
   Stats::TestUtil::TestStore store;
+  // The parent keeps the gauges it exported, so it must not outlive the store.
+  HotRestartingParent::Internal parent{&server_, message_sender_};
   MockListenerManager listener_manager;
   EXPECT_CALL(server_, listenerManager()).WillRepeatedly(ReturnRef(listener_manager));
   EXPECT_CALL(listener_manager, numConnections()).WillRepeatedly(Return(0));
@@ -232,23 +236,24 @@ TEST_F(HotRestartingParentTest, ExportStatsToChild) {
     store.gauge("g1", Stats::Gauge::ImportMode::Accumulate).set(123);
     store.gauge("g2", Stats::Gauge::ImportMode::Accumulate).set(456);
     HotRestartMessage::Reply::Stats stats;
-    hot_restarting_parent_.exportStatsToChild(&stats);
+    parent.exportStatsToChild(&stats);
     EXPECT_EQ(1, stats.counter_deltas().at("c1"));
     EXPECT_EQ(2, stats.counter_deltas().at("c2"));
     EXPECT_EQ(0, stats.gauges().at("g0"));
     EXPECT_EQ(123, stats.gauges().at("g1"));
     EXPECT_EQ(456, stats.gauges().at("g2"));
   }
-  // When a counter has not changed since its last export, it should not be included in the message.
+  // When a counter or gauge has not changed since its last export, it should not be included in
+  // the message.
   {
     store.counter("c2").add(2);
     store.gauge("g1", Stats::Gauge::ImportMode::Accumulate).add(1);
     store.gauge("g2", Stats::Gauge::ImportMode::Accumulate).sub(1);
     HotRestartMessage::Reply::Stats stats;
-    hot_restarting_parent_.exportStatsToChild(&stats);
+    parent.exportStatsToChild(&stats);
     EXPECT_EQ(stats.counter_deltas().end(), stats.counter_deltas().find("c1"));
     EXPECT_EQ(2, stats.counter_deltas().at("c2")); // 4 is the value, but 2 is the delta
-    EXPECT_EQ(0, stats.gauges().at("g0"));
+    EXPECT_EQ(stats.gauges().end(), stats.gauges().find("g0"));
     EXPECT_EQ(124, stats.gauges().at("g1"));
     EXPECT_EQ(455, stats.gauges().at("g2"));
   }
@@ -260,7 +265,7 @@ TEST_F(HotRestartingParentTest, ExportStatsToChild) {
     store.gauge("unused_gauge", Stats::Gauge::ImportMode::Accumulate);
     store.gauge("used_gauge", Stats::Gauge::ImportMode::Accumulate).add(1);
     HotRestartMessage::Reply::Stats stats;
-    hot_restarting_parent_.exportStatsToChild(&stats);
+    parent.exportStatsToChild(&stats);
     EXPECT_EQ(stats.counter_deltas().end(), stats.counter_deltas().find("unused_counter"));
     EXPECT_EQ(1, stats.counter_deltas().at("used_counter"));
     EXPECT_EQ(stats.gauges().end(), stats.counter_deltas().find("unused_gauge"));
@@ -268,10 +273,36 @@ TEST_F(HotRestartingParentTest, ExportStatsToChild) {
   }
 }
 
+TEST_F(HotRestartingParentTest, ExportStatsToChildDropsRemovedGauges) {
+  Stats::SymbolTableImpl symbol_table;
+  Stats::AllocatorImpl alloc(symbol_table);
+  Stats::ThreadLocalStoreImpl store(alloc);
+  HotRestartingParent::Internal parent{&server_, message_sender_};
+  MockListenerManager listener_manager;
+  EXPECT_CALL(server_, listenerManager()).WillRepeatedly(ReturnRef(listener_manager));
+  EXPECT_CALL(listener_manager, numConnections()).WillRepeatedly(Return(0));
+  EXPECT_CALL(server_, stats()).WillRepeatedly(ReturnRef(store));
+
+  store.rootScope()->gaugeFromString("g1", Stats::Gauge::ImportMode::Accumulate).set(1);
+  {
+    Stats::ScopeSharedPtr scope = store.rootScope()->createScope("removed.");
+    scope->gaugeFromString("g2", Stats::Gauge::ImportMode::Accumulate).set(2);
+    HotRestartMessage::Reply::Stats stats;
+    parent.exportStatsToChild(&stats);
+    EXPECT_EQ(2, stats.gauges().at("removed.g2"));
+    EXPECT_EQ(2, parent.exportedGaugeCountForTest());
+  }
+
+  HotRestartMessage::Reply::Stats stats;
+  parent.exportStatsToChild(&stats);
+  EXPECT_EQ(1, parent.exportedGaugeCountForTest());
+}
+
 TEST_F(HotRestartingParentTest, RetainDynamicStats) {
   MockListenerManager listener_manager;
   Stats::SymbolTableImpl parent_symbol_table;
   Stats::TestUtil::TestStore parent_store(parent_symbol_table);
+  HotRestartingParent::Internal parent{&server_, message_sender_};
 
   EXPECT_CALL(server_, listenerManager()).WillRepeatedly(ReturnRef(listener_manager));
   EXPECT_CALL(listener_manager, numConnections()).WillRepeatedly(Return(0));
@@ -286,7 +317,7 @@ TEST_F(HotRestartingParentTest, RetainDynamicStats) {
     parent_store.rootScope()
         ->gaugeFromStatName(dynamic.add("g2"), Stats::Gauge::ImportMode::Accumulate)
         .set(42);
-    hot_restarting_parent_.exportStatsToChild(&stats_proto);
+    parent.exportStatsToChild(&stats_proto);
   }
 
   {
@@ -95,11 +95,12 @@ TEST_F(OptionsImplTest, All) {
       "envoy --mode validate --concurrency 2 -c hello --admin-address-path path --restart-epoch 0 "
       "--local-address-ip-version v6 -l info --component-log-level upstream:debug,connection:trace "
       "--service-cluster cluster --service-node node --service-zone zone "
-      "--file-flush-interval-msec 9000 "
+      "--file-flush-interval-msec 9000 --file-flush-max-buffer-bytes 1048576 "
+      "--file-flush-block-when-full "
       "--drain-time-s 60 --log-format [%v] --enable-fine-grain-logging --parent-shutdown-time-s 90 "
       "--log-path "
       "/foo/bar "
-      "--disable-hot-restart --cpuset-threads --allow-unknown-static-fields "
+      "--disable-hot-restart --cpuset-threads --pin-worker-threads --allow-unknown-static-fields "
       "--reject-unknown-dynamic-fields --base-id 5 "
       "--use-dynamic-base-id --base-id-path /foo/baz "
       "--stats-tag foo:bar --stats-tag baz:bar "
@@ -120,10 +121,13 @@ TEST_F(OptionsImplTest, All) {
   EXPECT_EQ("node", options->serviceNodeName());
   EXPECT_EQ("zone", options->serviceZone());
   EXPECT_EQ(std::chrono::milliseconds(9000), options->fileFlushIntervalMsec());
+  EXPECT_EQ(1048576U, options->fileFlushMaxBufferBytes());
+  EXPECT_TRUE(options->fileFlushBlockWhenFull());
   EXPECT_EQ(std::chrono::seconds(60), options->drainTime());
   EXPECT_EQ(std::chrono::seconds(90), options->parentShutdownTime());
   EXPECT_TRUE(options->hotRestartDisabled());
   EXPECT_TRUE(options->cpusetThreadsEnabled());
+  EXPECT_TRUE(options->pinWorkerThreadsEnabled());
   EXPECT_TRUE(options->allowUnknownStaticFields());
   EXPECT_TRUE(options->rejectUnknownDynamicFields());
   EXPECT_EQ(5U, options->baseId());
@@ -162,6 +166,7 @@ TEST_F(OptionsImplTest, SetAll) {
   bool hot_restart_disabled = options->hotRestartDisabled();
   bool signal_handling_enabled = options->signalHandlingEnabled();
   bool cpuset_threads_enabled = options->cpusetThreadsEnabled();
+  bool pin_worker_threads_enabled = options->pinWorkerThreadsEnabled();
 
   options->setBaseId(109876);
   options->setUseDynamicBaseId(true);
@@ -182,6 +187,8 @@ TEST_F(OptionsImplTest, SetAll) {
   options->setLogPath("/foo/bar");
   options->setRestartEpoch(44);
   options->setFileFlushIntervalMsec(std::chrono::milliseconds(45));
+  options->setFileFlushMaxBufferBytes(4096);
+  options->setFileFlushBlockWhenFull(true);
   options->setMode(Server::Mode::Validate);
   options->setServiceClusterName("cluster_foo");
   options->setServiceNodeName("node_foo");
@@ -189,6 +196,7 @@ TEST_F(OptionsImplTest, SetAll) {
   options->setHotRestartDisabled(!options->hotRestartDisabled());
   options->setSignalHandling(!options->signalHandlingEnabled());
   options->setCpusetThreads(!options->cpusetThreadsEnabled());
+  options->setPinWorkerThreads(!options->pinWorkerThreadsEnabled());
   options->setAllowUnknownFields(true);
   options->setRejectUnknownFieldsDynamic(true);
   options->setSocketPath("/foo/envoy_domain_socket");
@@ -215,6 +223,8 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(std::chrono::seconds(43), options->parentShutdownTime());
   EXPECT_EQ(44, options->restartEpoch());
   EXPECT_EQ(std::chrono::milliseconds(45), options->fileFlushIntervalMsec());
+  EXPECT_EQ(4096U, options->fileFlushMaxBufferBytes());
+  EXPECT_TRUE(options->fileFlushBlockWhenFull());
   EXPECT_EQ(Server::Mode::Validate, options->mode());
   EXPECT_EQ("cluster_foo", options->serviceClusterName());
   EXPECT_EQ("node_foo", options->serviceNodeName());
@@ -222,6 +232,7 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(!hot_restart_disabled, options->hotRestartDisabled());
   EXPECT_EQ(!signal_handling_enabled, options->signalHandlingEnabled());
   EXPECT_EQ(!cpuset_threads_enabled, options->cpusetThreadsEnabled());
+  EXPECT_EQ(!pin_worker_threads_enabled, options->pinWorkerThreadsEnabled());
   EXPECT_TRUE(options->allowUnknownStaticFields());
   EXPECT_TRUE(options->rejectUnknownDynamicFields());
   EXPECT_EQ("/foo/envoy_domain_socket", options->socketPath());
@@ -248,6 +259,8 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(options->restartEpoch(), command_line_options->restart_epoch());
   EXPECT_EQ(options->fileFlushIntervalMsec().count() / 1000,
             command_line_options->file_flush_interval().seconds());
+  EXPECT_EQ(4096U, command_line_options->file_flush_max_buffer_bytes());
+  EXPECT_TRUE(command_line_options->file_flush_block_when_full());
   EXPECT_EQ(envoy::admin::v3::CommandLineOptions::Validate, command_line_options->mode());
   EXPECT_EQ(options->serviceClusterName(), command_line_options->service_cluster());
   EXPECT_EQ(options->serviceNodeName(), command_line_options->service_node());
@@ -256,6 +269,7 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(options->mutexTracingEnabled(), command_line_options->enable_mutex_tracing());
   EXPECT_EQ(options->coreDumpEnabled(), command_line_options->enable_core_dump());
   EXPECT_EQ(options->cpusetThreadsEnabled(), command_line_options->cpuset_threads());
+  EXPECT_EQ(options->pinWorkerThreadsEnabled(), command_line_options->pin_worker_threads());
   EXPECT_EQ(options->socketPath(), command_line_options->socket_path());
   EXPECT_EQ(options->socketMode(), command_line_options->socket_mode());
   EXPECT_EQ(1U, command_line_options->stats_tag().size());
@@ -276,6 +290,9 @@ TEST_F(OptionsImplTest, DefaultParams) {
   EXPECT_EQ(0U, options->statsTags().size());
   EXPECT_FALSE(options->hotRestartDisabled());
   EXPECT_FALSE(options->cpusetThreadsEnabled());
+  EXPECT_FALSE(options->pinWorkerThreadsEnabled());
+  EXPECT_EQ(0U, options->fileFlushMaxBufferBytes());
+  EXPECT_FALSE(options->fileFlushBlockWhenFull());
 
   // Validate that CommandLineOptions is constructed correctly with default params.
   Server::CommandLineOptionsPtr command_line_options = options->toCommandLineOptions();
@@ -290,6 +307,7 @@ TEST_F(OptionsImplTest, DefaultParams) {
   EXPECT_EQ(0, command_line_options->socket_mode());
   EXPECT_FALSE(command_line_options->disable_hot_restart());
   EXPECT_FALSE(command_line_options->cpuset_threads());
+  EXPECT_FALSE(command_line_options->pin_worker_threads());
   EXPECT_FALSE(command_line_options->allow_unknown_static_fields());
   EXPECT_FALSE(command_line_options->reject_unknown_dynamic_fields());
   EXPECT_EQ(0, options->statsTags().size());
@@ -363,6 +381,16 @@ TEST_F(OptionsImplTest, BadCliOption) {
                           MalformedArgvException, "error: unknown IP address version 'foo'");
 }
 
+TEST_F(OptionsImplTest, AsyncLogMode) {
+  EXPECT_EQ(Server::AsyncLogMode::Disabled, createOptionsImpl("envoy -c hello")->asyncLogMode());
+  EXPECT_EQ(Server::AsyncLogMode::Drop,
+            createOptionsImpl("envoy -c hello --log-async drop")->asyncLogMode());
+  EXPECT_EQ(Server::AsyncLogMode::Block,
+            createOptionsImpl("envoy -c hello --log-async block")->asyncLogMode());
+  EXPECT_THROW_WITH_REGEX(createOptionsImpl("envoy -c hello --log-async foo"),
+                          MalformedArgvException, "error: unknown log-async mode 'foo'");
+}
+
 TEST_F(OptionsImplTest, ParseComponentLogLevels) {
   std::unique_ptr<OptionsImpl> options = createOptionsImpl("envoy --mode init_only");
   options->parseComponentLogLevels("upstream:debug,connection:trace");
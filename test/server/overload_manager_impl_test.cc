@@ -896,6 +896,59 @@ TEST_F(OverloadManagerSimulatedTimeTest, RefreshLoopDelay) {
   manager->stop();
 }
 
+TEST_F(OverloadManagerSimulatedTimeTest, TrendTrigger) {
+  setDispatcherExpectation();
+  auto manager(createOverloadManager(R"YAML(
+  refresh_interval:
+    seconds: 1
+  resource_monitors:
+    - name: envoy.resource_monitors.fake_resource1
+  actions:
+    - name: envoy.overload_actions.stop_accepting_requests
+      triggers:
+        - name: envoy.resource_monitors.fake_resource1
+          trend:
+            value: 0.9
+            lookahead:
+              seconds: 2
+)YAML"));
+  manager->start();
+  const auto& action_state = manager->getThreadLocalOverloadState().getState(
+      "envoy.overload_actions.stop_accepting_requests");
+
+  factory1_.monitor_->setPressure(0.5);
+  timer_cb_();
+  EXPECT_FALSE(action_state.isSaturated());
+
+  // Growing by 0.1 per second, the pressure is projected to reach 0.8 in two seconds.
+  simTime().advanceTimeWait(Envoy::Seconds(1));
+  factory1_.monitor_->setPressure(0.6);
+  timer_cb_();
+  EXPECT_FALSE(action_state.isSaturated());
+
+  // Growing by 0.15 per second, the pressure is projected to reach 1.05 in two seconds.
+  simTime().advanceTimeWait(Envoy::Seconds(1));
+  factory1_.monitor_->setPressure(0.75);
+  timer_cb_();
+  EXPECT_TRUE(action_state.isSaturated());
+
+  // A stable pressure below the threshold is not projected to grow.
+  simTime().advanceTimeWait(Envoy::Seconds(1));
+  timer_cb_();
+  EXPECT_FALSE(action_state.isSaturated());
+
+  // A falling pressure at the threshold still saturates the trigger.
+  simTime().advanceTimeWait(Envoy::Seconds(1));
+  factory1_.monitor_->setPressure(0.95);
+  timer_cb_();
+  simTime().advanceTimeWait(Envoy::Seconds(1));
+  factory1_.monitor_->setPressure(0.9);
+  timer_cb_();
+  EXPECT_TRUE(action_state.isSaturated());
+
+  manager->stop();
+}
+
 class OverloadManagerLoadShedPointImplTest : public OverloadManagerImplTest {};
 
 TEST_F(OverloadManagerLoadShedPointImplTest, DuplicateLoadShedPoints) {
@@ -160,6 +160,68 @@ TEST(ServerInstanceUtil, flushImportModeUninitializedGauges) {
   InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
 }
 
+TEST(ServerInstanceUtil, flushOnlyChanged) {
+  InSequence s;
+
+  NiceMock<Upstream::MockClusterManager> cm;
+  Stats::TestUtil::TestStore store;
+  Event::SimulatedTimeSystem time_system;
+  Stats::Counter& changed_counter = store.counter("changed_counter");
+  Stats::Counter& idle_counter = store.counter("idle_counter");
+  Stats::Gauge& changed_gauge =
+      store.gauge("changed_gauge", Stats::Gauge::ImportMode::Accumulate);
+  Stats::Gauge& idle_gauge = store.gauge("idle_gauge", Stats::Gauge::ImportMode::Accumulate);
+  changed_counter.inc();
+  idle_counter.inc();
+  changed_gauge.set(5);
+  idle_gauge.set(3);
+
+  std::list<Stats::SinkPtr> sinks;
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, true);
+  // Counters are latched whether or not they are flushed.
+  EXPECT_EQ(0, idle_counter.latch());
+
+  Stats::MockSink* sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(sink);
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "changed_counter");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 1);
+
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().name(), "changed_gauge");
+    EXPECT_EQ(snapshot.gauges()[0].get().value(), 4);
+  }));
+  changed_counter.inc();
+  changed_gauge.sub(1);
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, true);
+
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.counters().empty());
+    EXPECT_TRUE(snapshot.gauges().empty());
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, true);
+
+  // Histograms without values in the interval are left out as well.
+  NiceMock<Stats::MockStore> mock_store;
+  Stats::ParentHistogramSharedPtr parent_histogram(new NiceMock<Stats::MockParentHistogram>());
+  std::vector<Stats::ParentHistogramSharedPtr> parent_histograms = {parent_histogram};
+  ON_CALL(mock_store, forEachSinkedHistogram)
+      .WillByDefault([&](std::function<void(std::size_t)> f_size,
+                         std::function<void(Stats::ParentHistogram&)> f_stat) {
+        if (f_size != nullptr) {
+          f_size(parent_histograms.size());
+        }
+        for (auto& histogram : parent_histograms) {
+          f_stat(*histogram);
+        }
+      });
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.histograms().empty());
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, mock_store, cm, time_system, true);
+}
+
 class RunHelperTest : public testing::Test {
 public:
   RunHelperTest() {
@@ -1,15 +1,19 @@
 #include "envoy/network/exception.h"
 
 #include "source/common/api/api_impl.h"
+#include "source/common/buffer/slice_allocator.h"
 #include "source/common/event/dispatcher_impl.h"
 #include "source/server/worker_impl.h"
 
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/api/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/server/guard_dog.h"
 #include "test/mocks/server/instance.h"
 #include "test/mocks/server/overload_manager.h"
 #include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
 #include "absl/synchronization/notification.h"
@@ -30,12 +34,12 @@ std::function<void()> emptyCallback = []() {};
 
 class WorkerImplTest : public testing::Test {
 public:
-  WorkerImplTest()
+  explicit WorkerImplTest(absl::optional<uint32_t> cpu = absl::nullopt)
       : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("worker_test")),
         no_exit_timer_(dispatcher_->createTimer([]() -> void {})),
         stat_names_(api_->rootScope().symbolTable()),
         worker_(tls_, hooks_, std::move(dispatcher_), Network::ConnectionHandlerPtr{handler_},
-                overload_manager_, *api_, stat_names_) {
+                overload_manager_, *api_, stat_names_, cpu) {
     // In the real worker the watchdog has timers that prevent exit. Here we need to prevent event
     // loop exit since we use mock timers.
     no_exit_timer_->enableTimer(std::chrono::hours(1));
@@ -48,6 +52,18 @@ public:
     no_exit_timer_.reset();
   }
 
+  // Runs cb on the worker thread and waits for it.
+  void runOnWorker(std::function<void()> cb) {
+    absl::Notification done;
+    worker_.dispatcher_->post([&cb, &done]() {
+      cb();
+      done.Notify();
+    });
+    done.WaitForNotification();
+  }
+
+  void flushBufferStats() { worker_.flushBufferStats(); }
+
   NiceMock<Runtime::MockLoader> runtime_;
   testing::NiceMock<Random::MockRandomGenerator> random_;
   NiceMock<ThreadLocal::MockInstance> tls_;
@@ -150,6 +166,34 @@ TEST_F(WorkerImplTest, BasicFlow) {
   worker_.stop();
 }
 
+// Flushes only add what changed since the previous flush, so that values merged into the counters
+// from a hot restart parent are kept.
+TEST_F(WorkerImplTest, FlushBufferStats) {
+  Stats::TestUtil::TestStore store;
+  worker_.start(guard_dog_, emptyCallback);
+  worker_.initializeStats(*store.rootScope());
+
+  runOnWorker([this, &store]() {
+    flushBufferStats();
+    Stats::Counter& cache_hits = store.counter("worker_test.buffer.slice_cache_hits");
+    cache_hits.add(1000);
+    const uint64_t counted_cache_hits = cache_hits.value();
+
+    const Buffer::SliceAllocator::Stats& stats = Buffer::SliceAllocator::threadStats();
+    const uint64_t thread_cache_hits = stats.cache_hits_;
+    Buffer::SliceAllocator::deallocate(Buffer::SliceAllocator::allocate(4096), 4096);
+    Buffer::SliceAllocator::deallocate(Buffer::SliceAllocator::allocate(4096), 4096);
+    EXPECT_LT(thread_cache_hits, stats.cache_hits_);
+
+    flushBufferStats();
+    EXPECT_EQ(counted_cache_hits + stats.cache_hits_ - thread_cache_hits, cache_hits.value());
+    EXPECT_EQ(stats.cached_bytes_, store.gauge("worker_test.buffer.slice_cache_bytes",
+                                               Stats::Gauge::ImportMode::NeverImport)
+                                       .value());
+  });
+  worker_.stop();
+}
+
 TEST_F(WorkerImplTest, WorkerInvokesProvidedCallback) {
   absl::Notification callback_ran;
   auto cb = [&callback_ran]() { callback_ran.Notify(); };
@@ -159,6 +203,29 @@ TEST_F(WorkerImplTest, WorkerInvokesProvidedCallback) {
   worker_.stop();
 }
 
+#if defined(__linux__)
+class PinnedWorkerImplTest : public WorkerImplTest {
+public:
+  PinnedWorkerImplTest() : WorkerImplTest(3) {}
+};
+
+TEST_F(PinnedWorkerImplTest, PinsWorkerThreadToCpu) {
+  Api::MockLinuxOsSysCalls linux_os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls(&linux_os_sys_calls);
+  EXPECT_CALL(linux_os_sys_calls, sched_setaffinity(0, sizeof(cpu_set_t), _))
+      .WillOnce(Invoke([](pid_t, size_t, const cpu_set_t* mask) {
+        EXPECT_EQ(1, CPU_COUNT(mask));
+        EXPECT_TRUE(CPU_ISSET(3, mask));
+        return Api::SysCallIntResult{0, 0};
+      }));
+
+  absl::Notification callback_ran;
+  worker_.start(guard_dog_, [&callback_ran]() { callback_ran.Notify(); });
+  callback_ran.WaitForNotification();
+  worker_.stop();
+}
+#endif
+
 } // namespace
 } // namespace Server
 } // namespace Envoy